@@ -1146,6 +1146,23 @@ elif ctx.pkg_name == 'libunwind':
     execute_make(ctx)
     install_files(ctx, 'include/*.h', ctx.pkg_inc_dir)
     install_files(ctx, 'src/.libs/libunwind.a', ctx.pkg_lib_dir)
+elif ctx.pkg_name == 'liburing':
+    download(
+        ctx,
+        'https://github.com/axboe/liburing/archive/refs/tags/'
+            'liburing-{ctx.pkg_ver}.tar.gz',
+        'liburing-{ctx.pkg_ver}.tar.gz')
+    unpack(ctx,
+           'liburing-{ctx.pkg_ver}.tar.gz',
+           'liburing-liburing-{ctx.pkg_ver}')
+    changedir(ctx, 'src/liburing-liburing-{ctx.pkg_ver}')
+    execute(ctx, '{vars} {flags} ./configure'.format(
+        vars=format_vars(ctx),
+        flags=format_flags(ctx, cflags='-fPIC')))
+    changedir(ctx, 'src')
+    execute_make(ctx)
+    install_tree(ctx, 'include', ctx.pkg_inc_dir)
+    install_files(ctx, 'liburing.a', ctx.pkg_lib_dir)
 elif ctx.pkg_name == 'openfec':
     if ctx.variant == 'debug':
         setattr(ctx, 'res_dir', 'bin/Debug')
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/adpcm_decoder.h"
+#include "roc_audio/adpcm_format.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+using namespace adpcm;
+
+namespace {
+
+// Decode group of up to Lanes channels.
+// Like in encoder, loops over lanes are branchless and have fixed length,
+// so that compiler can decode all channels of the group at once.
+// If samples is NULL, only predictor state is updated.
+template <size_t Lanes>
+void decode_group(const uint8_t* codes,
+                  size_t code_pos,
+                  size_t n_samples,
+                  size_t n_chans,
+                  size_t n_group_chans,
+                  int32_t* predictor,
+                  int32_t* step_index,
+                  sample_t* samples) {
+    int32_t pred[Lanes] = {};
+    int32_t index[Lanes] = {};
+
+    for (size_t l = 0; l < n_group_chans; l++) {
+        pred[l] = predictor[l];
+        index[l] = step_index[l];
+    }
+
+    for (size_t i = 0; i < n_samples; i++) {
+        int32_t code[Lanes] = {};
+
+        for (size_t l = 0; l < n_group_chans; l++) {
+            const size_t pos = code_pos + i * n_chans + l;
+            code[l] = (codes[pos >> 1] >> ((pos & 1) * 4)) & 0x0f;
+        }
+
+        for (size_t l = 0; l < Lanes; l++) {
+            const int32_t step = StepTable[index[l]];
+            const int32_t c = code[l];
+
+            int32_t vpdiff = step >> 3;
+            vpdiff += (c & 4) ? step : 0;
+            vpdiff += (c & 2) ? (step >> 1) : 0;
+            vpdiff += (c & 1) ? (step >> 2) : 0;
+
+            pred[l] += (c & 8) ? -vpdiff : vpdiff;
+            index[l] += IndexTable[c];
+            clamp_state(pred[l], index[l]);
+        }
+
+        if (samples) {
+            for (size_t l = 0; l < n_group_chans; l++) {
+                samples[i * n_chans + l] = dequantize_sample(pred[l]);
+            }
+        }
+    }
+
+    for (size_t l = 0; l < n_group_chans; l++) {
+        predictor[l] = pred[l];
+        step_index[l] = index[l];
+    }
+}
+
+bool parse_header(const void* frame_data,
+                  size_t frame_size,
+                  size_t n_chans,
+                  size_t& n_samples) {
+    if (frame_size < FrameHeaderSize) {
+        return false;
+    }
+
+    const uint8_t* data = (const uint8_t*)frame_data;
+
+    n_samples = ((size_t)data[0] << 8) | data[1];
+
+    return frame_size >= adpcm::frame_size(n_samples, n_chans);
+}
+
+} // namespace
+
+IFrameDecoder* AdpcmDecoder::construct(core::IArena& arena,
+                                       const SampleSpec& sample_spec) {
+    return new (arena) AdpcmDecoder(sample_spec, arena);
+}
+
+AdpcmDecoder::AdpcmDecoder(const SampleSpec& sample_spec, core::IArena& arena)
+    : n_chans_(sample_spec.num_channels())
+    , predictor_(arena)
+    , step_index_(arena)
+    , stream_pos_(0)
+    , stream_avail_(0)
+    , frame_data_(NULL)
+    , frame_off_(0) {
+    if (!predictor_.resize(n_chans_) || !step_index_.resize(n_chans_)) {
+        roc_panic("adpcm decoder: can't allocate state: n_chans=%lu",
+                  (unsigned long)n_chans_);
+    }
+}
+
+packet::stream_timestamp_t AdpcmDecoder::position() const {
+    return stream_pos_;
+}
+
+packet::stream_timestamp_t AdpcmDecoder::available() const {
+    return stream_avail_;
+}
+
+size_t AdpcmDecoder::decoded_sample_count(const void* frame_data,
+                                          size_t frame_size) const {
+    roc_panic_if_not(frame_data);
+
+    size_t n_samples = 0;
+    if (!parse_header(frame_data, frame_size, n_chans_, n_samples)) {
+        return 0;
+    }
+
+    return n_samples;
+}
+
+void AdpcmDecoder::begin(packet::stream_timestamp_t frame_position,
+                         const void* frame_data,
+                         size_t frame_size) {
+    roc_panic_if_not(frame_data);
+
+    if (frame_data_) {
+        roc_panic("adpcm decoder: unpaired begin/end");
+    }
+
+    frame_data_ = (const uint8_t*)frame_data;
+    frame_off_ = 0;
+
+    stream_pos_ = frame_position;
+    stream_avail_ = 0;
+
+    size_t n_samples = 0;
+    if (!parse_header(frame_data, frame_size, n_chans_, n_samples)
+        || !read_headers_(frame_data_, frame_size)) {
+        roc_log(LogDebug, "adpcm decoder: dropping malformed frame: size=%lu",
+                (unsigned long)frame_size);
+        return;
+    }
+
+    stream_avail_ = (packet::stream_timestamp_t)n_samples;
+}
+
+size_t AdpcmDecoder::read(sample_t* samples, size_t n_samples) {
+    if (!frame_data_) {
+        roc_panic("adpcm decoder: read should be called only between begin/end");
+    }
+
+    if (n_samples > (size_t)stream_avail_) {
+        n_samples = (size_t)stream_avail_;
+    }
+
+    decode_(samples, n_samples);
+
+    return n_samples;
+}
+
+size_t AdpcmDecoder::shift(size_t n_samples) {
+    if (!frame_data_) {
+        roc_panic("adpcm decoder: shift should be called only between begin/end");
+    }
+
+    if (n_samples > (size_t)stream_avail_) {
+        n_samples = (size_t)stream_avail_;
+    }
+
+    // Predictor state depends on all previous codes, so skipped samples
+    // still have to be decoded.
+    decode_(NULL, n_samples);
+
+    return n_samples;
+}
+
+void AdpcmDecoder::end() {
+    if (!frame_data_) {
+        roc_panic("adpcm decoder: unpaired begin/end");
+    }
+
+    stream_avail_ = 0;
+
+    frame_data_ = NULL;
+    frame_off_ = 0;
+}
+
+bool AdpcmDecoder::read_headers_(const uint8_t* frame_data, size_t frame_size) {
+    roc_panic_if_not(frame_size >= adpcm::frame_size(0, n_chans_));
+
+    const uint8_t* header = frame_data + FrameHeaderSize;
+
+    for (size_t c = 0; c < n_chans_; c++) {
+        const uint16_t pred = uint16_t((header[0] << 8) | header[1]);
+
+        predictor_[c] = (int16_t)pred;
+        step_index_[c] = header[2];
+
+        if (step_index_[c] > MaxStepIndex) {
+            return false;
+        }
+
+        header += ChannelHeaderSize;
+    }
+
+    return true;
+}
+
+void AdpcmDecoder::decode_(sample_t* samples, size_t n_samples) {
+    if (n_samples == 0) {
+        return;
+    }
+
+    const uint8_t* codes = frame_data_ + adpcm::frame_size(0, n_chans_);
+    const size_t code_pos = frame_off_ * n_chans_;
+
+    if (n_chans_ == 1) {
+        decode_group<1>(codes, code_pos, n_samples, n_chans_, 1, predictor_.data(),
+                        step_index_.data(), samples);
+    } else if (n_chans_ == 2) {
+        decode_group<2>(codes, code_pos, n_samples, n_chans_, 2, predictor_.data(),
+                        step_index_.data(), samples);
+    } else if (n_chans_ <= 4) {
+        decode_group<4>(codes, code_pos, n_samples, n_chans_, n_chans_,
+                        predictor_.data(), step_index_.data(), samples);
+    } else {
+        for (size_t c = 0; c < n_chans_; c += 8) {
+            decode_group<8>(codes, code_pos + c, n_samples, n_chans_,
+                            std::min<size_t>(8, n_chans_ - c), predictor_.data() + c,
+                            step_index_.data() + c, samples ? samples + c : NULL);
+        }
+    }
+
+    frame_off_ += n_samples;
+
+    stream_pos_ += (packet::stream_timestamp_t)n_samples;
+    stream_avail_ -= (packet::stream_timestamp_t)n_samples;
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/adpcm_decoder.h
+//! @brief ADPCM decoder.
+
+#ifndef ROC_AUDIO_ADPCM_DECODER_H_
+#define ROC_AUDIO_ADPCM_DECODER_H_
+
+#include "roc_audio/iframe_decoder.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/array.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+
+namespace roc {
+namespace audio {
+
+//! ADPCM decoder.
+//!
+//! Decodes frames produced by AdpcmEncoder, see adpcm_format.h for details.
+//! Predictor state is initialized from frame header, so frames can be
+//! decoded in any order. Samples are decoded on the fly by read() and
+//! shift(); like the encoder, channels are decoded in parallel.
+class AdpcmDecoder : public IFrameDecoder, public core::NonCopyable<> {
+public:
+    //! Construction function.
+    static IFrameDecoder* construct(core::IArena& arena, const SampleSpec& sample_spec);
+
+    //! Initialize.
+    AdpcmDecoder(const SampleSpec& sample_spec, core::IArena& arena);
+
+    //! Get current stream position.
+    virtual packet::stream_timestamp_t position() const;
+
+    //! Get number of samples available for decoding.
+    virtual packet::stream_timestamp_t available() const;
+
+    //! Get number of samples per channel, that can be decoded from given frame.
+    virtual size_t decoded_sample_count(const void* frame_data, size_t frame_size) const;
+
+    //! Start decoding a new frame.
+    virtual void begin(packet::stream_timestamp_t frame_position,
+                       const void* frame_data,
+                       size_t frame_size);
+
+    //! Read samples from current frame.
+    virtual size_t read(sample_t* samples, size_t n_samples);
+
+    //! Shift samples from current frame.
+    virtual size_t shift(size_t n_samples);
+
+    //! Finish decoding current frame.
+    virtual void end();
+
+private:
+    bool read_headers_(const uint8_t* frame_data, size_t frame_size);
+    void decode_(sample_t* samples, size_t n_samples);
+
+    const size_t n_chans_;
+
+    core::Array<int32_t, 8> predictor_;
+    core::Array<int32_t, 8> step_index_;
+
+    packet::stream_timestamp_t stream_pos_;
+    packet::stream_timestamp_t stream_avail_;
+
+    const uint8_t* frame_data_;
+    size_t frame_off_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_ADPCM_DECODER_H_
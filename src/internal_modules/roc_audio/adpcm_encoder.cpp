@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/adpcm_encoder.h"
+#include "roc_audio/adpcm_format.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+using namespace adpcm;
+
+namespace {
+
+// Encode group of up to Lanes channels.
+// Loops over lanes are branchless and have fixed length, so that compiler can
+// keep state of all channels in vector registers and encode them at once.
+template <size_t Lanes>
+void encode_group(const sample_t* samples,
+                  size_t n_samples,
+                  size_t n_chans,
+                  size_t n_group_chans,
+                  int32_t* predictor,
+                  int32_t* step_index,
+                  uint8_t* codes,
+                  size_t code_pos) {
+    int32_t pred[Lanes] = {};
+    int32_t index[Lanes] = {};
+
+    for (size_t l = 0; l < n_group_chans; l++) {
+        pred[l] = predictor[l];
+        index[l] = step_index[l];
+    }
+
+    for (size_t i = 0; i < n_samples; i++) {
+        int32_t x[Lanes] = {};
+        int32_t code[Lanes];
+
+        for (size_t l = 0; l < n_group_chans; l++) {
+            x[l] = quantize_sample(samples[i * n_chans + l]);
+        }
+
+        for (size_t l = 0; l < Lanes; l++) {
+            int32_t step = StepTable[index[l]];
+            int32_t diff = x[l] - pred[l];
+
+            const int32_t sign = diff < 0 ? 8 : 0;
+            diff = diff < 0 ? -diff : diff;
+
+            int32_t c = 0;
+            int32_t vpdiff = step >> 3;
+
+            const bool b2 = diff >= step;
+            c |= b2 ? 4 : 0;
+            diff -= b2 ? step : 0;
+            vpdiff += b2 ? step : 0;
+            step >>= 1;
+
+            const bool b1 = diff >= step;
+            c |= b1 ? 2 : 0;
+            diff -= b1 ? step : 0;
+            vpdiff += b1 ? step : 0;
+            step >>= 1;
+
+            const bool b0 = diff >= step;
+            c |= b0 ? 1 : 0;
+            vpdiff += b0 ? step : 0;
+
+            pred[l] += sign ? -vpdiff : vpdiff;
+            index[l] += IndexTable[c];
+            clamp_state(pred[l], index[l]);
+
+            code[l] = c | sign;
+        }
+
+        for (size_t l = 0; l < n_group_chans; l++) {
+            const size_t pos = code_pos + i * n_chans + l;
+            uint8_t& byte = codes[pos >> 1];
+
+            byte = (pos & 1) ? uint8_t((byte & 0x0f) | (code[l] << 4))
+                             : uint8_t((byte & 0xf0) | code[l]);
+        }
+    }
+
+    for (size_t l = 0; l < n_group_chans; l++) {
+        predictor[l] = pred[l];
+        step_index[l] = index[l];
+    }
+}
+
+} // namespace
+
+IFrameEncoder* AdpcmEncoder::construct(core::IArena& arena,
+                                       const SampleSpec& sample_spec) {
+    return new (arena) AdpcmEncoder(sample_spec, arena);
+}
+
+AdpcmEncoder::AdpcmEncoder(const SampleSpec& sample_spec, core::IArena& arena)
+    : n_chans_(sample_spec.num_channels())
+    , predictor_(arena)
+    , step_index_(arena)
+    , frame_data_(NULL)
+    , frame_byte_size_(0)
+    , frame_n_samples_(0)
+    , frame_max_samples_(0) {
+    if (!predictor_.resize(n_chans_) || !step_index_.resize(n_chans_)) {
+        roc_panic("adpcm encoder: can't allocate state: n_chans=%lu",
+                  (unsigned long)n_chans_);
+    }
+
+    for (size_t c = 0; c < n_chans_; c++) {
+        predictor_[c] = 0;
+        step_index_[c] = 0;
+    }
+}
+
+size_t AdpcmEncoder::encoded_byte_count(size_t num_samples) const {
+    return frame_size(num_samples, n_chans_);
+}
+
+void AdpcmEncoder::begin(void* frame_data, size_t frame_size) {
+    roc_panic_if_not(frame_data);
+
+    if (frame_data_) {
+        roc_panic("adpcm encoder: unpaired begin/end");
+    }
+
+    roc_panic_if_msg(frame_size < encoded_byte_count(0),
+                     "adpcm encoder: frame is too small for header: size=%lu",
+                     (unsigned long)frame_size);
+
+    frame_data_ = (uint8_t*)frame_data;
+    frame_byte_size_ = frame_size;
+    frame_n_samples_ = 0;
+    frame_max_samples_ = max_frame_samples(frame_size, n_chans_);
+}
+
+size_t AdpcmEncoder::write(const sample_t* samples, size_t n_samples) {
+    if (!frame_data_) {
+        roc_panic("adpcm encoder: write should be called only between begin/end");
+    }
+
+    if (n_samples > frame_max_samples_ - frame_n_samples_) {
+        n_samples = frame_max_samples_ - frame_n_samples_;
+    }
+
+    if (n_samples == 0) {
+        return 0;
+    }
+
+    if (frame_n_samples_ == 0) {
+        write_headers_(samples);
+    }
+
+    uint8_t* codes = frame_data_ + encoded_byte_count(0);
+    const size_t code_pos = frame_n_samples_ * n_chans_;
+
+    if (n_chans_ == 1) {
+        encode_group<1>(samples, n_samples, n_chans_, 1, predictor_.data(),
+                        step_index_.data(), codes, code_pos);
+    } else if (n_chans_ == 2) {
+        encode_group<2>(samples, n_samples, n_chans_, 2, predictor_.data(),
+                        step_index_.data(), codes, code_pos);
+    } else if (n_chans_ <= 4) {
+        encode_group<4>(samples, n_samples, n_chans_, n_chans_, predictor_.data(),
+                        step_index_.data(), codes, code_pos);
+    } else {
+        for (size_t c = 0; c < n_chans_; c += 8) {
+            encode_group<8>(samples + c, n_samples, n_chans_,
+                            std::min<size_t>(8, n_chans_ - c), predictor_.data() + c,
+                            step_index_.data() + c, codes, code_pos + c);
+        }
+    }
+
+    frame_n_samples_ += n_samples;
+
+    return n_samples;
+}
+
+size_t AdpcmEncoder::end() {
+    if (!frame_data_) {
+        roc_panic("adpcm encoder: unpaired begin/end");
+    }
+
+    if (frame_n_samples_ == 0) {
+        write_headers_(NULL);
+    }
+
+    frame_data_[0] = uint8_t(frame_n_samples_ >> 8);
+    frame_data_[1] = uint8_t(frame_n_samples_);
+
+    const size_t n_codes = frame_n_samples_ * n_chans_;
+    if (n_codes % 2 != 0) {
+        frame_data_[encoded_byte_count(0) + n_codes / 2] &= 0x0f;
+    }
+
+    const size_t written_byte_count = encoded_byte_count(frame_n_samples_);
+    roc_panic_if_not(written_byte_count <= frame_byte_size_);
+
+    frame_data_ = NULL;
+    frame_byte_size_ = 0;
+    frame_n_samples_ = 0;
+    frame_max_samples_ = 0;
+
+    return written_byte_count;
+}
+
+// Reset predictors to the first sample of the frame and store state of
+// all channels in frame, so that decoder doesn't need previous frames.
+void AdpcmEncoder::write_headers_(const sample_t* samples) {
+    uint8_t* header = frame_data_ + FrameHeaderSize;
+
+    for (size_t c = 0; c < n_chans_; c++) {
+        predictor_[c] = samples ? quantize_sample(samples[c]) : 0;
+
+        const uint16_t pred = (uint16_t)(int16_t)predictor_[c];
+
+        header[0] = uint8_t(pred >> 8);
+        header[1] = uint8_t(pred);
+        header[2] = uint8_t(step_index_[c]);
+        header[3] = 0;
+
+        header += ChannelHeaderSize;
+    }
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/adpcm_encoder.h
+//! @brief ADPCM encoder.
+
+#ifndef ROC_AUDIO_ADPCM_ENCODER_H_
+#define ROC_AUDIO_ADPCM_ENCODER_H_
+
+#include "roc_audio/iframe_encoder.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/array.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+
+namespace roc {
+namespace audio {
+
+//! ADPCM encoder.
+//!
+//! Encodes samples using IMA ADPCM, 4 bits per sample, see adpcm_format.h
+//! for details.
+//!
+//! Predictor is reset at the beginning of every frame to the first sample,
+//! and its state is stored in frame header, so frames can be decoded
+//! independently. Step index is carried over between frames.
+//!
+//! Channels are encoded in parallel: the encoding loop processes a group of
+//! channels at once using branchless code, which compiler maps to SIMD
+//! instructions.
+class AdpcmEncoder : public IFrameEncoder, public core::NonCopyable<> {
+public:
+    //! Construction function.
+    static IFrameEncoder* construct(core::IArena& arena, const SampleSpec& sample_spec);
+
+    //! Initialize.
+    AdpcmEncoder(const SampleSpec& sample_spec, core::IArena& arena);
+
+    //! Get encoded frame size in bytes for given number of samples per channel.
+    virtual size_t encoded_byte_count(size_t num_samples) const;
+
+    //! Start encoding a new frame.
+    virtual void begin(void* frame, size_t frame_size);
+
+    //! Encode samples.
+    virtual size_t write(const sample_t* samples, size_t n_samples);
+
+    //! Finish encoding frame.
+    virtual size_t end();
+
+private:
+    void write_headers_(const sample_t* samples);
+
+    const size_t n_chans_;
+
+    core::Array<int32_t, 8> predictor_;
+    core::Array<int32_t, 8> step_index_;
+
+    uint8_t* frame_data_;
+    size_t frame_byte_size_;
+    size_t frame_n_samples_;
+    size_t frame_max_samples_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_ADPCM_ENCODER_H_
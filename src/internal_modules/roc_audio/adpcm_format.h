@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/adpcm_format.h
+//! @brief ADPCM codec bitstream definitions.
+
+#ifndef ROC_AUDIO_ADPCM_FORMAT_H_
+#define ROC_AUDIO_ADPCM_FORMAT_H_
+
+#include "roc_audio/sample.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! ADPCM codec bitstream definitions.
+//!
+//! The format is IMA ADPCM (4 bits per sample), with packet framing similar
+//! to IMA ADPCM blocks in WAV files. Every frame starts with predictor state
+//! for every channel, so that decoder doesn't depend on previous packets.
+//!
+//! Frame layout:
+//! @code
+//!  +-------------+------------------+-----+--------------------+--------+
+//!  | num samples | channel header 0 | ... | channel header N-1 | codes  |
+//!  |  (16 bit)   |    (32 bit)      |     |     (32 bit)       |        |
+//!  +-------------+------------------+-----+--------------------+--------+
+//! @endcode
+//!
+//! Channel header consists of 16-bit signed predictor, 8-bit step index, and
+//! 8-bit reserved field (zero).
+//!
+//! Codes are 4-bit, interleaved in the same order as samples, e.g. two channels
+//! are coded as "L R L R ...". Each byte holds two codes, first one in the low
+//! nibble. If the number of codes is odd, the last high nibble is zero.
+//!
+//! All fields are big-endian.
+namespace adpcm {
+
+//! Frame header size, in bytes.
+const size_t FrameHeaderSize = 2;
+
+//! Channel header size, in bytes.
+const size_t ChannelHeaderSize = 4;
+
+//! Maximum number of samples per channel in frame.
+const size_t MaxSamples = 0xffff;
+
+//! Maximum step index.
+const int32_t MaxStepIndex = 88;
+
+//! Quantization step for every step index.
+extern const int32_t StepTable[MaxStepIndex + 1];
+
+//! Step index adjustment for every code.
+extern const int32_t IndexTable[16];
+
+//! Get frame size for given number of samples per channel.
+inline size_t frame_size(size_t n_samples, size_t n_chans) {
+    return FrameHeaderSize + n_chans * ChannelHeaderSize + (n_samples * n_chans + 1) / 2;
+}
+
+//! Get maximum number of samples per channel that fit into frame of given size.
+inline size_t max_frame_samples(size_t frame_size, size_t n_chans) {
+    const size_t header_size = FrameHeaderSize + n_chans * ChannelHeaderSize;
+    if (frame_size <= header_size) {
+        return 0;
+    }
+    const size_t n_samples = (frame_size - header_size) * 2 / n_chans;
+    return n_samples < MaxSamples ? n_samples : MaxSamples;
+}
+
+//! Convert sample to 16-bit integer, with clamping and rounding.
+inline int32_t quantize_sample(sample_t s) {
+    s *= 32768;
+    if (s >= 32767) {
+        return 32767;
+    }
+    if (s <= -32768) {
+        return -32768;
+    }
+    return (int32_t)(s >= 0 ? s + sample_t(0.5) : s - sample_t(0.5));
+}
+
+//! Convert 16-bit integer to sample.
+inline sample_t dequantize_sample(int32_t s) {
+    return sample_t(s) / 32768;
+}
+
+//! Clamp predictor and step index after update.
+inline void clamp_state(int32_t& predictor, int32_t& step_index) {
+    predictor = predictor < -32768 ? -32768 : predictor;
+    predictor = predictor > 32767 ? 32767 : predictor;
+    step_index = step_index < 0 ? 0 : step_index;
+    step_index = step_index > MaxStepIndex ? MaxStepIndex : step_index;
+}
+
+} // namespace adpcm
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_ADPCM_FORMAT_H_
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/beep_plc.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+BeepPlc::BeepPlc(const SampleSpec& sample_spec)
+    : sample_spec_(sample_spec) {
+}
+
+void BeepPlc::process_history(sample_t*, size_t) {
+}
+
+void BeepPlc::process_loss(sample_t* samples, size_t n_samples) {
+    const size_t n_total = n_samples * sample_spec_.num_channels();
+
+    for (size_t n = 0; n < n_total; n++) {
+        samples[n] = (sample_t)std::sin(2 * M_PI / 44100 * 880 * n);
+    }
+}
+
+} // namespace audio
+} // namespace roc
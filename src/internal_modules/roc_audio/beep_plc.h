@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/beep_plc.h
+//! @brief Beep PLC.
+
+#ifndef ROC_AUDIO_BEEP_PLC_H_
+#define ROC_AUDIO_BEEP_PLC_H_
+
+#include "roc_audio/iplc.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/noncopyable.h"
+
+namespace roc {
+namespace audio {
+
+//! Beep PLC.
+//! @remarks
+//!  Fills lost samples with weird beeps. Useful for debugging.
+class BeepPlc : public IPlc, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    explicit BeepPlc(const SampleSpec& sample_spec);
+
+    //! Process samples decoded from packets.
+    virtual void process_history(sample_t* samples, size_t n_samples);
+
+    //! Fill lost samples.
+    virtual void process_loss(sample_t* samples, size_t n_samples);
+
+private:
+    const SampleSpec sample_spec_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_BEEP_PLC_H_
@@ -7,6 +7,8 @@
  */
 
 #include "roc_audio/builtin_resampler.h"
+#include "roc_audio/integer_ops.h"
+#include "roc_audio/sample_layout.h"
 #include "roc_audio/sample_spec_to_str.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
@@ -76,6 +78,44 @@ inline size_t calc_bits(size_t n) {
     return c;
 }
 
+// Number of fractional bits in fixed point sinc weights.
+// Weights don't exceed 1, so for 16-bit samples products fit 32 bits, and for
+// 32-bit samples sums of products over any window fit 64 bits.
+const int S16WeightBits = 15;
+const int S32WeightBits = 24;
+
+// Convert float weight to fixed point with given number of fractional bits.
+template <class T>
+inline T quantize_weight(sample_t weight, int bits, int32_t max_value) {
+    const sample_t scaled = weight * (sample_t)((int32_t)1 << bits);
+
+    int32_t value = (int32_t)(scaled + (scaled >= 0 ? 0.5f : -0.5f));
+    value = std::min(value, max_value);
+    value = std::max(value, -max_value);
+
+    return (T)value;
+}
+
+// Convert dot product accumulator back to sample, with rounding and saturation.
+template <class T>
+inline T dequantize_sample(int64_t acc, int bits, int64_t min_value, int64_t max_value) {
+    int64_t value = (acc + ((int64_t)1 << (bits - 1))) >> bits;
+    value = std::min(value, max_value);
+    value = std::max(value, min_value);
+
+    return (T)value;
+}
+
+// Split interleaved samples into planes of n_samples.
+template <class T>
+void deinterleave_integer(const T* in, T* out, size_t n_samples, size_t n_chans) {
+    for (size_t ch = 0; ch < n_chans; ch++) {
+        for (size_t ns = 0; ns < n_samples; ns++) {
+            out[ch * n_samples + ns] = in[ns * n_chans + ch];
+        }
+    }
+}
+
 inline size_t get_window_interp(ResamplerProfile profile) {
     switch (profile) {
     case ResamplerProfile_Low:
@@ -112,23 +152,43 @@ inline size_t get_frame_size(size_t window_size,
     const float scaling =
         (float)in_spec.sample_rate() / (float)out_spec.sample_rate() * 1.5f;
 
-    return (size_t)std::ceil(window_size * scaling);
+    const size_t frame_size = (size_t)std::ceil(window_size * scaling);
+
+    if (in_spec.sample_layout() == SampleLayout_Planar) {
+        // Keep every plane of input frame aligned.
+        return plane_stride(frame_size);
+    }
+
+    return frame_size;
 }
 
 } // namespace
 
 BuiltinResampler::BuiltinResampler(core::IArena& arena,
                                    FrameFactory& frame_factory,
+                                   SincTableMap& sinc_table_map,
                                    ResamplerProfile profile,
                                    const SampleSpec& in_spec,
                                    const SampleSpec& out_spec)
     : IResampler(arena)
     , in_spec_(in_spec)
     , out_spec_(out_spec)
+    , planar_(in_spec.sample_layout() == SampleLayout_Planar)
+    , integer_(is_integer_spec(in_spec))
+    , integer_format_(in_spec.pcm_format())
+    , integer_input_frame_(0)
     , n_ready_frames_(0)
     , prev_frame_(NULL)
     , curr_frame_(NULL)
     , next_frame_(NULL)
+    , window_(arena)
+    , window_prev_begin_(0)
+    , window_prev_size_(0)
+    , window_curr_begin_(0)
+    , window_curr_size_(0)
+    , window_next_size_(0)
+    , window_s16_(arena)
+    , window_s32_(arena)
     , scaling_(1.0)
     , window_size_(get_window_size(profile))
     , qt_half_sinc_window_size_(float_to_fixedpoint(window_size_))
@@ -136,7 +196,6 @@ BuiltinResampler::BuiltinResampler(core::IArena& arena,
     , window_interp_bits_(calc_bits(window_interp_))
     , frame_size_ch_(get_frame_size(window_size_, in_spec, out_spec))
     , frame_size_(frame_size_ch_ * in_spec.num_channels())
-    , sinc_table_(arena)
     , sinc_table_ptr_(NULL)
     , qt_half_window_size_(float_to_fixedpoint((float)window_size_ / scaling_))
     , qt_epsilon_(float_to_fixedpoint(5e-8f))
@@ -157,7 +216,7 @@ BuiltinResampler::BuiltinResampler(core::IArena& arena,
         return;
     }
 
-    if (!fill_sinc_()) {
+    if (!init_sinc_(sinc_table_map)) {
         return;
     }
 
@@ -165,6 +224,10 @@ BuiltinResampler::BuiltinResampler(core::IArena& arena,
         return;
     }
 
+    if (integer_ && !alloc_integer_buffers_(frame_factory)) {
+        return;
+    }
+
     valid_ = true;
 }
 
@@ -239,19 +302,25 @@ bool BuiltinResampler::set_scaling(size_t input_sample_rate,
 }
 
 const core::Slice<sample_t>& BuiltinResampler::begin_push_input() {
-    if (n_ready_frames_ < 3) {
-        return frames_[n_ready_frames_];
-    }
+    roc_panic_if_msg(integer_,
+                     "builtin resampler: use begin_push_integer_input() for integer");
 
-    core::Slice<sample_t> new_last_frame = frames_[0];
-    frames_[0] = frames_[1];
-    frames_[1] = frames_[2];
-    frames_[2] = new_last_frame;
+    return frames_[rotate_frames_()];
+}
+
+const core::Slice<uint8_t>& BuiltinResampler::begin_push_integer_input() {
+    roc_panic_if_msg(!integer_, "builtin resampler: use begin_push_input() for raw");
 
-    return frames_[2];
+    integer_input_frame_ = rotate_frames_();
+
+    return integer_input_;
 }
 
 void BuiltinResampler::end_push_input() {
+    if (integer_) {
+        deinterleave_integer_input_(integer_input_frame_);
+    }
+
     prev_frame_ = frames_[0].data();
     curr_frame_ = frames_[1].data();
     next_frame_ = frames_[2].data();
@@ -266,6 +335,10 @@ void BuiltinResampler::end_push_input() {
 }
 
 size_t BuiltinResampler::pop_output(sample_t* out_data, size_t out_size) {
+    roc_panic_if_msg(planar_, "builtin resampler: use pop_planar_output() for planar");
+    roc_panic_if_msg(integer_,
+                     "builtin resampler: use pop_integer_output() for integer");
+
     if (n_ready_frames_ < 3) {
         return 0;
     }
@@ -277,12 +350,7 @@ size_t BuiltinResampler::pop_output(sample_t* out_data, size_t out_size) {
             break;
         }
 
-        if ((qt_sample_ & FRACT_PART_MASK) < qt_epsilon_) {
-            qt_sample_ &= INTEGER_PART_MASK;
-        } else if ((qt_one - (qt_sample_ & FRACT_PART_MASK)) < qt_epsilon_) {
-            qt_sample_ &= INTEGER_PART_MASK;
-            qt_sample_ += qt_one;
-        }
+        advance_sample_();
 
         for (size_t channel = 0; channel < in_spec_.num_channels(); ++channel) {
             out_data[out_pos + channel] = resample_(channel);
@@ -293,28 +361,169 @@ size_t BuiltinResampler::pop_output(sample_t* out_data, size_t out_size) {
     return out_pos;
 }
 
+size_t BuiltinResampler::pop_planar_output(sample_t* out_planes,
+                                           size_t out_stride,
+                                           size_t out_size) {
+    roc_panic_if_msg(!planar_, "builtin resampler: use pop_output() for interleaved");
+    roc_panic_if_msg(in_spec_.num_channels() > 1 && out_stride < out_size,
+                     "builtin resampler: output stride is less than output size");
+
+    if (n_ready_frames_ < 3) {
+        return 0;
+    }
+
+    size_t out_pos = 0;
+
+    for (; out_pos < out_size; out_pos++) {
+        if (qt_sample_ >= qt_frame_size_) {
+            break;
+        }
+
+        advance_sample_();
+
+        for (size_t channel = 0; channel < in_spec_.num_channels(); ++channel) {
+            out_planes[channel * out_stride + out_pos] = resample_planar_(channel);
+        }
+        qt_sample_ += qt_dt_;
+    }
+
+    return out_pos;
+}
+
+size_t BuiltinResampler::pop_integer_output(void* out_data, size_t out_size) {
+    roc_panic_if_msg(!integer_, "builtin resampler: use pop_output() for raw");
+
+    if (n_ready_frames_ < 3) {
+        return 0;
+    }
+
+    const size_t num_ch = in_spec_.num_channels();
+
+    size_t out_pos = 0;
+
+    for (; out_pos < out_size; out_pos += num_ch) {
+        if (qt_sample_ >= qt_frame_size_) {
+            break;
+        }
+
+        advance_sample_();
+        quantize_window_();
+
+        if (integer_format_ == PcmFormat_SInt16) {
+            int16_t* out_samples = (int16_t*)out_data + out_pos;
+            for (size_t channel = 0; channel < num_ch; ++channel) {
+                out_samples[channel] = resample_s16_(channel);
+            }
+        } else {
+            int32_t* out_samples = (int32_t*)out_data + out_pos;
+            for (size_t channel = 0; channel < num_ch; ++channel) {
+                out_samples[channel] = resample_s32_(channel);
+            }
+        }
+        qt_sample_ += qt_dt_;
+    }
+
+    return out_pos;
+}
+
 float BuiltinResampler::n_left_to_process() const {
     return fixedpoint_to_float(2 * qt_frame_size_ - qt_sample_) * in_spec_.num_channels();
 }
 
+size_t BuiltinResampler::rotate_frames_() {
+    if (n_ready_frames_ < 3) {
+        return n_ready_frames_;
+    }
+
+    core::Slice<sample_t> new_last_frame = frames_[0];
+    frames_[0] = frames_[1];
+    frames_[1] = frames_[2];
+    frames_[2] = new_last_frame;
+
+    return 2;
+}
+
+void BuiltinResampler::deinterleave_integer_input_(size_t frame_index) {
+    if (integer_format_ == PcmFormat_SInt16) {
+        deinterleave_integer((const int16_t*)integer_input_.data(),
+                             (int16_t*)frames_[frame_index].data(), frame_size_ch_,
+                             in_spec_.num_channels());
+    } else {
+        deinterleave_integer((const int32_t*)integer_input_.data(),
+                             (int32_t*)frames_[frame_index].data(), frame_size_ch_,
+                             in_spec_.num_channels());
+    }
+}
+
 bool BuiltinResampler::alloc_frames_(FrameFactory& frame_factory) {
     for (size_t n = 0; n < ROC_ARRAY_SIZE(frames_); n++) {
-        frames_[n] = frame_factory.new_raw_buffer();
+        frames_[n] =
+            planar_ ? frame_factory.new_planar_buffer() : frame_factory.new_raw_buffer();
 
         if (!frames_[n]) {
             roc_log(LogError, "builtin resampler: can't allocate frame buffer");
             return false;
         }
 
+        if (frames_[n].capacity() < frame_size_) {
+            roc_log(LogError,
+                    "builtin resampler: frame buffer is too small:"
+                    " buffer_size=%lu frame_size=%lu",
+                    (unsigned long)frames_[n].capacity(), (unsigned long)frame_size_);
+            return false;
+        }
+
         frames_[n].reslice(0, frame_size_);
     }
 
+    // Window covers at most every sample of all three frames.
+    if (!window_.resize(frame_size_ch_ * 3)) {
+        roc_log(LogError, "builtin resampler: can't allocate window");
+        return false;
+    }
+
+    return true;
+}
+
+// Frames hold planes of integer samples, which are not larger than raw
+// samples, so frames allocated by alloc_frames_() are reused. Input is
+// pushed into separate interleaved buffer.
+bool BuiltinResampler::alloc_integer_buffers_(FrameFactory& frame_factory) {
+    const size_t input_size = frame_size_ * integer_sample_size(integer_format_);
+
+    integer_input_ = frame_factory.new_byte_buffer();
+    if (!integer_input_) {
+        roc_log(LogError, "builtin resampler: can't allocate input buffer");
+        return false;
+    }
+
+    if (integer_input_.capacity() < input_size) {
+        roc_log(LogError,
+                "builtin resampler: input buffer is too small:"
+                " buffer_size=%lu input_size=%lu",
+                (unsigned long)integer_input_.capacity(), (unsigned long)input_size);
+        return false;
+    }
+
+    integer_input_.reslice(0, input_size);
+
+    const bool ok = integer_format_ == PcmFormat_SInt16
+        ? window_s16_.resize(window_.size())
+        : window_s32_.resize(window_.size());
+
+    if (!ok) {
+        roc_log(LogError, "builtin resampler: can't allocate window");
+        return false;
+    }
+
     return true;
 }
 
 bool BuiltinResampler::check_config_() const {
-    if (!in_spec_.is_valid() || !out_spec_.is_valid() || !in_spec_.is_raw()
-        || !out_spec_.is_raw()) {
+    if (!in_spec_.is_valid() || !out_spec_.is_valid()
+        || (!in_spec_.is_raw() && !is_integer_spec(in_spec_))
+        || in_spec_.sample_format() != out_spec_.sample_format()
+        || in_spec_.pcm_format() != out_spec_.pcm_format()) {
         roc_log(LogError,
                 "builtin resampler: invalid sample spec:"
                 " in_spec=%s out_spec=%s",
@@ -332,6 +541,24 @@ bool BuiltinResampler::check_config_() const {
         return false;
     }
 
+    if (in_spec_.sample_layout() != out_spec_.sample_layout()) {
+        roc_log(LogError,
+                "builtin resampler: input and output layouts should be equal:"
+                " in_spec=%s out_spec=%s",
+                sample_spec_to_str(in_spec_).c_str(),
+                sample_spec_to_str(out_spec_).c_str());
+        return false;
+    }
+
+    if (integer_ && planar_) {
+        roc_log(LogError,
+                "builtin resampler: planar layout is supported only for raw format:"
+                " in_spec=%s out_spec=%s",
+                sample_spec_to_str(in_spec_).c_str(),
+                sample_spec_to_str(out_spec_).c_str());
+        return false;
+    }
+
     if (frame_size_ != frame_size_ch_ * in_spec_.num_channels()) {
         roc_log(LogError,
                 "builtin resampler: frame_size is not multiple of num_channels:"
@@ -364,28 +591,14 @@ bool BuiltinResampler::check_config_() const {
     return true;
 }
 
-bool BuiltinResampler::fill_sinc_() {
-    if (!sinc_table_.resize(window_size_ * window_interp_ + 2)) {
+bool BuiltinResampler::init_sinc_(SincTableMap& sinc_table_map) {
+    sinc_table_ = sinc_table_map.get_table(window_size_, window_interp_);
+    if (!sinc_table_) {
         roc_log(LogError, "builtin resampler: can't allocate sinc table");
         return false;
     }
 
-    const double sinc_step = 1.0 / (double)window_interp_;
-    double sinc_t = sinc_step;
-
-    sinc_table_[0] = 1.0f;
-    for (size_t i = 1; i < sinc_table_.size(); ++i) {
-        const double window = 0.54
-            - 0.46
-                * std::cos(2 * M_PI
-                           * ((double)(i - 1) / 2.0 / (double)sinc_table_.size() + 0.5));
-        sinc_table_[i] = (float)(std::sin(M_PI * sinc_t) / M_PI / sinc_t * window);
-        sinc_t += sinc_step;
-    }
-    sinc_table_[sinc_table_.size() - 2] = 0;
-    sinc_table_[sinc_table_.size() - 1] = 0;
-
-    sinc_table_ptr_ = &sinc_table_[0];
+    sinc_table_ptr_ = sinc_table_->data();
 
     return true;
 }
@@ -396,6 +609,19 @@ bool BuiltinResampler::fill_sinc_() {
 // During going through input signal window only integer part of argument changes,
 // that's why there are two arguments in this function: integer part and fractional
 // part of time coordinate.
+// Snaps position of output sample to integer if it's very close to it,
+// and computes window for it.
+void BuiltinResampler::advance_sample_() {
+    if ((qt_sample_ & FRACT_PART_MASK) < qt_epsilon_) {
+        qt_sample_ &= INTEGER_PART_MASK;
+    } else if ((qt_one - (qt_sample_ & FRACT_PART_MASK)) < qt_epsilon_) {
+        qt_sample_ &= INTEGER_PART_MASK;
+        qt_sample_ += qt_one;
+    }
+
+    compute_window_();
+}
+
 sample_t BuiltinResampler::sinc_(const fixedpoint_t x, const float fract_x) {
     const size_t index = (x >> (FRACT_BIT_COUNT - window_interp_bits_));
 
@@ -407,7 +633,7 @@ sample_t BuiltinResampler::sinc_(const fixedpoint_t x, const float fract_x) {
     return scaling_ > 1.0f ? result / scaling_ : result;
 }
 
-sample_t BuiltinResampler::resample_(const size_t channel_offset) {
+void BuiltinResampler::compute_window_() {
     roc_panic_if_msg(qt_sinc_step_ == 0,
                      "builtin resampler:"
                      " set_scaling() must be called before any resampling could be done");
@@ -415,40 +641,33 @@ sample_t BuiltinResampler::resample_(const size_t channel_offset) {
     size_t ind_begin_prev;
 
     // Window lasts till that index.
-    const size_t ind_end_prev = channelize_index(frame_size_ch_, channel_offset);
+    const size_t ind_end_prev = frame_size_ch_;
 
     size_t ind_begin_cur;
     size_t ind_end_cur;
 
-    const size_t ind_begin_next = channelize_index(0, channel_offset);
     size_t ind_end_next;
 
     ind_begin_prev = (qt_sample_ >= qt_half_window_size_)
         ? frame_size_ch_
         : fixedpoint_to_size(qceil(qt_sample_ + (qt_frame_size_ - qt_half_window_size_)));
-    // ind_begin_prev is comparable with channel_len_ till we'll convert it to channalyzed
-    // presentation.
     roc_panic_if(ind_begin_prev > frame_size_ch_);
-    ind_begin_prev = channelize_index(ind_begin_prev, channel_offset);
 
     ind_begin_cur = (qt_sample_ >= qt_half_window_size_)
         ? fixedpoint_to_size(qceil(qt_sample_ - qt_half_window_size_))
         : 0;
     roc_panic_if(ind_begin_cur > frame_size_ch_);
-    ind_begin_cur = channelize_index(ind_begin_cur, channel_offset);
 
     ind_end_cur = ((qt_sample_ + qt_half_window_size_) > qt_frame_size_)
         ? frame_size_ch_ - 1
         : fixedpoint_to_size(qfloor(qt_sample_ + qt_half_window_size_));
     roc_panic_if(ind_end_cur > frame_size_ch_);
-    ind_end_cur = channelize_index(ind_end_cur, channel_offset);
 
     ind_end_next = ((qt_sample_ + qt_half_window_size_) > qt_frame_size_)
         ? fixedpoint_to_size(qfloor(qt_sample_ + qt_half_window_size_ - qt_frame_size_))
             + 1
         : 0;
     roc_panic_if(ind_end_next > frame_size_ch_);
-    ind_end_next = channelize_index(ind_end_next, channel_offset);
 
     // Counter inside window.
     // t_sinc = (t_sample - ceil( t_sample - window_len/cutoff*scale )) * sinc_step
@@ -465,29 +684,32 @@ sample_t BuiltinResampler::resample_(const size_t channel_offset) {
     // Compute fractional part of time position at the beginning. It wont change during
     // the run.
     float f_sinc_cur_fract = fractional(qt_sinc_cur << window_interp_bits_);
-    sample_t accumulator = 0;
 
+    sample_t* weights = window_.data();
     size_t i;
 
     // Run through previous frame.
-    for (i = ind_begin_prev; i < ind_end_prev; i += in_spec_.num_channels()) {
-        accumulator += prev_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
+    for (i = ind_begin_prev; i < ind_end_prev; i++) {
+        *weights++ = sinc_(qt_sinc_cur, f_sinc_cur_fract);
         qt_sinc_cur -= qt_sinc_inc;
     }
 
+    window_prev_begin_ = ind_begin_prev;
+    window_prev_size_ = ind_end_prev - ind_begin_prev;
+
     // Run through current frame through the left windows side. qt_sinc_cur is decreasing.
     i = ind_begin_cur;
 
-    accumulator += curr_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
+    *weights++ = sinc_(qt_sinc_cur, f_sinc_cur_fract);
     while (qt_sinc_cur >= qt_sinc_step_) {
-        i += in_spec_.num_channels();
+        i++;
         qt_sinc_cur -= qt_sinc_inc;
-        accumulator += curr_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
+        *weights++ = sinc_(qt_sinc_cur, f_sinc_cur_fract);
     }
 
-    i += in_spec_.num_channels();
+    i++;
 
-    roc_panic_if(i > channelize_index(frame_size_ch_, channel_offset));
+    roc_panic_if(i > frame_size_ch_);
 
     // Crossing zero -- we just need to switch qt_sinc_cur.
     // -1 ------------ 0 ------------- +1
@@ -498,19 +720,145 @@ sample_t BuiltinResampler::resample_(const size_t channel_offset) {
     f_sinc_cur_fract = fractional(qt_sinc_cur << window_interp_bits_);
 
     // Run through right side of the window, increasing qt_sinc_cur.
-    for (; i <= ind_end_cur; i += in_spec_.num_channels()) {
-        accumulator += curr_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
+    for (; i <= ind_end_cur; i++) {
+        *weights++ = sinc_(qt_sinc_cur, f_sinc_cur_fract);
         qt_sinc_cur += qt_sinc_inc;
     }
 
+    window_curr_begin_ = ind_begin_cur;
+    window_curr_size_ = i - ind_begin_cur;
+
     // Next frames run.
-    for (i = ind_begin_next; i < ind_end_next; i += in_spec_.num_channels()) {
-        accumulator += next_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
+    for (i = 0; i < ind_end_next; i++) {
+        *weights++ = sinc_(qt_sinc_cur, f_sinc_cur_fract);
         qt_sinc_cur += qt_sinc_inc;
     }
 
+    window_next_size_ = ind_end_next;
+
+    roc_panic_if(weights > window_.data() + window_.size());
+}
+
+sample_t BuiltinResampler::resample_(const size_t channel) const {
+    const size_t num_ch = in_spec_.num_channels();
+
+    const sample_t* prev = prev_frame_ + window_prev_begin_ * num_ch + channel;
+    const sample_t* curr = curr_frame_ + window_curr_begin_ * num_ch + channel;
+    const sample_t* next = next_frame_ + channel;
+
+    const sample_t* weights = window_.data();
+
+    sample_t accumulator = 0;
+
+    for (size_t n = 0; n < window_prev_size_; n++) {
+        accumulator += prev[n * num_ch] * weights[n];
+    }
+    weights += window_prev_size_;
+
+    for (size_t n = 0; n < window_curr_size_; n++) {
+        accumulator += curr[n * num_ch] * weights[n];
+    }
+    weights += window_curr_size_;
+
+    for (size_t n = 0; n < window_next_size_; n++) {
+        accumulator += next[n * num_ch] * weights[n];
+    }
+
     return accumulator;
 }
 
+// Planes of every frame are frame_size_ch_ samples apart, so the loops are
+// over contiguous memory.
+sample_t BuiltinResampler::resample_planar_(const size_t channel) const {
+    const size_t plane_offset = channel * frame_size_ch_;
+
+    const sample_t* prev = prev_frame_ + plane_offset + window_prev_begin_;
+    const sample_t* curr = curr_frame_ + plane_offset + window_curr_begin_;
+    const sample_t* next = next_frame_ + plane_offset;
+
+    const sample_t* weights = window_.data();
+
+    sample_t accumulator = 0;
+
+    for (size_t n = 0; n < window_prev_size_; n++) {
+        accumulator += prev[n] * weights[n];
+    }
+    weights += window_prev_size_;
+
+    for (size_t n = 0; n < window_curr_size_; n++) {
+        accumulator += curr[n] * weights[n];
+    }
+    weights += window_curr_size_;
+
+    for (size_t n = 0; n < window_next_size_; n++) {
+        accumulator += next[n] * weights[n];
+    }
+
+    return accumulator;
+}
+
+void BuiltinResampler::quantize_window_() {
+    const size_t n_weights = window_prev_size_ + window_curr_size_ + window_next_size_;
+    roc_panic_if(n_weights > window_.size());
+
+    const sample_t* weights = window_.data();
+
+    if (integer_format_ == PcmFormat_SInt16) {
+        int16_t* int_weights = window_s16_.data();
+        for (size_t n = 0; n < n_weights; n++) {
+            int_weights[n] =
+                quantize_weight<int16_t>(weights[n], S16WeightBits, INT16_MAX);
+        }
+    } else {
+        int32_t* int_weights = window_s32_.data();
+        for (size_t n = 0; n < n_weights; n++) {
+            int_weights[n] = quantize_weight<int32_t>(weights[n], S32WeightBits,
+                                                      (int32_t)1 << S32WeightBits);
+        }
+    }
+}
+
+// Frames hold planes of frame_size_ch_ samples, so the dot products are
+// over contiguous memory.
+int16_t BuiltinResampler::resample_s16_(const size_t channel) const {
+    const size_t plane_offset = channel * frame_size_ch_;
+
+    const int16_t* prev = (const int16_t*)prev_frame_ + plane_offset + window_prev_begin_;
+    const int16_t* curr = (const int16_t*)curr_frame_ + plane_offset + window_curr_begin_;
+    const int16_t* next = (const int16_t*)next_frame_ + plane_offset;
+
+    const int16_t* weights = window_s16_.data();
+
+    int64_t accumulator = dot_s16(prev, weights, window_prev_size_);
+    weights += window_prev_size_;
+
+    accumulator += dot_s16(curr, weights, window_curr_size_);
+    weights += window_curr_size_;
+
+    accumulator += dot_s16(next, weights, window_next_size_);
+
+    return dequantize_sample<int16_t>(accumulator, S16WeightBits, INT16_MIN, INT16_MAX);
+}
+
+int32_t BuiltinResampler::resample_s32_(const size_t channel) const {
+    const size_t plane_offset = channel * frame_size_ch_;
+
+    const int32_t* prev = (const int32_t*)prev_frame_ + plane_offset + window_prev_begin_;
+    const int32_t* curr = (const int32_t*)curr_frame_ + plane_offset + window_curr_begin_;
+    const int32_t* next = (const int32_t*)next_frame_ + plane_offset;
+
+    const int32_t* weights = window_s32_.data();
+
+    int64_t accumulator = dot_s32(prev, weights, window_prev_size_);
+    weights += window_prev_size_;
+
+    accumulator += dot_s32(curr, weights, window_curr_size_);
+    weights += window_curr_size_;
+
+    accumulator += dot_s32(next, weights, window_next_size_);
+
+    return dequantize_sample<int32_t>(accumulator, S32WeightBits, INT32_MIN, INT32_MAX);
+}
+
 } // namespace audio
 } // namespace roc
@@ -19,8 +19,11 @@
 #include "roc_audio/resampler_config.h"
 #include "roc_audio/sample.h"
 #include "roc_audio/sample_spec.h"
+#include "roc_audio/sinc_table.h"
+#include "roc_audio/sinc_table_map.h"
 #include "roc_core/array.h"
 #include "roc_core/noncopyable.h"
+#include "roc_core/shared_ptr.h"
 #include "roc_core/slice.h"
 #include "roc_core/stddefs.h"
 #include "roc_packet/units.h"
@@ -36,11 +39,26 @@ namespace audio {
 //!
 //! This backend is quite CPU-hungry, but it maintains requested scaling
 //! factor with very high precision.
+//!
+//! Sinc window is computed once per output sample and then applied to every
+//! channel, so the cost of additional channels is a dot product per channel.
+//!
+//! If sample spec has planar layout, input frames are planar and the dot
+//! product for every channel runs over contiguous plane.
+//!
+//! If sample spec has integer format (see is_integer_format()), input frames
+//! are split into per-channel planes when pushed, sinc window is quantized
+//! to fixed point once per output sample, and dot products are computed in
+//! integer arithmetic (NEON if available) with 64-bit accumulators.
 class BuiltinResampler : public IResampler, public core::NonCopyable<> {
 public:
     //! Initialize.
+    //! @remarks
+    //!  Sinc table is obtained from @p sinc_table_map and is shared with
+    //!  other resamplers using the same profile.
     BuiltinResampler(core::IArena& arena,
                      FrameFactory& frame_factory,
+                     SincTableMap& sinc_table_map,
                      ResamplerProfile profile,
                      const SampleSpec& in_spec,
                      const SampleSpec& out_spec);
@@ -60,14 +78,27 @@ public:
     virtual bool set_scaling(size_t input_rate, size_t output_rate, float multiplier);
 
     //! Get buffer to be filled with input data.
+    //! @remarks
+    //!  If sample spec has planar layout, buffer is aligned and holds one plane
+    //!  per channel, with frame size samples in each plane.
     virtual const core::Slice<sample_t>& begin_push_input();
 
+    //! Get buffer to be filled with input data in integer format.
+    virtual const core::Slice<uint8_t>& begin_push_integer_input();
+
     //! Commit buffer with input data.
     virtual void end_push_input();
 
     //! Read samples from input frame and fill output frame.
     virtual size_t pop_output(sample_t* out_data, size_t out_size);
 
+    //! Read samples from input frame and fill output planes.
+    virtual size_t
+    pop_planar_output(sample_t* out_planes, size_t out_stride, size_t out_size);
+
+    //! Read samples from input frame and fill output frame in integer format.
+    virtual size_t pop_integer_output(void* out_data, size_t out_size);
+
     //! How many samples were pushed but not processed yet.
     virtual float n_left_to_process() const;
 
@@ -77,25 +108,53 @@ private:
     typedef int32_t signed_fixedpoint_t;
     typedef int64_t signed_long_fixedpoint_t;
 
-    inline size_t channelize_index(const size_t i, const size_t ch_offset) const {
-        return i * in_spec_.num_channels() + ch_offset;
-    }
-
     bool alloc_frames_(FrameFactory& frame_factory);
+    bool alloc_integer_buffers_(FrameFactory& frame_factory);
+
+    // Rotates frames if needed and returns index of frame to be filled.
+    size_t rotate_frames_();
+
+    // Splits integer input buffer into planes of given frame.
+    void deinterleave_integer_input_(size_t frame_index);
 
     bool check_config_() const;
 
-    bool fill_sinc_();
+    bool init_sinc_(SincTableMap& sinc_table_map);
     sample_t sinc_(fixedpoint_t x, float fract_x);
 
-    // Computes single sample of the particular audio channel.
-    // channel_offset a serial number of the channel
-    // (e.g. left -- 0, right -- 1, etc.).
-    sample_t resample_(size_t channel_offset);
+    // Computes sinc weights of input samples for current output sample.
+    // Weights don't depend on channel.
+    void compute_window_();
+
+    // Computes single sample of the particular audio channel using weights
+    // from compute_window_().
+    // channel a serial number of the channel (e.g. left -- 0, right -- 1, etc.).
+    sample_t resample_(size_t channel) const;
+
+    // Same as resample_(), but for planar frames.
+    sample_t resample_planar_(size_t channel) const;
+
+    // Converts weights from compute_window_() to fixed point.
+    void quantize_window_();
+
+    // Same as resample_planar_(), but for integer formats.
+    int16_t resample_s16_(size_t channel) const;
+    int32_t resample_s32_(size_t channel) const;
+
+    void advance_sample_();
 
     const SampleSpec in_spec_;
     const SampleSpec out_spec_;
 
+    const bool planar_;
+
+    // If integer, frames_ hold planes of samples in integer format,
+    // and input is pushed via integer_input_.
+    const bool integer_;
+    const PcmFormat integer_format_;
+    core::Slice<uint8_t> integer_input_;
+    size_t integer_input_frame_;
+
     core::Slice<sample_t> frames_[3];
     size_t n_ready_frames_;
 
@@ -103,6 +162,19 @@ private:
     const sample_t* curr_frame_;
     const sample_t* next_frame_;
 
+    // sinc weights for input samples in window of current output sample,
+    // for previous, current and next frames, one after another
+    core::Array<sample_t> window_;
+    size_t window_prev_begin_;
+    size_t window_prev_size_;
+    size_t window_curr_begin_;
+    size_t window_curr_size_;
+    size_t window_next_size_;
+
+    // same weights in fixed point, used for integer formats
+    core::Array<int16_t> window_s16_;
+    core::Array<int32_t> window_s32_;
+
     float scaling_;
 
     const size_t window_size_;
@@ -114,7 +186,8 @@ private:
     const size_t frame_size_ch_;
     const size_t frame_size_;
 
-    core::Array<sample_t> sinc_table_;
+    // shared by all resamplers with same profile
+    core::SharedPtr<SincTable> sinc_table_;
     const sample_t* sinc_table_ptr_;
 
     // half window len in Q8.24 in terms of input signal
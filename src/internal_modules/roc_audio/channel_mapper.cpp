@@ -16,7 +16,8 @@ namespace audio {
 ChannelMapper::ChannelMapper(const ChannelSet& in_chans, const ChannelSet& out_chans)
     : in_chans_(in_chans)
     , out_chans_(out_chans)
-    , map_func_(NULL) {
+    , map_func_(NULL)
+    , map_planar_func_(NULL) {
     if (!in_chans_.is_valid()) {
         roc_panic("channel mapper matrix: invalid input channel set: %s",
                   channel_set_to_str(in_chans_).c_str());
@@ -74,6 +75,30 @@ void ChannelMapper::map(const sample_t* in_samples,
     (this->*map_func_)(in_samples, out_samples, n_samples_per_chan);
 }
 
+void ChannelMapper::map_planar(const sample_t* in_planes,
+                               size_t in_stride,
+                               sample_t* out_planes,
+                               size_t out_stride,
+                               size_t n_samples) {
+    if (!in_planes) {
+        roc_panic("channel mapper: input buffer is null");
+    }
+
+    if (!out_planes) {
+        roc_panic("channel mapper: output buffer is null");
+    }
+
+    if ((in_chans_.num_channels() > 1 && in_stride < n_samples)
+        || (out_chans_.num_channels() > 1 && out_stride < n_samples)) {
+        roc_panic("channel mapper: plane stride is less than plane size:"
+                  " in_stride=%lu out_stride=%lu n_samples=%lu",
+                  (unsigned long)in_stride, (unsigned long)out_stride,
+                  (unsigned long)n_samples);
+    }
+
+    (this->*map_planar_func_)(in_planes, in_stride, out_planes, out_stride, n_samples);
+}
+
 // Map between two surround channel sets.
 // Each output channel is a sum of input channels multiplied by coefficients
 // from the mapping matrix.
@@ -150,6 +175,76 @@ void ChannelMapper::map_multitrack_multitrack_(const sample_t* in_samples,
     }
 }
 
+// Same as map_surround_surround_(), but for planar layout.
+// Every output plane is accumulated from whole input planes, in the same order
+// as in interleaved version, so results are identical.
+void ChannelMapper::map_planar_surround_surround_(const sample_t* in_planes,
+                                                  size_t in_stride,
+                                                  sample_t* out_planes,
+                                                  size_t out_stride,
+                                                  size_t n_samples) {
+    for (size_t out_ch = 0; out_ch < out_chans_.num_channels(); out_ch++) {
+        sample_t* out_plane = out_planes + out_ch * out_stride;
+
+        memset(out_plane, 0, n_samples * sizeof(sample_t));
+
+        for (size_t in_ch = 0; in_ch < in_chans_.num_channels(); in_ch++) {
+            const sample_t* in_plane = in_planes + in_ch * in_stride;
+            const sample_t coeff = map_matrix_.coeff(out_ch, in_ch);
+
+            for (size_t ns = 0; ns < n_samples; ns++) {
+                out_plane[ns] += in_plane[ns] * coeff;
+            }
+        }
+
+        for (size_t ns = 0; ns < n_samples; ns++) {
+            out_plane[ns] = std::min(out_plane[ns], Sample_Max);
+            out_plane[ns] = std::max(out_plane[ns], Sample_Min);
+        }
+    }
+}
+
+// Same as map_multitrack_surround_(), but for planar layout.
+void ChannelMapper::map_planar_multitrack_surround_(const sample_t* in_planes,
+                                                    size_t in_stride,
+                                                    sample_t* out_planes,
+                                                    size_t out_stride,
+                                                    size_t n_samples) {
+    for (size_t out_ch = 0; out_ch < out_chans_.num_channels(); out_ch++) {
+        sample_t* out_plane = out_planes + out_ch * out_stride;
+
+        if (out_ch < in_chans_.num_channels()) {
+            memcpy(out_plane, in_planes + out_ch * in_stride,
+                   n_samples * sizeof(sample_t));
+        } else {
+            memset(out_plane, 0, n_samples * sizeof(sample_t));
+        }
+    }
+}
+
+// Same as map_multitrack_multitrack_(), but for planar layout.
+void ChannelMapper::map_planar_multitrack_multitrack_(const sample_t* in_planes,
+                                                      size_t in_stride,
+                                                      sample_t* out_planes,
+                                                      size_t out_stride,
+                                                      size_t n_samples) {
+    for (size_t ch = inout_chans_.first_channel(); ch <= inout_chans_.last_channel();
+         ch++) {
+        if (out_chans_.has_channel(ch)) {
+            if (in_chans_.has_channel(ch)) {
+                memcpy(out_planes, in_planes, n_samples * sizeof(sample_t));
+            } else {
+                memset(out_planes, 0, n_samples * sizeof(sample_t));
+            }
+            out_planes += out_stride;
+        }
+
+        if (in_chans_.has_channel(ch)) {
+            in_planes += in_stride;
+        }
+    }
+}
+
 void ChannelMapper::setup_map_func_() {
     switch (in_chans_.layout()) {
     case ChanLayout_None:
@@ -162,10 +257,12 @@ void ChannelMapper::setup_map_func_() {
 
         case ChanLayout_Surround:
             map_func_ = &ChannelMapper::map_surround_surround_;
+            map_planar_func_ = &ChannelMapper::map_planar_surround_surround_;
             break;
 
         case ChanLayout_Multitrack:
             map_func_ = &ChannelMapper::map_multitrack_surround_;
+            map_planar_func_ = &ChannelMapper::map_planar_multitrack_surround_;
             break;
         }
         break;
@@ -177,16 +274,18 @@ void ChannelMapper::setup_map_func_() {
 
         case ChanLayout_Surround:
             map_func_ = &ChannelMapper::map_multitrack_surround_;
+            map_planar_func_ = &ChannelMapper::map_planar_multitrack_surround_;
             break;
 
         case ChanLayout_Multitrack:
             map_func_ = &ChannelMapper::map_multitrack_multitrack_;
+            map_planar_func_ = &ChannelMapper::map_planar_multitrack_multitrack_;
             break;
         }
         break;
     }
 
-    if (!map_func_) {
+    if (!map_func_ || !map_planar_func_) {
         roc_panic("channel mapper: can't select mapper function");
     }
 }
@@ -27,6 +27,9 @@ namespace audio {
 //!  - different channel layouts (e.g. surround, multitrack)
 //!  - different channel orders (e.g. smpte, alsa)
 //!  - different channel masks (e.g. stereo, mono)
+//!
+//! Supports both interleaved and planar layouts. In planar layout, every output
+//! plane is computed from whole input planes, so loops don't use strided access.
 class ChannelMapper : public core::NonCopyable<> {
 public:
     //! Initialize.
@@ -38,11 +41,28 @@ public:
              sample_t* out_samples,
              size_t n_out_samples);
 
+    //! Map samples in planar layout.
+    //! @remarks
+    //!  @p in_planes and @p out_planes point to first plane of input and output,
+    //!  planes are @p in_stride and @p out_stride samples apart.
+    //!  @p n_samples is number of samples per channel.
+    void map_planar(const sample_t* in_planes,
+                    size_t in_stride,
+                    sample_t* out_planes,
+                    size_t out_stride,
+                    size_t n_samples);
+
 private:
     typedef void (ChannelMapper::*map_func_t)(const sample_t* in_samples,
                                               sample_t* out_samples,
                                               size_t n_samples);
 
+    typedef void (ChannelMapper::*map_planar_func_t)(const sample_t* in_planes,
+                                                     size_t in_stride,
+                                                     sample_t* out_planes,
+                                                     size_t out_stride,
+                                                     size_t n_samples);
+
     void map_surround_surround_(const sample_t* in_samples,
                                 sample_t* out_samples,
                                 size_t n_samples);
@@ -53,6 +73,22 @@ private:
                                     sample_t* out_samples,
                                     size_t n_samples);
 
+    void map_planar_surround_surround_(const sample_t* in_planes,
+                                       size_t in_stride,
+                                       sample_t* out_planes,
+                                       size_t out_stride,
+                                       size_t n_samples);
+    void map_planar_multitrack_surround_(const sample_t* in_planes,
+                                         size_t in_stride,
+                                         sample_t* out_planes,
+                                         size_t out_stride,
+                                         size_t n_samples);
+    void map_planar_multitrack_multitrack_(const sample_t* in_planes,
+                                           size_t in_stride,
+                                           sample_t* out_planes,
+                                           size_t out_stride,
+                                           size_t n_samples);
+
     void setup_map_func_();
 
     const ChannelSet in_chans_;
@@ -60,6 +96,7 @@ private:
     ChannelSet inout_chans_;
 
     map_func_t map_func_;
+    map_planar_func_t map_planar_func_;
 
     // use for surround <=> surround mapping
     ChannelMapperMatrix map_matrix_;
@@ -21,9 +21,11 @@ ChannelMapperReader::ChannelMapperReader(IFrameReader& reader,
                                          const SampleSpec& out_spec)
     : input_reader_(reader)
     , input_buf_()
+    , max_batch_(0)
     , mapper_(in_spec.channel_set(), out_spec.channel_set())
     , in_spec_(in_spec)
     , out_spec_(out_spec)
+    , planar_(in_spec.sample_layout() == SampleLayout_Planar)
     , valid_(false) {
     if (!in_spec_.is_valid() || !out_spec_.is_valid() || !in_spec_.is_raw()
         || !out_spec_.is_raw()) {
@@ -40,12 +42,35 @@ ChannelMapperReader::ChannelMapperReader(IFrameReader& reader,
                   sample_spec_to_str(out_spec).c_str());
     }
 
-    input_buf_ = frame_factory.new_raw_buffer();
+    if (in_spec_.sample_layout() != out_spec_.sample_layout()) {
+        roc_panic("channel mapper reader: required identical input and output layouts:"
+                  " in_spec=%s out_spec=%s",
+                  sample_spec_to_str(in_spec).c_str(),
+                  sample_spec_to_str(out_spec).c_str());
+    }
+
+    if (planar_) {
+        input_buf_ = frame_factory.new_planar_buffer();
+        max_batch_ = frame_factory.planar_buffer_size(in_spec_.num_channels());
+    } else {
+        input_buf_ = frame_factory.new_raw_buffer();
+        max_batch_ = frame_factory.raw_buffer_size() / in_spec_.num_channels();
+    }
+
     if (!input_buf_) {
         roc_log(LogError, "channel mapper reader: can't allocate temporary buffer");
         return;
     }
 
+    if (max_batch_ == 0) {
+        roc_log(LogError,
+                "channel mapper reader: temporary buffer is too small:"
+                " buffer_size=%lu in_spec=%s",
+                (unsigned long)frame_factory.raw_buffer_size(),
+                sample_spec_to_str(in_spec_).c_str());
+        return;
+    }
+
     input_buf_.reslice(0, input_buf_.capacity());
 
     valid_ = true;
@@ -62,19 +87,21 @@ bool ChannelMapperReader::read(Frame& out_frame) {
         roc_panic("channel mapper reader: unexpected frame size");
     }
 
-    const size_t max_batch = input_buf_.size() / in_spec_.num_channels();
+    if (out_frame.is_planar() != planar_) {
+        roc_panic("channel mapper reader: unexpected frame layout");
+    }
 
-    sample_t* out_samples = out_frame.raw_samples();
+    size_t out_offset = 0;
     size_t n_samples = out_frame.num_raw_samples() / out_spec_.num_channels();
 
     unsigned flags = 0;
 
     size_t frames_counter = 0;
     while (n_samples != 0) {
-        const size_t n_read = std::min(n_samples, max_batch);
+        const size_t n_read = std::min(n_samples, max_batch_);
 
         core::nanoseconds_t capt_ts = 0;
-        if (!read_(out_samples, n_read, flags, capt_ts)) {
+        if (!read_(out_frame, out_offset, n_read, flags, capt_ts)) {
             return false;
         }
 
@@ -82,7 +109,7 @@ bool ChannelMapperReader::read(Frame& out_frame) {
             out_frame.set_capture_timestamp(capt_ts);
         }
         frames_counter++;
-        out_samples += n_read * out_spec_.num_channels();
+        out_offset += n_read;
         n_samples -= n_read;
     }
 
@@ -92,16 +119,37 @@ bool ChannelMapperReader::read(Frame& out_frame) {
     return true;
 }
 
-bool ChannelMapperReader::read_(sample_t* out_samples,
+// Read n_samples per channel from input and write them to output frame,
+// starting from out_offset sample per channel.
+bool ChannelMapperReader::read_(Frame& out_frame,
+                                size_t out_offset,
                                 size_t n_samples,
                                 unsigned& flags,
                                 core::nanoseconds_t& capt_ts) {
+    if (planar_) {
+        Frame in_frame(input_buf_.data(), n_samples * in_spec_.num_channels(),
+                       in_spec_.num_channels());
+        if (!input_reader_.read(in_frame)) {
+            return false;
+        }
+
+        mapper_.map_planar(in_frame.plane(0), in_frame.plane_stride(),
+                           out_frame.plane(0) + out_offset, out_frame.plane_stride(),
+                           n_samples);
+
+        capt_ts = in_frame.capture_timestamp();
+        flags |= in_frame.flags();
+
+        return true;
+    }
+
     Frame in_frame(input_buf_.data(), n_samples * in_spec_.num_channels());
     if (!input_reader_.read(in_frame)) {
         return false;
     }
 
-    mapper_.map(in_frame.raw_samples(), in_frame.num_raw_samples(), out_samples,
+    mapper_.map(in_frame.raw_samples(), in_frame.num_raw_samples(),
+                out_frame.raw_samples() + out_offset * out_spec_.num_channels(),
                 n_samples * out_spec_.num_channels());
 
     capt_ts = in_frame.capture_timestamp();
@@ -25,6 +25,8 @@ namespace audio {
 
 //! Channel mapper reader.
 //! Reads frames from nested reader and maps them to another channel mask.
+//! Input and output sample specs should have the same layout, which can be
+//! interleaved or planar.
 class ChannelMapperReader : public IFrameReader, public core::NonCopyable<> {
 public:
     //! Initialize.
@@ -40,19 +42,23 @@ public:
     virtual bool read(Frame& frame);
 
 private:
-    bool read_(sample_t* out_samples,
+    bool read_(Frame& out_frame,
+               size_t out_offset,
                size_t n_samples,
                unsigned& flags,
                core::nanoseconds_t& capt_ts);
 
     IFrameReader& input_reader_;
     core::Slice<sample_t> input_buf_;
+    size_t max_batch_;
 
     ChannelMapper mapper_;
 
     const SampleSpec in_spec_;
     const SampleSpec out_spec_;
 
+    const bool planar_;
+
     bool valid_;
 };
 
@@ -7,6 +7,7 @@
  */
 
 #include "roc_audio/depacketizer.h"
+#include "roc_audio/integer_ops.h"
 #include "roc_audio/sample_spec_to_str.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
@@ -20,14 +21,16 @@ namespace {
 
 const core::nanoseconds_t LogInterval = 20 * core::Second;
 
-inline void write_zeros(sample_t* buf, size_t bufsz) {
-    memset(buf, 0, bufsz * sizeof(sample_t));
+// Zero bits are zero samples in raw format and in all integer formats.
+inline void write_zeros(uint8_t* buf, size_t n_bytes) {
+    memset(buf, 0, n_bytes);
 }
 
-inline void write_beep(sample_t* buf, size_t bufsz) {
-    for (size_t n = 0; n < bufsz; n++) {
-        buf[n] = (sample_t)std::sin(2 * M_PI / 44100 * 880 * n);
+size_t get_sample_size(const SampleSpec& sample_spec) {
+    if (is_integer_spec(sample_spec)) {
+        return integer_sample_size(sample_spec.pcm_format());
     }
+    return sizeof(sample_t);
 }
 
 } // namespace
@@ -35,10 +38,13 @@ inline void write_beep(sample_t* buf, size_t bufsz) {
 Depacketizer::Depacketizer(packet::IReader& reader,
                            IFrameDecoder& payload_decoder,
                            const SampleSpec& sample_spec,
-                           bool beep)
+                           IPlc* plc)
     : reader_(reader)
     , payload_decoder_(payload_decoder)
+    , plc_(plc)
     , sample_spec_(sample_spec)
+    , integer_(is_integer_spec(sample_spec))
+    , sample_size_(get_sample_size(sample_spec))
     , stream_ts_(0)
     , next_capture_ts_(0)
     , valid_capture_ts_(false)
@@ -46,15 +52,20 @@ Depacketizer::Depacketizer(packet::IReader& reader,
     , missing_samples_(0)
     , packet_samples_(0)
     , rate_limiter_(LogInterval)
-    , beep_(beep)
     , first_packet_(true)
     , valid_(false) {
-    roc_panic_if_msg(!sample_spec_.is_valid() || !sample_spec_.is_raw(),
-                     "depacketizer: required valid sample spec with raw format: %s",
+    roc_panic_if_msg(!sample_spec_.is_valid() || (!sample_spec_.is_raw() && !integer_),
+                     "depacketizer: required valid sample spec with raw or integer"
+                     " format: %s",
                      sample_spec_to_str(sample_spec_).c_str());
 
-    roc_log(LogDebug, "depacketizer: initializing: n_channels=%lu",
-            (unsigned long)sample_spec_.num_channels());
+    roc_panic_if_msg(integer_ && plc_,
+                     "depacketizer: plc requires raw format: %s",
+                     sample_spec_to_str(sample_spec_).c_str());
+
+    roc_log(LogDebug, "depacketizer: initializing: n_channels=%lu format=%s",
+            (unsigned long)sample_spec_.num_channels(),
+            pcm_format_to_str(sample_spec_.pcm_format()));
 
     valid_ = true;
 }
@@ -74,6 +85,10 @@ packet::stream_timestamp_t Depacketizer::next_timestamp() const {
     return stream_ts_;
 }
 
+const DepacketizerMetrics& Depacketizer::metrics() const {
+    return metrics_;
+}
+
 bool Depacketizer::read(Frame& frame) {
     read_frame_(frame);
 
@@ -83,12 +98,13 @@ bool Depacketizer::read(Frame& frame) {
 }
 
 void Depacketizer::read_frame_(Frame& frame) {
-    if (frame.num_raw_samples() % sample_spec_.num_channels() != 0) {
+    if (frame.num_bytes() % (sample_size_ * sample_spec_.num_channels()) != 0) {
         roc_panic("depacketizer: unexpected frame size");
     }
 
-    sample_t* buff_ptr = frame.raw_samples();
-    sample_t* buff_end = frame.raw_samples() + frame.num_raw_samples();
+    // In integer format, frame has no raw samples, and we fill its bytes.
+    uint8_t* buff_ptr = integer_ ? frame.bytes() : (uint8_t*)frame.raw_samples();
+    uint8_t* buff_end = buff_ptr + frame.num_bytes();
 
     FrameInfo info;
 
@@ -100,8 +116,8 @@ void Depacketizer::read_frame_(Frame& frame) {
     set_frame_props_(frame, info);
 }
 
-sample_t*
-Depacketizer::read_samples_(sample_t* buff_ptr, sample_t* buff_end, FrameInfo& info) {
+uint8_t*
+Depacketizer::read_samples_(uint8_t* buff_ptr, uint8_t* buff_end, FrameInfo& info) {
     update_packet_(info);
 
     if (packet_) {
@@ -113,10 +129,11 @@ Depacketizer::read_samples_(sample_t* buff_ptr, sample_t* buff_end, FrameInfo& i
             const size_t mis_samples = sample_spec_.num_channels()
                 * (size_t)packet::stream_timestamp_diff(next_timestamp, stream_ts_);
 
-            const size_t max_samples = (size_t)(buff_end - buff_ptr);
+            const size_t max_samples = (size_t)(buff_end - buff_ptr) / sample_size_;
             const size_t n_samples = std::min(mis_samples, max_samples);
 
-            buff_ptr = read_missing_samples_(buff_ptr, buff_ptr + n_samples);
+            buff_ptr =
+                read_missing_samples_(buff_ptr, buff_ptr + n_samples * sample_size_);
 
             //           next_capture_ts_
             //           next_timestamp
@@ -133,8 +150,8 @@ Depacketizer::read_samples_(sample_t* buff_ptr, sample_t* buff_end, FrameInfo& i
         }
 
         if (buff_ptr < buff_end) {
-            sample_t* new_buff_ptr = read_packet_samples_(buff_ptr, buff_end);
-            const size_t n_samples = size_t(new_buff_ptr - buff_ptr);
+            uint8_t* new_buff_ptr = read_packet_samples_(buff_ptr, buff_end);
+            const size_t n_samples = size_t(new_buff_ptr - buff_ptr) / sample_size_;
 
             info.n_decoded_samples += n_samples;
             if (n_samples && !info.capture_ts && valid_capture_ts_) {
@@ -151,7 +168,7 @@ Depacketizer::read_samples_(sample_t* buff_ptr, sample_t* buff_end, FrameInfo& i
 
         return buff_ptr;
     } else {
-        const size_t n_samples = size_t(buff_end - buff_ptr);
+        const size_t n_samples = size_t(buff_end - buff_ptr) / sample_size_;
 
         if (!info.capture_ts && valid_capture_ts_) {
             info.capture_ts = next_capture_ts_
@@ -166,11 +183,22 @@ Depacketizer::read_samples_(sample_t* buff_ptr, sample_t* buff_end, FrameInfo& i
     }
 }
 
-sample_t* Depacketizer::read_packet_samples_(sample_t* buff_ptr, sample_t* buff_end) {
+uint8_t* Depacketizer::read_packet_samples_(uint8_t* buff_ptr, uint8_t* buff_end) {
     const size_t requested_samples =
-        size_t(buff_end - buff_ptr) / sample_spec_.num_channels();
+        size_t(buff_end - buff_ptr) / sample_size_ / sample_spec_.num_channels();
+
+    size_t decoded_samples = 0;
+
+    if (integer_) {
+        decoded_samples = payload_decoder_.read_pcm(buff_ptr, requested_samples,
+                                                    sample_spec_.pcm_format());
+    } else {
+        decoded_samples = payload_decoder_.read((sample_t*)buff_ptr, requested_samples);
+    }
 
-    const size_t decoded_samples = payload_decoder_.read(buff_ptr, requested_samples);
+    if (plc_ && decoded_samples != 0) {
+        plc_->process_history((sample_t*)buff_ptr, decoded_samples);
+    }
 
     stream_ts_ += (packet::stream_timestamp_t)decoded_samples;
     packet_samples_ += (packet::stream_timestamp_t)decoded_samples;
@@ -180,17 +208,17 @@ sample_t* Depacketizer::read_packet_samples_(sample_t* buff_ptr, sample_t* buff_
         packet_ = NULL;
     }
 
-    return (buff_ptr + decoded_samples * sample_spec_.num_channels());
+    return (buff_ptr + decoded_samples * sample_spec_.num_channels() * sample_size_);
 }
 
-sample_t* Depacketizer::read_missing_samples_(sample_t* buff_ptr, sample_t* buff_end) {
+uint8_t* Depacketizer::read_missing_samples_(uint8_t* buff_ptr, uint8_t* buff_end) {
     const size_t num_samples =
-        (size_t)(buff_end - buff_ptr) / sample_spec_.num_channels();
+        (size_t)(buff_end - buff_ptr) / sample_size_ / sample_spec_.num_channels();
 
-    if (beep_) {
-        write_beep(buff_ptr, num_samples * sample_spec_.num_channels());
+    if (plc_ && num_samples != 0) {
+        plc_->process_loss((sample_t*)buff_ptr, num_samples);
     } else {
-        write_zeros(buff_ptr, num_samples * sample_spec_.num_channels());
+        write_zeros(buff_ptr, num_samples * sample_spec_.num_channels() * sample_size_);
     }
 
     stream_ts_ += (packet::stream_timestamp_t)num_samples;
@@ -199,9 +227,10 @@ sample_t* Depacketizer::read_missing_samples_(sample_t* buff_ptr, sample_t* buff
         zero_samples_ += (packet::stream_timestamp_t)num_samples;
     } else {
         missing_samples_ += (packet::stream_timestamp_t)num_samples;
+        metrics_.missing_samples += num_samples;
     }
 
-    return (buff_ptr + num_samples * sample_spec_.num_channels());
+    return (buff_ptr + num_samples * sample_spec_.num_channels() * sample_size_);
 }
 
 void Depacketizer::update_packet_(FrameInfo& info) {
@@ -242,6 +271,7 @@ void Depacketizer::update_packet_(FrameInfo& info) {
                 n_dropped);
 
         info.n_dropped_packets += n_dropped;
+        metrics_.late_packets += n_dropped;
     }
 
     if (!packet_) {
@@ -293,13 +323,19 @@ packet::PacketPtr Depacketizer::read_packet_() {
 }
 
 void Depacketizer::set_frame_props_(Frame& frame, const FrameInfo& info) {
+    const size_t n_frame_samples = frame.num_bytes() / sample_size_;
+
     unsigned flags = 0;
 
+    if (integer_) {
+        flags |= Frame::FlagNotRaw;
+    }
+
     if (info.n_decoded_samples != 0) {
         flags |= Frame::FlagNotBlank;
     }
 
-    if (info.n_decoded_samples < frame.num_raw_samples()) {
+    if (info.n_decoded_samples < n_frame_samples) {
         flags |= Frame::FlagNotComplete;
     }
 
@@ -308,7 +344,7 @@ void Depacketizer::set_frame_props_(Frame& frame, const FrameInfo& info) {
     }
 
     frame.set_flags(flags);
-    frame.set_duration(frame.num_raw_samples() / sample_spec_.num_channels());
+    frame.set_duration(n_frame_samples / sample_spec_.num_channels());
 
     if (info.capture_ts > 0) {
         // do not produce negative cts, which may happen when first packet was in
@@ -14,6 +14,7 @@
 
 #include "roc_audio/iframe_decoder.h"
 #include "roc_audio/iframe_reader.h"
+#include "roc_audio/iplc.h"
 #include "roc_audio/sample.h"
 #include "roc_audio/sample_spec.h"
 #include "roc_core/noncopyable.h"
@@ -23,10 +24,31 @@
 namespace roc {
 namespace audio {
 
+//! Metrics of depacketizer.
+struct DepacketizerMetrics {
+    //! Cumulative count of packets dropped because they were late.
+    uint64_t late_packets;
+
+    //! Cumulative count of samples (per channel) that were missing and
+    //! were filled using PLC or with zeros.
+    //! Doesn't include zeros produced before first packet.
+    uint64_t missing_samples;
+
+    DepacketizerMetrics()
+        : late_packets(0)
+        , missing_samples(0) {
+    }
+};
+
 //! Depacketizer.
 //! @remarks
 //!  Reads packets from a packet reader, decodes samples from packets using a
 //!  decoder, and produces an audio stream.
+//!
+//!  Besides raw format, sample spec may have integer format (see
+//!  is_integer_format()). In this case samples are decoded using
+//!  IFrameDecoder::read_pcm() directly to integer format, and PLC
+//!  can't be used.
 class Depacketizer : public IFrameReader, public core::NonCopyable<> {
 public:
     //! Initialization.
@@ -35,11 +57,12 @@ public:
     //!  - @p reader is used to read packets
     //!  - @p payload_decoder is used to extract samples from packets
     //!  - @p sample_spec describes output frames
-    //!  - @p beep enables weird beeps instead of silence on packet loss
+    //!  - @p plc is used to fill gaps caused by packet loss; if NULL,
+    //!    gaps are filled with zeros
     Depacketizer(packet::IReader& reader,
                  IFrameDecoder& payload_decoder,
                  const SampleSpec& sample_spec,
-                 bool beep);
+                 IPlc* plc);
 
     //! Was depacketizer constructed without errors?
     bool is_valid() const;
@@ -55,6 +78,9 @@ public:
     //!  is_started() should return true
     packet::stream_timestamp_t next_timestamp() const;
 
+    //! Get metrics.
+    const DepacketizerMetrics& metrics() const;
+
 private:
     struct FrameInfo {
         // Number of samples decoded from packets into the frame.
@@ -79,10 +105,10 @@ private:
 
     void read_frame_(Frame& frame);
 
-    sample_t* read_samples_(sample_t* buff_ptr, sample_t* buff_end, FrameInfo& info);
+    uint8_t* read_samples_(uint8_t* buff_ptr, uint8_t* buff_end, FrameInfo& info);
 
-    sample_t* read_packet_samples_(sample_t* buff_ptr, sample_t* buff_end);
-    sample_t* read_missing_samples_(sample_t* buff_ptr, sample_t* buff_end);
+    uint8_t* read_packet_samples_(uint8_t* buff_ptr, uint8_t* buff_end);
+    uint8_t* read_missing_samples_(uint8_t* buff_ptr, uint8_t* buff_end);
 
     void update_packet_(FrameInfo& info);
     packet::PacketPtr read_packet_();
@@ -93,9 +119,14 @@ private:
 
     packet::IReader& reader_;
     IFrameDecoder& payload_decoder_;
+    IPlc* plc_;
 
     const SampleSpec sample_spec_;
 
+    // If true, frames are filled with samples in integer format.
+    const bool integer_;
+    const size_t sample_size_;
+
     packet::PacketPtr packet_;
 
     packet::stream_timestamp_t stream_ts_;
@@ -106,9 +137,9 @@ private:
     packet::stream_timestamp_t missing_samples_;
     packet::stream_timestamp_t packet_samples_;
 
-    core::RateLimiter rate_limiter_;
+    DepacketizerMetrics metrics_;
 
-    const bool beep_;
+    core::RateLimiter rate_limiter_;
 
     bool first_packet_;
     bool valid_;
@@ -158,6 +158,16 @@ const packet::LinkMetrics& FeedbackMonitor::link_metrics(size_t party_index) con
     return link_metrics_;
 }
 
+packet::stream_source_t FeedbackMonitor::source_id(size_t party_index) const {
+    roc_panic_if_msg(party_index >= num_participants(),
+                     "feedback monitor: participant index out of bounds:"
+                     " index=%lu max=%lu",
+                     (unsigned long)party_index, (unsigned long)num_participants());
+
+    // TODO(gh-674): collect per-session metrics
+    return source_;
+}
+
 bool FeedbackMonitor::update_tuner_(packet::stream_timestamp_t duration) {
     if (!has_feedback_) {
         return true;
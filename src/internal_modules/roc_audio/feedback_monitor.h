@@ -100,6 +100,10 @@ public:
     //! @p party_index should be in range [0; num_participants()-1].
     const packet::LinkMetrics& link_metrics(size_t party_index) const;
 
+    //! Get source ID of remote participant.
+    //! @p party_index should be in range [0; num_participants()-1].
+    packet::stream_source_t source_id(size_t party_index) const;
+
 private:
     bool update_tuner_(packet::stream_timestamp_t duration);
 
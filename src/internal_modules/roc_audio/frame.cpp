@@ -17,6 +17,9 @@ namespace audio {
 Frame::Frame(sample_t* samples, size_t num_samples)
     : bytes_((uint8_t*)samples)
     , num_bytes_(num_samples * sizeof(sample_t))
+    , num_planes_(0)
+    , plane_size_(0)
+    , plane_stride_(0)
     , flags_(0)
     , duration_(0)
     , capture_timestamp_(0) {
@@ -28,6 +31,9 @@ Frame::Frame(sample_t* samples, size_t num_samples)
 Frame::Frame(uint8_t* bytes, size_t num_bytes)
     : bytes_(bytes)
     , num_bytes_(num_bytes)
+    , num_planes_(0)
+    , plane_size_(0)
+    , plane_stride_(0)
     , flags_(0)
     , duration_(0)
     , capture_timestamp_(0) {
@@ -36,6 +42,34 @@ Frame::Frame(uint8_t* bytes, size_t num_bytes)
     }
 }
 
+Frame::Frame(sample_t* samples, size_t num_samples, size_t num_channels)
+    : bytes_((uint8_t*)samples)
+    , num_bytes_(0)
+    , num_planes_(num_channels)
+    , plane_size_(0)
+    , plane_stride_(0)
+    , flags_(0)
+    , duration_(0)
+    , capture_timestamp_(0) {
+    if (!samples) {
+        roc_panic("frame: samples buffer is null");
+    }
+
+    if (num_channels == 0 || num_samples % num_channels != 0) {
+        roc_panic("frame: invalid planar frame size: num_samples=%lu num_channels=%lu",
+                  (unsigned long)num_samples, (unsigned long)num_channels);
+    }
+
+    if ((uintptr_t)samples % PlaneAlignment != 0) {
+        roc_panic("frame: planar samples buffer should be %d-byte aligned",
+                  (int)PlaneAlignment);
+    }
+
+    plane_size_ = num_samples / num_channels;
+    plane_stride_ = audio::plane_stride(plane_size_);
+    num_bytes_ = num_planes_ * plane_stride_ * sizeof(sample_t);
+}
+
 unsigned Frame::flags() const {
     return flags_;
 }
@@ -53,6 +87,10 @@ sample_t* Frame::raw_samples() const {
         roc_panic("frame: frame is not in raw format");
     }
 
+    if (num_planes_ != 0) {
+        roc_panic("frame: frame is in planar layout");
+    }
+
     return (sample_t*)bytes_;
 }
 
@@ -61,9 +99,46 @@ size_t Frame::num_raw_samples() const {
         roc_panic("frame: frame is not in raw format");
     }
 
+    if (num_planes_ != 0) {
+        return num_planes_ * plane_size_;
+    }
+
     return num_bytes_ / sizeof(sample_t);
 }
 
+bool Frame::is_planar() const {
+    return num_planes_ != 0;
+}
+
+size_t Frame::num_planes() const {
+    if (num_planes_ == 0) {
+        roc_panic("frame: frame is not in planar layout");
+    }
+
+    return num_planes_;
+}
+
+size_t Frame::plane_stride() const {
+    if (num_planes_ == 0) {
+        roc_panic("frame: frame is not in planar layout");
+    }
+
+    return plane_stride_;
+}
+
+sample_t* Frame::plane(size_t channel) const {
+    if (num_planes_ == 0) {
+        roc_panic("frame: frame is not in planar layout");
+    }
+
+    if (channel >= num_planes_) {
+        roc_panic("frame: plane out of bounds: channel=%lu num_planes=%lu",
+                  (unsigned long)channel, (unsigned long)num_planes_);
+    }
+
+    return (sample_t*)bytes_ + channel * plane_stride_;
+}
+
 uint8_t* Frame::bytes() const {
     return bytes_;
 }
@@ -123,6 +198,10 @@ void Frame::print() const {
 
     if (flags_ & FlagNotRaw) {
         core::print_memory(bytes(), num_bytes());
+    } else if (num_planes_ != 0) {
+        for (size_t ch = 0; ch < num_planes_; ch++) {
+            core::print_memory(plane(ch), plane_size_);
+        }
     } else {
         core::print_memory(raw_samples(), num_raw_samples());
     }
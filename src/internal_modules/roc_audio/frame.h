@@ -13,6 +13,7 @@
 #define ROC_AUDIO_FRAME_H_
 
 #include "roc_audio/sample.h"
+#include "roc_audio/sample_layout.h"
 #include "roc_audio/sample_spec.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/time.h"
@@ -32,6 +33,15 @@ public:
     //! Flags are set to zero.
     Frame(uint8_t* bytes, size_t num_bytes);
 
+    //! Construct frame from raw samples in planar layout.
+    //! @remarks
+    //!  @p num_samples is number of samples for all channels. Samples of every
+    //!  channel are stored in a separate plane, and planes are plane_stride()
+    //!  samples apart, so @p samples should point to a buffer that can hold
+    //!  @p num_channels planes. See SampleLayout_Planar.
+    //!  Flags are set to zero.
+    Frame(sample_t* samples, size_t num_samples, size_t num_channels);
+
     //! Frame flags.
     //! Flags are designed the way so that if you combine multiple frames into one,
     //! (concatenate or mix), bitwise OR of their flags will give flags for resulting
@@ -72,12 +82,31 @@ public:
 
     //! Get number of raw samples in frame,
     //! May be used only if is_raw() is true, otherwise use num_bytes().
+    //! For planar frames, returns number of samples in all planes.
     size_t num_raw_samples() const;
 
+    //! Check if raw samples are stored in planar layout.
+    //! If true, raw_samples() can't be used, and plane() should be used instead.
+    bool is_planar() const;
+
+    //! Get number of planes.
+    //! May be used only if is_planar() is true.
+    size_t num_planes() const;
+
+    //! Get distance between beginnings of adjacent planes, in samples.
+    //! May be used only if is_planar() is true.
+    size_t plane_stride() const;
+
+    //! Get samples of given channel.
+    //! May be used only if is_planar() is true.
+    //! Plane holds num_raw_samples() / num_planes() samples.
+    sample_t* plane(size_t channel) const;
+
     //! Get frame data as bytes.
     uint8_t* bytes() const;
 
     //! Get number of bytes in frame.
+    //! For planar frames, includes padding between planes.
     size_t num_bytes() const;
 
     //! Check if duration was set.
@@ -104,6 +133,9 @@ public:
 private:
     uint8_t* bytes_;
     size_t num_bytes_;
+    size_t num_planes_;
+    size_t plane_size_;
+    size_t plane_stride_;
     unsigned flags_;
     packet::stream_timestamp_t duration_;
     core::nanoseconds_t capture_timestamp_;
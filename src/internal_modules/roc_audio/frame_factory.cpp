@@ -7,6 +7,8 @@
  */
 
 #include "roc_audio/frame_factory.h"
+#include "roc_audio/sample_layout.h"
+#include "roc_core/align_ops.h"
 #include "roc_core/panic.h"
 
 namespace roc {
@@ -50,5 +52,39 @@ core::Slice<sample_t> FrameFactory::new_raw_buffer() {
         core::Buffer(*buffer_pool_, buffer_size_);
 }
 
+size_t FrameFactory::planar_buffer_size(size_t num_channels) const {
+    // Reserve space for padding needed to align buffer beginning.
+    const size_t max_padding =
+        (PlaneAlignment - core::AlignOps::max_alignment()) / sizeof(sample_t);
+
+    if (raw_buffer_size() <= max_padding) {
+        return 0;
+    }
+
+    return planar_buffer_samples(raw_buffer_size() - max_padding, num_channels);
+}
+
+core::Slice<sample_t> FrameFactory::new_planar_buffer() {
+    core::Slice<sample_t> buffer = new_raw_buffer();
+    if (!buffer) {
+        return buffer;
+    }
+
+    // Buffer data is aligned to maximum alignment, which is a multiple of
+    // sample size, so padding is a whole number of samples.
+    const size_t padding =
+        core::AlignOps::pad_as((size_t)(uintptr_t)buffer.data(), PlaneAlignment);
+
+    roc_panic_if(padding % sizeof(sample_t) != 0);
+
+    if (padding / sizeof(sample_t) > buffer.capacity()) {
+        return core::Slice<sample_t>();
+    }
+
+    buffer.reslice(padding / sizeof(sample_t), buffer.capacity());
+
+    return buffer;
+}
+
 } // namespace audio
 } // namespace roc
@@ -57,6 +57,17 @@ public:
     //! Allocate raw sample buffer.
     core::Slice<sample_t> new_raw_buffer();
 
+    //! Get maximum number of samples per channel in planar buffer.
+    //! @remarks
+    //!  Returns zero if planar buffer can't hold one aligned plane per channel.
+    size_t planar_buffer_size(size_t num_channels) const;
+
+    //! Allocate raw sample buffer for planar frames.
+    //! @remarks
+    //!  Returned buffer begins at PlaneAlignment boundary. Its capacity is
+    //!  enough for planar frame with planar_buffer_size() samples per channel.
+    core::Slice<sample_t> new_planar_buffer();
+
 private:
     // used if factory is created with default pools
     core::Optional<core::SlabPool<core::Buffer> > default_buffer_pool_;
@@ -109,6 +109,10 @@ void FreqEstimator::update(packet::stream_timestamp_t current) {
     }
 }
 
+void FreqEstimator::update_target_latency(packet::stream_timestamp_t target_latency) {
+    target_ = target_latency;
+}
+
 bool FreqEstimator::run_decimators_(packet::stream_timestamp_t current,
                                     double& filtered) {
     samples_counter_++;
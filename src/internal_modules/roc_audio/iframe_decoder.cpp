@@ -7,6 +7,7 @@
  */
 
 #include "roc_audio/iframe_decoder.h"
+#include "roc_core/panic.h"
 
 namespace roc {
 namespace audio {
@@ -14,5 +15,10 @@ namespace audio {
 IFrameDecoder::~IFrameDecoder() {
 }
 
+size_t IFrameDecoder::read_pcm(void*, size_t, PcmFormat format) {
+    roc_panic("frame decoder: decoding to %s is not supported by this decoder",
+              pcm_format_to_str(format));
+}
+
 } // namespace audio
 } // namespace roc
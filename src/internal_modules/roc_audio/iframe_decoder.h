@@ -12,6 +12,7 @@
 #ifndef ROC_AUDIO_IFRAME_DECODER_H_
 #define ROC_AUDIO_IFRAME_DECODER_H_
 
+#include "roc_audio/pcm_format.h"
 #include "roc_audio/sample.h"
 #include "roc_core/stddefs.h"
 #include "roc_packet/packet.h"
@@ -86,6 +87,26 @@ public:
     //!  This method may be called only between begin() and end() calls.
     virtual size_t read(sample_t* samples, size_t n_samples) = 0;
 
+    //! Read samples from current frame in given PCM format.
+    //!
+    //! @b Parameters
+    //!  - @p samples - buffer to write decoded samples to
+    //!  - @p n_samples - number of samples to be decoded per channel
+    //!  - @p format - PCM format of samples written to buffer
+    //!
+    //! @remarks
+    //!  Same as read(), but writes samples in @p format instead of raw samples.
+    //!  Used for integer processing, to avoid conversion to raw samples and back.
+    //!  Default implementation panics; decoders which can produce samples in
+    //!  other formats should override it.
+    //!
+    //! @returns
+    //!  number of samples decoded per channel.
+    //!
+    //! @pre
+    //!  This method may be called only between begin() and end() calls.
+    virtual size_t read_pcm(void* samples, size_t n_samples, PcmFormat format);
+
     //! Shift samples from current frame.
     //!
     //! @b Parameters
@@ -26,6 +26,10 @@ public:
     virtual ~IFrameEncoder();
 
     //! Get encoded frame size in bytes for given number of samples per channel.
+    //!
+    //! @remarks
+    //!  For encoders that produce variable-size frames, returns the maximum
+    //!  possible size of the frame. Actual size is reported by end().
     virtual size_t encoded_byte_count(size_t num_samples) const = 0;
 
     //! Start encoding a new frame.
@@ -57,7 +61,11 @@ public:
     //! @remarks
     //!  After this call, the frame is fully encoded and no more samples will be
     //!  written to the frame. A new frame should be started by calling begin().
-    virtual void end() = 0;
+    //!
+    //! @returns
+    //!  number of bytes written to the frame. It is never greater than value returned
+    //!  by encoded_byte_count() for the number of samples written to the frame.
+    virtual size_t end() = 0;
 };
 
 } // namespace audio
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/integer_ops.h"
+#include "roc_core/panic.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define ROC_AUDIO_INTEGER_NEON
+#endif
+
+namespace roc {
+namespace audio {
+
+bool is_integer_format(PcmFormat format) {
+    return format == PcmFormat_SInt16 || format == PcmFormat_SInt32;
+}
+
+bool is_integer_spec(const SampleSpec& sample_spec) {
+    return sample_spec.sample_format() == SampleFormat_Pcm
+        && is_integer_format(sample_spec.pcm_format());
+}
+
+size_t integer_sample_size(PcmFormat format) {
+    switch (format) {
+    case PcmFormat_SInt16:
+        return sizeof(int16_t);
+
+    case PcmFormat_SInt32:
+        return sizeof(int32_t);
+
+    default:
+        break;
+    }
+
+    roc_panic("integer ops: unsupported format: %s", pcm_format_to_str(format));
+}
+
+void mix_s16(int16_t* out_samples, const int16_t* in_samples, size_t n_samples) {
+    size_t n = 0;
+
+#if defined(ROC_AUDIO_INTEGER_NEON)
+    for (; n + 8 <= n_samples; n += 8) {
+        vst1q_s16(out_samples + n,
+                  vqaddq_s16(vld1q_s16(out_samples + n), vld1q_s16(in_samples + n)));
+    }
+#endif // defined(ROC_AUDIO_INTEGER_NEON)
+
+    for (; n < n_samples; n++) {
+        int32_t s = (int32_t)out_samples[n] + (int32_t)in_samples[n];
+
+        // Saturate on overflow.
+        s = std::min(s, (int32_t)INT16_MAX);
+        s = std::max(s, (int32_t)INT16_MIN);
+
+        out_samples[n] = (int16_t)s;
+    }
+}
+
+void mix_s32(int32_t* out_samples, const int32_t* in_samples, size_t n_samples) {
+    size_t n = 0;
+
+#if defined(ROC_AUDIO_INTEGER_NEON)
+    for (; n + 4 <= n_samples; n += 4) {
+        vst1q_s32(out_samples + n,
+                  vqaddq_s32(vld1q_s32(out_samples + n), vld1q_s32(in_samples + n)));
+    }
+#endif // defined(ROC_AUDIO_INTEGER_NEON)
+
+    for (; n < n_samples; n++) {
+        int64_t s = (int64_t)out_samples[n] + (int64_t)in_samples[n];
+
+        // Saturate on overflow.
+        s = std::min(s, (int64_t)INT32_MAX);
+        s = std::max(s, (int64_t)INT32_MIN);
+
+        out_samples[n] = (int32_t)s;
+    }
+}
+
+int64_t dot_s16(const int16_t* samples, const int16_t* weights, size_t n_samples) {
+    int64_t result = 0;
+    size_t n = 0;
+
+#if defined(ROC_AUDIO_INTEGER_NEON)
+    // Products of 16-bit values fit 32 bits, and pairs of them are
+    // accumulated into 64-bit lanes.
+    int64x2_t acc = vdupq_n_s64(0);
+
+    for (; n + 8 <= n_samples; n += 8) {
+        const int16x8_t s = vld1q_s16(samples + n);
+        const int16x8_t w = vld1q_s16(weights + n);
+
+        acc = vpadalq_s32(acc, vmull_s16(vget_low_s16(s), vget_low_s16(w)));
+        acc = vpadalq_s32(acc, vmull_s16(vget_high_s16(s), vget_high_s16(w)));
+    }
+
+    result = vgetq_lane_s64(acc, 0) + vgetq_lane_s64(acc, 1);
+#endif // defined(ROC_AUDIO_INTEGER_NEON)
+
+    for (; n < n_samples; n++) {
+        result += (int32_t)samples[n] * (int32_t)weights[n];
+    }
+
+    return result;
+}
+
+int64_t dot_s32(const int32_t* samples, const int32_t* weights, size_t n_samples) {
+    int64_t result = 0;
+    size_t n = 0;
+
+#if defined(ROC_AUDIO_INTEGER_NEON)
+    int64x2_t acc = vdupq_n_s64(0);
+
+    for (; n + 4 <= n_samples; n += 4) {
+        const int32x4_t s = vld1q_s32(samples + n);
+        const int32x4_t w = vld1q_s32(weights + n);
+
+        acc = vmlal_s32(acc, vget_low_s32(s), vget_low_s32(w));
+        acc = vmlal_s32(acc, vget_high_s32(s), vget_high_s32(w));
+    }
+
+    result = vgetq_lane_s64(acc, 0) + vgetq_lane_s64(acc, 1);
+#endif // defined(ROC_AUDIO_INTEGER_NEON)
+
+    for (; n < n_samples; n++) {
+        result += (int64_t)samples[n] * (int64_t)weights[n];
+    }
+
+    return result;
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/integer_ops.h
+//! @brief Integer sample operations.
+
+#ifndef ROC_AUDIO_INTEGER_OPS_H_
+#define ROC_AUDIO_INTEGER_OPS_H_
+
+#include "roc_audio/pcm_format.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Check if PCM format can be used for integer processing.
+//! @remarks
+//!  Returns true for native-endian PcmFormat_SInt16 and PcmFormat_SInt32.
+//!  In these formats, pipeline elements that support integer processing
+//!  (depacketizer, mixer, builtin resampler) work on samples directly,
+//!  without conversion to raw floating point samples.
+bool is_integer_format(PcmFormat format);
+
+//! Check if sample spec has PCM format that can be used for integer processing.
+bool is_integer_spec(const SampleSpec& sample_spec);
+
+//! Get size of one sample in given integer format, in bytes.
+//! @pre
+//!  is_integer_format() should return true for @p format.
+size_t integer_sample_size(PcmFormat format);
+
+//! Add 16-bit samples from @p in_samples to @p out_samples.
+//! @remarks
+//!  Sums are saturated to 16-bit range.
+//!  Uses NEON instructions if available.
+void mix_s16(int16_t* out_samples, const int16_t* in_samples, size_t n_samples);
+
+//! Add 32-bit samples from @p in_samples to @p out_samples.
+//! @remarks
+//!  Sums are saturated to 32-bit range.
+//!  Uses NEON instructions if available.
+void mix_s32(int32_t* out_samples, const int32_t* in_samples, size_t n_samples);
+
+//! Compute dot product of 16-bit samples and 16-bit weights.
+//! @remarks
+//!  Products are accumulated in 64 bits, so the result can't overflow.
+//!  Uses NEON instructions if available.
+int64_t dot_s16(const int16_t* samples, const int16_t* weights, size_t n_samples);
+
+//! Compute dot product of 32-bit samples and 32-bit weights.
+//! @remarks
+//!  Products are accumulated in 64 bits; caller should choose precision
+//!  of weights so that the result fits.
+//!  Uses NEON instructions if available.
+int64_t dot_s32(const int32_t* samples, const int32_t* weights, size_t n_samples);
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_INTEGER_OPS_H_
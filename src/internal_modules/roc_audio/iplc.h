@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/iplc.h
+//! @brief Packet loss concealment interface.
+
+#ifndef ROC_AUDIO_IPLC_H_
+#define ROC_AUDIO_IPLC_H_
+
+#include "roc_audio/sample.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Packet loss concealment interface.
+//! @remarks
+//!  Used by depacketizer to fill gaps caused by lost packets. Depacketizer
+//!  passes all samples of the stream to PLC, in order: samples decoded from
+//!  packets go to process_history(), and gaps go to process_loss().
+//!  Samples are interleaved; sizes are in number of samples per channel.
+class IPlc {
+public:
+    virtual ~IPlc();
+
+    //! Process samples decoded from packets.
+    //! @remarks
+    //!  PLC may remember samples to use them for synthesizing lost samples.
+    //!  PLC may also modify samples, e.g. to cross-fade from synthesized
+    //!  samples to real ones after a loss.
+    virtual void process_history(sample_t* samples, size_t n_samples) = 0;
+
+    //! Fill lost samples.
+    //! @remarks
+    //!  Called for every gap in the stream. Long gaps may be reported by
+    //!  multiple subsequent calls.
+    virtual void process_loss(sample_t* samples, size_t n_samples) = 0;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_IPLC_H_
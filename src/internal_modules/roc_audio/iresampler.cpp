@@ -7,6 +7,7 @@
  */
 
 #include "roc_audio/iresampler.h"
+#include "roc_core/panic.h"
 
 namespace roc {
 namespace audio {
@@ -18,5 +19,17 @@ IResampler::IResampler(core::IArena& arena)
 IResampler::~IResampler() {
 }
 
+const core::Slice<uint8_t>& IResampler::begin_push_integer_input() {
+    roc_panic("resampler: integer formats are not supported by this backend");
+}
+
+size_t IResampler::pop_planar_output(sample_t*, size_t, size_t) {
+    roc_panic("resampler: planar layout is not supported by this backend");
+}
+
+size_t IResampler::pop_integer_output(void*, size_t) {
+    roc_panic("resampler: integer formats are not supported by this backend");
+}
+
 } // namespace audio
 } // namespace roc
@@ -43,6 +43,16 @@ public:
     //!  data and invoke end_push_input().
     virtual const core::Slice<sample_t>& begin_push_input() = 0;
 
+    //! Get buffer to be filled with input data in integer format.
+    //! @remarks
+    //!  Same as begin_push_input(), but used when sample spec has integer
+    //!  format (see is_integer_format()). Returned buffer holds one input frame
+    //!  of interleaved samples in this format. After filling it, the caller
+    //!  should invoke end_push_input().
+    //!  Default implementation panics; backends supporting integer formats
+    //!  should override it.
+    virtual const core::Slice<uint8_t>& begin_push_integer_input();
+
     //! Commit buffer with input data.
     //! @remarks
     //!  Should be called after begin_push_input() to commit the push operation.
@@ -55,6 +65,26 @@ public:
     //!  with more input samples using begin_push_input() and end_push_input().
     virtual size_t pop_output(sample_t* out_data, size_t out_size) = 0;
 
+    //! Read samples from input buffer and fill output planes.
+    //! @remarks
+    //!  Same as pop_output(), but used when sample spec has planar layout.
+    //!  Writes up to @p out_size samples per channel to planes starting at
+    //!  @p out_planes and @p out_stride samples apart, and returns number of
+    //!  samples per channel written.
+    //!  Default implementation panics; backends supporting planar layout
+    //!  should override it.
+    virtual size_t
+    pop_planar_output(sample_t* out_planes, size_t out_stride, size_t out_size);
+
+    //! Read samples from input buffer and fill output frame in integer format.
+    //! @remarks
+    //!  Same as pop_output(), but used when sample spec has integer format.
+    //!  Writes up to @p out_size interleaved samples in this format to
+    //!  @p out_data, and returns number of samples written.
+    //!  Default implementation panics; backends supporting integer formats
+    //!  should override it.
+    virtual size_t pop_integer_output(void* out_data, size_t out_size);
+
     //! How many samples were pushed but not processed yet.
     //! @remarks
     //!  If last input sample pushed to resampler has number N, then last output sample
@@ -32,6 +32,7 @@ LatencyMonitor::LatencyMonitor(IFrameReader& frame_reader,
     , link_meter_(link_meter)
     , resampler_(resampler)
     , enable_scaling_(config.tuner_profile != audio::LatencyTunerProfile_Intact)
+    , scaling_(1.0f)
     , capture_ts_(0)
     , packet_sample_spec_(packet_sample_spec)
     , frame_sample_spec_(frame_sample_spec)
@@ -66,6 +67,12 @@ const LatencyMetrics& LatencyMonitor::metrics() const {
     return latency_metrics_;
 }
 
+float LatencyMonitor::scaling() const {
+    roc_panic_if(!is_valid());
+
+    return scaling_;
+}
+
 bool LatencyMonitor::read(Frame& frame) {
     roc_panic_if(!is_valid());
 
@@ -207,6 +214,7 @@ bool LatencyMonitor::update_scaling_() {
                     (double)scaling);
             return false;
         }
+        scaling_ = scaling;
     }
 
     return true;
@@ -78,6 +78,11 @@ public:
     //! Get metrics.
     const LatencyMetrics& metrics() const;
 
+    //! Get scaling factor last passed to resampler.
+    //! @remarks
+    //!  Returns 1 if scaling is disabled.
+    float scaling() const;
+
     //! Read audio frame from a pipeline.
     //! @remarks
     //!  Forwards frame from underlying reader as-is.
@@ -115,6 +120,7 @@ private:
 
     ResamplerReader* resampler_;
     const bool enable_scaling_;
+    float scaling_;
 
     core::nanoseconds_t capture_ts_;
 
@@ -18,6 +18,27 @@ namespace {
 
 const core::nanoseconds_t LogInterval = 5 * core::Second;
 
+// How often adaptive profile updates target latency.
+const core::nanoseconds_t AdaptInterval = 200 * core::Millisecond;
+
+// How long adaptive profile waits after target latency was increased
+// before starting to decrease it.
+const core::nanoseconds_t HoldInterval = 10 * core::Second;
+
+// Target latency needed to absorb jitter, as a multiple of jitter.
+const double JitterMultiplier = 4;
+
+// How many packets should be lost during adapt interval to consider
+// it a loss burst.
+const int64_t LossBurstLen = 2;
+
+// How much target latency is increased on loss burst.
+const double LossBurstGrowth = 1.5;
+
+// Which fraction of distance to desired target latency is passed
+// every adapt interval when decreasing target latency.
+const double DecayRate = 0.01;
+
 } // namespace
 
 void LatencyConfig::deduce_defaults(core::nanoseconds_t default_target_latency,
@@ -80,6 +101,29 @@ void LatencyConfig::deduce_defaults(core::nanoseconds_t default_target_latency,
         }
     }
 
+    // If target latency is adaptive.
+    if (tuner_profile == LatencyTunerProfile_Adaptive) {
+        // Deduce defaults for min_target_latency & max_target_latency.
+        // By default, target latency can go from a value suitable for good LAN
+        // links to twice the initial value.
+        if (target_latency > 0) {
+            if (min_target_latency == 0) {
+                min_target_latency = std::min(target_latency, 20 * core::Millisecond);
+            }
+            if (max_target_latency == 0) {
+                max_target_latency = target_latency * 2;
+            }
+        } else {
+            // Can't deduce bounds without target_latency.
+            if (min_target_latency == 0) {
+                min_target_latency = -1;
+            }
+            if (max_target_latency == 0) {
+                max_target_latency = -1;
+            }
+        }
+    }
+
     // If latency tuning is enabled.
     if (tuner_profile != LatencyTunerProfile_Intact) {
         // Deduce defaults for min_latency & max_latency if both are zero.
@@ -119,6 +163,11 @@ void LatencyConfig::deduce_defaults(core::nanoseconds_t default_target_latency,
         if (scaling_tolerance == 0) {
             scaling_tolerance = 0.005f;
         }
+
+        // Deduce default for start_scaling.
+        if (start_latency != 0 && start_scaling == 0) {
+            start_scaling = 0.01f;
+        }
     }
 
     // If latency bounding is enabled.
@@ -146,6 +195,8 @@ LatencyTuner::LatencyTuner(const LatencyConfig& config, const SampleSpec& sample
     , has_new_freq_coeff_(false)
     , freq_coeff_(0)
     , freq_coeff_max_delta_(config.scaling_tolerance)
+    , starting_(config.start_latency > 0)
+    , start_scaling_(config.start_scaling)
     , backend_(config.tuner_backend)
     , profile_(config.tuner_profile)
     , enable_tuning_(config.tuner_profile != audio::LatencyTunerProfile_Intact)
@@ -158,7 +209,16 @@ LatencyTuner::LatencyTuner(const LatencyConfig& config, const SampleSpec& sample
     , e2e_latency_(0)
     , has_jitter_(false)
     , jitter_(0)
+    , lost_packets_(0)
+    , prev_lost_packets_(0)
+    , enable_adaptation_(config.tuner_profile == audio::LatencyTunerProfile_Adaptive)
+    , adapt_interval_(sample_spec.ns_2_stream_timestamp_delta(AdaptInterval))
+    , adapt_pos_(0)
+    , hold_interval_(sample_spec.ns_2_stream_timestamp_delta(HoldInterval))
+    , hold_pos_((packet::stream_timestamp_t)hold_interval_)
     , target_latency_(0)
+    , min_target_latency_(0)
+    , max_target_latency_(0)
     , min_latency_(0)
     , max_latency_(0)
     , max_stalling_(0)
@@ -167,15 +227,22 @@ LatencyTuner::LatencyTuner(const LatencyConfig& config, const SampleSpec& sample
     roc_log(LogDebug,
             "latency tuner: initializing:"
             " target_latency=%ld(%.3fms) latency_tolerance=%ld(%.3fms)"
-            " stale_tolerance=%ld(%.3fms)"
+            " min_target_latency=%ld(%.3fms) max_target_latency=%ld(%.3fms)"
+            " stale_tolerance=%ld(%.3fms) start_latency=%ld(%.3fms)"
             " scaling_interval=%ld(%.3fms) scaling_tolerance=%f"
             " backend=%s profile=%s",
             (long)sample_spec_.ns_2_stream_timestamp_delta(config.target_latency),
             (double)config.target_latency / core::Millisecond,
             (long)sample_spec_.ns_2_stream_timestamp_delta(config.latency_tolerance),
             (double)config.latency_tolerance / core::Millisecond,
+            (long)sample_spec_.ns_2_stream_timestamp_delta(config.min_target_latency),
+            (double)config.min_target_latency / core::Millisecond,
+            (long)sample_spec_.ns_2_stream_timestamp_delta(config.max_target_latency),
+            (double)config.max_target_latency / core::Millisecond,
             (long)sample_spec_.ns_2_stream_timestamp_delta(config.stale_tolerance),
             (double)config.stale_tolerance / core::Millisecond,
+            (long)sample_spec_.ns_2_stream_timestamp_delta(config.start_latency),
+            (double)config.start_latency / core::Millisecond,
             (long)sample_spec_.ns_2_stream_timestamp_delta(config.scaling_interval),
             (double)config.scaling_interval / core::Millisecond,
             (double)config.scaling_tolerance, latency_tuner_backend_to_str(backend_),
@@ -188,6 +255,34 @@ LatencyTuner::LatencyTuner(const LatencyConfig& config, const SampleSpec& sample
         return;
     }
 
+    if (config.start_latency != 0) {
+        if (!enable_tuning_) {
+            roc_log(LogError,
+                    "latency tuner: invalid config:"
+                    " start_latency requires latency tuning to be enabled");
+            return;
+        }
+
+        if (config.start_latency < 0 || config.start_latency > config.target_latency) {
+            roc_log(LogError,
+                    "latency tuner: invalid config: start_latency is out of bounds:"
+                    " start_latency=%ld(%.3fms) target_latency=%ld(%.3fms)",
+                    (long)sample_spec_.ns_2_stream_timestamp_delta(config.start_latency),
+                    (double)config.start_latency / core::Millisecond,
+                    (long)sample_spec_.ns_2_stream_timestamp_delta(config.target_latency),
+                    (double)config.target_latency / core::Millisecond);
+            return;
+        }
+
+        if (config.start_scaling <= 0 || config.start_scaling >= 1) {
+            roc_log(LogError,
+                    "latency tuner: invalid config: start_scaling is out of bounds:"
+                    " start_scaling=%f",
+                    (double)config.start_scaling);
+            return;
+        }
+    }
+
     if (enable_bounds_ || enable_tuning_) {
         target_latency_ = sample_spec_.ns_2_stream_timestamp_delta(config.target_latency);
 
@@ -200,11 +295,40 @@ LatencyTuner::LatencyTuner(const LatencyConfig& config, const SampleSpec& sample
             return;
         }
 
+        if (enable_adaptation_) {
+            min_target_latency_ =
+                sample_spec_.ns_2_stream_timestamp_delta(config.min_target_latency);
+            max_target_latency_ =
+                sample_spec_.ns_2_stream_timestamp_delta(config.max_target_latency);
+
+            if (config.min_target_latency <= 0 || min_target_latency_ <= 0
+                || config.max_target_latency < config.target_latency
+                || config.min_target_latency > config.target_latency) {
+                roc_log(LogError,
+                        "latency tuner: invalid config: target latency bounds are"
+                        " invalid: min_target_latency=%ld(%.3fms)"
+                        " max_target_latency=%ld(%.3fms) target_latency=%ld(%.3fms)",
+                        (long)min_target_latency_,
+                        (double)config.min_target_latency / core::Millisecond,
+                        (long)max_target_latency_,
+                        (double)config.max_target_latency / core::Millisecond,
+                        (long)target_latency_,
+                        (double)config.target_latency / core::Millisecond);
+                return;
+            }
+        } else {
+            min_target_latency_ = target_latency_;
+            max_target_latency_ = target_latency_;
+        }
+
         if (enable_bounds_) {
-            min_latency_ = sample_spec_.ns_2_stream_timestamp_delta(
-                config.target_latency - config.latency_tolerance);
-            max_latency_ = sample_spec_.ns_2_stream_timestamp_delta(
-                config.target_latency + config.latency_tolerance);
+            // When target latency is adaptive, bounds cover the whole range
+            // of possible targets, so that changing target doesn't make
+            // current latency invalid.
+            min_latency_ = min_target_latency_
+                - sample_spec_.ns_2_stream_timestamp_delta(config.latency_tolerance);
+            max_latency_ = max_target_latency_
+                + sample_spec_.ns_2_stream_timestamp_delta(config.latency_tolerance);
             max_stalling_ =
                 sample_spec_.ns_2_stream_timestamp_delta(config.stale_tolerance);
 
@@ -244,9 +368,9 @@ LatencyTuner::LatencyTuner(const LatencyConfig& config, const SampleSpec& sample
             }
 
             fe_.reset(new (fe_)
-                          FreqEstimator(profile_ == LatencyTunerProfile_Responsive
-                                            ? FreqEstimatorProfile_Responsive
-                                            : FreqEstimatorProfile_Gradual,
+                          FreqEstimator(profile_ == LatencyTunerProfile_Gradual
+                                            ? FreqEstimatorProfile_Gradual
+                                            : FreqEstimatorProfile_Responsive,
                                         (packet::stream_timestamp_t)target_latency_));
             if (!fe_) {
                 return;
@@ -284,6 +408,8 @@ void LatencyTuner::write_metrics(const LatencyMetrics& latency_metrics,
         jitter_ = sample_spec_.ns_2_stream_timestamp_delta(link_metrics.jitter);
         has_jitter_ = true;
     }
+
+    lost_packets_ = link_metrics.lost_packets;
 }
 
 bool LatencyTuner::update_stream() {
@@ -310,6 +436,10 @@ bool LatencyTuner::update_stream() {
         break;
     }
 
+    if (enable_adaptation_) {
+        adapt_target_();
+    }
+
     if (enable_bounds_) {
         if (!check_bounds_(latency)) {
             return false;
@@ -342,12 +472,84 @@ float LatencyTuner::fetch_scaling() {
     return freq_coeff_;
 }
 
+core::nanoseconds_t LatencyTuner::target_latency() const {
+    roc_panic_if(!is_valid());
+
+    return sample_spec_.stream_timestamp_delta_2_ns(target_latency_);
+}
+
+void LatencyTuner::adapt_target_() {
+    if (stream_pos_ < adapt_pos_) {
+        return;
+    }
+
+    while (stream_pos_ >= adapt_pos_) {
+        adapt_pos_ += (packet::stream_timestamp_t)adapt_interval_;
+    }
+
+    // Loss burst is detected by the number of packets lost since previous
+    // adaptation. Sporadic single losses are ignored, because they are not
+    // caused by congestion and increasing latency won't help with them.
+    const bool is_loss_burst = lost_packets_ - prev_lost_packets_ >= LossBurstLen;
+    prev_lost_packets_ = lost_packets_;
+
+    // Latency that is needed to absorb currently measured jitter.
+    const double jitter_target = (double)jitter_ * JitterMultiplier;
+
+    double new_target = (double)target_latency_;
+
+    if (is_loss_burst || jitter_target > new_target) {
+        // Link is congested, grow quickly: jump right to the required value,
+        // and postpone decreasing target for a while.
+        if (is_loss_burst) {
+            new_target *= LossBurstGrowth;
+        }
+        new_target = std::max(new_target, jitter_target);
+
+        hold_pos_ = stream_pos_ + (packet::stream_timestamp_t)hold_interval_;
+    } else if (has_jitter_ && !packet::stream_timestamp_lt(stream_pos_, hold_pos_)) {
+        // Link is clean for a while, shrink slowly: pass a small fraction
+        // of the distance to the required value.
+        new_target -= std::max((new_target - jitter_target) * DecayRate, 1.);
+    }
+
+    new_target = std::min(new_target, (double)max_target_latency_);
+    new_target = std::max(new_target, (double)min_target_latency_);
+
+    if ((packet::stream_timestamp_diff_t)new_target != target_latency_) {
+        set_target_((packet::stream_timestamp_diff_t)new_target);
+    }
+}
+
+void LatencyTuner::set_target_(packet::stream_timestamp_diff_t target_latency) {
+    roc_log(LogTrace,
+            "latency tuner: updating target latency:"
+            " old=%ld(%.3fms) new=%ld(%.3fms) jitter=%ld(%.3fms)",
+            (long)target_latency_,
+            sample_spec_.stream_timestamp_delta_2_ms(target_latency_),
+            (long)target_latency,
+            sample_spec_.stream_timestamp_delta_2_ms(target_latency), (long)jitter_,
+            sample_spec_.stream_timestamp_delta_2_ms(jitter_));
+
+    target_latency_ = target_latency;
+
+    if (fe_) {
+        fe_->update_target_latency((packet::stream_timestamp_t)target_latency_);
+    }
+}
+
 bool LatencyTuner::check_bounds_(const packet::stream_timestamp_diff_t latency) {
     // Queue is considered "stalling" if there were no new packets for
     // some period of time.
     const bool is_stalling = backend_ == audio::LatencyTunerBackend_Niq
         && niq_stalling_ > max_stalling_ && max_stalling_ > 0;
 
+    if (latency < min_latency_ && starting_) {
+        // During fast start, latency is expected to be below target, and may
+        // be below minimum until it grows enough.
+        return true;
+    }
+
     if (latency < min_latency_ && is_stalling) {
         // There are two possible reasons why queue latency becomes lower than minimum:
         //  1. either we were not able to compensate clock drift (or compensation is
@@ -395,13 +597,34 @@ void LatencyTuner::compute_scaling_(packet::stream_timestamp_diff_t latency) {
         return;
     }
 
+    if (starting_ && latency >= target_latency_) {
+        roc_log(LogDebug,
+                "latency tuner: fast start finished:"
+                " latency=%ld(%.3fms) target=%ld(%.3fms)",
+                (long)latency, sample_spec_.stream_timestamp_delta_2_ms(latency),
+                (long)target_latency_,
+                sample_spec_.stream_timestamp_delta_2_ms(target_latency_));
+        starting_ = false;
+    }
+
     while (stream_pos_ >= scale_pos_) {
-        fe_->update((packet::stream_timestamp_t)latency);
+        // During fast start, frequency estimator is not updated, otherwise
+        // it would accumulate error and overshoot when fast start finishes.
+        if (!starting_) {
+            fe_->update((packet::stream_timestamp_t)latency);
+        }
         scale_pos_ += (packet::stream_timestamp_t)scale_interval_;
     }
 
     has_new_freq_coeff_ = true;
 
+    if (starting_) {
+        // Slow down playback with constant rate until latency
+        // grows up to target.
+        freq_coeff_ = 1.0f - start_scaling_;
+        return;
+    }
+
     freq_coeff_ = fe_->freq_coeff();
     freq_coeff_ = std::min(freq_coeff_, 1.0f + freq_coeff_max_delta_);
     freq_coeff_ = std::max(freq_coeff_, 1.0f - freq_coeff_max_delta_);
@@ -458,6 +681,9 @@ const char* latency_tuner_profile_to_str(LatencyTunerProfile profile) {
 
     case LatencyTunerProfile_Gradual:
         return "gradual";
+
+    case LatencyTunerProfile_Adaptive:
+        return "adaptive";
     }
 
     return "<invalid>";
@@ -57,7 +57,13 @@ enum LatencyTunerProfile {
 
     //! Slow and smooth tuning.
     //! Good for higher network latency and jitter.
-    LatencyTunerProfile_Gradual
+    LatencyTunerProfile_Gradual,
+
+    //! Responsive tuning with adaptive target latency.
+    //! Target latency follows measured network jitter and losses
+    //! within configured bounds.
+    //! Good for links with low but unstable jitter, e.g. Wi-Fi.
+    LatencyTunerProfile_Adaptive
 };
 
 //! Latency settings.
@@ -80,6 +86,45 @@ struct LatencyConfig {
     //!  Negative value is an error.
     core::nanoseconds_t target_latency;
 
+    //! Minimum target latency.
+    //! @remarks
+    //!  Used by adaptive profile. Target latency is never decreased
+    //!  below this value.
+    //! @note
+    //!  If zero, default value is used if possible.
+    //!  Negative value is an error.
+    core::nanoseconds_t min_target_latency;
+
+    //! Maximum target latency.
+    //! @remarks
+    //!  Used by adaptive profile. Target latency is never increased
+    //!  above this value.
+    //! @note
+    //!  If zero, default value is used if possible.
+    //!  Negative value is an error.
+    core::nanoseconds_t max_target_latency;
+
+    //! Start latency.
+    //! @remarks
+    //!  If non-zero, enables fast start: playback begins as soon as this
+    //!  much is buffered, instead of waiting until target latency is reached,
+    //!  and then latency tuner slows down playback until latency grows up
+    //!  to the target.
+    //! @note
+    //!  If zero, fast start is disabled.
+    //!  Should not be larger than target latency.
+    //!  Requires latency tuning to be enabled.
+    core::nanoseconds_t start_latency;
+
+    //! How much to slow down playback during fast start.
+    //! @remarks
+    //!  For example, 0.01 means that during fast start freq_coeff is 0.99,
+    //!  i.e. latency grows by 10ms every second.
+    //! @note
+    //!  If zero, default value is used.
+    //!  Negative value is an error.
+    float start_scaling;
+
     //! Maximum allowed deviation from target latency.
     //! @remarks
     //!  If the latency goes out of bounds, the session is terminated.
@@ -119,6 +164,10 @@ struct LatencyConfig {
         : tuner_backend(LatencyTunerBackend_Default)
         , tuner_profile(LatencyTunerProfile_Default)
         , target_latency(0)
+        , min_target_latency(0)
+        , max_target_latency(0)
+        , start_latency(0)
+        , start_scaling(0)
         , latency_tolerance(0)
         , stale_tolerance(0)
         , scaling_interval(0)
@@ -164,6 +213,11 @@ struct LatencyMetrics {
 //! - assuming that the difference between actual latency and target latency is
 //!   caused by the clock drift between sender and receiver, calculates scaling
 //!   factor for resampler to compensate it
+//! - with fast start, slows down playback until latency grows from start
+//!   latency up to target latency
+//! - with adaptive profile, adjusts target latency itself: increases it quickly
+//!   when jitter grows or packets are lost in bursts, and decreases it slowly
+//!   when link stays clean
 class LatencyTuner : public core::NonCopyable<> {
 public:
     //! Initialize.
@@ -183,6 +237,8 @@ public:
     //!    metrics to use
     //!  - check if latency goes out of bounds and session should be
     //!    terminated; if so, returns false
+    //!  - with adaptive profile, updates target latency based on jitter
+    //!    and losses
     //!  - computes updated scaling based on latency history and configured
     //!    profile
     bool update_stream();
@@ -199,7 +255,14 @@ public:
     //!  Returned value is close to 1.0.
     float fetch_scaling();
 
+    //! Get current target latency.
+    //! @remarks
+    //!  Constant unless adaptive profile is used.
+    core::nanoseconds_t target_latency() const;
+
 private:
+    void adapt_target_();
+    void set_target_(packet::stream_timestamp_diff_t target_latency);
     bool check_bounds_(packet::stream_timestamp_diff_t latency);
     void compute_scaling_(packet::stream_timestamp_diff_t latency);
     void report_();
@@ -218,6 +281,9 @@ private:
     float freq_coeff_;
     const float freq_coeff_max_delta_;
 
+    bool starting_;
+    const float start_scaling_;
+
     const LatencyTunerBackend backend_;
     const LatencyTunerProfile profile_;
 
@@ -234,7 +300,18 @@ private:
     bool has_jitter_;
     packet::stream_timestamp_diff_t jitter_;
 
+    int64_t lost_packets_;
+    int64_t prev_lost_packets_;
+
+    const bool enable_adaptation_;
+    packet::stream_timestamp_diff_t adapt_interval_;
+    packet::stream_timestamp_t adapt_pos_;
+    packet::stream_timestamp_diff_t hold_interval_;
+    packet::stream_timestamp_t hold_pos_;
+
     packet::stream_timestamp_diff_t target_latency_;
+    packet::stream_timestamp_diff_t min_target_latency_;
+    packet::stream_timestamp_diff_t max_target_latency_;
     packet::stream_timestamp_diff_t min_latency_;
     packet::stream_timestamp_diff_t max_latency_;
     packet::stream_timestamp_diff_t max_stalling_;
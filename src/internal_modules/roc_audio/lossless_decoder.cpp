@@ -0,0 +1,435 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/lossless_decoder.h"
+#include "roc_audio/lossless_format.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+using namespace lossless;
+
+// Reads bits from frame, MSB first.
+// Reading beyond the end of frame returns zero bits and sets error flag.
+class LosslessDecoder::BitReader {
+public:
+    BitReader(const uint8_t* data, size_t size)
+        : data_(data)
+        , size_(size)
+        , pos_(0)
+        , acc_(0)
+        , acc_bits_(0)
+        , error_(false) {
+    }
+
+    bool error() const {
+        return error_;
+    }
+
+    // Read n_bits unsigned value, n_bits <= 32.
+    uint32_t read(unsigned n_bits) {
+        if (n_bits == 0) {
+            return 0;
+        }
+
+        while (acc_bits_ < n_bits) {
+            acc_ = (acc_ << 8) | get_byte_();
+            acc_bits_ += 8;
+        }
+
+        acc_bits_ -= n_bits;
+
+        return (uint32_t)(acc_ >> acc_bits_) & (uint32_t)(((uint64_t)1 << n_bits) - 1);
+    }
+
+    // Read n_bits signed value in two's complement, n_bits <= 32.
+    int32_t read_signed(unsigned n_bits) {
+        const uint32_t value = read(n_bits);
+
+        if (n_bits < 32 && (value >> (n_bits - 1)) != 0) {
+            return (int32_t)(value | ~(((uint32_t)1 << n_bits) - 1));
+        }
+        return (int32_t)value;
+    }
+
+    // Read value coded using Rice code with given parameter.
+    uint32_t read_rice(unsigned param) {
+        uint32_t quotient = 0;
+
+        while (read(1) == 0) {
+            if (error_) {
+                return 0;
+            }
+            quotient++;
+        }
+
+        return (quotient << param) | read(param);
+    }
+
+private:
+    uint8_t get_byte_() {
+        if (pos_ >= size_) {
+            error_ = true;
+            return 0;
+        }
+        return data_[pos_++];
+    }
+
+    const uint8_t* data_;
+    size_t size_;
+    size_t pos_;
+
+    uint64_t acc_;
+    unsigned acc_bits_;
+
+    bool error_;
+};
+
+namespace {
+
+// Reverse folding performed by encoder.
+inline int32_t unfold_residual(uint32_t u) {
+    return (u & 1) ? -(int32_t)(u >> 1) - 1 : (int32_t)(u >> 1);
+}
+
+// Compute sample from residual and previous samples using fixed predictor.
+// Uses 64-bit arithmetic so that corrupted input can't cause overflow.
+inline int32_t fixed_restore(const int32_t* s, size_t i, unsigned order, int32_t r) {
+    int64_t v = r;
+
+    switch (order) {
+    case 0:
+        break;
+    case 1:
+        v += (int64_t)s[i - 1];
+        break;
+    case 2:
+        v += 2 * (int64_t)s[i - 1] - s[i - 2];
+        break;
+    case 3:
+        v += 3 * (int64_t)s[i - 1] - 3 * (int64_t)s[i - 2] + s[i - 3];
+        break;
+    default:
+        v += 4 * (int64_t)s[i - 1] - 6 * (int64_t)s[i - 2] + 4 * (int64_t)s[i - 3]
+            - s[i - 4];
+        break;
+    }
+
+    return (int32_t)v;
+}
+
+// Check that frame is large enough to hold declared number of samples.
+// Size of constant subframe doesn't depend on number of samples, and it's
+// byte-aligned, so leading constant subframes are walked as is. For the first
+// non-constant subframe, minimum size is computed from its header, and for
+// the following ones, minimum size of any subframe is used.
+bool check_frame_size(const uint8_t* payload,
+                      size_t payload_size,
+                      size_t n_samples,
+                      size_t n_chans) {
+    const uint64_t avail_bits = (uint64_t)payload_size * 8;
+    const uint64_t min_subframe_bits =
+        SubframeHeaderBits + std::min((uint64_t)n_samples, (uint64_t)BitDepth);
+
+    uint64_t need_bits = 0;
+
+    for (size_t c = 0; c < n_chans && n_samples != 0; c++) {
+        const size_t off = (size_t)(need_bits / 8);
+        if (off >= payload_size) {
+            return false;
+        }
+
+        const unsigned type = payload[off] >> WastedBits;
+        const unsigned wasted_bits = payload[off] & ((1u << WastedBits) - 1);
+
+        if (wasted_bits >= BitDepth) {
+            return false;
+        }
+
+        if (type == Subframe_Constant) {
+            need_bits += SubframeHeaderBits + BitDepth;
+            continue;
+        }
+
+        const unsigned sample_bits = BitDepth - wasted_bits;
+
+        if (type == Subframe_Verbatim) {
+            need_bits += SubframeHeaderBits + (uint64_t)n_samples * sample_bits;
+        } else if (type >= Subframe_Fixed && type <= Subframe_Fixed + MaxFixedOrder) {
+            const size_t order = type - Subframe_Fixed;
+            if (order > n_samples) {
+                return false;
+            }
+            // Every residual takes at least one bit.
+            need_bits += SubframeHeaderBits + (uint64_t)order * sample_bits
+                + PartitionOrderBits + RiceParamBits + (n_samples - order);
+        } else {
+            return false;
+        }
+
+        need_bits += (uint64_t)(n_chans - c - 1) * min_subframe_bits;
+        break;
+    }
+
+    return need_bits <= avail_bits;
+}
+
+bool parse_header(const void* frame_data,
+                  size_t frame_size,
+                  size_t& n_samples,
+                  size_t& n_chans) {
+    if (frame_size < FrameHeaderSize) {
+        return false;
+    }
+
+    const uint8_t* data = (const uint8_t*)frame_data;
+
+    n_samples = ((size_t)data[0] << 8) | data[1];
+    n_chans = ((size_t)data[2] << 8) | data[3];
+
+    return check_frame_size(data + FrameHeaderSize, frame_size - FrameHeaderSize,
+                            n_samples, n_chans);
+}
+
+} // namespace
+
+IFrameDecoder* LosslessDecoder::construct(core::IArena& arena,
+                                          const SampleSpec& sample_spec) {
+    return new (arena) LosslessDecoder(sample_spec, arena);
+}
+
+LosslessDecoder::LosslessDecoder(const SampleSpec& sample_spec, core::IArena& arena)
+    : n_chans_(sample_spec.num_channels())
+    , chan_samples_(arena)
+    , samples_(arena)
+    , stream_pos_(0)
+    , stream_avail_(0)
+    , frame_data_(NULL)
+    , frame_off_(0) {
+}
+
+packet::stream_timestamp_t LosslessDecoder::position() const {
+    return stream_pos_;
+}
+
+packet::stream_timestamp_t LosslessDecoder::available() const {
+    return stream_avail_;
+}
+
+size_t LosslessDecoder::decoded_sample_count(const void* frame_data,
+                                             size_t frame_size) const {
+    roc_panic_if_not(frame_data);
+
+    size_t n_samples = 0, n_chans = 0;
+    if (!parse_header(frame_data, frame_size, n_samples, n_chans)
+        || n_chans != n_chans_) {
+        return 0;
+    }
+
+    return n_samples;
+}
+
+void LosslessDecoder::begin(packet::stream_timestamp_t frame_position,
+                            const void* frame_data,
+                            size_t frame_size) {
+    roc_panic_if_not(frame_data);
+
+    if (frame_data_) {
+        roc_panic("lossless decoder: unpaired begin/end");
+    }
+
+    frame_data_ = frame_data;
+    frame_off_ = 0;
+
+    stream_pos_ = frame_position;
+    stream_avail_ = 0;
+
+    if (!decode_frame_(frame_data, frame_size)) {
+        roc_log(LogDebug, "lossless decoder: dropping malformed frame: size=%lu",
+                (unsigned long)frame_size);
+        return;
+    }
+
+    stream_avail_ = (packet::stream_timestamp_t)(samples_.size() / n_chans_);
+}
+
+size_t LosslessDecoder::read(sample_t* samples, size_t n_samples) {
+    if (!frame_data_) {
+        roc_panic("lossless decoder: read should be called only between begin/end");
+    }
+
+    if (n_samples > (size_t)stream_avail_) {
+        n_samples = (size_t)stream_avail_;
+    }
+
+    if (n_samples == 0) {
+        return 0;
+    }
+
+    memcpy(samples, samples_.data() + frame_off_ * n_chans_,
+           n_samples * n_chans_ * sizeof(sample_t));
+
+    frame_off_ += n_samples;
+
+    stream_pos_ += (packet::stream_timestamp_t)n_samples;
+    stream_avail_ -= (packet::stream_timestamp_t)n_samples;
+
+    return n_samples;
+}
+
+size_t LosslessDecoder::shift(size_t n_samples) {
+    if (!frame_data_) {
+        roc_panic("lossless decoder: shift should be called only between begin/end");
+    }
+
+    if (n_samples > (size_t)stream_avail_) {
+        n_samples = (size_t)stream_avail_;
+    }
+
+    frame_off_ += n_samples;
+
+    stream_pos_ += (packet::stream_timestamp_t)n_samples;
+    stream_avail_ -= (packet::stream_timestamp_t)n_samples;
+
+    return n_samples;
+}
+
+void LosslessDecoder::end() {
+    if (!frame_data_) {
+        roc_panic("lossless decoder: unpaired begin/end");
+    }
+
+    stream_avail_ = 0;
+
+    frame_data_ = NULL;
+    frame_off_ = 0;
+}
+
+bool LosslessDecoder::decode_frame_(const void* frame_data, size_t frame_size) {
+    size_t n_samples = 0, n_chans = 0;
+
+    if (!parse_header(frame_data, frame_size, n_samples, n_chans)) {
+        return false;
+    }
+
+    if (n_chans != n_chans_) {
+        return false;
+    }
+
+    // Normally allocation happens only for the first frame.
+    if (!samples_.resize(n_samples * n_chans_) || !chan_samples_.resize(n_samples)) {
+        roc_log(LogError, "lossless decoder: can't allocate buffers: n_samples=%lu",
+                (unsigned long)n_samples);
+        samples_.clear();
+        return false;
+    }
+
+    BitReader reader((const uint8_t*)frame_data + FrameHeaderSize,
+                     frame_size - FrameHeaderSize);
+
+    for (size_t c = 0; c < n_chans_ && n_samples != 0; c++) {
+        if (!decode_channel_(reader, c, n_samples)) {
+            samples_.clear();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool LosslessDecoder::decode_channel_(BitReader& reader, size_t chan, size_t n_samples) {
+    int32_t* s = chan_samples_.data();
+
+    const unsigned type = reader.read(SubframeTypeBits);
+    const unsigned wasted_bits = reader.read(WastedBits);
+
+    if (wasted_bits >= BitDepth) {
+        return false;
+    }
+
+    const unsigned sample_bits = BitDepth - wasted_bits;
+
+    if (type == Subframe_Constant) {
+        const int32_t value = reader.read_signed(BitDepth);
+        for (size_t i = 0; i < n_samples; i++) {
+            s[i] = value;
+        }
+    } else if (type == Subframe_Verbatim) {
+        for (size_t i = 0; i < n_samples; i++) {
+            s[i] = reader.read_signed(sample_bits);
+        }
+    } else if (type >= Subframe_Fixed && type <= Subframe_Fixed + MaxFixedOrder) {
+        const unsigned order = type - Subframe_Fixed;
+
+        if (order > n_samples) {
+            return false;
+        }
+
+        for (size_t i = 0; i < order; i++) {
+            s[i] = reader.read_signed(sample_bits);
+        }
+
+        const unsigned partition_order = reader.read(PartitionOrderBits);
+        if (partition_order > MaxPartitionOrder) {
+            return false;
+        }
+
+        const size_t n_residuals = n_samples - order;
+        const size_t part_len = partition_length(n_residuals, partition_order);
+
+        for (size_t start = 0; start < n_residuals; start += part_len) {
+            const size_t end = std::min(start + part_len, n_residuals);
+
+            const unsigned param = reader.read(RiceParamBits);
+            if (param > MaxRiceParam) {
+                return false;
+            }
+
+            for (size_t i = order + start; i < order + end; i++) {
+                s[i] = fixed_restore(s, i, order,
+                                     unfold_residual(reader.read_rice(param)));
+            }
+
+            if (reader.error()) {
+                return false;
+            }
+        }
+    } else {
+        return false;
+    }
+
+    if (reader.error()) {
+        return false;
+    }
+
+    sample_t* out = samples_.data() + chan;
+
+    const int64_t min_value = -((int64_t)1 << (BitDepth - 1));
+    const int64_t max_value = ((int64_t)1 << (BitDepth - 1)) - 1;
+
+    for (size_t i = 0; i < n_samples; i++) {
+        // Multiplication instead of shift, because shift of negative
+        // number is undefined. Clamping affects only corrupted frames.
+        int64_t value = (int64_t)s[i] * ((int64_t)1 << wasted_bits);
+        if (value < min_value) {
+            value = min_value;
+        } else if (value > max_value) {
+            value = max_value;
+        }
+
+        *out = dequantize_sample((int32_t)value);
+        out += n_chans_;
+    }
+
+    return true;
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,407 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/lossless_encoder.h"
+#include "roc_audio/lossless_format.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+using namespace lossless;
+
+// Writes bits to frame, MSB first.
+class LosslessEncoder::BitWriter {
+public:
+    BitWriter(uint8_t* data, size_t size)
+        : data_(data)
+        , size_(size)
+        , pos_(0)
+        , acc_(0)
+        , acc_bits_(0) {
+    }
+
+    // Write lower n_bits of value, n_bits <= 32.
+    void write(uint32_t value, unsigned n_bits) {
+        if (n_bits == 0) {
+            return;
+        }
+        if (n_bits < 32) {
+            value &= ((uint32_t)1 << n_bits) - 1;
+        }
+
+        acc_ = (acc_ << n_bits) | value;
+        acc_bits_ += n_bits;
+
+        while (acc_bits_ >= 8) {
+            acc_bits_ -= 8;
+            put_byte_((uint8_t)(acc_ >> acc_bits_));
+        }
+    }
+
+    // Write value using Rice code with given parameter.
+    void write_rice(uint32_t value, unsigned param) {
+        uint32_t quotient = value >> param;
+
+        if (quotient + 1 + param <= 32) {
+            write(((uint32_t)1 << param) | (value & (((uint32_t)1 << param) - 1)),
+                  quotient + 1 + param);
+            return;
+        }
+
+        while (quotient >= 32) {
+            write(0, 32);
+            quotient -= 32;
+        }
+
+        write(1, quotient + 1);
+        write(value, param);
+    }
+
+    // Pad to byte boundary and return number of bytes written.
+    size_t finish() {
+        if (acc_bits_ != 0) {
+            write(0, 8 - acc_bits_);
+        }
+        return pos_;
+    }
+
+private:
+    void put_byte_(uint8_t byte) {
+        roc_panic_if_msg(pos_ >= size_, "lossless encoder: frame overflow: size=%lu",
+                         (unsigned long)size_);
+        data_[pos_++] = byte;
+    }
+
+    uint8_t* data_;
+    size_t size_;
+    size_t pos_;
+
+    uint64_t acc_;
+    unsigned acc_bits_;
+};
+
+namespace {
+
+// Compute residual of fixed predictor of given order at given position.
+inline int32_t fixed_residual(const int32_t* s, size_t i, unsigned order) {
+    switch (order) {
+    case 0:
+        return s[i];
+    case 1:
+        return s[i] - s[i - 1];
+    case 2:
+        return s[i] - 2 * s[i - 1] + s[i - 2];
+    case 3:
+        return s[i] - 3 * s[i - 1] + 3 * s[i - 2] - s[i - 3];
+    default:
+        return s[i] - 4 * s[i - 1] + 6 * s[i - 2] - 4 * s[i - 3] + s[i - 4];
+    }
+}
+
+// Map signed residual to unsigned: 0, -1, 1, -2, 2, ... => 0, 1, 2, 3, 4, ...
+inline uint32_t fold_residual(int32_t r) {
+    return r >= 0 ? (uint32_t)r << 1 : (((uint32_t)-(r + 1)) << 1) | 1;
+}
+
+// Select best fixed predictor order, using sum of absolute residuals as estimate.
+// Same heuristic as used by FLAC reference encoder.
+unsigned select_fixed_order(const int32_t* s, size_t n_samples) {
+    if (n_samples <= MaxFixedOrder) {
+        return 0;
+    }
+
+    uint64_t err[MaxFixedOrder + 1] = {};
+
+    for (size_t i = MaxFixedOrder; i < n_samples; i++) {
+        const int32_t e0 = s[i];
+        const int32_t e1 = e0 - s[i - 1];
+        const int32_t e2 = e1 - (s[i - 1] - s[i - 2]);
+        const int32_t e3 = e2 - (s[i - 1] - 2 * s[i - 2] + s[i - 3]);
+        const int32_t e4 =
+            e3 - (s[i - 1] - 3 * s[i - 2] + 3 * s[i - 3] - s[i - 4]);
+
+        err[0] += (uint32_t)(e0 < 0 ? -e0 : e0);
+        err[1] += (uint32_t)(e1 < 0 ? -e1 : e1);
+        err[2] += (uint32_t)(e2 < 0 ? -e2 : e2);
+        err[3] += (uint32_t)(e3 < 0 ? -e3 : e3);
+        err[4] += (uint32_t)(e4 < 0 ? -e4 : e4);
+    }
+
+    unsigned order = 0;
+    for (unsigned o = 1; o <= MaxFixedOrder; o++) {
+        if (err[o] < err[order]) {
+            order = o;
+        }
+    }
+
+    return order;
+}
+
+// Estimate optimal Rice parameter for partition with given sum of folded residuals.
+unsigned select_rice_param(uint64_t sum, size_t count) {
+    unsigned param = 0;
+    while (param < MaxRiceParam && ((uint64_t)count << (param + 1)) < sum) {
+        param++;
+    }
+    return param;
+}
+
+// Estimate number of bits needed to code partition with given Rice parameter.
+uint64_t estimate_rice_bits(uint64_t sum, size_t count, unsigned param) {
+    return (uint64_t)count * (param + 1) + (sum >> param);
+}
+
+// Compute exact number of bits needed to code partition with given Rice parameter.
+uint64_t compute_rice_bits(const uint32_t* residuals, size_t count, unsigned param) {
+    uint64_t bits = (uint64_t)count * (param + 1);
+    for (size_t i = 0; i < count; i++) {
+        bits += residuals[i] >> param;
+    }
+    return bits;
+}
+
+} // namespace
+
+IFrameEncoder* LosslessEncoder::construct(core::IArena& arena,
+                                          const SampleSpec& sample_spec) {
+    return new (arena) LosslessEncoder(sample_spec, arena);
+}
+
+LosslessEncoder::LosslessEncoder(const SampleSpec& sample_spec, core::IArena& arena)
+    : n_chans_(sample_spec.num_channels())
+    , samples_(arena)
+    , residuals_(arena)
+    , frame_data_(NULL)
+    , frame_byte_size_(0)
+    , frame_n_samples_(0)
+    , frame_max_samples_(0) {
+    roc_panic_if_msg(n_chans_ > MaxChannels,
+                     "lossless encoder: too many channels: num=%lu max=%lu",
+                     (unsigned long)n_chans_, (unsigned long)MaxChannels);
+}
+
+size_t LosslessEncoder::encoded_byte_count(size_t num_samples) const {
+    return max_frame_size(num_samples, n_chans_);
+}
+
+void LosslessEncoder::begin(void* frame_data, size_t frame_size) {
+    roc_panic_if_not(frame_data);
+
+    if (frame_data_) {
+        roc_panic("lossless encoder: unpaired begin/end");
+    }
+
+    frame_data_ = frame_data;
+    frame_byte_size_ = frame_size;
+    frame_n_samples_ = 0;
+    frame_max_samples_ = max_frame_samples(frame_size, n_chans_);
+
+    // Normally allocation happens only for the first frame.
+    // Both buffers are resized every time, so that if previous allocation
+    // failed half-way, we don't proceed with an undersized buffer.
+    if (!samples_.resize(frame_max_samples_ * n_chans_)
+        || !residuals_.resize(frame_max_samples_)) {
+        roc_log(LogError, "lossless encoder: can't allocate buffers: n_samples=%lu",
+                (unsigned long)frame_max_samples_);
+        frame_max_samples_ = 0;
+    }
+}
+
+size_t LosslessEncoder::write(const sample_t* samples, size_t n_samples) {
+    if (!frame_data_) {
+        roc_panic("lossless encoder: write should be called only between begin/end");
+    }
+
+    if (n_samples > frame_max_samples_ - frame_n_samples_) {
+        n_samples = frame_max_samples_ - frame_n_samples_;
+    }
+
+    if (n_samples == 0) {
+        return 0;
+    }
+
+    // Samples are stored per-channel, because every channel is coded separately.
+    for (size_t c = 0; c < n_chans_; c++) {
+        int32_t* chan_samples =
+            samples_.data() + c * frame_max_samples_ + frame_n_samples_;
+
+        for (size_t i = 0; i < n_samples; i++) {
+            chan_samples[i] = quantize_sample(samples[i * n_chans_ + c]);
+        }
+    }
+
+    frame_n_samples_ += n_samples;
+
+    return n_samples;
+}
+
+size_t LosslessEncoder::end() {
+    if (!frame_data_) {
+        roc_panic("lossless encoder: unpaired begin/end");
+    }
+
+    BitWriter writer((uint8_t*)frame_data_, frame_byte_size_);
+
+    writer.write((uint32_t)frame_n_samples_, 16);
+    writer.write((uint32_t)n_chans_, 16);
+
+    if (frame_n_samples_ != 0) {
+        for (size_t c = 0; c < n_chans_; c++) {
+            encode_channel_(writer, samples_.data() + c * frame_max_samples_);
+        }
+    }
+
+    const size_t written_byte_count = writer.finish();
+    roc_panic_if_not(written_byte_count <= encoded_byte_count(frame_n_samples_));
+
+    frame_data_ = NULL;
+    frame_byte_size_ = 0;
+    frame_n_samples_ = 0;
+    frame_max_samples_ = 0;
+
+    return written_byte_count;
+}
+
+void LosslessEncoder::encode_channel_(BitWriter& writer, int32_t* samples) {
+    const size_t n_samples = frame_n_samples_;
+
+    int32_t bit_mask = 0;
+    bool is_constant = true;
+
+    for (size_t i = 0; i < n_samples; i++) {
+        bit_mask |= samples[i];
+        is_constant = is_constant && samples[i] == samples[0];
+    }
+
+    if (is_constant) {
+        writer.write(Subframe_Constant, SubframeTypeBits);
+        writer.write(0, WastedBits);
+        writer.write((uint32_t)samples[0], BitDepth);
+        return;
+    }
+
+    // Low bits that are zero in all samples, e.g. when 16-bit audio is
+    // transferred using 24-bit encoding.
+    unsigned wasted_bits = 0;
+    while (((bit_mask >> wasted_bits) & 1) == 0) {
+        wasted_bits++;
+    }
+
+    if (wasted_bits != 0) {
+        for (size_t i = 0; i < n_samples; i++) {
+            samples[i] >>= wasted_bits;
+        }
+    }
+
+    const unsigned sample_bits = BitDepth - wasted_bits;
+    const uint64_t verbatim_bits = (uint64_t)n_samples * sample_bits;
+
+    const unsigned order = select_fixed_order(samples, n_samples);
+
+    const size_t n_residuals = n_samples - order;
+    uint32_t* residuals = residuals_.data();
+
+    for (size_t i = 0; i < n_residuals; i++) {
+        residuals[i] = fold_residual(fixed_residual(samples, i + order, order));
+    }
+
+    // Compute sums for finest partitioning; coarser partitionings are
+    // computed by merging them.
+    uint64_t sums[1 << MaxPartitionOrder] = {};
+    size_t n_partitions = 0;
+
+    {
+        const size_t len = partition_length(n_residuals, MaxPartitionOrder);
+        for (size_t start = 0; start < n_residuals; start += len, n_partitions++) {
+            const size_t end = std::min(start + len, n_residuals);
+            for (size_t i = start; i < end; i++) {
+                sums[n_partitions] += residuals[i];
+            }
+        }
+    }
+
+    unsigned best_partition_order = 0;
+    uint64_t best_bits = (uint64_t)-1;
+
+    for (unsigned p = MaxPartitionOrder + 1; p-- > 0;) {
+        const size_t len = partition_length(n_residuals, p);
+        uint64_t bits = 0;
+
+        for (size_t part = 0, start = 0; start < n_residuals; part++, start += len) {
+            const size_t count = std::min(len, n_residuals - start);
+            const unsigned param = select_rice_param(sums[part], count);
+
+            bits += RiceParamBits + estimate_rice_bits(sums[part], count, param);
+        }
+
+        if (bits <= best_bits) {
+            best_bits = bits;
+            best_partition_order = p;
+        }
+
+        if (p != 0) {
+            // Merge adjacent partitions.
+            for (size_t part = 0; part < ((size_t)1 << (p - 1)); part++) {
+                sums[part] = sums[part * 2] + sums[part * 2 + 1];
+            }
+        }
+    }
+
+    // Recompute sums for selected partitioning and compute exact size.
+    const size_t part_len = partition_length(n_residuals, best_partition_order);
+
+    unsigned params[1 << MaxPartitionOrder] = {};
+    uint64_t fixed_bits = (uint64_t)order * sample_bits + PartitionOrderBits;
+
+    for (size_t part = 0, start = 0; start < n_residuals; part++, start += part_len) {
+        const size_t count = std::min(part_len, n_residuals - start);
+
+        uint64_t sum = 0;
+        for (size_t i = 0; i < count; i++) {
+            sum += residuals[start + i];
+        }
+
+        params[part] = select_rice_param(sum, count);
+        fixed_bits +=
+            RiceParamBits + compute_rice_bits(residuals + start, count, params[part]);
+    }
+
+    if (fixed_bits >= verbatim_bits) {
+        writer.write(Subframe_Verbatim, SubframeTypeBits);
+        writer.write(wasted_bits, WastedBits);
+
+        for (size_t i = 0; i < n_samples; i++) {
+            writer.write((uint32_t)samples[i], sample_bits);
+        }
+        return;
+    }
+
+    writer.write(Subframe_Fixed + order, SubframeTypeBits);
+    writer.write(wasted_bits, WastedBits);
+
+    for (size_t i = 0; i < order; i++) {
+        writer.write((uint32_t)samples[i], sample_bits);
+    }
+
+    writer.write(best_partition_order, PartitionOrderBits);
+
+    for (size_t part = 0, start = 0; start < n_residuals; part++, start += part_len) {
+        const size_t count = std::min(part_len, n_residuals - start);
+
+        writer.write(params[part], RiceParamBits);
+
+        for (size_t i = 0; i < count; i++) {
+            writer.write_rice(residuals[start + i], params[part]);
+        }
+    }
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/lossless_encoder.h
+//! @brief Lossless encoder.
+
+#ifndef ROC_AUDIO_LOSSLESS_ENCODER_H_
+#define ROC_AUDIO_LOSSLESS_ENCODER_H_
+
+#include "roc_audio/iframe_encoder.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/array.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+
+namespace roc {
+namespace audio {
+
+//! Lossless encoder.
+//!
+//! Compresses samples using fixed linear predictor and Rice coding of
+//! residuals, see lossless_format.h for details.
+//!
+//! Samples are accumulated by write() and the whole frame is compressed by
+//! end(), so that the encoder can choose predictor and coding parameters
+//! for every channel. Frames don't depend on each other.
+//!
+//! Frame size is variable. encoded_byte_count() returns upper bound, and
+//! end() returns actual size.
+class LosslessEncoder : public IFrameEncoder, public core::NonCopyable<> {
+public:
+    //! Construction function.
+    static IFrameEncoder* construct(core::IArena& arena, const SampleSpec& sample_spec);
+
+    //! Initialize.
+    LosslessEncoder(const SampleSpec& sample_spec, core::IArena& arena);
+
+    //! Get maximum encoded frame size in bytes for given number of samples per channel.
+    virtual size_t encoded_byte_count(size_t num_samples) const;
+
+    //! Start encoding a new frame.
+    virtual void begin(void* frame, size_t frame_size);
+
+    //! Encode samples.
+    virtual size_t write(const sample_t* samples, size_t n_samples);
+
+    //! Finish encoding frame.
+    virtual size_t end();
+
+private:
+    class BitWriter;
+
+    void encode_channel_(BitWriter& writer, int32_t* samples);
+
+    const size_t n_chans_;
+
+    core::Array<int32_t> samples_;
+    core::Array<uint32_t> residuals_;
+
+    void* frame_data_;
+    size_t frame_byte_size_;
+    size_t frame_n_samples_;
+    size_t frame_max_samples_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_LOSSLESS_ENCODER_H_
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/lossless_format.h
+//! @brief Lossless codec bitstream definitions.
+
+#ifndef ROC_AUDIO_LOSSLESS_FORMAT_H_
+#define ROC_AUDIO_LOSSLESS_FORMAT_H_
+
+#include "roc_audio/sample.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Lossless codec bitstream definitions.
+//!
+//! The format is a subset of FLAC, adapted for packets. Every frame is decoded
+//! independently and carries its own length, so that decoder doesn't depend on
+//! previous packets and ignores trailing bytes after the frame.
+//!
+//! Frame layout:
+//! @code
+//!  +-------------+-----------+------------+-----+--------------+---------+
+//!  | num samples | num chans | subframe 0 | ... | subframe N-1 | padding |
+//!  |  (16 bit)   | (16 bit)  |            |     |              |         |
+//!  +-------------+-----------+------------+-----+--------------+---------+
+//! @endcode
+//!
+//! Each subframe encodes one channel and starts with 3-bit type and 5-bit
+//! number of "wasted" low bits, which are zero in all samples and are not coded.
+//! Subframes are packed without alignment; the frame is padded with zero bits
+//! to a byte boundary.
+//!
+//! Subframe types:
+//!  - constant: single 24-bit sample repeated for the whole frame
+//!  - verbatim: every sample is coded as is
+//!  - fixed: FLAC fixed polynomial predictor of order 0..4; warm-up samples are
+//!    coded as is, then residuals are coded using partitioned Rice coding with
+//!    4-bit partition order and 5-bit Rice parameter per partition
+//!
+//! Samples are 24-bit signed integers, all fields are big-endian.
+//!
+//! Decoder rejects frames which are too short to hold declared number of
+//! samples, assuming at least one bit per residual and sample_bits per
+//! verbatim sample. Only constant subframes may be shorter than that.
+namespace lossless {
+
+//! Bit depth of samples.
+const unsigned BitDepth = 24;
+
+//! Frame header size, in bytes.
+const size_t FrameHeaderSize = 4;
+
+//! Subframe header size, in bits.
+const unsigned SubframeHeaderBits = 8;
+
+//! Maximum number of samples per channel in frame.
+const size_t MaxSamples = 0xffff;
+
+//! Maximum number of channels in frame.
+const size_t MaxChannels = 0xffff;
+
+//! Maximum order of fixed predictor.
+const unsigned MaxFixedOrder = 4;
+
+//! Maximum order of residual partitioning.
+const unsigned MaxPartitionOrder = 4;
+
+//! Number of bits to store partition order.
+const unsigned PartitionOrderBits = 4;
+
+//! Maximum Rice parameter.
+const unsigned MaxRiceParam = 30;
+
+//! Number of bits to store Rice parameter.
+const unsigned RiceParamBits = 5;
+
+//! Subframe types.
+enum SubframeType {
+    //! All samples are equal.
+    Subframe_Constant = 0,
+
+    //! Samples are stored without compression.
+    Subframe_Verbatim = 1,
+
+    //! Fixed predictor of order (type - Subframe_Fixed).
+    Subframe_Fixed = 2
+};
+
+//! Number of bits to store subframe type.
+const unsigned SubframeTypeBits = 3;
+
+//! Number of bits to store number of wasted bits.
+const unsigned WastedBits = 5;
+
+//! Get maximum frame size in bytes for given number of samples and channels.
+//! @remarks
+//!  Encoder falls back to verbatim subframe when compression doesn't help,
+//!  so every subframe fits into header plus BitDepth bits per sample.
+inline size_t max_frame_size(size_t num_samples, size_t num_chans) {
+    return FrameHeaderSize
+        + num_chans * (SubframeHeaderBits / 8 + num_samples * BitDepth / 8);
+}
+
+//! Get maximum number of samples per channel that fit into frame of given size.
+inline size_t max_frame_samples(size_t frame_size, size_t num_chans) {
+    if (num_chans == 0 || frame_size < FrameHeaderSize) {
+        return 0;
+    }
+
+    const size_t chan_size = (frame_size - FrameHeaderSize) / num_chans;
+    if (chan_size < SubframeHeaderBits / 8) {
+        return 0;
+    }
+
+    const size_t num_samples = (chan_size - SubframeHeaderBits / 8) / (BitDepth / 8);
+
+    return num_samples < MaxSamples ? num_samples : MaxSamples;
+}
+
+//! Get length of residual partition for given partition order.
+//! @remarks
+//!  Partition of order (p - 1) always consists of two adjacent partitions of
+//!  order p. The last partition may be shorter than others.
+inline size_t partition_length(size_t num_residuals, unsigned partition_order) {
+    size_t len = (num_residuals + (1 << MaxPartitionOrder) - 1) >> MaxPartitionOrder;
+    if (len == 0) {
+        len = 1;
+    }
+    return len << (MaxPartitionOrder - partition_order);
+}
+
+//! Convert sample to 24-bit integer.
+inline int32_t quantize_sample(sample_t s) {
+    const sample_t scaled = s * sample_t(1 << (BitDepth - 1));
+
+    if (scaled >= sample_t((1 << (BitDepth - 1)) - 1)) {
+        return (1 << (BitDepth - 1)) - 1;
+    }
+    if (scaled <= -sample_t(1 << (BitDepth - 1))) {
+        return -(1 << (BitDepth - 1));
+    }
+
+    return int32_t(scaled >= 0 ? scaled + sample_t(0.5) : scaled - sample_t(0.5));
+}
+
+//! Convert 24-bit integer to sample.
+inline sample_t dequantize_sample(int32_t s) {
+    return sample_t(s) / sample_t(1 << (BitDepth - 1));
+}
+
+} // namespace lossless
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_LOSSLESS_FORMAT_H_
@@ -7,73 +7,234 @@
  */
 
 #include "roc_audio/mixer.h"
+#include "roc_audio/integer_ops.h"
 #include "roc_audio/sample_spec_to_str.h"
+#include "roc_core/atomic.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
+#include "roc_core/semaphore.h"
 #include "roc_core/stddefs.h"
+#include "roc_core/thread.h"
 
 namespace roc {
 namespace audio {
 
+namespace {
+
+void mix_samples(sample_t* out_data, const sample_t* in_data, size_t n_samples) {
+    for (size_t n = 0; n < n_samples; n++) {
+        out_data[n] += in_data[n];
+
+        // Saturate on overflow.
+        out_data[n] = std::min(out_data[n], Sample_Max);
+        out_data[n] = std::max(out_data[n], Sample_Min);
+    }
+}
+
+void zero_planes(
+    uint8_t* data, size_t stride, size_t n_planes, size_t n_samples, size_t sample_size) {
+    for (size_t p = 0; p < n_planes; p++) {
+        memset(data + p * stride * sample_size, 0, n_samples * sample_size);
+    }
+}
+
+size_t get_sample_size(const SampleSpec& sample_spec) {
+    if (is_integer_spec(sample_spec)) {
+        return integer_sample_size(sample_spec.pcm_format());
+    }
+    return sizeof(sample_t);
+}
+
+} // namespace
+
+// Worker reads a subset of inputs into their slots, which are then mixed
+// by Mixer in the calling thread.
+class Mixer::Worker : public core::Thread {
+public:
+    explicit Worker(Mixer& mixer)
+        : mixer_(mixer)
+        , out_size_(0)
+        , first_input_(0)
+        , input_step_(0)
+        , stop_(0) {
+    }
+
+    virtual ~Worker() {
+        roc_panic_if(is_joinable());
+    }
+
+    // Start reading inputs in worker thread.
+    void begin_process(size_t out_size, size_t first_input, size_t input_step) {
+        out_size_ = out_size;
+        first_input_ = first_input;
+        input_step_ = input_step;
+        start_sem_.post();
+    }
+
+    // Wait until worker thread finishes reading.
+    void end_process() {
+        done_sem_.wait();
+    }
+
+    // Ask worker thread to exit.
+    void stop() {
+        stop_ = 1;
+        start_sem_.post();
+    }
+
+private:
+    virtual void run() {
+        for (;;) {
+            start_sem_.wait();
+
+            if (stop_) {
+                break;
+            }
+
+            mixer_.read_inputs_(out_size_, first_input_, input_step_);
+
+            done_sem_.post();
+        }
+    }
+
+    Mixer& mixer_;
+
+    size_t out_size_;
+    size_t first_input_;
+    size_t input_step_;
+
+    core::Semaphore start_sem_;
+    core::Semaphore done_sem_;
+    core::Atomic<int> stop_;
+};
+
 Mixer::Mixer(FrameFactory& frame_factory,
+             core::IArena& arena,
              const SampleSpec& sample_spec,
-             bool enable_timestamps)
-    : sample_spec_(sample_spec)
+             bool enable_timestamps,
+             size_t num_threads)
+    : frame_factory_(frame_factory)
+    , arena_(arena)
+    , max_read_(0)
+    , workers_(arena)
+    , input_slots_(arena)
+    , sample_spec_(sample_spec)
     , enable_timestamps_(enable_timestamps)
+    , integer_(is_integer_spec(sample_spec))
+    , sample_size_(get_sample_size(sample_spec))
+    , planar_(sample_spec.sample_layout() == SampleLayout_Planar)
+    , num_planes_(planar_ ? sample_spec.num_channels() : 1)
+    , passthrough_mode_(false)
     , valid_(false) {
-    roc_panic_if_msg(!sample_spec_.is_valid() || !sample_spec_.is_raw(),
-                     "mixer: required valid sample spec with raw format: %s",
+    roc_panic_if_msg(!sample_spec_.is_valid() || (!sample_spec_.is_raw() && !integer_),
+                     "mixer: required valid sample spec with raw or integer format: %s",
                      sample_spec_to_str(sample_spec_).c_str());
 
-    temp_buf_ = frame_factory.new_raw_buffer();
+    roc_panic_if_msg(planar_ && integer_,
+                     "mixer: planar layout is supported only for raw format: %s",
+                     sample_spec_to_str(sample_spec_).c_str());
+
+    if (planar_) {
+        temp_buf_ = frame_factory.new_planar_buffer();
+        max_read_ = frame_factory.planar_buffer_size(sample_spec_.num_channels());
+    } else {
+        // In integer format, raw buffers are used to store smaller samples.
+        temp_buf_ = frame_factory.new_raw_buffer();
+        max_read_ = frame_factory.raw_buffer_size() * sizeof(sample_t) / sample_size_;
+    }
+
     if (!temp_buf_) {
         roc_log(LogError, "mixer: can't allocate temporary buffer");
         return;
     }
 
+    if (max_read_ == 0) {
+        roc_log(LogError, "mixer: temporary buffer is too small: buffer_size=%lu",
+                (unsigned long)frame_factory.raw_buffer_size());
+        return;
+    }
+
     temp_buf_.reslice(0, temp_buf_.capacity());
 
+    const size_t num_workers =
+        std::min(std::max(num_threads, (size_t)1), (size_t)MaxWorkers);
+
+    // First worker is the calling thread.
+    for (size_t n = 1; n < num_workers; n++) {
+        Worker* worker = new (arena_) Worker(*this);
+        if (!worker) {
+            roc_log(LogError, "mixer: can't allocate worker");
+            return;
+        }
+
+        if (!workers_.push_back(worker)) {
+            arena_.destroy_object(*worker);
+            return;
+        }
+    }
+
+    if (!start_workers_()) {
+        return;
+    }
+
+    if (num_workers > 1) {
+        roc_log(LogDebug, "mixer: initialized: num_workers=%lu",
+                (unsigned long)num_workers);
+    }
+
     valid_ = true;
 }
 
+Mixer::~Mixer() {
+    stop_workers_();
+
+    for (size_t n = 0; n < workers_.size(); n++) {
+        arena_.destroy_object(*workers_[n]);
+    }
+}
+
 bool Mixer::is_valid() const {
     return valid_;
 }
 
+size_t Mixer::num_workers() const {
+    return workers_.size() + 1;
+}
+
 void Mixer::add_input(IFrameReader& reader) {
     roc_panic_if(!valid_);
 
     readers_.push_back(reader);
+    update_mode_();
+    update_slots_();
 }
 
 void Mixer::remove_input(IFrameReader& reader) {
     roc_panic_if(!valid_);
 
     readers_.remove(reader);
+    update_mode_();
+    update_slots_();
 }
 
 bool Mixer::read(Frame& frame) {
     roc_panic_if(!valid_);
 
-    // Optimization for single reader case.
-    if (readers_.size() == 1) {
-        if (!readers_.front()->read(frame)) {
-            frame.set_duration(frame.num_raw_samples() / sample_spec_.num_channels());
-        }
-
-        if (!enable_timestamps_) {
-            // When timestamps are disabled, don't forget to zeroize
-            // them in the optimized path.
-            frame.set_capture_timestamp(0);
-        }
-
+    if (passthrough_mode_) {
+        passthrough_(frame);
         return true;
     }
 
-    const size_t max_read = temp_buf_.size();
+    if (frame.is_planar() != planar_) {
+        roc_panic("mixer: unexpected frame layout");
+    }
 
-    sample_t* samples = frame.raw_samples();
-    size_t n_samples = frame.num_raw_samples();
+    // In planar mode, every plane is filled independently, and samples
+    // are counted per plane.
+    uint8_t* data = planar_ ? (uint8_t*)frame.plane(0) : frame_data_(frame);
+    const size_t stride = planar_ ? frame.plane_stride() : 0;
+    const size_t frame_size = frame_size_(frame);
+    size_t n_samples = frame_size / num_planes_;
 
     unsigned flags = 0;
     core::nanoseconds_t capture_ts = 0;
@@ -83,24 +244,94 @@ bool Mixer::read(Frame& frame) {
         // we retrieved from pool. Usually it's big enough, but we still
         // handle situation when requested read is larger.
         size_t n_read = n_samples;
-        if (n_read > max_read) {
-            n_read = max_read;
+        if (n_read > max_read_) {
+            n_read = max_read_;
         }
 
-        read_(samples, n_read, flags, capture_ts);
+        read_(data, stride, n_read, flags, capture_ts);
 
-        samples += n_read;
+        data += n_read * sample_size_;
         n_samples -= n_read;
     }
 
+    if (integer_) {
+        flags |= Frame::FlagNotRaw;
+    }
+
     frame.set_flags(flags);
-    frame.set_duration(frame.num_raw_samples() / sample_spec_.num_channels());
+    frame.set_duration(frame_size / sample_spec_.num_channels());
     frame.set_capture_timestamp(capture_ts);
 
     return true;
 }
 
-void Mixer::read_(sample_t* out_data,
+void Mixer::update_mode_() {
+    const bool passthrough_mode = readers_.size() == 1;
+
+    if (passthrough_mode != passthrough_mode_) {
+        roc_log(LogDebug, "mixer: switching to %s mode: n_inputs=%lu",
+                passthrough_mode ? "passthrough" : "mixing",
+                (unsigned long)readers_.size());
+        passthrough_mode_ = passthrough_mode;
+    }
+}
+
+// Allocate or release input slots, so that there is one slot per input.
+// Slots are needed only when inputs are read by workers.
+void Mixer::update_slots_() {
+    if (workers_.size() == 0) {
+        return;
+    }
+
+    if (input_slots_.size() > readers_.size()) {
+        (void)input_slots_.resize(readers_.size());
+    }
+
+    while (input_slots_.size() < readers_.size()) {
+        InputSlot slot;
+        slot.buf = planar_ ? frame_factory_.new_planar_buffer()
+                           : frame_factory_.new_raw_buffer();
+
+        if (!slot.buf || !input_slots_.push_back(slot)) {
+            // read_() falls back to sequential reading until next attempt.
+            roc_log(LogError, "mixer: can't allocate input buffer: n_inputs=%lu",
+                    (unsigned long)readers_.size());
+            return;
+        }
+
+        input_slots_.back().buf.reslice(0, input_slots_.back().buf.capacity());
+    }
+}
+
+// Single input reads directly into output frame.
+void Mixer::passthrough_(Frame& frame) {
+    frame.set_flags(0);
+
+    if (!readers_.front()->read(frame)) {
+        // Same as in mixing mode, where failed inputs are not mixed
+        // into zeroized output.
+        if (planar_) {
+            zero_planes((uint8_t*)frame.plane(0), frame.plane_stride(), num_planes_,
+                        frame.num_raw_samples() / num_planes_, sample_size_);
+        } else {
+            memset(frame.bytes(), 0, frame.num_bytes());
+        }
+
+        frame.set_flags(integer_ ? (unsigned)Frame::FlagNotRaw : 0);
+        frame.set_capture_timestamp(0);
+    }
+
+    frame.set_duration(frame_size_(frame) / sample_spec_.num_channels());
+
+    if (!enable_timestamps_) {
+        // When timestamps are disabled, don't forget to zeroize
+        // them in the passthrough path.
+        frame.set_capture_timestamp(0);
+    }
+}
+
+void Mixer::read_(uint8_t* out_data,
+                  size_t out_stride,
                   size_t out_size,
                   unsigned& out_flags,
                   core::nanoseconds_t& out_cts) {
@@ -109,52 +340,199 @@ void Mixer::read_(sample_t* out_data,
 
     const size_t n_readers = readers_.size();
 
-    core::nanoseconds_t cts_base = 0;
-    double cts_sum = 0;
-    size_t cts_count = 0;
+    // Don't wake up more workers than there are inputs.
+    const size_t n_workers = std::min(num_workers(), n_readers);
 
     // Zeroize output frame.
-    memset(out_data, 0, out_size * sizeof(sample_t));
+    zero_planes(out_data, out_stride, num_planes_, out_size, sample_size_);
+
+    Partial partial;
+
+    if (n_workers > 1 && input_slots_.size() == n_readers) {
+        read_parallel_(out_data, out_stride, out_size, n_workers, partial);
+    } else {
+        read_sequential_(out_data, out_stride, out_size, partial);
+    }
 
+    // Accumulate flags from all mixed frames.
+    out_flags |= partial.flags;
+
+    if (partial.cts_count != 0) {
+        // Compute average timestamp.
+        // Don't forget to compensate everything that we subtracted when
+        // accumulating timestamps.
+        out_cts =
+            core::nanoseconds_t(partial.cts_base * ((double)partial.cts_count / n_readers)
+                                + partial.cts_sum / (double)n_readers);
+    }
+}
+
+// Read inputs one by one into temporary buffer and mix them.
+void Mixer::read_sequential_(uint8_t* out_data,
+                             size_t out_stride,
+                             size_t out_size,
+                             Partial& partial) {
     for (IFrameReader* rp = readers_.front(); rp; rp = readers_.nextof(*rp)) {
-        sample_t* temp_data = temp_buf_.data();
+        unsigned in_flags = 0;
+        core::nanoseconds_t in_cts = 0;
 
-        Frame temp_frame(temp_data, out_size);
-        if (!rp->read(temp_frame)) {
+        uint8_t* in_data = (uint8_t*)temp_buf_.data();
+
+        if (!read_input_(*rp, in_data, out_size, in_flags, in_cts)) {
             continue;
         }
 
-        for (size_t n = 0; n < out_size; n++) {
-            out_data[n] += temp_data[n];
+        mix_input_(out_data, out_stride, in_data, out_size, in_flags, in_cts, partial);
+    }
+}
 
-            // Saturate on overflow.
-            out_data[n] = std::min(out_data[n], Sample_Max);
-            out_data[n] = std::max(out_data[n], Sample_Min);
+// Read inputs in parallel into their slots, then mix slots in the same
+// order as read_sequential_(). Since saturation is applied after adding
+// every input, mixing partial sums of workers would give different results.
+void Mixer::read_parallel_(uint8_t* out_data,
+                           size_t out_stride,
+                           size_t out_size,
+                           size_t n_workers,
+                           Partial& partial) {
+    // First worker is processed in calling thread, others in their own threads.
+    for (size_t n = 1; n < n_workers; n++) {
+        workers_[n - 1]->begin_process(out_size, n, n_workers);
+    }
+
+    read_inputs_(out_size, 0, n_workers);
+
+    for (size_t n = 1; n < n_workers; n++) {
+        workers_[n - 1]->end_process();
+    }
+
+    for (size_t n = 0; n < input_slots_.size(); n++) {
+        const InputSlot& slot = input_slots_[n];
+        if (!slot.has_frame) {
+            continue;
         }
 
-        // Accumulate flags from all mixed frames.
-        out_flags |= temp_frame.flags();
+        mix_input_(out_data, out_stride, (const uint8_t*)slot.buf.data(), out_size,
+                   slot.flags, slot.capture_ts, partial);
+    }
+}
 
-        const core::nanoseconds_t frame_cts = temp_frame.capture_timestamp();
+// Read every input_step'th input starting from first_input into its slot.
+// May be called concurrently from multiple workers for disjoint subsets
+// of inputs.
+void Mixer::read_inputs_(size_t out_size, size_t first_input, size_t input_step) {
+    size_t n_input = 0;
 
-        if (enable_timestamps_ && frame_cts != 0) {
-            // Subtract first non-zero timestamp from all other timestamps.
-            // Since timestamp calculation is used only when inputs are synchronous
-            // and their timestamps are close, this effectively makes all values
-            // small, avoiding overflow and rounding errors when adding them.
-            if (cts_base == 0) {
-                cts_base = frame_cts;
-            }
-            cts_sum += double(frame_cts - cts_base);
-            cts_count++;
+    for (IFrameReader* rp = readers_.front(); rp; rp = readers_.nextof(*rp), n_input++) {
+        if (n_input % input_step != first_input) {
+            continue;
         }
+
+        InputSlot& slot = input_slots_[n_input];
+
+        slot.has_frame = read_input_(*rp, (uint8_t*)slot.buf.data(), out_size,
+                                     slot.flags, slot.capture_ts);
     }
+}
 
-    if (cts_count != 0) {
-        // Compute average timestamp.
-        // Don't forget to compensate everything that we subtracted above.
-        out_cts = core::nanoseconds_t(cts_base * ((double)cts_count / n_readers)
-                                      + cts_sum / (double)n_readers);
+// Read out_size samples per plane from input into buffer.
+// In planar mode, planes in buffer are plane_stride(out_size) apart.
+bool Mixer::read_input_(IFrameReader& reader,
+                        uint8_t* in_data,
+                        size_t out_size,
+                        unsigned& in_flags,
+                        core::nanoseconds_t& in_cts) {
+    bool ok;
+
+    if (planar_) {
+        Frame frame((sample_t*)in_data, out_size * num_planes_, num_planes_);
+        ok = reader.read(frame);
+        in_flags = frame.flags();
+        in_cts = frame.capture_timestamp();
+    } else {
+        Frame frame(in_data, out_size * sample_size_);
+        ok = reader.read(frame);
+        in_flags = frame.flags();
+        in_cts = frame.capture_timestamp();
+    }
+
+    return ok;
+}
+
+void Mixer::mix_input_(uint8_t* out_data,
+                       size_t out_stride,
+                       const uint8_t* in_data,
+                       size_t out_size,
+                       unsigned in_flags,
+                       core::nanoseconds_t in_cts,
+                       Partial& partial) {
+    const size_t in_stride = plane_stride(out_size);
+
+    for (size_t p = 0; p < num_planes_; p++) {
+        mix_(out_data + p * out_stride * sample_size_,
+             in_data + p * in_stride * sample_size_, out_size);
+    }
+
+    partial.flags |= in_flags;
+
+    if (enable_timestamps_ && in_cts != 0) {
+        // Subtract first non-zero timestamp from all other timestamps.
+        // Since timestamp calculation is used only when inputs are synchronous
+        // and their timestamps are close, this effectively makes all values
+        // small, avoiding overflow and rounding errors when adding them.
+        if (partial.cts_count == 0) {
+            partial.cts_base = in_cts;
+        }
+        partial.cts_sum += double(in_cts - partial.cts_base);
+        partial.cts_count++;
+    }
+}
+
+void Mixer::mix_(uint8_t* out_data, const uint8_t* in_data, size_t n_samples) const {
+    if (integer_) {
+        if (sample_spec_.pcm_format() == PcmFormat_SInt16) {
+            mix_s16((int16_t*)out_data, (const int16_t*)in_data, n_samples);
+        } else {
+            mix_s32((int32_t*)out_data, (const int32_t*)in_data, n_samples);
+        }
+        return;
+    }
+
+    mix_samples((sample_t*)out_data, (const sample_t*)in_data, n_samples);
+}
+
+// Get pointer to samples of interleaved frame.
+uint8_t* Mixer::frame_data_(Frame& frame) const {
+    if (integer_) {
+        return frame.bytes();
+    }
+    return (uint8_t*)frame.raw_samples();
+}
+
+// Get number of samples in frame for all channels.
+size_t Mixer::frame_size_(const Frame& frame) const {
+    if (planar_) {
+        return frame.num_raw_samples();
+    }
+    return frame.num_bytes() / sample_size_;
+}
+
+bool Mixer::start_workers_() {
+    for (size_t n = 0; n < workers_.size(); n++) {
+        if (!workers_[n]->start()) {
+            roc_log(LogError, "mixer: can't start worker thread");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void Mixer::stop_workers_() {
+    for (size_t n = 0; n < workers_.size(); n++) {
+        if (workers_[n]->is_joinable()) {
+            workers_[n]->stop();
+            workers_[n]->join();
+        }
     }
 }
 
@@ -16,6 +16,8 @@
 #include "roc_audio/iframe_reader.h"
 #include "roc_audio/sample.h"
 #include "roc_audio/sample_spec.h"
+#include "roc_core/array.h"
+#include "roc_core/iarena.h"
 #include "roc_core/list.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/slice.h"
@@ -43,18 +45,52 @@ namespace audio {
 //! frame as the average capture timestamps of all mixed input frames.
 //! This makes sense only when all inputs are synchronized and their
 //! timestamps are close to each other.
+//!
+//! If there is exactly one input, mixer works in passthrough mode: the input
+//! reads directly into the output frame, without temporary buffer, zeroing
+//! and mixing. Mixer switches between passthrough and mixing modes
+//! automatically when inputs are added or removed. This makes the common case
+//! of a single session almost free.
+//!
+//! If more than one thread is requested, inputs are divided between worker
+//! threads. Every worker reads its inputs into per-input buffers, and then
+//! the calling thread mixes those buffers in the same order and with the same
+//! saturation as when inputs are read sequentially, so the output doesn't
+//! depend on the number of threads. First worker is processed on the calling
+//! thread. Since inputs are usually receiver sessions with their own
+//! depacketizers, decoders and resamplers, reading dominates mixing, and this
+//! allows to process sessions in parallel.
+//!
+//! If sample spec has planar layout, input and output frames are planar, and
+//! every channel is zeroized and mixed as a separate contiguous plane.
+//!
+//! Besides raw format, sample spec may have integer format (see
+//! is_integer_format()). In this case frames are mixed using saturating
+//! integer arithmetic (NEON if available), without conversion to floating
+//! point, which is cheaper on CPUs with weak FPU. Planar layout is supported
+//! only for raw format.
 class Mixer : public IFrameReader, public core::NonCopyable<> {
 public:
     //! Initialize.
-    //! @p buffer_factory is used to allocate a temporary buffer for mixing.
+    //! @p frame_factory is used to allocate a temporary buffer for mixing, and
+    //! a buffer per input if there are multiple workers.
     //! @p enable_timestamps defines whether to enable calculation of capture timestamps.
+    //! @p num_threads defines maximum number of workers; if it's 1, all inputs
+    //! are read sequentially in the calling thread.
     Mixer(FrameFactory& frame_factory,
+          core::IArena& arena,
           const SampleSpec& sample_spec,
-          bool enable_timestamps);
+          bool enable_timestamps,
+          size_t num_threads);
+
+    ~Mixer();
 
     //! Check if the mixer was succefully constructed.
     bool is_valid() const;
 
+    //! Get number of workers, including calling thread.
+    size_t num_workers() const;
+
     //! Add input reader.
     void add_input(IFrameReader&);
 
@@ -68,17 +104,109 @@ public:
     virtual bool read(Frame& frame);
 
 private:
-    void read_(sample_t* out_data,
+    class Worker;
+
+    enum { MaxWorkers = 32 };
+
+    // Frame read from input by worker.
+    struct InputSlot {
+        core::Slice<sample_t> buf;
+        bool has_frame;
+        unsigned flags;
+        core::nanoseconds_t capture_ts;
+
+        InputSlot()
+            : has_frame(false)
+            , flags(0)
+            , capture_ts(0) {
+        }
+    };
+
+    // Flags and timestamps accumulated from mixed inputs.
+    struct Partial {
+        unsigned flags;
+        core::nanoseconds_t cts_base;
+        double cts_sum;
+        size_t cts_count;
+
+        Partial()
+            : flags(0)
+            , cts_base(0)
+            , cts_sum(0)
+            , cts_count(0) {
+        }
+    };
+
+    bool start_workers_();
+    void stop_workers_();
+
+    void update_mode_();
+    void update_slots_();
+
+    void passthrough_(Frame& frame);
+
+    void read_(uint8_t* out_data,
+               size_t out_stride,
                size_t out_size,
                unsigned& out_flags,
                core::nanoseconds_t& out_cts);
 
+    void read_sequential_(uint8_t* out_data,
+                          size_t out_stride,
+                          size_t out_size,
+                          Partial& partial);
+    void read_parallel_(uint8_t* out_data,
+                        size_t out_stride,
+                        size_t out_size,
+                        size_t n_workers,
+                        Partial& partial);
+
+    void read_inputs_(size_t out_size, size_t first_input, size_t input_step);
+
+    bool read_input_(IFrameReader& reader,
+                     uint8_t* in_data,
+                     size_t out_size,
+                     unsigned& in_flags,
+                     core::nanoseconds_t& in_cts);
+
+    void mix_input_(uint8_t* out_data,
+                    size_t out_stride,
+                    const uint8_t* in_data,
+                    size_t out_size,
+                    unsigned in_flags,
+                    core::nanoseconds_t in_cts,
+                    Partial& partial);
+
+    void mix_(uint8_t* out_data, const uint8_t* in_data, size_t n_samples) const;
+
+    uint8_t* frame_data_(Frame& frame) const;
+    size_t frame_size_(const Frame& frame) const;
+
+    FrameFactory& frame_factory_;
+    core::IArena& arena_;
+
     core::List<IFrameReader, core::NoOwnership> readers_;
     core::Slice<sample_t> temp_buf_;
+    size_t max_read_;
+
+    core::Array<Worker*, MaxWorkers> workers_;
+    core::Array<InputSlot> input_slots_;
 
     const SampleSpec sample_spec_;
     const bool enable_timestamps_;
 
+    // If integer, samples are in integer format, and temporary buffers
+    // are reused to store them.
+    const bool integer_;
+    const size_t sample_size_;
+
+    // If planar, frames have one plane per channel, otherwise single plane
+    // with interleaved samples.
+    const bool planar_;
+    const size_t num_planes_;
+
+    bool passthrough_mode_;
+
     bool valid_;
 };
 
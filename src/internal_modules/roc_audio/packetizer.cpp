@@ -125,27 +125,42 @@ bool Packetizer::begin_packet_() {
     packet_cts_ = capture_ts_;
 
     // Begin encoding samples into packet.
-    payload_encoder_.begin(packet_->payload().data(), packet_->payload().size());
+    payload_encoder_.begin(packet_->rtp()->payload.data(),
+                           packet_->rtp()->payload.size());
 
     return true;
 }
 
 void Packetizer::end_packet_() {
-    // How much bytes we've written into packet payload.
-    const size_t written_payload_size = payload_encoder_.encoded_byte_count(packet_pos_);
-    roc_panic_if_not(written_payload_size <= payload_size_);
-
     // Finish encoding samples into packet.
-    payload_encoder_.end();
+    // Returns how much bytes we've written into packet payload.
+    const size_t written_payload_size = payload_encoder_.end();
+    roc_panic_if_not(written_payload_size <= payload_size_);
 
     // Fill protocol-specific fields.
     sequencer_.next(*packet_, packet_cts_, (packet::stream_timestamp_t)packet_pos_);
 
-    // Apply padding if needed.
-    if (packet_pos_ < samples_per_packet_) {
-        pad_packet_(written_payload_size);
+    // Adjust packet size if needed.
+    if (written_payload_size < payload_size_) {
+        if (!packet_->has_flags(packet::Packet::FlagFEC)) {
+            // Packet size may vary, truncate unused payload.
+            truncate_packet_(written_payload_size);
+        } else if (packet_pos_ < samples_per_packet_) {
+            // FEC requires all packets in block to have same size, so we
+            // can't truncate incomplete packet and have to pad it instead.
+            pad_packet_(written_payload_size);
+        } else {
+            // FEC requires all packets in block to have same size, so we
+            // keep unused payload bytes. This happens only with encoders
+            // that produce variable-size frames, and their frames define
+            // their own length, so trailing bytes are ignored by decoder.
+            zero_packet_tail_(written_payload_size);
+        }
     }
 
+    packet_->set_buffer(packet_buffer_);
+    packet_buffer_ = core::Slice<uint8_t>();
+
     const status::StatusCode code = writer_.write(packet_);
     // TODO(gh-183): forward status
     roc_panic_if(code != status::StatusOK);
@@ -158,17 +173,34 @@ void Packetizer::end_packet_() {
     packet_cts_ = 0;
 }
 
-void Packetizer::pad_packet_(size_t written_payload_size) {
-    if (written_payload_size == payload_size_) {
-        return;
+void Packetizer::truncate_packet_(size_t written_payload_size) {
+    core::Slice<uint8_t>& payload = packet_->rtp()->payload;
+
+    // Without FEC, payload is always the last part of packet buffer.
+    if (payload.data() + payload.size() != packet_buffer_.data() + packet_buffer_.size()) {
+        roc_panic("packetizer: can't truncate packet: payload is not at buffer end");
     }
 
+    const size_t unused_size = payload.size() - written_payload_size;
+
+    payload.reslice(0, written_payload_size);
+    packet_buffer_.reslice(0, packet_buffer_.size() - unused_size);
+}
+
+void Packetizer::pad_packet_(size_t written_payload_size) {
     if (!composer_.pad(*packet_, payload_size_ - written_payload_size)) {
         roc_panic("packetizer: can't pad packet: orig_size=%lu actual_size=%lu",
                   (unsigned long)payload_size_, (unsigned long)written_payload_size);
     }
 }
 
+void Packetizer::zero_packet_tail_(size_t written_payload_size) {
+    core::Slice<uint8_t>& payload = packet_->rtp()->payload;
+
+    memset(payload.data() + written_payload_size, 0,
+           payload.size() - written_payload_size);
+}
+
 packet::PacketPtr Packetizer::create_packet_() {
     packet::PacketPtr packet = packet_factory_.new_packet();
     if (!packet) {
@@ -190,7 +222,9 @@ packet::PacketPtr Packetizer::create_packet_() {
     }
     packet->add_flags(packet::Packet::FlagPrepared);
 
-    packet->set_buffer(buffer);
+    // Buffer is attached to packet when packet is finished, because until then
+    // we don't know actual payload size.
+    packet_buffer_ = buffer;
 
     return packet;
 }
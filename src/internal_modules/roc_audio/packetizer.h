@@ -81,14 +81,17 @@ public:
 
     //! Flush buffered packet, if any.
     //! @remarks
-    //!  Packet is padded to match fixed size.
+    //!  Packet is truncated to actual payload size, or, if it's protected by FEC,
+    //!  padded to match fixed size.
     void flush();
 
 private:
     bool begin_packet_();
     void end_packet_();
 
+    void truncate_packet_(size_t written_payload_size);
     void pad_packet_(size_t written_payload_size);
+    void zero_packet_tail_(size_t written_payload_size);
 
     packet::PacketPtr create_packet_();
 
@@ -104,6 +107,7 @@ private:
     size_t payload_size_;
 
     packet::PacketPtr packet_;
+    core::Slice<uint8_t> packet_buffer_;
     size_t packet_pos_;
     core::nanoseconds_t packet_cts_;
 
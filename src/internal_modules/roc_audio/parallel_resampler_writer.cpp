@@ -0,0 +1,409 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/parallel_resampler_writer.h"
+#include "roc_audio/resampler_map.h"
+#include "roc_audio/resampler_writer.h"
+#include "roc_audio/sample_spec_to_str.h"
+#include "roc_core/atomic.h"
+#include "roc_core/log.h"
+#include "roc_core/optional.h"
+#include "roc_core/panic.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/shared_ptr.h"
+#include "roc_core/thread.h"
+
+namespace roc {
+namespace audio {
+
+// Lane handles a contiguous group of channels.
+// It deinterleaves its channels from input frame, passes them to its own
+// resampler, and accumulates resampled samples until they're collected
+// by ParallelResamplerWriter.
+class ParallelResamplerWriter::Lane : public core::Thread, public IFrameWriter {
+public:
+    Lane(core::IArena& arena,
+         FrameFactory& frame_factory,
+         SincTableMap& sinc_table_map,
+         const ResamplerConfig& config,
+         const SampleSpec& in_sample_spec,
+         const SampleSpec& out_sample_spec,
+         size_t first_chan,
+         size_t num_chans)
+        : in_sample_spec_(make_lane_spec_(in_sample_spec, num_chans))
+        , out_sample_spec_(make_lane_spec_(out_sample_spec, num_chans))
+        , total_chans_(in_sample_spec.num_channels())
+        , first_chan_(first_chan)
+        , num_chans_(num_chans)
+        , in_frame_(NULL)
+        , input_buf_(arena)
+        , output_buf_(arena)
+        , output_cts_(0)
+        , stop_(0)
+        , valid_(false) {
+        resampler_ = ResamplerMap::instance().new_resampler(
+            arena, frame_factory, sinc_table_map, config, in_sample_spec_,
+            out_sample_spec_);
+        if (!resampler_) {
+            return;
+        }
+
+        resampler_writer_.reset(new (resampler_writer_) ResamplerWriter(
+            *this, *resampler_, frame_factory, in_sample_spec_, out_sample_spec_));
+        if (!resampler_writer_ || !resampler_writer_->is_valid()) {
+            return;
+        }
+
+        valid_ = true;
+    }
+
+    virtual ~Lane() {
+        roc_panic_if(is_joinable());
+    }
+
+    bool is_valid() const {
+        return valid_;
+    }
+
+    size_t first_chan() const {
+        return first_chan_;
+    }
+
+    size_t num_chans() const {
+        return num_chans_;
+    }
+
+    // Number of resampled samples per channel ready to be collected.
+    size_t num_ready() const {
+        return output_buf_.size() / num_chans_;
+    }
+
+    // Capture timestamp of first ready sample.
+    core::nanoseconds_t ready_cts() const {
+        return output_cts_;
+    }
+
+    // Ready samples of this lane, interleaved.
+    const sample_t* ready_samples() const {
+        return output_buf_.data();
+    }
+
+    // Remove first n_samples per channel from ready samples.
+    void consume(size_t n_samples) {
+        roc_panic_if(n_samples > num_ready());
+
+        const size_t remain = output_buf_.size() - n_samples * num_chans_;
+
+        if (remain != 0) {
+            memmove(output_buf_.data(), output_buf_.data() + n_samples * num_chans_,
+                    remain * sizeof(sample_t));
+        }
+
+        if (!output_buf_.resize(remain)) {
+            roc_panic("parallel resampler: can't shrink buffer");
+        }
+
+        if (output_cts_ != 0) {
+            output_cts_ += out_sample_spec_.samples_per_chan_2_ns(n_samples);
+        }
+    }
+
+    // Process frame in calling thread.
+    void process(Frame& in_frame) {
+        in_frame_ = &in_frame;
+        process_();
+    }
+
+    // Start processing frame in lane thread.
+    void begin_process(Frame& in_frame) {
+        in_frame_ = &in_frame;
+        start_sem_.post();
+    }
+
+    // Wait until lane thread finishes processing.
+    void end_process() {
+        done_sem_.wait();
+    }
+
+    // Ask lane thread to exit.
+    void stop() {
+        stop_ = 1;
+        start_sem_.post();
+    }
+
+    // Collect resampled samples from nested resampler writer.
+    virtual void write(Frame& frame) {
+        const size_t pos = output_buf_.size();
+        const size_t n_samples = frame.num_raw_samples();
+
+        if (pos == 0) {
+            output_cts_ = frame.capture_timestamp();
+        }
+
+        if (!output_buf_.grow_exp(pos + n_samples)
+            || !output_buf_.resize(pos + n_samples)) {
+            roc_panic("parallel resampler: can't allocate output buffer");
+        }
+
+        memcpy(output_buf_.data() + pos, frame.raw_samples(),
+               n_samples * sizeof(sample_t));
+    }
+
+private:
+    static SampleSpec make_lane_spec_(const SampleSpec& spec, size_t num_chans) {
+        ChannelSet chans;
+        chans.set_layout(ChanLayout_Multitrack);
+        chans.set_order(ChanOrder_None);
+        chans.set_count(num_chans);
+
+        return SampleSpec(spec.sample_rate(), Sample_RawFormat, chans);
+    }
+
+    virtual void run() {
+        for (;;) {
+            start_sem_.wait();
+
+            if (stop_) {
+                break;
+            }
+
+            process_();
+
+            done_sem_.post();
+        }
+    }
+
+    void process_() {
+        roc_panic_if(!in_frame_);
+
+        const size_t n_samples = in_frame_->num_raw_samples() / total_chans_;
+
+        if (!input_buf_.grow_exp(n_samples * num_chans_)
+            || !input_buf_.resize(n_samples * num_chans_)) {
+            roc_panic("parallel resampler: can't allocate input buffer");
+        }
+
+        const sample_t* in_samples = in_frame_->raw_samples() + first_chan_;
+        sample_t* lane_samples = input_buf_.data();
+
+        for (size_t ns = 0; ns < n_samples; ns++) {
+            for (size_t nc = 0; nc < num_chans_; nc++) {
+                lane_samples[nc] = in_samples[nc];
+            }
+            in_samples += total_chans_;
+            lane_samples += num_chans_;
+        }
+
+        Frame lane_frame(input_buf_.data(), input_buf_.size());
+        lane_frame.set_duration((packet::stream_timestamp_t)n_samples);
+        lane_frame.set_capture_timestamp(in_frame_->capture_timestamp());
+
+        resampler_writer_->write(lane_frame);
+
+        in_frame_ = NULL;
+    }
+
+    const SampleSpec in_sample_spec_;
+    const SampleSpec out_sample_spec_;
+
+    const size_t total_chans_;
+    const size_t first_chan_;
+    const size_t num_chans_;
+
+    Frame* in_frame_;
+
+    core::SharedPtr<IResampler> resampler_;
+    core::Optional<ResamplerWriter> resampler_writer_;
+
+    core::Array<sample_t> input_buf_;
+    core::Array<sample_t> output_buf_;
+    core::nanoseconds_t output_cts_;
+
+    core::Semaphore start_sem_;
+    core::Semaphore done_sem_;
+    core::Atomic<int> stop_;
+
+    bool valid_;
+};
+
+ParallelResamplerWriter::ParallelResamplerWriter(IFrameWriter& writer,
+                                                 core::IArena& arena,
+                                                 FrameFactory& frame_factory,
+                                                 SincTableMap& sinc_table_map,
+                                                 const ResamplerConfig& config,
+                                                 const SampleSpec& in_sample_spec,
+                                                 const SampleSpec& out_sample_spec,
+                                                 size_t num_threads)
+    : writer_(writer)
+    , arena_(arena)
+    , in_sample_spec_(in_sample_spec)
+    , out_sample_spec_(out_sample_spec)
+    , lanes_(arena)
+    , output_buf_(arena)
+    , valid_(false) {
+    if (!in_sample_spec_.is_valid() || !out_sample_spec_.is_valid()
+        || !in_sample_spec_.is_raw() || !out_sample_spec_.is_raw()) {
+        roc_panic("parallel resampler: required valid sample specs with raw format:"
+                  " in_spec=%s out_spec=%s",
+                  sample_spec_to_str(in_sample_spec_).c_str(),
+                  sample_spec_to_str(out_sample_spec_).c_str());
+    }
+
+    if (in_sample_spec_.channel_set() != out_sample_spec_.channel_set()) {
+        roc_panic("parallel resampler: required identical input and output channel sets:"
+                  " in_spec=%s out_spec=%s",
+                  sample_spec_to_str(in_sample_spec_).c_str(),
+                  sample_spec_to_str(out_sample_spec_).c_str());
+    }
+
+    const size_t num_chans = in_sample_spec_.num_channels();
+
+    size_t num_lanes = std::min(std::max(num_threads, (size_t)1), num_chans);
+    num_lanes = std::min(num_lanes, (size_t)MaxLanes);
+
+    for (size_t n = 0; n < num_lanes; n++) {
+        const size_t first_chan = n * num_chans / num_lanes;
+        const size_t last_chan = (n + 1) * num_chans / num_lanes;
+
+        Lane* lane =
+            new (arena_) Lane(arena_, frame_factory, sinc_table_map, config,
+                              in_sample_spec_, out_sample_spec_, first_chan,
+                              last_chan - first_chan);
+        if (!lane) {
+            roc_log(LogError, "parallel resampler: can't allocate lane");
+            return;
+        }
+
+        if (!lanes_.push_back(lane)) {
+            arena_.destroy_object(*lane);
+            return;
+        }
+
+        if (!lane->is_valid()) {
+            return;
+        }
+    }
+
+    if (!start_lanes_()) {
+        return;
+    }
+
+    roc_log(LogDebug, "parallel resampler: initialized: num_lanes=%lu num_chans=%lu",
+            (unsigned long)lanes_.size(), (unsigned long)num_chans);
+
+    valid_ = true;
+}
+
+ParallelResamplerWriter::~ParallelResamplerWriter() {
+    stop_lanes_();
+
+    for (size_t n = 0; n < lanes_.size(); n++) {
+        arena_.destroy_object(*lanes_[n]);
+    }
+}
+
+bool ParallelResamplerWriter::is_valid() const {
+    return valid_;
+}
+
+size_t ParallelResamplerWriter::num_lanes() const {
+    return lanes_.size();
+}
+
+void ParallelResamplerWriter::write(Frame& in_frame) {
+    roc_panic_if_not(is_valid());
+
+    if (in_frame.num_raw_samples() % in_sample_spec_.num_channels() != 0) {
+        roc_panic("parallel resampler: unexpected frame size");
+    }
+
+    // First lane is processed in calling thread, others in their own threads.
+    for (size_t n = 1; n < lanes_.size(); n++) {
+        lanes_[n]->begin_process(in_frame);
+    }
+
+    lanes_[0]->process(in_frame);
+
+    for (size_t n = 1; n < lanes_.size(); n++) {
+        lanes_[n]->end_process();
+    }
+
+    write_output_();
+}
+
+bool ParallelResamplerWriter::start_lanes_() {
+    for (size_t n = 1; n < lanes_.size(); n++) {
+        if (!lanes_[n]->start()) {
+            roc_log(LogError, "parallel resampler: can't start lane thread");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ParallelResamplerWriter::stop_lanes_() {
+    for (size_t n = 1; n < lanes_.size(); n++) {
+        if (lanes_[n]->is_joinable()) {
+            lanes_[n]->stop();
+            lanes_[n]->join();
+        }
+    }
+}
+
+// Interleave samples that are ready in all lanes and pass them further.
+// Every lane runs identical resampler on identical timeline, so normally
+// all lanes produce same number of samples; if they don't, the difference
+// is kept in lanes until next write.
+void ParallelResamplerWriter::write_output_() {
+    size_t n_samples = lanes_[0]->num_ready();
+
+    for (size_t n = 1; n < lanes_.size(); n++) {
+        n_samples = std::min(n_samples, lanes_[n]->num_ready());
+    }
+
+    if (n_samples == 0) {
+        return;
+    }
+
+    const size_t total_chans = out_sample_spec_.num_channels();
+
+    if (!output_buf_.grow_exp(n_samples * total_chans)
+        || !output_buf_.resize(n_samples * total_chans)) {
+        roc_panic("parallel resampler: can't allocate output buffer");
+    }
+
+    for (size_t n = 0; n < lanes_.size(); n++) {
+        const Lane& lane = *lanes_[n];
+        const size_t lane_chans = lane.num_chans();
+
+        const sample_t* lane_samples = lane.ready_samples();
+        sample_t* out_samples = output_buf_.data() + lane.first_chan();
+
+        for (size_t ns = 0; ns < n_samples; ns++) {
+            for (size_t nc = 0; nc < lane_chans; nc++) {
+                out_samples[nc] = lane_samples[nc];
+            }
+            lane_samples += lane_chans;
+            out_samples += total_chans;
+        }
+    }
+
+    Frame out_frame(output_buf_.data(), output_buf_.size());
+    out_frame.set_duration((packet::stream_timestamp_t)n_samples);
+    out_frame.set_capture_timestamp(lanes_[0]->ready_cts());
+
+    for (size_t n = 0; n < lanes_.size(); n++) {
+        lanes_[n]->consume(n_samples);
+    }
+
+    writer_.write(out_frame);
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/parallel_resampler_writer.h
+//! @brief Parallel resampler.
+
+#ifndef ROC_AUDIO_PARALLEL_RESAMPLER_WRITER_H_
+#define ROC_AUDIO_PARALLEL_RESAMPLER_WRITER_H_
+
+#include "roc_audio/frame.h"
+#include "roc_audio/frame_factory.h"
+#include "roc_audio/iframe_writer.h"
+#include "roc_audio/resampler_config.h"
+#include "roc_audio/sample.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_audio/sinc_table_map.h"
+#include "roc_core/array.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Resampler element for writing pipeline, splitting work between threads.
+//! @remarks
+//!  Channels are divided into groups (lanes), and every lane has its own
+//!  resampler and runs on its own thread. Since every lane sees continuous
+//!  stream of its channels, resampler state is never reset or split in time,
+//!  and output is the same as with a single resampler.
+//!
+//!  Lanes are synchronized on every written frame, so this writer is useful
+//!  only with large frames, e.g. when transcoding files in batch mode.
+//!  First lane is processed on the calling thread.
+class ParallelResamplerWriter : public IFrameWriter, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  @p num_threads defines maximum number of lanes. Actual number of lanes
+    //!  is limited by number of channels.
+    ParallelResamplerWriter(IFrameWriter& writer,
+                            core::IArena& arena,
+                            FrameFactory& frame_factory,
+                            SincTableMap& sinc_table_map,
+                            const ResamplerConfig& config,
+                            const SampleSpec& in_sample_spec,
+                            const SampleSpec& out_sample_spec,
+                            size_t num_threads);
+
+    ~ParallelResamplerWriter();
+
+    //! Check if object is successfully constructed.
+    bool is_valid() const;
+
+    //! Get number of lanes.
+    size_t num_lanes() const;
+
+    //! Write audio frame.
+    virtual void write(Frame&);
+
+private:
+    class Lane;
+
+    enum { MaxLanes = 32 };
+
+    bool start_lanes_();
+    void stop_lanes_();
+
+    void write_output_();
+
+    IFrameWriter& writer_;
+    core::IArena& arena_;
+
+    const SampleSpec in_sample_spec_;
+    const SampleSpec out_sample_spec_;
+
+    core::Array<Lane*, MaxLanes> lanes_;
+    core::Array<sample_t> output_buf_;
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_PARALLEL_RESAMPLER_WRITER_H_
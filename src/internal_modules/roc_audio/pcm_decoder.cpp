@@ -59,6 +59,16 @@ void PcmDecoder::begin(packet::stream_timestamp_t frame_position,
 }
 
 size_t PcmDecoder::read(sample_t* samples, size_t n_samples) {
+    return read_(pcm_mapper_, samples, n_samples);
+}
+
+size_t PcmDecoder::read_pcm(void* samples, size_t n_samples, PcmFormat format) {
+    PcmMapper mapper(pcm_mapper_.input_format(), format);
+
+    return read_(mapper, samples, n_samples);
+}
+
+size_t PcmDecoder::read_(PcmMapper& mapper, void* samples, size_t n_samples) {
     if (!frame_data_) {
         roc_panic("pcm decoder: read should be called only between begin/end");
     }
@@ -70,9 +80,9 @@ size_t PcmDecoder::read(sample_t* samples, size_t n_samples) {
     size_t samples_bit_off = 0;
 
     const size_t n_mapped_samples =
-        pcm_mapper_.map(frame_data_, frame_byte_size_, frame_bit_off_, samples,
-                        n_samples * n_chans_ * sizeof(sample_t), samples_bit_off,
-                        n_samples * n_chans_)
+        mapper.map(frame_data_, frame_byte_size_, frame_bit_off_, samples,
+                   mapper.output_byte_count(n_samples * n_chans_), samples_bit_off,
+                   n_samples * n_chans_)
         / n_chans_;
 
     roc_panic_if_not(samples_bit_off % 8 == 0);
@@ -46,6 +46,11 @@ public:
     //! Read samples from current frame.
     virtual size_t read(sample_t* samples, size_t n_samples);
 
+    //! Read samples from current frame in given PCM format.
+    //! @remarks
+    //!  Samples are mapped from packet format to @p format directly.
+    virtual size_t read_pcm(void* samples, size_t n_samples, PcmFormat format);
+
     //! Shift samples from current frame.
     virtual size_t shift(size_t n_samples);
 
@@ -53,6 +58,8 @@ public:
     virtual void end();
 
 private:
+    size_t read_(PcmMapper& mapper, void* samples, size_t n_samples);
+
     PcmMapper pcm_mapper_;
     const size_t n_chans_;
 
@@ -21,7 +21,8 @@ PcmEncoder::PcmEncoder(const SampleSpec& sample_spec)
     , n_chans_(sample_spec.num_channels())
     , frame_data_(NULL)
     , frame_byte_size_(0)
-    , frame_bit_off_(0) {
+    , frame_bit_off_(0)
+    , frame_n_samples_(0) {
 }
 
 size_t PcmEncoder::encoded_byte_count(size_t num_samples) const {
@@ -55,17 +56,24 @@ size_t PcmEncoder::write(const sample_t* samples, size_t n_samples) {
     roc_panic_if_not(samples_bit_off % 8 == 0);
     roc_panic_if_not(n_mapped_samples <= n_samples);
 
+    frame_n_samples_ += n_mapped_samples;
+
     return n_mapped_samples;
 }
 
-void PcmEncoder::end() {
+size_t PcmEncoder::end() {
     if (!frame_data_) {
         roc_panic("pcm encoder: unpaired begin/end");
     }
 
+    const size_t written_byte_count = encoded_byte_count(frame_n_samples_);
+
     frame_data_ = NULL;
     frame_byte_size_ = 0;
     frame_bit_off_ = 0;
+    frame_n_samples_ = 0;
+
+    return written_byte_count;
 }
 
 } // namespace audio
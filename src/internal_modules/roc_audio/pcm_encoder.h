@@ -39,7 +39,7 @@ public:
     virtual size_t write(const sample_t* samples, size_t n_samples);
 
     //! Finish encoding frame.
-    virtual void end();
+    virtual size_t end();
 
 private:
     PcmMapper pcm_mapper_;
@@ -48,6 +48,7 @@ private:
     void* frame_data_;
     size_t frame_byte_size_;
     size_t frame_bit_off_;
+    size_t frame_n_samples_;
 };
 
 } // namespace audio
@@ -8,6 +8,7 @@
 
 #include "roc_audio/pcm_mapper_reader.h"
 #include "roc_audio/sample_format.h"
+#include "roc_audio/sample_layout.h"
 #include "roc_audio/sample_spec_to_str.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
@@ -21,9 +22,12 @@ PcmMapperReader::PcmMapperReader(IFrameReader& reader,
                                  const SampleSpec& out_spec)
     : mapper_(in_spec.pcm_format(), out_spec.pcm_format())
     , in_reader_(reader)
+    , max_planar_size_(0)
     , in_spec_(in_spec)
     , out_spec_(out_spec)
     , num_ch_(out_spec.num_channels())
+    , in_planar_(in_spec.sample_layout() == SampleLayout_Planar)
+    , out_planar_(out_spec.sample_layout() == SampleLayout_Planar)
     , valid_(false) {
     if (!in_spec_.is_valid() || !out_spec_.is_valid()
         || in_spec_.sample_format() != SampleFormat_Pcm
@@ -49,12 +53,51 @@ PcmMapperReader::PcmMapperReader(IFrameReader& reader,
                   sample_spec_to_str(out_spec_).c_str());
     }
 
-    in_buf_ = frame_factory.new_byte_buffer();
-    if (!in_buf_) {
-        roc_log(LogError, "pcm mapper reader: can't allocate temporary buffer");
-        return;
+    if ((in_planar_ && (!in_spec_.is_raw() || out_planar_))
+        || (out_planar_ && !out_spec_.is_raw())) {
+        roc_panic("pcm mapper reader: planar layout is supported only for raw format"
+                  " and only on one side:"
+                  " in_spec=%s out_spec=%s",
+                  sample_spec_to_str(in_spec_).c_str(),
+                  sample_spec_to_str(out_spec_).c_str());
+    }
+
+    if (in_planar_) {
+        // Planar input is read into aligned buffer.
+        planar_buf_ = frame_factory.new_planar_buffer();
+        if (!planar_buf_) {
+            roc_log(LogError, "pcm mapper reader: can't allocate temporary buffer");
+            return;
+        }
+        planar_buf_.reslice(0, planar_buf_.capacity());
+
+        max_planar_size_ = frame_factory.planar_buffer_size(num_ch_);
+        if (max_planar_size_ == 0) {
+            roc_log(LogError,
+                    "pcm mapper reader: temporary buffer is too small:"
+                    " buffer_size=%lu in_spec=%s",
+                    (unsigned long)frame_factory.raw_buffer_size(),
+                    sample_spec_to_str(in_spec_).c_str());
+            return;
+        }
+    } else {
+        in_buf_ = frame_factory.new_byte_buffer();
+        if (!in_buf_) {
+            roc_log(LogError, "pcm mapper reader: can't allocate temporary buffer");
+            return;
+        }
+        in_buf_.reslice(0, in_buf_.capacity());
+    }
+
+    if ((in_planar_ && !out_spec_.is_raw()) || (out_planar_ && !in_spec_.is_raw())) {
+        // Interleaved raw samples between mapping and layout conversion.
+        raw_buf_ = frame_factory.new_raw_buffer();
+        if (!raw_buf_) {
+            roc_log(LogError, "pcm mapper reader: can't allocate temporary buffer");
+            return;
+        }
+        raw_buf_.reslice(0, raw_buf_.capacity());
     }
-    in_buf_.reslice(0, in_buf_.capacity());
 
     valid_ = true;
 }
@@ -66,6 +109,22 @@ bool PcmMapperReader::is_valid() const {
 bool PcmMapperReader::read(Frame& out_frame) {
     roc_panic_if(!valid_);
 
+    if (out_frame.is_planar() != out_planar_) {
+        roc_panic("pcm mapper reader: unexpected frame layout");
+    }
+
+    if (out_planar_) {
+        return read_to_planar_(out_frame);
+    }
+
+    if (in_planar_) {
+        return read_from_planar_(out_frame);
+    }
+
+    return read_interleaved_(out_frame);
+}
+
+bool PcmMapperReader::read_interleaved_(Frame& out_frame) {
     const size_t max_sample_count = mapper_.input_sample_count(in_buf_.size()) / num_ch_;
 
     const size_t out_sample_count =
@@ -112,5 +171,121 @@ bool PcmMapperReader::read(Frame& out_frame) {
     return true;
 }
 
+// Read interleaved samples in any format and write them to planes of raw
+// output frame.
+bool PcmMapperReader::read_to_planar_(Frame& out_frame) {
+    size_t max_sample_count = mapper_.input_sample_count(in_buf_.size()) / num_ch_;
+    if (!in_spec_.is_raw()) {
+        max_sample_count = std::min(max_sample_count, raw_buf_.size() / num_ch_);
+    }
+
+    const size_t out_sample_count = out_frame.num_raw_samples() / num_ch_;
+    size_t out_sample_offset = 0;
+
+    unsigned out_flags = 0;
+
+    while (out_sample_offset < out_sample_count) {
+        const size_t n_samples =
+            std::min(out_sample_count - out_sample_offset, max_sample_count);
+
+        const size_t in_byte_count = mapper_.input_byte_count(n_samples * num_ch_);
+
+        Frame in_frame(in_buf_.data(), in_byte_count);
+        if (!in_reader_.read(in_frame)) {
+            return false;
+        }
+
+        const sample_t* in_samples = (const sample_t*)in_buf_.data();
+
+        if (!in_spec_.is_raw()) {
+            size_t in_bit_offset = 0;
+            size_t raw_bit_offset = 0;
+
+            mapper_.map(in_buf_.data(), in_byte_count, in_bit_offset,
+                        (uint8_t*)raw_buf_.data(), raw_buf_.size() * sizeof(sample_t),
+                        raw_bit_offset, n_samples * num_ch_);
+
+            in_samples = raw_buf_.data();
+        }
+
+        deinterleave_samples(in_samples, out_frame.plane(0) + out_sample_offset,
+                             out_frame.plane_stride(), num_ch_, n_samples);
+
+        out_flags |= in_frame.flags();
+        if (out_sample_offset == 0) {
+            out_frame.set_capture_timestamp(in_frame.capture_timestamp());
+        }
+
+        out_sample_offset += n_samples;
+    }
+
+    out_frame.set_flags(out_flags & ~(unsigned)Frame::FlagNotRaw);
+    out_frame.set_duration(out_sample_count);
+
+    return true;
+}
+
+// Read planes of raw input frame and write them as interleaved samples
+// in any format.
+bool PcmMapperReader::read_from_planar_(Frame& out_frame) {
+    size_t max_sample_count = max_planar_size_;
+    if (!out_spec_.is_raw()) {
+        max_sample_count = std::min(max_sample_count, raw_buf_.size() / num_ch_);
+    }
+
+    const size_t out_sample_count =
+        mapper_.output_sample_count(out_frame.num_bytes()) / num_ch_;
+    size_t out_sample_offset = 0;
+
+    size_t out_bit_offset = 0;
+
+    unsigned out_flags = 0;
+
+    while (out_sample_offset < out_sample_count) {
+        const size_t n_samples =
+            std::min(out_sample_count - out_sample_offset, max_sample_count);
+
+        Frame in_frame(planar_buf_.data(), n_samples * num_ch_, num_ch_);
+        if (!in_reader_.read(in_frame)) {
+            return false;
+        }
+
+        if (out_spec_.is_raw()) {
+            interleave_samples(in_frame.plane(0), in_frame.plane_stride(),
+                               (sample_t*)out_frame.bytes()
+                                   + out_sample_offset * num_ch_,
+                               num_ch_, n_samples);
+        } else {
+            interleave_samples(in_frame.plane(0), in_frame.plane_stride(),
+                               raw_buf_.data(), num_ch_, n_samples);
+
+            size_t raw_bit_offset = 0;
+
+            mapper_.map((const uint8_t*)raw_buf_.data(),
+                        n_samples * num_ch_ * sizeof(sample_t), raw_bit_offset,
+                        out_frame.bytes(), out_frame.num_bytes(), out_bit_offset,
+                        n_samples * num_ch_);
+        }
+
+        out_flags |= in_frame.flags();
+        if (out_sample_offset == 0) {
+            out_frame.set_capture_timestamp(in_frame.capture_timestamp());
+        }
+
+        out_sample_offset += n_samples;
+    }
+
+    if (out_spec_.is_raw()) {
+        out_flags &= ~(unsigned)Frame::FlagNotRaw;
+    } else {
+        out_flags |= (unsigned)Frame::FlagNotRaw;
+    }
+
+    out_frame.set_flags(out_flags);
+    out_frame.set_duration(out_sample_count);
+
+    return true;
+}
+
 } // namespace audio
 } // namespace roc
@@ -26,6 +26,10 @@ namespace audio {
 
 //! Pcm mapper reader.
 //! Reads frames from nested reader and maps them to another pcm mask.
+//!
+//! Also converts between interleaved and planar layouts. Planar layout is
+//! supported only for raw samples, so if one of the specs is planar, it
+//! should have raw format, and the other spec should be interleaved.
 class PcmMapperReader : public IFrameReader, public core::NonCopyable<> {
 public:
     //! Initialize.
@@ -41,16 +45,28 @@ public:
     virtual bool read(Frame& frame);
 
 private:
+    bool read_interleaved_(Frame& out_frame);
+    bool read_to_planar_(Frame& out_frame);
+    bool read_from_planar_(Frame& out_frame);
+
     PcmMapper mapper_;
 
     IFrameReader& in_reader_;
     core::Slice<uint8_t> in_buf_;
 
+    // used when converting between layouts
+    core::Slice<sample_t> planar_buf_;
+    core::Slice<sample_t> raw_buf_;
+    size_t max_planar_size_;
+
     const SampleSpec in_spec_;
     const SampleSpec out_spec_;
 
     const size_t num_ch_;
 
+    const bool in_planar_;
+    const bool out_planar_;
+
     bool valid_;
 };
 
@@ -49,6 +49,14 @@ PcmMapperWriter::PcmMapperWriter(IFrameWriter& writer,
                   sample_spec_to_str(out_spec_).c_str());
     }
 
+    if (in_spec_.sample_layout() != SampleLayout_Interleaved
+        || out_spec_.sample_layout() != SampleLayout_Interleaved) {
+        roc_panic("pcm mapper writer: required interleaved layout:"
+                  " in_spec=%s out_spec=%s",
+                  sample_spec_to_str(in_spec_).c_str(),
+                  sample_spec_to_str(out_spec_).c_str());
+    }
+
     out_buf_ = frame_factory.new_byte_buffer();
     if (!out_buf_) {
         roc_log(LogError, "pcm mapper writer: can't allocate temporary buffer");
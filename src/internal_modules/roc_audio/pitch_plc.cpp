@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/pitch_plc.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// Range of pitch periods to search.
+const core::nanoseconds_t MinPeriod = 2500 * core::Microsecond;
+const core::nanoseconds_t MaxPeriod = 15 * core::Millisecond;
+
+// Length of window used to compute correlation.
+const core::nanoseconds_t CorrLen = 20 * core::Millisecond;
+
+// Length of cross-fade from synthetic to real signal after loss.
+// Also an upper bound for overlap-add from real to synthetic signal at the
+// beginning of loss, which is additionally limited to a quarter of period.
+const core::nanoseconds_t FadeLen = 4 * core::Millisecond;
+
+// Synthetic signal is attenuated linearly from start to end, and then
+// replaced with silence. Repeating the same period for a long time produces
+// unnatural buzzing sound.
+const core::nanoseconds_t AttenuationStart = 10 * core::Millisecond;
+const core::nanoseconds_t AttenuationEnd = 60 * core::Millisecond;
+
+} // namespace
+
+PitchPlc::PitchPlc(const SampleSpec& sample_spec, core::IArena& arena)
+    : n_chans_(sample_spec.num_channels())
+    , min_period_(std::max((size_t)1, sample_spec.ns_2_samples_per_chan(MinPeriod)))
+    , max_period_(std::max(min_period_, sample_spec.ns_2_samples_per_chan(MaxPeriod)))
+    , corr_len_(std::max((size_t)1, sample_spec.ns_2_samples_per_chan(CorrLen)))
+    , fade_len_(sample_spec.ns_2_samples_per_chan(FadeLen))
+    , attenuation_start_(sample_spec.ns_2_samples_per_chan(AttenuationStart))
+    , attenuation_end_(sample_spec.ns_2_samples_per_chan(AttenuationEnd))
+    , history_(arena)
+    , history_len_(corr_len_ + max_period_)
+    , history_size_(0)
+    , mono_(arena)
+    , period_buf_(arena)
+    , period_(0)
+    , period_pos_(0)
+    , onset_len_(0)
+    , state_(State_Normal)
+    , loss_pos_(0)
+    , fade_pos_(0)
+    , valid_(false) {
+    roc_log(LogDebug,
+            "pitch plc: initializing: n_chans=%lu min_period=%lu max_period=%lu"
+            " corr_len=%lu",
+            (unsigned long)n_chans_, (unsigned long)min_period_,
+            (unsigned long)max_period_, (unsigned long)corr_len_);
+
+    if (!history_.resize(history_len_ * n_chans_) || !mono_.resize(history_len_)
+        || !period_buf_.resize(max_period_ * n_chans_)) {
+        roc_log(LogError, "pitch plc: can't allocate buffers");
+        return;
+    }
+
+    valid_ = true;
+}
+
+bool PitchPlc::is_valid() const {
+    return valid_;
+}
+
+void PitchPlc::process_history(sample_t* samples, size_t n_samples) {
+    roc_panic_if(!valid_);
+
+    if (state_ == State_Loss) {
+        state_ = State_Fade;
+        fade_pos_ = 0;
+    }
+
+    if (state_ == State_Fade) {
+        size_t i = 0;
+
+        for (; i < n_samples && fade_pos_ < fade_len_; i++, fade_pos_++) {
+            const sample_t weight = sample_t(fade_pos_ + 1) / sample_t(fade_len_ + 1);
+
+            for (size_t c = 0; c < n_chans_; c++) {
+                sample_t& s = samples[i * n_chans_ + c];
+                s = s * weight + next_synth_sample_(c) * (1 - weight);
+            }
+
+            advance_synth_();
+        }
+
+        if (fade_pos_ == fade_len_) {
+            state_ = State_Normal;
+        }
+    }
+
+    append_history_(samples, n_samples);
+}
+
+void PitchPlc::process_loss(sample_t* samples, size_t n_samples) {
+    roc_panic_if(!valid_);
+
+    if (state_ != State_Loss) {
+        begin_loss_();
+    }
+
+    size_t i = 0;
+
+    for (; i < n_samples && period_ != 0 && loss_pos_ < attenuation_end_; i++) {
+        for (size_t c = 0; c < n_chans_; c++) {
+            samples[i * n_chans_ + c] = next_synth_sample_(c);
+        }
+
+        advance_synth_();
+    }
+
+    if (i < n_samples) {
+        memset(samples + i * n_chans_, 0, (n_samples - i) * n_chans_ * sizeof(sample_t));
+        loss_pos_ += n_samples - i;
+    }
+}
+
+void PitchPlc::append_history_(const sample_t* samples, size_t n_samples) {
+    sample_t* history = history_.data();
+
+    if (n_samples >= history_len_) {
+        memcpy(history, samples + (n_samples - history_len_) * n_chans_,
+               history_len_ * n_chans_ * sizeof(sample_t));
+        history_size_ = history_len_;
+        return;
+    }
+
+    // Most recent samples are at the end of buffer.
+    memmove(history, history + n_samples * n_chans_,
+            (history_len_ - n_samples) * n_chans_ * sizeof(sample_t));
+    memcpy(history + (history_len_ - n_samples) * n_chans_, samples,
+           n_samples * n_chans_ * sizeof(sample_t));
+
+    history_size_ = std::min(history_len_, history_size_ + n_samples);
+}
+
+void PitchPlc::begin_loss_() {
+    state_ = State_Loss;
+    loss_pos_ = 0;
+
+    period_ = find_period_();
+    period_pos_ = 0;
+    onset_len_ = 0;
+
+    if (period_ == 0) {
+        roc_log(LogTrace, "pitch plc: not enough history, filling loss with zeros");
+        return;
+    }
+
+    // Synthetic signal continues from the beginning of the last period.
+    memcpy(period_buf_.data(), history_.data() + (history_len_ - period_) * n_chans_,
+           period_ * n_chans_ * sizeof(sample_t));
+
+    // First period sample usually doesn't match the last decoded sample, so the
+    // beginning of synthetic signal is overlap-added with the real one.
+    // History is always longer than period, see find_period_().
+    onset_len_ = std::min(period_ / 4, fade_len_);
+
+    roc_log(LogTrace, "pitch plc: starting loss concealment: period=%lu onset=%lu",
+            (unsigned long)period_, (unsigned long)onset_len_);
+}
+
+// Find lag that maximizes normalized cross-correlation between last corr_len_
+// samples of history and history shifted by lag.
+size_t PitchPlc::find_period_() {
+    if (history_size_ < corr_len_ + min_period_) {
+        return 0;
+    }
+
+    const sample_t* history = history_.data();
+    sample_t* mono = mono_.data();
+
+    for (size_t i = history_len_ - history_size_; i < history_len_; i++) {
+        sample_t s = 0;
+        for (size_t c = 0; c < n_chans_; c++) {
+            s += history[i * n_chans_ + c];
+        }
+        mono[i] = s;
+    }
+
+    const sample_t* signal_end = mono + history_len_;
+    const size_t max_lag = std::min(max_period_, history_size_ - corr_len_);
+
+    // Coarse search with decimation by 2.
+    size_t best_lag = min_period_;
+    double best_score = -1;
+
+    for (size_t lag = min_period_; lag <= max_lag; lag += 2) {
+        const double score = correlate_(signal_end, lag, 2);
+        if (score > best_score) {
+            best_score = score;
+            best_lag = lag;
+        }
+    }
+
+    // Refine around best lag.
+    const size_t from_lag = std::max(min_period_, best_lag - 1);
+    const size_t to_lag = std::min(max_lag, best_lag + 1);
+
+    best_score = -1;
+
+    for (size_t lag = from_lag; lag <= to_lag; lag++) {
+        const double score = correlate_(signal_end, lag, 1);
+        if (score > best_score) {
+            best_score = score;
+            best_lag = lag;
+        }
+    }
+
+    return best_lag;
+}
+
+double PitchPlc::correlate_(const sample_t* signal_end, size_t lag, size_t step) const {
+    const sample_t* window = signal_end - corr_len_;
+    const sample_t* lagged = window - lag;
+
+    double corr = 0, energy = 0;
+
+    for (size_t i = 0; i < corr_len_; i += step) {
+        corr += (double)window[i] * lagged[i];
+        energy += (double)lagged[i] * lagged[i];
+    }
+
+    if (energy <= 0) {
+        return 0;
+    }
+
+    return corr / std::sqrt(energy);
+}
+
+sample_t PitchPlc::gain_() const {
+    if (loss_pos_ < attenuation_start_) {
+        return 1;
+    }
+    if (loss_pos_ >= attenuation_end_) {
+        return 0;
+    }
+    return 1
+        - sample_t(loss_pos_ - attenuation_start_)
+        / sample_t(attenuation_end_ - attenuation_start_);
+}
+
+// Overlap-add synthetic sample with continuation of decoded signal.
+// Continuation is the odd-symmetric extension of history around its last
+// sample, which preserves both its value and slope at the boundary.
+sample_t PitchPlc::onset_sample_(size_t chan, sample_t synth) const {
+    const sample_t last = history_[(history_len_ - 1) * n_chans_ + chan];
+    const sample_t mirrored = history_[(history_len_ - loss_pos_ - 2) * n_chans_ + chan];
+
+    const sample_t cont = 2 * last - mirrored;
+    const sample_t weight = sample_t(loss_pos_ + 1) / sample_t(onset_len_ + 1);
+
+    return cont * (1 - weight) + synth * weight;
+}
+
+sample_t PitchPlc::next_synth_sample_(size_t chan) const {
+    if (period_ == 0) {
+        return 0;
+    }
+
+    const sample_t synth = period_buf_[period_pos_ * n_chans_ + chan] * gain_();
+
+    if (loss_pos_ < onset_len_) {
+        return onset_sample_(chan, synth);
+    }
+
+    return synth;
+}
+
+void PitchPlc::advance_synth_() {
+    if (period_ != 0) {
+        period_pos_ = (period_pos_ + 1) % period_;
+    }
+    loss_pos_++;
+}
+
+} // namespace audio
+} // namespace roc
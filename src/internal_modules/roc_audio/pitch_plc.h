@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/pitch_plc.h
+//! @brief Pitch-based PLC.
+
+#ifndef ROC_AUDIO_PITCH_PLC_H_
+#define ROC_AUDIO_PITCH_PLC_H_
+
+#include "roc_audio/iplc.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/array.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+
+namespace roc {
+namespace audio {
+
+//! Pitch-based PLC.
+//! @remarks
+//!  Based on the algorithm from ITU-T G.711 Appendix I.
+//!
+//!  Keeps history of recently decoded samples. When loss begins, estimates
+//!  pitch period of the history using normalized cross-correlation, and
+//!  fills the gap by repeating the last pitch period. Repetition starts
+//!  fading out after a while, and turns into silence for long losses.
+//!
+//!  Both edges of the gap are smoothed to avoid a click. At the onset, first
+//!  synthetic samples are overlap-added with the extrapolation of the last
+//!  decoded samples. When packets arrive again, first decoded samples are
+//!  cross-faded with the continued synthetic signal.
+//!
+//!  All channels share the same pitch period, estimated on the sum of
+//!  channels.
+class PitchPlc : public IPlc, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    PitchPlc(const SampleSpec& sample_spec, core::IArena& arena);
+
+    //! Check if the object was successfully constructed.
+    bool is_valid() const;
+
+    //! Process samples decoded from packets.
+    virtual void process_history(sample_t* samples, size_t n_samples);
+
+    //! Fill lost samples.
+    virtual void process_loss(sample_t* samples, size_t n_samples);
+
+private:
+    enum State { State_Normal, State_Loss, State_Fade };
+
+    void append_history_(const sample_t* samples, size_t n_samples);
+
+    void begin_loss_();
+    size_t find_period_();
+    double correlate_(const sample_t* signal_end, size_t lag, size_t step) const;
+
+    sample_t gain_() const;
+    sample_t onset_sample_(size_t chan, sample_t synth) const;
+    sample_t next_synth_sample_(size_t chan) const;
+    void advance_synth_();
+
+    const size_t n_chans_;
+
+    const size_t min_period_;
+    const size_t max_period_;
+    const size_t corr_len_;
+    const size_t fade_len_;
+    const size_t attenuation_start_;
+    const size_t attenuation_end_;
+
+    // Last decoded samples, interleaved.
+    core::Array<sample_t> history_;
+    size_t history_len_;
+    size_t history_size_;
+
+    // Sum of channels of history, used for pitch estimation.
+    core::Array<sample_t> mono_;
+
+    // Last pitch period of history at the moment when loss started.
+    core::Array<sample_t> period_buf_;
+    size_t period_;
+    size_t period_pos_;
+
+    // Length of overlap-add at the beginning of loss.
+    size_t onset_len_;
+
+    State state_;
+    size_t loss_pos_;
+    size_t fade_pos_;
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_PITCH_PLC_H_
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/plc_config.h
+//! @brief PLC config.
+
+#ifndef ROC_AUDIO_PLC_CONFIG_H_
+#define ROC_AUDIO_PLC_CONFIG_H_
+
+namespace roc {
+namespace audio {
+
+//! PLC backends.
+enum PlcBackend {
+    //! Default backend.
+    //! Resolved to one of other backends.
+    PlcBackend_Default,
+
+    //! No PLC.
+    //! Lost samples are filled with zeros.
+    PlcBackend_None,
+
+    //! Pitch-based PLC.
+    //! Lost samples are synthesized by repeating last pitch period of
+    //! decoded signal, with gradual attenuation during long losses and
+    //! cross-fade into the next decoded packet.
+    PlcBackend_Pitch
+};
+
+//! PLC config.
+struct PlcConfig {
+    //! PLC backend.
+    PlcBackend backend;
+
+    PlcConfig()
+        : backend(PlcBackend_Default) {
+    }
+
+    //! Automatically fill missing settings.
+    void deduce_defaults();
+};
+
+//! Get string name of PLC backend.
+const char* plc_backend_to_str(PlcBackend backend);
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_PLC_CONFIG_H_
@@ -36,6 +36,13 @@ bool ProfilingReader::read(Frame& frame) {
     return ret;
 }
 
+float ProfilingReader::get_moving_avg() {
+    const float avg = profiler_.get_moving_avg();
+
+    // Profiler returns NaN until first frame is added.
+    return avg > 0 ? avg : 0;
+}
+
 core::nanoseconds_t ProfilingReader::read_(Frame& frame, bool& ret) {
     const core::nanoseconds_t start = core::timestamp(core::ClockMonotonic);
 
@@ -37,6 +37,11 @@ public:
     //! Read audio frame.
     virtual bool read(Frame& frame);
 
+    //! Get average processing speed, in samples per second.
+    //! @remarks
+    //!  Returns zero if no frames were read yet.
+    float get_moving_avg();
+
 private:
     core::nanoseconds_t read_(Frame& frame, bool& ret);
 
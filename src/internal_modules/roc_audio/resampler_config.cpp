@@ -15,9 +15,10 @@ namespace audio {
 void ResamplerConfig::deduce_defaults(LatencyTunerBackend latency_backend,
                                       LatencyTunerProfile latency_tuner) {
     if (backend == ResamplerBackend_Default) {
-        // If responsive profile is set, use builtin backend instead of speex,
-        // since it has higher scaling precision.
-        const bool need_builtin_backend = latency_tuner == LatencyTunerProfile_Responsive;
+        // If responsive or adaptive profile is set, use builtin backend instead
+        // of speex, since it has higher scaling precision.
+        const bool need_builtin_backend = latency_tuner == LatencyTunerProfile_Responsive
+            || latency_tuner == LatencyTunerProfile_Adaptive;
 
         // If speex backend is not available, fallback to builtin backend.
         const bool force_builtin_backend =
@@ -42,6 +43,9 @@ const char* resampler_backend_to_str(ResamplerBackend backend) {
     case ResamplerBackend_SpeexDec:
         return "speexdec";
 
+    case ResamplerBackend_Slip:
+        return "slip";
+
     case ResamplerBackend_Default:
         return "default";
     }
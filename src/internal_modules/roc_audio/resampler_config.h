@@ -36,7 +36,13 @@ enum ResamplerBackend {
     //! Combined SpeexDSP + decimating resampler.
     //! Tolerable precision, tolerable quality, fast.
     //! May be disabled at build time.
-    ResamplerBackend_SpeexDec
+    ResamplerBackend_SpeexDec,
+
+    //! Combined SpeexDSP or built-in + sample slipping resampler.
+    //! Tolerable precision, good quality, fastest.
+    //! Clock drift is compensated by inserting or dropping single samples
+    //! with short cross-fades; supports only small scaling deviations.
+    ResamplerBackend_Slip
 };
 
 //! Resampler parameters presets.
@@ -9,6 +9,8 @@
 #include "roc_audio/resampler_map.h"
 #include "roc_audio/builtin_resampler.h"
 #include "roc_audio/decimation_resampler.h"
+#include "roc_audio/integer_ops.h"
+#include "roc_audio/slip_resampler.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_core/scoped_ptr.h"
@@ -22,28 +24,66 @@ namespace audio {
 
 namespace {
 
+template <class T>
+IResampler* new_inner_resampler(core::IArena& arena,
+                                FrameFactory& frame_factory,
+                                SincTableMap&,
+                                ResamplerProfile profile,
+                                const SampleSpec& in_spec,
+                                const SampleSpec& out_spec) {
+    return new (arena) T(arena, frame_factory, profile, in_spec, out_spec);
+}
+
+template <>
+IResampler* new_inner_resampler<BuiltinResampler>(core::IArena& arena,
+                                                  FrameFactory& frame_factory,
+                                                  SincTableMap& sinc_table_map,
+                                                  ResamplerProfile profile,
+                                                  const SampleSpec& in_spec,
+                                                  const SampleSpec& out_spec) {
+    return new (arena) BuiltinResampler(arena, frame_factory, sinc_table_map, profile,
+                                        in_spec, out_spec);
+}
+
 template <class T>
 core::SharedPtr<IResampler> resampler_ctor(core::IArena& arena,
                                            FrameFactory& frame_factory,
+                                           SincTableMap& sinc_table_map,
                                            ResamplerProfile profile,
                                            const SampleSpec& in_spec,
                                            const SampleSpec& out_spec) {
-    return new (arena) T(arena, frame_factory, profile, in_spec, out_spec);
+    return new_inner_resampler<T>(arena, frame_factory, sinc_table_map, profile, in_spec,
+                                  out_spec);
 }
 
 template <class T>
 core::SharedPtr<IResampler> resampler_dec_ctor(core::IArena& arena,
                                                FrameFactory& frame_factory,
+                                               SincTableMap& sinc_table_map,
                                                ResamplerProfile profile,
                                                const SampleSpec& in_spec,
                                                const SampleSpec& out_spec) {
-    core::SharedPtr<IResampler> inner_resampler =
-        new (arena) T(arena, frame_factory, profile, in_spec, out_spec);
+    core::SharedPtr<IResampler> inner_resampler = new_inner_resampler<T>(
+        arena, frame_factory, sinc_table_map, profile, in_spec, out_spec);
 
     return new (arena)
         DecimationResampler(inner_resampler, arena, frame_factory, in_spec, out_spec);
 }
 
+template <class T>
+core::SharedPtr<IResampler> resampler_slip_ctor(core::IArena& arena,
+                                                FrameFactory& frame_factory,
+                                                SincTableMap& sinc_table_map,
+                                                ResamplerProfile profile,
+                                                const SampleSpec& in_spec,
+                                                const SampleSpec& out_spec) {
+    core::SharedPtr<IResampler> inner_resampler = new_inner_resampler<T>(
+        arena, frame_factory, sinc_table_map, profile, in_spec, out_spec);
+
+    return new (arena)
+        SlipResampler(inner_resampler, arena, frame_factory, in_spec, out_spec);
+}
+
 } // namespace
 
 ResamplerMap::ResamplerMap()
@@ -65,9 +105,21 @@ ResamplerMap::ResamplerMap()
     {
         Backend back;
         back.id = ResamplerBackend_Builtin;
+        back.planar = true;
+        back.integer = true;
         back.ctor = &resampler_ctor<BuiltinResampler>;
         add_backend_(back);
     }
+    {
+        Backend back;
+        back.id = ResamplerBackend_Slip;
+#ifdef ROC_TARGET_SPEEXDSP
+        back.ctor = &resampler_slip_ctor<SpeexResampler>;
+#else
+        back.ctor = &resampler_slip_ctor<BuiltinResampler>;
+#endif // ROC_TARGET_SPEEXDSP
+        add_backend_(back);
+    }
 }
 
 size_t ResamplerMap::num_backends() const {
@@ -83,8 +135,19 @@ bool ResamplerMap::is_supported(ResamplerBackend backend_id) const {
     return find_backend_(backend_id) != NULL;
 }
 
+bool ResamplerMap::supports_planar(ResamplerBackend backend_id) const {
+    const Backend* backend = find_backend_(backend_id);
+    return backend && backend->planar;
+}
+
+bool ResamplerMap::supports_integer(ResamplerBackend backend_id) const {
+    const Backend* backend = find_backend_(backend_id);
+    return backend && backend->integer;
+}
+
 core::SharedPtr<IResampler> ResamplerMap::new_resampler(core::IArena& arena,
                                                         FrameFactory& frame_factory,
+                                                        SincTableMap& sinc_table_map,
                                                         const ResamplerConfig& config,
                                                         const SampleSpec& in_spec,
                                                         const SampleSpec& out_spec) {
@@ -95,8 +158,27 @@ core::SharedPtr<IResampler> ResamplerMap::new_resampler(core::IArena& arena,
         return NULL;
     }
 
+    if ((in_spec.sample_layout() == SampleLayout_Planar
+         || out_spec.sample_layout() == SampleLayout_Planar)
+        && !backend->planar) {
+        roc_log(LogError,
+                "resampler map: resampler backend doesn't support planar layout:"
+                " [%d] %s",
+                config.backend, resampler_backend_to_str(config.backend));
+        return NULL;
+    }
+
+    if ((is_integer_spec(in_spec) || is_integer_spec(out_spec)) && !backend->integer) {
+        roc_log(LogError,
+                "resampler map: resampler backend doesn't support integer formats:"
+                " [%d] %s",
+                config.backend, resampler_backend_to_str(config.backend));
+        return NULL;
+    }
+
     core::SharedPtr<IResampler> resampler =
-        backend->ctor(arena, frame_factory, config.profile, in_spec, out_spec);
+        backend->ctor(arena, frame_factory, sinc_table_map, config.profile, in_spec,
+                      out_spec);
 
     if (!resampler || !resampler->is_valid()) {
         return NULL;
@@ -16,6 +16,7 @@
 #include "roc_audio/iresampler.h"
 #include "roc_audio/resampler_config.h"
 #include "roc_audio/sample_spec.h"
+#include "roc_audio/sinc_table_map.h"
 #include "roc_core/iarena.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/shared_ptr.h"
@@ -43,9 +44,19 @@ public:
     //! Check if given backend is supported.
     bool is_supported(ResamplerBackend backend_id) const;
 
+    //! Check if given backend can process samples in planar layout.
+    bool supports_planar(ResamplerBackend backend_id) const;
+
+    //! Check if given backend can process samples in integer format.
+    //! @see is_integer_format().
+    bool supports_integer(ResamplerBackend backend_id) const;
+
     //! Instantiate IResampler for given backend ID.
+    //! @remarks
+    //!  @p sinc_table_map is used by backends which need sinc tables.
     core::SharedPtr<IResampler> new_resampler(core::IArena& arena,
                                               FrameFactory& frame_factory,
+                                              SincTableMap& sinc_table_map,
                                               const ResamplerConfig& config,
                                               const SampleSpec& in_spec,
                                               const SampleSpec& out_spec);
@@ -53,17 +64,22 @@ public:
 private:
     friend class core::Singleton<ResamplerMap>;
 
-    enum { MaxBackends = 4 };
+    enum { MaxBackends = 5 };
 
     struct Backend {
         Backend()
             : id()
+            , planar(false)
+            , integer(false)
             , ctor(NULL) {
         }
 
         ResamplerBackend id;
+        bool planar;
+        bool integer;
         core::SharedPtr<IResampler> (*ctor)(core::IArena& arena,
                                             FrameFactory& frame_factory,
+                                            SincTableMap& sinc_table_map,
                                             ResamplerProfile profile,
                                             const SampleSpec& in_spec,
                                             const SampleSpec& out_spec);
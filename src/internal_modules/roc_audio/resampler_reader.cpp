@@ -7,12 +7,24 @@
  */
 
 #include "roc_audio/resampler_reader.h"
+#include "roc_audio/integer_ops.h"
 #include "roc_audio/sample_spec_to_str.h"
 #include "roc_core/panic.h"
 
 namespace roc {
 namespace audio {
 
+namespace {
+
+size_t get_sample_size(const SampleSpec& sample_spec) {
+    if (is_integer_spec(sample_spec)) {
+        return integer_sample_size(sample_spec.pcm_format());
+    }
+    return sizeof(sample_t);
+}
+
+} // namespace
+
 ResamplerReader::ResamplerReader(IFrameReader& reader,
                                  IResampler& resampler,
                                  const SampleSpec& in_sample_spec,
@@ -21,12 +33,18 @@ ResamplerReader::ResamplerReader(IFrameReader& reader,
     , reader_(reader)
     , in_sample_spec_(in_sample_spec)
     , out_sample_spec_(out_sample_spec)
+    , planar_(in_sample_spec.sample_layout() == SampleLayout_Planar)
+    , integer_(is_integer_spec(in_sample_spec))
+    , sample_size_(get_sample_size(in_sample_spec))
     , last_in_cts_(0)
     , scaling_(1.0f)
     , valid_(false) {
     if (!in_sample_spec_.is_valid() || !out_sample_spec_.is_valid()
-        || !in_sample_spec_.is_raw() || !out_sample_spec_.is_raw()) {
-        roc_panic("resampler reader: required valid sample specs with raw format:"
+        || (!in_sample_spec_.is_raw() && !integer_)
+        || in_sample_spec_.sample_format() != out_sample_spec_.sample_format()
+        || in_sample_spec_.pcm_format() != out_sample_spec_.pcm_format()) {
+        roc_panic("resampler reader: required valid sample specs with identical raw"
+                  " or integer format:"
                   " in_spec=%s out_spec=%s",
                   sample_spec_to_str(in_sample_spec_).c_str(),
                   sample_spec_to_str(out_sample_spec_).c_str());
@@ -39,6 +57,20 @@ ResamplerReader::ResamplerReader(IFrameReader& reader,
                   sample_spec_to_str(out_sample_spec_).c_str());
     }
 
+    if (in_sample_spec_.sample_layout() != out_sample_spec_.sample_layout()) {
+        roc_panic("resampler reader: required identical input and output layouts:"
+                  " in_spec=%s out_spec=%s",
+                  sample_spec_to_str(in_sample_spec_).c_str(),
+                  sample_spec_to_str(out_sample_spec_).c_str());
+    }
+
+    if (planar_ && integer_) {
+        roc_panic("resampler reader: planar layout is supported only for raw format:"
+                  " in_spec=%s out_spec=%s",
+                  sample_spec_to_str(in_sample_spec_).c_str(),
+                  sample_spec_to_str(out_sample_spec_).c_str());
+    }
+
     if (!resampler_.is_valid()) {
         return;
     }
@@ -67,10 +99,22 @@ bool ResamplerReader::set_scaling(float multiplier) {
 bool ResamplerReader::read(Frame& out_frame) {
     roc_panic_if_not(is_valid());
 
+    if (out_frame.is_planar() != planar_) {
+        roc_panic("resampler reader: unexpected frame layout");
+    }
+
+    if (integer_) {
+        return read_integer_(out_frame);
+    }
+
     if (out_frame.num_raw_samples() % out_sample_spec_.num_channels() != 0) {
         roc_panic("resampler reader: unexpected frame size");
     }
 
+    if (planar_) {
+        return read_planar_(out_frame);
+    }
+
     size_t out_pos = 0;
 
     while (out_pos < out_frame.num_raw_samples()) {
@@ -89,16 +133,90 @@ bool ResamplerReader::read(Frame& out_frame) {
     }
 
     out_frame.set_duration(out_frame.num_raw_samples() / out_sample_spec_.num_channels());
-    out_frame.set_capture_timestamp(capture_ts_(out_frame));
+    out_frame.set_capture_timestamp(capture_ts_(out_frame.num_raw_samples()));
+
+    return true;
+}
+
+// Same as read(), but pops samples directly into planes of output frame.
+bool ResamplerReader::read_planar_(Frame& out_frame) {
+    const size_t out_size = out_frame.num_raw_samples() / out_sample_spec_.num_channels();
+
+    size_t out_pos = 0;
+
+    while (out_pos < out_size) {
+        const size_t out_remain = out_size - out_pos;
+
+        const size_t num_popped = resampler_.pop_planar_output(
+            out_frame.plane(0) + out_pos, out_frame.plane_stride(), out_remain);
+
+        if (num_popped < out_remain) {
+            if (!push_input_()) {
+                return false;
+            }
+        }
+
+        out_pos += num_popped;
+    }
+
+    out_frame.set_duration(out_size);
+    out_frame.set_capture_timestamp(capture_ts_(out_frame.num_raw_samples()));
+
+    return true;
+}
+
+// Same as read(), but pops samples in integer format into frame bytes.
+bool ResamplerReader::read_integer_(Frame& out_frame) {
+    if (out_frame.num_bytes() % (sample_size_ * out_sample_spec_.num_channels()) != 0) {
+        roc_panic("resampler reader: unexpected frame size");
+    }
+
+    const size_t out_size = out_frame.num_bytes() / sample_size_;
+
+    size_t out_pos = 0;
+
+    while (out_pos < out_size) {
+        const size_t out_remain = out_size - out_pos;
+
+        const size_t num_popped = resampler_.pop_integer_output(
+            out_frame.bytes() + out_pos * sample_size_, out_remain);
+
+        if (num_popped < out_remain) {
+            if (!push_input_()) {
+                return false;
+            }
+        }
+
+        out_pos += num_popped;
+    }
+
+    out_frame.set_flags(out_frame.flags() | Frame::FlagNotRaw);
+    out_frame.set_duration(out_size / out_sample_spec_.num_channels());
+    out_frame.set_capture_timestamp(capture_ts_(out_size));
 
     return true;
 }
 
 bool ResamplerReader::push_input_() {
+    if (integer_) {
+        const core::Slice<uint8_t>& in_buff = resampler_.begin_push_integer_input();
+
+        Frame in_frame(in_buff.data(), in_buff.size());
+        return push_frame_(in_frame);
+    }
+
     const core::Slice<sample_t>& in_buff = resampler_.begin_push_input();
 
+    if (planar_) {
+        Frame in_frame(in_buff.data(), in_buff.size(), in_sample_spec_.num_channels());
+        return push_frame_(in_frame);
+    }
+
     Frame in_frame(in_buff.data(), in_buff.size());
+    return push_frame_(in_frame);
+}
 
+bool ResamplerReader::push_frame_(Frame& in_frame) {
     if (!reader_.read(in_frame)) {
         return false;
     }
@@ -109,8 +227,10 @@ bool ResamplerReader::push_input_() {
 
     if (in_cts > 0) {
         // Remember timestamp of last sample of last input frame.
-        last_in_cts_ =
-            in_cts + in_sample_spec_.samples_overall_2_ns(in_frame.num_raw_samples());
+        const size_t in_size =
+            integer_ ? in_frame.num_bytes() / sample_size_ : in_frame.num_raw_samples();
+
+        last_in_cts_ = in_cts + in_sample_spec_.samples_overall_2_ns(in_size);
     }
 
     return true;
@@ -119,7 +239,7 @@ bool ResamplerReader::push_input_() {
 // Compute timestamp of first sample of current output frame.
 // We have timestamps in input frames, and we should find to
 // which time our output frame does correspond in input stream.
-core::nanoseconds_t ResamplerReader::capture_ts_(Frame& out_frame) {
+core::nanoseconds_t ResamplerReader::capture_ts_(size_t out_size) {
     if (last_in_cts_ == 0) {
         // We didn't receive input frame with non-zero cts yet,
         // so for now we keep cts zero.
@@ -137,7 +257,7 @@ core::nanoseconds_t ResamplerReader::capture_ts_(Frame& out_frame) {
     // Subtract length of current output frame multiplied by scaling.
     // Now we have point in input stream corresponding to head of output frame.
     out_cts -= core::nanoseconds_t(
-        out_sample_spec_.samples_overall_2_ns(out_frame.num_raw_samples()) * scaling_);
+        out_sample_spec_.samples_overall_2_ns(out_size) * scaling_);
 
     if (out_cts < 0) {
         // Input frame cts was very close to zero (unix epoch), in this case we
@@ -27,6 +27,9 @@ namespace roc {
 namespace audio {
 
 //! Resampler element for reading pipeline.
+//! @remarks
+//!  If sample specs have planar layout or integer format, resampler backend
+//!  should support it.
 class ResamplerReader : public IFrameReader, public core::NonCopyable<> {
 public:
     //! Initialize.
@@ -45,8 +48,11 @@ public:
     virtual bool read(Frame&);
 
 private:
+    bool read_planar_(Frame& out_frame);
+    bool read_integer_(Frame& out_frame);
     bool push_input_();
-    core::nanoseconds_t capture_ts_(Frame& out_frame);
+    bool push_frame_(Frame& in_frame);
+    core::nanoseconds_t capture_ts_(size_t out_size);
 
     IResampler& resampler_;
     IFrameReader& reader_;
@@ -54,6 +60,12 @@ private:
     const SampleSpec in_sample_spec_;
     const SampleSpec out_sample_spec_;
 
+    const bool planar_;
+
+    // If integer, frames have samples in integer format.
+    const bool integer_;
+    const size_t sample_size_;
+
     // timestamp of the last sample +1 of the last frame pushed into resampler
     core::nanoseconds_t last_in_cts_;
 
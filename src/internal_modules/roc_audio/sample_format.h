@@ -28,6 +28,18 @@ enum SampleFormat {
     //! What specific PCM coding and endian is used is defined
     //! by PcmFormat enum.
     SampleFormat_Pcm,
+
+    //! Lossless compressed format.
+    //! Samples are quantized to 24-bit integers and compressed using
+    //! linear prediction and Rice coding (see LosslessEncoder).
+    //! PcmFormat is not used.
+    SampleFormat_Lossless,
+
+    //! IMA ADPCM format.
+    //! Samples are quantized to 16-bit integers and coded using 4 bits
+    //! per sample (see AdpcmEncoder).
+    //! PcmFormat is not used.
+    SampleFormat_Adpcm,
 };
 
 //! Get string name of sample format.
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/sample_layout.h"
+#include "roc_core/align_ops.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// Number of samples in one aligned block.
+const size_t AlignmentSamples = PlaneAlignment / sizeof(sample_t);
+
+} // namespace
+
+const char* sample_layout_to_str(SampleLayout layout) {
+    switch (layout) {
+    case SampleLayout_Interleaved:
+        return "interleaved";
+
+    case SampleLayout_Planar:
+        return "planar";
+    }
+
+    return "invalid";
+}
+
+size_t plane_stride(size_t n_samples_per_chan) {
+    return core::AlignOps::align_as(n_samples_per_chan, AlignmentSamples);
+}
+
+size_t planar_buffer_samples(size_t buffer_size, size_t n_chans) {
+    roc_panic_if_msg(n_chans == 0, "sample layout: number of channels is zero");
+
+    const size_t n_samples = buffer_size / n_chans;
+
+    return n_samples - n_samples % AlignmentSamples;
+}
+
+void deinterleave_samples(const sample_t* in_samples,
+                          sample_t* out_planes,
+                          size_t out_stride,
+                          size_t n_chans,
+                          size_t n_samples) {
+    roc_panic_if(!in_samples);
+    roc_panic_if(!out_planes);
+    roc_panic_if(n_chans > 1 && out_stride < n_samples);
+
+    for (size_t ch = 0; ch < n_chans; ch++) {
+        const sample_t* in = in_samples + ch;
+        sample_t* out = out_planes + ch * out_stride;
+
+        for (size_t ns = 0; ns < n_samples; ns++) {
+            out[ns] = in[ns * n_chans];
+        }
+    }
+}
+
+void interleave_samples(const sample_t* in_planes,
+                        size_t in_stride,
+                        sample_t* out_samples,
+                        size_t n_chans,
+                        size_t n_samples) {
+    roc_panic_if(!in_planes);
+    roc_panic_if(!out_samples);
+    roc_panic_if(n_chans > 1 && in_stride < n_samples);
+
+    for (size_t ch = 0; ch < n_chans; ch++) {
+        const sample_t* in = in_planes + ch * in_stride;
+        sample_t* out = out_samples + ch;
+
+        for (size_t ns = 0; ns < n_samples; ns++) {
+            out[ns * n_chans] = in[ns];
+        }
+    }
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/sample_layout.h
+//! @brief Sample layout.
+
+#ifndef ROC_AUDIO_SAMPLE_LAYOUT_H_
+#define ROC_AUDIO_SAMPLE_LAYOUT_H_
+
+#include "roc_audio/sample.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Sample layout.
+//! Defines how samples of different channels are placed in memory.
+enum SampleLayout {
+    //! Interleaved layout.
+    //! Samples of all channels for the same time moment are stored together,
+    //! e.g. "L R L R L R ...".
+    SampleLayout_Interleaved,
+
+    //! Planar layout.
+    //! Samples of every channel are stored in a separate plane, and planes
+    //! follow each other, e.g. "L L L ... R R R ...".
+    //! Every plane starts at PlaneAlignment boundary, so planes don't share
+    //! cache lines and per-channel loops can be vectorized.
+    //! Used only for raw samples inside pipeline.
+    SampleLayout_Planar
+};
+
+//! Alignment of every plane in planar layout, in bytes.
+//! Equal to cache line size on most CPUs.
+const size_t PlaneAlignment = 64;
+
+//! Get string name of sample layout.
+const char* sample_layout_to_str(SampleLayout layout);
+
+//! Get distance between beginnings of adjacent planes, in samples.
+//! @remarks
+//!  Number of samples per channel rounded up, so that if the first plane is
+//!  aligned, every plane is aligned.
+size_t plane_stride(size_t n_samples_per_chan);
+
+//! Get maximum number of samples per channel in planar buffer.
+//! @remarks
+//!  @p buffer_size is number of samples in buffer that begins at PlaneAlignment
+//!  boundary. Returns zero if buffer can't hold even one aligned plane for
+//!  every channel.
+size_t planar_buffer_samples(size_t buffer_size, size_t n_chans);
+
+//! Convert samples from interleaved to planar layout.
+//! @remarks
+//!  Reads @p n_samples per channel from @p in_samples and writes them to
+//!  @p n_chans planes starting at @p out_planes and @p out_stride samples apart.
+void deinterleave_samples(const sample_t* in_samples,
+                          sample_t* out_planes,
+                          size_t out_stride,
+                          size_t n_chans,
+                          size_t n_samples);
+
+//! Convert samples from planar to interleaved layout.
+//! @remarks
+//!  Reads @p n_samples per channel from @p n_chans planes starting at
+//!  @p in_planes and @p in_stride samples apart, and writes them to @p out_samples.
+void interleave_samples(const sample_t* in_planes,
+                        size_t in_stride,
+                        sample_t* out_samples,
+                        size_t n_chans,
+                        size_t n_samples);
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_SAMPLE_LAYOUT_H_
@@ -86,7 +86,8 @@ SampleSpec::SampleSpec()
     : sample_rate_(0)
     , sample_fmt_(SampleFormat_Invalid)
     , pcm_fmt_(PcmFormat_Invalid)
-    , pcm_width_(0) {
+    , pcm_width_(0)
+    , sample_layout_(SampleLayout_Interleaved) {
 }
 
 SampleSpec::SampleSpec(const size_t sample_rate,
@@ -96,6 +97,7 @@ SampleSpec::SampleSpec(const size_t sample_rate,
     , sample_fmt_(SampleFormat_Pcm)
     , pcm_fmt_(pcm_fmt)
     , pcm_width_(get_pcm_sample_width(pcm_fmt))
+    , sample_layout_(SampleLayout_Interleaved)
     , channel_set_(channel_set) {
     roc_panic_if_msg(sample_rate_ == 0, "sample spec: invalid sample rate");
     roc_panic_if_msg(pcm_fmt_ == PcmFormat_Invalid || pcm_width_ == 0,
@@ -112,6 +114,7 @@ SampleSpec::SampleSpec(const size_t sample_rate,
     , sample_fmt_(SampleFormat_Pcm)
     , pcm_fmt_(pcm_fmt)
     , pcm_width_(get_pcm_sample_width(pcm_fmt))
+    , sample_layout_(SampleLayout_Interleaved)
     , channel_set_(channel_layout, channel_order, channel_mask) {
     roc_panic_if_msg(sample_rate_ == 0, "sample spec: invalid sample rate");
     roc_panic_if_msg(pcm_fmt_ == PcmFormat_Invalid || pcm_width_ == 0,
@@ -123,7 +126,8 @@ bool SampleSpec::operator==(const SampleSpec& other) const {
     return sample_fmt_ == other.sample_fmt_
         && (sample_fmt_ != SampleFormat_Pcm || pcm_fmt_ == other.pcm_fmt_
             || get_pcm_canon_format(pcm_fmt_) == get_pcm_canon_format(other.pcm_fmt_))
-        && sample_rate_ == other.sample_rate_ && channel_set_ == other.channel_set_;
+        && sample_rate_ == other.sample_rate_ && sample_layout_ == other.sample_layout_
+        && channel_set_ == other.channel_set_;
 }
 
 bool SampleSpec::operator!=(const SampleSpec& other) const {
@@ -149,6 +153,7 @@ void SampleSpec::clear() {
     sample_fmt_ = SampleFormat_Invalid;
     pcm_fmt_ = PcmFormat_Invalid;
     pcm_width_ = 0;
+    sample_layout_ = SampleLayout_Interleaved;
     sample_rate_ = 0;
     channel_set_.clear();
 }
@@ -192,6 +197,14 @@ void SampleSpec::set_pcm_format(PcmFormat pcm_fmt) {
     pcm_width_ = get_pcm_sample_width(pcm_fmt);
 }
 
+SampleLayout SampleSpec::sample_layout() const {
+    return sample_layout_;
+}
+
+void SampleSpec::set_sample_layout(SampleLayout sample_layout) {
+    sample_layout_ = sample_layout;
+}
+
 size_t SampleSpec::sample_rate() const {
     return sample_rate_;
 }
@@ -16,6 +16,7 @@
 #include "roc_audio/pcm_format.h"
 #include "roc_audio/sample.h"
 #include "roc_audio/sample_format.h"
+#include "roc_audio/sample_layout.h"
 #include "roc_core/attributes.h"
 #include "roc_core/stddefs.h"
 #include "roc_core/string_builder.h"
@@ -115,6 +116,17 @@ public:
     //! Set PCM format.
     void set_pcm_format(PcmFormat pcm_fmt);
 
+    //! Get sample layout.
+    //! @remarks
+    //!  Defines how samples of different channels are placed in frames.
+    //!  Default is SampleLayout_Interleaved. Planar layout is used only for
+    //!  raw samples inside pipeline; byte size conversions below assume
+    //!  interleaved layout.
+    SampleLayout sample_layout() const;
+
+    //! Set sample layout.
+    void set_sample_layout(SampleLayout sample_layout);
+
     //! Get channel set.
     //! @remarks
     //!  Defines sample channels (layout and numbers).
@@ -244,6 +256,7 @@ private:
     SampleFormat sample_fmt_;
     PcmFormat pcm_fmt_;
     size_t pcm_width_;
+    SampleLayout sample_layout_;
     ChannelSet channel_set_;
 };
 
@@ -22,6 +22,10 @@ void format_sample_spec(const SampleSpec& sample_spec, core::StringBuilder& bld)
         bld.append_str(str ? str : "invalid");
     }
     bld.append_str(">");
+    if (sample_spec.sample_layout() != SampleLayout_Interleaved) {
+        bld.append_str(" layout=");
+        bld.append_str(sample_layout_to_str(sample_spec.sample_layout()));
+    }
     bld.append_str(" chset=");
     format_channel_set(sample_spec.channel_set(), bld);
     bld.append_str(">");
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/sinc_table.h
+//! @brief Windowed sinc table.
+
+#ifndef ROC_AUDIO_SINC_TABLE_H_
+#define ROC_AUDIO_SINC_TABLE_H_
+
+#include "roc_audio/sample.h"
+#include "roc_core/allocation_policy.h"
+#include "roc_core/array.h"
+#include "roc_core/iarena.h"
+#include "roc_core/ref_counted.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Windowed sinc table.
+//!
+//! Holds right half of Hamming-windowed sinc function, sampled with
+//! @p window_interp points per zero crossing, for @p window_size zero
+//! crossings, plus two trailing zeros for interpolation.
+//!
+//! Table is immutable after construction, so it may be shared by any
+//! number of resamplers in any threads.
+class SincTable : public core::RefCounted<SincTable, core::ArenaAllocation> {
+public:
+    //! Initialize.
+    SincTable(size_t window_size, size_t window_interp, core::IArena& arena);
+
+    //! Check if table was successfully built.
+    bool is_valid() const;
+
+    //! Number of zero crossings in table.
+    size_t window_size() const;
+
+    //! Number of points per zero crossing.
+    size_t window_interp() const;
+
+    //! Get table values.
+    const sample_t* data() const;
+
+    //! Get number of table values.
+    size_t size() const;
+
+private:
+    const size_t window_size_;
+    const size_t window_interp_;
+
+    core::Array<sample_t> table_;
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_SINC_TABLE_H_
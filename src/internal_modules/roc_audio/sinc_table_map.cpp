@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/sinc_table_map.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+SincTableMap::SincTableMap(core::IArena& arena)
+    : arena_(arena)
+    , n_tables_(0) {
+}
+
+core::SharedPtr<SincTable> SincTableMap::get_table(size_t window_size,
+                                                   size_t window_interp) {
+    core::Mutex::Lock lock(mutex_);
+
+    for (size_t n = 0; n < n_tables_; n++) {
+        if (tables_[n]->window_size() == window_size
+            && tables_[n]->window_interp() == window_interp) {
+            return tables_[n];
+        }
+    }
+
+    if (n_tables_ == MaxTables) {
+        roc_log(LogError, "sinc table map: too many tables: max=%lu",
+                (unsigned long)MaxTables);
+        return NULL;
+    }
+
+    core::SharedPtr<SincTable> table =
+        new (arena_) SincTable(window_size, window_interp, arena_);
+
+    if (!table || !table->is_valid()) {
+        roc_log(LogError, "sinc table map: can't build table");
+        return NULL;
+    }
+
+    tables_[n_tables_++] = table;
+
+    return table;
+}
+
+size_t SincTableMap::num_tables() const {
+    core::Mutex::Lock lock(mutex_);
+
+    return n_tables_;
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/sinc_table_map.h
+//! @brief Shared sinc tables.
+
+#ifndef ROC_AUDIO_SINC_TABLE_MAP_H_
+#define ROC_AUDIO_SINC_TABLE_MAP_H_
+
+#include "roc_audio/sinc_table.h"
+#include "roc_core/iarena.h"
+#include "roc_core/mutex.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/shared_ptr.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Shared sinc tables.
+//!
+//! Sinc table depends only on resampler profile, but may take hundreds of
+//! kilobytes and is rather expensive to compute. Instead of building own
+//! table, every resampler obtains it here, and all resamplers with the same
+//! parameters share one instance.
+//!
+//! Normally there is one map per context, shared by all its pipelines.
+//! Tables are allocated from the given arena, built on first request, and
+//! kept until the map is destroyed. Resamplers hold references to tables,
+//! so a table outlives the map if it's still in use. Number of distinct
+//! tables is bounded by number of profiles.
+//!
+//! Thread-safe.
+class SincTableMap : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    explicit SincTableMap(core::IArena& arena);
+
+    //! Get table with given parameters.
+    //! @remarks
+    //!  Builds table if it doesn't exist yet.
+    //!  Returns NULL if table can't be built.
+    core::SharedPtr<SincTable> get_table(size_t window_size, size_t window_interp);
+
+    //! Get number of built tables.
+    size_t num_tables() const;
+
+private:
+    enum { MaxTables = 8 };
+
+    core::Mutex mutex_;
+
+    core::IArena& arena_;
+
+    core::SharedPtr<SincTable> tables_[MaxTables];
+    size_t n_tables_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_SINC_TABLE_MAP_H_
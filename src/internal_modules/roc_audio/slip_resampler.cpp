@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/slip_resampler.h"
+#include "roc_audio/sample_spec_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+const core::nanoseconds_t LogReportInterval = 20 * core::Second;
+
+const size_t InputFrameSize = 16;
+
+// Number of samples per channel over which one slip is spread.
+const size_t FadeLength = 16;
+
+// How long to wait for a good slip point before doing slip anyway.
+const size_t MaxSlipWait = 16;
+
+// Slip point should have activity below this fraction of average activity.
+const float LowActivityRatio = 0.25f;
+
+// Smoothing coefficient for average activity.
+const float ActivityAvgCoeff = 0.05f;
+
+// Should be below 1 / (FadeLength + 1), so that slips done back-to-back
+// can keep up with the multiplier.
+const float MaxScalingDeviation = 0.055f;
+
+// Allowed rounding error when checking multiplier against its bound, because
+// callers clamp multiplier to 1.0 +/- MaxScalingDeviation, and the result may
+// be slightly out of bound, e.g. 1.0f - (1.0f - 0.055f) > 0.055f.
+const float ScalingEpsilon = 1e-6f;
+
+} // namespace
+
+SlipResampler::SlipResampler(const core::SharedPtr<IResampler>& inner_resampler,
+                             core::IArena& arena,
+                             FrameFactory& frame_factory,
+                             const SampleSpec& in_spec,
+                             const SampleSpec& out_spec)
+    : IResampler(arena)
+    , inner_resampler_(inner_resampler)
+    , use_inner_resampler_(in_spec.sample_rate() != out_spec.sample_rate())
+    , input_spec_(in_spec)
+    , output_spec_(out_spec)
+    , multiplier_(1.0f)
+    , num_ch_(in_spec.num_channels())
+    , in_size_(0)
+    , in_pos_(0)
+    , out_acc_(0)
+    , slip_mode_(Slip_None)
+    , slip_pos_(0)
+    , slip_wait_(0)
+    , activity_avg_(0)
+    , total_count_(0)
+    , slip_count_(0)
+    , report_limiter_(LogReportInterval)
+    , valid_(false) {
+    roc_log(LogDebug,
+            "slip resampler: initializing: "
+            " frame_size=%lu fade_len=%lu num_ch=%lu use_inner_resampler=%d",
+            (unsigned long)InputFrameSize, (unsigned long)FadeLength,
+            (unsigned long)num_ch_, (int)use_inner_resampler_);
+
+    if (!in_spec.is_valid() || !out_spec.is_valid() || !in_spec.is_raw()
+        || !out_spec.is_raw()) {
+        roc_log(LogError,
+                "slip resampler: invalid sample spec:"
+                " in_spec=%s out_spec=%s",
+                sample_spec_to_str(in_spec).c_str(),
+                sample_spec_to_str(out_spec).c_str());
+        return;
+    }
+
+    if (in_spec.channel_set() != out_spec.channel_set()) {
+        roc_log(LogError,
+                "slip resampler: input and output channel sets should be equal:"
+                " in_spec=%s out_spec=%s",
+                sample_spec_to_str(in_spec).c_str(),
+                sample_spec_to_str(out_spec).c_str());
+        return;
+    }
+
+    if (frame_factory.raw_buffer_size() < InputFrameSize * num_ch_) {
+        roc_log(LogError, "slip resampler: can't allocate temporary buffer");
+        return;
+    }
+
+    in_buf_ = frame_factory.new_raw_buffer();
+    if (!in_buf_) {
+        roc_log(LogError, "slip resampler: can't allocate temporary buffer");
+        return;
+    }
+    in_buf_.reslice(0, InputFrameSize * num_ch_);
+
+    prev_buf_ = frame_factory.new_raw_buffer();
+    if (!prev_buf_) {
+        roc_log(LogError, "slip resampler: can't allocate temporary buffer");
+        return;
+    }
+    prev_buf_.reslice(0, num_ch_);
+
+    memset(prev_buf_.data(), 0, prev_buf_.size() * sizeof(sample_t));
+
+    valid_ = true;
+}
+
+SlipResampler::~SlipResampler() {
+}
+
+float SlipResampler::max_scaling_deviation() {
+    return MaxScalingDeviation;
+}
+
+bool SlipResampler::is_valid() const {
+    return valid_;
+}
+
+bool SlipResampler::set_scaling(size_t input_rate, size_t output_rate, float multiplier) {
+    roc_panic_if_not(is_valid());
+
+    if (input_rate == 0 || output_rate == 0 || multiplier <= 0
+        || std::abs(multiplier - 1.0f) > MaxScalingDeviation + ScalingEpsilon) {
+        roc_log(LogError,
+                "slip resampler:"
+                " scaling out of range: in_rate=%lu out_rate=%lu mult=%e",
+                (unsigned long)input_rate, (unsigned long)output_rate,
+                (double)multiplier);
+        return false;
+    }
+
+    use_inner_resampler_ = (input_rate != output_rate);
+
+    if (use_inner_resampler_) {
+        // always pass 1.0 instead of multiplier to inner resampler
+        if (!inner_resampler_->set_scaling(input_rate, output_rate, 1.0f)) {
+            return false;
+        }
+    }
+
+    input_spec_.set_sample_rate(input_rate);
+    output_spec_.set_sample_rate(output_rate);
+
+    multiplier_ = multiplier;
+
+    return true;
+}
+
+const core::Slice<sample_t>& SlipResampler::begin_push_input() {
+    roc_panic_if_not(is_valid());
+
+    if (use_inner_resampler_) {
+        // return buffer of inner resampler
+        return inner_resampler_->begin_push_input();
+    }
+
+    // return our buffer
+    return in_buf_;
+}
+
+void SlipResampler::end_push_input() {
+    roc_panic_if_not(is_valid());
+
+    if (use_inner_resampler_) {
+        // start reading from inner resampler
+        inner_resampler_->end_push_input();
+        return;
+    }
+
+    // start reading from our buffer
+    in_size_ = in_buf_.size();
+    in_pos_ = 0;
+    out_acc_ += in_size_ / multiplier_;
+}
+
+size_t SlipResampler::pop_output(sample_t* out_data, size_t out_size) {
+    roc_panic_if_not(is_valid());
+
+    size_t out_pos = 0;
+
+    while (out_pos < out_size) {
+        // self-check
+        roc_panic_if_not(in_size_ % num_ch_ == 0 && in_pos_ % num_ch_ == 0
+                         && in_pos_ <= in_size_);
+        roc_panic_if_not(out_size % num_ch_ == 0 && out_pos % num_ch_ == 0
+                         && out_pos <= out_size);
+
+        if (slip_mode_ == Slip_Insert && slip_pos_ == FadeLength) {
+            // fade reached delay of one sample; complete insertion by
+            // repeating previous input sample without consuming input
+            memcpy(out_data + out_pos, prev_buf_.data(), num_ch_ * sizeof(sample_t));
+            out_pos += num_ch_;
+            out_acc_ -= num_ch_;
+
+            slip_mode_ = Slip_None;
+            // for reports
+            slip_count_++;
+            continue;
+        }
+
+        if (in_pos_ == in_size_ && use_inner_resampler_) {
+            // no more samples in input frame, but maybe inner resampler has more?
+            // try to refill our buffer and start reading from it
+            in_size_ = inner_resampler_->pop_output(in_buf_.data(), in_buf_.size());
+            in_pos_ = 0;
+            out_acc_ += in_size_ / multiplier_;
+        }
+
+        if (in_pos_ == in_size_) {
+            // no more samples in input frame and inner resampler
+            // caller should push more input samples
+            break;
+        }
+
+        const sample_t* in_frame = in_buf_.data() + in_pos_;
+
+        if (slip_mode_ == Slip_None) {
+            const int drift = pending_slip_();
+
+            if (drift == 0) {
+                // no slip needed, copy input samples to output
+                const size_t copy_size = std::min(in_size_ - in_pos_, out_size - out_pos);
+
+                memcpy(out_data + out_pos, in_frame, copy_size * sizeof(sample_t));
+
+                out_pos += copy_size;
+                in_pos_ += copy_size;
+                out_acc_ -= copy_size;
+                slip_wait_ = 0;
+
+                // remember last num_ch samples for fading
+                memcpy(prev_buf_.data(), in_buf_.data() + in_pos_ - num_ch_,
+                       num_ch_ * sizeof(sample_t));
+                continue;
+            }
+
+            // slip is needed, but we'd better start it at a quiet or flat point;
+            // if we're behind by two or more samples, don't wait anymore
+            const bool at_slip_point = is_slip_point_(in_frame);
+
+            if (!at_slip_point && std::abs(drift) < 2 && slip_wait_ < MaxSlipWait) {
+                memcpy(out_data + out_pos, in_frame, num_ch_ * sizeof(sample_t));
+                memcpy(prev_buf_.data(), in_frame, num_ch_ * sizeof(sample_t));
+
+                out_pos += num_ch_;
+                in_pos_ += num_ch_;
+                out_acc_ -= num_ch_;
+                slip_wait_++;
+                continue;
+            }
+
+            slip_pos_ = 0;
+            slip_wait_ = 0;
+
+            if (drift > 0) {
+                // accumulator is ahead of input, insert one sample
+                slip_mode_ = Slip_Insert;
+            } else {
+                // accumulator is behind input, drop one sample;
+                // first consume one input sample without producing output,
+                // then fade from delay of one sample back to zero delay
+                slip_mode_ = Slip_Drop;
+
+                memcpy(prev_buf_.data(), in_frame, num_ch_ * sizeof(sample_t));
+                in_pos_ += num_ch_;
+                continue;
+            }
+        }
+
+        // interpolate between previous and current input sample
+        fade_frame_(out_data + out_pos, in_frame, slip_delay_());
+        memcpy(prev_buf_.data(), in_frame, num_ch_ * sizeof(sample_t));
+
+        out_pos += num_ch_;
+        in_pos_ += num_ch_;
+        out_acc_ -= num_ch_;
+        slip_pos_++;
+
+        if (slip_mode_ == Slip_Drop && slip_pos_ == FadeLength) {
+            slip_mode_ = Slip_None;
+            // for reports
+            slip_count_++;
+        }
+    }
+
+    // for reports
+    total_count_ += out_pos;
+
+    report_stats_();
+
+    return out_pos;
+}
+
+float SlipResampler::n_left_to_process() const {
+    roc_panic_if_not(is_valid());
+
+    // how much samples are pending in our buffer
+    float n_pending = float(in_size_ - in_pos_);
+
+    if (slip_mode_ != Slip_None) {
+        // during slip, output is delayed by fraction of sample
+        n_pending += slip_delay_() * num_ch_;
+    }
+
+    float n_samples = n_pending / output_spec_.sample_rate() * input_spec_.sample_rate();
+
+    if (use_inner_resampler_) {
+        // how much samples are pending in inner resampler
+        n_samples += inner_resampler_->n_left_to_process();
+    }
+
+    return n_samples;
+}
+
+// Returns how many samples per channel should be inserted (if positive)
+// or dropped (if negative) to keep up with multiplier.
+int SlipResampler::pending_slip_() const {
+    return int((out_acc_ - float(in_size_ - in_pos_)) / num_ch_);
+}
+
+// Checks if difference between given and previous input sample is well below
+// its average. Average is updated only while we're looking for a slip point,
+// which is enough to track signal level and doesn't add per-sample cost.
+bool SlipResampler::is_slip_point_(const sample_t* frame) {
+    const sample_t* prev = prev_buf_.data();
+
+    float activity = 0;
+    for (size_t ch = 0; ch < num_ch_; ch++) {
+        activity += std::abs(frame[ch] - prev[ch]);
+    }
+
+    const bool is_low = activity <= activity_avg_ * LowActivityRatio;
+
+    activity_avg_ += (activity - activity_avg_) * ActivityAvgCoeff;
+
+    return is_low;
+}
+
+void SlipResampler::fade_frame_(sample_t* out_frame,
+                                const sample_t* in_frame,
+                                float delay) {
+    const sample_t* prev = prev_buf_.data();
+
+    for (size_t ch = 0; ch < num_ch_; ch++) {
+        out_frame[ch] = in_frame[ch] - delay * (in_frame[ch] - prev[ch]);
+    }
+}
+
+// Fractional delay for current fade step, in samples.
+float SlipResampler::slip_delay_() const {
+    if (slip_mode_ == Slip_Insert) {
+        return float(slip_pos_ + 1) / (FadeLength + 1);
+    }
+    return 1.0f - float(slip_pos_) / FadeLength;
+}
+
+void SlipResampler::report_stats_() {
+    if (!report_limiter_.allow()) {
+        return;
+    }
+
+    // number of insertions/removals per second
+    const float slip_ratio = (float)slip_count_
+        / ((float)output_spec_.samples_overall_2_ns(total_count_) / core::Second);
+
+    total_count_ = 0;
+    slip_count_ = 0;
+
+    roc_log(LogDebug, "slip resampler: mult=%.6f ratio=%.3f slips/sec",
+            (double)multiplier_, (double)slip_ratio);
+}
+
+} // namespace audio
+} // namespace roc
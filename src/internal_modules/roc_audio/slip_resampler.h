@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/slip_resampler.h
+//! @brief Sample slipping resampler.
+
+#ifndef ROC_AUDIO_SLIP_RESAMPLER_H_
+#define ROC_AUDIO_SLIP_RESAMPLER_H_
+
+#include "roc_audio/frame.h"
+#include "roc_audio/frame_factory.h"
+#include "roc_audio/iresampler.h"
+#include "roc_audio/sample.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/rate_limiter.h"
+#include "roc_core/slice.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Sample slipping resampler.
+//!
+//! Acts as decorator for another resampler instance.
+//!
+//! Like DecimationResampler, uses underlying resampler only to apply constant part
+//! of scaling factor based on input and output rates, and skips it if these rates
+//! are equal. Dynamic part of scaling factor, a.k.a. multiplier, is applied by
+//! inserting or dropping single samples ("slips").
+//!
+//! Unlike DecimationResampler, slips are not abrupt:
+//!  - a slip is started at a point where signal is quiet or flat, i.e. where
+//!    difference between adjacent samples is well below its recent average,
+//!    or unconditionally if no such point was found during a short period
+//!  - a slip is spread over a short fade, during which output is linearly
+//!    interpolated between adjacent input samples with fractional delay slowly
+//!    moving from 0 to 1 (insertion) or from 1 to 0 (removal)
+//!
+//! Between slips, samples are copied as is, so when input and output rates are
+//! the same, CPU cost is close to memcpy(). The price is that only rather small
+//! multipliers are supported, which is enough to compensate clock drift; latency
+//! tuner bounds its scaling accordingly when this backend is used.
+class SlipResampler : public IResampler, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    SlipResampler(const core::SharedPtr<IResampler>& inner_resampler,
+                  core::IArena& arena,
+                  FrameFactory& frame_factory,
+                  const SampleSpec& in_spec,
+                  const SampleSpec& out_spec);
+
+    ~SlipResampler();
+
+    //! Maximum supported deviation of multiplier from 1.0.
+    static float max_scaling_deviation();
+
+    //! Check if object is successfully constructed.
+    virtual bool is_valid() const;
+
+    //! Set new resample factor.
+    virtual bool set_scaling(size_t input_rate, size_t output_rate, float multiplier);
+
+    //! Get buffer to be filled with input data.
+    virtual const core::Slice<sample_t>& begin_push_input();
+
+    //! Commit buffer with input data.
+    virtual void end_push_input();
+
+    //! Read samples from input frame and fill output frame.
+    virtual size_t pop_output(sample_t* out_data, size_t out_size);
+
+    //! How many samples were pushed but not processed yet.
+    virtual float n_left_to_process() const;
+
+private:
+    enum SlipMode { Slip_None, Slip_Insert, Slip_Drop };
+
+    int pending_slip_() const;
+    bool is_slip_point_(const sample_t* frame);
+    void fade_frame_(sample_t* out_frame, const sample_t* in_frame, float delay);
+    float slip_delay_() const;
+
+    void report_stats_();
+
+    const core::SharedPtr<IResampler> inner_resampler_;
+    bool use_inner_resampler_;
+
+    SampleSpec input_spec_;
+    SampleSpec output_spec_;
+    float multiplier_;
+
+    const size_t num_ch_;
+
+    core::Slice<sample_t> in_buf_;
+    size_t in_size_;
+    size_t in_pos_;
+
+    float out_acc_;
+
+    core::Slice<sample_t> prev_buf_;
+
+    SlipMode slip_mode_;
+    size_t slip_pos_;
+    size_t slip_wait_;
+    float activity_avg_;
+
+    size_t total_count_;
+    size_t slip_count_;
+    core::RateLimiter report_limiter_;
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_SLIP_RESAMPLER_H_
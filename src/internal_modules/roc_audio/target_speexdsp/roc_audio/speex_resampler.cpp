@@ -52,6 +52,10 @@ SpeexResampler::SpeexResampler(core::IArena& arena,
                                const SampleSpec& out_spec)
     : IResampler(arena)
     , speex_state_(NULL)
+    , ratio_num_(0)
+    , ratio_den_(0)
+    , in_rate_(0)
+    , out_rate_(0)
     , num_ch_((spx_uint32_t)in_spec.num_channels())
     , in_frame_size_(0)
     , in_frame_pos_(0)
@@ -179,18 +183,33 @@ bool SpeexResampler::set_scaling(size_t input_rate, size_t output_rate, float mu
         return false;
     }
 
+    const spx_uint32_t in_rate = spx_uint32_t(roundf(input_rate * mult));
+    const spx_uint32_t out_rate = spx_uint32_t(output_rate);
+
+    if (ratio_num == ratio_num_ && ratio_den == ratio_den_ && in_rate == in_rate_
+        && out_rate == out_rate_) {
+        // Speex recomputes its filter table on every call, even if nothing has
+        // changed, which is expensive and happens often: scaling is updated every
+        // few milliseconds, and decimating backend always passes 1.0 to us.
+        return true;
+    }
+
     const int err = speex_resampler_set_rate_frac(speex_state_, ratio_num, ratio_den,
-                                                  spx_uint32_t(roundf(input_rate * mult)),
-                                                  spx_uint32_t(output_rate));
+                                                  in_rate, out_rate);
 
     if (err != RESAMPLER_ERR_SUCCESS) {
         roc_log(LogError,
                 "speex resampler: speex_resampler_set_rate_frac(%d/%d, %d/%d): [%d] %s",
-                (int)ratio_num, (int)ratio_den, int(roundf(input_rate * mult)),
-                int(output_rate), err, get_error_msg(err));
+                (int)ratio_num, (int)ratio_den, (int)in_rate, (int)out_rate, err,
+                get_error_msg(err));
         return false;
     }
 
+    ratio_num_ = ratio_num;
+    ratio_den_ = ratio_den;
+    in_rate_ = in_rate;
+    out_rate_ = out_rate;
+
     in_latency_diff_ = (ssize_t)speex_resampler_get_input_latency(speex_state_)
         - (ssize_t)initial_in_latency_;
 
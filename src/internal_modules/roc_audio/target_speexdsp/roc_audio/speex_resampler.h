@@ -71,6 +71,14 @@ private:
 
     SpeexResamplerState* speex_state_;
 
+    // Rates and ratio last passed to speex.
+    // Every change makes speex rebuild its filter table, so we avoid
+    // passing the same values again.
+    spx_uint32_t ratio_num_;
+    spx_uint32_t ratio_den_;
+    spx_uint32_t in_rate_;
+    spx_uint32_t out_rate_;
+
     // Channel count.
     const spx_uint32_t num_ch_;
 
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/flat_hashmap.h
+//! @brief Open-addressing hash table.
+
+#ifndef ROC_CORE_FLAT_HASHMAP_H_
+#define ROC_CORE_FLAT_HASHMAP_H_
+
+#include "roc_core/aligned_storage.h"
+#include "roc_core/attributes.h"
+#include "roc_core/flat_hashmap_impl.h"
+#include "roc_core/hashsum.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/ownership_policy.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Open-addressing hash table.
+//!
+//! Alternative to Hashmap with the same interface, optimized for frequent
+//! lookups by small fixed-size keys, like source ids or socket addresses.
+//!
+//! Characteristics:
+//!  1) Non-intrusive. Elements don't need to inherit any node class.
+//!     Table stores pointers to elements and their hashes.
+//!  2) Open addressing. All slots are stored in flat arrays, without
+//!     pointer chasing. Every slot has one control byte with 7 bits of
+//!     element hash; lookup compares groups of 16 control bytes at once
+//!     (using SSE2 when available, or 64-bit SWAR arithmetic otherwise),
+//!     and dereferences only elements whose hash matches.
+//!  3) Controllable allocations. Allocations and deallocations are performed
+//!     only when the table is rebuilt during insertion or explicit grow().
+//!  4) Zero allocations for small hash tables. A fixed number of slots can be
+//!     embedded directly into hash table object.
+//!  5) Allows to iterate elements in insertion order. Removed elements leave
+//!     holes, which are compacted when table is rebuilt.
+//!
+//! Unlike Hashmap, contains(), remove() and nextof() compute key hash,
+//! because element doesn't hold any table data.
+//!
+//! @tparam T defines object type, it should implement three methods:
+//!
+//! @code
+//!   // get object key
+//!   Key key() const;
+//!
+//!   // compute key hash
+//!   static core::hashsum_t key_hash(Key key);
+//!
+//!   // compare two keys for equality
+//!   static bool key_equal(Key key1, Key key2);
+//! @endcode
+//!
+//! Object key should not change while object is member of the table.
+//!
+//! @tparam EmbeddedCapacity defines the capacity embedded directly into
+//! FlatHashmap. It is used instead of dynamic memory while the number of
+//! elements is smaller than this capacity.
+//!
+//! @tparam OwnershipPolicy defines ownership policy which is used to acquire an element
+//! ownership when it's added to the hashmap and release ownership when it's removed
+//! from the hashmap.
+template <class T,
+          size_t EmbeddedCapacity = 0,
+          template <class TT> class OwnershipPolicy = RefCountedOwnership>
+class FlatHashmap : public NonCopyable<> {
+public:
+    //! Pointer type.
+    //! @remarks
+    //!  either raw or smart pointer depending on the ownership policy.
+    typedef typename OwnershipPolicy<T>::Pointer Pointer;
+
+    //! Initialize empty hashmap with arena.
+    //! @remarks
+    //!  Hashmap capacity may grow using arena.
+    explicit FlatHashmap(IArena& arena)
+        : impl_(embedded_slots_.memory(), NumEmbeddedSlots, arena) {
+    }
+
+    //! Release ownership of all elements.
+    ~FlatHashmap() {
+        T* elem = (T*)impl_.front();
+
+        while (elem != NULL) {
+            const hashsum_t hash = T::key_hash(elem->key());
+            T* next_elem = (T*)impl_.nextof(hash, elem);
+            impl_.remove(hash, elem);
+            OwnershipPolicy<T>::release(*elem);
+            elem = next_elem;
+        }
+    }
+
+    //! Get maximum number of elements that can be added to hashmap before
+    //! it is rebuilt.
+    size_t capacity() const {
+        return impl_.capacity();
+    }
+
+    //! Get number of elements added to hashmap.
+    size_t size() const {
+        return impl_.size();
+    }
+
+    //! Check if size is zero.
+    bool is_empty() const {
+        return size() == 0;
+    }
+
+    //! Check if element belongs to hashmap.
+    //!
+    //! @note
+    //!  - has O(1) complexity in average
+    //!  - computes key hash
+    bool contains(const T& elem) const {
+        return impl_.contains(T::key_hash(const_cast<T&>(elem).key()), &elem);
+    }
+
+    //! Find element in the hashmap by key.
+    //!
+    //! @returns
+    //!  Pointer to the element with given key or NULL if it's not found.
+    //!
+    //! @note
+    //!  - has O(1) complexity in average and O(n) in the worst case
+    //!  - computes key hash
+    template <class Key> Pointer find(const Key& key) const {
+        return (T*)impl_.find(T::key_hash(key), (const void*)&key,
+                              &FlatHashmap<T, EmbeddedCapacity,
+                                           OwnershipPolicy>::key_equal_<Key>);
+    }
+
+    //! Get first element in hashmap.
+    //! Elements are ordered by insertion.
+    //! @returns
+    //!  first element or NULL if hashmap is empty.
+    Pointer front() const {
+        return (T*)impl_.front();
+    }
+
+    //! Get last element in hashmap.
+    //! Elements are ordered by insertion.
+    //! @returns
+    //!  last element or NULL if hashmap is empty.
+    Pointer back() const {
+        return (T*)impl_.back();
+    }
+
+    //! Get hashmap element next to given one.
+    //! Elements are ordered by insertion.
+    //!
+    //! @returns
+    //!  hashmap element following @p elem if @p elem is not
+    //!  last, or NULL otherwise.
+    //!
+    //! @pre
+    //!  @p elem should be member of this hashmap.
+    Pointer nextof(T& elem) const {
+        return (T*)impl_.nextof(T::key_hash(elem.key()), &elem);
+    }
+
+    //! Get hashmap element previous to given one.
+    //! Elements are ordered by insertion.
+    //!
+    //! @returns
+    //!  hashmap element preceding @p elem if @p elem is not
+    //!  first, or NULL otherwise.
+    //!
+    //! @pre
+    //!  @p elem should be member of this hashmap.
+    Pointer prevof(T& elem) const {
+        return (T*)impl_.prevof(T::key_hash(elem.key()), &elem);
+    }
+
+    //! Insert element into hashmap.
+    //!
+    //! @remarks
+    //!  - acquires ownership of @p elem
+    //!
+    //! @returns
+    //!  false if the allocation failed
+    //!
+    //! @pre
+    //!  - hashmap shouldn't have an element with the same key
+    //!
+    //! @note
+    //!  - has O(1) complexity in average and O(n) in the worst case
+    //!  - computes key hash
+    //!  - makes allocations and deallocations only when table is rebuilt
+    ROC_ATTR_NODISCARD bool insert(T& elem) {
+        if (!insert_(elem.key(), elem)) {
+            return false;
+        }
+        OwnershipPolicy<T>::acquire(elem);
+        return true;
+    }
+
+    //! Remove element from hashmap.
+    //!
+    //! @remarks
+    //!  - releases ownership of @p elem
+    //!
+    //! @pre
+    //!  @p elem should be member of this hashmap.
+    //!
+    //! @note
+    //!  - has O(1) complexity in average
+    //!  - computes key hash
+    //!  - doesn't make allocations or deallocations
+    void remove(T& elem) {
+        impl_.remove(T::key_hash(elem.key()), &elem);
+        OwnershipPolicy<T>::release(elem);
+    }
+
+    //! Grow hashtable capacity.
+    //!
+    //! @remarks
+    //!  Check if hash table is full, and if so, rebuild it, either increasing
+    //!  capacity or compacting holes left by removed elements.
+    //!
+    //! @returns
+    //!  - true if no growth needed or growth succeeded
+    //!  - false if allocation failed
+    ROC_ATTR_NODISCARD bool grow() {
+        return impl_.grow();
+    }
+
+private:
+    enum {
+        // how much slots are embedded directly into FlatHashmap object
+        NumEmbeddedSlots = FlatHashmapEmbeddedSlots<EmbeddedCapacity>::Value
+    };
+
+    template <class Key> static bool key_equal_(void* elem, const void* key) {
+        const Key& key_ref = *(const Key*)key;
+        return T::key_equal(((T*)elem)->key(), key_ref);
+    }
+
+    template <class Key> bool insert_(const Key& key, T& elem) {
+        return impl_.insert(
+            &elem, T::key_hash(key), (const void*)&key,
+            &FlatHashmap<T, EmbeddedCapacity, OwnershipPolicy>::key_equal_<Key>);
+    }
+
+    AlignedStorage<NumEmbeddedSlots * FlatHashmapImpl::LoadFactorNum
+                       / FlatHashmapImpl::LoadFactorDen
+                       * sizeof(FlatHashmapImpl::Entry)
+                   + NumEmbeddedSlots
+                       * (sizeof(FlatHashmapImpl::Slot) + sizeof(uint8_t))>
+        embedded_slots_;
+
+    FlatHashmapImpl impl_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_FLAT_HASHMAP_H_
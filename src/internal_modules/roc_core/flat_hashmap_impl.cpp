@@ -0,0 +1,482 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/flat_hashmap_impl.h"
+#include "roc_core/panic.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace roc {
+namespace core {
+
+namespace {
+
+// Control byte values.
+// Full slots hold 7 low bits of hash, so that high bit is zero.
+enum { Ctrl_Empty = 0x80, Ctrl_Deleted = 0xFE };
+
+uint8_t hash_h2(hashsum_t hash) {
+    return uint8_t(hash & 0x7F);
+}
+
+size_t hash_h1(hashsum_t hash) {
+    return size_t(hash >> 7);
+}
+
+// Index of lowest set bit, mask should be non-zero.
+size_t lowest_bit(uint32_t mask) {
+#if defined(__GNUC__)
+    return (size_t)__builtin_ctz(mask);
+#else  // !defined(__GNUC__)
+    size_t n = 0;
+    if ((mask & 0xFF) == 0) {
+        mask >>= 8;
+        n += 8;
+    }
+    if ((mask & 0xF) == 0) {
+        mask >>= 4;
+        n += 4;
+    }
+    if ((mask & 0x3) == 0) {
+        mask >>= 2;
+        n += 2;
+    }
+    if ((mask & 0x1) == 0) {
+        n += 1;
+    }
+    return n;
+#endif // defined(__GNUC__)
+}
+
+#if defined(__SSE2__)
+
+// Group of control bytes, compared using SSE2.
+class Group {
+public:
+    explicit Group(const uint8_t* ctrl)
+        : ctrl_(_mm_loadu_si128((const __m128i*)ctrl)) {
+    }
+
+    // Bitmask of slots with given control byte.
+    uint32_t match(uint8_t h2) const {
+        return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8((char)h2), ctrl_));
+    }
+
+    // Bitmask of empty slots.
+    uint32_t match_empty() const {
+        return match(Ctrl_Empty);
+    }
+
+    // Bitmask of empty or deleted slots.
+    uint32_t match_free() const {
+        return (uint32_t)_mm_movemask_epi8(ctrl_);
+    }
+
+private:
+    __m128i ctrl_;
+};
+
+#else // !defined(__SSE2__)
+
+// Group of control bytes, compared using 64-bit SWAR arithmetic.
+class Group {
+public:
+    explicit Group(const uint8_t* ctrl)
+        : lo_(load_(ctrl))
+        , hi_(load_(ctrl + 8)) {
+    }
+
+    // Bitmask of slots with given control byte.
+    // May have false positives, which are filtered by caller.
+    uint32_t match(uint8_t h2) const {
+        return to_bitmask_(match_word_(lo_, h2)) | (to_bitmask_(match_word_(hi_, h2)) << 8);
+    }
+
+    // Bitmask of empty slots.
+    uint32_t match_empty() const {
+        // empty is 0b10000000, deleted is 0b11111110, full is 0b0xxxxxxx
+        return to_bitmask_(lo_ & ~(lo_ << 6) & Msbs)
+            | (to_bitmask_(hi_ & ~(hi_ << 6) & Msbs) << 8);
+    }
+
+    // Bitmask of empty or deleted slots.
+    uint32_t match_free() const {
+        return to_bitmask_(lo_ & Msbs) | (to_bitmask_(hi_ & Msbs) << 8);
+    }
+
+private:
+    static const uint64_t Lsbs = 0x0101010101010101ull;
+    static const uint64_t Msbs = 0x8080808080808080ull;
+
+    static uint64_t load_(const uint8_t* p) {
+        // byte N goes to bits 8N..8N+7 regardless of endianess
+        uint64_t w = 0;
+        for (size_t n = 0; n < 8; n++) {
+            w |= uint64_t(p[n]) << (n * 8);
+        }
+        return w;
+    }
+
+    static uint64_t match_word_(uint64_t w, uint8_t h2) {
+        const uint64_t x = w ^ (Lsbs * h2);
+        return (x - Lsbs) & ~x & Msbs;
+    }
+
+    // Gather high bit of every byte into 8-bit mask.
+    static uint32_t to_bitmask_(uint64_t w) {
+        return uint32_t(((w >> 7) * 0x0102040810204080ull) >> 56);
+    }
+
+    uint64_t lo_;
+    uint64_t hi_;
+};
+
+#endif // defined(__SSE2__)
+
+} // namespace
+
+FlatHashmapImpl::FlatHashmapImpl(void* preallocated_data,
+                                 size_t num_preallocated_slots,
+                                 IArena& arena)
+    : preallocated_data_(preallocated_data)
+    , num_preallocated_slots_(num_preallocated_slots)
+    , memory_(NULL)
+    , entries_(NULL)
+    , slots_(NULL)
+    , ctrl_(NULL)
+    , n_slots_(0)
+    , n_entries_(0)
+    , size_(0)
+    , arena_(arena) {
+    if (num_preallocated_slots_ != 0) {
+        roc_panic_if_msg(num_preallocated_slots_ < MinSlots
+                             || (num_preallocated_slots_ & (num_preallocated_slots_ - 1)),
+                         "flat hashmap: invalid number of preallocated slots");
+
+        set_memory_(preallocated_data_, num_preallocated_slots_);
+        reindex_();
+    }
+}
+
+FlatHashmapImpl::~FlatHashmapImpl() {
+    if (size_ != 0) {
+        roc_panic("flat hashmap: hashmap isn't empty on destruct");
+    }
+    dealloc_memory_();
+}
+
+size_t FlatHashmapImpl::capacity() const {
+    return entries_capacity_(n_slots_);
+}
+
+size_t FlatHashmapImpl::size() const {
+    return size_;
+}
+
+void* FlatHashmapImpl::find(hashsum_t hash,
+                            const void* key,
+                            key_equals_callback callback) const {
+    const size_t slot = find_key_slot_(hash, key, callback);
+    if (slot == NoSlot) {
+        return NULL;
+    }
+    return slots_[slot].elem;
+}
+
+bool FlatHashmapImpl::contains(hashsum_t hash, const void* elem) const {
+    return find_elem_slot_(hash, elem) != NoSlot;
+}
+
+void* FlatHashmapImpl::front() const {
+    for (size_t n = 0; n < n_entries_; n++) {
+        if (entries_[n].elem) {
+            return entries_[n].elem;
+        }
+    }
+    return NULL;
+}
+
+void* FlatHashmapImpl::back() const {
+    for (size_t n = n_entries_; n > 0; n--) {
+        if (entries_[n - 1].elem) {
+            return entries_[n - 1].elem;
+        }
+    }
+    return NULL;
+}
+
+void* FlatHashmapImpl::nextof(hashsum_t hash, const void* elem) const {
+    const size_t slot = find_elem_slot_(hash, elem);
+    if (slot == NoSlot) {
+        roc_panic("flat hashmap: element is not a member of hashmap");
+    }
+
+    for (size_t n = slots_[slot].pos + 1; n < n_entries_; n++) {
+        if (entries_[n].elem) {
+            return entries_[n].elem;
+        }
+    }
+    return NULL;
+}
+
+void* FlatHashmapImpl::prevof(hashsum_t hash, const void* elem) const {
+    const size_t slot = find_elem_slot_(hash, elem);
+    if (slot == NoSlot) {
+        roc_panic("flat hashmap: element is not a member of hashmap");
+    }
+
+    for (size_t n = slots_[slot].pos; n > 0; n--) {
+        if (entries_[n - 1].elem) {
+            return entries_[n - 1].elem;
+        }
+    }
+    return NULL;
+}
+
+bool FlatHashmapImpl::insert(void* elem,
+                             hashsum_t hash,
+                             const void* key,
+                             key_equals_callback callback) {
+    roc_panic_if(!elem);
+
+    if (n_entries_ >= entries_capacity_(n_slots_)) {
+        if (!grow()) {
+            return false;
+        }
+    }
+
+    if (find_key_slot_(hash, key, callback) != NoSlot) {
+        roc_panic("flat hashmap: attempt to insert an element with duplicate key");
+    }
+
+    const size_t slot = find_free_slot_(hash);
+    roc_panic_if(slot == NoSlot);
+
+    ctrl_[slot] = hash_h2(hash);
+    slots_[slot].elem = elem;
+    slots_[slot].hash = hash;
+    slots_[slot].pos = n_entries_;
+
+    entries_[n_entries_].elem = elem;
+    entries_[n_entries_].hash = hash;
+
+    n_entries_++;
+    size_++;
+
+    return true;
+}
+
+void FlatHashmapImpl::remove(hashsum_t hash, const void* elem) {
+    const size_t slot = find_elem_slot_(hash, elem);
+    if (slot == NoSlot) {
+        roc_panic("flat hashmap: attempt to remove an element which is not a member");
+    }
+
+    // Entry becomes a hole until next rebuild, so that insertion order
+    // of remaining elements is kept and positions in slots stay valid.
+    entries_[slots_[slot].pos].elem = NULL;
+    ctrl_[slot] = Ctrl_Deleted;
+
+    size_--;
+}
+
+bool FlatHashmapImpl::grow() {
+    if (n_entries_ < entries_capacity_(n_slots_)) {
+        return true;
+    }
+
+    size_t n_slots = n_slots_ != 0 ? n_slots_ : (size_t)MinSlots;
+
+    // If at least half of entries are holes, compact in place,
+    // otherwise double the table.
+    if (size_ >= entries_capacity_(n_slots) / 2) {
+        n_slots = n_slots_ != 0 ? n_slots_ * 2 : (size_t)MinSlots;
+    }
+
+    return rebuild_(n_slots);
+}
+
+size_t FlatHashmapImpl::find_key_slot_(hashsum_t hash,
+                                       const void* key,
+                                       key_equals_callback callback) const {
+    if (n_slots_ == 0) {
+        return NoSlot;
+    }
+
+    const size_t n_groups = n_slots_ / GroupWidth;
+    const uint8_t h2 = hash_h2(hash);
+
+    size_t group = hash_h1(hash) & (n_groups - 1);
+
+    for (size_t step = 1; step <= n_groups; step++) {
+        const Group g(ctrl_ + group * GroupWidth);
+
+        for (uint32_t mask = g.match(h2); mask != 0; mask &= mask - 1) {
+            const size_t slot = group * GroupWidth + lowest_bit(mask);
+            const Slot& s = slots_[slot];
+
+            if (ctrl_[slot] == h2 && s.hash == hash && callback(s.elem, key)) {
+                return slot;
+            }
+        }
+
+        if (g.match_empty() != 0) {
+            break;
+        }
+
+        group = (group + step) & (n_groups - 1);
+    }
+
+    return NoSlot;
+}
+
+size_t FlatHashmapImpl::find_elem_slot_(hashsum_t hash, const void* elem) const {
+    if (n_slots_ == 0 || elem == NULL) {
+        return NoSlot;
+    }
+
+    const size_t n_groups = n_slots_ / GroupWidth;
+    const uint8_t h2 = hash_h2(hash);
+
+    size_t group = hash_h1(hash) & (n_groups - 1);
+
+    for (size_t step = 1; step <= n_groups; step++) {
+        const Group g(ctrl_ + group * GroupWidth);
+
+        for (uint32_t mask = g.match(h2); mask != 0; mask &= mask - 1) {
+            const size_t slot = group * GroupWidth + lowest_bit(mask);
+
+            if (ctrl_[slot] == h2 && slots_[slot].elem == elem) {
+                return slot;
+            }
+        }
+
+        if (g.match_empty() != 0) {
+            break;
+        }
+
+        group = (group + step) & (n_groups - 1);
+    }
+
+    return NoSlot;
+}
+
+size_t FlatHashmapImpl::find_free_slot_(hashsum_t hash) const {
+    const size_t n_groups = n_slots_ / GroupWidth;
+
+    size_t group = hash_h1(hash) & (n_groups - 1);
+
+    for (size_t step = 1; step <= n_groups; step++) {
+        const Group g(ctrl_ + group * GroupWidth);
+
+        const uint32_t mask = g.match_free();
+        if (mask != 0) {
+            return group * GroupWidth + lowest_bit(mask);
+        }
+
+        group = (group + step) & (n_groups - 1);
+    }
+
+    return NoSlot;
+}
+
+size_t FlatHashmapImpl::entries_capacity_(size_t n_slots) const {
+    return n_slots * LoadFactorNum / LoadFactorDen;
+}
+
+bool FlatHashmapImpl::rebuild_(size_t n_slots) {
+    roc_panic_if(n_slots < (size_t)MinSlots || (n_slots & (n_slots - 1)) != 0);
+
+    if (n_slots == n_slots_) {
+        // Compact entries in place, keeping their order.
+        size_t n_live = 0;
+        for (size_t n = 0; n < n_entries_; n++) {
+            if (entries_[n].elem) {
+                entries_[n_live++] = entries_[n];
+            }
+        }
+        n_entries_ = n_live;
+
+        reindex_();
+        return true;
+    }
+
+    void* new_memory = NULL;
+
+    if (n_slots <= num_preallocated_slots_ && memory_ != preallocated_data_) {
+        new_memory = preallocated_data_;
+        n_slots = num_preallocated_slots_;
+    } else {
+        new_memory = arena_.allocate(memory_size(n_slots));
+        if (!new_memory) {
+            return false;
+        }
+    }
+
+    Entry* old_entries = entries_;
+    const size_t old_n_entries = n_entries_;
+    void* old_memory = memory_;
+
+    set_memory_(new_memory, n_slots);
+
+    n_entries_ = 0;
+    for (size_t n = 0; n < old_n_entries; n++) {
+        if (old_entries[n].elem) {
+            entries_[n_entries_++] = old_entries[n];
+        }
+    }
+
+    reindex_();
+
+    if (old_memory && old_memory != preallocated_data_) {
+        arena_.deallocate(old_memory);
+    }
+
+    return true;
+}
+
+void FlatHashmapImpl::set_memory_(void* memory, size_t n_slots) {
+    memory_ = memory;
+    n_slots_ = n_slots;
+
+    entries_ = (Entry*)memory;
+    slots_ = (Slot*)(entries_ + entries_capacity_(n_slots));
+    ctrl_ = (uint8_t*)(slots_ + n_slots);
+}
+
+void FlatHashmapImpl::reindex_() {
+    memset(ctrl_, Ctrl_Empty, n_slots_);
+
+    for (size_t n = 0; n < n_entries_; n++) {
+        const size_t slot = find_free_slot_(entries_[n].hash);
+        roc_panic_if(slot == NoSlot);
+
+        ctrl_[slot] = hash_h2(entries_[n].hash);
+        slots_[slot].elem = entries_[n].elem;
+        slots_[slot].hash = entries_[n].hash;
+        slots_[slot].pos = n;
+    }
+}
+
+void FlatHashmapImpl::dealloc_memory_() {
+    if (memory_ && memory_ != preallocated_data_) {
+        arena_.deallocate(memory_);
+    }
+
+    memory_ = NULL;
+    entries_ = NULL;
+    slots_ = NULL;
+    ctrl_ = NULL;
+    n_slots_ = 0;
+    n_entries_ = 0;
+}
+
+} // namespace core
+} // namespace roc
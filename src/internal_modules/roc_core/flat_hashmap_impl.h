@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/flat_hashmap_impl.h
+//! @brief Open-addressing hash table implementation file.
+
+#ifndef ROC_CORE_FLAT_HASHMAP_IMPL_H_
+#define ROC_CORE_FLAT_HASHMAP_IMPL_H_
+
+#include "roc_core/attributes.h"
+#include "roc_core/hashsum.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Open-addressing hash table internal implementation.
+//!
+//! Table memory is one block holding three arrays:
+//!  - entries: element pointers and hashes, in insertion order;
+//!    removed elements leave holes which are compacted on rebuild;
+//!  - slots: element pointer, hash, and position in entries array;
+//!  - control bytes: for every slot, either "empty", "deleted", or 7 low
+//!    bits of element hash.
+//!
+//! Lookup scans control bytes group by group, comparing whole group with
+//! 7-bit hash in a few instructions, and touches slots only for matching
+//! control bytes. Groups are probed using triangular sequence.
+class FlatHashmapImpl : public NonCopyable<> {
+public:
+    enum {
+        //! Number of control bytes compared at once.
+        GroupWidth = 16,
+
+        //! Minimum number of slots.
+        MinSlots = 16,
+
+        // rebuild happens when n_entries >= n_slots * LoadFactorNum / LoadFactorDen
+        LoadFactorNum = 7,
+        LoadFactorDen = 8
+    };
+
+    //! Table entry.
+    struct Entry {
+        //! Element pointer, NULL if removed.
+        void* elem;
+
+        //! Element hash.
+        hashsum_t hash;
+    };
+
+    //! Table slot.
+    struct Slot {
+        //! Element pointer.
+        void* elem;
+
+        //! Element hash.
+        hashsum_t hash;
+
+        //! Position in entries array.
+        size_t pos;
+    };
+
+    //! Callback function pointer type for key equality check.
+    typedef bool (*key_equals_callback)(void* elem, const void* key);
+
+    //! Get size of memory block needed for given number of slots.
+    //! @p n_slots should be zero or a power of two not less than MinSlots.
+    static size_t memory_size(size_t n_slots) {
+        return n_slots * LoadFactorNum / LoadFactorDen * sizeof(Entry)
+            + n_slots * sizeof(Slot) + n_slots;
+    }
+
+    //! Initialize empty table.
+    //! If @p num_preallocated_slots is non-zero, @p preallocated_data should
+    //! have memory_size(num_preallocated_slots) bytes.
+    FlatHashmapImpl(void* preallocated_data, size_t num_preallocated_slots, IArena& arena);
+
+    //! Deinitialize.
+    ~FlatHashmapImpl();
+
+    //! Get maximum number of elements that can be added before table is rebuilt.
+    size_t capacity() const;
+
+    //! Get number of elements.
+    size_t size() const;
+
+    //! Find element by key.
+    void* find(hashsum_t hash, const void* key, key_equals_callback callback) const;
+
+    //! Check if element belongs to table.
+    bool contains(hashsum_t hash, const void* elem) const;
+
+    //! Get first element.
+    void* front() const;
+
+    //! Get last element.
+    void* back() const;
+
+    //! Get element next to given one.
+    void* nextof(hashsum_t hash, const void* elem) const;
+
+    //! Get element previous to given one.
+    void* prevof(hashsum_t hash, const void* elem) const;
+
+    //! Insert element.
+    ROC_ATTR_NODISCARD bool
+    insert(void* elem, hashsum_t hash, const void* key, key_equals_callback callback);
+
+    //! Remove element.
+    void remove(hashsum_t hash, const void* elem);
+
+    //! Ensure that there is room for one more element.
+    ROC_ATTR_NODISCARD bool grow();
+
+private:
+    enum { NoSlot = (size_t)-1 };
+
+    size_t find_key_slot_(hashsum_t hash, const void* key, key_equals_callback) const;
+    size_t find_elem_slot_(hashsum_t hash, const void* elem) const;
+    size_t find_free_slot_(hashsum_t hash) const;
+
+    size_t entries_capacity_(size_t n_slots) const;
+
+    bool rebuild_(size_t n_slots);
+    void set_memory_(void* memory, size_t n_slots);
+    void reindex_();
+    void dealloc_memory_();
+
+    void* const preallocated_data_;
+    const size_t num_preallocated_slots_;
+
+    void* memory_;
+
+    Entry* entries_;
+    Slot* slots_;
+    uint8_t* ctrl_;
+
+    size_t n_slots_;
+    size_t n_entries_;
+    size_t size_;
+
+    IArena& arena_;
+};
+
+//! Compute number of slots embedded into FlatHashmap for given capacity.
+template <size_t Capacity,
+          size_t NumSlots = FlatHashmapImpl::MinSlots,
+          bool Fits = (NumSlots * FlatHashmapImpl::LoadFactorNum
+                           / FlatHashmapImpl::LoadFactorDen
+                       >= Capacity)>
+struct FlatHashmapEmbeddedSlots {
+    //! Number of slots.
+    enum { Value = FlatHashmapEmbeddedSlots<Capacity, NumSlots * 2>::Value };
+};
+
+//! Compute number of slots embedded into FlatHashmap for given capacity.
+template <size_t Capacity, size_t NumSlots>
+struct FlatHashmapEmbeddedSlots<Capacity, NumSlots, true> {
+    //! Number of slots.
+    enum { Value = Capacity == 0 ? 0 : NumSlots };
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_FLAT_HASHMAP_IMPL_H_
@@ -17,6 +17,9 @@ namespace core {
 
 namespace {
 
+// How often drainer thread checks rings in asynchronous mode.
+const nanoseconds_t DrainInterval = 5 * Millisecond;
+
 void backend_handler(const LogMessage& msg, void** args) {
     roc_panic_if(!args);
     roc_panic_if(!args[0]);
@@ -24,16 +27,33 @@ void backend_handler(const LogMessage& msg, void** args) {
     ((LogBackend*)args[0])->handle(msg);
 }
 
+// Logger singleton is never destroyed, so drainer thread, if any, is stopped
+// and joined from destructor of this object at process exit.
+struct AsyncStopper {
+    ~AsyncStopper() {
+        Logger::instance().set_async(false);
+    }
+} async_stopper;
+
 } // namespace
 
 Logger::Logger()
     : level_(LogError)
     , colors_mode_(ColorsDisabled)
-    , location_mode_(LocationDisabled) {
+    , location_mode_(LocationDisabled)
+    , async_(0)
+    , stop_drainer_(0)
+    , thread_ring_(&release_ring_)
+    , num_dropped_(0)
+    , num_reported_(0) {
     handler_ = &backend_handler;
     handler_args_[0] = &backend_;
 }
 
+Logger::~Logger() {
+    set_async(false);
+}
+
 void Logger::set_verbosity(unsigned verb) {
     switch (verb) {
     case 0:
@@ -99,12 +119,82 @@ void Logger::set_handler(LogHandler handler, void** args, size_t n_args) {
     }
 }
 
+void Logger::set_async(bool enabled) {
+    Mutex::Lock lock(async_mutex_);
+
+    if (enabled == (bool)AtomicOps::load_relaxed(async_)) {
+        return;
+    }
+
+    if (enabled) {
+        AtomicOps::store_relaxed(stop_drainer_, 0);
+
+        drainer_.reset();
+        drainer_.reset(new (drainer_) Drainer(*this));
+
+        if (!drainer_->start()) {
+            roc_log(LogError, "logger: can't start drainer thread");
+            return;
+        }
+
+        AtomicOps::store_release(async_, 1);
+    } else {
+        AtomicOps::store_release(async_, 0);
+        AtomicOps::store_release(stop_drainer_, 1);
+
+        // Drainer passes all pending records to handler before exiting.
+        drainer_->join();
+    }
+}
+
+size_t Logger::num_dropped() const {
+    return AtomicOps::load_relaxed(num_dropped_);
+}
+
 void Logger::writef(LogLevel level,
                     const char* module,
                     const char* file,
                     int line,
                     const char* format,
                     ...) {
+    // During global destruction, messages go through synchronous path, which
+    // stops using user handler (see below).
+    if (AtomicOps::load_acquire(async_) && !GlobalDestructor::is_destroying()) {
+        if (level > get_level() || level == LogNone) {
+            return;
+        }
+
+        const uint64_t tid = Thread::get_tid();
+
+        if (LogRing* ring = find_ring_(tid)) {
+            LogRecord* rec = ring->begin_write();
+            if (!rec) {
+                AtomicOps::fetch_add_relaxed(num_dropped_, 1u);
+                return;
+            }
+
+            rec->level = level;
+            rec->module = module;
+            rec->file = file;
+            rec->line = line;
+            rec->time = timestamp(ClockUnix);
+            rec->tid = tid;
+
+            va_list args;
+            va_start(args, format);
+            if (vsnprintf(rec->text, sizeof(rec->text) - 1, format, args) < 0) {
+                rec->text[0] = '\0';
+            }
+            va_end(args);
+
+            ring->end_write();
+            return;
+        }
+
+        // All rings are claimed by other running threads,
+        // fall back to synchronous mode.
+    }
+
     Mutex::Lock lock(mutex_);
 
     if (level > level_ || level == LogNone) {
@@ -143,5 +233,123 @@ void Logger::writef(LogLevel level,
     handler_(msg, handler_args_);
 }
 
+void Logger::run_drainer_() {
+    while (!AtomicOps::load_acquire(stop_drainer_)) {
+        drain_rings_();
+        sleep_for(ClockMonotonic, DrainInterval);
+    }
+
+    drain_rings_();
+}
+
+// Invoked from exiting thread that has claimed a ring.
+void Logger::release_ring_(void* ring) {
+    ((LogRing*)ring)->release();
+}
+
+LogRing* Logger::find_ring_(uint64_t tid) {
+    if (LogRing* ring = (LogRing*)thread_ring_.get()) {
+        return ring;
+    }
+
+    const size_t start = (size_t)(tid % MaxRings);
+
+    for (size_t n = 0; n < MaxRings; n++) {
+        LogRing& ring = rings_[(start + n) % MaxRings];
+
+        if (!ring.try_claim(tid)) {
+            continue;
+        }
+
+        // Remember ring, so that it's released when thread exits.
+        if (!thread_ring_.set(&ring)) {
+            ring.release();
+            return NULL;
+        }
+
+        return &ring;
+    }
+
+    return NULL;
+}
+
+void Logger::drain_rings_() {
+    Mutex::Lock lock(mutex_);
+
+    for (;;) {
+        // Pick oldest record among heads of all rings, to keep messages
+        // from different threads ordered.
+        LogRing* next_ring = NULL;
+        const LogRecord* next_rec = NULL;
+
+        for (size_t n = 0; n < MaxRings; n++) {
+            const LogRecord* rec = rings_[n].begin_read();
+            if (rec && (!next_rec || rec->time < next_rec->time)) {
+                next_ring = &rings_[n];
+                next_rec = rec;
+            }
+        }
+
+        if (!next_ring) {
+            break;
+        }
+
+        LogMessage msg;
+        msg.level = (LogLevel)next_rec->level;
+        msg.module = next_rec->module;
+        msg.file = next_rec->file;
+        msg.line = next_rec->line;
+        msg.time = next_rec->time;
+        msg.pid = Thread::get_pid();
+        msg.tid = next_rec->tid;
+        msg.text = next_rec->text;
+
+        handle_(msg);
+
+        next_ring->end_read();
+    }
+
+    report_dropped_();
+}
+
+void Logger::report_dropped_() {
+    const uint32_t num_dropped = AtomicOps::load_relaxed(num_dropped_);
+
+    if (num_dropped == num_reported_) {
+        return;
+    }
+
+    char text[64] = {};
+    snprintf(text, sizeof(text) - 1, "logger: dropped %lu messages, rings are full",
+             (unsigned long)(num_dropped - num_reported_));
+
+    num_reported_ = num_dropped;
+
+    LogMessage msg;
+    msg.level = LogInfo;
+    msg.module = ROC_STRINGIZE(ROC_MODULE);
+    msg.file = __FILE__;
+    msg.line = __LINE__;
+    msg.time = timestamp(ClockUnix);
+    msg.pid = Thread::get_pid();
+    msg.tid = Thread::get_tid();
+    msg.text = text;
+
+    handle_(msg);
+}
+
+void Logger::handle_(const LogMessage& msg) {
+    // See comment in writef().
+    if (handler_ != &backend_handler && GlobalDestructor::is_destroying()) {
+        return;
+    }
+
+    LogMessage full_msg = msg;
+    full_msg.location_mode = location_mode_;
+    full_msg.colors_mode = colors_mode_;
+
+    handler_(full_msg, handler_args_);
+}
+
 } // namespace core
 } // namespace roc
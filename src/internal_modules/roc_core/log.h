@@ -15,9 +15,14 @@
 #include "roc_core/atomic_ops.h"
 #include "roc_core/attributes.h"
 #include "roc_core/log_backend.h"
+#include "roc_core/log_ring.h"
 #include "roc_core/mutex.h"
 #include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
 #include "roc_core/singleton.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/thread.h"
+#include "roc_core/thread_local_ptr.h"
 #include "roc_core/time.h"
 
 #ifndef ROC_MODULE
@@ -145,12 +150,59 @@ public:
     //!  Other threads will see the change immediately.
     void set_handler(LogHandler handler, void** args, size_t n_args);
 
+    //! Enable or disable asynchronous mode.
+    //! @remarks
+    //!  In asynchronous mode, writef() formats message into a ring owned by
+    //!  calling thread and returns without taking locks; messages are passed
+    //!  to handler from a background thread. If the ring is full, message is
+    //!  dropped and counted. Ring is released when its thread exits; if all
+    //!  rings are claimed by other running threads, writef() falls back to
+    //!  synchronous mode.
+    //! @note
+    //!  When asynchronous mode is disabled, background thread is stopped and
+    //!  pending messages are passed to handler before returning. This is also
+    //!  done automatically at process exit.
+    void set_async(bool enabled);
+
+    //! Get number of messages dropped in asynchronous mode.
+    size_t num_dropped() const;
+
 private:
     friend class Singleton<Logger>;
 
     enum { MaxArgs = 8 };
 
+    enum { MaxRings = 16 };
+
+    // Background thread passing records from rings to handler.
+    // Threads can't be started twice, so a new one is created each time
+    // asynchronous mode is enabled.
+    class Drainer : public Thread {
+    public:
+        explicit Drainer(Logger& owner)
+            : owner_(owner) {
+        }
+
+    private:
+        virtual void run() {
+            owner_.run_drainer_();
+        }
+
+        Logger& owner_;
+    };
+
     Logger();
+    ~Logger();
+
+    void run_drainer_();
+
+    static void release_ring_(void* ring);
+
+    LogRing* find_ring_(uint64_t tid);
+    void drain_rings_();
+    void report_dropped_();
+
+    void handle_(const LogMessage& msg);
 
     int level_;
 
@@ -163,6 +215,18 @@ private:
 
     ColorsMode colors_mode_;
     LocationMode location_mode_;
+
+    Mutex async_mutex_;
+
+    int async_;
+    int stop_drainer_;
+
+    LogRing rings_[MaxRings];
+    ThreadLocalPtr thread_ring_;
+    Optional<Drainer> drainer_;
+
+    uint32_t num_dropped_;
+    uint32_t num_reported_;
 };
 
 } // namespace core
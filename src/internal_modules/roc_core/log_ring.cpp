@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/log_ring.h"
+#include "roc_core/atomic_ops.h"
+
+namespace roc {
+namespace core {
+
+LogRing::LogRing()
+    : claimed_(0)
+    , ready_(0)
+    , owner_(0)
+    , read_pos_(0)
+    , write_pos_(0) {
+}
+
+bool LogRing::is_owned_by(uint64_t tid) const {
+    if (!AtomicOps::load_acquire(ready_)) {
+        return false;
+    }
+
+    return owner_ == tid;
+}
+
+bool LogRing::try_claim(uint64_t tid) {
+    int expected = 0;
+    if (!AtomicOps::compare_exchange_acq_rel(claimed_, expected, 1)) {
+        return false;
+    }
+
+    // Owner is published via ready_, so that readers of owner_
+    // never see partially written value.
+    owner_ = tid;
+    AtomicOps::store_release(ready_, 1);
+
+    return true;
+}
+
+void LogRing::release() {
+    AtomicOps::store_release(ready_, 0);
+    owner_ = 0;
+
+    // Publishes all records written by previous owner to next owner.
+    AtomicOps::store_release(claimed_, 0);
+}
+
+LogRecord* LogRing::begin_write() {
+    const uint32_t wr_pos = AtomicOps::load_relaxed(write_pos_);
+    const uint32_t rd_pos = AtomicOps::load_acquire(read_pos_);
+
+    if (wr_pos - rd_pos >= (uint32_t)Capacity) {
+        return NULL;
+    }
+
+    return &records_[wr_pos % Capacity];
+}
+
+void LogRing::end_write() {
+    AtomicOps::fetch_add_release(write_pos_, 1u);
+}
+
+const LogRecord* LogRing::begin_read() {
+    const uint32_t rd_pos = AtomicOps::load_relaxed(read_pos_);
+    const uint32_t wr_pos = AtomicOps::load_acquire(write_pos_);
+
+    if (rd_pos == wr_pos) {
+        return NULL;
+    }
+
+    return &records_[rd_pos % Capacity];
+}
+
+void LogRing::end_read() {
+    AtomicOps::fetch_add_release(read_pos_, 1u);
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/log_ring.h
+//! @brief Per-thread ring of log records.
+
+#ifndef ROC_CORE_LOG_RING_H_
+#define ROC_CORE_LOG_RING_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace core {
+
+//! Log record.
+//! @remarks
+//!  Message text is formatted by producer, so that record doesn't
+//!  reference any data owned by producer, except string literals.
+struct LogRecord {
+    int level; //!< Logging level.
+
+    const char* module; //!< Name of module that originated message.
+    const char* file;   //!< File path.
+    int line;           //!< Line number.
+
+    nanoseconds_t time; //!< Timestamp, nanoseconds since Unix epoch.
+    uint64_t tid;       //!< Plaform-specific thread ID.
+
+    char text[256]; //!< Message text.
+};
+
+//! Per-thread ring of log records.
+//!
+//! Fixed-capacity single-producer single-consumer circular buffer.
+//! Producer is the thread that claimed the ring, consumer is the logger
+//! drainer thread. Both are never blocked. Memory is embedded into the
+//! object, so that ring can be used before any arena is available.
+//!
+//! Ring remains bound to its thread until the thread releases it, which
+//! normally happens when the thread exits. Records written before release
+//! are still delivered to consumer.
+class LogRing : public NonCopyable<> {
+public:
+    //! Number of records in ring.
+    enum { Capacity = 32 };
+
+    //! Initialize unclaimed ring.
+    LogRing();
+
+    //! Check if ring is claimed by given thread.
+    //! Lock-free.
+    bool is_owned_by(uint64_t tid) const;
+
+    //! Try to claim ring for given thread.
+    //! Returns false if ring is already claimed by another thread.
+    //! Lock-free.
+    bool try_claim(uint64_t tid);
+
+    //! Release ring claimed by calling thread.
+    //! After this call, ring may be claimed by another thread.
+    //! Lock-free.
+    void release();
+
+    //! Begin writing of a record.
+    //! If ring is full, returns NULL.
+    //! Should be called from owner thread.
+    LogRecord* begin_write();
+
+    //! End writing of a record.
+    //! Should be called if and only if begin_write() returned non-NULL.
+    void end_write();
+
+    //! Begin reading of a record.
+    //! If ring is empty, returns NULL.
+    //! Should be called from consumer thread.
+    const LogRecord* begin_read();
+
+    //! End reading of a record.
+    //! Should be called if and only if begin_read() returned non-NULL.
+    void end_read();
+
+private:
+    int claimed_;
+    int ready_;
+    uint64_t owner_;
+
+    uint32_t read_pos_;
+    uint32_t write_pos_;
+
+    LogRecord records_[Capacity];
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_LOG_RING_H_
@@ -69,5 +69,9 @@ size_t MemoryLimiter::num_acquired() {
     return bytes_acquired_;
 }
 
+size_t MemoryLimiter::max_bytes() const {
+    return max_bytes_;
+}
+
 } // namespace core
 } // namespace roc
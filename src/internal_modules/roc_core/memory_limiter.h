@@ -47,6 +47,10 @@ public:
     //! Get number of bytes currently acquired.
     size_t num_acquired();
 
+    //! Get maximum number of bytes that can be acquired.
+    //! Zero means no limit.
+    size_t max_bytes() const;
+
 private:
     const char* name_;
     const size_t max_bytes_;
@@ -126,6 +126,16 @@ public:
         return impl_.num_guard_failures();
     }
 
+    //! Get number of objects currently allocated from pool.
+    size_t num_used_slots() const {
+        return impl_.num_used_slots();
+    }
+
+    //! Get number of objects that can be allocated without growing pool.
+    size_t num_free_slots() const {
+        return impl_.num_free_slots();
+    }
+
 private:
     enum {
         SlotSize = (sizeof(SlabPoolImpl::SlotHeader) + sizeof(SlabPoolImpl::SlotCanary)
@@ -130,6 +130,18 @@ size_t SlabPoolImpl::num_guard_failures() const {
     return num_guard_failures_;
 }
 
+size_t SlabPoolImpl::num_used_slots() const {
+    Mutex::Lock lock(mutex_);
+
+    return n_used_slots_;
+}
+
+size_t SlabPoolImpl::num_free_slots() const {
+    Mutex::Lock lock(mutex_);
+
+    return free_slots_.size();
+}
+
 void* SlabPoolImpl::give_slot_to_user_(Slot* slot) {
     slot->~Slot();
 
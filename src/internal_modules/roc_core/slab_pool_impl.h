@@ -87,6 +87,12 @@ public:
     //! Get number of guard failures.
     size_t num_guard_failures() const;
 
+    //! Get number of slots currently given to users.
+    size_t num_used_slots() const;
+
+    //! Get number of slots allocated but currently not used.
+    size_t num_free_slots() const;
+
 private:
     struct Slab : ListNode<> {};
     struct Slot : ListNode<> {};
@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+#include "roc_core/pinned_arena.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+// Default huge page size on most systems that support them.
+const size_t HugePageSize = 2 * 1024 * 1024;
+
+size_t page_size() {
+    const long sz = sysconf(_SC_PAGESIZE);
+    return sz > 0 ? (size_t)sz : 4096;
+}
+
+} // namespace
+
+PinnedArena::PinnedArena(size_t size)
+    : memory_(NULL)
+    , size_(0)
+    , locked_(false)
+    , huge_(false)
+    , free_list_(NULL)
+    , num_free_bytes_(0)
+    , num_allocations_(0) {
+    if (size == 0) {
+        roc_panic("pinned arena: size should be non-zero");
+    }
+
+    if (!map_region_(size)) {
+        return;
+    }
+
+    free_list_ = (ChunkHeader*)memory_;
+    free_list_->owner = NULL;
+    free_list_->chunk_size = size_ - size_ % AlignOps::max_alignment();
+    free_list_->data_size = 0;
+    free_list_->next_free = NULL;
+
+    num_free_bytes_ = free_list_->chunk_size;
+
+    roc_log(LogDebug, "pinned arena: initialized: size=%lu locked=%d huge=%d",
+            (unsigned long)size_, (int)locked_, (int)huge_);
+}
+
+PinnedArena::~PinnedArena() {
+    if (num_allocations_ != 0) {
+        // Not a panic, see comment for HeapArena_DefaultGuards.
+        roc_log(LogError, "pinned arena: detected leak(s): %lu chunk(s) were not freed",
+                (unsigned long)num_allocations_);
+    }
+
+    unmap_region_();
+}
+
+bool PinnedArena::is_valid() const {
+    return memory_ != NULL;
+}
+
+bool PinnedArena::is_locked() const {
+    return locked_;
+}
+
+bool PinnedArena::is_huge() const {
+    return huge_;
+}
+
+size_t PinnedArena::size() const {
+    return size_;
+}
+
+size_t PinnedArena::num_free_bytes() const {
+    Mutex::Lock lock(mutex_);
+
+    return num_free_bytes_;
+}
+
+size_t PinnedArena::num_allocations() const {
+    Mutex::Lock lock(mutex_);
+
+    return num_allocations_;
+}
+
+void* PinnedArena::allocate(size_t size) {
+    const size_t chunk_size = compute_allocated_size(size);
+
+    Mutex::Lock lock(mutex_);
+
+    // First fit.
+    ChunkHeader* prev = NULL;
+    ChunkHeader* chunk = free_list_;
+
+    while (chunk && chunk->chunk_size < chunk_size) {
+        prev = chunk;
+        chunk = chunk->next_free;
+    }
+
+    if (!chunk) {
+        roc_log(LogError,
+                "pinned arena: allocation failed: chunk_size=%lu payload_size=%lu"
+                " free_bytes=%lu region_size=%lu",
+                (unsigned long)chunk_size, (unsigned long)size,
+                (unsigned long)num_free_bytes_, (unsigned long)size_);
+        return NULL;
+    }
+
+    ChunkHeader* next = chunk->next_free;
+
+    // Split chunk if remainder can hold at least a header.
+    if (chunk->chunk_size - chunk_size >= compute_allocated_size(0)) {
+        ChunkHeader* rest = (ChunkHeader*)((char*)chunk + chunk_size);
+        rest->owner = NULL;
+        rest->chunk_size = chunk->chunk_size - chunk_size;
+        rest->data_size = 0;
+        rest->next_free = next;
+
+        chunk->chunk_size = chunk_size;
+        next = rest;
+    }
+
+    if (prev) {
+        prev->next_free = next;
+    } else {
+        free_list_ = next;
+    }
+
+    chunk->owner = this;
+    chunk->data_size = size;
+    chunk->next_free = NULL;
+
+    num_free_bytes_ -= chunk->chunk_size;
+    num_allocations_++;
+
+    return chunk->data;
+}
+
+void PinnedArena::deallocate(void* ptr) {
+    ChunkHeader* chunk = chunk_from_data_(ptr);
+
+    Mutex::Lock lock(mutex_);
+
+    chunk->owner = NULL;
+    chunk->data_size = 0;
+
+    num_free_bytes_ += chunk->chunk_size;
+    num_allocations_--;
+
+    // Insert into free list, which is sorted by address.
+    ChunkHeader* prev = NULL;
+    ChunkHeader* next = free_list_;
+
+    while (next && next < chunk) {
+        prev = next;
+        next = next->next_free;
+    }
+
+    // Merge with following chunk.
+    if (next && (char*)chunk + chunk->chunk_size == (char*)next) {
+        chunk->chunk_size += next->chunk_size;
+        next = next->next_free;
+    }
+    chunk->next_free = next;
+
+    // Merge with preceding chunk.
+    if (prev && (char*)prev + prev->chunk_size == (char*)chunk) {
+        prev->chunk_size += chunk->chunk_size;
+        prev->next_free = chunk->next_free;
+    } else if (prev) {
+        prev->next_free = chunk;
+    } else {
+        free_list_ = chunk;
+    }
+}
+
+size_t PinnedArena::compute_allocated_size(size_t size) const {
+    return AlignOps::align_max(sizeof(ChunkHeader) + size);
+}
+
+size_t PinnedArena::allocated_size(void* ptr) const {
+    const ChunkHeader* chunk = chunk_from_data_(ptr);
+
+    return compute_allocated_size(chunk->data_size);
+}
+
+PinnedArena::ChunkHeader* PinnedArena::chunk_from_data_(void* ptr) const {
+    if (!ptr) {
+        roc_panic("pinned arena: null pointer");
+    }
+
+    ChunkHeader* chunk = ROC_CONTAINER_OF(ptr, ChunkHeader, data);
+
+    if ((char*)chunk < (char*)memory_ || (char*)chunk >= (char*)memory_ + size_
+        || chunk->owner != this) {
+        roc_panic("pinned arena:"
+                  " attempt to use chunk not belonging to this arena:"
+                  " this_arena=%p chunk=%p",
+                  (const void*)this, (const void*)ptr);
+    }
+
+    return chunk;
+}
+
+bool PinnedArena::map_region_(size_t size) {
+#if defined(MAP_HUGETLB)
+    {
+        const size_t huge_size = (size + HugePageSize - 1) / HugePageSize * HugePageSize;
+
+        void* memory = mmap(NULL, huge_size, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+        if (memory != MAP_FAILED) {
+            memory_ = memory;
+            size_ = huge_size;
+            huge_ = true;
+        } else {
+            roc_log(LogDebug, "pinned arena: huge pages not available: %s",
+                    errno_to_str().c_str());
+        }
+    }
+#endif // defined(MAP_HUGETLB)
+
+    if (!memory_) {
+        const size_t pg_size = page_size();
+        const size_t map_size = (size + pg_size - 1) / pg_size * pg_size;
+
+        void* memory = mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (memory == MAP_FAILED) {
+            roc_log(LogError, "pinned arena: mmap(): size=%lu: %s",
+                    (unsigned long)map_size, errno_to_str().c_str());
+            return false;
+        }
+
+        memory_ = memory;
+        size_ = map_size;
+
+#if defined(MADV_HUGEPAGE)
+        if (madvise(memory_, size_, MADV_HUGEPAGE) != 0) {
+            roc_log(LogDebug, "pinned arena: madvise(MADV_HUGEPAGE): %s",
+                    errno_to_str().c_str());
+        }
+#endif // defined(MADV_HUGEPAGE)
+    }
+
+    if (mlock(memory_, size_) == 0) {
+        locked_ = true;
+    } else {
+        roc_log(LogInfo,
+                "pinned arena: mlock(): size=%lu: %s:"
+                " memory will not be locked, consider increasing RLIMIT_MEMLOCK",
+                (unsigned long)size_, errno_to_str().c_str());
+    }
+
+    // Fault in all pages now, so that they are not faulted on realtime path.
+    memset(memory_, 0, size_);
+
+    return true;
+}
+
+void PinnedArena::unmap_region_() {
+    if (!memory_) {
+        return;
+    }
+
+    if (locked_) {
+        if (munlock(memory_, size_) != 0) {
+            roc_log(LogError, "pinned arena: munlock(): %s", errno_to_str().c_str());
+        }
+    }
+
+    if (munmap(memory_, size_) != 0) {
+        roc_panic("pinned arena: munmap(): %s", errno_to_str().c_str());
+    }
+
+    memory_ = NULL;
+}
+
+} // namespace core
+} // namespace roc
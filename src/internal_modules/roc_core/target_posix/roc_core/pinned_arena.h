@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/target_posix/roc_core/pinned_arena.h
+//! @brief Pinned memory arena.
+
+#ifndef ROC_CORE_PINNED_ARENA_H_
+#define ROC_CORE_PINNED_ARENA_H_
+
+#include "roc_core/align_ops.h"
+#include "roc_core/iarena.h"
+#include "roc_core/mutex.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Pinned memory arena.
+//!
+//! Reserves a fixed memory region up front and serves all allocations from it.
+//! Intended for pools used on realtime path, so that steady-state operation
+//! causes neither page faults nor TLB pressure.
+//!
+//! When region is created:
+//!  - first tries to map it using explicit huge pages (MAP_HUGETLB), if they
+//!    are available in the system; otherwise maps regular pages and asks kernel
+//!    to back them with transparent huge pages (MADV_HUGEPAGE)
+//!  - locks region in RAM (mlock), so that it can't be swapped out; if locking
+//!    is not permitted (e.g. because of RLIMIT_MEMLOCK), continues without it
+//!  - touches every page, so that all page faults happen during construction
+//!
+//! Region size never changes. When it's exhausted, allocate() returns NULL.
+//! Allocation uses first-fit free list, which is fine because arena clients,
+//! like SlabPool, request memory rarely and in large chunks.
+//!
+//! Allocated chunks have the following format:
+//! @code
+//!  +-------------+-----------+---------+
+//!  | ChunkHeader | user data | padding |
+//!  +-------------+-----------+---------+
+//! @endcode
+//!
+//! Thread-safe.
+class PinnedArena : public IArena, public NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  Reserves at least @p size bytes.
+    explicit PinnedArena(size_t size);
+
+    //! Deinitialize.
+    //! @remarks
+    //!  Releases region. All memory should be returned to arena.
+    ~PinnedArena();
+
+    //! Check if region was successfully reserved.
+    bool is_valid() const;
+
+    //! Check if region is locked in RAM.
+    bool is_locked() const;
+
+    //! Check if region is backed by explicit huge pages.
+    bool is_huge() const;
+
+    //! Get region size in bytes.
+    size_t size() const;
+
+    //! Get number of bytes not used by allocated chunks.
+    size_t num_free_bytes() const;
+
+    //! Get number of allocated chunks.
+    size_t num_allocations() const;
+
+    //! Allocate memory.
+    virtual void* allocate(size_t size);
+
+    //! Deallocate previously allocated memory.
+    virtual void deallocate(void* ptr);
+
+    //! Computes how many bytes will be actually allocated if allocate() is called with
+    //! given size. Covers all internal overhead, if any.
+    virtual size_t compute_allocated_size(size_t size) const;
+
+    //! Returns how many bytes was allocated for given pointer returned by allocate().
+    //! Covers all internal overhead, if any.
+    //! Returns same value as computed by compute_allocated_size(size).
+    virtual size_t allocated_size(void* ptr) const;
+
+private:
+    struct ChunkHeader {
+        // The pinned arena that the chunk belongs to.
+        // NULL if chunk is free.
+        PinnedArena* owner;
+        // Chunk size, including header.
+        size_t chunk_size;
+        // Requested size, if chunk is allocated.
+        size_t data_size;
+        // Next free chunk with higher address, if chunk is free.
+        ChunkHeader* next_free;
+        // User data.
+        AlignMax data[];
+    };
+
+    bool map_region_(size_t size);
+    void unmap_region_();
+
+    ChunkHeader* chunk_from_data_(void* ptr) const;
+
+    void* memory_;
+    size_t size_;
+    bool locked_;
+    bool huge_;
+
+    Mutex mutex_;
+
+    ChunkHeader* free_list_;
+    size_t num_free_bytes_;
+    size_t num_allocations_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_PINNED_ARENA_H_
@@ -46,6 +46,14 @@ uint64_t Thread::get_tid() {
 #endif
 }
 
+size_t Thread::get_cpu_count() {
+    const long n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n_cpus < 1) {
+        return 1;
+    }
+    return (size_t)n_cpus;
+}
+
 bool Thread::enable_realtime() {
     sched_param param;
     memset(&param, 0, sizeof(param));
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/thread_local_ptr.h"
+
+namespace roc {
+namespace core {
+
+// Logging is not used here, because logger itself relies on this class.
+ThreadLocalPtr::ThreadLocalPtr(ExitHandler handler)
+    : valid_(false) {
+    if (pthread_key_create(&key_, handler) != 0) {
+        return;
+    }
+
+    valid_ = true;
+}
+
+ThreadLocalPtr::~ThreadLocalPtr() {
+    if (valid_) {
+        pthread_key_delete(key_);
+    }
+}
+
+bool ThreadLocalPtr::is_valid() const {
+    return valid_;
+}
+
+void* ThreadLocalPtr::get() const {
+    if (!valid_) {
+        return NULL;
+    }
+
+    return pthread_getspecific(key_);
+}
+
+bool ThreadLocalPtr::set(void* ptr) {
+    if (!valid_) {
+        return false;
+    }
+
+    return pthread_setspecific(key_, ptr) == 0;
+}
+
+} // namespace core
+} // namespace roc
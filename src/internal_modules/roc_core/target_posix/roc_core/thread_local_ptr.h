@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/target_posix/roc_core/thread_local_ptr.h
+//! @brief Thread-local pointer.
+
+#ifndef ROC_CORE_THREAD_LOCAL_PTR_H_
+#define ROC_CORE_THREAD_LOCAL_PTR_H_
+
+#include <pthread.h>
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Thread-local pointer.
+//! @remarks
+//!  Each thread sees its own value, initially NULL. When a thread exits
+//!  while its value is non-NULL, exit handler is invoked with that value
+//!  from the exiting thread.
+class ThreadLocalPtr : public NonCopyable<> {
+public:
+    //! Exit handler.
+    typedef void (*ExitHandler)(void* ptr);
+
+    //! Initialize.
+    explicit ThreadLocalPtr(ExitHandler handler);
+
+    //! Deinitialize.
+    //! @remarks
+    //!  Exit handler is not invoked for values of threads still running.
+    ~ThreadLocalPtr();
+
+    //! Check if object was successfully constructed.
+    bool is_valid() const;
+
+    //! Get value for calling thread.
+    void* get() const;
+
+    //! Set value for calling thread.
+    //! Returns false on failure.
+    bool set(void* ptr);
+
+private:
+    pthread_key_t key_;
+    bool valid_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_THREAD_LOCAL_PTR_H_
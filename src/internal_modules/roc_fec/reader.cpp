@@ -43,6 +43,7 @@ Reader::Reader(const ReaderConfig& config,
     , repair_block_resized_(false)
     , payload_resized_(false)
     , n_packets_(0)
+    , n_repaired_(0)
     , max_sbn_jump_(config.max_sbn_jump)
     , fec_scheme_(fec_scheme) {
     valid_ = true;
@@ -60,6 +61,10 @@ bool Reader::is_alive() const {
     return alive_;
 }
 
+uint64_t Reader::num_repaired_packets() const {
+    return n_repaired_;
+}
+
 status::StatusCode Reader::read(packet::PacketPtr& pp) {
     roc_panic_if_not(is_valid());
 
@@ -250,6 +255,7 @@ void Reader::try_repair_() {
         }
 
         source_block_[n] = pp;
+        n_repaired_++;
     }
 
     decoder_.end();
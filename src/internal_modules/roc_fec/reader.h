@@ -66,6 +66,9 @@ public:
     //! Is decoder alive?
     bool is_alive() const;
 
+    //! Get number of source packets restored from repair packets so far.
+    uint64_t num_repaired_packets() const;
+
     //! Read packet.
     //! @remarks
     //!  When a packet loss is detected, try to restore it from repair packets.
@@ -137,6 +140,7 @@ private:
     bool payload_resized_;
 
     unsigned n_packets_;
+    uint64_t n_repaired_;
 
     const size_t max_sbn_jump_;
     const packet::FecScheme fec_scheme_;
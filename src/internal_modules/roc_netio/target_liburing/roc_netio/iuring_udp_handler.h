@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_netio/target_liburing/roc_netio/iuring_udp_handler.h
+//! @brief io_uring UDP completion handler interface.
+
+#ifndef ROC_NETIO_IURING_UDP_HANDLER_H_
+#define ROC_NETIO_IURING_UDP_HANDLER_H_
+
+#include "roc_address/socket_addr.h"
+#include "roc_core/slice.h"
+#include "roc_packet/packet.h"
+
+namespace roc {
+namespace netio {
+
+//! io_uring UDP completion handler interface.
+class IUringUdpHandler {
+public:
+    virtual ~IUringUdpHandler();
+
+    //! Handle received datagram.
+    //! @remarks
+    //!  @p data points directly into packet buffer from the pool, into which
+    //!  the kernel has written the datagram.
+    //! @note
+    //!  This method is called from the network loop thread.
+    virtual void handle_uring_received(const core::Slice<uint8_t>& data,
+                                       const address::SocketAddr& src_addr) = 0;
+
+    //! Handle permanent failure of receiving.
+    //! @remarks
+    //!  Invoked if kernel rejected receive request, so that handler can
+    //!  continue receiving using another mechanism. Sending is not affected.
+    //! @note
+    //!  This method is called from the network loop thread.
+    virtual void handle_uring_recv_failed() = 0;
+
+    //! Handle completion of sending of given packet.
+    //! @remarks
+    //!  @p err is zero on success or negative errno code on failure.
+    //! @note
+    //!  This method is called from the network loop thread.
+    virtual void handle_uring_sent(const packet::PacketPtr& packet, int err) = 0;
+
+    //! Handle completion of asynchronous closing of io_uring.
+    //! @note
+    //!  This method is called from the network loop thread.
+    virtual void handle_uring_closed() = 0;
+};
+
+} // namespace netio
+} // namespace roc
+
+#endif // ROC_NETIO_IURING_UDP_HANDLER_H_
@@ -0,0 +1,604 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "roc_netio/uring_udp_io.h"
+#include "roc_address/socket_addr_to_str.h"
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace netio {
+
+UringUdpIo::UringUdpIo(IUringUdpHandler& handler,
+                       uv_loop_t& event_loop,
+                       packet::PacketFactory& packet_factory)
+    : handler_(handler)
+    , loop_(event_loop)
+    , packet_factory_(packet_factory)
+    , sock_fd_(-1)
+    , ring_initialized_(false)
+    , event_fd_(-1)
+    , poll_initialized_(false)
+    , retry_timer_initialized_(false)
+    , buf_ring_(NULL)
+    , n_missing_buffers_(0)
+    , recv_wanted_(false)
+    , recv_armed_(false)
+    , cancel_queued_(false)
+    , pending_sends_(0)
+    , unsubmitted_(0)
+    , want_close_(false)
+    , closing_(false) {
+    memset(&recv_msg_, 0, sizeof(recv_msg_));
+}
+
+UringUdpIo::~UringUdpIo() {
+    if (poll_initialized_ || retry_timer_initialized_) {
+        roc_panic(
+            "uring udp io: io_uring was not fully closed before calling destructor");
+    }
+
+    if (pending_sends_ != 0) {
+        roc_panic("uring udp io: packets weren't fully sent before calling destructor");
+    }
+
+    release_();
+}
+
+size_t UringUdpIo::recv_header_size() {
+    return sizeof(io_uring_recvmsg_out) + sizeof(sockaddr_storage);
+}
+
+bool UringUdpIo::is_open() const {
+    return poll_initialized_ || retry_timer_initialized_;
+}
+
+bool UringUdpIo::open(int sock_fd, const address::SocketAddr& bind_address) {
+    roc_panic_if_msg(ring_initialized_, "uring udp io: can't call open() twice");
+
+    sock_fd_ = sock_fd;
+    bind_address_ = bind_address;
+
+    if (int err = io_uring_queue_init(RingSize, &ring_, 0)) {
+        roc_log(LogDebug, "uring udp io: io_uring_queue_init(): %s",
+                core::errno_to_str(-err).c_str());
+        return false;
+    }
+    ring_initialized_ = true;
+
+    io_uring_probe* probe = io_uring_get_probe_ring(&ring_);
+    if (!probe) {
+        roc_log(LogDebug, "uring udp io: io_uring_get_probe_ring() failed");
+        release_();
+        return false;
+    }
+
+    // Probe can't tell whether multishot recvmsg and sendto are supported, since
+    // they're flavors of existing opcodes. Both appeared in Linux 6.0 together
+    // with IORING_OP_SEND_ZC, so we use the latter as a marker. Without this
+    // check, older kernels would accept the ring and then fail every request.
+    const bool has_ops = io_uring_opcode_supported(probe, IORING_OP_RECVMSG)
+        && io_uring_opcode_supported(probe, IORING_OP_SEND)
+        && io_uring_opcode_supported(probe, IORING_OP_ASYNC_CANCEL)
+        && io_uring_opcode_supported(probe, IORING_OP_SEND_ZC);
+
+    io_uring_free_probe(probe);
+
+    if (!has_ops) {
+        roc_log(LogDebug, "uring udp io: required io_uring operations not supported");
+        release_();
+        return false;
+    }
+
+    // Provided buffer ring is set up here rather than in start_recv(), so that
+    // lack of support for it makes the whole port fall back to libuv.
+    int err = 0;
+    buf_ring_ =
+        io_uring_setup_buf_ring(&ring_, RecvBufferCount, RecvBufferGroup, 0, &err);
+    if (!buf_ring_) {
+        roc_log(LogDebug, "uring udp io: io_uring_setup_buf_ring(): %s",
+                core::errno_to_str(-err).c_str());
+        release_();
+        return false;
+    }
+
+    if ((event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) < 0) {
+        roc_log(LogError, "uring udp io: eventfd(): %s", core::errno_to_str().c_str());
+        release_();
+        return false;
+    }
+
+    if (int err = io_uring_register_eventfd(&ring_, event_fd_)) {
+        roc_log(LogDebug, "uring udp io: io_uring_register_eventfd(): %s",
+                core::errno_to_str(-err).c_str());
+        release_();
+        return false;
+    }
+
+    if (int err = uv_poll_init(&loop_, &poll_, event_fd_)) {
+        roc_log(LogError, "uring udp io: uv_poll_init(): [%s] %s", uv_err_name(err),
+                uv_strerror(err));
+        release_();
+        return false;
+    }
+
+    poll_.data = this;
+    poll_initialized_ = true;
+
+    if (int err = uv_poll_start(&poll_, UV_READABLE, poll_cb_)) {
+        roc_panic("uring udp io: uv_poll_start(): [%s] %s", uv_err_name(err),
+                  uv_strerror(err));
+    }
+
+    if (int err = uv_timer_init(&loop_, &retry_timer_)) {
+        roc_panic("uring udp io: uv_timer_init(): [%s] %s", uv_err_name(err),
+                  uv_strerror(err));
+    }
+
+    retry_timer_.data = this;
+    retry_timer_initialized_ = true;
+
+    roc_log(LogDebug, "uring udp io: initialized io_uring: bind=%s ring_size=%d",
+            address::socket_addr_to_str(bind_address_).c_str(), (int)RingSize);
+
+    return true;
+}
+
+bool UringUdpIo::start_recv() {
+    roc_panic_if_msg(!is_open(), "uring udp io: can't start receiving on closed io");
+
+    if (recv_wanted_) {
+        return true;
+    }
+
+    n_missing_buffers_ = RecvBufferCount;
+    refill_buffers_();
+
+    if (n_missing_buffers_ == RecvBufferCount) {
+        roc_log(LogError, "uring udp io: can't allocate receive buffers");
+        return false;
+    }
+
+    // Kernel writes io_uring_recvmsg_out header and source address into the
+    // beginning of each provided buffer, followed by the datagram payload.
+    // Must match recv_header_size().
+    recv_msg_.msg_namelen = sizeof(sockaddr_storage);
+    recv_msg_.msg_controllen = 0;
+
+    recv_wanted_ = true;
+
+    if (!arm_recv_()) {
+        recv_wanted_ = false;
+        return false;
+    }
+
+    flush();
+
+    roc_log(LogDebug, "uring udp io: started multishot receive: bind=%s n_buffers=%d",
+            address::socket_addr_to_str(bind_address_).c_str(),
+            (int)(RecvBufferCount - n_missing_buffers_));
+
+    return true;
+}
+
+bool UringUdpIo::enqueue_send(const packet::PacketPtr& pp) {
+    roc_panic_if_msg(!is_open(), "uring udp io: can't send on closed io");
+
+    io_uring_sqe* sqe = get_sqe_();
+    if (!sqe) {
+        return false;
+    }
+
+    const packet::UDP& udp = *pp->udp();
+
+    io_uring_prep_sendto(sqe, sock_fd_, pp->buffer().data(), pp->buffer().size(), 0,
+                         udp.dst_addr.saddr(), (socklen_t)udp.dst_addr.slen());
+    io_uring_sqe_set_data64(sqe, (uint64_t)(uintptr_t)pp.get());
+
+    // will be decremented in handle_send_completion_()
+    pp->incref();
+
+    pending_sends_++;
+    unsubmitted_++;
+
+    return true;
+}
+
+void UringUdpIo::flush() {
+    if (!ring_initialized_) {
+        return;
+    }
+
+    (void)submit_();
+}
+
+void UringUdpIo::async_close() {
+    if (want_close_) {
+        return;
+    }
+
+    want_close_ = true;
+
+    continue_closing_();
+}
+
+void UringUdpIo::poll_cb_(uv_poll_t* handle, int status, int events) {
+    roc_panic_if_not(handle);
+
+    UringUdpIo& self = *(UringUdpIo*)handle->data;
+
+    if (status < 0) {
+        roc_log(LogError, "uring udp io: poll error: [%s] %s", uv_err_name(status),
+                uv_strerror(status));
+        return;
+    }
+
+    // Reset eventfd counter. It doesn't matter how many times it was signaled,
+    // we process all available completions anyway.
+    uint64_t counter = 0;
+    if (read(self.event_fd_, &counter, sizeof(counter)) < 0 && errno != EAGAIN) {
+        roc_log(LogError, "uring udp io: read(): %s", core::errno_to_str().c_str());
+    }
+
+    self.process_completions_();
+}
+
+void UringUdpIo::retry_cb_(uv_timer_t* handle) {
+    roc_panic_if_not(handle);
+
+    UringUdpIo& self = *(UringUdpIo*)handle->data;
+
+    self.process_completions_();
+}
+
+void UringUdpIo::close_cb_(uv_handle_t* handle) {
+    roc_panic_if_not(handle);
+
+    UringUdpIo& self = *(UringUdpIo*)handle->data;
+
+    if (handle == (uv_handle_t*)&self.poll_) {
+        self.poll_initialized_ = false;
+    } else {
+        self.retry_timer_initialized_ = false;
+    }
+
+    if (self.poll_initialized_ || self.retry_timer_initialized_) {
+        return;
+    }
+
+    self.release_();
+
+    roc_log(LogDebug, "uring udp io: closed io_uring: bind=%s",
+            address::socket_addr_to_str(self.bind_address_).c_str());
+
+    self.handler_.handle_uring_closed();
+}
+
+void UringUdpIo::process_completions_() {
+    unsigned head = 0;
+    unsigned n_cqes = 0;
+    io_uring_cqe* cqe = NULL;
+
+    // Completions are read directly from shared memory, without syscalls.
+    io_uring_for_each_cqe(&ring_, head, cqe) {
+        const uint64_t user_data = io_uring_cqe_get_data64(cqe);
+
+        if (user_data == UserData_Recv) {
+            handle_recv_completion_(*cqe);
+        } else if (user_data == UserData_Cancel) {
+            // nothing to do
+        } else {
+            handle_send_completion_(*cqe);
+        }
+
+        n_cqes++;
+    }
+
+    io_uring_cq_advance(&ring_, n_cqes);
+
+    if (want_close_) {
+        continue_closing_();
+        return;
+    }
+
+    resume_recv_();
+}
+
+void UringUdpIo::handle_recv_completion_(const io_uring_cqe& cqe) {
+    if (!(cqe.flags & IORING_CQE_F_MORE)) {
+        recv_armed_ = false;
+    }
+
+    if (cqe.res < 0) {
+        if (cqe.res != -ECANCELED && cqe.res != -ENOBUFS) {
+            roc_log(LogError, "uring udp io: recvmsg failed: bind=%s: %s",
+                    address::socket_addr_to_str(bind_address_).c_str(),
+                    core::errno_to_str(-cqe.res).c_str());
+            if (!recv_armed_ && recv_wanted_ && !want_close_) {
+                // don't re-arm request that is going to fail again,
+                // instead let handler switch to another I/O mechanism
+                recv_wanted_ = false;
+                handler_.handle_uring_recv_failed();
+            }
+        }
+        return;
+    }
+
+    if (!(cqe.flags & IORING_CQE_F_BUFFER)) {
+        roc_panic("uring udp io: recvmsg completion without buffer");
+    }
+
+    const unsigned short buf_id = (unsigned short)(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+    roc_panic_if_not(buf_id < RecvBufferCount);
+
+    // Take ownership of the buffer back from the kernel.
+    core::BufferPtr bp = recv_buffers_[buf_id];
+    recv_buffers_[buf_id] = NULL;
+    n_missing_buffers_++;
+
+    roc_panic_if_not(bp);
+
+    io_uring_recvmsg_out* out =
+        io_uring_recvmsg_validate(bp->data(), cqe.res, &recv_msg_);
+    if (!out) {
+        roc_log(LogError, "uring udp io: invalid recvmsg output: bind=%s res=%d",
+                address::socket_addr_to_str(bind_address_).c_str(), (int)cqe.res);
+        return;
+    }
+
+    if (out->flags & MSG_TRUNC) {
+        roc_log(LogDebug, "uring udp io: ignoring truncated datagram: bind=%s",
+                address::socket_addr_to_str(bind_address_).c_str());
+        return;
+    }
+
+    const size_t payload_size =
+        io_uring_recvmsg_payload_length(out, cqe.res, &recv_msg_);
+    if (payload_size == 0) {
+        roc_log(LogTrace, "uring udp io: ignoring empty datagram: bind=%s",
+                address::socket_addr_to_str(bind_address_).c_str());
+        return;
+    }
+
+    address::SocketAddr src_addr;
+    if (out->namelen == 0
+        || !src_addr.set_host_port_saddr((const sockaddr*)io_uring_recvmsg_name(out))) {
+        roc_log(LogError, "uring udp io: can't determine source address: bind=%s",
+                address::socket_addr_to_str(bind_address_).c_str());
+        return;
+    }
+
+    const size_t payload_off =
+        (size_t)((uint8_t*)io_uring_recvmsg_payload(out, &recv_msg_) - bp->data());
+
+    if (payload_off + payload_size > bp->size()) {
+        roc_panic("uring udp io: unexpected payload size: got %lu, max %lu",
+                  (unsigned long)(payload_off + payload_size), (unsigned long)bp->size());
+    }
+
+    handler_.handle_uring_received(
+        core::Slice<uint8_t>(*bp, payload_off, payload_off + payload_size), src_addr);
+}
+
+void UringUdpIo::handle_send_completion_(const io_uring_cqe& cqe) {
+    packet::PacketPtr pp = (packet::Packet*)(uintptr_t)io_uring_cqe_get_data64(&cqe);
+
+    // one reference for incref() called from enqueue_send()
+    // one reference for the shared pointer above
+    roc_panic_if(pp->getref() < 2);
+
+    // decrement reference counter incremented in enqueue_send()
+    pp->decref();
+
+    roc_panic_if_not(pending_sends_ > 0);
+    pending_sends_--;
+
+    handler_.handle_uring_sent(pp, cqe.res < 0 ? cqe.res : 0);
+}
+
+void UringUdpIo::resume_recv_() {
+    if (n_missing_buffers_ != 0) {
+        refill_buffers_();
+    }
+
+    if (recv_wanted_ && !recv_armed_) {
+        // Multishot request was terminated, e.g. because we've run out of
+        // provided buffers. Re-arm it now, when buffers are refilled.
+        // If pool is still exhausted or submission queue is full, there
+        // may be no more completions to wake us up, so use timer.
+        if (n_missing_buffers_ == RecvBufferCount || !arm_recv_()) {
+            schedule_retry_();
+        }
+    }
+
+    if (!submit_()) {
+        schedule_retry_();
+    }
+}
+
+bool UringUdpIo::arm_recv_() {
+    io_uring_sqe* sqe = get_sqe_();
+    if (!sqe) {
+        return false;
+    }
+
+    io_uring_prep_recvmsg_multishot(sqe, sock_fd_, &recv_msg_, 0);
+    io_uring_sqe_set_data64(sqe, UserData_Recv);
+
+    sqe->flags |= IOSQE_BUFFER_SELECT;
+    sqe->buf_group = RecvBufferGroup;
+
+    unsubmitted_++;
+    recv_armed_ = true;
+
+    return true;
+}
+
+void UringUdpIo::refill_buffers_() {
+    const int mask = io_uring_buf_ring_mask(RecvBufferCount);
+    int n_added = 0;
+
+    for (unsigned short buf_id = 0; buf_id < RecvBufferCount; buf_id++) {
+        if (recv_buffers_[buf_id]) {
+            continue;
+        }
+
+        core::BufferPtr bp = packet_factory_.new_packet_buffer();
+        if (!bp) {
+            roc_log(LogError, "uring udp io: can't allocate buffer");
+            break;
+        }
+
+        if (bp->size() <= recv_header_size()) {
+            roc_panic("uring udp io: buffer too small for recvmsg header:"
+                      " buffer_size=%lu header_size=%lu",
+                      (unsigned long)bp->size(), (unsigned long)recv_header_size());
+        }
+
+        io_uring_buf_ring_add(buf_ring_, bp->data(), (unsigned)bp->size(), buf_id, mask,
+                              n_added);
+
+        recv_buffers_[buf_id] = bp;
+        n_added++;
+    }
+
+    if (n_added != 0) {
+        // Publish all added buffers to the kernel at once.
+        io_uring_buf_ring_advance(buf_ring_, n_added);
+        n_missing_buffers_ -= (size_t)n_added;
+    }
+}
+
+void UringUdpIo::cancel_recv_() {
+    if (!recv_armed_ || cancel_queued_) {
+        return;
+    }
+
+    io_uring_sqe* sqe = get_sqe_();
+    if (!sqe) {
+        // Without cancellation, closing would never finish, so try later.
+        schedule_retry_();
+        return;
+    }
+
+    io_uring_prep_cancel64(sqe, UserData_Recv, 0);
+    io_uring_sqe_set_data64(sqe, UserData_Cancel);
+
+    unsubmitted_++;
+    cancel_queued_ = true;
+}
+
+void UringUdpIo::continue_closing_() {
+    cancel_recv_();
+
+    if (!submit_()) {
+        schedule_retry_();
+    }
+
+    try_finish_closing_();
+}
+
+void UringUdpIo::schedule_retry_() {
+    if (!retry_timer_initialized_ || closing_
+        || uv_is_active((uv_handle_t*)&retry_timer_)) {
+        return;
+    }
+
+    if (int err = uv_timer_start(&retry_timer_, retry_cb_, RetryIntervalMs, 0)) {
+        roc_log(LogError, "uring udp io: uv_timer_start(): [%s] %s", uv_err_name(err),
+                uv_strerror(err));
+    }
+}
+
+io_uring_sqe* UringUdpIo::get_sqe_() {
+    io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+
+    if (!sqe) {
+        // Submission queue is full, submit what we have and retry.
+        if (submit_()) {
+            sqe = io_uring_get_sqe(&ring_);
+        }
+    }
+
+    if (!sqe) {
+        roc_log(LogError, "uring udp io: submission queue is full");
+    }
+
+    return sqe;
+}
+
+bool UringUdpIo::submit_() {
+    if (unsubmitted_ == 0) {
+        return true;
+    }
+
+    const int ret = io_uring_submit(&ring_);
+    if (ret < 0) {
+        roc_log(LogError, "uring udp io: io_uring_submit(): %s",
+                core::errno_to_str(-ret).c_str());
+        return false;
+    }
+
+    unsubmitted_ = 0;
+    return true;
+}
+
+void UringUdpIo::try_finish_closing_() {
+    if (!want_close_ || closing_) {
+        return;
+    }
+
+    if (recv_armed_ || pending_sends_ != 0) {
+        // wait for in-flight requests
+        return;
+    }
+
+    closing_ = true;
+
+    if (retry_timer_initialized_ && !uv_is_closing((uv_handle_t*)&retry_timer_)) {
+        uv_timer_stop(&retry_timer_);
+        uv_close((uv_handle_t*)&retry_timer_, close_cb_);
+    }
+
+    if (poll_initialized_ && !uv_is_closing((uv_handle_t*)&poll_)) {
+        uv_poll_stop(&poll_);
+        uv_close((uv_handle_t*)&poll_, close_cb_);
+    }
+}
+
+void UringUdpIo::release_() {
+    if (buf_ring_) {
+        io_uring_free_buf_ring(&ring_, buf_ring_, RecvBufferCount, RecvBufferGroup);
+        buf_ring_ = NULL;
+    }
+
+    for (size_t n = 0; n < RecvBufferCount; n++) {
+        recv_buffers_[n] = NULL;
+    }
+
+    if (ring_initialized_) {
+        io_uring_queue_exit(&ring_);
+        ring_initialized_ = false;
+    }
+
+    if (event_fd_ >= 0) {
+        if (close(event_fd_) != 0) {
+            roc_log(LogError, "uring udp io: close(): %s", core::errno_to_str().c_str());
+        }
+        event_fd_ = -1;
+    }
+}
+
+} // namespace netio
+} // namespace roc
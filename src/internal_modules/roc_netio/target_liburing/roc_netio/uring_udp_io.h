@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_netio/target_liburing/roc_netio/uring_udp_io.h
+//! @brief io_uring-based UDP datagram I/O.
+
+#ifndef ROC_NETIO_URING_UDP_IO_H_
+#define ROC_NETIO_URING_UDP_IO_H_
+
+#include <liburing.h>
+#include <sys/socket.h>
+#include <uv.h>
+
+#include "roc_core/buffer.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_netio/iuring_udp_handler.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace netio {
+
+//! io_uring-based UDP datagram I/O.
+//!
+//! Performs sending and receiving of datagrams for a socket owned by UdpPort
+//! using io_uring instead of libuv:
+//!
+//!  - receiving is done using a single multishot recvmsg request; kernel writes
+//!    datagrams directly into packet buffers from the pool, which are handed to
+//!    the kernel via provided buffer ring; every consumed buffer is immediately
+//!    replaced with a new one from the pool; each buffer starts with a header of
+//!    recv_header_size() bytes, followed by the datagram payload
+//!
+//!  - sending is done using sendto requests, which are accumulated and then
+//!    submitted in a batch by a single io_uring_enter() call
+//!
+//! Completion queue is attached to an eventfd, which is polled by the libuv
+//! event loop, so all completions are processed on the network loop thread,
+//! the same way as libuv callbacks.
+//!
+//! If packet pool is exhausted or submission queue is full, receiving and
+//! closing are retried from a libuv timer. If receiving fails permanently,
+//! handler is notified, so that it can switch to libuv I/O.
+class UringUdpIo : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  Buffers allocated from @p packet_factory are used for receiving, and
+    //!  should be recv_header_size() bytes larger than maximum datagram size.
+    UringUdpIo(IUringUdpHandler& handler,
+               uv_loop_t& event_loop,
+               packet::PacketFactory& packet_factory);
+
+    //! Destroy.
+    ~UringUdpIo();
+
+    //! Get number of bytes that kernel writes to receive buffer before payload.
+    //! @remarks
+    //!  Includes io_uring_recvmsg_out header and space for source address.
+    static size_t recv_header_size();
+
+    //! Check if io_uring is set up and can be used.
+    bool is_open() const;
+
+    //! Set up io_uring for given socket.
+    //! @remarks
+    //!  Returns false if io_uring can't be used, e.g. if running kernel doesn't
+    //!  support features we need (multishot recvmsg with provided buffer ring,
+    //!  and sendto, which appeared in Linux 6.0). In this case caller should
+    //!  fall back to libuv I/O.
+    bool open(int sock_fd, const address::SocketAddr& bind_address);
+
+    //! Start receiving datagrams.
+    //! @remarks
+    //!  Received datagrams are passed to IUringUdpHandler::handle_uring_received().
+    //!  If receiving fails later, IUringUdpHandler::handle_uring_recv_failed()
+    //!  is invoked.
+    bool start_recv();
+
+    //! Enqueue packet for sending.
+    //! @remarks
+    //!  Request is not submitted until flush() is called, or submission queue
+    //!  becomes full. Completion is reported via IUringUdpHandler::handle_uring_sent().
+    bool enqueue_send(const packet::PacketPtr& packet);
+
+    //! Submit all enqueued requests.
+    void flush();
+
+    //! Initiate asynchronous close.
+    //! @remarks
+    //!  Cancels receiving, waits until all in-flight requests are completed,
+    //!  and then invokes IUringUdpHandler::handle_uring_closed().
+    void async_close();
+
+private:
+    enum {
+        // Number of submission queue entries.
+        RingSize = 256,
+
+        // Number of pool buffers provided to kernel for receiving.
+        RecvBufferCount = 64,
+
+        // Provided buffer group ID.
+        RecvBufferGroup = 0,
+
+        // Delay before retrying operation that failed because of lack of
+        // resources, in milliseconds.
+        RetryIntervalMs = 5
+    };
+
+    // Special user_data values; other values are packet pointers.
+    enum {
+        UserData_Recv = 1,
+        UserData_Cancel = 2
+    };
+
+    static void poll_cb_(uv_poll_t* handle, int status, int events);
+    static void retry_cb_(uv_timer_t* handle);
+    static void close_cb_(uv_handle_t* handle);
+
+    void process_completions_();
+    void handle_recv_completion_(const io_uring_cqe& cqe);
+    void handle_send_completion_(const io_uring_cqe& cqe);
+
+    void resume_recv_();
+    bool arm_recv_();
+    void refill_buffers_();
+
+    void cancel_recv_();
+    void continue_closing_();
+    void schedule_retry_();
+
+    io_uring_sqe* get_sqe_();
+    bool submit_();
+
+    void try_finish_closing_();
+    void release_();
+
+    IUringUdpHandler& handler_;
+    uv_loop_t& loop_;
+    packet::PacketFactory& packet_factory_;
+
+    int sock_fd_;
+    address::SocketAddr bind_address_;
+
+    io_uring ring_;
+    bool ring_initialized_;
+
+    int event_fd_;
+
+    uv_poll_t poll_;
+    bool poll_initialized_;
+
+    uv_timer_t retry_timer_;
+    bool retry_timer_initialized_;
+
+    io_uring_buf_ring* buf_ring_;
+    core::BufferPtr recv_buffers_[RecvBufferCount];
+    size_t n_missing_buffers_;
+
+    msghdr recv_msg_;
+
+    bool recv_wanted_;
+    bool recv_armed_;
+    bool cancel_queued_;
+
+    size_t pending_sends_;
+    size_t unsubmitted_;
+
+    bool want_close_;
+    bool closing_;
+};
+
+} // namespace netio
+} // namespace roc
+
+#endif // ROC_NETIO_URING_UDP_IO_H_
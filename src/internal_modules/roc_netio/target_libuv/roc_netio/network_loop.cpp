@@ -107,6 +107,12 @@ NetworkLoop::NetworkLoop(core::IPool& packet_pool,
                          core::IArena& arena)
     : packet_factory_(packet_pool, buffer_pool)
     , arena_(arena)
+#ifdef ROC_TARGET_LIBURING
+    , uring_buffer_pool_("uring_buffer_pool",
+                         arena,
+                         buffer_pool.object_size() + UringUdpIo::recv_header_size())
+    , uring_packet_factory_(packet_pool, uring_buffer_pool_)
+#endif // ROC_TARGET_LIBURING
     , started_(false)
     , loop_initialized_(false)
     , stop_sem_initialized_(false)
@@ -385,8 +391,14 @@ void NetworkLoop::close_all_sems_() {
 void NetworkLoop::task_add_udp_port_(NetworkTask& base_task) {
     Tasks::AddUdpPort& task = (Tasks::AddUdpPort&)base_task;
 
+#ifdef ROC_TARGET_LIBURING
+    packet::PacketFactory& port_packet_factory = uring_packet_factory_;
+#else
+    packet::PacketFactory& port_packet_factory = packet_factory_;
+#endif // ROC_TARGET_LIBURING
+
     core::SharedPtr<UdpPort> port =
-        new (arena_) UdpPort(*task.config_, loop_, packet_factory_, arena_);
+        new (arena_) UdpPort(*task.config_, loop_, port_packet_factory, arena_);
     if (!port) {
         roc_log(LogError, "network loop: can't add udp port %s: allocate failed",
                 address::socket_addr_to_str(task.config_->bind_address).c_str());
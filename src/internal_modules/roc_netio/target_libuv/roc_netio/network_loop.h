@@ -24,6 +24,7 @@
 #include "roc_core/mpsc_queue_node.h"
 #include "roc_core/optional.h"
 #include "roc_core/semaphore.h"
+#include "roc_core/slab_pool.h"
 #include "roc_core/thread.h"
 #include "roc_netio/basic_port.h"
 #include "roc_netio/iclose_handler.h"
@@ -250,6 +251,13 @@ private:
     packet::PacketFactory packet_factory_;
     core::IArena& arena_;
 
+#ifdef ROC_TARGET_LIBURING
+    // Same as packet buffers, but with extra room for header that io_uring
+    // writes before received datagram. Used for receiving by UDP ports.
+    core::SlabPool<core::Buffer> uring_buffer_pool_;
+    packet::PacketFactory uring_packet_factory_;
+#endif // ROC_TARGET_LIBURING
+
     bool started_;
 
     uv_loop_t loop_;
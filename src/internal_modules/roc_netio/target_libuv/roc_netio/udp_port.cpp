@@ -6,8 +6,11 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 
+#include <errno.h>
+
 #include "roc_netio/udp_port.h"
 #include "roc_address/socket_addr_to_str.h"
+#include "roc_core/errno_to_str.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_core/shared_ptr.h"
@@ -42,6 +45,10 @@ UdpPort::UdpPort(const UdpConfig& config,
     , closed_(false)
     , fd_()
     , packet_factory_(packet_factory)
+#ifdef ROC_TARGET_LIBURING
+    , uring_io_(*this, event_loop, packet_factory)
+    , uring_send_(false)
+#endif // ROC_TARGET_LIBURING
     , inbound_writer_(NULL)
     , rate_limiter_(PacketLogInterval) {
     BasicPort::update_descriptor();
@@ -124,6 +131,15 @@ bool UdpPort::open() {
 
     update_descriptor();
 
+#ifdef ROC_TARGET_LIBURING
+    if (uring_io_.open(fd_, config_.bind_address)) {
+        uring_send_ = true;
+    } else {
+        roc_log(LogDebug, "udp port: %s: io_uring not available, using libuv I/O",
+                descriptor());
+    }
+#endif // ROC_TARGET_LIBURING
+
     roc_log(LogDebug, "udp port: %s: opened port", descriptor());
 
     return true;
@@ -180,6 +196,18 @@ bool UdpPort::start_recv(packet::IWriter& inbound_writer) {
         }
     }
 
+#ifdef ROC_TARGET_LIBURING
+    if (!recv_started_ && uring_io_.is_open()) {
+        if (uring_io_.start_recv()) {
+            recv_started_ = true;
+        } else {
+            roc_log(LogDebug,
+                    "udp port: %s: can't receive via io_uring, using libuv I/O",
+                    descriptor());
+        }
+    }
+#endif // ROC_TARGET_LIBURING
+
     if (!recv_started_) {
         if (int err = uv_udp_recv_start(&handle_, alloc_cb_, recv_cb_)) {
             roc_log(LogError, "udp port: %s: uv_udp_recv_start(): [%s] %s", descriptor(),
@@ -309,39 +337,12 @@ void UdpPort::recv_cb_(uv_udp_t* handle,
         return;
     }
 
-    self.received_packets_++;
-
-    roc_log(LogTrace, "udp port: %s: received packet: num=%d src=%s dst=%s nread=%ld",
-            self.descriptor(), (int)self.received_packets_,
-            address::socket_addr_to_str(src_addr).c_str(),
-            address::socket_addr_to_str(self.config_.bind_address).c_str(), (long)nread);
-
     if ((size_t)nread > bp->size()) {
         roc_panic("udp port: %s: unexpected buffer size: got %ld, max %ld",
                   self.descriptor(), (long)nread, (long)bp->size());
     }
 
-    packet::PacketPtr pp = self.packet_factory_.new_packet();
-    if (!pp) {
-        roc_log(LogError, "udp port: %s: can't allocate packet", self.descriptor());
-        return;
-    }
-
-    pp->add_flags(packet::Packet::FlagUDP);
-
-    pp->udp()->src_addr = src_addr;
-    pp->udp()->dst_addr = self.config_.bind_address;
-    pp->udp()->receive_timestamp = core::timestamp(core::ClockUnix);
-
-    pp->set_buffer(core::Slice<uint8_t>(*bp, 0, (size_t)nread));
-
-    if (self.inbound_writer_) {
-        const status::StatusCode code = self.inbound_writer_->write(pp);
-        if (code != status::StatusOK) {
-            roc_panic("udp port: %s: can't writer packet: status=%s", self.descriptor(),
-                      status::code_to_str(code));
-        }
-    }
+    self.deliver_packet_(core::Slice<uint8_t>(*bp, 0, (size_t)nread), src_addr);
 }
 
 void UdpPort::write_sem_cb_(uv_async_t* handle) {
@@ -366,6 +367,19 @@ void UdpPort::write_sem_cb_(uv_async_t* handle) {
                 address::socket_addr_to_str(udp.dst_addr).c_str(),
                 (long)pp->buffer().size());
 
+#ifdef ROC_TARGET_LIBURING
+        if (self.uring_io_.is_open()) {
+            // Will be submitted in a batch by flush() below.
+            // Completion is reported via handle_uring_sent().
+            if (!self.uring_io_.enqueue_send(pp)) {
+                roc_log(LogError, "udp port: %s: can't enqueue packet to io_uring",
+                        self.descriptor());
+                self.handle_uring_sent(pp, -EAGAIN);
+            }
+            continue;
+        }
+#endif // ROC_TARGET_LIBURING
+
         uv_buf_t buf;
         buf.base = (char*)pp->buffer().data();
         buf.len = pp->buffer().size();
@@ -382,6 +396,13 @@ void UdpPort::write_sem_cb_(uv_async_t* handle) {
         // will be decremented in send_cb_()
         pp->incref();
     }
+
+#ifdef ROC_TARGET_LIBURING
+    if (self.uring_io_.is_open()) {
+        // Submit all packets popped from the queue using single syscall.
+        self.uring_io_.flush();
+    }
+#endif // ROC_TARGET_LIBURING
 }
 
 void UdpPort::send_cb_(uv_udp_send_t* req, int status) {
@@ -442,7 +463,16 @@ status::StatusCode UdpPort::write(const packet::PacketPtr& pp) {
 
 void UdpPort::write_(const packet::PacketPtr& pp) {
     const bool had_pending = (++pending_packets_ > 1);
-    if (!had_pending) {
+
+#ifdef ROC_TARGET_LIBURING
+    // io_uring is used only from network thread, so all packets go through
+    // the queue and are submitted in a batch from write_sem_cb_().
+    const bool try_direct = !uring_send_;
+#else
+    const bool try_direct = true;
+#endif // ROC_TARGET_LIBURING
+
+    if (!had_pending && try_direct) {
         if (try_nonblocking_write_(pp)) {
             --pending_packets_;
             return;
@@ -479,7 +509,90 @@ bool UdpPort::try_nonblocking_write_(const packet::PacketPtr& pp) {
     return success;
 }
 
+void UdpPort::deliver_packet_(const core::Slice<uint8_t>& buf,
+                              const address::SocketAddr& src_addr) {
+    received_packets_++;
+
+    roc_log(LogTrace, "udp port: %s: received packet: num=%d src=%s dst=%s nread=%ld",
+            descriptor(), (int)received_packets_,
+            address::socket_addr_to_str(src_addr).c_str(),
+            address::socket_addr_to_str(config_.bind_address).c_str(),
+            (long)buf.size());
+
+    packet::PacketPtr pp = packet_factory_.new_packet();
+    if (!pp) {
+        roc_log(LogError, "udp port: %s: can't allocate packet", descriptor());
+        return;
+    }
+
+    pp->add_flags(packet::Packet::FlagUDP);
+
+    pp->udp()->src_addr = src_addr;
+    pp->udp()->dst_addr = config_.bind_address;
+    pp->udp()->receive_timestamp = core::timestamp(core::ClockUnix);
+
+    pp->set_buffer(buf);
+
+    if (inbound_writer_) {
+        const status::StatusCode code = inbound_writer_->write(pp);
+        if (code != status::StatusOK) {
+            roc_panic("udp port: %s: can't writer packet: status=%s", descriptor(),
+                      status::code_to_str(code));
+        }
+    }
+}
+
+#ifdef ROC_TARGET_LIBURING
+
+void UdpPort::handle_uring_received(const core::Slice<uint8_t>& data,
+                                    const address::SocketAddr& src_addr) {
+    deliver_packet_(data, src_addr);
+}
+
+void UdpPort::handle_uring_recv_failed() {
+    roc_log(LogInfo,
+            "udp port: %s: receiving via io_uring failed, switching to libuv I/O",
+            descriptor());
+
+    if (int err = uv_udp_recv_start(&handle_, alloc_cb_, recv_cb_)) {
+        roc_log(LogError, "udp port: %s: uv_udp_recv_start(): [%s] %s", descriptor(),
+                uv_err_name(err), uv_strerror(err));
+    }
+}
+
+void UdpPort::handle_uring_sent(const packet::PacketPtr& pp, int err) {
+    if (err < 0) {
+        roc_log(LogError,
+                "udp port: %s:"
+                " can't send packet: src=%s dst=%s sz=%ld: %s",
+                descriptor(), address::socket_addr_to_str(config_.bind_address).c_str(),
+                address::socket_addr_to_str(pp->udp()->dst_addr).c_str(),
+                (long)pp->buffer().size(), core::errno_to_str(-err).c_str());
+    }
+
+    const int pending_packets = --pending_packets_;
+
+    if (pending_packets == 0 && want_close_) {
+        start_closing_();
+    }
+}
+
+void UdpPort::handle_uring_closed() {
+    roc_log(LogDebug, "udp port: %s: closed io_uring", descriptor());
+
+    // Now close libuv handles.
+    start_closing_();
+}
+
+#endif // ROC_TARGET_LIBURING
+
 bool UdpPort::fully_closed_() const {
+#ifdef ROC_TARGET_LIBURING
+    if (uring_io_.is_open()) {
+        return false;
+    }
+#endif // ROC_TARGET_LIBURING
+
     if (!handle_initialized_ && !write_sem_initialized_) {
         return true;
     }
@@ -496,6 +609,17 @@ void UdpPort::start_closing_() {
         return;
     }
 
+#ifdef ROC_TARGET_LIBURING
+    if (uring_io_.is_open()) {
+        // Close io_uring first, because it may still use the socket.
+        // Will continue in handle_uring_closed().
+        roc_log(LogDebug, "udp port: %s: initiating asynchronous io_uring close",
+                descriptor());
+        uring_io_.async_close();
+        return;
+    }
+#endif // ROC_TARGET_LIBURING
+
     roc_log(LogDebug, "udp port: %s: initiating asynchronous close", descriptor());
 
     if (recv_started_) {
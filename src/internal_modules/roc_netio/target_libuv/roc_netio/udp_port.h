@@ -25,6 +25,11 @@
 #include "roc_packet/iwriter.h"
 #include "roc_packet/packet_factory.h"
 
+#ifdef ROC_TARGET_LIBURING
+#include "roc_netio/iuring_udp_handler.h"
+#include "roc_netio/uring_udp_io.h"
+#endif // ROC_TARGET_LIBURING
+
 namespace roc {
 namespace netio {
 
@@ -67,7 +72,15 @@ struct UdpConfig {
 };
 
 //! UDP sender/receiver port.
-class UdpPort : public BasicPort, private packet::IWriter {
+//! @remarks
+//!  If io_uring support is enabled at build time and is supported by running
+//!  kernel, datagrams are sent and received via io_uring, and libuv handle
+//!  is used only to manage socket. Otherwise, libuv is used for everything.
+class UdpPort : public BasicPort,
+#ifdef ROC_TARGET_LIBURING
+                private IUringUdpHandler,
+#endif // ROC_TARGET_LIBURING
+                private packet::IWriter {
 public:
     //! Initialize.
     UdpPort(const UdpConfig& config,
@@ -121,6 +134,18 @@ private:
     void write_(const packet::PacketPtr& packet);
     bool try_nonblocking_write_(const packet::PacketPtr& pp);
 
+    void deliver_packet_(const core::Slice<uint8_t>& buf,
+                         const address::SocketAddr& src_addr);
+
+#ifdef ROC_TARGET_LIBURING
+    // Implements IUringUdpHandler
+    virtual void handle_uring_received(const core::Slice<uint8_t>& data,
+                                       const address::SocketAddr& src_addr);
+    virtual void handle_uring_recv_failed();
+    virtual void handle_uring_sent(const packet::PacketPtr& packet, int err);
+    virtual void handle_uring_closed();
+#endif // ROC_TARGET_LIBURING
+
     bool fully_closed_() const;
     void start_closing_();
 
@@ -151,6 +176,12 @@ private:
 
     packet::PacketFactory& packet_factory_;
 
+#ifdef ROC_TARGET_LIBURING
+    UringUdpIo uring_io_;
+    // Set in open() and not changed afterwards, so can be read by writer.
+    bool uring_send_;
+#endif // ROC_TARGET_LIBURING
+
     packet::IWriter* inbound_writer_;
     core::MpscQueue<packet::Packet> outbound_queue_;
 
@@ -9,29 +9,74 @@
 #include "roc_node/context.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
+#include "roc_node/node.h"
+#include "roc_node/shared_receiver.h"
 
 namespace roc {
 namespace node {
 
 Context::Context(const ContextConfig& config, core::IArena& arena)
-    : arena_(arena)
-    , packet_pool_("packet_pool", arena_)
-    , packet_buffer_pool_(
-          "packet_buffer_pool", arena_, sizeof(core::Buffer) + config.max_packet_size)
-    , frame_buffer_pool_(
-          "frame_buffer_pool", arena_, sizeof(core::Buffer) + config.max_frame_size)
+    : arena_limiter_("arena", config.max_arena_memory)
+    , packet_limiter_("packet", config.max_packet_memory)
+    , frame_limiter_("frame", config.max_frame_memory)
+    , arena_(arena, arena_limiter_)
+    , pool_arena_(init_pool_arena_(config, arena))
+    , packet_pool_("packet_pool", pool_arena_)
+    , packet_buffer_pool_("packet_buffer_pool",
+                          pool_arena_,
+                          sizeof(core::Buffer) + config.max_packet_size)
+    , frame_buffer_pool_("frame_buffer_pool",
+                         pool_arena_,
+                         sizeof(core::Buffer) + config.max_frame_size)
+    , limited_packet_pool_(packet_pool_, packet_limiter_)
+    , limited_packet_buffer_pool_(packet_buffer_pool_, packet_limiter_)
+    , limited_frame_buffer_pool_(frame_buffer_pool_, frame_limiter_)
     , encoding_map_(arena_)
-    , network_loop_(packet_pool_, packet_buffer_pool_, arena_)
-    , control_loop_(network_loop_, arena_) {
+    , sinc_table_map_(arena_)
+    , network_loop_(limited_packet_pool_, limited_packet_buffer_pool_, arena_)
+    , control_loop_(network_loop_, arena_)
+    , last_node_id_(0)
+    , multicast_shared_(config.enable_shared_multicast)
+    , metrics_valid_(false) {
     roc_log(LogDebug, "context: initializing");
+
+    metrics_exporter_.reset(new (metrics_exporter_)
+                                MetricsExporter(config.metrics_exporter, *this, arena_));
+    if (!metrics_exporter_->is_valid()) {
+        return;
+    }
+
+    if (config.metrics_exporter.file_path) {
+        if (!metrics_exporter_->start_writing()) {
+            roc_log(LogError, "context: can't start metrics exporter");
+            return;
+        }
+    }
+
+    metrics_valid_ = true;
 }
 
 Context::~Context() {
     roc_log(LogDebug, "context: deinitializing");
+
+    metrics_exporter_->stop_writing();
+
+    if (!shared_receivers_.is_empty()) {
+        roc_panic("context: attempt to destroy context before removing all"
+                  " shared receivers");
+    }
+
+    if (!nodes_.is_empty()) {
+        roc_panic("context: attempt to destroy context before unregistering all nodes");
+    }
 }
 
 bool Context::is_valid() {
-    return network_loop_.is_valid() && control_loop_.is_valid();
+    if (pinned_arena_ && !pinned_arena_->is_valid()) {
+        return false;
+    }
+
+    return network_loop_.is_valid() && control_loop_.is_valid() && metrics_valid_;
 }
 
 core::IArena& Context::arena() {
@@ -39,21 +84,25 @@ core::IArena& Context::arena() {
 }
 
 core::IPool& Context::packet_pool() {
-    return packet_pool_;
+    return limited_packet_pool_;
 }
 
 core::IPool& Context::packet_buffer_pool() {
-    return packet_buffer_pool_;
+    return limited_packet_buffer_pool_;
 }
 
 core::IPool& Context::frame_buffer_pool() {
-    return frame_buffer_pool_;
+    return limited_frame_buffer_pool_;
 }
 
 rtp::EncodingMap& Context::encoding_map() {
     return encoding_map_;
 }
 
+audio::SincTableMap& Context::sinc_table_map() {
+    return sinc_table_map_;
+}
+
 netio::NetworkLoop& Context::network_loop() {
     return network_loop_;
 }
@@ -62,5 +111,175 @@ ctl::ControlLoop& Context::control_loop() {
     return control_loop_;
 }
 
+MetricsExporter& Context::metrics_exporter() {
+    return *metrics_exporter_;
+}
+
+uint64_t Context::allocate_node_id() {
+    core::Mutex::Lock lock(nodes_mutex_);
+
+    return ++last_node_id_;
+}
+
+void Context::register_node(Node& node) {
+    core::Mutex::Lock lock(nodes_mutex_);
+
+    if (!nodes_.contains(node)) {
+        nodes_.push_back(node);
+    }
+}
+
+void Context::unregister_node(Node& node) {
+    core::Mutex::Lock lock(nodes_mutex_);
+
+    if (nodes_.contains(node)) {
+        nodes_.remove(node);
+    }
+}
+
+bool Context::is_multicast_shared() const {
+    return multicast_shared_;
+}
+
+core::SharedPtr<SharedReceiver>
+Context::bind_shared_receiver(SharedReceiver* attached,
+                              const pipeline::ReceiverSourceConfig& pipeline_config,
+                              address::Interface iface,
+                              address::EndpointUri& uri,
+                              const netio::UdpConfig& udp_config) {
+    core::Mutex::Lock lock(shared_mutex_);
+
+    core::SharedPtr<SharedReceiver> shared = attached;
+
+    if (!shared) {
+        for (shared = shared_receivers_.front(); shared;
+             shared = shared_receivers_.nextof(*shared)) {
+            if (shared->has_endpoint(iface, uri, udp_config)) {
+                break;
+            }
+        }
+
+        if (shared && !shared->is_compatible(pipeline_config)) {
+            roc_log(LogError,
+                    "context: can't use shared receiver:"
+                    " receivers of the same multicast endpoint should have"
+                    " the same output sample spec, latency, fec, and resampler"
+                    " settings");
+            return NULL;
+        }
+    }
+
+    if (!shared) {
+        shared = new (arena_) SharedReceiver(*this, pipeline_config, arena_);
+        if (!shared || !shared->is_valid()) {
+            roc_log(LogError, "context: can't create shared receiver");
+            return NULL;
+        }
+    }
+
+    if (!shared->bind(iface, uri, udp_config)) {
+        return NULL;
+    }
+
+    if (!shared_receivers_.contains(*shared)) {
+        shared_receivers_.push_back(*shared);
+    }
+
+    if (!attached) {
+        shared->add_consumer();
+    }
+
+    return shared;
+}
+
+void Context::unbind_shared_receiver(SharedReceiver& shared) {
+    core::Mutex::Lock lock(shared_mutex_);
+
+    shared.remove_consumer();
+
+    if (shared.num_consumers() == 0) {
+        shared_receivers_.remove(shared);
+    }
+}
+
+size_t Context::num_shared_receivers() {
+    core::Mutex::Lock lock(shared_mutex_);
+
+    return shared_receivers_.size();
+}
+
+bool Context::collect_metrics(MetricsCollector& collector) {
+    if (!collect_pool_metrics_(collector, "packet_pool", packet_pool_)
+        || !collect_pool_metrics_(collector, "packet_buffer_pool", packet_buffer_pool_)
+        || !collect_pool_metrics_(collector, "frame_buffer_pool", frame_buffer_pool_)) {
+        return false;
+    }
+
+    if (!collect_memory_metrics_(collector, "arena", arena_limiter_)
+        || !collect_memory_metrics_(collector, "packet", packet_limiter_)
+        || !collect_memory_metrics_(collector, "frame", frame_limiter_)) {
+        return false;
+    }
+
+    core::Mutex::Lock lock(nodes_mutex_);
+
+    for (Node* node = nodes_.front(); node != NULL; node = nodes_.nextof(*node)) {
+        if (!node->collect_metrics(collector)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+core::IArena& Context::init_pool_arena_(const ContextConfig& config,
+                                        core::IArena& arena) {
+    // Pools are tracked by their own limiters, so they use original arena
+    // instead of limited one.
+    if (config.pinned_memory_size == 0) {
+        return arena;
+    }
+
+    pinned_arena_.reset(new (pinned_arena_) core::PinnedArena(config.pinned_memory_size));
+
+    if (!pinned_arena_->is_valid()) {
+        roc_log(LogError, "context: can't reserve pinned memory: size=%lu",
+                (unsigned long)config.pinned_memory_size);
+    }
+
+    return *pinned_arena_;
+}
+
+template <class T>
+bool Context::collect_pool_metrics_(MetricsCollector& collector,
+                                    const char* name,
+                                    const core::SlabPool<T>& pool) {
+    MetricsCollector::PoolEntry* entry = collector.add_pool(name);
+    if (!entry) {
+        return false;
+    }
+
+    entry->object_size = pool.object_size();
+    entry->used_objects = pool.num_used_slots();
+    entry->free_objects = pool.num_free_slots();
+    entry->guard_failures = pool.num_guard_failures();
+
+    return true;
+}
+
+bool Context::collect_memory_metrics_(MetricsCollector& collector,
+                                      const char* name,
+                                      core::MemoryLimiter& limiter) {
+    MetricsCollector::MemoryEntry* entry = collector.add_memory(name);
+    if (!entry) {
+        return false;
+    }
+
+    entry->acquired_bytes = limiter.num_acquired();
+    entry->limit_bytes = limiter.max_bytes();
+
+    return true;
+}
+
 } // namespace node
 } // namespace roc
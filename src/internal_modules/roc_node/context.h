@@ -12,15 +12,29 @@
 #ifndef ROC_NODE_CONTEXT_H_
 #define ROC_NODE_CONTEXT_H_
 
+#include "roc_address/endpoint_uri.h"
+#include "roc_address/interface.h"
 #include "roc_audio/sample.h"
+#include "roc_audio/sinc_table_map.h"
 #include "roc_core/allocation_policy.h"
 #include "roc_core/atomic.h"
 #include "roc_core/iarena.h"
+#include "roc_core/list.h"
+#include "roc_core/mutex.h"
+#include "roc_core/optional.h"
+#include "roc_core/limited_arena.h"
+#include "roc_core/limited_pool.h"
+#include "roc_core/memory_limiter.h"
+#include "roc_core/pinned_arena.h"
 #include "roc_core/ref_counted.h"
+#include "roc_core/shared_ptr.h"
 #include "roc_core/slab_pool.h"
 #include "roc_ctl/control_loop.h"
 #include "roc_netio/network_loop.h"
+#include "roc_node/metrics_collector.h"
+#include "roc_node/metrics_exporter.h"
 #include "roc_packet/packet_factory.h"
+#include "roc_pipeline/config.h"
 #include "roc_rtp/encoding_map.h"
 
 namespace roc {
@@ -34,12 +48,50 @@ struct ContextConfig {
     //! Maximum size in bytes of an audio frame.
     size_t max_frame_size;
 
+    //! Size in bytes of pinned memory region for packet and frame pools.
+    //! If non-zero, pools allocate memory only from a region of this size,
+    //! reserved when context is created, backed by huge pages if possible,
+    //! and locked in RAM. If the region is exhausted, allocations fail.
+    //! If zero, pools allocate memory from context arena.
+    size_t pinned_memory_size;
+
+    //! Maximum memory in bytes allocated from context arena.
+    //! Doesn't include packet and frame pools. Zero means no limit.
+    size_t max_arena_memory;
+
+    //! Maximum memory in bytes used by packets and packet buffers.
+    //! Zero means no limit.
+    size_t max_packet_memory;
+
+    //! Maximum memory in bytes used by frame buffers.
+    //! Zero means no limit.
+    size_t max_frame_memory;
+
+    //! Metrics exporter config.
+    //! If file path is set, metrics of all nodes are periodically written
+    //! to that file in OpenMetrics text format.
+    MetricsExporterConfig metrics_exporter;
+
+    //! Share multicast subscriptions between receivers.
+    //! If enabled, receivers which bind to the same multicast endpoint
+    //! use one shared receiver, which receives and decodes the stream
+    //! once, and fans out decoded frames to all of them.
+    bool enable_shared_multicast;
+
     ContextConfig()
         : max_packet_size(2048)
-        , max_frame_size(4096) {
+        , max_frame_size(4096)
+        , pinned_memory_size(0)
+        , max_arena_memory(0)
+        , max_packet_memory(0)
+        , max_frame_memory(0)
+        , enable_shared_multicast(false) {
     }
 };
 
+class Node;
+class SharedReceiver;
+
 //! Node context.
 class Context : public core::RefCounted<Context, core::ManualAllocation> {
 public:
@@ -67,23 +119,111 @@ public:
     //! Get encoding map.
     rtp::EncodingMap& encoding_map();
 
+    //! Get sinc table map.
+    //! @remarks
+    //!  Shared by resamplers of all pipelines of the context.
+    audio::SincTableMap& sinc_table_map();
+
     //! Get network event loop.
     netio::NetworkLoop& network_loop();
 
     //! Get control event loop.
     ctl::ControlLoop& control_loop();
 
+    //! Get metrics exporter.
+    MetricsExporter& metrics_exporter();
+
+    //! Allocate unique node identifier.
+    uint64_t allocate_node_id();
+
+    //! Register node, so that its metrics are exported.
+    //! Should be called when node is fully constructed.
+    void register_node(Node& node);
+
+    //! Unregister node.
+    //! Should be called before node starts destruction.
+    //! Does nothing if node is not registered.
+    void unregister_node(Node& node);
+
+    //! Check if receivers should share multicast subscriptions.
+    bool is_multicast_shared() const;
+
+    //! Bind interface of shared receiver and attach consumer to it.
+    //! @remarks
+    //!  If @p attached is NULL, finds shared receiver with the same endpoint
+    //!  or creates a new one, and attaches new consumer to it. Otherwise,
+    //!  binds another interface of already attached shared receiver.
+    //! @returns
+    //!  shared receiver, or NULL on failure.
+    core::SharedPtr<SharedReceiver>
+    bind_shared_receiver(SharedReceiver* attached,
+                         const pipeline::ReceiverSourceConfig& pipeline_config,
+                         address::Interface iface,
+                         address::EndpointUri& uri,
+                         const netio::UdpConfig& udp_config);
+
+    //! Detach consumer from shared receiver.
+    //! @remarks
+    //!  When last consumer is detached, shared receiver is removed.
+    void unbind_shared_receiver(SharedReceiver& shared);
+
+    //! Get number of shared receivers.
+    size_t num_shared_receivers();
+
+    //! Collect metrics of pools and all registered nodes.
+    //! @remarks
+    //!  Nodes read metrics snapshots published by pipelines, so this
+    //!  method never waits for pipelines.
+    ROC_ATTR_NODISCARD bool collect_metrics(MetricsCollector& collector);
+
 private:
-    core::IArena& arena_;
+    core::IArena& init_pool_arena_(const ContextConfig& config, core::IArena& arena);
+
+    template <class T>
+    bool collect_pool_metrics_(MetricsCollector& collector,
+                               const char* name,
+                               const core::SlabPool<T>& pool);
+
+    bool collect_memory_metrics_(MetricsCollector& collector,
+                                 const char* name,
+                                 core::MemoryLimiter& limiter);
+
+    // Track and limit memory used by context arena and pools.
+    // Declared first, so that they're destroyed after everything else.
+    core::MemoryLimiter arena_limiter_;
+    core::MemoryLimiter packet_limiter_;
+    core::MemoryLimiter frame_limiter_;
+
+    core::LimitedArena arena_;
+
+    // If enabled, pools use pinned arena instead of context arena.
+    core::Optional<core::PinnedArena> pinned_arena_;
+    core::IArena& pool_arena_;
 
     core::SlabPool<packet::Packet> packet_pool_;
     core::SlabPool<core::Buffer> packet_buffer_pool_;
     core::SlabPool<core::Buffer> frame_buffer_pool_;
 
+    core::LimitedPool limited_packet_pool_;
+    core::LimitedPool limited_packet_buffer_pool_;
+    core::LimitedPool limited_frame_buffer_pool_;
+
     rtp::EncodingMap encoding_map_;
+    audio::SincTableMap sinc_table_map_;
 
     netio::NetworkLoop network_loop_;
     ctl::ControlLoop control_loop_;
+
+    core::Mutex nodes_mutex_;
+    core::List<Node, core::NoOwnership> nodes_;
+    uint64_t last_node_id_;
+
+    const bool multicast_shared_;
+    core::Mutex shared_mutex_;
+    core::List<SharedReceiver> shared_receivers_;
+
+    core::Optional<MetricsExporter> metrics_exporter_;
+    bool metrics_valid_;
 };
 
 } // namespace node
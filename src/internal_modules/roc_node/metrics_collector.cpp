@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_node/metrics_collector.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace node {
+
+namespace {
+
+template <class T, size_t N> T* append_entry(core::Array<T, N>& array) {
+    if (!array.resize(array.size() + 1)) {
+        roc_log(LogError, "metrics collector: can't allocate entry");
+        return NULL;
+    }
+    return &array.back();
+}
+
+template <class T, size_t N, class Entry>
+bool append_parties(core::Array<T, N>& array,
+                    Entry& entry,
+                    const T* parties,
+                    size_t count) {
+    const size_t first = array.size();
+    if (!array.resize(first + count)) {
+        roc_log(LogError, "metrics collector: can't allocate participant entries");
+        return false;
+    }
+    for (size_t n = 0; n < count; n++) {
+        array[first + n] = parties[n];
+    }
+    entry.first_party = first;
+    entry.party_count = count;
+    return true;
+}
+
+} // namespace
+
+MetricsCollector::MetricsCollector(core::IArena& arena)
+    : pools_(arena)
+    , memory_(arena)
+    , nodes_(arena)
+    , sender_slots_(arena)
+    , receiver_slots_(arena)
+    , sender_parties_(arena)
+    , receiver_parties_(arena) {
+}
+
+void MetricsCollector::clear() {
+    pools_.clear();
+    memory_.clear();
+    nodes_.clear();
+    sender_slots_.clear();
+    receiver_slots_.clear();
+    sender_parties_.clear();
+    receiver_parties_.clear();
+}
+
+MetricsCollector::PoolEntry* MetricsCollector::add_pool(const char* name) {
+    roc_panic_if(!name);
+
+    PoolEntry* entry = append_entry(pools_);
+    if (entry) {
+        entry->name = name;
+    }
+    return entry;
+}
+
+MetricsCollector::MemoryEntry* MetricsCollector::add_memory(const char* name) {
+    roc_panic_if(!name);
+
+    MemoryEntry* entry = append_entry(memory_);
+    if (entry) {
+        entry->name = name;
+    }
+    return entry;
+}
+
+MetricsCollector::NodeEntry* MetricsCollector::add_node(const char* type, uint64_t id) {
+    roc_panic_if(!type);
+
+    NodeEntry* entry = append_entry(nodes_);
+    if (entry) {
+        entry->type = type;
+        entry->id = id;
+    }
+    return entry;
+}
+
+MetricsCollector::SenderSlotEntry* MetricsCollector::add_sender_slot(
+    const char* node_type, uint64_t node_id, uint64_t slot_index) {
+    roc_panic_if(!node_type);
+
+    SenderSlotEntry* entry = append_entry(sender_slots_);
+    if (entry) {
+        entry->node_type = node_type;
+        entry->node_id = node_id;
+        entry->slot_index = slot_index;
+        entry->first_party = 0;
+        entry->party_count = 0;
+    }
+    return entry;
+}
+
+MetricsCollector::ReceiverSlotEntry* MetricsCollector::add_receiver_slot(
+    const char* node_type, uint64_t node_id, uint64_t slot_index) {
+    roc_panic_if(!node_type);
+
+    ReceiverSlotEntry* entry = append_entry(receiver_slots_);
+    if (entry) {
+        entry->node_type = node_type;
+        entry->node_id = node_id;
+        entry->slot_index = slot_index;
+        entry->first_party = 0;
+        entry->party_count = 0;
+    }
+    return entry;
+}
+
+bool MetricsCollector::add_sender_parties(
+    SenderSlotEntry& slot_entry,
+    const pipeline::SenderParticipantMetrics* parties,
+    size_t count) {
+    return append_parties(sender_parties_, slot_entry, parties, count);
+}
+
+bool MetricsCollector::add_receiver_parties(
+    ReceiverSlotEntry& slot_entry,
+    const pipeline::ReceiverParticipantMetrics* parties,
+    size_t count) {
+    return append_parties(receiver_parties_, slot_entry, parties, count);
+}
+
+size_t MetricsCollector::num_pools() const {
+    return pools_.size();
+}
+
+const MetricsCollector::PoolEntry& MetricsCollector::pool(size_t index) const {
+    return pools_[index];
+}
+
+size_t MetricsCollector::num_memory() const {
+    return memory_.size();
+}
+
+const MetricsCollector::MemoryEntry& MetricsCollector::memory(size_t index) const {
+    return memory_[index];
+}
+
+size_t MetricsCollector::num_nodes() const {
+    return nodes_.size();
+}
+
+const MetricsCollector::NodeEntry& MetricsCollector::node(size_t index) const {
+    return nodes_[index];
+}
+
+size_t MetricsCollector::num_sender_slots() const {
+    return sender_slots_.size();
+}
+
+const MetricsCollector::SenderSlotEntry&
+MetricsCollector::sender_slot(size_t index) const {
+    return sender_slots_[index];
+}
+
+size_t MetricsCollector::num_receiver_slots() const {
+    return receiver_slots_.size();
+}
+
+const MetricsCollector::ReceiverSlotEntry&
+MetricsCollector::receiver_slot(size_t index) const {
+    return receiver_slots_[index];
+}
+
+const pipeline::SenderParticipantMetrics&
+MetricsCollector::sender_party(size_t index) const {
+    return sender_parties_[index];
+}
+
+const pipeline::ReceiverParticipantMetrics&
+MetricsCollector::receiver_party(size_t index) const {
+    return receiver_parties_[index];
+}
+
+} // namespace node
+} // namespace roc
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_node/metrics_collector.h
+//! @brief Metrics collector.
+
+#ifndef ROC_NODE_METRICS_COLLECTOR_H_
+#define ROC_NODE_METRICS_COLLECTOR_H_
+
+#include "roc_core/array.h"
+#include "roc_core/attributes.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_pipeline/metrics.h"
+#include "roc_pipeline/pipeline_loop.h"
+
+namespace roc {
+namespace node {
+
+//! Metrics collector.
+//! @remarks
+//!  Accumulates copies of metrics of all nodes, slots and pools of
+//!  a context, so that they can be rendered after all locks are released.
+//!  Nodes fill it from lock-free snapshots and never wait for pipelines.
+class MetricsCollector : public core::NonCopyable<> {
+public:
+    //! Metrics of memory pool.
+    struct PoolEntry {
+        const char* name;      //!< Pool name.
+        size_t object_size;    //!< Size of one object.
+        size_t used_objects;   //!< Objects currently allocated.
+        size_t free_objects;   //!< Objects allocated from arena, but not used.
+        size_t guard_failures; //!< Detected memory corruptions.
+    };
+
+    //! Metrics of memory limiter.
+    struct MemoryEntry {
+        const char* name;      //!< Limiter name.
+        size_t acquired_bytes; //!< Bytes currently acquired.
+        size_t limit_bytes;    //!< Maximum bytes, or zero if unlimited.
+    };
+
+    //! Metrics of node.
+    struct NodeEntry {
+        const char* type;                     //!< Node type.
+        uint64_t id;                          //!< Node identifier.
+        pipeline::PipelineLoop::Stats stats; //!< Pipeline loop statistics.
+    };
+
+    //! Metrics of sender slot.
+    struct SenderSlotEntry {
+        const char* node_type;           //!< Node type.
+        uint64_t node_id;                //!< Node identifier.
+        uint64_t slot_index;             //!< Slot index.
+        pipeline::SenderSlotMetrics slot; //!< Slot metrics.
+        size_t first_party;              //!< Index of first participant entry.
+        size_t party_count;              //!< Number of participant entries.
+    };
+
+    //! Metrics of receiver slot.
+    struct ReceiverSlotEntry {
+        const char* node_type;             //!< Node type.
+        uint64_t node_id;                  //!< Node identifier.
+        uint64_t slot_index;               //!< Slot index.
+        pipeline::ReceiverSlotMetrics slot; //!< Slot metrics.
+        size_t first_party;                //!< Index of first participant entry.
+        size_t party_count;                //!< Number of participant entries.
+    };
+
+    //! Initialize.
+    explicit MetricsCollector(core::IArena& arena);
+
+    //! Remove all entries.
+    //! Keeps allocated memory for reuse.
+    void clear();
+
+    //! Add pool entry.
+    //! Returns NULL if allocation failed.
+    PoolEntry* add_pool(const char* name);
+
+    //! Add memory limiter entry.
+    //! Returns NULL if allocation failed.
+    MemoryEntry* add_memory(const char* name);
+
+    //! Add node entry.
+    //! Returns NULL if allocation failed.
+    NodeEntry* add_node(const char* type, uint64_t id);
+
+    //! Add sender slot entry.
+    //! Returns NULL if allocation failed.
+    SenderSlotEntry* add_sender_slot(const char* node_type,
+                                     uint64_t node_id,
+                                     uint64_t slot_index);
+
+    //! Add receiver slot entry.
+    //! Returns NULL if allocation failed.
+    ReceiverSlotEntry* add_receiver_slot(const char* node_type,
+                                         uint64_t node_id,
+                                         uint64_t slot_index);
+
+    //! Add participant entries to sender slot entry.
+    //! Copies @p count entries from @p parties.
+    //! Returns false if allocation failed.
+    ROC_ATTR_NODISCARD bool
+    add_sender_parties(SenderSlotEntry& slot_entry,
+                       const pipeline::SenderParticipantMetrics* parties,
+                       size_t count);
+
+    //! Add participant entries to receiver slot entry.
+    //! Copies @p count entries from @p parties.
+    //! Returns false if allocation failed.
+    ROC_ATTR_NODISCARD bool
+    add_receiver_parties(ReceiverSlotEntry& slot_entry,
+                         const pipeline::ReceiverParticipantMetrics* parties,
+                         size_t count);
+
+    //! Get number of pool entries.
+    size_t num_pools() const;
+
+    //! Get pool entry.
+    const PoolEntry& pool(size_t index) const;
+
+    //! Get number of memory limiter entries.
+    size_t num_memory() const;
+
+    //! Get memory limiter entry.
+    const MemoryEntry& memory(size_t index) const;
+
+    //! Get number of node entries.
+    size_t num_nodes() const;
+
+    //! Get node entry.
+    const NodeEntry& node(size_t index) const;
+
+    //! Get number of sender slot entries.
+    size_t num_sender_slots() const;
+
+    //! Get sender slot entry.
+    const SenderSlotEntry& sender_slot(size_t index) const;
+
+    //! Get number of receiver slot entries.
+    size_t num_receiver_slots() const;
+
+    //! Get receiver slot entry.
+    const ReceiverSlotEntry& receiver_slot(size_t index) const;
+
+    //! Get sender participant entry.
+    const pipeline::SenderParticipantMetrics& sender_party(size_t index) const;
+
+    //! Get receiver participant entry.
+    const pipeline::ReceiverParticipantMetrics& receiver_party(size_t index) const;
+
+private:
+    core::Array<PoolEntry, 4> pools_;
+    core::Array<MemoryEntry, 4> memory_;
+    core::Array<NodeEntry> nodes_;
+    core::Array<SenderSlotEntry> sender_slots_;
+    core::Array<ReceiverSlotEntry> receiver_slots_;
+    core::Array<pipeline::SenderParticipantMetrics> sender_parties_;
+    core::Array<pipeline::ReceiverParticipantMetrics> receiver_parties_;
+};
+
+} // namespace node
+} // namespace roc
+
+#endif // ROC_NODE_METRICS_COLLECTOR_H_
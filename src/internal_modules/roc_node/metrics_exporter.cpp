@@ -0,0 +1,674 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_node/metrics_exporter.h"
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+#include "roc_core/string_builder.h"
+#include "roc_node/context.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace node {
+
+namespace {
+
+enum ValueFormat {
+    // integer value
+    Format_Integer,
+    // nanoseconds, rendered as seconds
+    Format_Seconds,
+    // floating point value
+    Format_Float
+};
+
+// Builds OpenMetrics text exposition.
+// See https://github.com/OpenObservability/OpenMetrics/blob/main/specification/OpenMetrics.md
+class Writer {
+public:
+    explicit Writer(core::StringBuffer& buffer)
+        : builder_(buffer) {
+    }
+
+    bool is_ok() const {
+        return builder_.is_ok();
+    }
+
+    // Write metadata of metric family.
+    // All samples of a family should be written after its metadata.
+    void family(const char* name, const char* type, const char* unit, const char* help) {
+        builder_.append_str("# TYPE ");
+        builder_.append_str(name);
+        builder_.append_char(' ');
+        builder_.append_str(type);
+        builder_.append_char('\n');
+
+        if (unit) {
+            builder_.append_str("# UNIT ");
+            builder_.append_str(name);
+            builder_.append_char(' ');
+            builder_.append_str(unit);
+            builder_.append_char('\n');
+        }
+
+        builder_.append_str("# HELP ");
+        builder_.append_str(name);
+        builder_.append_char(' ');
+        builder_.append_str(help);
+        builder_.append_char('\n');
+    }
+
+    // Write one sample.
+    // Counters should pass "_total" suffix.
+    void
+    sample(const char* name, const char* suffix, const char* labels, double value,
+           ValueFormat format) {
+        char value_str[64];
+
+        switch (format) {
+        case Format_Integer:
+            snprintf(value_str, sizeof(value_str), "%.0f", value);
+            break;
+        case Format_Seconds:
+            snprintf(value_str, sizeof(value_str), "%.9f", value / core::Second);
+            break;
+        case Format_Float:
+            snprintf(value_str, sizeof(value_str), "%.6f", value);
+            break;
+        }
+
+        builder_.append_str(name);
+        if (suffix) {
+            builder_.append_str(suffix);
+        }
+        builder_.append_char('{');
+        builder_.append_str(labels);
+        builder_.append_str("} ");
+        builder_.append_str(value_str);
+        builder_.append_char('\n');
+    }
+
+    void end() {
+        builder_.append_str("# EOF\n");
+    }
+
+private:
+    core::StringBuilder builder_;
+};
+
+enum { MaxLabelsLen = 192 };
+
+void format_pool_labels(char* buf, const MetricsCollector::PoolEntry& entry) {
+    snprintf(buf, MaxLabelsLen, "pool=\"%s\"", entry.name);
+}
+
+void format_memory_labels(char* buf, const MetricsCollector::MemoryEntry& entry) {
+    snprintf(buf, MaxLabelsLen, "memory=\"%s\"", entry.name);
+}
+
+void format_node_labels(char* buf, const char* node_type, uint64_t node_id) {
+    snprintf(buf, MaxLabelsLen, "node=\"%s\",node_id=\"%llu\"", node_type,
+             (unsigned long long)node_id);
+}
+
+void format_slot_labels(char* buf,
+                        const char* node_type,
+                        uint64_t node_id,
+                        uint64_t slot_index) {
+    snprintf(buf, MaxLabelsLen, "node=\"%s\",node_id=\"%llu\",slot=\"%llu\"", node_type,
+             (unsigned long long)node_id, (unsigned long long)slot_index);
+}
+
+// Connection is identified by SSRC of remote participant, which, unlike
+// its position in slot metrics, doesn't change when other connections
+// come and go.
+void format_conn_labels(char* buf,
+                        const char* node_type,
+                        uint64_t node_id,
+                        uint64_t slot_index,
+                        packet::stream_source_t conn_source_id) {
+    snprintf(buf, MaxLabelsLen,
+             "node=\"%s\",node_id=\"%llu\",slot=\"%llu\",connection=\"%lu\"", node_type,
+             (unsigned long long)node_id, (unsigned long long)slot_index,
+             (unsigned long)conn_source_id);
+}
+
+struct PoolFamily {
+    const char* name;
+    const char* type;
+    const char* suffix;
+    const char* unit;
+    const char* help;
+    size_t MetricsCollector::PoolEntry::*field;
+};
+
+const PoolFamily pool_families[] = {
+    { "roc_pool_object_size_bytes", "gauge", NULL, "bytes", "Size of one pool object.",
+      &MetricsCollector::PoolEntry::object_size },
+    { "roc_pool_used_objects", "gauge", NULL, NULL,
+      "Number of objects currently allocated from pool.",
+      &MetricsCollector::PoolEntry::used_objects },
+    { "roc_pool_free_objects", "gauge", NULL, NULL,
+      "Number of objects that can be allocated without growing pool.",
+      &MetricsCollector::PoolEntry::free_objects },
+    { "roc_pool_guard_failures", "counter", "_total", NULL,
+      "Number of detected memory corruptions.",
+      &MetricsCollector::PoolEntry::guard_failures },
+};
+
+struct MemoryFamily {
+    const char* name;
+    const char* help;
+    size_t MetricsCollector::MemoryEntry::*field;
+};
+
+const MemoryFamily memory_families[] = {
+    { "roc_memory_acquired_bytes", "Memory currently acquired through limiter.",
+      &MetricsCollector::MemoryEntry::acquired_bytes },
+    { "roc_memory_limit_bytes", "Memory limit of limiter, or zero if unlimited.",
+      &MetricsCollector::MemoryEntry::limit_bytes },
+};
+
+struct PipelineFamily {
+    const char* name;
+    const char* help;
+    uint64_t pipeline::PipelineLoop::Stats::*field;
+};
+
+const PipelineFamily pipeline_families[] = {
+    { "roc_pipeline_tasks", "Number of pipeline tasks processed.",
+      &pipeline::PipelineLoop::Stats::task_processed_total },
+    { "roc_pipeline_tasks_in_place",
+      "Number of pipeline tasks processed in place, without waiting for frame.",
+      &pipeline::PipelineLoop::Stats::task_processed_in_place },
+    { "roc_pipeline_tasks_in_frame",
+      "Number of pipeline tasks processed between sub-frames.",
+      &pipeline::PipelineLoop::Stats::task_processed_in_frame },
+    { "roc_pipeline_preemptions",
+      "Number of times task processing was preempted by frame processing.",
+      &pipeline::PipelineLoop::Stats::preemptions },
+    { "roc_pipeline_scheduler_calls", "Number of times task processing was scheduled.",
+      &pipeline::PipelineLoop::Stats::scheduler_calls },
+    { "roc_pipeline_scheduler_cancellations",
+      "Number of times scheduled task processing was cancelled.",
+      &pipeline::PipelineLoop::Stats::scheduler_cancellations },
+};
+
+double conn_total_packets(const packet::LinkMetrics& link, const audio::LatencyMetrics&) {
+    return (double)link.total_packets;
+}
+
+double conn_lost_packets(const packet::LinkMetrics& link, const audio::LatencyMetrics&) {
+    return (double)link.lost_packets;
+}
+
+double conn_jitter(const packet::LinkMetrics& link, const audio::LatencyMetrics&) {
+    return (double)link.jitter;
+}
+
+double conn_rtt(const packet::LinkMetrics& link, const audio::LatencyMetrics&) {
+    return (double)link.rtt;
+}
+
+double conn_fec_repaired_packets(const packet::LinkMetrics& link,
+                                 const audio::LatencyMetrics&) {
+    return (double)link.fec_repaired_packets;
+}
+
+double conn_fec_unrepaired_packets(const packet::LinkMetrics& link,
+                                   const audio::LatencyMetrics&) {
+    return (double)link.fec_unrepaired_packets;
+}
+
+double conn_late_packets(const packet::LinkMetrics& link, const audio::LatencyMetrics&) {
+    return (double)link.late_packets;
+}
+
+double conn_concealed_duration(const packet::LinkMetrics& link,
+                               const audio::LatencyMetrics&) {
+    return (double)link.concealed_duration;
+}
+
+double conn_niq_latency(const packet::LinkMetrics&,
+                        const audio::LatencyMetrics& latency) {
+    return (double)latency.niq_latency;
+}
+
+double conn_niq_stalling(const packet::LinkMetrics&,
+                         const audio::LatencyMetrics& latency) {
+    return (double)latency.niq_stalling;
+}
+
+double conn_e2e_latency(const packet::LinkMetrics&,
+                        const audio::LatencyMetrics& latency) {
+    return (double)latency.e2e_latency;
+}
+
+struct ConnFamily {
+    const char* name;
+    const char* type;
+    const char* suffix;
+    const char* unit;
+    const char* help;
+    ValueFormat format;
+    double (*get)(const packet::LinkMetrics&, const audio::LatencyMetrics&);
+};
+
+const ConnFamily conn_families[] = {
+    { "roc_connection_packets", "counter", "_total", NULL,
+      "Number of packets expected on connection.", Format_Integer,
+      &conn_total_packets },
+    { "roc_connection_lost_packets", "gauge", NULL, NULL,
+      "Cumulative count of lost packets.", Format_Integer, &conn_lost_packets },
+    { "roc_connection_jitter_seconds", "gauge", NULL, "seconds",
+      "Estimated interarrival jitter.", Format_Seconds, &conn_jitter },
+    { "roc_connection_rtt_seconds", "gauge", NULL, "seconds",
+      "Estimated round-trip time.", Format_Seconds, &conn_rtt },
+    { "roc_connection_fec_repaired_packets", "counter", "_total", NULL,
+      "Number of packets restored using FEC.", Format_Integer,
+      &conn_fec_repaired_packets },
+    { "roc_connection_fec_unrepaired_packets", "counter", "_total", NULL,
+      "Number of lost packets not restored using FEC.", Format_Integer,
+      &conn_fec_unrepaired_packets },
+    { "roc_connection_late_packets", "counter", "_total", NULL,
+      "Number of packets dropped because they were late.", Format_Integer,
+      &conn_late_packets },
+    { "roc_connection_concealed_seconds", "counter", "_total", "seconds",
+      "Duration of stream gaps filled with loss concealment.", Format_Seconds,
+      &conn_concealed_duration },
+    { "roc_connection_niq_latency_seconds", "gauge", NULL, "seconds",
+      "Network incoming queue length.", Format_Seconds, &conn_niq_latency },
+    { "roc_connection_niq_stalling_seconds", "gauge", NULL, "seconds",
+      "Delay since last received packet.", Format_Seconds, &conn_niq_stalling },
+    { "roc_connection_e2e_latency_seconds", "gauge", NULL, "seconds",
+      "Estimated end-to-end latency.", Format_Seconds, &conn_e2e_latency },
+};
+
+void render_pools(Writer& writer, const MetricsCollector& collector) {
+    char labels[MaxLabelsLen];
+
+    for (size_t nf = 0; nf < ROC_ARRAY_SIZE(pool_families); nf++) {
+        const PoolFamily& fam = pool_families[nf];
+
+        writer.family(fam.name, fam.type, fam.unit, fam.help);
+
+        for (size_t n = 0; n < collector.num_pools(); n++) {
+            const MetricsCollector::PoolEntry& entry = collector.pool(n);
+
+            format_pool_labels(labels, entry);
+            writer.sample(fam.name, fam.suffix, labels, (double)(entry.*fam.field),
+                          Format_Integer);
+        }
+    }
+}
+
+void render_memory(Writer& writer, const MetricsCollector& collector) {
+    char labels[MaxLabelsLen];
+
+    for (size_t nf = 0; nf < ROC_ARRAY_SIZE(memory_families); nf++) {
+        const MemoryFamily& fam = memory_families[nf];
+
+        writer.family(fam.name, "gauge", "bytes", fam.help);
+
+        for (size_t n = 0; n < collector.num_memory(); n++) {
+            const MetricsCollector::MemoryEntry& entry = collector.memory(n);
+
+            format_memory_labels(labels, entry);
+            writer.sample(fam.name, NULL, labels, (double)(entry.*fam.field),
+                          Format_Integer);
+        }
+    }
+}
+
+void render_pipelines(Writer& writer, const MetricsCollector& collector) {
+    char labels[MaxLabelsLen];
+
+    for (size_t nf = 0; nf < ROC_ARRAY_SIZE(pipeline_families); nf++) {
+        const PipelineFamily& fam = pipeline_families[nf];
+
+        writer.family(fam.name, "counter", NULL, fam.help);
+
+        for (size_t n = 0; n < collector.num_nodes(); n++) {
+            const MetricsCollector::NodeEntry& entry = collector.node(n);
+
+            format_node_labels(labels, entry.type, entry.id);
+            writer.sample(fam.name, "_total", labels, (double)(entry.stats.*fam.field),
+                          Format_Integer);
+        }
+    }
+}
+
+void render_slots(Writer& writer, const MetricsCollector& collector) {
+    char labels[MaxLabelsLen];
+
+    writer.family("roc_slot_connections", "gauge", NULL,
+                  "Number of connections in slot.");
+
+    for (size_t n = 0; n < collector.num_sender_slots(); n++) {
+        const MetricsCollector::SenderSlotEntry& entry = collector.sender_slot(n);
+
+        format_slot_labels(labels, entry.node_type, entry.node_id, entry.slot_index);
+        writer.sample("roc_slot_connections", NULL, labels,
+                      (double)entry.slot.num_participants, Format_Integer);
+    }
+
+    for (size_t n = 0; n < collector.num_receiver_slots(); n++) {
+        const MetricsCollector::ReceiverSlotEntry& entry = collector.receiver_slot(n);
+
+        format_slot_labels(labels, entry.node_type, entry.node_id, entry.slot_index);
+        writer.sample("roc_slot_connections", NULL, labels,
+                      (double)entry.slot.num_participants, Format_Integer);
+    }
+
+    writer.family("roc_slot_frame_processing_seconds", "gauge", "seconds",
+                  "Average time spent processing one frame.");
+
+    for (size_t n = 0; n < collector.num_sender_slots(); n++) {
+        const MetricsCollector::SenderSlotEntry& entry = collector.sender_slot(n);
+
+        format_slot_labels(labels, entry.node_type, entry.node_id, entry.slot_index);
+        writer.sample("roc_slot_frame_processing_seconds", NULL, labels,
+                      (double)entry.slot.frame_processing_time, Format_Seconds);
+    }
+
+    for (size_t n = 0; n < collector.num_receiver_slots(); n++) {
+        const MetricsCollector::ReceiverSlotEntry& entry = collector.receiver_slot(n);
+
+        format_slot_labels(labels, entry.node_type, entry.node_id, entry.slot_index);
+        writer.sample("roc_slot_frame_processing_seconds", NULL, labels,
+                      (double)entry.slot.frame_processing_time, Format_Seconds);
+    }
+
+    writer.family("roc_slot_admitted_sessions", "counter", NULL,
+                  "Number of sessions created in slot.");
+
+    for (size_t n = 0; n < collector.num_receiver_slots(); n++) {
+        const MetricsCollector::ReceiverSlotEntry& entry = collector.receiver_slot(n);
+
+        format_slot_labels(labels, entry.node_type, entry.node_id, entry.slot_index);
+        writer.sample("roc_slot_admitted_sessions", "_total", labels,
+                      (double)entry.slot.num_admitted_sessions, Format_Integer);
+    }
+
+    writer.family("roc_slot_rejected_sessions", "counter", NULL,
+                  "Number of rejected attempts to create session in slot.");
+
+    for (size_t n = 0; n < collector.num_receiver_slots(); n++) {
+        const MetricsCollector::ReceiverSlotEntry& entry = collector.receiver_slot(n);
+
+        format_slot_labels(labels, entry.node_type, entry.node_id, entry.slot_index);
+        writer.sample("roc_slot_rejected_sessions", "_total", labels,
+                      (double)entry.slot.num_rejected_sessions, Format_Integer);
+    }
+
+    writer.family("roc_slot_shed_sessions", "counter", NULL,
+                  "Number of sessions removed from slot because of overload.");
+
+    for (size_t n = 0; n < collector.num_receiver_slots(); n++) {
+        const MetricsCollector::ReceiverSlotEntry& entry = collector.receiver_slot(n);
+
+        format_slot_labels(labels, entry.node_type, entry.node_id, entry.slot_index);
+        writer.sample("roc_slot_shed_sessions", "_total", labels,
+                      (double)entry.slot.num_shed_sessions, Format_Integer);
+    }
+
+    writer.family("roc_slot_complete", "gauge", NULL,
+                  "Whether sender slot has all required endpoints.");
+
+    for (size_t n = 0; n < collector.num_sender_slots(); n++) {
+        const MetricsCollector::SenderSlotEntry& entry = collector.sender_slot(n);
+
+        format_slot_labels(labels, entry.node_type, entry.node_id, entry.slot_index);
+        writer.sample("roc_slot_complete", NULL, labels,
+                      entry.slot.is_complete ? 1 : 0, Format_Integer);
+    }
+
+    writer.family("roc_slot_pacing_queue_depth", "gauge", NULL,
+                  "Number of packets held by sender pacer.");
+
+    for (size_t n = 0; n < collector.num_sender_slots(); n++) {
+        const MetricsCollector::SenderSlotEntry& entry = collector.sender_slot(n);
+
+        format_slot_labels(labels, entry.node_type, entry.node_id, entry.slot_index);
+        writer.sample("roc_slot_pacing_queue_depth", NULL, labels,
+                      (double)entry.slot.pacing_queue_depth, Format_Integer);
+    }
+
+    writer.family("roc_slot_pacing_delay_seconds", "gauge", "seconds",
+                  "Time that last released packet spent in sender pacer queue.");
+
+    for (size_t n = 0; n < collector.num_sender_slots(); n++) {
+        const MetricsCollector::SenderSlotEntry& entry = collector.sender_slot(n);
+
+        format_slot_labels(labels, entry.node_type, entry.node_id, entry.slot_index);
+        writer.sample("roc_slot_pacing_delay_seconds", NULL, labels,
+                      (double)entry.slot.pacing_delay, Format_Seconds);
+    }
+}
+
+void render_connections(Writer& writer, const MetricsCollector& collector) {
+    char labels[MaxLabelsLen];
+
+    for (size_t nf = 0; nf < ROC_ARRAY_SIZE(conn_families); nf++) {
+        const ConnFamily& fam = conn_families[nf];
+
+        writer.family(fam.name, fam.type, fam.unit, fam.help);
+
+        for (size_t n = 0; n < collector.num_sender_slots(); n++) {
+            const MetricsCollector::SenderSlotEntry& entry = collector.sender_slot(n);
+
+            for (size_t np = 0; np < entry.party_count; np++) {
+                const pipeline::SenderParticipantMetrics& party =
+                    collector.sender_party(entry.first_party + np);
+
+                format_conn_labels(labels, entry.node_type, entry.node_id,
+                                   entry.slot_index, party.source_id);
+                writer.sample(fam.name, fam.suffix, labels,
+                              fam.get(party.link, party.latency), fam.format);
+            }
+        }
+
+        for (size_t n = 0; n < collector.num_receiver_slots(); n++) {
+            const MetricsCollector::ReceiverSlotEntry& entry = collector.receiver_slot(n);
+
+            for (size_t np = 0; np < entry.party_count; np++) {
+                const pipeline::ReceiverParticipantMetrics& party =
+                    collector.receiver_party(entry.first_party + np);
+
+                format_conn_labels(labels, entry.node_type, entry.node_id,
+                                   entry.slot_index, party.source_id);
+                writer.sample(fam.name, fam.suffix, labels,
+                              fam.get(party.link, party.latency), fam.format);
+            }
+        }
+    }
+
+    writer.family("roc_connection_resampler_scaling", "gauge", NULL,
+                  "Current clock drift compensation factor.");
+
+    for (size_t n = 0; n < collector.num_receiver_slots(); n++) {
+        const MetricsCollector::ReceiverSlotEntry& entry = collector.receiver_slot(n);
+
+        for (size_t np = 0; np < entry.party_count; np++) {
+            const pipeline::ReceiverParticipantMetrics& party =
+                collector.receiver_party(entry.first_party + np);
+
+            format_conn_labels(labels, entry.node_type, entry.node_id, entry.slot_index,
+                               party.source_id);
+            writer.sample("roc_connection_resampler_scaling", NULL, labels,
+                          (double)party.resampler_scaling, Format_Float);
+        }
+    }
+}
+
+} // namespace
+
+MetricsExporter::MetricsExporter(const MetricsExporterConfig& config,
+                                 Context& context,
+                                 core::IArena& arena)
+    : config_(config)
+    , context_(context)
+    , collector_(arena)
+    , file_path_(arena)
+    , temp_path_(arena)
+    , file_buffer_(arena)
+    , stop_(0)
+    , valid_(false) {
+    if (config_.file_path) {
+        if (config_.interval <= 0) {
+            roc_log(LogError, "metrics exporter: invalid config: interval=%.3fms",
+                    (double)config_.interval / core::Millisecond);
+            return;
+        }
+
+        // output is first written to temporary file in the same directory,
+        // and then renamed, which is atomic
+        core::StringBuilder b(temp_path_);
+        b.append_str(config_.file_path);
+        b.append_str(".tmp");
+
+        if (!b.is_ok() || !file_path_.assign(config_.file_path)) {
+            roc_log(LogError, "metrics exporter: can't allocate buffer");
+            return;
+        }
+    }
+
+    valid_ = true;
+}
+
+MetricsExporter::~MetricsExporter() {
+    if (is_joinable()) {
+        roc_panic("metrics exporter: attempt to call destructor"
+                  " before calling stop_writing()");
+    }
+}
+
+bool MetricsExporter::is_valid() const {
+    return valid_;
+}
+
+bool MetricsExporter::render(core::StringBuffer& buffer) {
+    roc_panic_if(!valid_);
+
+    return render_(buffer);
+}
+
+bool MetricsExporter::start_writing() {
+    roc_panic_if(!valid_);
+
+    if (file_path_.is_empty()) {
+        roc_panic("metrics exporter: attempt to start writing without file path");
+    }
+
+    roc_log(LogInfo, "metrics exporter: writing metrics to \"%s\" every %.3fms",
+            file_path_.c_str(), (double)config_.interval / core::Millisecond);
+
+    return start();
+}
+
+void MetricsExporter::stop_writing() {
+    stop_ = 1;
+
+    while (!timer_.try_set_deadline(0)) {
+        // concurrent update, retry
+    }
+
+    join();
+}
+
+void MetricsExporter::run() {
+    roc_log(LogDebug, "metrics exporter: starting background thread");
+
+    while (!stop_) {
+        (void)write_file_();
+
+        while (!timer_.try_set_deadline(core::timestamp(core::ClockMonotonic)
+                                        + config_.interval)) {
+            // concurrent update, retry
+        }
+
+        // Checked after updating deadline, so that deadline set by
+        // stop_writing() is never overwritten unnoticed.
+        if (stop_) {
+            break;
+        }
+
+        timer_.wait_deadline();
+    }
+
+    roc_log(LogDebug, "metrics exporter: exiting background thread");
+}
+
+bool MetricsExporter::render_(core::StringBuffer& buffer) {
+    core::Mutex::Lock lock(mutex_);
+
+    collector_.clear();
+
+    if (!context_.collect_metrics(collector_)) {
+        return false;
+    }
+
+    Writer writer(buffer);
+
+    render_pools(writer, collector_);
+    render_memory(writer, collector_);
+    render_pipelines(writer, collector_);
+    render_slots(writer, collector_);
+    render_connections(writer, collector_);
+
+    writer.end();
+
+    if (!writer.is_ok()) {
+        roc_log(LogError, "metrics exporter: can't allocate buffer");
+        return false;
+    }
+
+    return true;
+}
+
+bool MetricsExporter::write_file_() {
+    if (!render_(file_buffer_)) {
+        return false;
+    }
+
+    FILE* fp = fopen(temp_path_.c_str(), "w");
+    if (!fp) {
+        roc_log(LogError, "metrics exporter: can't open \"%s\": %s",
+                temp_path_.c_str(), core::errno_to_str().c_str());
+        return false;
+    }
+
+    bool ok = fwrite(file_buffer_.c_str(), 1, file_buffer_.len(), fp)
+        == file_buffer_.len();
+
+    if (fclose(fp) != 0) {
+        ok = false;
+    }
+
+    if (!ok) {
+        roc_log(LogError, "metrics exporter: can't write \"%s\": %s",
+                temp_path_.c_str(), core::errno_to_str().c_str());
+        (void)remove(temp_path_.c_str());
+        return false;
+    }
+
+    if (rename(temp_path_.c_str(), file_path_.c_str()) != 0) {
+        roc_log(LogError, "metrics exporter: can't rename \"%s\" to \"%s\": %s",
+                temp_path_.c_str(), file_path_.c_str(),
+                core::errno_to_str().c_str());
+        (void)remove(temp_path_.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace node
+} // namespace roc
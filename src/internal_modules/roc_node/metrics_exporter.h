@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_node/metrics_exporter.h
+//! @brief Metrics exporter.
+
+#ifndef ROC_NODE_METRICS_EXPORTER_H_
+#define ROC_NODE_METRICS_EXPORTER_H_
+
+#include "roc_core/atomic.h"
+#include "roc_core/attributes.h"
+#include "roc_core/iarena.h"
+#include "roc_core/mutex.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/string_buffer.h"
+#include "roc_core/thread.h"
+#include "roc_core/time.h"
+#include "roc_core/timer.h"
+#include "roc_node/metrics_collector.h"
+
+namespace roc {
+namespace node {
+
+class Context;
+
+//! Metrics exporter config.
+struct MetricsExporterConfig {
+    //! Path to output file.
+    //! If NULL, metrics are only rendered on demand.
+    const char* file_path;
+
+    //! Interval between subsequent writes of output file.
+    core::nanoseconds_t interval;
+
+    MetricsExporterConfig()
+        : file_path(NULL)
+        , interval(core::Second) {
+    }
+};
+
+//! Metrics exporter.
+//!
+//! Renders metrics of all nodes registered in context, their slots and
+//! connections, pipeline loop statistics and context memory pools in
+//! OpenMetrics text format.
+//!
+//! If file path is configured, background thread periodically renders
+//! metrics and atomically replaces output file, so that scraper (e.g.
+//! textfile collector of Prometheus node exporter) never reads partially
+//! written file.
+//!
+//! Metrics are collected from snapshots published by pipeline threads,
+//! so exporter never blocks pipelines.
+class MetricsExporter : public core::Thread {
+public:
+    //! Initialize.
+    MetricsExporter(const MetricsExporterConfig& config,
+                    Context& context,
+                    core::IArena& arena);
+
+    //! Deinitialize.
+    virtual ~MetricsExporter();
+
+    //! Check if successfully constructed.
+    bool is_valid() const;
+
+    //! Render metrics to buffer.
+    //! Can be called from any thread.
+    ROC_ATTR_NODISCARD bool render(core::StringBuffer& buffer);
+
+    //! Start background thread writing output file.
+    ROC_ATTR_NODISCARD bool start_writing();
+
+    //! Stop background thread and wait until it exits.
+    void stop_writing();
+
+private:
+    virtual void run();
+
+    bool render_(core::StringBuffer& buffer);
+    bool write_file_();
+
+    const MetricsExporterConfig config_;
+
+    Context& context_;
+
+    core::Mutex mutex_;
+    MetricsCollector collector_;
+
+    core::StringBuffer file_path_;
+    core::StringBuffer temp_path_;
+    core::StringBuffer file_buffer_;
+
+    core::Timer timer_;
+    core::Atomic<int> stop_;
+
+    bool valid_;
+};
+
+} // namespace node
+} // namespace roc
+
+#endif // ROC_NODE_METRICS_EXPORTER_H_
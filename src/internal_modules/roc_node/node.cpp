@@ -12,7 +12,8 @@ namespace roc {
 namespace node {
 
 Node::Node(Context& context)
-    : context_(&context) {
+    : context_(&context)
+    , id_(context.allocate_node_id()) {
 }
 
 Node::~Node() {
@@ -22,5 +23,13 @@ Context& Node::context() {
     return *context_;
 }
 
+uint64_t Node::id() const {
+    return id_;
+}
+
+bool Node::collect_metrics(MetricsCollector&) {
+    return true;
+}
+
 } // namespace node
 } // namespace roc
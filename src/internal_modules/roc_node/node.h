@@ -12,15 +12,19 @@
 #ifndef ROC_NODE_NODE_H_
 #define ROC_NODE_NODE_H_
 
+#include "roc_core/attributes.h"
+#include "roc_core/list_node.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/shared_ptr.h"
+#include "roc_core/stddefs.h"
 #include "roc_node/context.h"
+#include "roc_node/metrics_collector.h"
 
 namespace roc {
 namespace node {
 
 //! Base class for nodes.
-class Node : public core::NonCopyable<> {
+class Node : public core::NonCopyable<>, public core::ListNode<> {
 public:
     //! Initialize.
     Node(Context& context);
@@ -31,8 +35,18 @@ public:
     //! All nodes hold reference to context.
     Context& context();
 
+    //! Get node identifier, unique within context.
+    uint64_t id() const;
+
+    //! Collect node metrics.
+    //! @remarks
+    //!  Invoked by context from metrics exporter thread. Implementations
+    //!  should read metrics snapshots and never wait for pipeline.
+    ROC_ATTR_NODISCARD virtual bool collect_metrics(MetricsCollector& collector);
+
 private:
     core::SharedPtr<Context> context_;
+    const uint64_t id_;
 };
 
 } // namespace node
@@ -11,21 +11,28 @@
 #include "roc_address/socket_addr_to_str.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
+#include "roc_node/shared_receiver.h"
 
 namespace roc {
 namespace node {
 
 Receiver::Receiver(Context& context,
-                   const pipeline::ReceiverSourceConfig& pipeline_config)
+                   const pipeline::ReceiverSourceConfig& pipeline_config,
+                   bool enable_sharing)
     : Node(context)
+    , pipeline_config_(pipeline_config)
     , pipeline_(*this,
                 pipeline_config,
                 context.encoding_map(),
+                context.sinc_table_map(),
                 context.packet_pool(),
                 context.packet_buffer_pool(),
                 context.frame_buffer_pool(),
                 context.arena())
     , processing_task_(pipeline_)
+    , enable_sharing_(enable_sharing && context.is_multicast_shared())
+    , shared_source_(pipeline_.source())
+    , use_shared_source_(0)
     , slot_pool_("slot_pool", context.arena())
     , slot_map_(context.arena())
     , party_metrics_(context.arena())
@@ -40,11 +47,16 @@ Receiver::Receiver(Context& context,
     }
 
     valid_ = true;
+
+    context.register_node(*this);
 }
 
 Receiver::~Receiver() {
     roc_log(LogDebug, "receiver node: deinitializing");
 
+    // Stop exporting metrics before destroying anything.
+    context().unregister_node(*this);
+
     // First remove all slots. This may involve usage of processing task.
     while (core::SharedPtr<Slot> slot = slot_map_.front()) {
         cleanup_slot_(*slot);
@@ -177,6 +189,32 @@ bool Receiver::bind(slot_index_t slot_index,
 
     port.config.bind_address = resolve_task.get_address();
 
+    if (enable_sharing_ && port.config.multicast_interface[0] != '\0') {
+        if (!bind_shared_(*slot, iface, uri)) {
+            roc_log(LogError,
+                    "receiver node:"
+                    " can't bind %s interface of slot %lu:"
+                    " can't attach to shared receiver",
+                    address::interface_to_str(iface), (unsigned long)slot_index);
+            break_slot_(*slot);
+            return false;
+        }
+
+        update_compatibility_(iface, uri);
+
+        return true;
+    }
+
+    if (has_shared_slot_()) {
+        roc_log(LogError,
+                "receiver node:"
+                " can't bind %s interface of slot %lu:"
+                " receiver attached to shared receiver can't have other endpoints",
+                address::interface_to_str(iface), (unsigned long)slot_index);
+        break_slot_(*slot);
+        return false;
+    }
+
     netio::NetworkLoop::Tasks::AddUdpPort port_task(port.config);
     if (!context().network_loop().schedule_and_wait(port_task)) {
         roc_log(LogError,
@@ -265,6 +303,47 @@ bool Receiver::unlink(slot_index_t slot_index) {
     return true;
 }
 
+bool Receiver::collect_metrics(MetricsCollector& collector) {
+    core::Mutex::Lock lock(mutex_);
+
+    roc_panic_if_not(is_valid());
+
+    MetricsCollector::NodeEntry* node_entry = collector.add_node("receiver", id());
+    if (!node_entry) {
+        return false;
+    }
+
+    pipeline_.load_stats(node_entry->stats);
+
+    for (core::SharedPtr<Slot> slot = slot_map_.front(); slot;
+         slot = slot_map_.nextof(*slot)) {
+        if (!slot->handle || slot->shared) {
+            // Metrics of shared slots are collected from shared receiver.
+            continue;
+        }
+
+        MetricsCollector::ReceiverSlotEntry* slot_entry =
+            collector.add_receiver_slot("receiver", id(), slot->index);
+        if (!slot_entry) {
+            return false;
+        }
+
+        if (!pipeline_.load_slot_metrics(slot->handle, slot_entry->slot,
+                                         party_metrics_)) {
+            roc_log(LogError, "receiver node: can't load slot metrics");
+            return false;
+        }
+
+        if (party_metrics_.size() != 0
+            && !collector.add_receiver_parties(*slot_entry, party_metrics_.data(),
+                                               party_metrics_.size())) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool Receiver::get_metrics(slot_index_t slot_index,
                            slot_metrics_func_t slot_metrics_func,
                            void* slot_metrics_arg,
@@ -287,6 +366,12 @@ bool Receiver::get_metrics(slot_index_t slot_index,
         return false;
     }
 
+    if (slot->shared) {
+        return slot->shared->get_metrics(slot_metrics_func, slot_metrics_arg,
+                                         party_metrics_func, party_metrics_size,
+                                         party_metrics_arg);
+    }
+
     if (party_metrics_size) {
         if (!party_metrics_.resize(*party_metrics_size)) {
             roc_log(LogError,
@@ -297,13 +382,13 @@ bool Receiver::get_metrics(slot_index_t slot_index,
         }
     }
 
-    pipeline::ReceiverLoop::Tasks::QuerySlot task(
-        slot->handle, slot_metrics_,
-        party_metrics_.size() != 0 ? party_metrics_.data() : NULL, party_metrics_size);
-    if (!pipeline_.schedule_and_wait(task)) {
+    if (!pipeline_.load_slot_metrics(
+            slot->handle, slot_metrics_,
+            party_metrics_.size() != 0 ? party_metrics_.data() : NULL,
+            party_metrics_size)) {
         roc_log(LogError,
                 "receiver node:"
-                " can't get metrics of slot %lu: operation failed",
+                " can't get metrics of slot %lu: snapshot is being updated",
                 (unsigned long)slot_index);
         return false;
     }
@@ -338,6 +423,10 @@ bool Receiver::has_broken() {
 }
 
 sndio::ISource& Receiver::source() {
+    if (use_shared_source_) {
+        return shared_source_;
+    }
+
     return pipeline_.source();
 }
 
@@ -361,6 +450,60 @@ void Receiver::update_compatibility_(address::Interface iface,
     used_protocols_[iface] = uri.proto();
 }
 
+bool Receiver::has_shared_slot_() {
+    for (core::SharedPtr<Slot> slot = slot_map_.front(); slot;
+         slot = slot_map_.nextof(*slot)) {
+        if (slot->shared) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool Receiver::has_own_ports_() {
+    for (core::SharedPtr<Slot> slot = slot_map_.front(); slot;
+         slot = slot_map_.nextof(*slot)) {
+        for (size_t p = 0; p < address::Iface_Max; p++) {
+            if (slot->ports[p].handle) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool Receiver::bind_shared_(Slot& slot,
+                            address::Interface iface,
+                            address::EndpointUri& uri) {
+    if (!slot.shared && (has_shared_slot_() || has_own_ports_())) {
+        // Frames of shared receiver are not mixed with other slots, so
+        // shared slot should be the only one.
+        roc_log(LogError,
+                "receiver node: shared multicast endpoint should be the only"
+                " endpoint of receiver");
+        return false;
+    }
+
+    core::SharedPtr<SharedReceiver> shared = context().bind_shared_receiver(
+        slot.shared, pipeline_config_, iface, uri, slot.ports[iface].config);
+    if (!shared) {
+        return false;
+    }
+
+    if (!slot.shared) {
+        roc_log(LogDebug, "receiver node: attached slot %lu to shared receiver",
+                (unsigned long)slot.index);
+
+        slot.shared = shared.get();
+        shared_source_.attach(*shared);
+        use_shared_source_ = 1;
+    }
+
+    return true;
+}
+
 core::SharedPtr<Receiver::Slot> Receiver::get_slot_(slot_index_t slot_index,
                                                     bool auto_create) {
     core::SharedPtr<Slot> slot = slot_map_.find(slot_index);
@@ -400,6 +543,16 @@ core::SharedPtr<Receiver::Slot> Receiver::get_slot_(slot_index_t slot_index,
 }
 
 void Receiver::cleanup_slot_(Slot& slot) {
+    // Detach from shared receiver, which is removed with its ports when
+    // last consumer is detached.
+    if (slot.shared) {
+        use_shared_source_ = 0;
+        shared_source_.detach();
+
+        context().unbind_shared_receiver(*slot.shared);
+        slot.shared = NULL;
+    }
+
     // First remove network ports, because they write to pipeline slot.
     for (size_t p = 0; p < address::Iface_Max; p++) {
         if (slot.ports[p].handle) {
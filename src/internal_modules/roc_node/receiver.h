@@ -18,18 +18,23 @@
 #include "roc_core/attributes.h"
 #include "roc_core/hashmap.h"
 #include "roc_core/mutex.h"
+#include "roc_core/atomic.h"
 #include "roc_core/ref_counted.h"
 #include "roc_core/slab_pool.h"
 #include "roc_core/stddefs.h"
 #include "roc_ctl/control_loop.h"
 #include "roc_node/context.h"
+#include "roc_node/metrics_collector.h"
 #include "roc_node/node.h"
+#include "roc_node/shared_receiver_source.h"
 #include "roc_pipeline/ipipeline_task_scheduler.h"
 #include "roc_pipeline/receiver_loop.h"
 
 namespace roc {
 namespace node {
 
+class SharedReceiver;
+
 //! Receiver node.
 class Receiver : public Node, private pipeline::IPipelineTaskScheduler {
 public:
@@ -37,7 +42,12 @@ public:
     typedef uint64_t slot_index_t;
 
     //! Initialize.
-    Receiver(Context& context, const pipeline::ReceiverSourceConfig& pipeline_config);
+    //! @remarks
+    //!  If @p enable_sharing is true and context has shared multicast mode,
+    //!  multicast endpoints are received via shared receivers of context.
+    Receiver(Context& context,
+             const pipeline::ReceiverSourceConfig& pipeline_config,
+             bool enable_sharing = true);
 
     //! Deinitialize.
     ~Receiver();
@@ -68,6 +78,9 @@ public:
         void* party_arg);
 
     //! Get metrics.
+    //! @remarks
+    //!  Reads metrics snapshot of the slot. Waits for pipeline only if the
+    //!  snapshot is older than metrics interval and has to be republished.
     ROC_ATTR_NODISCARD bool get_metrics(slot_index_t slot_index,
                                         slot_metrics_func_t slot_metrics_func,
                                         void* slot_metrics_arg,
@@ -81,6 +94,9 @@ public:
     //! Get receiver source.
     sndio::ISource& source();
 
+    //! Collect node metrics.
+    virtual bool collect_metrics(MetricsCollector& collector);
+
 private:
     struct Port {
         netio::UdpConfig config;
@@ -95,6 +111,8 @@ private:
         const slot_index_t index;
         pipeline::ReceiverLoop::SlotHandle handle;
         Port ports[address::Iface_Max];
+        // Owned by context while slot is attached.
+        SharedReceiver* shared;
         bool broken;
 
         Slot(core::IPool& pool,
@@ -103,6 +121,7 @@ private:
             : core::RefCounted<Slot, core::PoolAllocation>(pool)
             , index(index)
             , handle(handle)
+            , shared(NULL)
             , broken(false) {
         }
 
@@ -122,6 +141,10 @@ private:
     bool check_compatibility_(address::Interface iface, const address::EndpointUri& uri);
     void update_compatibility_(address::Interface iface, const address::EndpointUri& uri);
 
+    bool has_shared_slot_();
+    bool has_own_ports_();
+    bool bind_shared_(Slot& slot, address::Interface iface, address::EndpointUri& uri);
+
     core::SharedPtr<Slot> get_slot_(slot_index_t slot_index, bool auto_create);
     void cleanup_slot_(Slot& slot);
     void break_slot_(Slot& slot);
@@ -132,9 +155,16 @@ private:
 
     core::Mutex mutex_;
 
+    const pipeline::ReceiverSourceConfig pipeline_config_;
+
     pipeline::ReceiverLoop pipeline_;
     ctl::ControlLoop::Tasks::PipelineProcessing processing_task_;
 
+    // Used instead of pipeline when slot is attached to shared receiver.
+    const bool enable_sharing_;
+    SharedReceiverSource shared_source_;
+    core::Atomic<int> use_shared_source_;
+
     core::SlabPool<Slot> slot_pool_;
     core::Hashmap<Slot> slot_map_;
 
@@ -142,7 +172,7 @@ private:
     address::Protocol used_protocols_[address::Iface_Max];
 
     pipeline::ReceiverSlotMetrics slot_metrics_;
-    core::Array<pipeline::ReceiverParticipantMetrics, 8> party_metrics_;
+    core::Array<pipeline::ReceiverParticipantMetrics> party_metrics_;
 
     bool valid_;
 };
@@ -22,12 +22,14 @@ ReceiverDecoder::ReceiverDecoder(Context& context,
     , pipeline_(*this,
                 pipeline_config,
                 context.encoding_map(),
+                context.sinc_table_map(),
                 context.packet_pool(),
                 context.packet_buffer_pool(),
                 context.frame_buffer_pool(),
                 context.arena())
     , slot_(NULL)
     , processing_task_(pipeline_)
+    , party_metrics_(context.arena())
     , valid_(false) {
     roc_log(LogDebug, "receiver decoder node: initializing");
 
@@ -52,11 +54,16 @@ ReceiverDecoder::ReceiverDecoder(Context& context,
     }
 
     valid_ = true;
+
+    context.register_node(*this);
 }
 
 ReceiverDecoder::~ReceiverDecoder() {
     roc_log(LogDebug, "receiver decoder node: deinitializing");
 
+    // Stop exporting metrics before destroying anything.
+    context().unregister_node(*this);
+
     if (slot_) {
         // First remove slot. This may involve usage of processing task.
         pipeline::ReceiverLoop::Tasks::DeleteSlot task(slot_);
@@ -118,6 +125,39 @@ bool ReceiverDecoder::activate(address::Interface iface, address::Protocol proto
     return true;
 }
 
+bool ReceiverDecoder::collect_metrics(MetricsCollector& collector) {
+    core::Mutex::Lock lock(mutex_);
+
+    roc_panic_if_not(is_valid());
+
+    MetricsCollector::NodeEntry* node_entry =
+        collector.add_node("receiver_decoder", id());
+    if (!node_entry) {
+        return false;
+    }
+
+    pipeline_.load_stats(node_entry->stats);
+
+    MetricsCollector::ReceiverSlotEntry* slot_entry =
+        collector.add_receiver_slot("receiver_decoder", id(), 0);
+    if (!slot_entry) {
+        return false;
+    }
+
+    if (!pipeline_.load_slot_metrics(slot_, slot_entry->slot, party_metrics_)) {
+        roc_log(LogError, "receiver decoder node: can't load slot metrics");
+        return false;
+    }
+
+    if (party_metrics_.size() != 0
+        && !collector.add_receiver_parties(*slot_entry, party_metrics_.data(),
+                                           party_metrics_.size())) {
+        return false;
+    }
+
+    return true;
+}
+
 bool ReceiverDecoder::get_metrics(slot_metrics_func_t slot_metrics_func,
                                   void* slot_metrics_arg,
                                   party_metrics_func_t party_metrics_func,
@@ -14,9 +14,11 @@
 
 #include "roc_address/interface.h"
 #include "roc_address/protocol.h"
+#include "roc_core/array.h"
 #include "roc_core/attributes.h"
 #include "roc_core/mutex.h"
 #include "roc_node/context.h"
+#include "roc_node/metrics_collector.h"
 #include "roc_node/node.h"
 #include "roc_packet/concurrent_queue.h"
 #include "roc_packet/packet_factory.h"
@@ -75,6 +77,9 @@ public:
     //! Source for reading decoded frames.
     sndio::ISource& source();
 
+    //! Collect node metrics.
+    virtual bool collect_metrics(MetricsCollector& collector);
+
 private:
     virtual void schedule_task_processing(pipeline::PipelineLoop&,
                                           core::nanoseconds_t delay);
@@ -94,6 +99,8 @@ private:
     pipeline::ReceiverLoop::SlotHandle slot_;
     ctl::ControlLoop::Tasks::PipelineProcessing processing_task_;
 
+    core::Array<pipeline::ReceiverParticipantMetrics> party_metrics_;
+
     bool valid_;
 };
 
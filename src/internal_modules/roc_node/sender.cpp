@@ -20,6 +20,7 @@ Sender::Sender(Context& context, const pipeline::SenderSinkConfig& pipeline_conf
     , pipeline_(*this,
                 pipeline_config,
                 context.encoding_map(),
+                context.sinc_table_map(),
                 context.packet_pool(),
                 context.packet_buffer_pool(),
                 context.frame_buffer_pool(),
@@ -39,19 +40,26 @@ Sender::Sender(Context& context, const pipeline::SenderSinkConfig& pipeline_conf
     }
 
     valid_ = true;
+
+    context.register_node(*this);
 }
 
 Sender::~Sender() {
     roc_log(LogDebug, "sender node: deinitializing");
 
+    // Stop exporting metrics before destroying anything.
+    context().unregister_node(*this);
+
     // First remove all slots. This may involve usage of processing task.
     while (core::SharedPtr<Slot> slot = slot_map_.front()) {
         cleanup_slot_(*slot);
         slot_map_.remove(*slot);
     }
 
-    // Then wait until processing task is fully completed, before
+    // Then cancel processing task, which may be scheduled for pipeline
+    // refresh in future, and wait until it's fully completed, before
     // proceeding to its destruction.
+    context().control_loop().async_cancel(processing_task_);
     context().control_loop().wait(processing_task_);
 }
 
@@ -269,6 +277,46 @@ bool Sender::unlink(slot_index_t slot_index) {
     return true;
 }
 
+bool Sender::collect_metrics(MetricsCollector& collector) {
+    core::Mutex::Lock lock(mutex_);
+
+    roc_panic_if_not(is_valid());
+
+    MetricsCollector::NodeEntry* node_entry = collector.add_node("sender", id());
+    if (!node_entry) {
+        return false;
+    }
+
+    pipeline_.load_stats(node_entry->stats);
+
+    for (core::SharedPtr<Slot> slot = slot_map_.front(); slot;
+         slot = slot_map_.nextof(*slot)) {
+        if (!slot->handle) {
+            continue;
+        }
+
+        MetricsCollector::SenderSlotEntry* slot_entry =
+            collector.add_sender_slot("sender", id(), slot->index);
+        if (!slot_entry) {
+            return false;
+        }
+
+        if (!pipeline_.load_slot_metrics(slot->handle, slot_entry->slot,
+                                         party_metrics_)) {
+            roc_log(LogError, "sender node: can't load slot metrics");
+            return false;
+        }
+
+        if (party_metrics_.size() != 0
+            && !collector.add_sender_parties(*slot_entry, party_metrics_.data(),
+                                             party_metrics_.size())) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool Sender::get_metrics(slot_index_t slot_index,
                          slot_metrics_func_t slot_metrics_func,
                          void* slot_metrics_arg,
@@ -301,13 +349,13 @@ bool Sender::get_metrics(slot_index_t slot_index,
         }
     }
 
-    pipeline::SenderLoop::Tasks::QuerySlot task(
-        slot->handle, slot_metrics_,
-        party_metrics_.size() != 0 ? party_metrics_.data() : NULL, party_metrics_size);
-    if (!pipeline_.schedule_and_wait(task)) {
+    if (!pipeline_.load_slot_metrics(
+            slot->handle, slot_metrics_,
+            party_metrics_.size() != 0 ? party_metrics_.data() : NULL,
+            party_metrics_size)) {
         roc_log(LogError,
                 "sender node:"
-                " can't get metrics of slot %lu: operation failed",
+                " can't get metrics of slot %lu: snapshot is being updated",
                 (unsigned long)slot_index);
         return false;
     }
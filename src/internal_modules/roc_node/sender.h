@@ -23,6 +23,7 @@
 #include "roc_core/slab_pool.h"
 #include "roc_core/stddefs.h"
 #include "roc_node/context.h"
+#include "roc_node/metrics_collector.h"
 #include "roc_node/node.h"
 #include "roc_packet/iwriter.h"
 #include "roc_pipeline/ipipeline_task_scheduler.h"
@@ -70,6 +71,9 @@ public:
         void* party_arg);
 
     //! Get metrics.
+    //! @remarks
+    //!  Reads metrics snapshot of the slot. Waits for pipeline only if the
+    //!  snapshot is older than metrics interval and has to be republished.
     ROC_ATTR_NODISCARD bool get_metrics(slot_index_t slot_index,
                                         slot_metrics_func_t slot_metrics_func,
                                         void* slot_metrics_arg,
@@ -86,6 +90,9 @@ public:
     //! Get sender sink.
     sndio::ISink& sink();
 
+    //! Collect node metrics.
+    virtual bool collect_metrics(MetricsCollector& collector);
+
 private:
     struct Port {
         netio::UdpConfig config;
@@ -156,7 +163,7 @@ private:
     address::Protocol used_protocols_[address::Iface_Max];
 
     pipeline::SenderSlotMetrics slot_metrics_;
-    core::Array<pipeline::SenderParticipantMetrics, 8> party_metrics_;
+    core::Array<pipeline::SenderParticipantMetrics> party_metrics_;
 
     bool valid_;
 };
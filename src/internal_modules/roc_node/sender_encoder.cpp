@@ -23,12 +23,14 @@ SenderEncoder::SenderEncoder(Context& context,
     , pipeline_(*this,
                 pipeline_config,
                 context.encoding_map(),
+                context.sinc_table_map(),
                 context.packet_pool(),
                 context.packet_buffer_pool(),
                 context.frame_buffer_pool(),
                 context.arena())
     , slot_(NULL)
     , processing_task_(pipeline_)
+    , party_metrics_(context.arena())
     , valid_(false) {
     roc_log(LogDebug, "sender encoder node: initializing");
 
@@ -52,11 +54,16 @@ SenderEncoder::SenderEncoder(Context& context,
     }
 
     valid_ = true;
+
+    context.register_node(*this);
 }
 
 SenderEncoder::~SenderEncoder() {
     roc_log(LogDebug, "sender encoder node: deinitializing");
 
+    // Stop exporting metrics before destroying anything.
+    context().unregister_node(*this);
+
     if (slot_) {
         // First remove slot. This may involve usage of processing task.
         pipeline::SenderLoop::Tasks::DeleteSlot task(slot_);
@@ -65,8 +72,10 @@ SenderEncoder::~SenderEncoder() {
         }
     }
 
-    // Then wait until processing task is fully completed, before
+    // Then cancel processing task, which may be scheduled for pipeline
+    // refresh in future, and wait until it's fully completed, before
     // proceeding to its destruction.
+    context().control_loop().async_cancel(processing_task_);
     context().control_loop().wait(processing_task_);
 }
 
@@ -119,6 +128,38 @@ bool SenderEncoder::activate(address::Interface iface, address::Protocol proto)
     return true;
 }
 
+bool SenderEncoder::collect_metrics(MetricsCollector& collector) {
+    core::Mutex::Lock lock(mutex_);
+
+    roc_panic_if_not(is_valid());
+
+    MetricsCollector::NodeEntry* node_entry = collector.add_node("sender_encoder", id());
+    if (!node_entry) {
+        return false;
+    }
+
+    pipeline_.load_stats(node_entry->stats);
+
+    MetricsCollector::SenderSlotEntry* slot_entry =
+        collector.add_sender_slot("sender_encoder", id(), 0);
+    if (!slot_entry) {
+        return false;
+    }
+
+    if (!pipeline_.load_slot_metrics(slot_, slot_entry->slot, party_metrics_)) {
+        roc_log(LogError, "sender encoder node: can't load slot metrics");
+        return false;
+    }
+
+    if (party_metrics_.size() != 0
+        && !collector.add_sender_parties(*slot_entry, party_metrics_.data(),
+                                         party_metrics_.size())) {
+        return false;
+    }
+
+    return true;
+}
+
 bool SenderEncoder::get_metrics(slot_metrics_func_t slot_metrics_func,
                                 void* slot_metrics_arg,
                                 party_metrics_func_t party_metrics_func,
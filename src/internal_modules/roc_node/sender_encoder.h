@@ -15,11 +15,13 @@
 #include "roc_address/interface.h"
 #include "roc_address/protocol.h"
 #include "roc_address/socket_addr.h"
+#include "roc_core/array.h"
 #include "roc_core/atomic.h"
 #include "roc_core/attributes.h"
 #include "roc_core/mutex.h"
 #include "roc_core/optional.h"
 #include "roc_node/context.h"
+#include "roc_node/metrics_collector.h"
 #include "roc_node/node.h"
 #include "roc_packet/concurrent_queue.h"
 #include "roc_packet/ireader.h"
@@ -80,6 +82,9 @@ public:
     //! Sink for writing frames for encoding.
     sndio::ISink& sink();
 
+    //! Collect node metrics.
+    virtual bool collect_metrics(MetricsCollector& collector);
+
 private:
     virtual void schedule_task_processing(pipeline::PipelineLoop&,
                                           core::nanoseconds_t delay);
@@ -99,6 +104,8 @@ private:
     pipeline::SenderLoop::SlotHandle slot_;
     ctl::ControlLoop::Tasks::PipelineProcessing processing_task_;
 
+    core::Array<pipeline::SenderParticipantMetrics> party_metrics_;
+
     bool valid_;
 };
 
@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_node/shared_receiver.h"
+#include "roc_address/endpoint_uri_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace node {
+
+namespace {
+
+// Receiver slot used for shared stream.
+const Receiver::slot_index_t SharedSlot = 0;
+
+// How much of decoded stream is kept for consumers which are behind.
+const core::nanoseconds_t HistoryDuration = 500 * core::Millisecond;
+
+const core::nanoseconds_t LogInterval = 20 * core::Second;
+
+bool latency_equal(const audio::LatencyConfig& a, const audio::LatencyConfig& b) {
+    return a.tuner_backend == b.tuner_backend && a.tuner_profile == b.tuner_profile
+        && a.target_latency == b.target_latency
+        && a.min_target_latency == b.min_target_latency
+        && a.max_target_latency == b.max_target_latency
+        && a.start_latency == b.start_latency
+        && a.latency_tolerance == b.latency_tolerance;
+}
+
+bool fec_equal(const pipeline::ReceiverSessionConfig& a,
+               const pipeline::ReceiverSessionConfig& b) {
+    return a.fec_decoder.scheme == b.fec_decoder.scheme
+        && a.fec_decoder.ldpc_prng_seed == b.fec_decoder.ldpc_prng_seed
+        && a.fec_decoder.ldpc_N1 == b.fec_decoder.ldpc_N1
+        && a.fec_decoder.rs_m == b.fec_decoder.rs_m
+        && a.fec_reader.max_sbn_jump == b.fec_reader.max_sbn_jump;
+}
+
+bool resampler_equal(const audio::ResamplerConfig& a, const audio::ResamplerConfig& b) {
+    return a.backend == b.backend && a.profile == b.profile;
+}
+
+} // namespace
+
+SharedReceiver::SharedReceiver(Context& context,
+                               const pipeline::ReceiverSourceConfig& pipeline_config,
+                               core::IArena& arena)
+    : core::RefCounted<SharedReceiver, core::ArenaAllocation>(arena)
+    , sample_spec_(pipeline_config.common.output_sample_spec)
+    , session_config_(pipeline_config.session_defaults)
+    , n_consumers_(0)
+    , ring_(arena)
+    , ring_len_(0)
+    , write_pos_(0)
+    , rate_limiter_(LogInterval)
+    , valid_(false) {
+    roc_log(LogDebug, "shared receiver: initializing");
+
+    receiver_.reset(new (receiver_) Receiver(context, pipeline_config, false));
+    if (!receiver_->is_valid()) {
+        return;
+    }
+
+    ring_len_ = std::max(sample_spec_.ns_2_samples_per_chan(HistoryDuration), (size_t)2);
+
+    if (!ring_.resize(ring_len_ * sample_spec_.num_channels())) {
+        roc_log(LogError, "shared receiver: can't allocate buffer");
+        return;
+    }
+
+    valid_ = true;
+}
+
+bool SharedReceiver::is_valid() const {
+    return valid_;
+}
+
+bool SharedReceiver::is_compatible(
+    const pipeline::ReceiverSourceConfig& pipeline_config) const {
+    if (pipeline_config.common.output_sample_spec != sample_spec_) {
+        roc_log(LogError, "shared receiver: consumer has different output sample spec");
+        return false;
+    }
+
+    const pipeline::ReceiverSessionConfig& session_config =
+        pipeline_config.session_defaults;
+
+    if (!latency_equal(session_config.latency, session_config_.latency)) {
+        roc_log(LogError, "shared receiver: consumer has different latency config");
+        return false;
+    }
+
+    if (!fec_equal(session_config, session_config_)) {
+        roc_log(LogError, "shared receiver: consumer has different fec config");
+        return false;
+    }
+
+    if (!resampler_equal(session_config.resampler, session_config_.resampler)) {
+        roc_log(LogError, "shared receiver: consumer has different resampler config");
+        return false;
+    }
+
+    return true;
+}
+
+bool SharedReceiver::has_endpoint(address::Interface iface,
+                                  const address::EndpointUri& uri,
+                                  const netio::UdpConfig& config) const {
+    roc_panic_if(iface < 0);
+    roc_panic_if(iface >= (int)address::Iface_Max);
+
+    const Endpoint& endpoint = endpoints_[iface];
+
+    return endpoint.bound && endpoint.proto == uri.proto()
+        && endpoint.config.bind_address == config.bind_address
+        && strcmp(endpoint.config.multicast_interface, config.multicast_interface) == 0;
+}
+
+bool SharedReceiver::bind(address::Interface iface,
+                          address::EndpointUri& uri,
+                          const netio::UdpConfig& config) {
+    roc_panic_if_not(is_valid());
+
+    roc_panic_if(iface < 0);
+    roc_panic_if(iface >= (int)address::Iface_Max);
+
+    Endpoint& endpoint = endpoints_[iface];
+
+    if (endpoint.bound) {
+        if (!has_endpoint(iface, uri, config)) {
+            roc_log(LogError,
+                    "shared receiver: can't bind %s interface to %s:"
+                    " interface is already bound to another endpoint",
+                    address::interface_to_str(iface),
+                    address::endpoint_uri_to_str(uri).c_str());
+            return false;
+        }
+
+        if (uri.port() == 0 && !uri.set_port(endpoint.port)) {
+            roc_panic("shared receiver: can't set endpoint port");
+        }
+
+        return true;
+    }
+
+    if (!receiver_->configure(SharedSlot, iface, config)) {
+        return false;
+    }
+
+    if (!receiver_->bind(SharedSlot, iface, uri)) {
+        return false;
+    }
+
+    endpoint.bound = true;
+    endpoint.proto = uri.proto();
+    endpoint.config = config;
+    endpoint.port = uri.port();
+
+    return true;
+}
+
+bool SharedReceiver::get_metrics(Receiver::slot_metrics_func_t slot_metrics_func,
+                                 void* slot_metrics_arg,
+                                 Receiver::party_metrics_func_t party_metrics_func,
+                                 size_t* party_metrics_size,
+                                 void* party_metrics_arg) {
+    roc_panic_if_not(is_valid());
+
+    return receiver_->get_metrics(SharedSlot, slot_metrics_func, slot_metrics_arg,
+                                  party_metrics_func, party_metrics_size,
+                                  party_metrics_arg);
+}
+
+size_t SharedReceiver::num_consumers() const {
+    return n_consumers_;
+}
+
+void SharedReceiver::add_consumer() {
+    n_consumers_++;
+
+    roc_log(LogDebug, "shared receiver: attached consumer: n_consumers=%lu",
+            (unsigned long)n_consumers_);
+}
+
+void SharedReceiver::remove_consumer() {
+    roc_panic_if(n_consumers_ == 0);
+
+    n_consumers_--;
+
+    roc_log(LogDebug, "shared receiver: detached consumer: n_consumers=%lu",
+            (unsigned long)n_consumers_);
+}
+
+uint64_t SharedReceiver::position() {
+    core::Mutex::Lock lock(mutex_);
+
+    return write_pos_;
+}
+
+bool SharedReceiver::read(uint64_t& position, audio::Frame& frame) {
+    core::Mutex::Lock lock(mutex_);
+
+    roc_panic_if_not(is_valid());
+
+    const size_t num_channels = sample_spec_.num_channels();
+
+    roc_panic_if_msg(frame.num_raw_samples() % num_channels != 0,
+                     "shared receiver: unexpected frame size");
+
+    audio::sample_t* samples = frame.raw_samples();
+    size_t remaining = frame.num_raw_samples() / num_channels;
+
+    while (remaining != 0) {
+        // Keep chunk smaller than buffer, so that decoding it doesn't
+        // overwrite samples which weren't yet copied.
+        const size_t chunk_len = std::min(remaining, ring_len_ / 2);
+
+        if (position + chunk_len > write_pos_) {
+            if (!decode_(size_t(position + chunk_len - write_pos_))) {
+                return false;
+            }
+        }
+
+        if (position + ring_len_ < write_pos_) {
+            if (rate_limiter_.allow()) {
+                roc_log(LogDebug,
+                        "shared receiver: consumer is too late, skipping samples:"
+                        " skipped=%lu",
+                        (unsigned long)(write_pos_ - chunk_len - position));
+            }
+            position = write_pos_ - chunk_len;
+        }
+
+        copy_(position, samples, chunk_len);
+
+        position += chunk_len;
+        samples += chunk_len * num_channels;
+        remaining -= chunk_len;
+    }
+
+    return true;
+}
+
+void SharedReceiver::reclock(uint64_t position, core::nanoseconds_t timestamp) {
+    core::Mutex::Lock lock(mutex_);
+
+    roc_panic_if_not(is_valid());
+
+    if (position == write_pos_) {
+        receiver_->source().reclock(timestamp);
+    }
+}
+
+bool SharedReceiver::decode_(size_t n_samples) {
+    const size_t num_channels = sample_spec_.num_channels();
+
+    while (n_samples != 0) {
+        const size_t ring_off = size_t(write_pos_ % ring_len_);
+        const size_t n_decode = std::min(n_samples, ring_len_ - ring_off);
+
+        audio::Frame frame(ring_.data() + ring_off * num_channels,
+                           n_decode * num_channels);
+
+        if (!receiver_->source().read(frame)) {
+            return false;
+        }
+
+        write_pos_ += n_decode;
+        n_samples -= n_decode;
+    }
+
+    return true;
+}
+
+void SharedReceiver::copy_(uint64_t position,
+                           audio::sample_t* samples,
+                           size_t n_samples) {
+    const size_t num_channels = sample_spec_.num_channels();
+
+    const size_t ring_off = size_t(position % ring_len_);
+    const size_t n_first = std::min(n_samples, ring_len_ - ring_off);
+
+    memcpy(samples, ring_.data() + ring_off * num_channels,
+           n_first * num_channels * sizeof(audio::sample_t));
+
+    if (n_first < n_samples) {
+        memcpy(samples + n_first * num_channels, ring_.data(),
+               (n_samples - n_first) * num_channels * sizeof(audio::sample_t));
+    }
+}
+
+} // namespace node
+} // namespace roc
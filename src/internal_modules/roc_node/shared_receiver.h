@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_node/shared_receiver.h
+//! @brief Shared multicast receiver.
+
+#ifndef ROC_NODE_SHARED_RECEIVER_H_
+#define ROC_NODE_SHARED_RECEIVER_H_
+
+#include "roc_address/endpoint_uri.h"
+#include "roc_address/interface.h"
+#include "roc_address/protocol.h"
+#include "roc_audio/frame.h"
+#include "roc_audio/sample.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/allocation_policy.h"
+#include "roc_core/array.h"
+#include "roc_core/attributes.h"
+#include "roc_core/list_node.h"
+#include "roc_core/mutex.h"
+#include "roc_core/optional.h"
+#include "roc_core/rate_limiter.h"
+#include "roc_core/ref_counted.h"
+#include "roc_core/stddefs.h"
+#include "roc_netio/network_loop.h"
+#include "roc_node/receiver.h"
+#include "roc_pipeline/config.h"
+
+namespace roc {
+namespace node {
+
+//! Shared multicast receiver.
+//!
+//! Owned by context. Receives and decodes one multicast stream on behalf
+//! of multiple receiver nodes, which joined the same multicast group with
+//! identical endpoints.
+//!
+//! Internally it's a regular receiver with a single slot. Decoded frames
+//! are stored in a ring buffer, and every consumer reads them from its own
+//! position. The stream is decoded on demand, when a consumer reaches the
+//! end of the buffer; so it advances at the pace of the fastest consumer.
+//!
+//! Limitations:
+//!  - Clock drift is compensated only for the consumer which drives decoding
+//!    (see reclock()). There is no per-consumer resampling, so if consumers
+//!    are clocked by different sound cards, slower consumers gradually fall
+//!    behind the fastest one.
+//!  - The buffer holds 500ms of decoded stream. A consumer can be up to this
+//!    much out of sync with the fastest one; when it falls behind by more than
+//!    buffer size, it skips to the most recent frames, which is heard as a
+//!    glitch.
+//!  - All consumers should use the same output sample spec, latency, FEC, and
+//!    resampler settings, since they share the same receiver pipeline; see
+//!    is_compatible().
+class SharedReceiver : public core::RefCounted<SharedReceiver, core::ArenaAllocation>,
+                       public core::ListNode<> {
+public:
+    //! Initialize.
+    SharedReceiver(Context& context,
+                   const pipeline::ReceiverSourceConfig& pipeline_config,
+                   core::IArena& arena);
+
+    //! Check if successfully constructed.
+    bool is_valid() const;
+
+    //! Check if frames can be consumed by receiver with given config.
+    //! @remarks
+    //!  Consumers should have the same output sample spec, and the same latency,
+    //!  FEC, and resampler settings.
+    bool is_compatible(const pipeline::ReceiverSourceConfig& pipeline_config) const;
+
+    //! Check if interface is bound to given endpoint.
+    //! @remarks
+    //!  @p config should have resolved bind address.
+    bool has_endpoint(address::Interface iface,
+                      const address::EndpointUri& uri,
+                      const netio::UdpConfig& config) const;
+
+    //! Bind interface to endpoint.
+    //! @remarks
+    //!  If interface is already bound to the same endpoint, does nothing.
+    //!  If it's bound to another endpoint, fails.
+    //!  If @p uri has zero port, it's updated with the actual port.
+    ROC_ATTR_NODISCARD bool bind(address::Interface iface,
+                                 address::EndpointUri& uri,
+                                 const netio::UdpConfig& config);
+
+    //! Get metrics of shared stream.
+    //! @remarks
+    //!  Same as Receiver::get_metrics().
+    ROC_ATTR_NODISCARD bool get_metrics(Receiver::slot_metrics_func_t slot_metrics_func,
+                                        void* slot_metrics_arg,
+                                        Receiver::party_metrics_func_t party_metrics_func,
+                                        size_t* party_metrics_size,
+                                        void* party_metrics_arg);
+
+    //! Get number of attached consumers.
+    size_t num_consumers() const;
+
+    //! Increment number of attached consumers.
+    void add_consumer();
+
+    //! Decrement number of attached consumers.
+    void remove_consumer();
+
+    //! Get position of the most recent decoded sample.
+    //! @remarks
+    //!  New consumers start reading from this position.
+    uint64_t position();
+
+    //! Read frame for consumer.
+    //! @remarks
+    //!  Fills @p frame with samples starting from @p position, decoding more
+    //!  samples if needed, and advances @p position.
+    ROC_ATTR_NODISCARD bool read(uint64_t& position, audio::Frame& frame);
+
+    //! Adjust clock of shared stream.
+    //! @remarks
+    //!  Applied only if consumer at @p position is the one who drives decoding,
+    //!  i.e. it has read all decoded samples.
+    void reclock(uint64_t position, core::nanoseconds_t timestamp);
+
+private:
+    struct Endpoint {
+        bool bound;
+        address::Protocol proto;
+        netio::UdpConfig config;
+        int port;
+
+        Endpoint()
+            : bound(false)
+            , proto(address::Proto_None)
+            , port(0) {
+        }
+    };
+
+    bool decode_(size_t n_samples);
+    void copy_(uint64_t position, audio::sample_t* samples, size_t n_samples);
+
+    core::Mutex mutex_;
+
+    const audio::SampleSpec sample_spec_;
+    const pipeline::ReceiverSessionConfig session_config_;
+
+    core::Optional<Receiver> receiver_;
+    Endpoint endpoints_[address::Iface_Max];
+
+    size_t n_consumers_;
+
+    core::Array<audio::sample_t> ring_;
+    size_t ring_len_;
+    uint64_t write_pos_;
+
+    core::RateLimiter rate_limiter_;
+
+    bool valid_;
+};
+
+} // namespace node
+} // namespace roc
+
+#endif // ROC_NODE_SHARED_RECEIVER_H_
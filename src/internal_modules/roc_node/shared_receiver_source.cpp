@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_node/shared_receiver_source.h"
+#include "roc_core/panic.h"
+#include "roc_node/shared_receiver.h"
+
+namespace roc {
+namespace node {
+
+SharedReceiverSource::SharedReceiverSource(sndio::ISource& fallback)
+    : fallback_(fallback)
+    , position_(0) {
+}
+
+SharedReceiverSource::~SharedReceiverSource() {
+}
+
+void SharedReceiverSource::attach(SharedReceiver& shared) {
+    core::Mutex::Lock lock(mutex_);
+
+    roc_panic_if_msg(shared_, "shared receiver source: already attached");
+
+    shared_ = &shared;
+    position_ = shared.position();
+}
+
+void SharedReceiverSource::detach() {
+    core::Mutex::Lock lock(mutex_);
+
+    shared_ = NULL;
+    position_ = 0;
+}
+
+sndio::ISink* SharedReceiverSource::to_sink() {
+    return NULL;
+}
+
+sndio::ISource* SharedReceiverSource::to_source() {
+    return this;
+}
+
+sndio::DeviceType SharedReceiverSource::type() const {
+    return sndio::DeviceType_Source;
+}
+
+sndio::DeviceState SharedReceiverSource::state() const {
+    return fallback_.state();
+}
+
+void SharedReceiverSource::pause() {
+    fallback_.pause();
+}
+
+bool SharedReceiverSource::resume() {
+    return fallback_.resume();
+}
+
+bool SharedReceiverSource::restart() {
+    return fallback_.restart();
+}
+
+audio::SampleSpec SharedReceiverSource::sample_spec() const {
+    return fallback_.sample_spec();
+}
+
+core::nanoseconds_t SharedReceiverSource::latency() const {
+    return fallback_.latency();
+}
+
+bool SharedReceiverSource::has_latency() const {
+    return fallback_.has_latency();
+}
+
+bool SharedReceiverSource::has_clock() const {
+    return fallback_.has_clock();
+}
+
+void SharedReceiverSource::reclock(core::nanoseconds_t timestamp) {
+    core::Mutex::Lock lock(mutex_);
+
+    if (!shared_) {
+        fallback_.reclock(timestamp);
+        return;
+    }
+
+    shared_->reclock(position_, timestamp);
+}
+
+bool SharedReceiverSource::read(audio::Frame& frame) {
+    core::Mutex::Lock lock(mutex_);
+
+    if (!shared_) {
+        return fallback_.read(frame);
+    }
+
+    return shared_->read(position_, frame);
+}
+
+} // namespace node
+} // namespace roc
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_node/shared_receiver_source.h
+//! @brief Source reading from shared receiver.
+
+#ifndef ROC_NODE_SHARED_RECEIVER_SOURCE_H_
+#define ROC_NODE_SHARED_RECEIVER_SOURCE_H_
+
+#include "roc_core/mutex.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/shared_ptr.h"
+#include "roc_core/stddefs.h"
+#include "roc_sndio/isource.h"
+
+namespace roc {
+namespace node {
+
+class SharedReceiver;
+
+//! Source reading from shared receiver.
+//! @remarks
+//!  Used by receiver node which consumes a shared multicast stream instead
+//!  of decoding it by itself. Keeps consumer position in shared stream.
+//!  When not attached, forwards reads to fallback source, which is the
+//!  receiver's own pipeline.
+//!  Device properties are always reported by fallback source, which has
+//!  the same sample spec as shared receiver.
+class SharedReceiverSource : public sndio::ISource, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    explicit SharedReceiverSource(sndio::ISource& fallback);
+
+    virtual ~SharedReceiverSource();
+
+    //! Start reading from shared receiver.
+    void attach(SharedReceiver& shared);
+
+    //! Stop reading from shared receiver.
+    void detach();
+
+    //! Cast IDevice to ISink.
+    virtual sndio::ISink* to_sink();
+
+    //! Cast IDevice to ISink.
+    virtual sndio::ISource* to_source();
+
+    //! Get device type.
+    virtual sndio::DeviceType type() const;
+
+    //! Get device state.
+    virtual sndio::DeviceState state() const;
+
+    //! Pause reading.
+    virtual void pause();
+
+    //! Resume paused reading.
+    virtual bool resume();
+
+    //! Restart reading from the beginning.
+    virtual bool restart();
+
+    //! Get sample specification of the source.
+    virtual audio::SampleSpec sample_spec() const;
+
+    //! Get latency of the source.
+    virtual core::nanoseconds_t latency() const;
+
+    //! Check if the source supports latency reports.
+    virtual bool has_latency() const;
+
+    //! Check if the source has own clock.
+    virtual bool has_clock() const;
+
+    //! Adjust source clock to match consumer clock.
+    virtual void reclock(core::nanoseconds_t timestamp);
+
+    //! Read frame.
+    virtual bool read(audio::Frame& frame);
+
+private:
+    core::Mutex mutex_;
+
+    sndio::ISource& fallback_;
+
+    core::SharedPtr<SharedReceiver> shared_;
+    uint64_t position_;
+};
+
+} // namespace node
+} // namespace roc
+
+#endif // ROC_NODE_SHARED_RECEIVER_SOURCE_H_
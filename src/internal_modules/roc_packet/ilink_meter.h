@@ -57,13 +57,36 @@ struct LinkMetrics {
     //! it on receiver.
     core::nanoseconds_t rtt;
 
+    //! Cumulative count of lost packets restored using FEC.
+    //! On sender, is retrieved from receiver via RTCP.
+    uint64_t fec_repaired_packets;
+
+    //! Cumulative count of lost packets that were not restored using FEC.
+    //! If FEC is not used, equal to the number of lost packets.
+    //! On sender, is retrieved from receiver via RTCP.
+    uint64_t fec_unrepaired_packets;
+
+    //! Cumulative count of packets dropped by receiver because they arrived
+    //! too late to be played.
+    //! On sender, is retrieved from receiver via RTCP.
+    uint64_t late_packets;
+
+    //! Cumulative duration of gaps in stream that were filled by receiver
+    //! using packet loss concealment or with silence.
+    //! On sender, is retrieved from receiver via RTCP.
+    core::nanoseconds_t concealed_duration;
+
     LinkMetrics()
         : ext_first_seqnum(0)
         , ext_last_seqnum(0)
         , total_packets(0)
         , lost_packets(0)
         , jitter(0)
-        , rtt(0) {
+        , rtt(0)
+        , fec_repaired_packets(0)
+        , fec_unrepaired_packets(0)
+        , late_packets(0)
+        , concealed_duration(0) {
     }
 };
 
@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_packet/pacer.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace packet {
+
+namespace {
+
+// When rate is derived automatically, allow this much more traffic than the
+// average rate of the stream, so that the queue can drain after jitter in
+// packet production.
+const double DerivedRateHeadroom = 1.5;
+
+} // namespace
+
+Pacer::Pacer(IWriter& writer,
+             const PacerConfig& config,
+             core::nanoseconds_t packet_length,
+             size_t n_source_packets,
+             size_t n_repair_packets)
+    : writer_(writer)
+    , config_(config)
+    , packet_length_(packet_length)
+    , n_source_packets_(n_source_packets)
+    , n_repair_packets_(n_repair_packets)
+    , rate_(0)
+    , bucket_size_(0)
+    , tokens_(0)
+    , max_packet_size_(0)
+    , last_time_(0)
+    , repair_interval_(0)
+    , next_repair_time_(0)
+    , pacing_delay_(0)
+    , valid_(false) {
+    if (packet_length_ <= 0 || n_source_packets_ == 0) {
+        roc_log(LogError,
+                "pacer: invalid config: packet_length=%.3fms n_source_packets=%lu",
+                (double)packet_length_ / core::Millisecond,
+                (unsigned long)n_source_packets_);
+        return;
+    }
+
+    if (config_.burst < 0) {
+        roc_log(LogError, "pacer: invalid config: burst=%.3fms",
+                (double)config_.burst / core::Millisecond);
+        return;
+    }
+
+    if (n_repair_packets_ != 0) {
+        repair_interval_ = packet_length_ * (core::nanoseconds_t)n_source_packets_
+            / (core::nanoseconds_t)n_repair_packets_;
+    }
+
+    if (config_.rate != 0) {
+        rate_ = (double)config_.rate;
+    }
+
+    roc_log(LogDebug,
+            "pacer: initializing:"
+            " rate=%lu burst=%.3fms packet_length=%.3fms repair_interval=%.3fms",
+            (unsigned long)config_.rate, (double)config_.burst / core::Millisecond,
+            (double)packet_length_ / core::Millisecond,
+            (double)repair_interval_ / core::Millisecond);
+
+    valid_ = true;
+}
+
+bool Pacer::is_valid() const {
+    return valid_;
+}
+
+status::StatusCode Pacer::write(const PacketPtr& packet) {
+    roc_panic_if(!is_valid());
+
+    if (!packet) {
+        roc_panic("pacer: unexpected null packet");
+    }
+
+    if (packet->udp()) {
+        packet->udp()->queue_timestamp = core::timestamp(core::ClockUnix);
+    }
+
+    update_rate_(*packet);
+
+    queue_.push_back(*packet);
+
+    return status::StatusOK;
+}
+
+status::StatusCode Pacer::refresh(core::nanoseconds_t current_time) {
+    roc_panic_if(!is_valid());
+
+    add_tokens_(current_time);
+
+    while (PacketPtr packet = queue_.front()) {
+        if (!can_send_(*packet, current_time)) {
+            break;
+        }
+
+        queue_.remove(*packet);
+        on_sent_(*packet, current_time);
+
+        const status::StatusCode code = writer_.write(packet);
+        if (code != status::StatusOK) {
+            return code;
+        }
+    }
+
+    return status::StatusOK;
+}
+
+status::StatusCode Pacer::flush(core::nanoseconds_t current_time) {
+    roc_panic_if(!is_valid());
+
+    if (queue_.size() != 0) {
+        roc_log(LogDebug, "pacer: flushing %lu queued packets",
+                (unsigned long)queue_.size());
+    }
+
+    add_tokens_(current_time);
+
+    while (PacketPtr packet = queue_.front()) {
+        queue_.remove(*packet);
+        on_sent_(*packet, current_time);
+
+        const status::StatusCode code = writer_.write(packet);
+        if (code != status::StatusOK) {
+            return code;
+        }
+    }
+
+    return status::StatusOK;
+}
+
+core::nanoseconds_t Pacer::refresh_deadline() const {
+    roc_panic_if(!is_valid());
+
+    const PacketPtr packet = queue_.front();
+    if (!packet) {
+        return 0;
+    }
+
+    core::nanoseconds_t deadline = last_time_;
+
+    const double packet_size = (double)packet->buffer().size();
+    if (tokens_ < packet_size && rate_ > 0) {
+        deadline += (core::nanoseconds_t)((packet_size - tokens_) / rate_ * core::Second)
+            + 1;
+    }
+
+    if (repair_interval_ > 0 && packet->has_flags(Packet::FlagRepair)) {
+        deadline = std::max(deadline, next_repair_time_);
+    }
+
+    return deadline;
+}
+
+PacerMetrics Pacer::metrics() const {
+    roc_panic_if(!is_valid());
+
+    PacerMetrics metrics;
+    metrics.queue_depth = queue_.size();
+    metrics.pacing_delay = pacing_delay_;
+
+    return metrics;
+}
+
+void Pacer::update_rate_(const Packet& packet) {
+    const size_t packet_size = packet.buffer().size();
+    if (packet_size <= max_packet_size_) {
+        return;
+    }
+
+    max_packet_size_ = packet_size;
+
+    if (config_.rate == 0) {
+        // Average number of bytes per second of source stream: one packet
+        // per packet length.
+        rate_ = (double)max_packet_size_ / ((double)packet_length_ / core::Second)
+            * DerivedRateHeadroom;
+
+        if (n_repair_packets_ != 0) {
+            // Repair stream has n_repair_packets for every n_source_packets
+            // of source stream, and repair packets have the same size as
+            // source packets.
+            rate_ = rate_ * (double)n_repair_packets_ / (double)n_source_packets_;
+        }
+    }
+
+    const core::nanoseconds_t burst = config_.burst != 0 ? config_.burst : packet_length_;
+
+    // Bucket should be able to hold at least one packet, otherwise we
+    // would never send anything.
+    bucket_size_ =
+        std::max(rate_ * ((double)burst / core::Second), (double)max_packet_size_);
+}
+
+void Pacer::add_tokens_(core::nanoseconds_t current_time) {
+    if (last_time_ == 0) {
+        tokens_ = bucket_size_;
+        last_time_ = current_time;
+        return;
+    }
+
+    if (current_time <= last_time_) {
+        return;
+    }
+
+    tokens_ += rate_ * ((double)(current_time - last_time_) / core::Second);
+    if (tokens_ > bucket_size_) {
+        tokens_ = bucket_size_;
+    }
+
+    last_time_ = current_time;
+}
+
+bool Pacer::can_send_(const Packet& packet, core::nanoseconds_t current_time) const {
+    if (tokens_ < (double)packet.buffer().size()) {
+        return false;
+    }
+
+    if (repair_interval_ > 0 && packet.has_flags(Packet::FlagRepair)) {
+        if (current_time < next_repair_time_) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void Pacer::on_sent_(Packet& packet, core::nanoseconds_t current_time) {
+    tokens_ -= (double)packet.buffer().size();
+
+    if (repair_interval_ > 0 && packet.has_flags(Packet::FlagRepair)) {
+        // Keep schedule phase when we're late by less than one interval, so that
+        // coarse refresh() calls don't accumulate lag; restart schedule after idle.
+        if (next_repair_time_ < current_time - repair_interval_) {
+            next_repair_time_ = current_time;
+        }
+        next_repair_time_ += repair_interval_;
+    }
+
+    if (packet.udp() && packet.udp()->queue_timestamp != 0) {
+        pacing_delay_ = std::max(current_time - packet.udp()->queue_timestamp,
+                                 (core::nanoseconds_t)0);
+    }
+}
+
+} // namespace packet
+} // namespace roc
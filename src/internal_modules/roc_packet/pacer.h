@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_packet/pacer.h
+//! @brief Outbound packet pacer.
+
+#ifndef ROC_PACKET_PACER_H_
+#define ROC_PACKET_PACER_H_
+
+#include "roc_core/list.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/time.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet.h"
+
+namespace roc {
+namespace packet {
+
+//! Pacer parameters.
+struct PacerConfig {
+    //! Sending rate, in bytes per second.
+    //! @remarks
+    //!  If zero, rate is derived from packet length, FEC block size, and
+    //!  the size of packets being sent.
+    size_t rate;
+
+    //! Maximum burst duration.
+    //! @remarks
+    //!  Defines capacity of the token bucket: how much traffic can be sent at
+    //!  once after idle period, expressed as duration at configured rate.
+    //!  If zero, packet length is used.
+    core::nanoseconds_t burst;
+
+    PacerConfig()
+        : rate(0)
+        , burst(0) {
+    }
+};
+
+//! Pacer metrics.
+struct PacerMetrics {
+    //! Number of packets currently queued in pacer.
+    size_t queue_depth;
+
+    //! How long last released packet spent in pacer queue.
+    core::nanoseconds_t pacing_delay;
+
+    PacerMetrics()
+        : queue_depth(0)
+        , pacing_delay(0) {
+    }
+};
+
+//! Outbound packet pacer.
+//!
+//! Delays outgoing packets to avoid bursts on the wire:
+//!
+//!  - all packets pass through a token bucket, which limits sending rate
+//!    and maximum burst size
+//!
+//!  - repair packets, which are produced by FEC writer in a burst at the end
+//!    of every block, are additionally spread evenly across the next block
+//!    interval
+//!
+//! When rate is not configured, it is derived from the source stream rate,
+//! i.e. one packet per packet length. For repair stream, this rate is scaled
+//! by the ratio of repair and source packets in FEC block.
+//!
+//! Packets passed to write() are queued; refresh() should be called
+//! at refresh_deadline() to send queued packets which are due to the output
+//! writer, and flush() should be called before sending is stopped.
+class Pacer : public IWriter, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p writer is used to write paced packets
+    //!  - @p config defines rate and burst size
+    //!  - @p packet_length defines duration of a single source packet
+    //!  - @p n_source_packets and @p n_repair_packets define FEC block size;
+    //!    @p n_repair_packets should be non-zero only for pacer of repair stream
+    Pacer(IWriter& writer,
+          const PacerConfig& config,
+          core::nanoseconds_t packet_length,
+          size_t n_source_packets,
+          size_t n_repair_packets);
+
+    //! Check if object is successfully constructed.
+    bool is_valid() const;
+
+    //! Enqueue packet for sending.
+    //! @remarks
+    //!  Packet is not sent immediately, it's sent by next refresh() call
+    //!  when it's allowed by rate limit.
+    virtual ROC_ATTR_NODISCARD status::StatusCode write(const PacketPtr& packet);
+
+    //! Send queued packets that are due.
+    ROC_ATTR_NODISCARD status::StatusCode refresh(core::nanoseconds_t current_time);
+
+    //! Send all queued packets immediately, ignoring rate limit.
+    //! @remarks
+    //!  Used when sending is stopped, so that queued packets are not lost.
+    ROC_ATTR_NODISCARD status::StatusCode flush(core::nanoseconds_t current_time);
+
+    //! Get deadline when refresh() should be called again.
+    //! @returns
+    //!  absolute time, or zero if there are no queued packets.
+    core::nanoseconds_t refresh_deadline() const;
+
+    //! Get metrics.
+    PacerMetrics metrics() const;
+
+private:
+    void update_rate_(const Packet& packet);
+    void add_tokens_(core::nanoseconds_t current_time);
+    bool can_send_(const Packet& packet, core::nanoseconds_t current_time) const;
+    void on_sent_(Packet& packet, core::nanoseconds_t current_time);
+
+    IWriter& writer_;
+
+    core::List<Packet> queue_;
+
+    const PacerConfig config_;
+    const core::nanoseconds_t packet_length_;
+    const size_t n_source_packets_;
+    const size_t n_repair_packets_;
+
+    // Token bucket state, in bytes.
+    double rate_;
+    double bucket_size_;
+    double tokens_;
+    size_t max_packet_size_;
+    core::nanoseconds_t last_time_;
+
+    // Repair packets spreading.
+    core::nanoseconds_t repair_interval_;
+    core::nanoseconds_t next_repair_time_;
+
+    core::nanoseconds_t pacing_delay_;
+
+    bool valid_;
+};
+
+} // namespace packet
+} // namespace roc
+
+#endif // ROC_PACKET_PACER_H_
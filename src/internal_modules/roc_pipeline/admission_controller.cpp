@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/admission_controller.h"
+#include "roc_address/socket_addr_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace pipeline {
+
+namespace {
+
+// New sessions are admitted only while load is below this fraction of limit.
+const float AdmitLoadRatio = 0.9f;
+
+} // namespace
+
+AdmissionController::AdmissionController(const ReceiverCommonConfig& common_config,
+                                         const StateTracker& state_tracker)
+    : state_tracker_(state_tracker)
+    , max_sessions_(common_config.max_sessions)
+    , max_load_(common_config.max_session_load)
+    , deny_duration_(common_config.shed_deny_duration)
+    , load_(0)
+    , avg_session_load_(0) {
+    roc_panic_if_msg(max_load_ < 0, "admission controller: invalid max load: %f",
+                     (double)max_load_);
+
+    if (max_sessions_ != 0 || max_load_ != 0) {
+        roc_log(LogDebug, "admission controller: max_sessions=%lu max_load=%.3f",
+                (unsigned long)max_sessions_, (double)max_load_);
+    }
+}
+
+bool AdmissionController::can_admit() const {
+    if (max_sessions_ != 0 && state_tracker_.num_active_sessions() >= max_sessions_) {
+        return false;
+    }
+
+    if (max_load_ != 0 && load_ >= max_load_ * AdmitLoadRatio) {
+        return false;
+    }
+
+    return true;
+}
+
+bool AdmissionController::is_overloaded() const {
+    return max_load_ != 0 && load_ > max_load_;
+}
+
+float AdmissionController::load() const {
+    return load_;
+}
+
+void AdmissionController::update_load(const SessionLoad& load) {
+    if (load.n_measured != 0) {
+        // Remember average, so that it can be used for estimation even
+        // when no session has measured load, e.g. after all sessions were
+        // re-created.
+        avg_session_load_ = load.measured_load / (float)load.n_measured;
+    }
+
+    load_ = load.measured_load + avg_session_load_ * (float)load.n_unmeasured;
+}
+
+void AdmissionController::deny(const address::SocketAddr& source_addr,
+                               bool has_source_id,
+                               packet::stream_source_t source_id,
+                               core::nanoseconds_t current_time) {
+    if (deny_duration_ <= 0 || (!source_addr && !has_source_id)) {
+        return;
+    }
+
+    DenyEntry* entry = &deny_list_[0];
+
+    for (size_t n = 1; n < MaxDenyEntries; n++) {
+        if (deny_list_[n].expiry < entry->expiry) {
+            entry = &deny_list_[n];
+        }
+    }
+
+    entry->source_addr = source_addr;
+    entry->has_source_id = has_source_id;
+    entry->source_id = source_id;
+    entry->expiry = current_time + deny_duration_;
+
+    roc_log(LogDebug,
+            "admission controller: denying sender:"
+            " src_addr=%s src_id=%lu duration=%.3fs",
+            address::socket_addr_to_str(source_addr).c_str(), (unsigned long)source_id,
+            (double)deny_duration_ / core::Second);
+}
+
+bool AdmissionController::is_denied(const address::SocketAddr& source_addr,
+                                    bool has_source_id,
+                                    packet::stream_source_t source_id,
+                                    core::nanoseconds_t current_time) const {
+    for (size_t n = 0; n < MaxDenyEntries; n++) {
+        const DenyEntry& entry = deny_list_[n];
+
+        if (entry.expiry <= current_time) {
+            continue;
+        }
+
+        if (source_addr && entry.source_addr && source_addr == entry.source_addr) {
+            return true;
+        }
+
+        if (has_source_id && entry.has_source_id && source_id == entry.source_id) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace pipeline
+} // namespace roc
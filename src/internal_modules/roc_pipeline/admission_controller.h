@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/admission_controller.h
+//! @brief Session admission controller.
+
+#ifndef ROC_PIPELINE_ADMISSION_CONTROLLER_H_
+#define ROC_PIPELINE_ADMISSION_CONTROLLER_H_
+
+#include "roc_address/socket_addr.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+#include "roc_packet/units.h"
+#include "roc_pipeline/config.h"
+#include "roc_pipeline/state_tracker.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Processing load of a set of sessions.
+struct SessionLoad {
+    //! Sum of loads of sessions which load is already measured.
+    float measured_load;
+
+    //! Load of most expensive session.
+    float max_load;
+
+    //! Number of sessions which load is already measured.
+    size_t n_measured;
+
+    //! Number of sessions which load is not measured yet.
+    size_t n_unmeasured;
+
+    SessionLoad()
+        : measured_load(0)
+        , max_load(0)
+        , n_measured(0)
+        , n_unmeasured(0) {
+    }
+
+    //! Add load of another set of sessions.
+    void add(const SessionLoad& other) {
+        measured_load += other.measured_load;
+        max_load = std::max(max_load, other.max_load);
+        n_measured += other.n_measured;
+        n_unmeasured += other.n_unmeasured;
+    }
+};
+
+//! Session admission controller.
+//!
+//! Shared by all slots of receiver source. Decides whether new sessions
+//! can be created, based on number of active sessions and on processing
+//! load of existing sessions, and tells when receiver is overloaded and
+//! some sessions should be removed.
+//!
+//! Load is reported by receiver source on every refresh. To avoid repeatedly
+//! creating and removing sessions, new sessions are admitted only while load
+//! is noticeably below the limit, and sessions are removed only when load is
+//! above the limit.
+//!
+//! Sessions which were just created don't have measured load yet. They are
+//! charged with the average load of measured sessions, so that a burst of
+//! new sessions can't bypass the limit.
+//!
+//! Senders of removed sessions are put into a small deny list for a limited
+//! time, so that they can't re-create session right after it was removed.
+class AdmissionController : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    AdmissionController(const ReceiverCommonConfig& common_config,
+                        const StateTracker& state_tracker);
+
+    //! Check if a new session can be created.
+    bool can_admit() const;
+
+    //! Check if load exceeds the limit and a session should be removed.
+    bool is_overloaded() const;
+
+    //! Get last reported load.
+    float load() const;
+
+    //! Report processing load of all sessions.
+    //! @remarks
+    //!  Sessions which load is not measured yet are charged with the average
+    //!  load of measured sessions.
+    void update_load(const SessionLoad& load);
+
+    //! Deny creating sessions from given sender for a while.
+    //! @remarks
+    //!  Called when session of this sender is removed because of overload.
+    //!  Sender is identified by source address and SSRC, any of which may be
+    //!  empty. If deny list is full, the entry which expires first is replaced.
+    void deny(const address::SocketAddr& source_addr,
+              bool has_source_id,
+              packet::stream_source_t source_id,
+              core::nanoseconds_t current_time);
+
+    //! Check if creating sessions from given sender is denied.
+    //! @remarks
+    //!  Returns true if either source address or SSRC is in deny list.
+    bool is_denied(const address::SocketAddr& source_addr,
+                   bool has_source_id,
+                   packet::stream_source_t source_id,
+                   core::nanoseconds_t current_time) const;
+
+private:
+    enum { MaxDenyEntries = 16 };
+
+    struct DenyEntry {
+        address::SocketAddr source_addr;
+        bool has_source_id;
+        packet::stream_source_t source_id;
+        core::nanoseconds_t expiry;
+
+        DenyEntry()
+            : has_source_id(false)
+            , source_id(0)
+            , expiry(0) {
+        }
+    };
+
+    const StateTracker& state_tracker_;
+
+    const size_t max_sessions_;
+    const float max_load_;
+    const core::nanoseconds_t deny_duration_;
+
+    float load_;
+    float avg_session_load_;
+
+    DenyEntry deny_list_[MaxDenyEntries];
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_ADMISSION_CONTROLLER_H_
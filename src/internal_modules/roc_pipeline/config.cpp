@@ -7,11 +7,34 @@
  */
 
 #include "roc_pipeline/config.h"
+#include "roc_audio/slip_resampler.h"
 #include "roc_rtp/headers.h"
 
 namespace roc {
 namespace pipeline {
 
+namespace {
+
+// Some resampler backends can't apply arbitrary scaling, so we tell latency
+// tuner to keep scaling within their limits.
+void bound_latency_scaling(audio::LatencyConfig& latency,
+                           const audio::ResamplerConfig& resampler) {
+    if (resampler.backend != audio::ResamplerBackend_Slip) {
+        return;
+    }
+
+    const float max_deviation = audio::SlipResampler::max_scaling_deviation();
+
+    if (latency.scaling_tolerance > max_deviation) {
+        latency.scaling_tolerance = max_deviation;
+    }
+    if (latency.start_scaling > max_deviation) {
+        latency.start_scaling = max_deviation;
+    }
+}
+
+} // namespace
+
 SenderSinkConfig::SenderSinkConfig()
     : input_sample_spec(DefaultSampleSpec)
     , payload_type(rtp::PayloadType_L16_Stereo)
@@ -20,12 +43,15 @@ SenderSinkConfig::SenderSinkConfig()
     , enable_auto_duration(false)
     , enable_auto_cts(false)
     , enable_profiling(false)
-    , enable_interleaving(false) {
+    , enable_interleaving(false)
+    , enable_pacing(false)
+    , metrics_interval(DefaultMetricsInterval) {
 }
 
 void SenderSinkConfig::deduce_defaults() {
     latency.deduce_defaults(DefaultLatency, false);
     resampler.deduce_defaults(latency.tuner_backend, latency.tuner_profile);
+    bound_latency_scaling(latency, resampler);
 }
 
 SenderSlotConfig::SenderSlotConfig() {
@@ -38,7 +64,15 @@ ReceiverCommonConfig::ReceiverCommonConfig()
     : output_sample_spec(DefaultSampleSpec)
     , enable_timing(false)
     , enable_auto_reclock(false)
-    , enable_profiling(false) {
+    , enable_profiling(false)
+    , processing_layout(audio::SampleLayout_Interleaved)
+    , processing_format(audio::Sample_RawFormat)
+    , enable_inline_parsing(false)
+    , max_sessions(0)
+    , max_session_load(0)
+    , shed_deny_duration(DefaultShedDenyDuration)
+    , metrics_interval(DefaultMetricsInterval) {
+    rtcp.report_batch_size = DefaultRtcpReportBatchSize;
 }
 
 void ReceiverCommonConfig::deduce_defaults() {
@@ -53,9 +87,12 @@ void ReceiverSessionConfig::deduce_defaults() {
     latency.deduce_defaults(DefaultLatency, true);
     watchdog.deduce_defaults(latency.target_latency);
     resampler.deduce_defaults(latency.tuner_backend, latency.tuner_profile);
+    bound_latency_scaling(latency, resampler);
+    plc.deduce_defaults();
 }
 
-ReceiverSourceConfig::ReceiverSourceConfig() {
+ReceiverSourceConfig::ReceiverSourceConfig()
+    : num_session_threads(1) {
 }
 
 void ReceiverSourceConfig::deduce_defaults() {
@@ -64,7 +101,8 @@ void ReceiverSourceConfig::deduce_defaults() {
 }
 
 ReceiverSlotConfig::ReceiverSlotConfig()
-    : enable_routing(true) {
+    : enable_routing(true)
+    , session_priority(SessionPriority_Normal) {
 }
 
 void ReceiverSlotConfig::deduce_defaults() {
@@ -73,7 +111,8 @@ void ReceiverSlotConfig::deduce_defaults() {
 TranscoderConfig::TranscoderConfig()
     : input_sample_spec(DefaultSampleSpec)
     , output_sample_spec(DefaultSampleSpec)
-    , enable_profiling(false) {
+    , enable_profiling(false)
+    , num_threads(1) {
 }
 
 void TranscoderConfig::deduce_defaults() {
@@ -15,6 +15,7 @@
 #include "roc_address/protocol.h"
 #include "roc_audio/feedback_monitor.h"
 #include "roc_audio/latency_tuner.h"
+#include "roc_audio/plc_config.h"
 #include "roc_audio/profiler.h"
 #include "roc_audio/resampler_config.h"
 #include "roc_audio/sample_spec.h"
@@ -24,6 +25,7 @@
 #include "roc_fec/codec_config.h"
 #include "roc_fec/reader.h"
 #include "roc_fec/writer.h"
+#include "roc_packet/pacer.h"
 #include "roc_packet/units.h"
 #include "roc_pipeline/pipeline_loop.h"
 #include "roc_rtcp/config.h"
@@ -54,6 +56,23 @@ const core::nanoseconds_t DefaultPacketLength = 5 * core::Millisecond;
 //!  networks allow lower latencies, and some networks require higher.
 const core::nanoseconds_t DefaultLatency = 200 * core::Millisecond;
 
+//! Default metrics interval.
+//! @remarks
+//!  For how long metrics snapshot can be reused by readers before pipeline
+//!  has to republish it.
+const core::nanoseconds_t DefaultMetricsInterval = 50 * core::Millisecond;
+
+//! Default shed deny duration.
+//! @remarks
+//!  For how long sender of shed session is not allowed to create a new session.
+const core::nanoseconds_t DefaultShedDenyDuration = 10 * core::Second;
+
+//! Default RTCP report batch size on receiver.
+//! @remarks
+//!  How many senders receiver reports to in one RTCP generation. Reports to
+//!  more senders are spread across report interval.
+const size_t DefaultRtcpReportBatchSize = 100;
+
 //! Parameters of sender sink and sender session.
 struct SenderSinkConfig {
     //! Input sample spec
@@ -74,6 +93,9 @@ struct SenderSinkConfig {
     //! FEC encoder parameters.
     fec::CodecConfig fec_encoder;
 
+    //! Pacer parameters.
+    packet::PacerConfig pacer;
+
     //! Latency parameters.
     audio::LatencyConfig latency;
 
@@ -104,6 +126,16 @@ struct SenderSinkConfig {
     //! Interleave packets.
     bool enable_interleaving;
 
+    //! Pace outgoing packets to avoid bursts.
+    bool enable_pacing;
+
+    //! Maximum age of metrics snapshot.
+    //! @remarks
+    //!  Pipeline republishes snapshot during refresh when it becomes older
+    //!  than this, or when number of participants changes. Zero means
+    //!  republishing on every refresh.
+    core::nanoseconds_t metrics_interval;
+
     //! Initialize config.
     SenderSinkConfig();
 
@@ -120,6 +152,20 @@ struct SenderSlotConfig {
     void deduce_defaults();
 };
 
+//! Priority of receiver sessions.
+//! @remarks
+//!  When receiver is overloaded, sessions with lower priority are removed first.
+enum SessionPriority {
+    //! Sessions are removed before others.
+    SessionPriority_Low,
+
+    //! Default priority.
+    SessionPriority_Normal,
+
+    //! Sessions are removed after others.
+    SessionPriority_High
+};
+
 //! Parameters common for all receiver sessions.
 struct ReceiverCommonConfig {
     //! Output sample spec.
@@ -143,6 +189,69 @@ struct ReceiverCommonConfig {
     //! Profile moving average of frames being written.
     bool enable_profiling;
 
+    //! Layout of samples inside receiver pipeline.
+    //! @remarks
+    //!  If planar, sessions convert decoded samples to planar layout, and
+    //!  channel mapper, resampler (if backend supports it) and mixer process
+    //!  every channel as a separate aligned plane. Samples are converted back
+    //!  to interleaved layout after mixing. Output sample spec is always
+    //!  interleaved.
+    audio::SampleLayout processing_layout;
+
+    //! Format of samples inside receiver pipeline.
+    //! @remarks
+    //!  Either audio::Sample_RawFormat, or one of the native-endian integer
+    //!  formats (see audio::is_integer_format()). If integer, depacketizer,
+    //!  builtin resampler and mixer process 16-bit or 32-bit integer samples
+    //!  with saturating arithmetic. Elements that can't handle integer samples
+    //!  (PLC, channel mapper, other resampler backends, non-PCM decoders) still
+    //!  work with raw samples, and session converts them to integer format
+    //!  once. Can't be combined with planar processing layout.
+    audio::PcmFormat processing_format;
+
+    //! Parse inbound packets on network thread.
+    //! @remarks
+    //!  If enabled, RTP and FEC headers are parsed right when the packet is
+    //!  written to endpoint by network thread, before it is enqueued. Packets
+    //!  that can't be parsed or have unknown payload type are dropped early and
+    //!  never reach pipeline thread, which only routes already classified packets.
+    bool enable_inline_parsing;
+
+    //! Maximum number of sessions in all slots.
+    //! @remarks
+    //!  When limit is reached, new sessions are rejected.
+    //!  Zero means no limit.
+    size_t max_sessions;
+
+    //! Maximum processing load of all sessions.
+    //! @remarks
+    //!  Load is time spent on producing frames of sessions divided by duration
+    //!  of those frames, e.g. 0.5 means that sessions take half of real time.
+    //!  When load exceeds the limit, new sessions are rejected, and existing
+    //!  sessions are removed one by one, starting from slots with lowest
+    //!  priority and from most expensive session in slot.
+    //!  When sessions are processed in parallel, load may exceed 1.
+    //!  Zero means no limit. Per-session processing time is measured only
+    //!  when limit is set.
+    float max_session_load;
+
+    //! For how long sender of shed session is denied to create a new session.
+    //! @remarks
+    //!  When session is removed because of overload, its source address and
+    //!  SSRC are remembered, and packets from them don't create sessions until
+    //!  this duration expires. Otherwise the sender would immediately re-create
+    //!  the session, and receiver would oscillate between admitting and
+    //!  shedding it.
+    //!  Zero disables deny list.
+    core::nanoseconds_t shed_deny_duration;
+
+    //! Maximum age of metrics snapshot.
+    //! @remarks
+    //!  Pipeline republishes snapshot during refresh when it becomes older
+    //!  than this, or when number of participants changes. Zero means
+    //!  republishing on every refresh.
+    core::nanoseconds_t metrics_interval;
+
     //! Initialize config.
     ReceiverCommonConfig();
 
@@ -170,7 +279,12 @@ struct ReceiverSessionConfig {
     //! Resampler parameters.
     audio::ResamplerConfig resampler;
 
+    //! Packet loss concealment parameters.
+    audio::PlcConfig plc;
+
     //! Insert weird beeps instead of silence on packet loss.
+    //! @remarks
+    //!  Overrides PLC parameters.
     bool enable_beeping;
 
     //! Initialize config.
@@ -191,6 +305,14 @@ struct ReceiverSourceConfig {
     //! Default parameters for a session.
     ReceiverSessionConfig session_defaults;
 
+    //! Number of threads used for processing sessions.
+    //! @remarks
+    //!  If greater than one, mixer divides sessions between worker threads,
+    //!  which read them in parallel, and then mixes their outputs. Output
+    //!  doesn't depend on number of threads. Useful when there are many
+    //!  sessions and a single core can't keep up with them.
+    size_t num_session_threads;
+
     //! Initialize config.
     ReceiverSourceConfig();
 
@@ -203,6 +325,16 @@ struct ReceiverSlotConfig {
     //! Enable routing packets to multiple sessions within slot.
     bool enable_routing;
 
+    //! Packet loss concealment parameters for sessions of this slot.
+    //! @remarks
+    //!  If backend is PlcBackend_Default, session defaults are used.
+    audio::PlcConfig plc;
+
+    //! Priority of sessions of this slot.
+    //! @remarks
+    //!  Used when sessions have to be removed because receiver is overloaded.
+    SessionPriority session_priority;
+
     //! Initialize config.
     ReceiverSlotConfig();
 
@@ -227,6 +359,12 @@ struct TranscoderConfig {
     //! Profile moving average of frames being written.
     bool enable_profiling;
 
+    //! Number of threads used for resampling.
+    //! @remarks
+    //!  If greater than one, channels are split into groups, and each group
+    //!  is resampled in its own thread. Makes sense only with large frames.
+    size_t num_threads;
+
     //! Initialize config.
     TranscoderConfig();
 
@@ -14,6 +14,7 @@
 
 #include "roc_audio/latency_tuner.h"
 #include "roc_core/stddefs.h"
+#include "roc_core/time.h"
 #include "roc_packet/ilink_meter.h"
 #include "roc_packet/units.h"
 
@@ -22,13 +23,17 @@ namespace pipeline {
 
 //! Sender-side metrics specific to one participant (remote receiver).
 struct SenderParticipantMetrics {
+    //! Source ID of remote receiver.
+    packet::stream_source_t source_id;
+
     //! Link metrics.
     packet::LinkMetrics link;
 
     //! Latency metrics.
     audio::LatencyMetrics latency;
 
-    SenderParticipantMetrics() {
+    SenderParticipantMetrics()
+        : source_id(0) {
     }
 };
 
@@ -43,22 +48,46 @@ struct SenderSlotMetrics {
     //! Is slot configuration complete (all endpoints bound).
     bool is_complete;
 
+    //! Number of packets queued in pacers of all endpoints.
+    size_t pacing_queue_depth;
+
+    //! Maximum time that last sent packet spent in pacer, among all endpoints.
+    core::nanoseconds_t pacing_delay;
+
+    //! Average time spent by pipeline to process one frame.
+    //! @remarks
+    //!  Shared by all slots of the pipeline.
+    core::nanoseconds_t frame_processing_time;
+
     SenderSlotMetrics()
         : source_id(0)
         , num_participants(0)
-        , is_complete(false) {
+        , is_complete(false)
+        , pacing_queue_depth(0)
+        , pacing_delay(0)
+        , frame_processing_time(0) {
     }
 };
 
 //! Receiver-side metrics specific to one participant (remote sender).
 struct ReceiverParticipantMetrics {
+    //! Source ID of remote sender.
+    //! Zero if not known yet.
+    packet::stream_source_t source_id;
+
     //! Link metrics.
     packet::LinkMetrics link;
 
     //! Latency metrics.
     audio::LatencyMetrics latency;
 
-    ReceiverParticipantMetrics() {
+    //! Scaling factor currently applied to resampler.
+    //! Equal to 1 if latency tuning is disabled.
+    float resampler_scaling;
+
+    ReceiverParticipantMetrics()
+        : source_id(0)
+        , resampler_scaling(1.0f) {
     }
 };
 
@@ -70,9 +99,30 @@ struct ReceiverSlotMetrics {
     //! Number of participants (remote senders) connected to slot.
     size_t num_participants;
 
+    //! Average time spent by pipeline to process one frame.
+    //! @remarks
+    //!  Shared by all slots of the pipeline.
+    core::nanoseconds_t frame_processing_time;
+
+    //! Number of sessions created in slot.
+    size_t num_admitted_sessions;
+
+    //! Number of times when session was not created because of admission control.
+    //! @remarks
+    //!  Every packet from unknown sender that would create a new session
+    //!  counts as an attempt.
+    size_t num_rejected_sessions;
+
+    //! Number of sessions removed because receiver was overloaded.
+    size_t num_shed_sessions;
+
     ReceiverSlotMetrics()
         : source_id(0)
-        , num_participants(0) {
+        , num_participants(0)
+        , frame_processing_time(0)
+        , num_admitted_sessions(0)
+        , num_rejected_sessions(0)
+        , num_shed_sessions(0) {
     }
 };
 
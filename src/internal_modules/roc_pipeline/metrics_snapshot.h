@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/metrics_snapshot.h
+//! @brief Snapshot of slot metrics.
+
+#ifndef ROC_PIPELINE_METRICS_SNAPSHOT_H_
+#define ROC_PIPELINE_METRICS_SNAPSHOT_H_
+
+#include "roc_core/array.h"
+#include "roc_core/atomic.h"
+#include "roc_core/iarena.h"
+#include "roc_core/log.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/seqlock.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Snapshot of slot metrics.
+//!
+//! Holds copy of slot metrics and metrics of all its participants. Snapshot
+//! is published by pipeline thread, and can be read by any thread without
+//! locks and without waiting for pipeline.
+//!
+//! Slot metrics are stored in a seqlock. Participant metrics are stored in a
+//! list of fixed-size chunks, each in its own seqlock. Every publish bumps
+//! generation, which is stored in every chunk and in slot metrics; reader
+//! retries if it sees chunks from different generations.
+//!
+//! Chunks are allocated when number of participants grows and are never
+//! freed or moved until snapshot is destroyed, so reader can walk them while
+//! pipeline is publishing.
+//!
+//! Thread-safe.
+template <class SlotMetrics, class ParticipantMetrics>
+class MetricsSnapshot : public core::NonCopyable<> {
+public:
+    //! Initialize empty snapshot.
+    explicit MetricsSnapshot(core::IArena& arena)
+        : arena_(arena)
+        , header_(Header())
+        , first_chunk_(NULL)
+        , last_chunk_(NULL)
+        , num_chunks_(0)
+        , parties_(arena)
+        , generation_(0)
+        , published_count_(0)
+        , publish_ts_(0) {
+    }
+
+    ~MetricsSnapshot() {
+        Chunk* chunk = first_chunk_;
+        while (chunk) {
+            Chunk* next_chunk = chunk->next;
+            arena_.destroy_object(*chunk);
+            chunk = next_chunk;
+        }
+    }
+
+    //! Check if snapshot should be republished.
+    //! @remarks
+    //!  Returns true if snapshot was never published, or was published at
+    //!  least @p max_age before @p current_time, or if number of participants
+    //!  changed since then. Should be called from pipeline thread.
+    bool need_publish(core::nanoseconds_t current_time,
+                      core::nanoseconds_t max_age,
+                      size_t party_count) const {
+        return generation_ == 0 || current_time - publish_ts_ >= max_age
+            || party_count != published_count_;
+    }
+
+    //! Publish metrics from given slot.
+    //! @remarks
+    //!  Invokes @c slot.get_metrics() with buffer that can hold up to
+    //!  @p party_count participants. Should be called from pipeline thread.
+    //!  Allocates memory only when number of participants grows.
+    template <class Slot>
+    void publish(const Slot& slot, size_t party_count, core::nanoseconds_t current_time) {
+        if (!reserve_(party_count)) {
+            roc_log(LogError,
+                    "metrics snapshot: can't allocate buffer for %lu participants",
+                    (unsigned long)party_count);
+        }
+
+        Header header;
+        header.generation = ++generation_;
+        header.party_count = parties_.size();
+
+        slot.get_metrics(header.slot, header.party_count != 0 ? parties_.data() : NULL,
+                         &header.party_count);
+
+        // Chunks are stored before header, so that reader that sees new header
+        // also sees new chunks.
+        Chunk* chunk = first_chunk_;
+        for (size_t off = 0; off < header.party_count; off += ChunkSize) {
+            ChunkData data;
+            data.generation = header.generation;
+            for (size_t n = 0; n < ChunkSize && off + n < header.party_count; n++) {
+                data.parties[n] = parties_[off + n];
+            }
+            chunk->data.exclusive_store(data);
+            chunk = chunk->next;
+        }
+
+        header_.exclusive_store(header);
+
+        published_count_ = party_count;
+        publish_ts_ = current_time;
+    }
+
+    //! Copy metrics from snapshot to user-provided structs.
+    //! @remarks
+    //!  @p party_count defines size of @p party_metrics array and is updated
+    //!  to the number of written elements. Lock-free, never waits for pipeline.
+    //! @returns
+    //!  false if snapshot is being republished concurrently and consistent copy
+    //!  couldn't be obtained after a few attempts.
+    bool load(SlotMetrics& slot_metrics,
+              ParticipantMetrics* party_metrics,
+              size_t* party_count) const {
+        for (size_t attempt = 0; attempt < MaxLoadAttempts; attempt++) {
+            Header header;
+            if (!header_.try_load(header)) {
+                continue;
+            }
+
+            size_t count = 0;
+            if (party_metrics && party_count) {
+                count = std::min(*party_count, header.party_count);
+            }
+
+            if (!load_chunks_(header.generation, party_metrics, count)) {
+                continue;
+            }
+
+            slot_metrics = header.slot;
+            if (party_count) {
+                *party_count = count;
+            }
+            return true;
+        }
+
+        return false;
+    }
+
+    //! Copy metrics from snapshot to user-provided struct and array.
+    //! @remarks
+    //!  Resizes @p party_metrics to the number of published participants and
+    //!  fills it. Lock-free, never waits for pipeline, but may allocate memory
+    //!  for the array.
+    //! @returns
+    //!  false if array can't be resized, or if snapshot is being republished
+    //!  concurrently and consistent copy couldn't be obtained.
+    template <size_t N>
+    bool load(SlotMetrics& slot_metrics,
+              core::Array<ParticipantMetrics, N>& party_metrics) const {
+        for (size_t attempt = 0; attempt < MaxLoadAttempts; attempt++) {
+            Header header;
+            if (!header_.try_load(header)) {
+                continue;
+            }
+
+            if (!party_metrics.resize(header.party_count)) {
+                roc_log(LogError,
+                        "metrics snapshot: can't allocate buffer for %lu participants",
+                        (unsigned long)header.party_count);
+                return false;
+            }
+
+            if (!load_chunks_(header.generation,
+                              header.party_count != 0 ? party_metrics.data() : NULL,
+                              header.party_count)) {
+                continue;
+            }
+
+            slot_metrics = header.slot;
+            return true;
+        }
+
+        return false;
+    }
+
+private:
+    enum {
+        // Number of participants per chunk.
+        ChunkSize = 8,
+
+        // How many times reader retries when it races with publish.
+        MaxLoadAttempts = 8
+    };
+
+    struct Header {
+        uint64_t generation;
+        SlotMetrics slot;
+        size_t party_count;
+
+        Header()
+            : generation(0)
+            , party_count(0) {
+        }
+    };
+
+    struct ChunkData {
+        uint64_t generation;
+        ParticipantMetrics parties[ChunkSize];
+
+        ChunkData()
+            : generation(0) {
+        }
+    };
+
+    struct Chunk {
+        core::Seqlock<ChunkData> data;
+        core::Atomic<Chunk*> next;
+
+        Chunk()
+            : data(ChunkData())
+            , next(NULL) {
+        }
+    };
+
+    bool reserve_(size_t party_count) {
+        if (parties_.size() < party_count && !parties_.resize(party_count)) {
+            return false;
+        }
+
+        while (num_chunks_ * ChunkSize < parties_.size()) {
+            Chunk* chunk = new (arena_) Chunk();
+            if (!chunk) {
+                // Drop participants that don't fit into allocated chunks.
+                (void)parties_.resize(num_chunks_ * ChunkSize);
+                return false;
+            }
+
+            // Chunk is linked before header mentioning it is published.
+            if (last_chunk_) {
+                last_chunk_->next = chunk;
+            } else {
+                first_chunk_ = chunk;
+            }
+            last_chunk_ = chunk;
+            num_chunks_++;
+        }
+
+        return true;
+    }
+
+    bool load_chunks_(uint64_t generation,
+                      ParticipantMetrics* party_metrics,
+                      size_t count) const {
+        Chunk* chunk = first_chunk_;
+
+        for (size_t off = 0; off < count; off += ChunkSize) {
+            roc_panic_if(!chunk);
+
+            ChunkData data;
+            if (!chunk->data.try_load(data) || data.generation != generation) {
+                return false;
+            }
+            for (size_t n = 0; n < ChunkSize && off + n < count; n++) {
+                party_metrics[off + n] = data.parties[n];
+            }
+
+            chunk = chunk->next;
+        }
+
+        return true;
+    }
+
+    core::IArena& arena_;
+
+    // Shared with readers.
+    core::Seqlock<Header> header_;
+    core::Atomic<Chunk*> first_chunk_;
+
+    // Used only by pipeline thread.
+    Chunk* last_chunk_;
+    size_t num_chunks_;
+    core::Array<ParticipantMetrics> parties_;
+    uint64_t generation_;
+    size_t published_count_;
+    core::nanoseconds_t publish_ts_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_METRICS_SNAPSHOT_H_
@@ -17,6 +17,9 @@ namespace {
 
 const core::nanoseconds_t StatsReportInterval = core::Minute;
 
+// Each new frame contributes 1/N to smoothed frame processing time.
+const core::nanoseconds_t FrameTimeSmoothing = 8;
+
 } // namespace
 
 PipelineLoop::PipelineLoop(IPipelineTaskScheduler& scheduler,
@@ -35,10 +38,15 @@ PipelineLoop::PipelineLoop(IPipelineTaskScheduler& scheduler,
     , processing_state_(ProcNotScheduled)
     , frame_processing_tid_(0)
     , next_frame_deadline_(0)
+    , refresh_deadline_(0)
+    , scheduled_refresh_deadline_(0)
+    , frame_processing_time_(0)
+    , frame_processing_avg_(0)
     , subframe_tasks_deadline_(0)
     , samples_processed_(0)
     , enough_samples_to_process_tasks_(false)
-    , rate_limiter_(StatsReportInterval) {
+    , rate_limiter_(StatsReportInterval)
+    , stats_snapshot_(Stats()) {
 }
 
 PipelineLoop::~PipelineLoop() {
@@ -52,6 +60,14 @@ const PipelineLoop::Stats& PipelineLoop::get_stats_ref() const {
     return stats_;
 }
 
+void PipelineLoop::load_stats(Stats& stats) const {
+    stats = stats_snapshot_.wait_load();
+}
+
+core::nanoseconds_t PipelineLoop::frame_processing_time() const {
+    return frame_processing_time_.wait_load();
+}
+
 size_t PipelineLoop::num_pending_tasks() const {
     return (size_t)pending_tasks_;
 }
@@ -60,6 +76,13 @@ size_t PipelineLoop::num_pending_frames() const {
     return (size_t)pending_frames_;
 }
 
+void PipelineLoop::request_refresh(core::nanoseconds_t deadline) {
+    refresh_deadline_.exclusive_store(deadline);
+}
+
+void PipelineLoop::refresh_imp() {
+}
+
 void PipelineLoop::schedule(PipelineTask& task, IPipelineTaskCompleter& completer) {
     if (task.state_ != PipelineTask::StateNew) {
         roc_panic("pipeline loop: attempt to schedule task more than once");
@@ -132,7 +155,7 @@ bool PipelineLoop::schedule_and_maybe_process_task_(PipelineTask& task) {
 
     pipeline_mutex_.unlock();
 
-    if (n_pending_frames == 0 && pending_tasks_ != 0) {
+    if (n_pending_frames == 0 && has_pending_work_()) {
         schedule_async_task_processing_();
     }
 
@@ -140,6 +163,12 @@ bool PipelineLoop::schedule_and_maybe_process_task_(PipelineTask& task) {
 }
 
 void PipelineLoop::process_tasks() {
+    if (processing_state_ == ProcRefreshScheduled) {
+        // refresh is not cancelled by frames, so allow concurrent frame to
+        // schedule next refresh while we're running
+        processing_state_ = ProcNotScheduled;
+    }
+
     const bool need_reschedule = maybe_process_tasks_();
 
     processing_state_ = ProcNotScheduled;
@@ -163,6 +192,10 @@ bool PipelineLoop::maybe_process_tasks_() {
 
     int n_pending_frames = 0;
 
+    if ((n_pending_frames = pending_frames_) == 0) {
+        maybe_refresh_();
+    }
+
     for (;;) {
         if (!interframe_task_processing_allowed_(next_frame_deadline)) {
             break;
@@ -189,7 +222,37 @@ bool PipelineLoop::maybe_process_tasks_() {
 
     pipeline_mutex_.unlock();
 
-    return (n_pending_frames == 0 && pending_tasks_ != 0);
+    return (n_pending_frames == 0 && has_pending_work_());
+}
+
+void PipelineLoop::maybe_refresh_() {
+    core::nanoseconds_t refresh_deadline = 0;
+    if (!refresh_deadline_.try_load(refresh_deadline) || refresh_deadline == 0) {
+        return;
+    }
+
+    if (timestamp_imp() < refresh_deadline) {
+        return;
+    }
+
+    // refresh_imp() may request next refresh
+    refresh_deadline_.exclusive_store(0);
+
+    refresh_imp();
+}
+
+bool PipelineLoop::has_pending_work_() const {
+    if (pending_tasks_ != 0) {
+        return true;
+    }
+
+    core::nanoseconds_t refresh_deadline = 0;
+    if (!refresh_deadline_.try_load(refresh_deadline)) {
+        // concurrent update, assume that refresh is requested
+        return true;
+    }
+
+    return refresh_deadline != 0;
 }
 
 bool PipelineLoop::process_subframes_and_tasks(audio::Frame& frame) {
@@ -206,11 +269,16 @@ bool PipelineLoop::process_subframes_and_tasks_simple_(audio::Frame& frame) {
 
     pipeline_mutex_.lock();
 
+    const core::nanoseconds_t frame_start_time = timestamp_imp();
+
     const bool frame_res = process_subframe_imp(frame);
 
+    update_frame_processing_time_(frame_start_time);
+    publish_stats_();
+
     pipeline_mutex_.unlock();
 
-    if (--pending_frames_ == 0 && pending_tasks_ != 0) {
+    if (--pending_frames_ == 0 && has_pending_work_()) {
         schedule_async_task_processing_();
     }
 
@@ -226,6 +294,8 @@ bool PipelineLoop::process_subframes_and_tasks_precise_(audio::Frame& frame) {
 
     pipeline_mutex_.lock();
 
+    const core::nanoseconds_t frame_proc_start_time = timestamp_imp();
+
     core::nanoseconds_t next_frame_deadline = 0;
 
     packet::stream_timestamp_t frame_pos = 0;
@@ -264,13 +334,15 @@ bool PipelineLoop::process_subframes_and_tasks_precise_(audio::Frame& frame) {
         }
     }
 
+    update_frame_processing_time_(frame_proc_start_time);
+    publish_stats_();
     report_stats_();
 
     frame_processing_tid_.exclusive_store(tid_imp());
 
     pipeline_mutex_.unlock();
 
-    if (--pending_frames_ == 0 && pending_tasks_ != 0) {
+    if (--pending_frames_ == 0 && has_pending_work_()) {
         schedule_async_task_processing_();
     }
 
@@ -287,7 +359,25 @@ void PipelineLoop::schedule_async_task_processing_() {
         return;
     }
 
-    if (processing_state_ == ProcNotScheduled) {
+    core::nanoseconds_t refresh_deadline = 0;
+    if (!refresh_deadline_.try_load(refresh_deadline)) {
+        refresh_deadline = 0;
+    }
+
+    if (pending_tasks_ == 0 && refresh_deadline != 0) {
+        // only refresh is pending, schedule processing at refresh deadline;
+        // if processing is already scheduled for earlier time, keep it
+        if (processing_state_ == ProcNotScheduled
+            || (processing_state_ == ProcRefreshScheduled
+                && refresh_deadline < scheduled_refresh_deadline_)) {
+            scheduler_.schedule_task_processing(*this, refresh_deadline);
+            stats_.scheduler_calls++;
+
+            scheduled_refresh_deadline_ = refresh_deadline;
+            processing_state_ = ProcRefreshScheduled;
+        }
+    } else if (processing_state_ == ProcNotScheduled
+               || processing_state_ == ProcRefreshScheduled) {
         core::nanoseconds_t deadline = 0;
 
         if (config_.enable_precise_task_scheduling) {
@@ -459,6 +549,30 @@ bool PipelineLoop::interframe_task_processing_allowed_(
         || now >= (next_frame_deadline + no_task_proc_half_interval_);
 }
 
+void PipelineLoop::update_frame_processing_time_(core::nanoseconds_t start_time) {
+    const core::nanoseconds_t elapsed = timestamp_imp() - start_time;
+
+    if (frame_processing_avg_ == 0) {
+        frame_processing_avg_ = elapsed;
+    } else {
+        frame_processing_avg_ += (elapsed - frame_processing_avg_) / FrameTimeSmoothing;
+    }
+
+    frame_processing_time_.exclusive_store(frame_processing_avg_);
+}
+
+void PipelineLoop::publish_stats_() {
+    // scheduler counters are updated under scheduler mutex; if it's busy,
+    // skip this frame instead of blocking, next frame will publish stats
+    if (!scheduler_mutex_.try_lock()) {
+        return;
+    }
+
+    stats_snapshot_.exclusive_store(stats_);
+
+    scheduler_mutex_.unlock();
+}
+
 void PipelineLoop::report_stats_() {
     if (!rate_limiter_.would_allow()) {
         return;
@@ -196,6 +196,20 @@ struct PipelineLoopConfig {
 //! either schedule or cancel asynchronous task processing, depending on whether
 //! there are pending tasks and frames.
 //!
+//! Refresh without frames
+//! ----------------------
+//!
+//! Some pipelines have work that is driven by time rather than by frames, e.g.
+//! sending delayed packets. Such pipeline calls request_refresh() during frame or
+//! task processing with the time when it wants to be refreshed. If no frame is
+//! processed by that time, pipeline asks IPipelineTaskScheduler to invoke
+//! process_tasks() at that time, which in turn invokes refresh_imp().
+//!
+//! Unlike task processing, refresh is not cancelled when a frame is processed,
+//! because in this case it's usually just re-requested with a later deadline.
+//! The next process_tasks() call will either refresh the pipeline or reschedule
+//! itself to the new deadline.
+//!
 //! Lock-free operations
 //! --------------------
 //!
@@ -235,17 +249,6 @@ struct PipelineLoopConfig {
 //! comments in the source code of the benchmarks.
 class PipelineLoop : public core::NonCopyable<> {
 public:
-    //! Enqueue a task for asynchronous execution.
-    void schedule(PipelineTask& task, IPipelineTaskCompleter& completer);
-
-    //! Enqueue a task for asynchronous execution and wait until it finishes.
-    //! @returns false if the task fails.
-    bool schedule_and_wait(PipelineTask& task);
-
-    //! Process some of the enqueued tasks, if any.
-    void process_tasks();
-
-protected:
     //! Task processing statistics.
     struct Stats {
         //! Total number of tasks processed.
@@ -276,6 +279,23 @@ protected:
         }
     };
 
+    //! Enqueue a task for asynchronous execution.
+    void schedule(PipelineTask& task, IPipelineTaskCompleter& completer);
+
+    //! Enqueue a task for asynchronous execution and wait until it finishes.
+    //! @returns false if the task fails.
+    bool schedule_and_wait(PipelineTask& task);
+
+    //! Process some of the enqueued tasks, if any.
+    void process_tasks();
+
+    //! Get copy of task processing statistics.
+    //! @remarks
+    //!  Returns snapshot published by frame processing thread, which may be
+    //!  slightly outdated. Can be called from any thread. Lock-free.
+    void load_stats(Stats& stats) const;
+
+protected:
     //! Initialization.
     PipelineLoop(IPipelineTaskScheduler& scheduler,
                  const PipelineLoopConfig& config,
@@ -293,6 +313,12 @@ protected:
     //! Returned object can't be accessed concurrently with other methods.
     const Stats& get_stats_ref() const;
 
+    //! Get average time spent processing one frame.
+    //! @remarks
+    //!  Includes tasks processed in-frame. Exponentially smoothed.
+    //!  Can be called from any thread. Lock-free.
+    core::nanoseconds_t frame_processing_time() const;
+
     //! Split frame and process subframes and some of the enqueued tasks.
     bool process_subframes_and_tasks(audio::Frame& frame);
 
@@ -308,14 +334,30 @@ protected:
     //! Process task.
     virtual bool process_task_imp(PipelineTask& task) = 0;
 
+    //! Request refresh_imp() invocation at given time.
+    //! @remarks
+    //!  Should be called from process_subframe_imp(), process_task_imp(), or
+    //!  refresh_imp(). @p deadline is absolute time in units of timestamp_imp().
+    //!  If no frame is processed until @p deadline, refresh_imp() will be invoked
+    //!  from process_tasks(). Zero deadline cancels the request.
+    void request_refresh(core::nanoseconds_t deadline);
+
+    //! Refresh pipeline when no frames are processed.
+    //! @remarks
+    //!  Invoked from process_tasks() when deadline passed to request_refresh()
+    //!  expires. Default implementation does nothing.
+    virtual void refresh_imp();
+
 private:
-    enum ProcState { ProcNotScheduled, ProcScheduled, ProcRunning };
+    enum ProcState { ProcNotScheduled, ProcScheduled, ProcRefreshScheduled, ProcRunning };
 
     bool process_subframes_and_tasks_simple_(audio::Frame& frame);
     bool process_subframes_and_tasks_precise_(audio::Frame& frame);
 
     bool schedule_and_maybe_process_task_(PipelineTask& task);
     bool maybe_process_tasks_();
+    void maybe_refresh_();
+    bool has_pending_work_() const;
 
     void schedule_async_task_processing_();
     void cancel_async_task_processing_();
@@ -334,6 +376,8 @@ private:
     bool
     interframe_task_processing_allowed_(core::nanoseconds_t next_frame_deadline) const;
 
+    void update_frame_processing_time_(core::nanoseconds_t start_time);
+    void publish_stats_();
     void report_stats_();
 
     // configuration
@@ -373,6 +417,16 @@ private:
     // when next frame is expected to be started
     core::Seqlock<core::nanoseconds_t> next_frame_deadline_;
 
+    // when refresh_imp() should be invoked, if no frames are processed
+    core::Seqlock<core::nanoseconds_t> refresh_deadline_;
+
+    // deadline of scheduled asynchronous processing in ProcRefreshScheduled state
+    core::nanoseconds_t scheduled_refresh_deadline_;
+
+    // smoothed time spent processing one frame
+    core::Seqlock<core::nanoseconds_t> frame_processing_time_;
+    core::nanoseconds_t frame_processing_avg_;
+
     // when task processing before next sub-frame ends
     core::nanoseconds_t subframe_tasks_deadline_;
 
@@ -385,6 +439,7 @@ private:
     // task processing statistics
     core::RateLimiter rate_limiter_;
     Stats stats_;
+    core::Seqlock<Stats> stats_snapshot_;
 };
 
 } // namespace pipeline
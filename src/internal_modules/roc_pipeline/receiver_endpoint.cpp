@@ -19,6 +19,7 @@ namespace roc {
 namespace pipeline {
 
 ReceiverEndpoint::ReceiverEndpoint(address::Protocol proto,
+                                   const ReceiverCommonConfig& common_config,
                                    StateTracker& state_tracker,
                                    ReceiverSessionGroup& session_group,
                                    const rtp::EncodingMap& encoding_map,
@@ -32,6 +33,7 @@ ReceiverEndpoint::ReceiverEndpoint(address::Protocol proto,
     , composer_(NULL)
     , parser_(NULL)
     , inbound_address_(inbound_address)
+    , inline_parsing_(common_config.enable_inline_parsing)
     , valid_(false) {
     packet::IComposer* composer = NULL;
     packet::IParser* parser = NULL;
@@ -198,8 +200,9 @@ status::StatusCode ReceiverEndpoint::pull_packets(core::nanoseconds_t current_ti
     // queue were added in a very short time or are being added currently. It's
     // acceptable to consider such packets late and pull them next time.
     while (packet::PacketPtr packet = inbound_queue_.try_pop_front_exclusive()) {
-        if (!parser_->parse(*packet, packet->buffer())) {
-            roc_log(LogDebug, "receiver endpoint: can't parse packet");
+        // If inline parsing is enabled, packet was already parsed in write().
+        if (!inline_parsing_ && !parse_packet_(*packet)) {
+            state_tracker_.add_pending_packets(-1);
             continue;
         }
 
@@ -220,11 +223,38 @@ status::StatusCode ReceiverEndpoint::write(const packet::PacketPtr& packet) {
     roc_panic_if(!packet);
     roc_panic_if(!parser_);
 
+    // If inline parsing is enabled, parse packet right here on network thread,
+    // so that junk is dropped before it is enqueued and pipeline thread only
+    // has to route already classified packets. Parsers are stateless and
+    // encoding map is thread-safe, so it's safe to do it concurrently with
+    // pipeline thread.
+    if (inline_parsing_ && !parse_packet_(*packet)) {
+        return status::StatusOK;
+    }
+
     state_tracker_.add_pending_packets(+1);
     inbound_queue_.push_back(*packet);
 
     return status::StatusOK;
 }
 
+bool ReceiverEndpoint::parse_packet_(packet::Packet& packet) {
+    if (!parser_->parse(packet, packet.buffer())) {
+        roc_log(LogDebug, "receiver endpoint: can't parse packet");
+        return false;
+    }
+
+    // When parsing early, also drop RTP packets with payload type unknown to
+    // encoding map, since session can't be created for them anyway.
+    if (inline_parsing_ && packet.has_flags(packet::Packet::FlagRTP)
+        && !packet.has_flags(packet::Packet::FlagAudio)) {
+        roc_log(LogDebug, "receiver endpoint: unknown payload type %u",
+                (unsigned)packet.rtp()->payload_type);
+        return false;
+    }
+
+    return true;
+}
+
 } // namespace pipeline
 } // namespace roc
@@ -45,6 +45,7 @@ class ReceiverEndpoint : public core::RefCounted<ReceiverEndpoint, core::ArenaAl
 public:
     //! Initialize.
     ReceiverEndpoint(address::Protocol proto,
+                     const ReceiverCommonConfig& common_config,
                      StateTracker& state_tracker,
                      ReceiverSessionGroup& session_group,
                      const rtp::EncodingMap& encoding_map,
@@ -86,6 +87,8 @@ public:
     //!  Packets passed to this writer will be pulled into pipeline.
     //!  This writer is thread-safe and lock-free, packets can be written
     //!  to it from netio thread.
+    //!  If inline parsing is enabled, packets are parsed inside write(),
+    //!  and malformed packets are dropped before entering the queue.
     packet::IWriter& inbound_writer();
 
     //! Pull packets written to inbound writer into pipeline.
@@ -98,6 +101,8 @@ public:
 private:
     virtual ROC_ATTR_NODISCARD status::StatusCode write(const packet::PacketPtr& packet);
 
+    bool parse_packet_(packet::Packet& packet);
+
     const address::Protocol proto_;
 
     StateTracker& state_tracker_;
@@ -118,6 +123,9 @@ private:
     address::SocketAddr inbound_address_;
     core::MpscQueue<packet::Packet> inbound_queue_;
 
+    // If true, packets are parsed in write() on network thread.
+    const bool inline_parsing_;
+
     bool valid_;
 };
 
@@ -89,6 +89,7 @@ packet::IWriter* ReceiverLoop::Tasks::AddEndpoint::get_inbound_writer() const {
 ReceiverLoop::ReceiverLoop(IPipelineTaskScheduler& scheduler,
                            const ReceiverSourceConfig& source_config,
                            const rtp::EncodingMap& encoding_map,
+                           audio::SincTableMap& sinc_table_map,
                            core::IPool& packet_pool,
                            core::IPool& packet_buffer_pool,
                            core::IPool& frame_buffer_pool,
@@ -97,6 +98,7 @@ ReceiverLoop::ReceiverLoop(IPipelineTaskScheduler& scheduler,
         scheduler, source_config.pipeline_loop, source_config.common.output_sample_spec)
     , source_(source_config,
               encoding_map,
+              sinc_table_map,
               packet_pool,
               packet_buffer_pool,
               frame_buffer_pool,
@@ -129,6 +131,46 @@ sndio::ISource& ReceiverLoop::source() {
     return *this;
 }
 
+bool ReceiverLoop::load_slot_metrics(SlotHandle slot_handle,
+                                     ReceiverSlotMetrics& slot_metrics,
+                                     ReceiverParticipantMetrics* party_metrics,
+                                     size_t* party_count) {
+    roc_panic_if(!is_valid());
+
+    if (!slot_handle) {
+        roc_panic("receiver loop: slot handle is null");
+    }
+
+    ReceiverSlot* slot = (ReceiverSlot*)slot_handle;
+
+    if (!slot->load_metrics(slot_metrics, party_metrics, party_count)) {
+        return false;
+    }
+
+    slot_metrics.frame_processing_time = frame_processing_time();
+    return true;
+}
+
+bool ReceiverLoop::load_slot_metrics(
+    SlotHandle slot_handle,
+    ReceiverSlotMetrics& slot_metrics,
+    core::Array<ReceiverParticipantMetrics>& party_metrics) {
+    roc_panic_if(!is_valid());
+
+    if (!slot_handle) {
+        roc_panic("receiver loop: slot handle is null");
+    }
+
+    ReceiverSlot* slot = (ReceiverSlot*)slot_handle;
+
+    if (!slot->load_metrics(slot_metrics, party_metrics)) {
+        return false;
+    }
+
+    slot_metrics.frame_processing_time = frame_processing_time();
+    return true;
+}
+
 sndio::ISink* ReceiverLoop::to_sink() {
     roc_panic_if(!is_valid());
 
@@ -287,6 +329,8 @@ bool ReceiverLoop::task_query_slot_(Task& task) {
     roc_panic_if(!task.slot_metrics_);
 
     task.slot_->get_metrics(*task.slot_metrics_, task.party_metrics_, task.party_count_);
+    task.slot_metrics_->frame_processing_time = frame_processing_time();
+
     return true;
 }
 
@@ -12,6 +12,7 @@
 #ifndef ROC_PIPELINE_RECEIVER_LOOP_H_
 #define ROC_PIPELINE_RECEIVER_LOOP_H_
 
+#include "roc_core/array.h"
 #include "roc_core/iarena.h"
 #include "roc_core/ipool.h"
 #include "roc_core/mutex.h"
@@ -125,6 +126,7 @@ public:
     ReceiverLoop(IPipelineTaskScheduler& scheduler,
                  const ReceiverSourceConfig& source_config,
                  const rtp::EncodingMap& encoding_map,
+                 audio::SincTableMap& sinc_table_map,
                  core::IPool& packet_pool,
                  core::IPool& packet_buffer_pool,
                  core::IPool& frame_buffer_pool,
@@ -138,6 +140,27 @@ public:
     //!  Samples received from remote peers become available in this source.
     sndio::ISource& source();
 
+    //! Get snapshot of slot metrics.
+    //! @remarks
+    //!  Reads snapshot last published by pipeline thread during refresh.
+    //!  Lock-free and never waits for pipeline, so can be called from any
+    //!  thread, but slot should not be deleted concurrently.
+    //! @returns
+    //!  false if consistent snapshot can't be read because it's being
+    //!  republished concurrently.
+    bool load_slot_metrics(SlotHandle slot,
+                           ReceiverSlotMetrics& slot_metrics,
+                           ReceiverParticipantMetrics* party_metrics,
+                           size_t* party_count);
+
+    //! Get snapshot of slot metrics.
+    //! @remarks
+    //!  Same as above, but resizes @p party_metrics to the number of
+    //!  participants in snapshot, so that they're read at once.
+    bool load_slot_metrics(SlotHandle slot,
+                           ReceiverSlotMetrics& slot_metrics,
+                           core::Array<ReceiverParticipantMetrics>& party_metrics);
+
 private:
     // Methods of sndio::ISource
     virtual sndio::ISink* to_sink();
@@ -7,6 +7,9 @@
  */
 
 #include "roc_pipeline/receiver_session.h"
+#include "roc_audio/beep_plc.h"
+#include "roc_audio/integer_ops.h"
+#include "roc_audio/pitch_plc.h"
 #include "roc_audio/resampler_map.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
@@ -18,11 +21,13 @@ namespace pipeline {
 ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
                                  const ReceiverCommonConfig& common_config,
                                  const rtp::EncodingMap& encoding_map,
+                                 audio::SincTableMap& sinc_table_map,
                                  packet::PacketFactory& packet_factory,
                                  audio::FrameFactory& frame_factory,
                                  core::IArena& arena)
     : core::RefCounted<ReceiverSession, core::ArenaAllocation>(arena)
     , frame_reader_(NULL)
+    , sample_rate_(common_config.output_sample_spec.sample_rate())
     , valid_(false) {
     const rtp::Encoding* pkt_encoding =
         encoding_map.find_by_pt(session_config.payload_type);
@@ -76,8 +81,13 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
     }
     pkt_reader = filter_.get();
 
+    // With fast start, playback begins when start latency is buffered,
+    // and latency tuner then grows latency up to the target.
     delayed_reader_.reset(new (delayed_reader_) packet::DelayedReader(
-        *pkt_reader, session_config.latency.target_latency, pkt_encoding->sample_spec));
+        *pkt_reader,
+        session_config.latency.start_latency > 0 ? session_config.latency.start_latency
+                                                 : session_config.latency.target_latency,
+        pkt_encoding->sample_spec));
     if (!delayed_reader_ || !delayed_reader_->is_valid()) {
         return;
     }
@@ -146,13 +156,57 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
     // from packet readers pipeline.
     audio::IFrameReader* frm_reader = NULL;
 
+    const bool use_resampler =
+        session_config.latency.tuner_profile != audio::LatencyTunerProfile_Intact
+        || pkt_encoding->sample_spec.sample_rate()
+            != common_config.output_sample_spec.sample_rate();
+
+    const bool use_mapping = pkt_encoding->sample_spec.channel_set()
+        != common_config.output_sample_spec.channel_set();
+
+    // If integer processing format is requested, resampler works in it when
+    // backend supports it. Other elements before resampler work in it only
+    // if all of them support it.
+    const bool use_integer =
+        audio::is_integer_format(common_config.processing_format);
+    const bool integer_resampler = use_integer && use_resampler
+        && audio::ResamplerMap::instance().supports_integer(
+            session_config.resampler.backend);
+
+    bool early_integer = false;
+
     {
-        const audio::SampleSpec out_spec(pkt_encoding->sample_spec.sample_rate(),
+        const audio::SampleSpec plc_spec(pkt_encoding->sample_spec.sample_rate(),
                                          audio::Sample_RawFormat,
                                          pkt_encoding->sample_spec.channel_set());
 
+        if (session_config.enable_beeping) {
+            plc_.reset(new (arena) audio::BeepPlc(plc_spec), arena);
+            if (!plc_) {
+                return;
+            }
+        } else if (session_config.plc.backend == audio::PlcBackend_Pitch) {
+            audio::PitchPlc* pitch_plc = new (arena) audio::PitchPlc(plc_spec, arena);
+            plc_.reset(pitch_plc, arena);
+            if (!plc_ || !pitch_plc->is_valid()) {
+                return;
+            }
+        }
+
+        // PLC and channel mapper work only with raw samples, and decoders
+        // other than PCM can't produce integer samples.
+        early_integer = use_integer && !plc_ && !use_mapping
+            && (!use_resampler || integer_resampler)
+            && pkt_encoding->sample_spec.sample_format() == audio::SampleFormat_Pcm;
+
+        const audio::SampleSpec out_spec(pkt_encoding->sample_spec.sample_rate(),
+                                         early_integer
+                                             ? common_config.processing_format
+                                             : audio::Sample_RawFormat,
+                                         pkt_encoding->sample_spec.channel_set());
+
         depacketizer_.reset(new (depacketizer_) audio::Depacketizer(
-            *pkt_reader, *payload_decoder_, out_spec, session_config.enable_beeping));
+            *pkt_reader, *payload_decoder_, out_spec, plc_.get()));
         if (!depacketizer_ || !depacketizer_->is_valid()) {
             return;
         }
@@ -169,15 +223,42 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
         }
     }
 
-    if (pkt_encoding->sample_spec.channel_set()
-        != common_config.output_sample_spec.channel_set()) {
+    // Decoded samples are interleaved. If planar layout is requested, switch
+    // to it before channel mapper, unless resampler backend can't handle it;
+    // in this case switch after resampler.
+    const bool use_planar =
+        common_config.processing_layout == audio::SampleLayout_Planar;
+    const bool early_planar = use_planar
+        && (!use_resampler
+            || audio::ResamplerMap::instance().supports_planar(
+                session_config.resampler.backend));
+
+    if (early_planar) {
         const audio::SampleSpec in_spec(pkt_encoding->sample_spec.sample_rate(),
                                         audio::Sample_RawFormat,
                                         pkt_encoding->sample_spec.channel_set());
 
-        const audio::SampleSpec out_spec(pkt_encoding->sample_spec.sample_rate(),
-                                         audio::Sample_RawFormat,
-                                         common_config.output_sample_spec.channel_set());
+        audio::SampleSpec out_spec = in_spec;
+        out_spec.set_sample_layout(audio::SampleLayout_Planar);
+
+        if (!init_converter_(frm_reader, frame_factory, in_spec, out_spec)) {
+            return;
+        }
+    }
+
+    const audio::SampleLayout early_layout =
+        early_planar ? audio::SampleLayout_Planar : audio::SampleLayout_Interleaved;
+
+    if (use_mapping) {
+        audio::SampleSpec in_spec(pkt_encoding->sample_spec.sample_rate(),
+                                  audio::Sample_RawFormat,
+                                  pkt_encoding->sample_spec.channel_set());
+        in_spec.set_sample_layout(early_layout);
+
+        audio::SampleSpec out_spec(pkt_encoding->sample_spec.sample_rate(),
+                                   audio::Sample_RawFormat,
+                                   common_config.output_sample_spec.channel_set());
+        out_spec.set_sample_layout(early_layout);
 
         channel_mapper_reader_.reset(
             new (channel_mapper_reader_) audio::ChannelMapperReader(
@@ -188,19 +269,40 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
         frm_reader = channel_mapper_reader_.get();
     }
 
-    if (session_config.latency.tuner_profile != audio::LatencyTunerProfile_Intact
-        || pkt_encoding->sample_spec.sample_rate()
-            != common_config.output_sample_spec.sample_rate()) {
+    // If samples were decoded as raw, but resampler can work with integer
+    // format, switch to integer format before resampler.
+    if (integer_resampler && !early_integer) {
         const audio::SampleSpec in_spec(pkt_encoding->sample_spec.sample_rate(),
                                         audio::Sample_RawFormat,
                                         common_config.output_sample_spec.channel_set());
 
-        const audio::SampleSpec out_spec(common_config.output_sample_spec.sample_rate(),
-                                         audio::Sample_RawFormat,
+        const audio::SampleSpec out_spec(pkt_encoding->sample_spec.sample_rate(),
+                                         common_config.processing_format,
                                          common_config.output_sample_spec.channel_set());
 
+        if (!init_converter_(frm_reader, frame_factory, in_spec, out_spec)) {
+            return;
+        }
+    }
+
+    if (use_resampler) {
+        const audio::PcmFormat resampler_format = integer_resampler
+            ? common_config.processing_format
+            : audio::Sample_RawFormat;
+
+        audio::SampleSpec in_spec(pkt_encoding->sample_spec.sample_rate(),
+                                  resampler_format,
+                                  common_config.output_sample_spec.channel_set());
+        in_spec.set_sample_layout(early_layout);
+
+        audio::SampleSpec out_spec(common_config.output_sample_spec.sample_rate(),
+                                   resampler_format,
+                                   common_config.output_sample_spec.channel_set());
+        out_spec.set_sample_layout(early_layout);
+
         resampler_.reset(audio::ResamplerMap::instance().new_resampler(
-            arena, frame_factory, session_config.resampler, in_spec, out_spec));
+            arena, frame_factory, sinc_table_map, session_config.resampler, in_spec,
+            out_spec));
         if (!resampler_) {
             return;
         }
@@ -213,6 +315,23 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
         frm_reader = resampler_reader_.get();
     }
 
+    // Otherwise, switch to requested layout or integer format after resampler.
+    if ((use_planar && !early_planar)
+        || (use_integer && !early_integer && !integer_resampler)) {
+        const audio::SampleSpec in_spec(common_config.output_sample_spec.sample_rate(),
+                                        audio::Sample_RawFormat,
+                                        common_config.output_sample_spec.channel_set());
+
+        audio::SampleSpec out_spec(common_config.output_sample_spec.sample_rate(),
+                                   common_config.processing_format,
+                                   common_config.output_sample_spec.channel_set());
+        out_spec.set_sample_layout(common_config.processing_layout);
+
+        if (!init_converter_(frm_reader, frame_factory, in_spec, out_spec)) {
+            return;
+        }
+    }
+
     latency_monitor_.reset(new (latency_monitor_) audio::LatencyMonitor(
         *frm_reader, *source_queue_, *depacketizer_, *source_meter_,
         resampler_reader_.get(), session_config.latency, pkt_encoding->sample_spec,
@@ -222,6 +341,17 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
     }
     frm_reader = latency_monitor_.get();
 
+    if (common_config.max_session_load > 0) {
+        // Measure processing time of session for admission control.
+        profiling_reader_.reset(new (profiling_reader_) audio::ProfilingReader(
+            *frm_reader, arena, common_config.output_sample_spec,
+            common_config.profiler));
+        if (!profiling_reader_ || !profiling_reader_->is_valid()) {
+            return;
+        }
+        frm_reader = profiling_reader_.get();
+    }
+
     if (!frm_reader) {
         return;
     }
@@ -304,7 +434,7 @@ void ReceiverSession::generate_reports(const char* report_cname,
     if (n_reports > 0 && packet_router_->has_source_id(packet::Packet::FlagAudio)
         && source_meter_->has_metrics() && source_meter_->has_encoding()) {
         const audio::LatencyMetrics& latency_metrics = latency_monitor_->metrics();
-        const packet::LinkMetrics& link_metrics = source_meter_->metrics();
+        const packet::LinkMetrics link_metrics = link_metrics_();
 
         rtcp::RecvReport& report = *reports;
 
@@ -322,6 +452,10 @@ void ReceiverSession::generate_reports(const char* report_cname,
         report.niq_latency = latency_metrics.niq_latency;
         report.niq_stalling = latency_metrics.niq_stalling;
         report.e2e_latency = latency_metrics.e2e_latency;
+        report.fec_repaired_packets = link_metrics.fec_repaired_packets;
+        report.fec_unrepaired_packets = link_metrics.fec_unrepaired_packets;
+        report.late_packets = link_metrics.late_packets;
+        report.concealed_duration = link_metrics.concealed_duration;
 
         reports++;
         n_reports--;
@@ -367,11 +501,78 @@ ReceiverParticipantMetrics ReceiverSession::get_metrics() const {
     roc_panic_if(!is_valid());
 
     ReceiverParticipantMetrics metrics;
-    metrics.link = source_meter_->metrics();
+    if (packet_router_->has_source_id(packet::Packet::FlagAudio)) {
+        metrics.source_id = packet_router_->get_source_id(packet::Packet::FlagAudio);
+    }
+    metrics.link = link_metrics_();
     metrics.latency = latency_monitor_->metrics();
+    metrics.resampler_scaling = latency_monitor_->scaling();
 
     return metrics;
 }
 
+packet::LinkMetrics ReceiverSession::link_metrics_() const {
+    // Link meter reports losses on network. Add information on how
+    // losses were recovered after that, using FEC and PLC.
+    packet::LinkMetrics metrics = source_meter_->metrics();
+
+    if (fec_reader_) {
+        metrics.fec_repaired_packets = fec_reader_->num_repaired_packets();
+    }
+
+    if (metrics.lost_packets > 0
+        && (uint64_t)metrics.lost_packets > metrics.fec_repaired_packets) {
+        metrics.fec_unrepaired_packets =
+            (uint64_t)metrics.lost_packets - metrics.fec_repaired_packets;
+    }
+
+    const audio::DepacketizerMetrics& depacketizer_metrics = depacketizer_->metrics();
+
+    metrics.late_packets = depacketizer_metrics.late_packets;
+
+    if (source_meter_->has_encoding()) {
+        metrics.concealed_duration =
+            core::nanoseconds_t((double)depacketizer_metrics.missing_samples
+                                * core::Second
+                                / source_meter_->encoding().sample_spec.sample_rate());
+    }
+
+    return metrics;
+}
+
+float ReceiverSession::processing_load() {
+    roc_panic_if(!is_valid());
+
+    if (!profiling_reader_) {
+        return 0;
+    }
+
+    const float speed = profiling_reader_->get_moving_avg();
+    if (speed <= 0) {
+        return 0;
+    }
+
+    return (float)sample_rate_ / speed;
+}
+
+// Insert converter from interleaved raw samples to planar layout or to
+// integer format. Planar layout and integer format are mutually exclusive,
+// so there is at most one converter per session.
+bool ReceiverSession::init_converter_(audio::IFrameReader*& frm_reader,
+                                      audio::FrameFactory& frame_factory,
+                                      const audio::SampleSpec& in_spec,
+                                      const audio::SampleSpec& out_spec) {
+    roc_panic_if_msg(converter_, "receiver session: converter already created");
+
+    converter_.reset(new (converter_) audio::PcmMapperReader(*frm_reader, frame_factory,
+                                                            in_spec, out_spec));
+    if (!converter_ || !converter_->is_valid()) {
+        return false;
+    }
+    frm_reader = converter_.get();
+
+    return true;
+}
+
 } // namespace pipeline
 } // namespace roc
@@ -18,9 +18,13 @@
 #include "roc_audio/frame_factory.h"
 #include "roc_audio/iframe_decoder.h"
 #include "roc_audio/iframe_reader.h"
+#include "roc_audio/iplc.h"
 #include "roc_audio/iresampler.h"
 #include "roc_audio/latency_monitor.h"
+#include "roc_audio/pcm_mapper_reader.h"
+#include "roc_audio/profiling_reader.h"
 #include "roc_audio/resampler_reader.h"
+#include "roc_audio/sinc_table_map.h"
 #include "roc_audio/watchdog.h"
 #include "roc_core/iarena.h"
 #include "roc_core/list_node.h"
@@ -62,6 +66,7 @@ public:
     ReceiverSession(const ReceiverSessionConfig& session_config,
                     const ReceiverCommonConfig& common_config,
                     const rtp::EncodingMap& encoding_map,
+                    audio::SincTableMap& sinc_table_map,
                     packet::PacketFactory& packet_factory,
                     audio::FrameFactory& frame_factory,
                     core::IArena& arena);
@@ -115,7 +120,21 @@ public:
     //! Get session metrics.
     ReceiverParticipantMetrics get_metrics() const;
 
+    //! Get processing load of session.
+    //! @remarks
+    //!  Returns time spent on producing frames divided by their duration,
+    //!  averaged over profiling interval. Returns zero if processing time
+    //!  is not measured.
+    float processing_load();
+
 private:
+    bool init_converter_(audio::IFrameReader*& frm_reader,
+                         audio::FrameFactory& frame_factory,
+                         const audio::SampleSpec& in_spec,
+                         const audio::SampleSpec& out_spec);
+
+    packet::LinkMetrics link_metrics_() const;
+
     audio::IFrameReader* frame_reader_;
 
     core::Optional<packet::Router> packet_router_;
@@ -139,8 +158,11 @@ private:
 
     core::Optional<rtp::TimestampInjector> timestamp_injector_;
 
+    core::ScopedPtr<audio::IPlc> plc_;
     core::Optional<audio::Depacketizer> depacketizer_;
 
+    core::Optional<audio::PcmMapperReader> converter_;
+
     core::Optional<audio::ChannelMapperReader> channel_mapper_reader_;
 
     core::Optional<audio::ResamplerReader> resampler_reader_;
@@ -148,6 +170,10 @@ private:
 
     core::Optional<audio::LatencyMonitor> latency_monitor_;
 
+    core::Optional<audio::ProfilingReader> profiling_reader_;
+
+    const size_t sample_rate_;
+
     bool valid_;
 };
 
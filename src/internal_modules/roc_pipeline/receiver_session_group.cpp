@@ -16,23 +16,38 @@
 namespace roc {
 namespace pipeline {
 
+namespace {
+
+// How often to log rejected sessions.
+const core::nanoseconds_t RejectLogInterval = 5 * core::Second;
+
+} // namespace
+
 ReceiverSessionGroup::ReceiverSessionGroup(const ReceiverSourceConfig& source_config,
                                            const ReceiverSlotConfig& slot_config,
                                            StateTracker& state_tracker,
+                                           AdmissionController& admission_controller,
                                            audio::Mixer& mixer,
                                            const rtp::EncodingMap& encoding_map,
+                                           audio::SincTableMap& sinc_table_map,
                                            packet::PacketFactory& packet_factory,
                                            audio::FrameFactory& frame_factory,
                                            core::IArena& arena)
     : source_config_(source_config)
     , slot_config_(slot_config)
     , state_tracker_(state_tracker)
+    , admission_controller_(admission_controller)
     , mixer_(mixer)
     , encoding_map_(encoding_map)
+    , sinc_table_map_(sinc_table_map)
     , arena_(arena)
     , packet_factory_(packet_factory)
     , frame_factory_(frame_factory)
     , session_router_(arena)
+    , num_admitted_(0)
+    , num_rejected_(0)
+    , num_shed_(0)
+    , reject_log_limiter_(RejectLogInterval)
     , valid_(false) {
     identity_.reset(new (identity_) rtp::Identity());
     if (!identity_ || !identity_->is_valid()) {
@@ -79,7 +94,7 @@ status::StatusCode ReceiverSessionGroup::route_packet(const packet::PacketPtr& p
         return route_control_packet_(packet, current_time);
     }
 
-    return route_transport_packet_(packet);
+    return route_transport_packet_(packet, current_time);
 }
 
 core::nanoseconds_t
@@ -145,11 +160,80 @@ size_t ReceiverSessionGroup::num_sessions() const {
     return sessions_.size();
 }
 
+SessionPriority ReceiverSessionGroup::session_priority() const {
+    return slot_config_.session_priority;
+}
+
+SessionLoad ReceiverSessionGroup::processing_load() {
+    roc_panic_if(!is_valid());
+
+    SessionLoad load;
+
+    for (core::SharedPtr<ReceiverSession> sess = sessions_.front(); sess;
+         sess = sessions_.nextof(*sess)) {
+        const float sess_load = sess->processing_load();
+
+        if (sess_load <= 0) {
+            // Not measured yet.
+            load.n_unmeasured++;
+            continue;
+        }
+
+        load.measured_load += sess_load;
+        load.max_load = std::max(load.max_load, sess_load);
+        load.n_measured++;
+    }
+
+    return load;
+}
+
+void ReceiverSessionGroup::shed_session(core::nanoseconds_t current_time) {
+    roc_panic_if(!is_valid());
+
+    core::SharedPtr<ReceiverSession> victim;
+    float victim_load = -1;
+
+    for (core::SharedPtr<ReceiverSession> sess = sessions_.front(); sess;
+         sess = sessions_.nextof(*sess)) {
+        const float sess_load = sess->processing_load();
+
+        if (sess_load > victim_load) {
+            victim = sess;
+            victim_load = sess_load;
+        }
+    }
+
+    if (!victim) {
+        return;
+    }
+
+    roc_log(LogInfo,
+            "session group: receiver is overloaded, shedding session:"
+            " session_load=%.3f total_load=%.3f",
+            (double)victim_load, (double)admission_controller_.load());
+
+    // Don't let the sender re-create session right away.
+    address::SocketAddr source_addr;
+    bool has_source_id = false;
+    packet::stream_source_t source_id = 0;
+
+    if (session_router_.get_session_source(victim, source_addr, has_source_id,
+                                           source_id)) {
+        admission_controller_.deny(source_addr, has_source_id, source_id, current_time);
+    }
+
+    remove_session_(victim);
+    num_shed_++;
+}
+
 void ReceiverSessionGroup::get_slot_metrics(ReceiverSlotMetrics& slot_metrics) const {
     roc_panic_if(!is_valid());
 
     slot_metrics.source_id = identity_->ssrc();
     slot_metrics.num_participants = sessions_.size();
+    slot_metrics.num_admitted_sessions = num_admitted_;
+    slot_metrics.num_rejected_sessions = num_rejected_;
+    slot_metrics.num_shed_sessions = num_shed_;
 }
 
 void ReceiverSessionGroup::get_participant_metrics(
@@ -278,7 +362,8 @@ void ReceiverSessionGroup::halt_recv_stream(packet::stream_source_t send_source_
 }
 
 status::StatusCode
-ReceiverSessionGroup::route_transport_packet_(const packet::PacketPtr& packet) {
+ReceiverSessionGroup::route_transport_packet_(const packet::PacketPtr& packet,
+                                              core::nanoseconds_t current_time) {
     core::SharedPtr<ReceiverSession> sess;
 
     if (slot_config_.enable_routing) {
@@ -319,7 +404,7 @@ ReceiverSessionGroup::route_transport_packet_(const packet::PacketPtr& packet) {
     }
 
     // Session not found, auto-create session if possible.
-    if (can_create_session_(packet)) {
+    if (can_create_session_(packet, current_time)) {
         return create_session_(packet);
     }
 
@@ -339,12 +424,40 @@ ReceiverSessionGroup::route_control_packet_(const packet::PacketPtr& packet,
     return rtcp_communicator_->process_packet(packet, current_time);
 }
 
-bool ReceiverSessionGroup::can_create_session_(const packet::PacketPtr& packet) {
+bool ReceiverSessionGroup::can_create_session_(const packet::PacketPtr& packet,
+                                               core::nanoseconds_t current_time) {
     if (packet->has_flags(packet::Packet::FlagRepair)) {
         roc_log(LogDebug, "session group: ignoring repair packet for unknown session");
         return false;
     }
 
+    if (packet->udp()
+        && admission_controller_.is_denied(packet->udp()->src_addr,
+                                           packet->has_source_id(), packet->source_id(),
+                                           current_time)) {
+        num_rejected_++;
+        if (reject_log_limiter_.allow()) {
+            roc_log(LogInfo,
+                    "session group: rejecting new session, sender was recently shed:"
+                    " src_addr=%s n_rejected=%lu",
+                    address::socket_addr_to_str(packet->udp()->src_addr).c_str(),
+                    (unsigned long)num_rejected_);
+        }
+        return false;
+    }
+
+    if (!admission_controller_.can_admit()) {
+        num_rejected_++;
+        if (reject_log_limiter_.allow()) {
+            roc_log(LogInfo,
+                    "session group: rejecting new session: n_sessions=%lu load=%.3f"
+                    " n_rejected=%lu",
+                    (unsigned long)state_tracker_.num_active_sessions(),
+                    (double)admission_controller_.load(), (unsigned long)num_rejected_);
+        }
+        return false;
+    }
+
     return true;
 }
 
@@ -377,7 +490,8 @@ ReceiverSessionGroup::create_session_(const packet::PacketPtr& packet) {
 
     core::SharedPtr<ReceiverSession> sess =
         new (arena_) ReceiverSession(sess_config, source_config_.common, encoding_map_,
-                                     packet_factory_, frame_factory_, arena_);
+                                     sinc_table_map_, packet_factory_, frame_factory_,
+                                     arena_);
 
     if (!sess || !sess->is_valid()) {
         roc_log(LogError, "session group: can't create session, initialization failed");
@@ -408,6 +522,7 @@ ReceiverSessionGroup::create_session_(const packet::PacketPtr& packet) {
     sessions_.push_back(*sess);
 
     state_tracker_.add_active_sessions(+1);
+    num_admitted_++;
 
     return status::StatusOK;
 }
@@ -444,6 +559,10 @@ ReceiverSessionGroup::make_session_config_(const packet::PacketPtr& packet) cons
         config.fec_decoder.scheme = fec->fec_scheme;
     }
 
+    if (slot_config_.plc.backend != audio::PlcBackend_Default) {
+        config.plc = slot_config_.plc;
+    }
+
     return config;
 }
 
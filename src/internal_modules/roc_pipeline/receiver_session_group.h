@@ -14,10 +14,13 @@
 
 #include "roc_audio/frame_factory.h"
 #include "roc_audio/mixer.h"
+#include "roc_audio/sinc_table_map.h"
 #include "roc_core/iarena.h"
 #include "roc_core/list.h"
+#include "roc_core/rate_limiter.h"
 #include "roc_core/noncopyable.h"
 #include "roc_packet/packet_factory.h"
+#include "roc_pipeline/admission_controller.h"
 #include "roc_pipeline/metrics.h"
 #include "roc_pipeline/receiver_endpoint.h"
 #include "roc_pipeline/receiver_session.h"
@@ -45,14 +48,19 @@ namespace pipeline {
 //!
 //! It also exchanges control information with remote senders using rtcp::Communicator
 //! and updates routing based on that control information.
+//!
+//! New sessions are created only if allowed by AdmissionController, which is
+//! shared by all session groups of receiver source.
 class ReceiverSessionGroup : public core::NonCopyable<>, private rtcp::IParticipant {
 public:
     //! Initialize.
     ReceiverSessionGroup(const ReceiverSourceConfig& source_config,
                          const ReceiverSlotConfig& slot_config,
                          StateTracker& state_tracker,
+                         AdmissionController& admission_controller,
                          audio::Mixer& mixer,
                          const rtp::EncodingMap& encoding_map,
+                         audio::SincTableMap& sinc_table_map,
                          packet::PacketFactory& packet_factory,
                          audio::FrameFactory& frame_factory,
                          core::IArena& arena);
@@ -89,6 +97,18 @@ public:
     //! Get number of sessions in group.
     size_t num_sessions() const;
 
+    //! Get priority of sessions in group.
+    SessionPriority session_priority() const;
+
+    //! Get processing load of all sessions in group.
+    SessionLoad processing_load();
+
+    //! Remove most expensive session.
+    //! @remarks
+    //!  Used by receiver source when it is overloaded. Sender of removed
+    //!  session is denied to create new sessions for a while.
+    void shed_session(core::nanoseconds_t current_time);
+
     //! Get slot metrics.
     //! @remarks
     //!  These metrics are for the whole slot.
@@ -121,11 +141,13 @@ private:
                                                   const rtcp::SendReport& send_report);
     virtual void halt_recv_stream(packet::stream_source_t send_source_id);
 
-    status::StatusCode route_transport_packet_(const packet::PacketPtr& packet);
+    status::StatusCode route_transport_packet_(const packet::PacketPtr& packet,
+                                               core::nanoseconds_t current_time);
     status::StatusCode route_control_packet_(const packet::PacketPtr& packet,
                                              core::nanoseconds_t current_time);
 
-    bool can_create_session_(const packet::PacketPtr& packet);
+    bool can_create_session_(const packet::PacketPtr& packet,
+                             core::nanoseconds_t current_time);
 
     status::StatusCode create_session_(const packet::PacketPtr& packet);
     void remove_session_(core::SharedPtr<ReceiverSession> sess);
@@ -137,9 +159,11 @@ private:
     const ReceiverSlotConfig slot_config_;
 
     StateTracker& state_tracker_;
+    AdmissionController& admission_controller_;
     audio::Mixer& mixer_;
 
     const rtp::EncodingMap& encoding_map_;
+    audio::SincTableMap& sinc_table_map_;
 
     core::IArena& arena_;
     packet::PacketFactory& packet_factory_;
@@ -153,6 +177,11 @@ private:
     core::List<ReceiverSession> sessions_;
     ReceiverSessionRouter session_router_;
 
+    size_t num_admitted_;
+    size_t num_rejected_;
+    size_t num_shed_;
+    core::RateLimiter reject_log_limiter_;
+
     bool valid_;
 };
 
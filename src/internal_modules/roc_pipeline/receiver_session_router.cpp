@@ -61,6 +61,27 @@ bool ReceiverSessionRouter::has_session(const core::SharedPtr<ReceiverSession>&
     return session_route_map_.find(session) != NULL;
 }
 
+bool ReceiverSessionRouter::get_session_source(
+    const core::SharedPtr<ReceiverSession>& session,
+    address::SocketAddr& source_addr,
+    bool& has_source_id,
+    packet::stream_source_t& source_id) {
+    roc_panic_if(!session);
+
+    SessionNode* node = session_route_map_.find(session);
+    if (!node) {
+        return false;
+    }
+
+    const Route& route = node->route();
+
+    source_addr = route.source_addr;
+    has_source_id = route.has_main_source_id;
+    source_id = route.main_source_id;
+
+    return true;
+}
+
 status::StatusCode
 ReceiverSessionRouter::add_session(const core::SharedPtr<ReceiverSession>& session,
                                    packet::stream_source_t source_id,
@@ -101,6 +101,15 @@ public:
     //!  or unlink_source().
     bool has_session(const core::SharedPtr<ReceiverSession>& session);
 
+    //! Get source address and main source ID of the route of given session.
+    //! @remarks
+    //!  Returns false if there is no route for session. Source address
+    //!  may be empty.
+    bool get_session_source(const core::SharedPtr<ReceiverSession>& session,
+                            address::SocketAddr& source_addr,
+                            bool& has_source_id,
+                            packet::stream_source_t& source_id);
+
     //! Register session in router.
     //! @remarks
     //!  - @p session defines session where to route packets.
@@ -16,22 +16,28 @@ namespace pipeline {
 ReceiverSlot::ReceiverSlot(const ReceiverSourceConfig& source_config,
                            const ReceiverSlotConfig& slot_config,
                            StateTracker& state_tracker,
+                           AdmissionController& admission_controller,
                            audio::Mixer& mixer,
                            const rtp::EncodingMap& encoding_map,
+                           audio::SincTableMap& sinc_table_map,
                            packet::PacketFactory& packet_factory,
                            audio::FrameFactory& frame_factory,
                            core::IArena& arena)
     : core::RefCounted<ReceiverSlot, core::ArenaAllocation>(arena)
+    , common_config_(source_config.common)
     , encoding_map_(encoding_map)
     , state_tracker_(state_tracker)
     , session_group_(source_config,
                      slot_config,
                      state_tracker_,
+                     admission_controller,
                      mixer,
                      encoding_map,
+                     sinc_table_map,
                      packet_factory,
                      frame_factory,
                      arena)
+    , metrics_snapshot_(arena)
     , valid_(false) {
     if (!session_group_.is_valid()) {
         return;
@@ -40,6 +46,8 @@ ReceiverSlot::ReceiverSlot(const ReceiverSourceConfig& source_config,
     roc_log(LogDebug, "receiver slot: initializing");
 
     valid_ = true;
+
+    publish_metrics_(0);
 }
 
 bool ReceiverSlot::is_valid() const {
@@ -94,7 +102,15 @@ core::nanoseconds_t ReceiverSlot::refresh(core::nanoseconds_t current_time) {
         roc_panic_if(code != status::StatusOK);
     }
 
-    return session_group_.refresh_sessions(current_time);
+    const core::nanoseconds_t next_deadline =
+        session_group_.refresh_sessions(current_time);
+
+    if (metrics_snapshot_.need_publish(current_time, common_config_.metrics_interval,
+                                       session_group_.num_sessions())) {
+        publish_metrics_(current_time);
+    }
+
+    return next_deadline;
 }
 
 void ReceiverSlot::reclock(core::nanoseconds_t playback_time) {
@@ -109,6 +125,24 @@ size_t ReceiverSlot::num_sessions() const {
     return session_group_.num_sessions();
 }
 
+SessionPriority ReceiverSlot::session_priority() const {
+    roc_panic_if(!is_valid());
+
+    return session_group_.session_priority();
+}
+
+SessionLoad ReceiverSlot::processing_load() {
+    roc_panic_if(!is_valid());
+
+    return session_group_.processing_load();
+}
+
+void ReceiverSlot::shed_session(core::nanoseconds_t current_time) {
+    roc_panic_if(!is_valid());
+
+    session_group_.shed_session(current_time);
+}
+
 void ReceiverSlot::get_metrics(ReceiverSlotMetrics& slot_metrics,
                                ReceiverParticipantMetrics* party_metrics,
                                size_t* party_count) const {
@@ -121,6 +155,22 @@ void ReceiverSlot::get_metrics(ReceiverSlotMetrics& slot_metrics,
     }
 }
 
+bool ReceiverSlot::load_metrics(ReceiverSlotMetrics& slot_metrics,
+                                ReceiverParticipantMetrics* party_metrics,
+                                size_t* party_count) const {
+    return metrics_snapshot_.load(slot_metrics, party_metrics, party_count);
+}
+
+bool ReceiverSlot::load_metrics(
+    ReceiverSlotMetrics& slot_metrics,
+    core::Array<ReceiverParticipantMetrics>& party_metrics) const {
+    return metrics_snapshot_.load(slot_metrics, party_metrics);
+}
+
+void ReceiverSlot::publish_metrics_(core::nanoseconds_t current_time) {
+    metrics_snapshot_.publish(*this, session_group_.num_sessions(), current_time);
+}
+
 ReceiverEndpoint*
 ReceiverSlot::create_source_endpoint_(address::Protocol proto,
                                       const address::SocketAddr& inbound_address,
@@ -141,8 +191,8 @@ ReceiverSlot::create_source_endpoint_(address::Protocol proto,
     }
 
     source_endpoint_.reset(new (source_endpoint_) ReceiverEndpoint(
-        proto, state_tracker_, session_group_, encoding_map_, inbound_address,
-        outbound_writer, arena()));
+        proto, common_config_, state_tracker_, session_group_, encoding_map_,
+        inbound_address, outbound_writer, arena()));
 
     if (!source_endpoint_ || !source_endpoint_->is_valid()) {
         roc_log(LogError, "receiver slot: can't create source endpoint");
@@ -173,8 +223,8 @@ ReceiverSlot::create_repair_endpoint_(address::Protocol proto,
     }
 
     repair_endpoint_.reset(new (repair_endpoint_) ReceiverEndpoint(
-        proto, state_tracker_, session_group_, encoding_map_, inbound_address,
-        outbound_writer, arena()));
+        proto, common_config_, state_tracker_, session_group_, encoding_map_,
+        inbound_address, outbound_writer, arena()));
 
     if (!repair_endpoint_ || !repair_endpoint_->is_valid()) {
         roc_log(LogError, "receiver slot: can't create repair endpoint");
@@ -199,8 +249,8 @@ ReceiverSlot::create_control_endpoint_(address::Protocol proto,
     }
 
     control_endpoint_.reset(new (control_endpoint_) ReceiverEndpoint(
-        proto, state_tracker_, session_group_, encoding_map_, inbound_address,
-        outbound_writer, arena()));
+        proto, common_config_, state_tracker_, session_group_, encoding_map_,
+        inbound_address, outbound_writer, arena()));
 
     if (!control_endpoint_ || !control_endpoint_->is_valid()) {
         roc_log(LogError, "receiver slot: can't create control endpoint");
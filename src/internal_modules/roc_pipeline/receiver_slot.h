@@ -16,11 +16,14 @@
 #include "roc_address/protocol.h"
 #include "roc_audio/frame_factory.h"
 #include "roc_audio/mixer.h"
+#include "roc_audio/sinc_table_map.h"
+#include "roc_core/array.h"
 #include "roc_core/iarena.h"
 #include "roc_core/list_node.h"
 #include "roc_core/ref_counted.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_pipeline/metrics.h"
+#include "roc_pipeline/metrics_snapshot.h"
 #include "roc_pipeline/receiver_endpoint.h"
 #include "roc_pipeline/receiver_session_group.h"
 #include "roc_pipeline/state_tracker.h"
@@ -41,8 +44,10 @@ public:
     ReceiverSlot(const ReceiverSourceConfig& source_config,
                  const ReceiverSlotConfig& slot_config,
                  StateTracker& state_tracker,
+                 AdmissionController& admission_controller,
                  audio::Mixer& mixer,
                  const rtp::EncodingMap& encoding_map,
+                 audio::SincTableMap& sinc_table_map,
                  packet::PacketFactory& packet_factory,
                  audio::FrameFactory& frame_factory,
                  core::IArena& arena);
@@ -71,12 +76,41 @@ public:
     //! Get number of alive sessions.
     size_t num_sessions() const;
 
+    //! Get priority of sessions of slot.
+    SessionPriority session_priority() const;
+
+    //! Get processing load of sessions of slot.
+    SessionLoad processing_load();
+
+    //! Remove most expensive session of slot.
+    void shed_session(core::nanoseconds_t current_time);
+
     //! Get metrics for slot and its participants.
     void get_metrics(ReceiverSlotMetrics& slot_metrics,
                      ReceiverParticipantMetrics* party_metrics,
                      size_t* party_count) const;
 
+    //! Get last published snapshot of metrics for slot and its participants.
+    //! @remarks
+    //!  Snapshot is republished by refresh(). Unlike other methods, can be
+    //!  called from any thread and never waits for pipeline.
+    //! @returns
+    //!  false if consistent snapshot can't be read because it's being
+    //!  republished concurrently.
+    bool load_metrics(ReceiverSlotMetrics& slot_metrics,
+                      ReceiverParticipantMetrics* party_metrics,
+                      size_t* party_count) const;
+
+    //! Get last published snapshot of metrics for slot and its participants.
+    //! @remarks
+    //!  Same as above, but resizes @p party_metrics to the number of
+    //!  participants in snapshot.
+    bool load_metrics(ReceiverSlotMetrics& slot_metrics,
+                      core::Array<ReceiverParticipantMetrics>& party_metrics) const;
+
 private:
+    void publish_metrics_(core::nanoseconds_t current_time);
+
     ReceiverEndpoint* create_source_endpoint_(address::Protocol proto,
                                               const address::SocketAddr& inbound_address,
                                               packet::IWriter* outbound_writer);
@@ -87,6 +121,7 @@ private:
                                                const address::SocketAddr& inbound_address,
                                                packet::IWriter* outbound_writer);
 
+    const ReceiverCommonConfig common_config_;
     const rtp::EncodingMap& encoding_map_;
 
     StateTracker& state_tracker_;
@@ -96,6 +131,8 @@ private:
     core::Optional<ReceiverEndpoint> repair_endpoint_;
     core::Optional<ReceiverEndpoint> control_endpoint_;
 
+    MetricsSnapshot<ReceiverSlotMetrics, ReceiverParticipantMetrics> metrics_snapshot_;
+
     bool valid_;
 };
 
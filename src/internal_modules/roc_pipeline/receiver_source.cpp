@@ -7,6 +7,7 @@
  */
 
 #include "roc_pipeline/receiver_source.h"
+#include "roc_audio/integer_ops.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 
@@ -15,36 +16,61 @@ namespace pipeline {
 
 ReceiverSource::ReceiverSource(const ReceiverSourceConfig& source_config,
                                const rtp::EncodingMap& encoding_map,
+                               audio::SincTableMap& sinc_table_map,
                                core::IPool& packet_pool,
                                core::IPool& packet_buffer_pool,
                                core::IPool& frame_buffer_pool,
                                core::IArena& arena)
     : source_config_(source_config)
     , encoding_map_(encoding_map)
+    , sinc_table_map_(sinc_table_map)
     , packet_factory_(packet_pool, packet_buffer_pool)
     , frame_factory_(frame_buffer_pool)
     , arena_(arena)
+    , admission_controller_(source_config_.common, state_tracker_)
     , frame_reader_(NULL)
     , valid_(false) {
     source_config_.deduce_defaults();
 
     audio::IFrameReader* frm_reader = NULL;
 
-    mixer_.reset(new (mixer_) audio::Mixer(
-        frame_factory_, source_config.common.output_sample_spec, true));
+    if (source_config_.common.processing_format != audio::Sample_RawFormat
+        && !audio::is_integer_format(source_config_.common.processing_format)) {
+        roc_log(LogError,
+                "receiver source: unsupported processing format: %s",
+                audio::pcm_format_to_str(source_config_.common.processing_format));
+        return;
+    }
+
+    if (source_config_.common.processing_format != audio::Sample_RawFormat
+        && source_config_.common.processing_layout != audio::SampleLayout_Interleaved) {
+        roc_log(LogError,
+                "receiver source: integer processing format requires interleaved"
+                " processing layout");
+        return;
+    }
+
+    // Sessions produce samples in processing format and layout, so mixing
+    // is done in them too.
+    audio::SampleSpec mixer_spec(source_config_.common.output_sample_spec.sample_rate(),
+                                 source_config_.common.processing_format,
+                                 source_config_.common.output_sample_spec.channel_set());
+    mixer_spec.set_sample_layout(source_config_.common.processing_layout);
+
+    mixer_.reset(new (mixer_) audio::Mixer(frame_factory_, arena, mixer_spec, true,
+                                           source_config_.num_session_threads));
     if (!mixer_ || !mixer_->is_valid()) {
         return;
     }
     frm_reader = mixer_.get();
 
-    if (!source_config_.common.output_sample_spec.is_raw()) {
-        const audio::SampleSpec in_spec(
-            source_config_.common.output_sample_spec.sample_rate(),
-            audio::Sample_RawFormat,
-            source_config_.common.output_sample_spec.channel_set());
-
+    if (source_config_.common.output_sample_spec.sample_format()
+            != mixer_spec.sample_format()
+        || source_config_.common.output_sample_spec.pcm_format()
+            != mixer_spec.pcm_format()
+        || mixer_spec.sample_layout() != audio::SampleLayout_Interleaved) {
         pcm_mapper_.reset(new (pcm_mapper_) audio::PcmMapperReader(
-            *frm_reader, frame_factory_, in_spec,
+            *frm_reader, frame_factory_, mixer_spec,
             source_config_.common.output_sample_spec));
         if (!pcm_mapper_ || !pcm_mapper_->is_valid()) {
             return;
@@ -80,8 +106,10 @@ ReceiverSlot* ReceiverSource::create_slot(const ReceiverSlotConfig& slot_config)
     roc_log(LogInfo, "receiver source: adding slot");
 
     core::SharedPtr<ReceiverSlot> slot =
-        new (arena_) ReceiverSlot(source_config_, slot_config, state_tracker_, *mixer_,
-                                  encoding_map_, packet_factory_, frame_factory_, arena_);
+        new (arena_) ReceiverSlot(source_config_, slot_config, state_tracker_,
+                                  admission_controller_, *mixer_, encoding_map_,
+                                  sinc_table_map_, packet_factory_, frame_factory_,
+                                  arena_);
 
     if (!slot || !slot->is_valid()) {
         roc_log(LogError, "receiver source: can't create slot");
@@ -127,6 +155,10 @@ core::nanoseconds_t ReceiverSource::refresh(core::nanoseconds_t current_time) {
         }
     }
 
+    if (source_config_.common.max_session_load > 0) {
+        update_admission_(current_time);
+    }
+
     return next_deadline;
 }
 
@@ -194,5 +226,39 @@ bool ReceiverSource::read(audio::Frame& frame) {
     return frame_reader_->read(frame);
 }
 
+// Report total load of sessions to admission controller, and if it's
+// overloaded, remove one session. Victim is chosen from slot with lowest
+// priority, and among such slots, from one with most expensive session.
+// If one removal is not enough, next one happens on next refresh.
+void ReceiverSource::update_admission_(core::nanoseconds_t current_time) {
+    SessionLoad total_load;
+
+    core::SharedPtr<ReceiverSlot> victim_slot;
+    float victim_load = 0;
+
+    for (core::SharedPtr<ReceiverSlot> slot = slots_.front(); slot;
+         slot = slots_.nextof(*slot)) {
+        const SessionLoad slot_load = slot->processing_load();
+        total_load.add(slot_load);
+
+        if (slot->num_sessions() == 0) {
+            continue;
+        }
+
+        if (!victim_slot || slot->session_priority() < victim_slot->session_priority()
+            || (slot->session_priority() == victim_slot->session_priority()
+                && slot_load.max_load > victim_load)) {
+            victim_slot = slot;
+            victim_load = slot_load.max_load;
+        }
+    }
+
+    admission_controller_.update_load(total_load);
+
+    if (admission_controller_.is_overloaded() && victim_slot) {
+        victim_slot->shed_session(current_time);
+    }
+}
+
 } // namespace pipeline
 } // namespace roc
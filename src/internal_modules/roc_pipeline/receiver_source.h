@@ -17,10 +17,12 @@
 #include "roc_audio/mixer.h"
 #include "roc_audio/pcm_mapper_reader.h"
 #include "roc_audio/profiling_reader.h"
+#include "roc_audio/sinc_table_map.h"
 #include "roc_core/iarena.h"
 #include "roc_core/optional.h"
 #include "roc_core/stddefs.h"
 #include "roc_packet/packet_factory.h"
+#include "roc_pipeline/admission_controller.h"
 #include "roc_pipeline/config.h"
 #include "roc_pipeline/receiver_endpoint.h"
 #include "roc_pipeline/receiver_slot.h"
@@ -45,6 +47,7 @@ public:
     //! Initialize.
     ReceiverSource(const ReceiverSourceConfig& source_config,
                    const rtp::EncodingMap& encoding_map,
+                   audio::SincTableMap& sinc_table_map,
                    core::IPool& packet_pool,
                    core::IPool& packet_buffer_pool,
                    core::IPool& frame_buffer_pool,
@@ -115,15 +118,19 @@ public:
     virtual bool read(audio::Frame&);
 
 private:
+    void update_admission_(core::nanoseconds_t current_time);
+
     ReceiverSourceConfig source_config_;
 
     const rtp::EncodingMap& encoding_map_;
+    audio::SincTableMap& sinc_table_map_;
 
     packet::PacketFactory packet_factory_;
     audio::FrameFactory frame_factory_;
     core::IArena& arena_;
 
     StateTracker state_tracker_;
+    AdmissionController admission_controller_;
 
     core::Optional<audio::Mixer> mixer_;
     core::Optional<audio::ProfilingReader> profiler_;
@@ -19,6 +19,7 @@ namespace roc {
 namespace pipeline {
 
 SenderEndpoint::SenderEndpoint(address::Protocol proto,
+                               const SenderSinkConfig& sink_config,
                                StateTracker& state_tracker,
                                SenderSession& sender_session,
                                const address::SocketAddr& outbound_address,
@@ -120,8 +121,27 @@ SenderEndpoint::SenderEndpoint(address::Protocol proto,
         return;
     }
 
+    packet::IWriter* writer = &outbound_writer;
+
+    // Control packets are small and rare, so pacing is applied only to
+    // transport endpoints.
+    if (sink_config.enable_pacing && proto != address::Proto_RTCP) {
+        size_t n_repair_packets = 0;
+        if (proto == address::Proto_RS8M_Repair || proto == address::Proto_LDPC_Repair) {
+            n_repair_packets = sink_config.fec_writer.n_repair_packets;
+        }
+
+        pacer_.reset(new (pacer_) packet::Pacer(
+            *writer, sink_config.pacer, sink_config.packet_length,
+            sink_config.fec_writer.n_source_packets, n_repair_packets));
+        if (!pacer_ || !pacer_->is_valid()) {
+            return;
+        }
+        writer = pacer_.get();
+    }
+
     shipper_.reset(new (shipper_)
-                       packet::Shipper(*composer, outbound_writer, &outbound_address));
+                       packet::Shipper(*composer, *writer, &outbound_address));
     if (!shipper_) {
         return;
     }
@@ -200,6 +220,47 @@ status::StatusCode SenderEndpoint::pull_packets(core::nanoseconds_t current_time
     return status::StatusOK;
 }
 
+status::StatusCode SenderEndpoint::push_packets(core::nanoseconds_t current_time) {
+    roc_panic_if(!is_valid());
+
+    if (!pacer_) {
+        // Pacing disabled, packets are sent immediately.
+        return status::StatusOK;
+    }
+
+    return pacer_->refresh(current_time);
+}
+
+status::StatusCode SenderEndpoint::flush_packets(core::nanoseconds_t current_time) {
+    roc_panic_if(!is_valid());
+
+    if (!pacer_) {
+        return status::StatusOK;
+    }
+
+    return pacer_->flush(current_time);
+}
+
+core::nanoseconds_t SenderEndpoint::push_deadline() const {
+    roc_panic_if(!is_valid());
+
+    if (!pacer_) {
+        return 0;
+    }
+
+    return pacer_->refresh_deadline();
+}
+
+packet::PacerMetrics SenderEndpoint::pacer_metrics() const {
+    roc_panic_if(!is_valid());
+
+    if (!pacer_) {
+        return packet::PacerMetrics();
+    }
+
+    return pacer_->metrics();
+}
+
 // Implementation of inbound_writer().write()
 status::StatusCode SenderEndpoint::write(const packet::PacketPtr& packet) {
     roc_panic_if(!is_valid());
@@ -22,7 +22,9 @@
 #include "roc_packet/icomposer.h"
 #include "roc_packet/iparser.h"
 #include "roc_packet/iwriter.h"
+#include "roc_packet/pacer.h"
 #include "roc_packet/shipper.h"
+#include "roc_pipeline/config.h"
 #include "roc_pipeline/state_tracker.h"
 #include "roc_rtcp/composer.h"
 #include "roc_rtcp/parser.h"
@@ -45,6 +47,7 @@ public:
     //!  - @p outbound_writer specifies destination writer to which packets are sent
     //!    in the end of endpoint pipeline
     SenderEndpoint(address::Protocol proto,
+                   const SenderSinkConfig& sink_config,
                    StateTracker& state_tracker,
                    SenderSession& sender_session,
                    const address::SocketAddr& outbound_address,
@@ -71,6 +74,7 @@ public:
     //!  Packets passed to this writer will be enqueued for sending.
     //!  When frame is written to SenderSession, it generates packets
     //!  and writes them to outbound writers of endpoints.
+    //!  If pacing is enabled, packets are delayed until push_packets().
     packet::IWriter& outbound_writer();
 
     //! Get writer for inbound packets.
@@ -93,6 +97,29 @@ public:
     //!  should periodically call pull_packets() to make them available.
     ROC_ATTR_NODISCARD status::StatusCode pull_packets(core::nanoseconds_t current_time);
 
+    //! Push packets delayed by pacer to network.
+    //! @remarks
+    //!  If pacing is enabled, packets written to outbound_writer() are queued
+    //!  and pipeline thread should periodically call push_packets() to send
+    //!  packets which are due. If pacing is disabled, does nothing.
+    ROC_ATTR_NODISCARD status::StatusCode push_packets(core::nanoseconds_t current_time);
+
+    //! Push all packets delayed by pacer to network, ignoring pacing.
+    //! @remarks
+    //!  Should be called before endpoint is removed, so that queued packets
+    //!  are not lost. If pacing is disabled, does nothing.
+    ROC_ATTR_NODISCARD status::StatusCode flush_packets(core::nanoseconds_t current_time);
+
+    //! Get deadline when push_packets() should be called again.
+    //! @returns
+    //!  absolute time, or zero if there are no delayed packets.
+    core::nanoseconds_t push_deadline() const;
+
+    //! Get pacer metrics.
+    //! @remarks
+    //!  If pacing is disabled, returns zero metrics.
+    packet::PacerMetrics pacer_metrics() const;
+
 private:
     virtual ROC_ATTR_NODISCARD status::StatusCode write(const packet::PacketPtr& packet);
 
@@ -108,6 +135,7 @@ private:
     core::ScopedPtr<packet::IComposer> fec_composer_;
     core::Optional<rtcp::Composer> rtcp_composer_;
     core::Optional<packet::Shipper> shipper_;
+    core::Optional<packet::Pacer> pacer_;
 
     // Inbound packets sub-pipeline.
     // On sender, typically present only in control endpoints.
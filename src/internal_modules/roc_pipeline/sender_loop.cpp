@@ -89,6 +89,7 @@ packet::IWriter* SenderLoop::Tasks::AddEndpoint::get_inbound_writer() const {
 SenderLoop::SenderLoop(IPipelineTaskScheduler& scheduler,
                        const SenderSinkConfig& sink_config,
                        const rtp::EncodingMap& encoding_map,
+                       audio::SincTableMap& sinc_table_map,
                        core::IPool& packet_pool,
                        core::IPool& packet_buffer_pool,
                        core::IPool& frame_buffer_pool,
@@ -96,6 +97,7 @@ SenderLoop::SenderLoop(IPipelineTaskScheduler& scheduler,
     : PipelineLoop(scheduler, sink_config.pipeline_loop, sink_config.input_sample_spec)
     , sink_(sink_config,
             encoding_map,
+            sinc_table_map,
             packet_pool,
             packet_buffer_pool,
             frame_buffer_pool,
@@ -130,6 +132,45 @@ sndio::ISink& SenderLoop::sink() {
     return *this;
 }
 
+bool SenderLoop::load_slot_metrics(SlotHandle slot_handle,
+                                   SenderSlotMetrics& slot_metrics,
+                                   SenderParticipantMetrics* party_metrics,
+                                   size_t* party_count) {
+    roc_panic_if_not(is_valid());
+
+    if (!slot_handle) {
+        roc_panic("sender loop: slot handle is null");
+    }
+
+    SenderSlot* slot = (SenderSlot*)slot_handle;
+
+    if (!slot->load_metrics(slot_metrics, party_metrics, party_count)) {
+        return false;
+    }
+
+    slot_metrics.frame_processing_time = frame_processing_time();
+    return true;
+}
+
+bool SenderLoop::load_slot_metrics(SlotHandle slot_handle,
+                                   SenderSlotMetrics& slot_metrics,
+                                   core::Array<SenderParticipantMetrics>& party_metrics) {
+    roc_panic_if_not(is_valid());
+
+    if (!slot_handle) {
+        roc_panic("sender loop: slot handle is null");
+    }
+
+    SenderSlot* slot = (SenderSlot*)slot_handle;
+
+    if (!slot->load_metrics(slot_metrics, party_metrics)) {
+        return false;
+    }
+
+    slot_metrics.frame_processing_time = frame_processing_time();
+    return true;
+}
+
 sndio::ISink* SenderLoop::to_sink() {
     roc_panic_if(!is_valid());
 
@@ -254,13 +295,15 @@ uint64_t SenderLoop::tid_imp() const {
 
 bool SenderLoop::process_subframe_imp(audio::Frame& frame) {
     sink_.write(frame);
-
-    // TODO: handle returned deadline and schedule refresh
-    sink_.refresh(core::timestamp(core::ClockUnix));
+    refresh_sink_();
 
     return true;
 }
 
+void SenderLoop::refresh_imp() {
+    refresh_sink_();
+}
+
 bool SenderLoop::process_task_imp(PipelineTask& basic_task) {
     Task& task = (Task&)basic_task;
 
@@ -268,6 +311,20 @@ bool SenderLoop::process_task_imp(PipelineTask& basic_task) {
     return (this->*(task.func_))(task);
 }
 
+void SenderLoop::refresh_sink_() {
+    const core::nanoseconds_t current_time = core::timestamp(core::ClockUnix);
+    const core::nanoseconds_t deadline = sink_.refresh(current_time);
+
+    if (deadline == 0) {
+        request_refresh(0);
+        return;
+    }
+
+    // sink uses unix time, and pipeline loop uses monotonic time
+    request_refresh(timestamp_imp()
+                    + std::max(deadline - current_time, (core::nanoseconds_t)0));
+}
+
 bool SenderLoop::task_create_slot_(Task& task) {
     task.slot_ = sink_.create_slot(task.slot_config_);
     return (bool)task.slot_;
@@ -285,6 +342,8 @@ bool SenderLoop::task_query_slot_(Task& task) {
     roc_panic_if(!task.slot_metrics_);
 
     task.slot_->get_metrics(*task.slot_metrics_, task.party_metrics_, task.party_count_);
+    task.slot_metrics_->frame_processing_time = frame_processing_time();
+
     return true;
 }
 
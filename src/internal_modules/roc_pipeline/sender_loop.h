@@ -12,6 +12,7 @@
 #ifndef ROC_PIPELINE_SENDER_LOOP_H_
 #define ROC_PIPELINE_SENDER_LOOP_H_
 
+#include "roc_core/array.h"
 #include "roc_core/iarena.h"
 #include "roc_core/ipool.h"
 #include "roc_core/mutex.h"
@@ -123,6 +124,7 @@ public:
     SenderLoop(IPipelineTaskScheduler& scheduler,
                const SenderSinkConfig& sink_config,
                const rtp::EncodingMap& encoding_map,
+               audio::SincTableMap& sinc_table_map,
                core::IPool& packet_pool,
                core::IPool& packet_buffer_pool,
                core::IPool& frame_buffer_pool,
@@ -136,6 +138,27 @@ public:
     //!  Samples written to the sink are sent to remote peers.
     sndio::ISink& sink();
 
+    //! Get snapshot of slot metrics.
+    //! @remarks
+    //!  Reads snapshot last published by pipeline thread during refresh.
+    //!  Lock-free and never waits for pipeline, so can be called from any
+    //!  thread, but slot should not be deleted concurrently.
+    //! @returns
+    //!  false if consistent snapshot can't be read because it's being
+    //!  republished concurrently.
+    bool load_slot_metrics(SlotHandle slot,
+                           SenderSlotMetrics& slot_metrics,
+                           SenderParticipantMetrics* party_metrics,
+                           size_t* party_count);
+
+    //! Get snapshot of slot metrics.
+    //! @remarks
+    //!  Same as above, but resizes @p party_metrics to the number of
+    //!  participants in snapshot, so that they're read at once.
+    bool load_slot_metrics(SlotHandle slot,
+                           SenderSlotMetrics& slot_metrics,
+                           core::Array<SenderParticipantMetrics>& party_metrics);
+
 private:
     // Methods of sndio::ISink
     virtual sndio::ISink* to_sink();
@@ -156,6 +179,9 @@ private:
     virtual uint64_t tid_imp() const;
     virtual bool process_subframe_imp(audio::Frame&);
     virtual bool process_task_imp(PipelineTask&);
+    virtual void refresh_imp();
+
+    void refresh_sink_();
 
     // Methods for tasks
     bool task_create_slot_(Task&);
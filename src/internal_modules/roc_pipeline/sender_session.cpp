@@ -17,12 +17,14 @@ namespace pipeline {
 
 SenderSession::SenderSession(const SenderSinkConfig& sink_config,
                              const rtp::EncodingMap& encoding_map,
+                             audio::SincTableMap& sinc_table_map,
                              packet::PacketFactory& packet_factory,
                              audio::FrameFactory& frame_factory,
                              core::IArena& arena)
     : arena_(arena)
     , sink_config_(sink_config)
     , encoding_map_(encoding_map)
+    , sinc_table_map_(sinc_table_map)
     , packet_factory_(packet_factory)
     , frame_factory_(frame_factory)
     , frame_writer_(NULL)
@@ -171,7 +173,8 @@ bool SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
                                          sink_config_.input_sample_spec.channel_set());
 
         resampler_.reset(audio::ResamplerMap::instance().new_resampler(
-            arena_, frame_factory_, sink_config_.resampler, in_spec, out_spec));
+            arena_, frame_factory_, sinc_table_map_, sink_config_.resampler, in_spec,
+            out_spec));
 
         if (!resampler_) {
             return false;
@@ -279,6 +282,7 @@ void SenderSession::get_participant_metrics(SenderParticipantMetrics* party_metr
             *party_count, feedback_monitor_ ? feedback_monitor_->num_participants() : 0);
 
         for (size_t n_part = 0; n_part < *party_count; n_part++) {
+            party_metrics[n_part].source_id = feedback_monitor_->source_id(n_part);
             party_metrics[n_part].link = feedback_monitor_->link_metrics(n_part);
             party_metrics[n_part].latency = feedback_monitor_->latency_metrics(n_part);
         }
@@ -341,6 +345,10 @@ SenderSession::notify_send_stream(packet::stream_source_t recv_source_id,
         link_metrics.lost_packets = recv_report.cum_loss;
         link_metrics.jitter = recv_report.jitter;
         link_metrics.rtt = recv_report.rtt;
+        link_metrics.fec_repaired_packets = recv_report.fec_repaired_packets;
+        link_metrics.fec_unrepaired_packets = recv_report.fec_unrepaired_packets;
+        link_metrics.late_packets = recv_report.late_packets;
+        link_metrics.concealed_duration = recv_report.concealed_duration;
 
         feedback_monitor_->process_feedback(recv_source_id, latency_metrics,
                                             link_metrics);
@@ -20,6 +20,7 @@
 #include "roc_audio/iresampler.h"
 #include "roc_audio/packetizer.h"
 #include "roc_audio/resampler_writer.h"
+#include "roc_audio/sinc_table_map.h"
 #include "roc_core/iarena.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/optional.h"
@@ -54,6 +55,7 @@ public:
     //! Initialize.
     SenderSession(const SenderSinkConfig& sink_config,
                   const rtp::EncodingMap& encoding_map,
+                  audio::SincTableMap& sinc_table_map,
                   packet::PacketFactory& packet_factory,
                   audio::FrameFactory& frame_factory,
                   core::IArena& arena);
@@ -128,6 +130,7 @@ private:
     const SenderSinkConfig sink_config_;
 
     const rtp::EncodingMap& encoding_map_;
+    audio::SincTableMap& sinc_table_map_;
 
     packet::PacketFactory& packet_factory_;
     audio::FrameFactory& frame_factory_;
@@ -10,18 +10,21 @@
 #include "roc_audio/resampler_map.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
+#include "roc_core/time.h"
 
 namespace roc {
 namespace pipeline {
 
 SenderSink::SenderSink(const SenderSinkConfig& sink_config,
                        const rtp::EncodingMap& encoding_map,
+                       audio::SincTableMap& sinc_table_map,
                        core::IPool& packet_pool,
                        core::IPool& packet_buffer_pool,
                        core::IPool& frame_buffer_pool,
                        core::IArena& arena)
     : sink_config_(sink_config)
     , encoding_map_(encoding_map)
+    , sinc_table_map_(sinc_table_map)
     , packet_factory_(packet_pool, packet_buffer_pool)
     , frame_factory_(frame_buffer_pool)
     , arena_(arena)
@@ -72,7 +75,8 @@ SenderSlot* SenderSink::create_slot(const SenderSlotConfig& slot_config) {
 
     core::SharedPtr<SenderSlot> slot =
         new (arena_) SenderSlot(sink_config_, slot_config, state_tracker_, encoding_map_,
-                                fanout_, packet_factory_, frame_factory_, arena_);
+                                sinc_table_map_, fanout_, packet_factory_,
+                                frame_factory_, arena_);
 
     if (!slot || !slot->is_valid()) {
         roc_log(LogError, "sender sink: can't create slot");
@@ -89,6 +93,9 @@ void SenderSink::delete_slot(SenderSlot* slot) {
 
     roc_log(LogInfo, "sender sink: removing slot");
 
+    // Don't lose packets delayed by pacing.
+    slot->flush(core::timestamp(core::ClockUnix));
+
     slots_.remove(*slot);
 }
 
@@ -16,6 +16,7 @@
 #include "roc_audio/frame_factory.h"
 #include "roc_audio/pcm_mapper_writer.h"
 #include "roc_audio/profiling_writer.h"
+#include "roc_audio/sinc_table_map.h"
 #include "roc_core/iarena.h"
 #include "roc_core/ipool.h"
 #include "roc_core/noncopyable.h"
@@ -45,6 +46,7 @@ public:
     //! Initialize.
     SenderSink(const SenderSinkConfig& sink_config,
                const rtp::EncodingMap& encoding_map,
+               audio::SincTableMap& sinc_table_map,
                core::IPool& packet_pool,
                core::IPool& packet_buffer_pool,
                core::IPool& frame_buffer_pool,
@@ -112,6 +114,7 @@ private:
     SenderSinkConfig sink_config_;
 
     const rtp::EncodingMap& encoding_map_;
+    audio::SincTableMap& sinc_table_map_;
 
     packet::PacketFactory packet_factory_;
     audio::FrameFactory frame_factory_;
@@ -8,6 +8,7 @@
 
 #include "roc_pipeline/sender_slot.h"
 #include "roc_core/log.h"
+#include "roc_core/macro_helpers.h"
 #include "roc_core/panic.h"
 #include "roc_pipeline/endpoint_helpers.h"
 
@@ -18,6 +19,7 @@ SenderSlot::SenderSlot(const SenderSinkConfig& sink_config,
                        const SenderSlotConfig& slot_config,
                        StateTracker& state_tracker,
                        const rtp::EncodingMap& encoding_map,
+                       audio::SincTableMap& sinc_table_map,
                        audio::Fanout& fanout,
                        packet::PacketFactory& packet_factory,
                        audio::FrameFactory& frame_factory,
@@ -26,13 +28,21 @@ SenderSlot::SenderSlot(const SenderSinkConfig& sink_config,
     , sink_config_(sink_config)
     , fanout_(fanout)
     , state_tracker_(state_tracker)
-    , session_(sink_config, encoding_map, packet_factory, frame_factory, arena)
+    , session_(sink_config,
+               encoding_map,
+               sinc_table_map,
+               packet_factory,
+               frame_factory,
+               arena)
+    , metrics_snapshot_(arena)
     , valid_(false) {
     if (!session_.is_valid()) {
         return;
     }
 
     valid_ = true;
+
+    publish_metrics_(0);
 }
 
 SenderSlot::~SenderSlot() {
@@ -139,7 +149,59 @@ core::nanoseconds_t SenderSlot::refresh(core::nanoseconds_t current_time) {
         roc_panic_if(code != status::StatusOK);
     }
 
-    return session_.refresh(current_time);
+    core::nanoseconds_t next_deadline = session_.refresh(current_time);
+
+    SenderEndpoint* transport_endpoints[] = {
+        source_endpoint_.get(),
+        repair_endpoint_.get(),
+    };
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(transport_endpoints); n++) {
+        SenderEndpoint* endpoint = transport_endpoints[n];
+        if (!endpoint) {
+            continue;
+        }
+
+        const status::StatusCode code = endpoint->push_packets(current_time);
+        // TODO(gh-183): forward status
+        roc_panic_if(code != status::StatusOK);
+
+        const core::nanoseconds_t push_deadline = endpoint->push_deadline();
+        if (push_deadline != 0) {
+            next_deadline = next_deadline == 0 ? push_deadline
+                                               : std::min(next_deadline, push_deadline);
+        }
+    }
+
+    SenderSlotMetrics slot_metrics;
+    session_.get_slot_metrics(slot_metrics);
+
+    if (metrics_snapshot_.need_publish(current_time, sink_config_.metrics_interval,
+                                       slot_metrics.num_participants)) {
+        publish_metrics_(current_time);
+    }
+
+    return next_deadline;
+}
+
+void SenderSlot::flush(core::nanoseconds_t current_time) {
+    roc_panic_if(!is_valid());
+
+    SenderEndpoint* transport_endpoints[] = {
+        source_endpoint_.get(),
+        repair_endpoint_.get(),
+    };
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(transport_endpoints); n++) {
+        SenderEndpoint* endpoint = transport_endpoints[n];
+        if (!endpoint) {
+            continue;
+        }
+
+        const status::StatusCode code = endpoint->flush_packets(current_time);
+        // TODO(gh-183): forward status
+        roc_panic_if(code != status::StatusOK);
+    }
 }
 
 void SenderSlot::get_metrics(SenderSlotMetrics& slot_metrics,
@@ -149,11 +211,48 @@ void SenderSlot::get_metrics(SenderSlotMetrics& slot_metrics,
 
     session_.get_slot_metrics(slot_metrics);
 
+    const SenderEndpoint* transport_endpoints[] = {
+        source_endpoint_.get(),
+        repair_endpoint_.get(),
+    };
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(transport_endpoints); n++) {
+        if (!transport_endpoints[n]) {
+            continue;
+        }
+
+        const packet::PacerMetrics pacer_metrics =
+            transport_endpoints[n]->pacer_metrics();
+
+        slot_metrics.pacing_queue_depth += pacer_metrics.queue_depth;
+        slot_metrics.pacing_delay =
+            std::max(slot_metrics.pacing_delay, pacer_metrics.pacing_delay);
+    }
+
     if (party_metrics || party_count) {
         session_.get_participant_metrics(party_metrics, party_count);
     }
 }
 
+bool SenderSlot::load_metrics(SenderSlotMetrics& slot_metrics,
+                              SenderParticipantMetrics* party_metrics,
+                              size_t* party_count) const {
+    return metrics_snapshot_.load(slot_metrics, party_metrics, party_count);
+}
+
+bool SenderSlot::load_metrics(
+    SenderSlotMetrics& slot_metrics,
+    core::Array<SenderParticipantMetrics>& party_metrics) const {
+    return metrics_snapshot_.load(slot_metrics, party_metrics);
+}
+
+void SenderSlot::publish_metrics_(core::nanoseconds_t current_time) {
+    SenderSlotMetrics slot_metrics;
+    session_.get_slot_metrics(slot_metrics);
+
+    metrics_snapshot_.publish(*this, slot_metrics.num_participants, current_time);
+}
+
 SenderEndpoint*
 SenderSlot::create_source_endpoint_(address::Protocol proto,
                                     const address::SocketAddr& outbound_address,
@@ -179,7 +278,8 @@ SenderSlot::create_source_endpoint_(address::Protocol proto,
     }
 
     source_endpoint_.reset(new (source_endpoint_) SenderEndpoint(
-        proto, state_tracker_, session_, outbound_address, outbound_writer, arena()));
+        proto, sink_config_, state_tracker_, session_, outbound_address, outbound_writer,
+        arena()));
     if (!source_endpoint_ || !source_endpoint_->is_valid()) {
         roc_log(LogError, "sender slot: can't create source endpoint");
         source_endpoint_.reset(NULL);
@@ -214,7 +314,8 @@ SenderSlot::create_repair_endpoint_(address::Protocol proto,
     }
 
     repair_endpoint_.reset(new (repair_endpoint_) SenderEndpoint(
-        proto, state_tracker_, session_, outbound_address, outbound_writer, arena()));
+        proto, sink_config_, state_tracker_, session_, outbound_address, outbound_writer,
+        arena()));
     if (!repair_endpoint_ || !repair_endpoint_->is_valid()) {
         roc_log(LogError, "sender slot: can't create repair endpoint");
         repair_endpoint_.reset(NULL);
@@ -238,7 +339,8 @@ SenderSlot::create_control_endpoint_(address::Protocol proto,
     }
 
     control_endpoint_.reset(new (control_endpoint_) SenderEndpoint(
-        proto, state_tracker_, session_, outbound_address, outbound_writer, arena()));
+        proto, sink_config_, state_tracker_, session_, outbound_address, outbound_writer,
+        arena()));
     if (!control_endpoint_ || !control_endpoint_->is_valid()) {
         roc_log(LogError, "sender slot: can't create control endpoint");
         control_endpoint_.reset(NULL);
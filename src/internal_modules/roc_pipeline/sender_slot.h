@@ -16,6 +16,8 @@
 #include "roc_address/protocol.h"
 #include "roc_audio/fanout.h"
 #include "roc_audio/frame_factory.h"
+#include "roc_audio/sinc_table_map.h"
+#include "roc_core/array.h"
 #include "roc_core/iarena.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/optional.h"
@@ -23,6 +25,7 @@
 #include "roc_packet/packet_factory.h"
 #include "roc_pipeline/config.h"
 #include "roc_pipeline/metrics.h"
+#include "roc_pipeline/metrics_snapshot.h"
 #include "roc_pipeline/sender_endpoint.h"
 #include "roc_pipeline/sender_session.h"
 #include "roc_pipeline/state_tracker.h"
@@ -43,6 +46,7 @@ public:
                const SenderSlotConfig& slot_config,
                StateTracker& state_tracker,
                const rtp::EncodingMap& encoding_map,
+               audio::SincTableMap& sinc_table_map,
                audio::Fanout& fanout,
                packet::PacketFactory& packet_factory,
                audio::FrameFactory& frame_factory,
@@ -65,12 +69,37 @@ public:
     //!  if there are no frames
     core::nanoseconds_t refresh(core::nanoseconds_t current_time);
 
+    //! Send all packets delayed by pacing.
+    //! @remarks
+    //!  Should be called before slot is removed.
+    void flush(core::nanoseconds_t current_time);
+
     //! Get metrics for slot and its participants.
     void get_metrics(SenderSlotMetrics& slot_metrics,
                      SenderParticipantMetrics* party_metrics,
                      size_t* party_count) const;
 
+    //! Get last published snapshot of metrics for slot and its participants.
+    //! @remarks
+    //!  Snapshot is republished by refresh(). Unlike other methods, can be
+    //!  called from any thread and never waits for pipeline.
+    //! @returns
+    //!  false if consistent snapshot can't be read because it's being
+    //!  republished concurrently.
+    bool load_metrics(SenderSlotMetrics& slot_metrics,
+                      SenderParticipantMetrics* party_metrics,
+                      size_t* party_count) const;
+
+    //! Get last published snapshot of metrics for slot and its participants.
+    //! @remarks
+    //!  Same as above, but resizes @p party_metrics to the number of
+    //!  participants in snapshot.
+    bool load_metrics(SenderSlotMetrics& slot_metrics,
+                      core::Array<SenderParticipantMetrics>& party_metrics) const;
+
 private:
+    void publish_metrics_(core::nanoseconds_t current_time);
+
     SenderEndpoint* create_source_endpoint_(address::Protocol proto,
                                             const address::SocketAddr& outbound_address,
                                             packet::IWriter& outbound_writer);
@@ -92,6 +121,8 @@ private:
     StateTracker& state_tracker_;
     SenderSession session_;
 
+    MetricsSnapshot<SenderSlotMetrics, SenderParticipantMetrics> metrics_snapshot_;
+
     bool valid_;
 };
 
@@ -16,6 +16,7 @@ namespace pipeline {
 
 TranscoderSink::TranscoderSink(const TranscoderConfig& config,
                                audio::IFrameWriter* output_writer,
+                               audio::SincTableMap& sinc_table_map,
                                core::IPool& buffer_pool,
                                core::IArena& arena)
     : frame_factory_(buffer_pool)
@@ -58,18 +59,30 @@ TranscoderSink::TranscoderSink(const TranscoderConfig& config,
                                         audio::Sample_RawFormat,
                                         config_.input_sample_spec.channel_set());
 
-        resampler_.reset(audio::ResamplerMap::instance().new_resampler(
-            arena, frame_factory_, config_.resampler, from_spec, to_spec));
-        if (!resampler_) {
-            return;
-        }
-
-        resampler_writer_.reset(new (resampler_writer_) audio::ResamplerWriter(
-            *frm_writer, *resampler_, frame_factory_, from_spec, to_spec));
-        if (!resampler_writer_ || !resampler_writer_->is_valid()) {
-            return;
+        if (config_.num_threads > 1 && from_spec.num_channels() > 1) {
+            parallel_resampler_writer_.reset(
+                new (parallel_resampler_writer_) audio::ParallelResamplerWriter(
+                    *frm_writer, arena, frame_factory_, sinc_table_map,
+                    config_.resampler, from_spec, to_spec, config_.num_threads));
+            if (!parallel_resampler_writer_ || !parallel_resampler_writer_->is_valid()) {
+                return;
+            }
+            frm_writer = parallel_resampler_writer_.get();
+        } else {
+            resampler_.reset(audio::ResamplerMap::instance().new_resampler(
+                arena, frame_factory_, sinc_table_map, config_.resampler, from_spec,
+                to_spec));
+            if (!resampler_) {
+                return;
+            }
+
+            resampler_writer_.reset(new (resampler_writer_) audio::ResamplerWriter(
+                *frm_writer, *resampler_, frame_factory_, from_spec, to_spec));
+            if (!resampler_writer_ || !resampler_writer_->is_valid()) {
+                return;
+            }
+            frm_writer = resampler_writer_.get();
         }
-        frm_writer = resampler_writer_.get();
     }
 
     if (config_.enable_profiling) {
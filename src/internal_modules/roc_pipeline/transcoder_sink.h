@@ -16,8 +16,10 @@
 #include "roc_audio/frame_factory.h"
 #include "roc_audio/iresampler.h"
 #include "roc_audio/null_writer.h"
+#include "roc_audio/parallel_resampler_writer.h"
 #include "roc_audio/profiling_writer.h"
 #include "roc_audio/resampler_writer.h"
+#include "roc_audio/sinc_table_map.h"
 #include "roc_core/ipool.h"
 #include "roc_core/optional.h"
 #include "roc_core/scoped_ptr.h"
@@ -36,6 +38,7 @@ public:
     //! Initialize.
     TranscoderSink(const TranscoderConfig& config,
                    audio::IFrameWriter* output_writer,
+                   audio::SincTableMap& sinc_table_map,
                    core::IPool& buffer_pool,
                    core::IArena& arena);
 
@@ -88,6 +91,8 @@ private:
     core::Optional<audio::ResamplerWriter> resampler_writer_;
     core::SharedPtr<audio::IResampler> resampler_;
 
+    core::Optional<audio::ParallelResamplerWriter> parallel_resampler_writer_;
+
     core::Optional<audio::ProfilingWriter> profiler_;
 
     audio::IFrameWriter* frame_writer_;
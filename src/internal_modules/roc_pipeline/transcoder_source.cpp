@@ -16,6 +16,7 @@ namespace pipeline {
 
 TranscoderSource::TranscoderSource(const TranscoderConfig& config,
                                    sndio::ISource& input_source,
+                                   audio::SincTableMap& sinc_table_map,
                                    core::IPool& buffer_pool,
                                    core::IArena& arena)
     : frame_factory_(buffer_pool)
@@ -57,7 +58,8 @@ TranscoderSource::TranscoderSource(const TranscoderConfig& config,
                                         config_.output_sample_spec.channel_set());
 
         resampler_.reset(audio::ResamplerMap::instance().new_resampler(
-            arena, frame_factory_, config_.resampler, from_spec, to_spec));
+            arena, frame_factory_, sinc_table_map, config_.resampler, from_spec,
+            to_spec));
         if (!resampler_) {
             return;
         }
@@ -17,6 +17,7 @@
 #include "roc_audio/iresampler.h"
 #include "roc_audio/profiling_reader.h"
 #include "roc_audio/resampler_reader.h"
+#include "roc_audio/sinc_table_map.h"
 #include "roc_core/ipool.h"
 #include "roc_core/optional.h"
 #include "roc_core/scoped_ptr.h"
@@ -35,6 +36,7 @@ public:
     //! Initialize.
     TranscoderSource(const TranscoderConfig& config,
                      sndio::ISource& input_source,
+                     audio::SincTableMap& sinc_table_map,
                      core::IPool& buffer_pool,
                      core::IArena& arena);
 
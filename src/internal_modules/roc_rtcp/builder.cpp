@@ -418,6 +418,21 @@ void Builder::add_xr_queue_metrics(const header::XrQueueMetricsBlock& queue_metr
     cur_xr_block_header_->set_len_bytes(sizeof(queue_metrics));
 }
 
+void Builder::add_xr_recovery_metrics(
+    const header::XrRecoveryMetricsBlock& recovery_metrics) {
+    roc_panic_if_msg(state_ != XR_HEAD, "rtcp builder: wrong call order");
+
+    header::XrRecoveryMetricsBlock* p =
+        (header::XrRecoveryMetricsBlock*)add_block_(sizeof(recovery_metrics));
+    if (!p) {
+        return;
+    }
+    memcpy(p, &recovery_metrics, sizeof(recovery_metrics));
+
+    cur_xr_block_header_ = &p->header();
+    cur_xr_block_header_->set_len_bytes(sizeof(recovery_metrics));
+}
+
 void Builder::end_xr() {
     roc_panic_if_msg(state_ != XR_HEAD, "rtcp builder: wrong call order");
 
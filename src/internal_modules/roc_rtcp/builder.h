@@ -101,6 +101,9 @@ public:
     //! Add queue metrics block.to current XR packet.
     void add_xr_queue_metrics(const header::XrQueueMetricsBlock& queue_metrics);
 
+    //! Add recovery metrics block to current XR packet.
+    void add_xr_recovery_metrics(const header::XrRecoveryMetricsBlock& recovery_metrics);
+
     //! Finish current DLRR block.
     void end_xr_dlrr();
 
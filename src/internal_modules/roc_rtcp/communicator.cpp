@@ -7,6 +7,7 @@
  */
 
 #include "roc_rtcp/communicator.h"
+#include "roc_core/fast_random.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_core/time.h"
@@ -37,8 +38,14 @@ Communicator::Communicator(const Config& config,
     , config_(config)
     , reporter_(config, participant, arena)
     , next_deadline_(0)
+    , round_start_(0)
+    , round_interval_(0)
+    , round_addr_index_(0)
+    , round_batch_index_(0)
+    , round_batch_count_(0)
     , dest_addr_count_(0)
     , dest_addr_index_(0)
+    , dest_addr_end_(0)
     , send_stream_count_(0)
     , send_stream_index_(0)
     , recv_stream_count_(0)
@@ -318,6 +325,12 @@ void Communicator::process_extended_report_(const XrTraverser& xr) {
             reporter_.process_queue_metrics_block(xr.packet(), iter.get_queue_metrics());
         } break;
 
+        case XrTraverser::Iterator::RECOVERY_METRICS_BLOCK: {
+            // Recovery Metrics is extended receiver report.
+            reporter_.process_recovery_metrics_block(xr.packet(),
+                                                     iter.get_recovery_metrics());
+        } break;
+
         default:
             break;
         }
@@ -362,11 +375,19 @@ status::StatusCode Communicator::generate_reports(core::nanoseconds_t current_ti
         return status::StatusOK;
     }
 
-    // TODO(gh-674): use IntervalComputer
-    next_deadline_ = current_time + config_.report_interval
-        - ((current_time - next_deadline_) % config_.report_interval);
+    if (round_addr_index_ == 0) {
+        // Start new round, which will report to all destination addresses,
+        // either at once, or in multiple batches. If we're late, align
+        // round start with expected report times.
+        round_interval_ = next_round_interval_();
+        round_start_ =
+            current_time - ((current_time - next_deadline_) % round_interval_);
+        round_batch_index_ = 0;
+        round_batch_count_ = 1;
+    }
 
-    roc_log(LogTrace, "rtcp communicator: generating report packets");
+    roc_log(LogTrace, "rtcp communicator: generating report packets: first_addr=%lu",
+            (unsigned long)round_addr_index_);
 
     const status::StatusCode status = generate_packets_(current_time, PacketType_Reports);
     if (status != status::StatusOK) {
@@ -374,6 +395,8 @@ status::StatusCode Communicator::generate_reports(core::nanoseconds_t current_ti
                 status::code_to_str(status));
     }
 
+    schedule_next_batch_(current_time);
+
     return status;
 }
 
@@ -384,6 +407,10 @@ status::StatusCode Communicator::generate_goodbye(core::nanoseconds_t current_ti
 
     roc_log(LogTrace, "rtcp communicator: generating goodbye packet");
 
+    // Goodbye is sent to all addresses at once, so interrupt current round,
+    // if any, and start new one next time.
+    round_addr_index_ = 0;
+
     const status::StatusCode status = generate_packets_(current_time, PacketType_Goodbye);
     if (status != status::StatusOK) {
         roc_log(LogDebug, "rtcp communicator: generation failed: status=%s",
@@ -395,7 +422,7 @@ status::StatusCode Communicator::generate_goodbye(core::nanoseconds_t current_ti
 
 status::StatusCode Communicator::generate_packets_(core::nanoseconds_t current_time,
                                                    PacketType packet_type) {
-    status::StatusCode status = begin_packet_generation_(current_time);
+    status::StatusCode status = begin_packet_generation_(current_time, packet_type);
     if (status != status::StatusOK) {
         return status;
     }
@@ -429,18 +456,54 @@ status::StatusCode Communicator::generate_packets_(core::nanoseconds_t current_t
     return status;
 }
 
-status::StatusCode
-Communicator::begin_packet_generation_(core::nanoseconds_t current_time) {
-    const status::StatusCode status = reporter_.begin_generation(current_time);
-    roc_log(LogTrace, "rtcp communicator: begin_generation(): status=%s",
-            status::code_to_str(status));
+core::nanoseconds_t Communicator::next_round_interval_() {
+    if (!config_.enable_interval_randomization) {
+        return config_.report_interval;
+    }
 
-    if (status != status::StatusOK) {
-        return status;
+    // RFC 3550 6.3.1: randomize interval to a value uniformly distributed
+    // between 0.5 and 1.5 times the calculated interval.
+    const core::nanoseconds_t interval = config_.report_interval / 2
+        + core::nanoseconds_t(double(config_.report_interval)
+                              * (double)core::fast_random_range(0, 1000) / 1000.);
+
+    return std::max(interval, (core::nanoseconds_t)1);
+}
+
+void Communicator::schedule_next_batch_(core::nanoseconds_t current_time) {
+    if (round_batch_index_ == 0 && config_.report_batch_size != 0) {
+        // First batch of the round, now we know how many addresses there are.
+        // Split round into batches, spread evenly across the round interval.
+        const size_t batch_size = config_.report_batch_size;
+        round_batch_count_ =
+            std::max((dest_addr_count_ + batch_size - 1) / batch_size, (size_t)1);
     }
+    round_batch_index_++;
+
+    if (dest_addr_end_ < dest_addr_count_) {
+        // Some addresses are not reported yet, schedule next batch.
+        // If number of addresses grew during the round, remaining batches
+        // are generated at the end of the round.
+        round_addr_index_ = dest_addr_end_;
+        next_deadline_ = round_start_
+            + round_interval_
+                * (core::nanoseconds_t)std::min(round_batch_index_, round_batch_count_)
+                / (core::nanoseconds_t)round_batch_count_;
+    } else {
+        // Round is finished, schedule next round.
+        // TODO(gh-674): use IntervalComputer
+        round_addr_index_ = 0;
+        next_deadline_ = current_time + round_interval_
+            - ((current_time - round_start_) % round_interval_);
+    }
+}
 
+status::StatusCode
+Communicator::begin_packet_generation_(core::nanoseconds_t current_time,
+                                       PacketType packet_type) {
     dest_addr_count_ = 0;
     dest_addr_index_ = 0;
+    dest_addr_end_ = 0;
 
     send_stream_count_ = 0;
     send_stream_index_ = 0;
@@ -448,6 +511,32 @@ Communicator::begin_packet_generation_(core::nanoseconds_t current_time) {
     recv_stream_count_ = 0;
     recv_stream_index_ = 0;
 
+    status::StatusCode status;
+
+    if (packet_type == PacketType_Reports && round_addr_index_ != 0) {
+        // Continue current round with next batch of addresses.
+        // Receiving streams are queried only once per round.
+        status = reporter_.continue_generation(current_time);
+        roc_log(LogTrace, "rtcp communicator: continue_generation(): status=%s",
+                status::code_to_str(status));
+    } else {
+        status = reporter_.begin_generation(current_time);
+        roc_log(LogTrace, "rtcp communicator: begin_generation(): status=%s",
+                status::code_to_str(status));
+    }
+
+    if (status != status::StatusOK) {
+        return status;
+    }
+
+    if (packet_type == PacketType_Reports && config_.report_batch_size != 0) {
+        dest_addr_index_ = round_addr_index_;
+        dest_addr_end_ = round_addr_index_ + config_.report_batch_size;
+    } else {
+        dest_addr_index_ = 0;
+        dest_addr_end_ = (size_t)-1;
+    }
+
     return status::StatusOK;
 }
 
@@ -464,8 +553,11 @@ bool Communicator::continue_packet_generation_() {
         && recv_stream_index_ >= recv_stream_count_) {
         if (dest_addr_count_ == 0) {
             // This is the very first report, do some initialization.
+            // Addresses could disappear since previous batch, so clamp
+            // the range of current batch.
             dest_addr_count_ = reporter_.num_dest_addresses();
-            dest_addr_index_ = 0;
+            dest_addr_index_ = std::min(dest_addr_index_, dest_addr_count_);
+            dest_addr_end_ = std::min(dest_addr_end_, dest_addr_count_);
         } else {
             // We've reported all blocks for current destination address,
             // switch to next address.
@@ -475,9 +567,9 @@ bool Communicator::continue_packet_generation_() {
             dest_addr_index_++;
         }
 
-        if (dest_addr_index_ >= dest_addr_count_) {
-            // We've reported all blocks for all destination addresses (or maybe
-            // there are no destination addresses), exit generation.
+        if (dest_addr_index_ >= dest_addr_end_) {
+            // We've reported all blocks for all destination addresses of current
+            // batch (or maybe there are no destination addresses), exit generation.
             return false;
         }
 
@@ -795,6 +887,12 @@ void Communicator::generate_extended_report_(Builder& bld) {
                                                        qm_blk);
 
                 bld.add_xr_queue_metrics(qm_blk);
+
+                header::XrRecoveryMetricsBlock rm_blk;
+                reporter_.generate_recovery_metrics_block(dest_addr_index_, stream_index,
+                                                          rm_blk);
+
+                bld.add_xr_recovery_metrics(rm_blk);
             }
         }
 
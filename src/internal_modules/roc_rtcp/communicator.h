@@ -84,6 +84,8 @@ public:
 
     //! Generate and send report packet(s).
     //! Should be called according to generation_deadline().
+    //! If Config::report_batch_size is set, each call generates reports
+    //! only for next batch of destination addresses.
     //! @p current_time is current time in nanoseconds since Unix epoch.
     //! Invokes IParticipant methods during generation.
     ROC_ATTR_NODISCARD status::StatusCode
@@ -112,7 +114,11 @@ private:
     status::StatusCode generate_packets_(core::nanoseconds_t current_time,
                                          PacketType packet_type);
 
-    status::StatusCode begin_packet_generation_(core::nanoseconds_t current_time);
+    core::nanoseconds_t next_round_interval_();
+    void schedule_next_batch_(core::nanoseconds_t current_time);
+
+    status::StatusCode begin_packet_generation_(core::nanoseconds_t current_time,
+                                                PacketType packet_type);
     status::StatusCode end_packet_generation_();
     bool continue_packet_generation_();
     status::StatusCode write_generated_packet_(const packet::PacketPtr& packet);
@@ -148,8 +154,17 @@ private:
     // When generation_deadline() should be called next time.
     core::nanoseconds_t next_deadline_;
 
+    // Current round of report generation. Every round reports to all
+    // destination addresses, possibly in multiple batches.
+    core::nanoseconds_t round_start_;    // When current round started.
+    core::nanoseconds_t round_interval_; // Duration of current round.
+    size_t round_addr_index_;            // First address of next batch.
+    size_t round_batch_index_;           // Index of next batch.
+    size_t round_batch_count_;           // Total number of batches in round.
+
     size_t dest_addr_count_; // Total count of destination addresses.
     size_t dest_addr_index_; // Index of current destination address.
+    size_t dest_addr_end_;   // Index after last address of current batch.
 
     size_t send_stream_count_; // Total count of sending stream reports.
     size_t send_stream_index_; // Index of current sending stream report.
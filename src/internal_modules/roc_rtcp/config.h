@@ -40,12 +40,31 @@ struct Config {
     //! Enable generation of SDES packets.
     bool enable_sdes;
 
+    //! Maximum number of destination addresses to generate reports for
+    //! during one generation.
+    //! @remarks
+    //!  If zero, reports for all destination addresses are generated at once,
+    //!  every report interval. Otherwise, generation is split into batches,
+    //!  which are spread evenly across report interval. This is useful when
+    //!  there are many remote participants (e.g. receiver with thousands of
+    //!  senders), to avoid generating thousands of packets at once.
+    size_t report_batch_size;
+
+    //! Randomize report interval.
+    //! @remarks
+    //!  If enabled, every interval is chosen randomly in range
+    //!  [0.5, 1.5] * report_interval, as recommended by RFC 3550, to avoid
+    //!  synchronization of reports of many participants.
+    bool enable_interval_randomization;
+
     Config()
         : report_interval(core::Millisecond * 200)
         , inactivity_timeout(core::Second * 5)
         , enable_sr_rr(true)
         , enable_xr(true)
-        , enable_sdes(true) {
+        , enable_sdes(true)
+        , report_batch_size(0)
+        , enable_interval_randomization(false) {
     }
 };
 
@@ -1081,7 +1081,8 @@ enum XrBlockType {
     // RFC 6843
     XR_DELAY_METRICS = 16, //!< Delay Metrics Report Block.
     // Non-standard
-    XR_QUEUE_METRICS = 220 //!< Queue Metrics Report Block.
+    XR_QUEUE_METRICS = 220,   //!< Queue Metrics Report Block.
+    XR_RECOVERY_METRICS = 221 //!< Recovery Metrics Report Block.
 };
 
 //! XR Block Header.
@@ -1755,6 +1756,150 @@ public:
     }
 } ROC_ATTR_PACKED_END;
 
+//! XR Recovery Metrics Block.
+//!
+//! Non-standard.
+//!
+//! Reports how receiver recovered from losses:
+//!
+//!  - fec_repaired: cumulative number of lost packets restored using FEC
+//!
+//!  - fec_unrepaired: cumulative number of lost packets that were not restored
+//!                    using FEC (or all lost packets, if FEC is not used)
+//!
+//!  - late_packets: cumulative number of packets dropped by receiver because
+//!                  they arrived too late to be played
+//!
+//!  - concealed_duration: cumulative duration of gaps in stream filled by receiver
+//!                        with loss concealment or silence (in NTP format)
+//!
+//! Counters are truncated to 32 bits.
+//!
+//! @code
+//!  0               1               2               3
+//!  0 1 2 3 4 5 6 7 0 1 2 3 4 5 6 7 0 1 2 3 4 5 6 7 0 1 2 3 4 5 6 7
+//! +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! |    BT=221     | I |   resv.   |      block length = 6         |
+//! +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! |                           SSRC of Source                      |
+//! +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! |                     FEC Repaired Packets                      |
+//! +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! |                    FEC Unrepaired Packets                     |
+//! +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! |                         Late Packets                          |
+//! +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! |             Concealed Duration - Seconds (bit 0-31)           |
+//! +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! |            Concealed Duration - Fraction (bit 0-31)           |
+//! +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! @endcode
+ROC_ATTR_PACKED_BEGIN class XrRecoveryMetricsBlock {
+private:
+    enum {
+        MetricFlag_shift = 6,
+        MetricFlag_mask = 0x03,
+    };
+
+    XrBlockHeader header_;
+
+    uint32_t ssrc_;
+    uint32_t fec_repaired_;
+    uint32_t fec_unrepaired_;
+    uint32_t late_packets_;
+    NtpTimestamp64 concealed_duration_;
+
+public:
+    XrRecoveryMetricsBlock() {
+        reset();
+    }
+
+    //! Reset to initial state (all zeros).
+    void reset() {
+        header_.reset(XR_RECOVERY_METRICS);
+        ssrc_ = fec_repaired_ = fec_unrepaired_ = late_packets_ = 0;
+        concealed_duration_.set_value(MetricUnavail_64);
+    }
+
+    //! Get common block header.
+    const XrBlockHeader& header() const {
+        return header_;
+    }
+
+    //! Get common block header.
+    XrBlockHeader& header() {
+        return header_;
+    }
+
+    //! Get Interval Metrics flag.
+    MetricFlag metric_flag() const {
+        return (MetricFlag)get_bit_field<uint8_t>(header_.type_specific(),
+                                                  MetricFlag_shift, MetricFlag_mask);
+    }
+
+    //! Set Interval Metrics flag.
+    void set_metric_flag(const MetricFlag f) {
+        uint8_t t = header_.type_specific();
+        set_bit_field<uint8_t>(t, (uint8_t)f, MetricFlag_shift, MetricFlag_mask);
+        header_.set_type_specific(t);
+    }
+
+    //! Get SSRC of source being reported.
+    packet::stream_source_t ssrc() const {
+        return core::ntoh32u(ssrc_);
+    }
+
+    //! Set SSRC of source being reported.
+    void set_ssrc(const packet::stream_source_t ssrc) {
+        ssrc_ = core::hton32u(ssrc);
+    }
+
+    //! Get number of packets repaired using FEC.
+    uint32_t fec_repaired() const {
+        return core::ntoh32u(fec_repaired_);
+    }
+
+    //! Set number of packets repaired using FEC.
+    void set_fec_repaired(const uint32_t n) {
+        fec_repaired_ = core::hton32u(n);
+    }
+
+    //! Get number of lost packets not repaired using FEC.
+    uint32_t fec_unrepaired() const {
+        return core::ntoh32u(fec_unrepaired_);
+    }
+
+    //! Set number of lost packets not repaired using FEC.
+    void set_fec_unrepaired(const uint32_t n) {
+        fec_unrepaired_ = core::hton32u(n);
+    }
+
+    //! Get number of packets dropped because they were late.
+    uint32_t late_packets() const {
+        return core::ntoh32u(late_packets_);
+    }
+
+    //! Set number of packets dropped because they were late.
+    void set_late_packets(const uint32_t n) {
+        late_packets_ = core::hton32u(n);
+    }
+
+    //! Check if Concealed Duration is set.
+    bool has_concealed_duration() const {
+        return concealed_duration_.value() != MetricUnavail_64;
+    }
+
+    //! Get Concealed Duration.
+    packet::ntp_timestamp_t concealed_duration() const {
+        return concealed_duration_.value();
+    }
+
+    //! Set Concealed Duration.
+    void set_concealed_duration(const packet::ntp_timestamp_t t) {
+        concealed_duration_.set_value(ntp_clamp_64(t, MetricUnavail_64 - 1));
+    }
+} ROC_ATTR_PACKED_END;
+
 } // namespace header
 } // namespace rtcp
 } // namespace roc
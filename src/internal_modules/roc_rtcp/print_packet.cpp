@@ -203,6 +203,23 @@ void print_xr_queue_metrics(core::Printer& p, const header::XrQueueMetricsBlock&
              (long long)packet::ntp_2_nanoseconds(blk.niq_stalling()));
 }
 
+void print_xr_recovery_metrics(core::Printer& p,
+                               const header::XrRecoveryMetricsBlock& blk) {
+    p.writef("|- recovery:\n");
+
+    print_xr_block_header(p, blk.header());
+
+    p.writef("|-- block body:\n");
+    print_metric_flag(p, blk.metric_flag());
+    p.writef("|--- ssrc: %lu\n", (unsigned long)blk.ssrc());
+    p.writef("|--- fec_repaired: %lu\n", (unsigned long)blk.fec_repaired());
+    p.writef("|--- fec_unrepaired: %lu\n", (unsigned long)blk.fec_unrepaired());
+    p.writef("|--- late_packets: %lu\n", (unsigned long)blk.late_packets());
+    p.writef("|--- concealed_duration: %016llx (unix %lld)\n",
+             (unsigned long long)blk.concealed_duration(),
+             (long long)packet::ntp_2_nanoseconds(blk.concealed_duration()));
+}
+
 void print_xr(core::Printer& p, const XrTraverser& xr) {
     p.writef("+ xr:\n");
 
@@ -239,6 +256,10 @@ void print_xr(core::Printer& p, const XrTraverser& xr) {
         case XrTraverser::Iterator::QUEUE_METRICS_BLOCK:
             print_xr_queue_metrics(p, iter.get_queue_metrics());
             break;
+
+        case XrTraverser::Iterator::RECOVERY_METRICS_BLOCK:
+            print_xr_recovery_metrics(p, iter.get_recovery_metrics());
+            break;
         }
     }
 }
@@ -119,7 +119,7 @@ status::StatusCode Reporter::begin_processing(const address::SocketAddr& report_
     // to a different value, we rely on that.
     report_time_ = report_time != report_time_ ? report_time : report_time + 1;
 
-    const status::StatusCode status = refresh_streams_();
+    const status::StatusCode status = refresh_streams_(true);
     if (status != status::StatusOK) {
         report_state_ = State_Idle;
         return status;
@@ -550,6 +550,49 @@ void Reporter::process_queue_metrics_block(const header::XrPacket& xr,
     update_stream_(*stream);
 }
 
+// Process XR Recovery Metrics data generated by remote receiver.
+void Reporter::process_recovery_metrics_block(const header::XrPacket& xr,
+                                              const header::XrRecoveryMetricsBlock& blk) {
+    roc_panic_if_msg(report_state_ != State_Processing,
+                     "rtcp reporter: invalid call order");
+
+    // SSRC from XR is stream receiver (RTCP packet originator).
+    // SSRC from Recovery Metrics block is stream sender (RTCP packet recipient).
+    const packet::stream_source_t recv_source_id = xr.ssrc();
+    const packet::stream_source_t send_source_id = blk.ssrc();
+
+    detect_collision_(recv_source_id);
+
+    if (send_source_id != local_source_id_) {
+        // This report is for different sender, not for us, so ignore it.
+        // Typical for multicast sessions.
+        return;
+    }
+
+    // Report to local sending stream from remote receiver.
+    core::SharedPtr<Stream> stream = find_stream_(recv_source_id, NoAutoCreate);
+    if (!stream || !stream->has_remote_recv_report) {
+        // Ignore Recovery Metrics if there was no matching SR.
+        return;
+    }
+
+    roc_log(LogTrace,
+            "rtcp reporter: processing Recovery Metrics block:"
+            " send_ssrc=%lu recv_ssrc=%lu",
+            (unsigned long)send_source_id, (unsigned long)recv_source_id);
+
+    stream->remote_recv_report.fec_repaired_packets = blk.fec_repaired();
+    stream->remote_recv_report.fec_unrepaired_packets = blk.fec_unrepaired();
+    stream->remote_recv_report.late_packets = blk.late_packets();
+
+    if (blk.has_concealed_duration()) {
+        stream->remote_recv_report.concealed_duration =
+            packet::ntp_2_nanoseconds(blk.concealed_duration());
+    }
+
+    update_stream_(*stream);
+}
+
 // Process BYE message generated by sender.
 void Reporter::process_goodbye(const packet::stream_source_t ssrc) {
     roc_panic_if_msg(report_state_ != State_Processing,
@@ -609,7 +652,30 @@ status::StatusCode Reporter::begin_generation(core::nanoseconds_t report_time) {
     // to a different value, we rely on that.
     report_time_ = report_time != report_time_ ? report_time : report_time + 1;
 
-    const status::StatusCode status = refresh_streams_();
+    const status::StatusCode status = refresh_streams_(true);
+    if (status != status::StatusOK) {
+        report_state_ = State_Idle;
+        return status;
+    }
+
+    return status::StatusOK;
+}
+
+status::StatusCode Reporter::continue_generation(core::nanoseconds_t report_time) {
+    roc_panic_if(!is_valid());
+
+    roc_panic_if_msg(report_state_ != State_Idle, "rtcp reporter: invalid call order");
+    roc_panic_if_msg(report_time <= 0, "rtcp reporter: invalid timestamp");
+
+    report_state_ = State_Generating;
+    report_error_ = status::StatusOK;
+
+    report_time_ = report_time != report_time_ ? report_time : report_time + 1;
+
+    // Receiving streams were queried by last begin_generation(), so
+    // here we query only local sending stream, which report should
+    // correspond to timestamp of SR that we're going to generate.
+    const status::StatusCode status = refresh_streams_(false);
     if (status != status::StatusOK) {
         report_state_ = State_Idle;
         return status;
@@ -858,6 +924,32 @@ void Reporter::generate_queue_metrics_block(size_t addr_index,
     }
 }
 
+// Generate XR Recovery Metrics block to deliver to remote sender.
+void Reporter::generate_recovery_metrics_block(size_t addr_index,
+                                               size_t stream_index,
+                                               header::XrRecoveryMetricsBlock& blk) {
+    roc_panic_if_msg(!is_receiving(),
+                     "rtcp reporter: Recovery Metrics can be generated only by receiver");
+
+    Stream* stream = address_index_[addr_index]->recv_stream_index[stream_index];
+    roc_panic_if(!stream);
+
+    blk.reset();
+
+    blk.set_ssrc(stream->source_id);
+    blk.set_metric_flag(header::MetricFlag_CumulativeDuration);
+
+    // Counters are truncated to 32 bits.
+    blk.set_fec_repaired((uint32_t)stream->local_recv_report->fec_repaired_packets);
+    blk.set_fec_unrepaired((uint32_t)stream->local_recv_report->fec_unrepaired_packets);
+    blk.set_late_packets((uint32_t)stream->local_recv_report->late_packets);
+
+    if (stream->local_recv_report->concealed_duration > 0) {
+        blk.set_concealed_duration(
+            packet::nanoseconds_2_ntp(stream->local_recv_report->concealed_duration));
+    }
+}
+
 bool Reporter::need_goodbye() const {
     roc_panic_if_msg(report_state_ != State_Generating,
                      "rtcp reporter: invalid call order");
@@ -964,18 +1056,22 @@ status::StatusCode Reporter::notify_streams_() {
     return status::StatusOK;
 }
 
-status::StatusCode Reporter::refresh_streams_() {
+status::StatusCode Reporter::refresh_streams_(bool query_recv_streams) {
     status::StatusCode status;
 
     // Query up-to-date reports from IParticipant.
-    if ((status = query_streams_()) != status::StatusOK) {
-        return status;
+    query_send_stream_();
+
+    if (query_recv_streams) {
+        if ((status = query_recv_streams_()) != status::StatusOK) {
+            return status;
+        }
     }
 
     // Rebuild index if needed.
     // This happens if local or remote streams appeared or disappeared.
     // Most times it doesn't happen and it's enough to update existing
-    // streams via query_streams_() above.
+    // streams via query_xxx_() above.
     if (need_rebuild_index_) {
         if ((status = rebuild_index_()) != status::StatusOK) {
             return status;
@@ -986,7 +1082,7 @@ status::StatusCode Reporter::refresh_streams_() {
     return status::StatusOK;
 }
 
-status::StatusCode Reporter::query_streams_() {
+void Reporter::query_send_stream_() {
     // Query report of local sending stream.
     const bool is_sending = participant_.has_send_stream();
 
@@ -1003,7 +1099,9 @@ status::StatusCode Reporter::query_streams_() {
     } else {
         has_local_send_report_ = false;
     }
+}
 
+status::StatusCode Reporter::query_recv_streams_() {
     // Query reports of local receiving streams.
     const size_t recv_count = participant_.num_recv_streams();
 
@@ -1139,8 +1237,8 @@ status::StatusCode Reporter::rebuild_index_() {
         }
 
         // Save pointer to report.
-        // This report is regularly updated by query_streams_().
-        // If query_streams_() invalidates pointers, it ensures that
+        // This report is regularly updated by query_recv_streams_().
+        // If query_recv_streams_() invalidates pointers, it ensures that
         // rebuild_index_() will be called soon after it.
         stream->local_recv_report = &local_recv_reports_[recv_idx];
     }
@@ -14,7 +14,7 @@
 
 #include "roc_address/socket_addr.h"
 #include "roc_core/array.h"
-#include "roc_core/hashmap.h"
+#include "roc_core/flat_hashmap.h"
 #include "roc_core/list.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/ownership_policy.h"
@@ -146,6 +146,10 @@ public:
     void process_queue_metrics_block(const header::XrPacket& xr,
                                      const header::XrQueueMetricsBlock& blk);
 
+    //! Process XR Recovery Metrics block (extended receiver report).
+    void process_recovery_metrics_block(const header::XrPacket& xr,
+                                        const header::XrRecoveryMetricsBlock& blk);
+
     //! Process BYE message.
     void process_goodbye(packet::stream_source_t ssrc);
 
@@ -163,6 +167,14 @@ public:
     ROC_ATTR_NODISCARD status::StatusCode
     begin_generation(core::nanoseconds_t report_time);
 
+    //! Continue report generation.
+    //! Same as begin_generation(), but doesn't query receiving streams from
+    //! IParticipant and reuses reports obtained by last begin_generation().
+    //! Used when generation of reports for many streams is split into
+    //! multiple batches.
+    ROC_ATTR_NODISCARD status::StatusCode
+    continue_generation(core::nanoseconds_t report_time);
+
     //! Get number of destination addresses to which to send reports.
     size_t num_dest_addresses() const;
 
@@ -228,6 +240,13 @@ public:
                                       size_t stream_index,
                                       header::XrQueueMetricsBlock& blk);
 
+    //! Generate XR Recovery Metrics block (extended receiver report).
+    //! @p addr_index should be in range [0; num_dest_addresses()-1].
+    //! @p stream_index should be in range [0; num_receiving_streams()-1].
+    void generate_recovery_metrics_block(size_t addr_index,
+                                         size_t stream_index,
+                                         header::XrRecoveryMetricsBlock& blk);
+
     //! Check if BYE message should be included.
     bool need_goodbye() const;
 
@@ -259,7 +278,6 @@ private:
     // that receives from us and/or sends to us.
     // Stream is uniquely identified by SSRC of remote participant.
     struct Stream : core::RefCounted<Stream, core::PoolAllocation>,
-                    core::HashmapNode<>,
                     core::ListNode<> {
         Stream(core::IPool& pool,
                packet::stream_source_t source_id,
@@ -356,7 +374,6 @@ private:
     // If we're sending all reports to a single preconfigured address, there will be
     // only one instance. Otherwise there will be an instance for every unique address.
     struct Address : core::RefCounted<Address, core::PoolAllocation>,
-                     core::HashmapNode<>,
                      core::ListNode<> {
         Address(core::IPool& pool,
                 core::IArena& arena,
@@ -396,8 +413,9 @@ private:
     };
 
     status::StatusCode notify_streams_();
-    status::StatusCode refresh_streams_();
-    status::StatusCode query_streams_();
+    status::StatusCode refresh_streams_(bool query_recv_streams);
+    void query_send_stream_();
+    status::StatusCode query_recv_streams_();
     status::StatusCode rebuild_index_();
 
     void detect_timeouts_();
@@ -436,8 +454,12 @@ private:
     core::Array<RecvReport, PreallocatedStreams> local_recv_reports_;
 
     // Map of all streams, identified by SSRC.
+    // Receiver may have thousands of streams and addresses, one per remote
+    // sender, so these maps use open addressing, which is faster than
+    // chained core::Hashmap at such sizes (see bench_flat_hashmap_lookup);
+    // for maps that usually hold few elements, core::Hashmap is preferred.
     core::SlabPool<Stream, PreallocatedStreams> stream_pool_;
-    core::Hashmap<Stream, PreallocatedStreams> stream_map_;
+    core::FlatHashmap<Stream, PreallocatedStreams> stream_map_;
 
     // List of all streams (from stream map) ordered by update time.
     // Recently updated streams are moved to the front of the list.
@@ -449,7 +471,7 @@ private:
     // In Report_Back mode, addresses will be allocated as we discover
     // new remote participants.
     core::SlabPool<Address, PreallocatedAddresses> address_pool_;
-    core::Hashmap<Address, PreallocatedAddresses> address_map_;
+    core::FlatHashmap<Address, PreallocatedAddresses> address_map_;
 
     // List of all addresses (from address map) ordered by rebuild time.
     // Recently rebuilt addresses are moved to the front of the list.
@@ -158,6 +158,21 @@ struct RecvReport {
     //! on receiver.
     core::nanoseconds_t e2e_latency;
 
+    //! Cumulative count of lost packets restored using FEC.
+    uint64_t fec_repaired_packets;
+
+    //! Cumulative count of lost packets that were not restored using FEC.
+    //! If FEC is not used, all lost packets are counted here.
+    uint64_t fec_unrepaired_packets;
+
+    //! Cumulative count of packets dropped by receiver because they
+    //! arrived too late to be played.
+    uint64_t late_packets;
+
+    //! Cumulative duration of gaps in stream filled by receiver with
+    //! packet loss concealment or silence.
+    core::nanoseconds_t concealed_duration;
+
     //! Estimated offset of remote clock relative to local clock.
     //! If you add it to local timestamp, you get estimated remote timestamp.
     //! Read-only field. You can read it on sender, but you should not set
@@ -184,6 +199,10 @@ struct RecvReport {
         , niq_latency(0)
         , niq_stalling(0)
         , e2e_latency(0)
+        , fec_repaired_packets(0)
+        , fec_unrepaired_packets(0)
+        , late_packets(0)
+        , concealed_duration(0)
         , clock_offset(0)
         , rtt(0) {
     }
@@ -181,6 +181,14 @@ void XrTraverser::Iterator::next_block_() {
             }
             state_ = QUEUE_METRICS_BLOCK;
             return;
+        case header::XR_RECOVERY_METRICS:
+            if (!check_recovery_metrics_()) {
+                // Skipping invalid block.
+                error_ = true;
+                break;
+            }
+            state_ = RECOVERY_METRICS_BLOCK;
+            return;
         default:
             // Unknown block.
             break;
@@ -234,6 +242,14 @@ bool XrTraverser::Iterator::check_queue_metrics_() {
     return true;
 }
 
+bool XrTraverser::Iterator::check_recovery_metrics_() {
+    if (cur_blk_len_ != sizeof(header::XrRecoveryMetricsBlock)) {
+        return false;
+    }
+
+    return true;
+}
+
 const header::XrRrtrBlock& XrTraverser::Iterator::get_rrtr() const {
     roc_panic_if_msg(state_ != RRTR_BLOCK,
                      "xr traverser: get_rrtr() called in wrong state %d", (int)state_);
@@ -273,5 +289,14 @@ const header::XrQueueMetricsBlock& XrTraverser::Iterator::get_queue_metrics() co
     return *(const header::XrQueueMetricsBlock*)cur_blk_header_;
 }
 
+const header::XrRecoveryMetricsBlock&
+XrTraverser::Iterator::get_recovery_metrics() const {
+    roc_panic_if_msg(state_ != RECOVERY_METRICS_BLOCK,
+                     "xr traverser: get_recovery_metrics() called in wrong state %d",
+                     (int)state_);
+
+    return *(const header::XrRecoveryMetricsBlock*)cur_blk_header_;
+}
+
 } // namespace rtcp
 } // namespace roc
@@ -7,6 +7,10 @@
  */
 
 #include "roc_rtp/encoding_map.h"
+#include "roc_audio/adpcm_decoder.h"
+#include "roc_audio/adpcm_encoder.h"
+#include "roc_audio/lossless_decoder.h"
+#include "roc_audio/lossless_encoder.h"
 #include "roc_audio/pcm_decoder.h"
 #include "roc_audio/pcm_encoder.h"
 #include "roc_audio/sample_format.h"
@@ -126,6 +130,24 @@ void EncodingMap::find_codecs_(Encoding& enc) {
         }
         break;
 
+    case audio::SampleFormat_Lossless:
+        if (!enc.new_encoder) {
+            enc.new_encoder = &audio::LosslessEncoder::construct;
+        }
+        if (!enc.new_decoder) {
+            enc.new_decoder = &audio::LosslessDecoder::construct;
+        }
+        break;
+
+    case audio::SampleFormat_Adpcm:
+        if (!enc.new_encoder) {
+            enc.new_encoder = &audio::AdpcmEncoder::construct;
+        }
+        if (!enc.new_decoder) {
+            enc.new_decoder = &audio::AdpcmDecoder::construct;
+        }
+        break;
+
     case audio::SampleFormat_Invalid:
         break;
     }
@@ -8,6 +8,7 @@
 
 #include "roc_rtp/link_meter.h"
 #include "roc_core/panic.h"
+#include "roc_core/stddefs.h"
 #include "roc_packet/units.h"
 
 namespace roc {
@@ -22,7 +23,12 @@ LinkMeter::LinkMeter(const EncodingMap& encoding_map)
     , has_metrics_(false)
     , first_seqnum_(0)
     , last_seqnum_hi_(0)
-    , last_seqnum_lo_(0) {
+    , last_seqnum_lo_(0)
+    , received_packets_(0)
+    , has_prev_packet_(false)
+    , prev_stream_ts_(0)
+    , prev_receive_ts_(0)
+    , jitter_(0) {
 }
 
 bool LinkMeter::has_metrics() const {
@@ -111,7 +117,7 @@ void LinkMeter::update_metrics_(const packet::Packet& packet) {
     // also counts possible wraps.
     if (first_packet_ || packet::seqnum_diff(pkt_seqnum, last_seqnum_lo_) > 0) {
         if (pkt_seqnum < last_seqnum_lo_) {
-            last_seqnum_hi_ += (uint16_t)-1;
+            last_seqnum_hi_ += (uint32_t)1 << 16;
         }
         last_seqnum_lo_ = pkt_seqnum;
     }
@@ -119,10 +125,38 @@ void LinkMeter::update_metrics_(const packet::Packet& packet) {
     metrics_.ext_first_seqnum = first_seqnum_;
     metrics_.ext_last_seqnum = last_seqnum_hi_ + last_seqnum_lo_;
 
-    // TODO(gh-688):
-    //  - fill total_packets
-    //  - fill lost_packets
-    //  - fill jitter (use encoding_->sample_spec to convert to nanoseconds)
+    // Packets expected minus packets received, as defined in RFC 3550.
+    // Late packets are counted when they arrive, and duplicates may
+    // make the loss negative.
+    received_packets_++;
+
+    metrics_.total_packets = metrics_.ext_last_seqnum - metrics_.ext_first_seqnum + 1;
+    metrics_.lost_packets =
+        (int64_t)metrics_.total_packets - (int64_t)received_packets_;
+
+    // Interarrival jitter, as defined in RFC 3550, section 6.4.1 and A.8:
+    // mean deviation of the difference in packet spacing at receiver
+    // compared to sender, smoothed with gain 1/16.
+    const packet::stream_timestamp_t pkt_stream_ts = packet.stream_timestamp();
+    const core::nanoseconds_t pkt_receive_ts = packet.receive_timestamp();
+
+    if (pkt_receive_ts != 0) {
+        if (has_prev_packet_) {
+            const core::nanoseconds_t send_delta =
+                encoding_->sample_spec.stream_timestamp_delta_2_ns(
+                    packet::stream_timestamp_diff(pkt_stream_ts, prev_stream_ts_));
+            const core::nanoseconds_t recv_delta = pkt_receive_ts - prev_receive_ts_;
+
+            const double transit_delta = std::abs(double(recv_delta - send_delta));
+
+            jitter_ += (transit_delta - jitter_) / 16.;
+            metrics_.jitter = (core::nanoseconds_t)jitter_;
+        }
+
+        prev_stream_ts_ = pkt_stream_ts;
+        prev_receive_ts_ = pkt_receive_ts;
+        has_prev_packet_ = true;
+    }
 
     first_packet_ = false;
     has_metrics_ = true;
@@ -104,6 +104,13 @@ private:
     uint16_t first_seqnum_;
     uint32_t last_seqnum_hi_;
     uint16_t last_seqnum_lo_;
+
+    uint64_t received_packets_;
+
+    bool has_prev_packet_;
+    packet::stream_timestamp_t prev_stream_ts_;
+    core::nanoseconds_t prev_receive_ts_;
+    double jitter_;
 };
 
 } // namespace rtp
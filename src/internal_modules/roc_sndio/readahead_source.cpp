@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_sndio/readahead_source.h"
+#include "roc_core/align_ops.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+// Header of every chunk in ring buffer.
+// Chunk with zero samples marks end of stream.
+struct ChunkHeader {
+    size_t n_samples;
+};
+
+size_t chunk_size(size_t frame_size) {
+    return core::AlignOps::align_max(sizeof(ChunkHeader))
+        + core::AlignOps::align_max(frame_size * sizeof(audio::sample_t));
+}
+
+} // namespace
+
+ReadaheadSource::ReadaheadSource(ISource& source,
+                                 core::IArena& arena,
+                                 size_t frame_size,
+                                 size_t num_frames)
+    : source_(source)
+    , frame_size_(frame_size)
+    , num_frames_(num_frames)
+    , header_size_(core::AlignOps::align_max(sizeof(ChunkHeader)))
+    , ring_(arena, chunk_size(frame_size), num_frames)
+    , stop_flag_(0)
+    , chunk_(NULL)
+    , chunk_pos_(0)
+    , eof_(false)
+    , valid_(false) {
+    if (frame_size_ == 0 || num_frames_ == 0) {
+        roc_log(LogError,
+                "readahead source: invalid config: frame_size=%lu num_frames=%lu",
+                (unsigned long)frame_size_, (unsigned long)num_frames_);
+        return;
+    }
+
+    if (source_.has_clock()) {
+        roc_log(LogError, "readahead source: sources with clock not supported");
+        return;
+    }
+
+    if (!ring_.is_valid()) {
+        roc_log(LogError, "readahead source: can't allocate ring buffer");
+        return;
+    }
+
+    if (!start_()) {
+        return;
+    }
+
+    valid_ = true;
+}
+
+ReadaheadSource::~ReadaheadSource() {
+    stop_();
+}
+
+bool ReadaheadSource::is_valid() const {
+    return valid_;
+}
+
+ISink* ReadaheadSource::to_sink() {
+    return NULL;
+}
+
+ISource* ReadaheadSource::to_source() {
+    return this;
+}
+
+DeviceType ReadaheadSource::type() const {
+    return DeviceType_Source;
+}
+
+DeviceState ReadaheadSource::state() const {
+    return source_.state();
+}
+
+void ReadaheadSource::pause() {
+    // no-op
+}
+
+bool ReadaheadSource::resume() {
+    return true;
+}
+
+bool ReadaheadSource::restart() {
+    roc_panic_if(!valid_);
+
+    roc_log(LogDebug, "readahead source: restarting");
+
+    stop_();
+
+    if (!source_.restart()) {
+        return false;
+    }
+
+    return start_();
+}
+
+audio::SampleSpec ReadaheadSource::sample_spec() const {
+    return source_.sample_spec();
+}
+
+core::nanoseconds_t ReadaheadSource::latency() const {
+    return 0;
+}
+
+bool ReadaheadSource::has_latency() const {
+    return false;
+}
+
+bool ReadaheadSource::has_clock() const {
+    return false;
+}
+
+void ReadaheadSource::reclock(core::nanoseconds_t) {
+    // no-op
+}
+
+bool ReadaheadSource::read(audio::Frame& frame) {
+    roc_panic_if(!valid_);
+
+    if (eof_) {
+        return false;
+    }
+
+    audio::sample_t* frame_data = frame.raw_samples();
+    const size_t frame_size = frame.num_raw_samples();
+
+    size_t frame_pos = 0;
+
+    while (frame_pos < frame_size) {
+        if (!chunk_) {
+            full_sem_->wait();
+
+            chunk_ = ring_.begin_read();
+            chunk_pos_ = 0;
+
+            roc_panic_if(!chunk_);
+        }
+
+        const size_t chunk_samples = ((const ChunkHeader*)chunk_)->n_samples;
+
+        if (chunk_samples == 0) {
+            // Keep eof chunk in ring until restart.
+            eof_ = true;
+            break;
+        }
+
+        const size_t n_samples =
+            std::min(frame_size - frame_pos, chunk_samples - chunk_pos_);
+
+        memcpy(frame_data + frame_pos,
+               (const audio::sample_t*)(chunk_ + header_size_) + chunk_pos_,
+               n_samples * sizeof(audio::sample_t));
+
+        frame_pos += n_samples;
+        chunk_pos_ += n_samples;
+
+        if (chunk_pos_ == chunk_samples) {
+            ring_.end_read();
+            chunk_ = NULL;
+            free_sem_->post();
+        }
+    }
+
+    if (frame_pos == 0) {
+        return false;
+    }
+
+    if (frame_pos < frame_size) {
+        memset(frame_data + frame_pos, 0,
+               (frame_size - frame_pos) * sizeof(audio::sample_t));
+    }
+
+    return true;
+}
+
+void ReadaheadSource::run_() {
+    roc_log(LogDebug, "readahead source: starting reader thread");
+
+    for (;;) {
+        free_sem_->wait();
+
+        if (stop_flag_) {
+            break;
+        }
+
+        uint8_t* chunk = ring_.begin_write();
+        roc_panic_if(!chunk);
+
+        audio::Frame frame((audio::sample_t*)(chunk + header_size_), frame_size_);
+
+        const size_t n_samples = source_.read(frame) ? frame.num_raw_samples() : 0;
+        ((ChunkHeader*)chunk)->n_samples = n_samples;
+
+        ring_.end_write();
+        full_sem_->post();
+
+        if (n_samples == 0) {
+            break;
+        }
+    }
+
+    roc_log(LogDebug, "readahead source: exiting reader thread");
+}
+
+bool ReadaheadSource::start_() {
+    free_sem_.reset();
+    free_sem_.reset(new (free_sem_) core::Semaphore((unsigned)num_frames_));
+
+    full_sem_.reset();
+    full_sem_.reset(new (full_sem_) core::Semaphore(0));
+
+    stop_flag_ = 0;
+
+    chunk_ = NULL;
+    chunk_pos_ = 0;
+    eof_ = false;
+
+    thread_.reset();
+    thread_.reset(new (thread_) Reader(*this));
+
+    if (!thread_->start()) {
+        roc_log(LogError, "readahead source: can't start reader thread");
+        return false;
+    }
+
+    return true;
+}
+
+void ReadaheadSource::stop_() {
+    if (thread_ && thread_->is_joinable()) {
+        stop_flag_ = 1;
+        free_sem_->post();
+
+        thread_->join();
+    }
+
+    if (!ring_.is_valid()) {
+        return;
+    }
+
+    // Thread is stopped, now we can drop everything that was read ahead.
+    if (chunk_) {
+        ring_.end_read();
+        chunk_ = NULL;
+    }
+
+    while (ring_.begin_read()) {
+        ring_.end_read();
+    }
+}
+
+} // namespace sndio
+} // namespace roc
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_sndio/readahead_source.h
+//! @brief Read-ahead source.
+
+#ifndef ROC_SNDIO_READAHEAD_SOURCE_H_
+#define ROC_SNDIO_READAHEAD_SOURCE_H_
+
+#include "roc_audio/sample.h"
+#include "roc_core/atomic.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/spsc_byte_buffer.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/thread.h"
+#include "roc_sndio/isource.h"
+
+namespace roc {
+namespace sndio {
+
+//! Read-ahead source.
+//! @remarks
+//!  Reads frames from nested source in a background thread and keeps up to
+//!  given number of frames in a lock-free ring buffer, so that reading from
+//!  disk overlaps with processing.
+//!
+//!  Intended for sources without own clock, like files. Frames of any size
+//!  can be read; they're assembled from frames read from nested source.
+class ReadaheadSource : public ISource, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  @p frame_size defines number of samples (for all channels) in frames
+    //!  read from nested source, and @p num_frames defines how much of them
+    //!  may be read ahead.
+    ReadaheadSource(ISource& source,
+                    core::IArena& arena,
+                    size_t frame_size,
+                    size_t num_frames);
+
+    virtual ~ReadaheadSource();
+
+    //! Check if the object was successfully constructed.
+    bool is_valid() const;
+
+    //! Cast IDevice to ISink.
+    virtual ISink* to_sink();
+
+    //! Cast IDevice to ISink.
+    virtual ISource* to_source();
+
+    //! Get device type.
+    virtual DeviceType type() const;
+
+    //! Get device state.
+    virtual DeviceState state() const;
+
+    //! Pause reading.
+    virtual void pause();
+
+    //! Resume paused reading.
+    virtual bool resume();
+
+    //! Restart reading from the beginning.
+    virtual bool restart();
+
+    //! Get sample specification of the source.
+    virtual audio::SampleSpec sample_spec() const;
+
+    //! Get latency of the source.
+    virtual core::nanoseconds_t latency() const;
+
+    //! Check if the source supports latency reports.
+    virtual bool has_latency() const;
+
+    //! Check if the source has own clock.
+    virtual bool has_clock() const;
+
+    //! Adjust source clock to match consumer clock.
+    virtual void reclock(core::nanoseconds_t timestamp);
+
+    //! Read frame.
+    virtual bool read(audio::Frame& frame);
+
+private:
+    // Background reader thread.
+    // Threads can't be started twice, so a new one is created on restart.
+    class Reader : public core::Thread {
+    public:
+        explicit Reader(ReadaheadSource& owner)
+            : owner_(owner) {
+        }
+
+    private:
+        virtual void run() {
+            owner_.run_();
+        }
+
+        ReadaheadSource& owner_;
+    };
+
+    void run_();
+
+    bool start_();
+    void stop_();
+
+    ISource& source_;
+
+    const size_t frame_size_;
+    const size_t num_frames_;
+    const size_t header_size_;
+
+    core::SpscByteBuffer ring_;
+
+    core::Optional<core::Semaphore> free_sem_;
+    core::Optional<core::Semaphore> full_sem_;
+
+    core::Optional<Reader> thread_;
+
+    core::Atomic<int> stop_flag_;
+
+    uint8_t* chunk_;
+    size_t chunk_pos_;
+    bool eof_;
+
+    bool valid_;
+};
+
+} // namespace sndio
+} // namespace roc
+
+#endif // ROC_SNDIO_READAHEAD_SOURCE_H_
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "roc_sndio/mmap_wav_sink.h"
+#include "roc_audio/pcm_format.h"
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+// Initial size of file mapping.
+// When it's exceeded, mapping size is doubled.
+const size_t InitialMapSize = 4 * 1024 * 1024;
+
+const size_t HeaderSize = sizeof(WavHeader::WavHeaderData);
+
+} // namespace
+
+MmapWavSink::MmapWavSink(core::IArena& arena, const Config& config)
+    : fd_(-1)
+    , map_data_(NULL)
+    , map_size_(0)
+    , data_size_(0)
+    , valid_(false) {
+    if (config.latency != 0) {
+        roc_log(LogError, "mmap wav sink: setting io latency not supported");
+        return;
+    }
+
+    sample_spec_ = config.sample_spec;
+
+    sample_spec_.use_defaults(audio::Sample_RawFormat, audio::ChanLayout_Surround,
+                              audio::ChanOrder_Smpte, audio::ChanMask_Surround_Stereo,
+                              44100);
+
+    if (!sample_spec_.is_raw()) {
+        roc_log(LogError, "mmap wav sink: sample format can be only \"-\" or \"%s\"",
+                audio::pcm_format_to_str(audio::Sample_RawFormat));
+        return;
+    }
+
+    header_.reset(new (header_)
+                      WavHeader(sample_spec_.num_channels(), sample_spec_.sample_rate(),
+                                sizeof(audio::sample_t) * 8));
+
+    valid_ = true;
+}
+
+MmapWavSink::~MmapWavSink() {
+    close_();
+}
+
+bool MmapWavSink::is_valid() const {
+    return valid_;
+}
+
+bool MmapWavSink::open(const char* path) {
+    roc_panic_if(!valid_);
+
+    if (!open_(path)) {
+        close_();
+        return false;
+    }
+
+    return true;
+}
+
+ISink* MmapWavSink::to_sink() {
+    return this;
+}
+
+ISource* MmapWavSink::to_source() {
+    return NULL;
+}
+
+DeviceType MmapWavSink::type() const {
+    return DeviceType_Sink;
+}
+
+DeviceState MmapWavSink::state() const {
+    return DeviceState_Active;
+}
+
+void MmapWavSink::pause() {
+    // no-op
+}
+
+bool MmapWavSink::resume() {
+    return true;
+}
+
+bool MmapWavSink::restart() {
+    return true;
+}
+
+audio::SampleSpec MmapWavSink::sample_spec() const {
+    if (!map_data_) {
+        roc_panic("mmap wav sink: not opened");
+    }
+
+    return sample_spec_;
+}
+
+core::nanoseconds_t MmapWavSink::latency() const {
+    return 0;
+}
+
+bool MmapWavSink::has_latency() const {
+    return false;
+}
+
+bool MmapWavSink::has_clock() const {
+    return false;
+}
+
+void MmapWavSink::write(audio::Frame& frame) {
+    if (!map_data_) {
+        roc_panic("mmap wav sink: not opened");
+    }
+
+    const size_t n_samples = frame.num_raw_samples();
+    if (n_samples == 0) {
+        return;
+    }
+
+    const size_t n_bytes = n_samples * sizeof(audio::sample_t);
+
+    if (HeaderSize + data_size_ + n_bytes > map_size_) {
+        if (!grow_(HeaderSize + data_size_ + n_bytes)) {
+            return;
+        }
+    }
+
+    memcpy(map_data_ + HeaderSize + data_size_, frame.raw_samples(), n_bytes);
+    data_size_ += n_bytes;
+
+    const WavHeader::WavHeaderData& wav_header =
+        header_->update_and_get_header(uint32_t(n_samples / sample_spec_.num_channels()));
+    memcpy(map_data_, &wav_header, HeaderSize);
+}
+
+bool MmapWavSink::open_(const char* path) {
+    if (map_data_) {
+        roc_panic("mmap wav sink: already opened");
+    }
+
+    struct stat st;
+    if (stat(path, &st) == 0 && !S_ISREG(st.st_mode)) {
+        roc_log(LogDebug, "mmap wav sink: not a regular file");
+        return false;
+    }
+
+    fd_ = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+        roc_log(LogDebug, "mmap wav sink: can't open output file: %s",
+                core::errno_to_str(errno).c_str());
+        return false;
+    }
+
+    if (!grow_(InitialMapSize)) {
+        return false;
+    }
+
+    header_->reset_sample_counter(0);
+    memcpy(map_data_, &header_->update_and_get_header(0), HeaderSize);
+
+    roc_log(LogInfo,
+            "mmap wav sink: opened output file:"
+            " path=%s out_bits=%lu out_rate=%lu out_ch=%lu",
+            path, (unsigned long)header_->bits_per_sample(),
+            (unsigned long)header_->sample_rate(),
+            (unsigned long)header_->num_channels());
+
+    return true;
+}
+
+bool MmapWavSink::grow_(size_t min_size) {
+    size_t new_size = map_size_ != 0 ? map_size_ : InitialMapSize;
+    while (new_size < min_size) {
+        new_size *= 2;
+    }
+
+    // First extend the file, while old mapping is still valid, so that
+    // on failure we keep writing to the old mapping.
+    if (!extend_file_(new_size)) {
+        return false;
+    }
+
+    // Then map the whole extended file.
+    void* addr = mmap(NULL, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (addr == MAP_FAILED) {
+        roc_log(LogError, "mmap wav sink: mmap(): %s", core::errno_to_str(errno).c_str());
+        return false;
+    }
+
+    // And only then unmap the old region. Since mapping is shared, data written
+    // to the old region is already visible in the new one.
+    if (map_data_) {
+        if (munmap(map_data_, map_size_) != 0) {
+            roc_panic("mmap wav sink: munmap(): %s", core::errno_to_str(errno).c_str());
+        }
+    }
+
+    map_data_ = (uint8_t*)addr;
+    map_size_ = new_size;
+
+    return true;
+}
+
+bool MmapWavSink::extend_file_(size_t new_size) {
+#if !(defined(__APPLE__) && defined(__MACH__))
+    // Reserve disk blocks, so that we get an error here instead of SIGBUS when
+    // writing to mapping if disk is full.
+    const int err = posix_fallocate(fd_, 0, (off_t)new_size);
+    if (err == 0) {
+        return true;
+    }
+    if (err != EINVAL && err != EOPNOTSUPP) {
+        roc_log(LogError, "mmap wav sink: can't allocate space for output file: %s",
+                core::errno_to_str(err).c_str());
+        return false;
+    }
+    // File system doesn't support preallocation, fall back to ftruncate().
+#endif
+
+    if (ftruncate(fd_, (off_t)new_size) != 0) {
+        roc_log(LogError, "mmap wav sink: can't resize output file: %s",
+                core::errno_to_str(errno).c_str());
+        return false;
+    }
+
+    return true;
+}
+
+void MmapWavSink::close_() {
+    if (fd_ < 0) {
+        return;
+    }
+
+    roc_log(LogDebug, "mmap wav sink: closing output file");
+
+    if (map_data_) {
+        if (munmap(map_data_, map_size_) != 0) {
+            roc_panic("mmap wav sink: munmap(): %s", core::errno_to_str(errno).c_str());
+        }
+        map_data_ = NULL;
+        map_size_ = 0;
+    }
+
+    // Cut off unused preallocated tail.
+    if (ftruncate(fd_, (off_t)(HeaderSize + data_size_)) != 0) {
+        roc_log(LogError, "mmap wav sink: can't truncate output file: %s",
+                core::errno_to_str(errno).c_str());
+    }
+
+    if (::close(fd_) != 0) {
+        roc_panic("mmap wav sink: can't close output file: %s",
+                  core::errno_to_str(errno).c_str());
+    }
+
+    fd_ = -1;
+}
+
+} // namespace sndio
+} // namespace roc
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_sndio/target_posix/roc_sndio/mmap_wav_sink.h
+//! @brief Memory-mapped WAV sink.
+
+#ifndef ROC_SNDIO_MMAP_WAV_SINK_H_
+#define ROC_SNDIO_MMAP_WAV_SINK_H_
+
+#include "roc_audio/sample_spec.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_core/stddefs.h"
+#include "roc_sndio/config.h"
+#include "roc_sndio/isink.h"
+#include "roc_sndio/wav_header.h"
+
+namespace roc {
+namespace sndio {
+
+//! Memory-mapped WAV sink.
+//! @remarks
+//!  Writes 32-bit float samples directly into a shared mapping of the output
+//!  file. File is grown in large chunks, and truncated to the actual size
+//!  when sink is closed. WAV header is updated in place after every write,
+//!  without any syscalls.
+//!
+//!  Only regular files are supported; open() fails otherwise, and caller
+//!  is expected to fall back to WavSink.
+class MmapWavSink : public ISink, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    MmapWavSink(core::IArena& arena, const Config& config);
+
+    virtual ~MmapWavSink();
+
+    //! Check if the object was successfully constructed.
+    bool is_valid() const;
+
+    //! Open output file.
+    bool open(const char* path);
+
+    //! Cast IDevice to ISink.
+    virtual ISink* to_sink();
+
+    //! Cast IDevice to ISink.
+    virtual ISource* to_source();
+
+    //! Get device type.
+    virtual DeviceType type() const;
+
+    //! Get device state.
+    virtual DeviceState state() const;
+
+    //! Pause reading.
+    virtual void pause();
+
+    //! Resume paused reading.
+    virtual bool resume();
+
+    //! Restart reading from the beginning.
+    virtual bool restart();
+
+    //! Get sample specification of the sink.
+    virtual audio::SampleSpec sample_spec() const;
+
+    //! Get latency of the sink.
+    virtual core::nanoseconds_t latency() const;
+
+    //! Check if the sink supports latency reports.
+    virtual bool has_latency() const;
+
+    //! Check if the sink has own clock.
+    virtual bool has_clock() const;
+
+    //! Write audio frame.
+    virtual void write(audio::Frame& frame);
+
+private:
+    bool open_(const char* path);
+    bool grow_(size_t min_size);
+    bool extend_file_(size_t new_size);
+    void close_();
+
+    audio::SampleSpec sample_spec_;
+    core::Optional<WavHeader> header_;
+
+    int fd_;
+    uint8_t* map_data_;
+    size_t map_size_;
+
+    size_t data_size_;
+
+    bool valid_;
+};
+
+} // namespace sndio
+} // namespace roc
+
+#endif // ROC_SNDIO_MMAP_WAV_SINK_H_
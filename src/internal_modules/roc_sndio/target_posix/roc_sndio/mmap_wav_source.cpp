@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "roc_sndio/mmap_wav_source.h"
+#include "roc_core/cpu_traits.h"
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+enum {
+    WavFormat_PCM = 0x1,
+    WavFormat_IEEE_Float = 0x3,
+    WavFormat_Extensible = 0xFFFE
+};
+
+enum { RiffHeaderSize = 12, ChunkHeaderSize = 8, FmtChunkMinSize = 16 };
+
+uint16_t read_le16(const uint8_t* p) {
+    return uint16_t(p[0] | (p[1] << 8));
+}
+
+uint32_t read_le32(const uint8_t* p) {
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16)
+        | (uint32_t(p[3]) << 24);
+}
+
+bool match_id(const uint8_t* p, const char* id) {
+    return memcmp(p, id, 4) == 0;
+}
+
+void convert_s16(audio::sample_t* out, const int16_t* in, size_t n_samples) {
+    const audio::sample_t scale = audio::sample_t(1) / audio::sample_t(32768);
+
+    // Simple loop without dependencies between iterations,
+    // so that compiler can vectorize it.
+    for (size_t n = 0; n < n_samples; n++) {
+        out[n] = audio::sample_t(in[n]) * scale;
+    }
+}
+
+} // namespace
+
+MmapWavSource::MmapWavSource(core::IArena& arena, const Config& config)
+    : map_data_(NULL)
+    , map_size_(0)
+    , format_(Format_Float32)
+    , num_channels_(0)
+    , sample_rate_(0)
+    , data_(NULL)
+    , data_samples_(0)
+    , data_pos_(0)
+    , eof_(false)
+    , valid_(false) {
+    if (config.latency != 0) {
+        roc_log(LogError, "mmap wav source: setting io latency not supported");
+        return;
+    }
+
+    if (!config.sample_spec.is_empty()) {
+        roc_log(LogError, "mmap wav source: setting io encoding not supported");
+        return;
+    }
+
+    valid_ = true;
+}
+
+MmapWavSource::~MmapWavSource() {
+    close_();
+}
+
+bool MmapWavSource::is_valid() const {
+    return valid_;
+}
+
+bool MmapWavSource::open(const char* path) {
+    roc_panic_if(!valid_);
+
+    if (!open_(path)) {
+        close_();
+        return false;
+    }
+
+    return true;
+}
+
+ISink* MmapWavSource::to_sink() {
+    return NULL;
+}
+
+ISource* MmapWavSource::to_source() {
+    return this;
+}
+
+DeviceType MmapWavSource::type() const {
+    return DeviceType_Source;
+}
+
+DeviceState MmapWavSource::state() const {
+    return DeviceState_Active;
+}
+
+void MmapWavSource::pause() {
+    // no-op
+}
+
+bool MmapWavSource::resume() {
+    return true;
+}
+
+bool MmapWavSource::restart() {
+    if (!map_data_) {
+        roc_panic("mmap wav source: not opened");
+    }
+
+    roc_log(LogDebug, "mmap wav source: restarting");
+
+    data_pos_ = 0;
+    eof_ = false;
+
+    return true;
+}
+
+audio::SampleSpec MmapWavSource::sample_spec() const {
+    if (!map_data_) {
+        roc_panic("mmap wav source: not opened");
+    }
+
+    audio::ChannelSet channel_set;
+    channel_set.set_layout(audio::ChanLayout_Surround);
+    channel_set.set_order(audio::ChanOrder_Smpte);
+    channel_set.set_count(num_channels_);
+
+    return audio::SampleSpec(sample_rate_, audio::Sample_RawFormat, channel_set);
+}
+
+core::nanoseconds_t MmapWavSource::latency() const {
+    return 0;
+}
+
+bool MmapWavSource::has_latency() const {
+    return false;
+}
+
+bool MmapWavSource::has_clock() const {
+    return false;
+}
+
+void MmapWavSource::reclock(core::nanoseconds_t timestamp) {
+    // no-op
+}
+
+bool MmapWavSource::read(audio::Frame& frame) {
+    if (!map_data_) {
+        roc_panic("mmap wav source: not opened");
+    }
+
+    if (eof_) {
+        return false;
+    }
+
+    audio::sample_t* frame_data = frame.raw_samples();
+    const size_t frame_size = frame.num_raw_samples();
+
+    const size_t n_samples = std::min(frame_size, data_samples_ - data_pos_);
+
+    if (n_samples == 0) {
+        roc_log(LogDebug, "mmap wav source: got eof from input file");
+        eof_ = true;
+        return false;
+    }
+
+    switch (format_) {
+    case Format_Float32:
+        memcpy(frame_data, data_ + data_pos_ * sizeof(float),
+               n_samples * sizeof(audio::sample_t));
+        break;
+
+    case Format_SInt16:
+        convert_s16(frame_data, (const int16_t*)data_ + data_pos_, n_samples);
+        break;
+    }
+
+    data_pos_ += n_samples;
+
+    if (n_samples < frame_size) {
+        memset(frame_data + n_samples, 0,
+               (frame_size - n_samples) * sizeof(audio::sample_t));
+    }
+
+    return true;
+}
+
+bool MmapWavSource::open_(const char* path) {
+    if (map_data_) {
+        roc_panic("mmap wav source: already opened");
+    }
+
+#if ROC_CPU_ENDIAN != ROC_CPU_LE
+    roc_log(LogDebug, "mmap wav source: not supported on big-endian cpu");
+    return false;
+#endif
+
+    if (sizeof(audio::sample_t) != sizeof(float)) {
+        roc_log(LogDebug, "mmap wav source: not supported for this sample type");
+        return false;
+    }
+
+    if (!map_(path)) {
+        return false;
+    }
+
+    if (!parse_header_()) {
+        return false;
+    }
+
+    // We read file sequentially from beginning to end.
+    (void)posix_madvise(map_data_, map_size_, POSIX_MADV_SEQUENTIAL);
+
+    roc_log(LogInfo,
+            "mmap wav source: opened input file:"
+            " path=%s in_format=%s in_rate=%lu in_ch=%lu",
+            path, format_ == Format_Float32 ? "f32" : "s16",
+            (unsigned long)sample_rate_, (unsigned long)num_channels_);
+
+    return true;
+}
+
+bool MmapWavSource::map_(const char* path) {
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        roc_log(LogDebug, "mmap wav source: can't open input file: %s",
+                core::errno_to_str(errno).c_str());
+        return false;
+    }
+
+    bool ok = false;
+    struct stat st;
+
+    if (fstat(fd, &st) != 0) {
+        roc_log(LogDebug, "mmap wav source: fstat(): %s",
+                core::errno_to_str(errno).c_str());
+    } else if (!S_ISREG(st.st_mode)) {
+        roc_log(LogDebug, "mmap wav source: not a regular file");
+    } else if ((size_t)st.st_size < RiffHeaderSize) {
+        roc_log(LogDebug, "mmap wav source: file is too small");
+    } else {
+        void* addr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            roc_log(LogDebug, "mmap wav source: mmap(): %s",
+                    core::errno_to_str(errno).c_str());
+        } else {
+            map_data_ = (uint8_t*)addr;
+            map_size_ = (size_t)st.st_size;
+            ok = true;
+        }
+    }
+
+    // Mapping remains valid after descriptor is closed.
+    if (::close(fd) != 0) {
+        roc_log(LogError, "mmap wav source: close(): %s",
+                core::errno_to_str(errno).c_str());
+    }
+
+    return ok;
+}
+
+bool MmapWavSource::parse_header_() {
+    if (!match_id(map_data_, "RIFF") || !match_id(map_data_ + 8, "WAVE")) {
+        roc_log(LogDebug, "mmap wav source: not a riff/wave file");
+        return false;
+    }
+
+    bool has_fmt = false;
+    size_t bits_per_sample = 0;
+
+    size_t pos = RiffHeaderSize;
+
+    while (pos + ChunkHeaderSize <= map_size_) {
+        const uint8_t* chunk = map_data_ + pos;
+        const size_t chunk_size = read_le32(chunk + 4);
+        const size_t body_pos = pos + ChunkHeaderSize;
+        const size_t body_avail = map_size_ - body_pos;
+
+        if (match_id(chunk, "fmt ")) {
+            if (chunk_size < FmtChunkMinSize || chunk_size > body_avail) {
+                roc_log(LogDebug, "mmap wav source: bad fmt chunk");
+                return false;
+            }
+
+            const uint8_t* body = chunk + ChunkHeaderSize;
+
+            unsigned audio_format = read_le16(body);
+            num_channels_ = read_le16(body + 2);
+            sample_rate_ = read_le32(body + 4);
+            bits_per_sample = read_le16(body + 14);
+
+            if (audio_format == WavFormat_Extensible && chunk_size >= 26) {
+                // First two bytes of sub-format GUID define actual format.
+                audio_format = read_le16(body + 24);
+            }
+
+            if (audio_format == WavFormat_IEEE_Float && bits_per_sample == 32) {
+                format_ = Format_Float32;
+            } else if (audio_format == WavFormat_PCM && bits_per_sample == 16) {
+                format_ = Format_SInt16;
+            } else {
+                roc_log(LogDebug,
+                        "mmap wav source: unsupported sample format:"
+                        " audio_format=%u bits=%lu",
+                        audio_format, (unsigned long)bits_per_sample);
+                return false;
+            }
+
+            if (num_channels_ == 0 || sample_rate_ == 0) {
+                roc_log(LogDebug, "mmap wav source: bad fmt chunk");
+                return false;
+            }
+
+            has_fmt = true;
+        } else if (match_id(chunk, "data")) {
+            if (!has_fmt) {
+                roc_log(LogDebug, "mmap wav source: data chunk before fmt chunk");
+                return false;
+            }
+
+            const size_t sample_size = bits_per_sample / 8;
+
+            if ((body_pos % sample_size) != 0) {
+                roc_log(LogDebug, "mmap wav source: misaligned data chunk");
+                return false;
+            }
+
+            // Size may be unset or wrong in files written by streaming encoders,
+            // so never trust it beyond actual file size.
+            const size_t data_size = std::min(chunk_size, body_avail);
+
+            data_ = map_data_ + body_pos;
+            data_samples_ = data_size / sample_size / num_channels_ * num_channels_;
+            data_pos_ = 0;
+
+            return true;
+        }
+
+        pos = body_pos + chunk_size + (chunk_size & 1);
+    }
+
+    roc_log(LogDebug, "mmap wav source: data chunk not found");
+    return false;
+}
+
+void MmapWavSource::close_() {
+    if (map_data_) {
+        if (munmap(map_data_, map_size_) != 0) {
+            roc_panic("mmap wav source: munmap(): %s",
+                      core::errno_to_str(errno).c_str());
+        }
+        map_data_ = NULL;
+        map_size_ = 0;
+    }
+
+    data_ = NULL;
+    data_samples_ = 0;
+    data_pos_ = 0;
+}
+
+} // namespace sndio
+} // namespace roc
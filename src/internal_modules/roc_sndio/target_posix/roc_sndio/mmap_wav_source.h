@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_sndio/target_posix/roc_sndio/mmap_wav_source.h
+//! @brief Memory-mapped WAV source.
+
+#ifndef ROC_SNDIO_MMAP_WAV_SOURCE_H_
+#define ROC_SNDIO_MMAP_WAV_SOURCE_H_
+
+#include "roc_audio/sample_spec.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_sndio/config.h"
+#include "roc_sndio/isource.h"
+
+namespace roc {
+namespace sndio {
+
+//! Memory-mapped WAV source.
+//! @remarks
+//!  Maps the whole file into memory and reads samples directly from the
+//!  mapping, bypassing stdio and decoder. 32-bit float samples are copied
+//!  into frames as is, 16-bit PCM samples are converted in a single tight
+//!  loop over the whole frame. Restart is O(1).
+//!
+//!  Only regular files with 32-bit float or 16-bit PCM samples are
+//!  supported; open() fails for other files, and caller is expected to
+//!  fall back to WavSource.
+class MmapWavSource : public ISource, private core::NonCopyable<> {
+public:
+    //! Initialize.
+    MmapWavSource(core::IArena& arena, const Config& config);
+
+    virtual ~MmapWavSource();
+
+    //! Check if the object was successfully constructed.
+    bool is_valid() const;
+
+    //! Open input file.
+    bool open(const char* path);
+
+    //! Cast IDevice to ISink.
+    virtual ISink* to_sink();
+
+    //! Cast IDevice to ISink.
+    virtual ISource* to_source();
+
+    //! Get device type.
+    virtual DeviceType type() const;
+
+    //! Get device state.
+    virtual DeviceState state() const;
+
+    //! Pause reading.
+    virtual void pause();
+
+    //! Resume paused reading.
+    virtual bool resume();
+
+    //! Restart reading from the beginning.
+    virtual bool restart();
+
+    //! Get sample specification of the source.
+    virtual audio::SampleSpec sample_spec() const;
+
+    //! Get latency of the source.
+    virtual core::nanoseconds_t latency() const;
+
+    //! Check if the source supports latency reports.
+    virtual bool has_latency() const;
+
+    //! Check if the source has own clock.
+    virtual bool has_clock() const;
+
+    //! Adjust source clock to match consumer clock.
+    virtual void reclock(core::nanoseconds_t timestamp);
+
+    //! Read frame.
+    virtual bool read(audio::Frame& frame);
+
+private:
+    enum Format { Format_Float32, Format_SInt16 };
+
+    bool open_(const char* path);
+    bool map_(const char* path);
+    bool parse_header_();
+    void close_();
+
+    uint8_t* map_data_;
+    size_t map_size_;
+
+    Format format_;
+    size_t num_channels_;
+    size_t sample_rate_;
+
+    const uint8_t* data_;
+    size_t data_samples_;
+    size_t data_pos_;
+
+    bool eof_;
+
+    bool valid_;
+};
+
+} // namespace sndio
+} // namespace roc
+
+#endif // ROC_SNDIO_MMAP_WAV_SOURCE_H_
@@ -13,6 +13,11 @@
 #include "roc_sndio/wav_sink.h"
 #include "roc_sndio/wav_source.h"
 
+#ifdef ROC_TARGET_POSIX
+#include "roc_sndio/mmap_wav_sink.h"
+#include "roc_sndio/mmap_wav_source.h"
+#endif // ROC_TARGET_POSIX
+
 namespace roc {
 namespace sndio {
 
@@ -27,6 +32,52 @@ bool has_suffix(const char* str, const char* suffix) {
     return strncmp(str + len_str - len_suffix, suffix, len_suffix) == 0;
 }
 
+#ifdef ROC_TARGET_POSIX
+IDevice* open_mmap_device(DeviceType device_type,
+                          const char* path,
+                          const Config& config,
+                          core::IArena& arena) {
+    switch (device_type) {
+    case DeviceType_Sink: {
+        core::ScopedPtr<MmapWavSink> sink(new (arena) MmapWavSink(arena, config),
+                                          arena);
+        if (!sink || !sink->is_valid()) {
+            return NULL;
+        }
+
+        if (!sink->open(path)) {
+            roc_log(LogDebug, "wav backend: mmap open failed, falling back: path=%s",
+                    path);
+            return NULL;
+        }
+
+        return sink.release();
+    } break;
+
+    case DeviceType_Source: {
+        core::ScopedPtr<MmapWavSource> source(new (arena) MmapWavSource(arena, config),
+                                              arena);
+        if (!source || !source->is_valid()) {
+            return NULL;
+        }
+
+        if (!source->open(path)) {
+            roc_log(LogDebug, "wav backend: mmap open failed, falling back: path=%s",
+                    path);
+            return NULL;
+        }
+
+        return source.release();
+    } break;
+
+    default:
+        break;
+    }
+
+    return NULL;
+}
+#endif // ROC_TARGET_POSIX
+
 } // namespace
 
 WavBackend::WavBackend() {
@@ -59,6 +110,14 @@ IDevice* WavBackend::open_device(DeviceType device_type,
         }
     }
 
+#ifdef ROC_TARGET_POSIX
+    // Memory-mapped implementation is much faster, but supports only regular
+    // files and a subset of formats, so we fall back to generic one if it fails.
+    if (IDevice* device = open_mmap_device(device_type, path, config, arena)) {
+        return device;
+    }
+#endif // ROC_TARGET_POSIX
+
     switch (device_type) {
     case DeviceType_Sink: {
         core::ScopedPtr<WavSink> sink(new (arena) WavSink(arena, config), arena);
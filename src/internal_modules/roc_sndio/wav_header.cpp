@@ -27,7 +27,8 @@ WavHeader::WavHeader(uint16_t num_channels,
                                                   * (bits_per_sample / 8u)),
         core::EndianOps::swap_native_le<uint16_t>(num_channels * (bits_per_sample / 8u)),
         core::EndianOps::swap_native_le<uint16_t>(bits_per_sample),
-        core::EndianOps::swap_native_be<uint32_t>(0x64617461) /* {'d','a','t','a'} */) {
+        core::EndianOps::swap_native_be<uint32_t>(0x64617461) /* {'d','a','t','a'} */)
+    , num_samples_(0) {
 }
 
 WavHeader::WavHeaderData::WavHeaderData(uint32_t chunk_id,
@@ -124,7 +124,7 @@ void WavSink::write(audio::Frame& frame) {
         }
 
         const WavHeader::WavHeaderData& wav_header =
-            header_->update_and_get_header(n_samples);
+            header_->update_and_get_header(n_samples / sample_spec_.num_channels());
         if (fwrite(&wav_header, sizeof(wav_header), 1, output_file_) != 1) {
             roc_log(LogError, "wav sink: failed to write header: %s",
                     core::errno_to_str(errno).c_str());
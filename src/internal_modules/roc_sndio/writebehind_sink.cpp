@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_sndio/writebehind_sink.h"
+#include "roc_core/align_ops.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+// Header of every chunk in ring buffer.
+// Chunk with zero samples asks writer thread to exit.
+struct ChunkHeader {
+    size_t n_samples;
+    unsigned flags;
+    core::nanoseconds_t capture_ts;
+};
+
+size_t chunk_size(size_t frame_size) {
+    return core::AlignOps::align_max(sizeof(ChunkHeader))
+        + core::AlignOps::align_max(frame_size * sizeof(audio::sample_t));
+}
+
+} // namespace
+
+WritebehindSink::WritebehindSink(ISink& sink,
+                                 core::IArena& arena,
+                                 size_t frame_size,
+                                 size_t num_frames)
+    : sink_(sink)
+    , sample_spec_(sink.sample_spec())
+    , frame_size_(frame_size)
+    , num_frames_(num_frames)
+    , header_size_(core::AlignOps::align_max(sizeof(ChunkHeader)))
+    , ring_(arena, chunk_size(frame_size), num_frames)
+    , valid_(false) {
+    if (frame_size_ == 0 || num_frames_ == 0) {
+        roc_log(LogError,
+                "writebehind sink: invalid config: frame_size=%lu num_frames=%lu",
+                (unsigned long)frame_size_, (unsigned long)num_frames_);
+        return;
+    }
+
+    if (sink_.has_clock()) {
+        roc_log(LogError, "writebehind sink: sinks with clock not supported");
+        return;
+    }
+
+    if (!ring_.is_valid()) {
+        roc_log(LogError, "writebehind sink: can't allocate ring buffer");
+        return;
+    }
+
+    if (!start_()) {
+        return;
+    }
+
+    valid_ = true;
+}
+
+WritebehindSink::~WritebehindSink() {
+    stop_();
+}
+
+bool WritebehindSink::is_valid() const {
+    return valid_;
+}
+
+ISink* WritebehindSink::to_sink() {
+    return this;
+}
+
+ISource* WritebehindSink::to_source() {
+    return NULL;
+}
+
+DeviceType WritebehindSink::type() const {
+    return DeviceType_Sink;
+}
+
+DeviceState WritebehindSink::state() const {
+    return sink_.state();
+}
+
+void WritebehindSink::pause() {
+    // no-op
+}
+
+bool WritebehindSink::resume() {
+    return true;
+}
+
+bool WritebehindSink::restart() {
+    roc_panic_if(!valid_);
+
+    roc_log(LogDebug, "writebehind sink: restarting");
+
+    // Flush pending frames before restarting nested sink.
+    stop_();
+
+    if (!sink_.restart()) {
+        return false;
+    }
+
+    return start_();
+}
+
+audio::SampleSpec WritebehindSink::sample_spec() const {
+    return sample_spec_;
+}
+
+core::nanoseconds_t WritebehindSink::latency() const {
+    return 0;
+}
+
+bool WritebehindSink::has_latency() const {
+    return false;
+}
+
+bool WritebehindSink::has_clock() const {
+    return false;
+}
+
+void WritebehindSink::write(audio::Frame& frame) {
+    roc_panic_if(!valid_);
+
+    const audio::sample_t* frame_data = frame.raw_samples();
+    const size_t frame_size = frame.num_raw_samples();
+
+    size_t frame_pos = 0;
+
+    while (frame_pos < frame_size) {
+        const size_t n_samples = std::min(frame_size - frame_pos, frame_size_);
+
+        free_sem_->wait();
+
+        uint8_t* chunk = ring_.begin_write();
+        roc_panic_if(!chunk);
+
+        ChunkHeader& header = *(ChunkHeader*)chunk;
+
+        header.n_samples = n_samples;
+        header.flags = frame.flags();
+        header.capture_ts = frame.capture_timestamp();
+
+        if (header.capture_ts != 0 && frame_pos != 0 && sample_spec_.is_valid()) {
+            header.capture_ts += sample_spec_.samples_overall_2_ns(frame_pos);
+        }
+
+        memcpy(chunk + header_size_, frame_data + frame_pos,
+               n_samples * sizeof(audio::sample_t));
+
+        ring_.end_write();
+        full_sem_->post();
+
+        frame_pos += n_samples;
+    }
+}
+
+void WritebehindSink::run_() {
+    roc_log(LogDebug, "writebehind sink: starting writer thread");
+
+    for (;;) {
+        full_sem_->wait();
+
+        uint8_t* chunk = ring_.begin_read();
+        roc_panic_if(!chunk);
+
+        const ChunkHeader& header = *(const ChunkHeader*)chunk;
+
+        if (header.n_samples == 0) {
+            ring_.end_read();
+            break;
+        }
+
+        audio::Frame frame((audio::sample_t*)(chunk + header_size_), header.n_samples);
+
+        frame.set_flags(header.flags);
+        frame.set_capture_timestamp(header.capture_ts);
+
+        if (sample_spec_.is_valid()) {
+            frame.set_duration((packet::stream_timestamp_t)(
+                header.n_samples / sample_spec_.num_channels()));
+        }
+
+        sink_.write(frame);
+
+        ring_.end_read();
+        free_sem_->post();
+    }
+
+    roc_log(LogDebug, "writebehind sink: exiting writer thread");
+}
+
+bool WritebehindSink::start_() {
+    free_sem_.reset();
+    free_sem_.reset(new (free_sem_) core::Semaphore((unsigned)num_frames_));
+
+    full_sem_.reset();
+    full_sem_.reset(new (full_sem_) core::Semaphore(0));
+
+    thread_.reset();
+    thread_.reset(new (thread_) Writer(*this));
+
+    if (!thread_->start()) {
+        roc_log(LogError, "writebehind sink: can't start writer thread");
+        return false;
+    }
+
+    return true;
+}
+
+void WritebehindSink::stop_() {
+    if (!thread_ || !thread_->is_joinable()) {
+        return;
+    }
+
+    // Enqueue end marker after all pending frames and wait until
+    // writer thread reaches it.
+    free_sem_->wait();
+
+    uint8_t* chunk = ring_.begin_write();
+    roc_panic_if(!chunk);
+
+    ((ChunkHeader*)chunk)->n_samples = 0;
+
+    ring_.end_write();
+    full_sem_->post();
+
+    thread_->join();
+}
+
+} // namespace sndio
+} // namespace roc
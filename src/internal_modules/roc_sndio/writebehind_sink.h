@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_sndio/writebehind_sink.h
+//! @brief Write-behind sink.
+
+#ifndef ROC_SNDIO_WRITEBEHIND_SINK_H_
+#define ROC_SNDIO_WRITEBEHIND_SINK_H_
+
+#include "roc_audio/sample.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/spsc_byte_buffer.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/thread.h"
+#include "roc_sndio/isink.h"
+
+namespace roc {
+namespace sndio {
+
+//! Write-behind sink.
+//! @remarks
+//!  Copies written frames into a lock-free ring buffer and writes them to
+//!  nested sink in a background thread, so that writing to disk overlaps
+//!  with processing. Blocks only when ring buffer is full.
+//!
+//!  Intended for sinks without own clock, like files. Pending frames are
+//!  flushed to nested sink in destructor.
+class WritebehindSink : public ISink, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  @p frame_size defines maximum number of samples (for all channels) in
+    //!  frames written to nested sink; larger frames are split. @p num_frames
+    //!  defines how much of them may be pending.
+    WritebehindSink(ISink& sink, core::IArena& arena, size_t frame_size, size_t num_frames);
+
+    virtual ~WritebehindSink();
+
+    //! Check if the object was successfully constructed.
+    bool is_valid() const;
+
+    //! Cast IDevice to ISink.
+    virtual ISink* to_sink();
+
+    //! Cast IDevice to ISink.
+    virtual ISource* to_source();
+
+    //! Get device type.
+    virtual DeviceType type() const;
+
+    //! Get device state.
+    virtual DeviceState state() const;
+
+    //! Pause reading.
+    virtual void pause();
+
+    //! Resume paused reading.
+    virtual bool resume();
+
+    //! Restart reading from the beginning.
+    virtual bool restart();
+
+    //! Get sample specification of the sink.
+    virtual audio::SampleSpec sample_spec() const;
+
+    //! Get latency of the sink.
+    virtual core::nanoseconds_t latency() const;
+
+    //! Check if the sink supports latency reports.
+    virtual bool has_latency() const;
+
+    //! Check if the sink has own clock.
+    virtual bool has_clock() const;
+
+    //! Write audio frame.
+    virtual void write(audio::Frame& frame);
+
+private:
+    // Background writer thread.
+    // Threads can't be started twice, so a new one is created on restart.
+    class Writer : public core::Thread {
+    public:
+        explicit Writer(WritebehindSink& owner)
+            : owner_(owner) {
+        }
+
+    private:
+        virtual void run() {
+            owner_.run_();
+        }
+
+        WritebehindSink& owner_;
+    };
+
+    void run_();
+
+    bool start_();
+    void stop_();
+
+    ISink& sink_;
+
+    const audio::SampleSpec sample_spec_;
+
+    const size_t frame_size_;
+    const size_t num_frames_;
+    const size_t header_size_;
+
+    core::SpscByteBuffer ring_;
+
+    core::Optional<core::Semaphore> free_sem_;
+    core::Optional<core::Semaphore> full_sem_;
+
+    core::Optional<Writer> thread_;
+
+    bool valid_;
+};
+
+} // namespace sndio
+} // namespace roc
+
+#endif // ROC_SNDIO_WRITEBEHIND_SINK_H_
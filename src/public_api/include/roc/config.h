@@ -323,7 +323,31 @@ typedef enum roc_format {
      * Uncompressed samples coded as 32-bit native-endian floats in range [-1; 1].
      * Channels are interleaved, e.g. two channels are encoded as "L R L R ...".
      */
-    ROC_FORMAT_PCM_FLOAT32 = 1
+    ROC_FORMAT_PCM_FLOAT32 = 1,
+
+    /** Lossless compressed samples.
+     * Samples are quantized to 24-bit integers and compressed using linear
+     * prediction and Rice coding of residuals, similar to FLAC. Every packet
+     * is compressed independently, so losing a packet doesn't affect others.
+     * Typical music takes about half of the bandwidth of 24-bit PCM.
+     *
+     * Can be used only for packet encodings registered using
+     * roc_context_register_encoding(); can't be used for frame encoding.
+     * Packet size varies, except when FEC is enabled: FEC requires fixed
+     * packet size, so with FEC compression doesn't reduce bandwidth.
+     */
+    ROC_FORMAT_LOSSLESS = 2,
+
+    /** IMA ADPCM compressed samples.
+     * Samples are quantized to 16-bit integers and coded using 4 bits per
+     * sample, which is 4 times less than 16-bit PCM. Coding is lossy, but has
+     * low complexity and no algorithmic latency. Every packet carries predictor
+     * state, so losing a packet doesn't affect others.
+     *
+     * Can be used only for packet encodings registered using
+     * roc_context_register_encoding(); can't be used for frame encoding.
+     */
+    ROC_FORMAT_ADPCM = 3
 } roc_format;
 
 /** Channel layout.
@@ -577,7 +601,26 @@ typedef enum roc_resampler_backend {
      *
      * Recommended when CPU resources are extremely limited.
      */
-    ROC_RESAMPLER_BACKEND_SPEEXDEC = 3
+    ROC_RESAMPLER_BACKEND_SPEEXDEC = 3,
+
+    /** Fastest good-quality resampler compensating clock drift by sample slipping.
+     *
+     * Like \ref ROC_RESAMPLER_BACKEND_SPEEXDEC, this backend uses another resampler
+     * only for converting between base rates (e.g. 44100 vs 48000). Clock drift is
+     * compensated by inserting or dropping single samples, but instead of doing it
+     * abruptly, each insertion or removal is spread over a short cross-fade and is
+     * placed where the signal is quiet or flat when possible.
+     *
+     * When frame and packet sample rates are equal, samples are copied as is between
+     * slips, and CPU usage is close to memcpy().
+     *
+     * This backend can compensate only small clock drift (up to about 5%), and scaling
+     * computed by latency tuner is bounded accordingly.
+     *
+     * Recommended when CPU resources are extremely limited, but quality of
+     * \ref ROC_RESAMPLER_BACKEND_SPEEXDEC is not enough.
+     */
+    ROC_RESAMPLER_BACKEND_SLIP = 4
 } roc_resampler_backend;
 
 /** Resampler profile.
@@ -600,6 +643,30 @@ typedef enum roc_resampler_profile {
     ROC_RESAMPLER_PROFILE_LOW = 3
 } roc_resampler_profile;
 
+/** Packet loss concealment backend.
+ * Defines how receiver fills gaps caused by lost or late packets, which were
+ * not restored using FEC.
+ */
+typedef enum roc_plc_backend {
+    /** Default backend.
+     * Current default is \c ROC_PLC_BACKEND_NONE.
+     */
+    ROC_PLC_BACKEND_DEFAULT = 0,
+
+    /** No packet loss concealment.
+     * Gaps are filled with silence.
+     */
+    ROC_PLC_BACKEND_NONE = 1,
+
+    /** Pitch-based packet loss concealment.
+     *
+     * Gaps are filled by repeating the last pitch period of the signal, with
+     * gradual attenuation during long losses. Beginning and end of each gap are
+     * cross-faded with the real signal. Works best for speech and tonal music.
+     */
+    ROC_PLC_BACKEND_PITCH = 2
+} roc_plc_backend;
+
 /** Context configuration.
  *
  * It is safe to memset() this struct with zeros to get a default config. It is also
@@ -625,6 +692,65 @@ typedef struct roc_context_config {
      * If zero, default value is used.
      */
     unsigned int max_frame_size;
+
+    /** Size in bytes of pinned memory for packets and frames.
+     *
+     * If non-zero, context reserves a memory region of this size when it's opened,
+     * and allocates all network packets and internal audio frames from it. The
+     * region is backed by huge pages when the system provides them, and is locked
+     * in RAM when permitted by RLIMIT_MEMLOCK. All its pages are faulted in
+     * beforehand, so that steady-state streaming doesn't cause page faults.
+     *
+     * The region never grows. When it's exhausted, new packets and frames can't be
+     * allocated and are dropped.
+     *
+     * If zero, packets and frames are allocated from heap on demand.
+     */
+    unsigned long long pinned_memory_size;
+
+    /** Path to metrics file.
+     *
+     * If set, context periodically writes metrics of all its senders and receivers,
+     * their slots and connections, and internal memory pools, to this file in
+     * OpenMetrics text format. The file is replaced atomically, so it can be
+     * scraped at any moment, e.g. by textfile collector of Prometheus node exporter.
+     *
+     * Metrics are read from snapshots and never block audio processing.
+     *
+     * The string is copied by roc_context_open().
+     *
+     * If NULL, metrics are not exported.
+     */
+    const char* metrics_file;
+
+    /** Interval between metrics file updates, in nanoseconds.
+     *
+     * If zero, default value is used.
+     */
+    unsigned long long metrics_interval;
+
+    /** Share multicast subscriptions between receivers.
+     *
+     * When true (non-zero), receivers of this context which bind to the same
+     * multicast endpoint (same address, protocol, and
+     * \c roc_interface_config.multicast_group) don't receive and decode the
+     * stream independently. Instead, the stream is received and decoded once,
+     * and decoded frames are delivered to all such receivers.
+     *
+     * Receivers sharing a stream should use the same frame encoding, latency,
+     * FEC, and resampler settings; otherwise binding fails. Such receivers
+     * should not have other endpoints besides the shared one.
+     *
+     * The shared stream is decoded at the pace of the receiver which reads it
+     * first, and clock drift is compensated only for that receiver. Other
+     * receivers get the same frames a bit later, and may drift up to 500ms
+     * out of sync; a receiver which falls behind further skips frames. So
+     * sharing is suitable only for receivers which are clocked by the same
+     * sound card or read frames at the same pace.
+     *
+     * By default, false.
+     */
+    int shared_multicast;
 } roc_context_config;
 
 /** Sender configuration.
@@ -682,6 +808,23 @@ typedef struct roc_sender_config {
      */
     unsigned int packet_interleaving;
 
+    /** Enable packet pacing.
+     *
+     * If non-zero, the sender spreads outgoing packets in time instead of sending
+     * them in bursts. In particular, FEC repair packets, which are otherwise sent
+     * all at once at the end of every block, are spread evenly across the next
+     * block. This may reduce losses on constrained links, but slightly increases
+     * latency.
+     */
+    unsigned int packet_pacing;
+
+    /** Packet pacing rate, in bytes per second.
+     * Used if packet pacing is enabled.
+     *
+     * If zero, rate is derived from packet length and FEC block size.
+     */
+    unsigned long long packet_pacing_rate;
+
     /** FEC encoding to use.
      *
      * If FEC is enabled, the sender employs a FEC encoding to generate redundant
@@ -793,6 +936,14 @@ typedef struct roc_sender_config {
      * If zero, default value is used (if latency tuning is enabled on sender).
      */
     unsigned long long latency_tolerance;
+
+    /** Enable randomization of RTCP report interval.
+     *
+     * If non-zero, every interval between RTCP reports is chosen randomly in range
+     * [0.5, 1.5] of nominal interval, as recommended by RFC 3550. This prevents
+     * reports of many participants from synchronizing.
+     */
+    unsigned int rtcp_interval_randomization;
 } roc_sender_config;
 
 /** Receiver configuration.
@@ -910,6 +1061,74 @@ typedef struct roc_receiver_config {
      * If zero, default value is used. If negative, the check is disabled.
      */
     long long choppy_playback_timeout;
+
+    /** Enable randomization of RTCP report interval.
+     *
+     * If non-zero, every interval between RTCP reports is chosen randomly in range
+     * [0.5, 1.5] of nominal interval, as recommended by RFC 3550. This prevents
+     * reports of many participants from synchronizing.
+     */
+    unsigned int rtcp_interval_randomization;
+
+    /** Maximum number of senders to generate RTCP reports for at once.
+     *
+     * If receiver has more senders, reports to them are generated in batches,
+     * spread evenly across report interval, instead of generating all packets
+     * at once.
+     *
+     * If zero, default value is used.
+     */
+    unsigned int rtcp_report_batch_size;
+
+    /** Packet loss concealment backend.
+     * Applied to all slots of the receiver.
+     *
+     * If zero, default backend is used (\ref ROC_PLC_BACKEND_DEFAULT).
+     */
+    roc_plc_backend plc_backend;
+
+    /** Number of threads for processing senders.
+     *
+     * If greater than one, senders connected to receiver are divided between
+     * this number of threads, which decode and resample their streams in parallel.
+     * Useful when receiver handles many senders and a single CPU core can't keep
+     * up with them. Output is the same regardless of the number of threads.
+     *
+     * If zero, default value is used (one thread).
+     */
+    unsigned int session_threads;
+
+    /** Enable planar processing.
+     *
+     * If non-zero, receiver internally stores samples of every channel in a
+     * separate cache-aligned buffer instead of interleaving them. This speeds
+     * up channel mapping, resampling and mixing of streams with many channels.
+     * Resampling is done in planar layout only with builtin resampler backend;
+     * with other backends, samples are converted to planar layout after it.
+     *
+     * Frames returned by receiver are always interleaved, according to
+     * \c frame_encoding.
+     *
+     * If zero, samples are processed in interleaved layout.
+     */
+    unsigned int planar_processing;
+
+    /** Integer processing.
+     *
+     * If 16 or 32, receiver keeps samples as signed integers of that width
+     * from decoding to mixing, and mixes them with saturating integer
+     * arithmetic. This is cheaper on CPUs with slow floating point, e.g.
+     * low-power ARM boards. Resampling is done in integer format only with
+     * builtin resampler backend. Packet loss concealment, channel mapping,
+     * other resampler backends and non-PCM encodings still work with floating
+     * point samples, which are converted to integers once per session.
+     *
+     * Can't be combined with \c planar_processing. Frames returned by receiver
+     * are converted to \c frame_encoding.
+     *
+     * If zero, samples are processed as 32-bit floats.
+     */
+    unsigned int integer_processing;
 } roc_receiver_config;
 
 /** Interface configuration.
@@ -138,6 +138,23 @@ ROC_API void roc_log_set_level(roc_log_level level);
  */
 ROC_API void roc_log_set_handler(roc_log_handler handler, void* argument);
 
+/** Enable or disable asynchronous logging.
+ *
+ * If \p enabled is non-zero, logging functions invoked from library threads, including
+ * real-time audio threads, don't take locks and don't invoke the handler; instead,
+ * messages are queued and passed to the handler from a background thread. If a queue
+ * is full, messages are dropped and the number of dropped messages is reported later.
+ * By default asynchronous logging is disabled.
+ *
+ * When asynchronous logging is disabled, pending messages are passed to the handler
+ * before this function returns.
+ *
+ * **Thread safety**
+ *
+ * Can be used concurrently. Handler calls are still serialized.
+ */
+ROC_API void roc_log_set_async(int enabled);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -43,6 +43,82 @@ typedef struct roc_connection_metrics {
      * May be zero initially, until enough statistics is accumulated.
      */
     unsigned long long e2e_latency;
+
+    /** Estimated network incoming queue latency, in nanoseconds.
+     *
+     * Defines how much media is buffered in receiver packet queue.
+     *
+     * On sender, is retrieved from receiver via \ref ROC_PROTO_RTCP.
+     */
+    unsigned long long niq_latency;
+
+    /** Delay since last received packet, in nanoseconds.
+     *
+     * Defines how long there were no new packets in receiver packet queue.
+     *
+     * On sender, is retrieved from receiver via \ref ROC_PROTO_RTCP.
+     */
+    unsigned long long niq_stalling;
+
+    /** Cumulative number of lost packets.
+     *
+     * Number of packets expected minus number of packets actually received.
+     * May be negative if there are duplicates.
+     *
+     * On sender, is retrieved from receiver via \ref ROC_PROTO_RTCP.
+     */
+    long long lost_packets;
+
+    /** Estimated interarrival jitter, in nanoseconds.
+     *
+     * On sender, is retrieved from receiver via \ref ROC_PROTO_RTCP.
+     */
+    unsigned long long jitter;
+
+    /** Estimated round-trip time, in nanoseconds.
+     *
+     * Computed using \ref ROC_PROTO_RTCP. Available only on sender.
+     */
+    unsigned long long rtt;
+
+    /** Cumulative number of lost packets restored using FEC.
+     *
+     * On sender, is retrieved from receiver via \ref ROC_PROTO_RTCP.
+     */
+    unsigned long long fec_repaired_packets;
+
+    /** Scaling factor applied to resampler to compensate clock drift.
+     *
+     * Equal to 1 if latency tuning is disabled. Available only on receiver.
+     */
+    float resampler_scaling;
+
+    /** Cumulative number of lost packets that were not restored using FEC.
+     *
+     * If FEC is not used, equal to the number of lost packets.
+     *
+     * On sender, is retrieved from receiver via \ref ROC_PROTO_RTCP.
+     */
+    unsigned long long fec_unrepaired_packets;
+
+    /** Cumulative number of packets dropped because they arrived too late.
+     *
+     * Such packets arrived after receiver already played their part of the
+     * stream, and couldn't be used.
+     *
+     * On sender, is retrieved from receiver via \ref ROC_PROTO_RTCP.
+     */
+    unsigned long long late_packets;
+
+    /** Cumulative duration of concealed gaps, in nanoseconds.
+     *
+     * Defines how much of the stream was missing on receiver (because of
+     * unrepaired losses or late packets) and was filled using packet loss
+     * concealment or with silence.
+     *
+     * On sender, is retrieved from receiver via \ref ROC_PROTO_RTCP.
+     */
+    unsigned long long concealed_duration;
 } roc_connection_metrics;
 
 /** Receiver metrics.
@@ -57,6 +133,12 @@ typedef struct roc_receiver_metrics {
      * When there are no connections, receiver produces silence.
      */
     unsigned int connection_count;
+
+    /** Average time spent to process one frame, in nanoseconds.
+     *
+     * Shared by all slots of the receiver.
+     */
+    unsigned long long frame_processing_time;
 } roc_receiver_metrics;
 
 /** Sender metrics.
@@ -78,6 +160,24 @@ typedef struct roc_sender_metrics {
      * connections, one per each discovered receiver.
      */
     unsigned int connection_count;
+
+    /** Number of packets queued by pacer.
+     *
+     * Non-zero only if packet pacing is enabled (see \ref roc_sender_config).
+     */
+    unsigned int pacing_queue_depth;
+
+    /** How long recently sent packet was delayed by pacer, in nanoseconds.
+     *
+     * Non-zero only if packet pacing is enabled (see \ref roc_sender_config).
+     */
+    unsigned long long pacing_delay;
+
+    /** Average time spent to process one frame, in nanoseconds.
+     *
+     * Shared by all slots of the sender.
+     */
+    unsigned long long frame_processing_time;
 } roc_sender_metrics;
 
 #ifdef __cplusplus
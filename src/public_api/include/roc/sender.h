@@ -271,6 +271,11 @@ ROC_API int roc_sender_connect(roc_sender* sender,
  * Actual number of connections (regardless of the array size) is also written to
  * \c connection_count field of \ref roc_sender_metrics.
  *
+ * Metrics are taken from a snapshot which is periodically published by the pipeline
+ * thread, so this function never blocks audio processing and never waits for it. The
+ * snapshot is updated every few tens of milliseconds, and right away when connections
+ * are added or removed.
+ *
  * **Parameters**
  *  - \p sender should point to an opened sender
  *  - \p slot specifies the sender slot (if in doubt, use \c ROC_SLOT_DEFAULT)
@@ -12,6 +12,7 @@
 #include "roc_audio/channel_defs.h"
 #include "roc_audio/freq_estimator.h"
 #include "roc_audio/pcm_format.h"
+#include "roc_audio/plc_config.h"
 #include "roc_audio/resampler_config.h"
 #include "roc_core/attributes.h"
 #include "roc_core/log.h"
@@ -49,6 +50,20 @@ bool context_config_from_user(node::ContextConfig& out, const roc_context_config
         out.max_frame_size = in.max_frame_size;
     }
 
+    if (in.pinned_memory_size != 0) {
+        out.pinned_memory_size = (size_t)in.pinned_memory_size;
+    }
+
+    if (in.metrics_file != NULL) {
+        out.metrics_exporter.file_path = in.metrics_file;
+    }
+
+    if (in.metrics_interval != 0) {
+        out.metrics_exporter.interval = (core::nanoseconds_t)in.metrics_interval;
+    }
+
+    out.enable_shared_multicast = (in.shared_multicast != 0);
+
     return true;
 }
 
@@ -108,6 +123,13 @@ bool sender_config_from_user(node::Context& context,
 
     out.enable_interleaving = in.packet_interleaving;
 
+    out.enable_pacing = in.packet_pacing;
+    if (in.packet_pacing_rate != 0) {
+        out.pacer.rate = (size_t)in.packet_pacing_rate;
+    }
+
+    out.rtcp.enable_interval_randomization = in.rtcp_interval_randomization;
+
     if (!fec_encoding_from_user(out.fec_encoder.scheme, in.fec_encoding)) {
         roc_log(LogError,
                 "bad configuration: invalid roc_sender_config.fec_encoding:"
@@ -183,6 +205,43 @@ bool receiver_config_from_user(node::Context&,
             in.choppy_playback_timeout;
     }
 
+    out.common.rtcp.enable_interval_randomization = in.rtcp_interval_randomization;
+    if (in.rtcp_report_batch_size != 0) {
+        out.common.rtcp.report_batch_size = (size_t)in.rtcp_report_batch_size;
+    }
+
+    if (in.session_threads != 0) {
+        out.num_session_threads = (size_t)in.session_threads;
+    }
+
+    out.common.processing_layout = in.planar_processing
+        ? audio::SampleLayout_Planar
+        : audio::SampleLayout_Interleaved;
+
+    switch (in.integer_processing) {
+    case 0:
+        out.common.processing_format = audio::Sample_RawFormat;
+        break;
+    case 16:
+        out.common.processing_format = audio::PcmFormat_SInt16;
+        break;
+    case 32:
+        out.common.processing_format = audio::PcmFormat_SInt32;
+        break;
+    default:
+        roc_log(LogError,
+                "bad configuration: invalid roc_receiver_config.integer_processing:"
+                " should be 0, 16, or 32");
+        return false;
+    }
+
+    if (in.planar_processing && in.integer_processing) {
+        roc_log(LogError,
+                "bad configuration: roc_receiver_config.integer_processing can't be"
+                " combined with roc_receiver_config.planar_processing");
+        return false;
+    }
+
     out.common.enable_timing = false;
     out.common.enable_auto_reclock = true;
 
@@ -231,6 +290,13 @@ bool receiver_config_from_user(node::Context&,
         return false;
     }
 
+    if (!plc_backend_from_user(out.session_defaults.plc.backend, in.plc_backend)) {
+        roc_log(LogError,
+                "bad configuration: invalid roc_receiver_config.plc_backend:"
+                " should be valid enum value");
+        return false;
+    }
+
     return true;
 }
 
@@ -340,6 +406,28 @@ bool sample_format_from_user(audio::SampleSpec& out, roc_format in, bool is_netw
         out.set_pcm_format(is_network ? audio::PcmFormat_SInt16_Be
                                       : audio::PcmFormat_Float32);
         return true;
+
+    case ROC_FORMAT_LOSSLESS:
+        if (!is_network) {
+            roc_log(LogError,
+                    "bad configuration: ROC_FORMAT_LOSSLESS can be used only"
+                    " for packet encoding");
+            return false;
+        }
+        out.set_sample_format(audio::SampleFormat_Lossless);
+        out.set_pcm_format(audio::PcmFormat_Invalid);
+        return true;
+
+    case ROC_FORMAT_ADPCM:
+        if (!is_network) {
+            roc_log(LogError,
+                    "bad configuration: ROC_FORMAT_ADPCM can be used only"
+                    " for packet encoding");
+            return false;
+        }
+        out.set_sample_format(audio::SampleFormat_Adpcm);
+        out.set_pcm_format(audio::PcmFormat_Invalid);
+        return true;
     }
 
     return false;
@@ -448,6 +536,10 @@ bool resampler_backend_from_user(audio::ResamplerBackend& out, roc_resampler_bac
     case ROC_RESAMPLER_BACKEND_SPEEXDEC:
         out = audio::ResamplerBackend_SpeexDec;
         return true;
+
+    case ROC_RESAMPLER_BACKEND_SLIP:
+        out = audio::ResamplerBackend_Slip;
+        return true;
     }
 
     return false;
@@ -473,6 +565,25 @@ bool resampler_profile_from_user(audio::ResamplerProfile& out, roc_resampler_pro
     return false;
 }
 
+ROC_ATTR_NO_SANITIZE_UB
+bool plc_backend_from_user(audio::PlcBackend& out, roc_plc_backend in) {
+    switch (enum_from_user(in)) {
+    case ROC_PLC_BACKEND_DEFAULT:
+        out = audio::PlcBackend_Default;
+        return true;
+
+    case ROC_PLC_BACKEND_NONE:
+        out = audio::PlcBackend_None;
+        return true;
+
+    case ROC_PLC_BACKEND_PITCH:
+        out = audio::PlcBackend_Pitch;
+        return true;
+    }
+
+    return false;
+}
+
 ROC_ATTR_NO_SANITIZE_UB
 bool packet_encoding_from_user(unsigned& out_pt, roc_packet_encoding in) {
     switch (enum_from_user(in)) {
@@ -604,6 +715,38 @@ bool proto_to_user(roc_protocol& out, address::Protocol in) {
     return false;
 }
 
+ROC_ATTR_NO_SANITIZE_UB
+void connection_metrics_to_user(roc_connection_metrics& out,
+                                const packet::LinkMetrics& link_metrics,
+                                const audio::LatencyMetrics& latency_metrics) {
+    if (latency_metrics.e2e_latency > 0) {
+        out.e2e_latency = (unsigned long long)latency_metrics.e2e_latency;
+    }
+    if (latency_metrics.niq_latency > 0) {
+        out.niq_latency = (unsigned long long)latency_metrics.niq_latency;
+    }
+    if (latency_metrics.niq_stalling > 0) {
+        out.niq_stalling = (unsigned long long)latency_metrics.niq_stalling;
+    }
+
+    out.lost_packets = (long long)link_metrics.lost_packets;
+
+    if (link_metrics.jitter > 0) {
+        out.jitter = (unsigned long long)link_metrics.jitter;
+    }
+    if (link_metrics.rtt > 0) {
+        out.rtt = (unsigned long long)link_metrics.rtt;
+    }
+
+    out.fec_repaired_packets = (unsigned long long)link_metrics.fec_repaired_packets;
+    out.fec_unrepaired_packets = (unsigned long long)link_metrics.fec_unrepaired_packets;
+    out.late_packets = (unsigned long long)link_metrics.late_packets;
+
+    if (link_metrics.concealed_duration > 0) {
+        out.concealed_duration = (unsigned long long)link_metrics.concealed_duration;
+    }
+}
+
 ROC_ATTR_NO_SANITIZE_UB
 void receiver_slot_metrics_to_user(const pipeline::ReceiverSlotMetrics& slot_metrics,
                                    void* slot_arg) {
@@ -612,6 +755,11 @@ void receiver_slot_metrics_to_user(const pipeline::ReceiverSlotMetrics& slot_met
     memset(&out, 0, sizeof(out));
 
     out.connection_count = (unsigned)slot_metrics.num_participants;
+
+    if (slot_metrics.frame_processing_time > 0) {
+        out.frame_processing_time =
+            (unsigned long long)slot_metrics.frame_processing_time;
+    }
 }
 
 ROC_ATTR_NO_SANITIZE_UB
@@ -623,9 +771,9 @@ void receiver_participant_metrics_to_user(
 
     memset(&out, 0, sizeof(out));
 
-    if (party_metrics.latency.e2e_latency > 0) {
-        out.e2e_latency = (unsigned long long)party_metrics.latency.e2e_latency;
-    }
+    connection_metrics_to_user(out, party_metrics.link, party_metrics.latency);
+
+    out.resampler_scaling = party_metrics.resampler_scaling;
 }
 
 ROC_ATTR_NO_SANITIZE_UB
@@ -636,6 +784,13 @@ void sender_slot_metrics_to_user(const pipeline::SenderSlotMetrics& slot_metrics
     memset(&out, 0, sizeof(out));
 
     out.connection_count = (unsigned)slot_metrics.num_participants;
+    out.pacing_queue_depth = (unsigned)slot_metrics.pacing_queue_depth;
+    out.pacing_delay = (unsigned long long)slot_metrics.pacing_delay;
+
+    if (slot_metrics.frame_processing_time > 0) {
+        out.frame_processing_time =
+            (unsigned long long)slot_metrics.frame_processing_time;
+    }
 }
 
 ROC_ATTR_NO_SANITIZE_UB
@@ -647,9 +802,7 @@ void sender_participant_metrics_to_user(
 
     memset(&out, 0, sizeof(out));
 
-    if (party_metrics.latency.e2e_latency > 0) {
-        out.e2e_latency = (unsigned long long)party_metrics.latency.e2e_latency;
-    }
+    connection_metrics_to_user(out, party_metrics.link, party_metrics.latency);
 }
 
 ROC_ATTR_NO_SANITIZE_UB
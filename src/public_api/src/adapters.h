@@ -53,6 +53,8 @@ bool latency_tuner_profile_from_user(audio::LatencyTunerProfile& out,
 bool resampler_backend_from_user(audio::ResamplerBackend& out, roc_resampler_backend in);
 bool resampler_profile_from_user(audio::ResamplerProfile& out, roc_resampler_profile in);
 
+bool plc_backend_from_user(audio::PlcBackend& out, roc_plc_backend in);
+
 bool packet_encoding_from_user(unsigned& out_pt, roc_packet_encoding in);
 bool fec_encoding_from_user(packet::FecScheme& out, roc_fec_encoding in);
 
@@ -61,6 +63,10 @@ bool interface_from_user(address::Interface& out, const roc_interface& in);
 bool proto_from_user(address::Protocol& out, const roc_protocol& in);
 bool proto_to_user(roc_protocol& out, address::Protocol in);
 
+void connection_metrics_to_user(roc_connection_metrics& out,
+                                const packet::LinkMetrics& link_metrics,
+                                const audio::LatencyMetrics& latency_metrics);
+
 void receiver_slot_metrics_to_user(const pipeline::ReceiverSlotMetrics& slot_metrics,
                                    void* slot_arg);
 void receiver_participant_metrics_to_user(
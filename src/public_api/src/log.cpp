@@ -46,3 +46,7 @@ void roc_log_set_handler(roc_log_handler handler, void* argument) {
         core::Logger::instance().set_handler(NULL, NULL, 0);
     }
 }
+
+void roc_log_set_async(int enabled) {
+    core::Logger::instance().set_async(enabled != 0);
+}
@@ -13,6 +13,7 @@
 #include "test_helpers/receiver.h"
 #include "test_helpers/sender.h"
 
+#include "roc_core/macro_helpers.h"
 #include "roc_core/time.h"
 #include "roc_fec/codec_map.h"
 
@@ -338,6 +339,43 @@ TEST(loopback_sender_2_receiver, multiple_senders_one_receiver_sequential) {
     sender_2.join();
 }
 
+TEST(loopback_sender_2_receiver, multiple_senders_one_receiver_session_threads) {
+    enum { Flags = 0, FrameChans = 2, PacketChans = 2, SessionThreads = 4 };
+
+    init_config(Flags, FrameChans, PacketChans);
+
+    receiver_conf.session_threads = SessionThreads;
+
+    test::Context context;
+
+    test::Receiver receiver(context, receiver_conf, sample_step, FrameChans,
+                            test::FrameSamples, Flags);
+
+    receiver.bind();
+
+    test::Sender sender_1(context, sender_conf, sample_step, FrameChans,
+                          test::FrameSamples, Flags);
+
+    sender_1.connect(receiver.source_endpoint(), receiver.repair_endpoint(), NULL);
+
+    CHECK(sender_1.start());
+    receiver.receive();
+    sender_1.stop();
+    sender_1.join();
+
+    receiver.wait_zeros(test::TotalSamples / 2);
+
+    test::Sender sender_2(context, sender_conf, sample_step, FrameChans,
+                          test::FrameSamples, Flags);
+
+    sender_2.connect(receiver.source_endpoint(), receiver.repair_endpoint(), NULL);
+
+    CHECK(sender_2.start());
+    receiver.receive();
+    sender_2.stop();
+    sender_2.join();
+}
+
 TEST(loopback_sender_2_receiver, sender_slots) {
     enum { Flags = 0, FrameChans = 2, PacketChans = 2, Slot1 = 1, Slot2 = 2 };
 
@@ -481,6 +519,60 @@ TEST(loopback_sender_2_receiver, mono_stereo_mono) {
     sender.join();
 }
 
+TEST(loopback_sender_2_receiver, stereo_mono_stereo_planar) {
+    enum { Flags = 0, FrameChans = 2, PacketChans = 1 };
+
+    init_config(Flags, FrameChans, PacketChans);
+
+    receiver_conf.planar_processing = 1;
+
+    test::Context context;
+
+    test::Receiver receiver(context, receiver_conf, sample_step, FrameChans,
+                            test::FrameSamples, Flags);
+
+    receiver.bind();
+
+    test::Sender sender(context, sender_conf, sample_step, FrameChans, test::FrameSamples,
+                        Flags);
+
+    sender.connect(receiver.source_endpoint(), receiver.repair_endpoint(), NULL);
+
+    CHECK(sender.start());
+    receiver.receive();
+    sender.stop();
+    sender.join();
+}
+
+TEST(loopback_sender_2_receiver, stereo_integer) {
+    enum { Flags = 0, FrameChans = 2, PacketChans = 2 };
+
+    const unsigned int bits[] = { 16, 32 };
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(bits); n++) {
+        init_config(Flags, FrameChans, PacketChans);
+
+        receiver_conf.integer_processing = bits[n];
+
+        test::Context context;
+
+        test::Receiver receiver(context, receiver_conf, sample_step, FrameChans,
+                                test::FrameSamples, Flags);
+
+        receiver.bind();
+
+        test::Sender sender(context, sender_conf, sample_step, FrameChans,
+                            test::FrameSamples, Flags);
+
+        sender.connect(receiver.source_endpoint(), receiver.repair_endpoint(), NULL);
+
+        CHECK(sender.start());
+        receiver.receive();
+        sender.stop();
+        sender.join();
+    }
+}
+
 TEST(loopback_sender_2_receiver, multitrack) {
     enum {
         Flags = test::FlagMultitrack,
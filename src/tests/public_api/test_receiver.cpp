@@ -545,6 +545,31 @@ TEST(receiver, bad_config) {
         roc_receiver_config receiver_config_copy = receiver_config;
         receiver_config_copy.resampler_profile = (roc_resampler_profile)99999;
 
+        roc_receiver* receiver = NULL;
+        CHECK(roc_receiver_open(context, &receiver_config_copy, &receiver) != 0);
+        CHECK(!receiver);
+    }
+    { // plc_backend == 99999
+        roc_receiver_config receiver_config_copy = receiver_config;
+        receiver_config_copy.plc_backend = (roc_plc_backend)99999;
+
+        roc_receiver* receiver = NULL;
+        CHECK(roc_receiver_open(context, &receiver_config_copy, &receiver) != 0);
+        CHECK(!receiver);
+    }
+    { // integer_processing == 24
+        roc_receiver_config receiver_config_copy = receiver_config;
+        receiver_config_copy.integer_processing = 24;
+
+        roc_receiver* receiver = NULL;
+        CHECK(roc_receiver_open(context, &receiver_config_copy, &receiver) != 0);
+        CHECK(!receiver);
+    }
+    { // integer_processing != 0 && planar_processing != 0
+        roc_receiver_config receiver_config_copy = receiver_config;
+        receiver_config_copy.integer_processing = 16;
+        receiver_config_copy.planar_processing = 1;
+
         roc_receiver* receiver = NULL;
         CHECK(roc_receiver_open(context, &receiver_config_copy, &receiver) != 0);
         CHECK(!receiver);
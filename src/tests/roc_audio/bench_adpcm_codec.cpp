@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/adpcm_decoder.h"
+#include "roc_audio/adpcm_encoder.h"
+#include "roc_audio/pcm_decoder.h"
+#include "roc_audio/pcm_encoder.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_arena.h"
+
+namespace roc {
+namespace audio {
+namespace {
+
+enum { SampleRate = 44100, SamplesPerFrame = 441, MaxChans = 8, MaxFrameSize = 4096 };
+
+core::HeapArena arena;
+
+SampleSpec make_spec(SampleFormat format, size_t n_chans) {
+    SampleSpec sample_spec;
+    sample_spec.set_sample_rate(SampleRate);
+    sample_spec.set_sample_format(format);
+    sample_spec.set_pcm_format(format == SampleFormat_Pcm ? PcmFormat_SInt16_Be
+                                                          : PcmFormat_Invalid);
+    sample_spec.channel_set().set_layout(ChanLayout_Multitrack);
+    sample_spec.channel_set().set_order(ChanOrder_None);
+    sample_spec.channel_set().set_range(0, n_chans - 1);
+    return sample_spec;
+}
+
+void generate_samples(sample_t* samples, size_t n_samples) {
+    sample_t s = 0;
+    for (size_t i = 0; i < n_samples; i++) {
+        // Random walk, to make predictor work in a realistic way.
+        s += sample_t(core::fast_random_range(0, 2000)) / 100000 - sample_t(0.01);
+        s = std::max(sample_t(-0.9), std::min(sample_t(0.9), s));
+        samples[i] = s;
+    }
+}
+
+void bench_encoder(benchmark::State& state, IFrameEncoder& encoder, size_t n_chans) {
+    sample_t samples[SamplesPerFrame * MaxChans];
+    generate_samples(samples, SamplesPerFrame * n_chans);
+
+    uint8_t frame[MaxFrameSize];
+    const size_t frame_size = encoder.encoded_byte_count(SamplesPerFrame);
+
+    while (state.KeepRunning()) {
+        encoder.begin(frame, frame_size);
+        encoder.write(samples, SamplesPerFrame);
+        benchmark::DoNotOptimize(encoder.end());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * SamplesPerFrame * n_chans);
+}
+
+void bench_decoder(benchmark::State& state,
+                   IFrameEncoder& encoder,
+                   IFrameDecoder& decoder,
+                   size_t n_chans) {
+    sample_t samples[SamplesPerFrame * MaxChans];
+    generate_samples(samples, SamplesPerFrame * n_chans);
+
+    uint8_t frame[MaxFrameSize];
+    const size_t frame_size = encoder.encoded_byte_count(SamplesPerFrame);
+
+    encoder.begin(frame, frame_size);
+    encoder.write(samples, SamplesPerFrame);
+    encoder.end();
+
+    while (state.KeepRunning()) {
+        decoder.begin(0, frame, frame_size);
+        benchmark::DoNotOptimize(decoder.read(samples, SamplesPerFrame));
+        decoder.end();
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * SamplesPerFrame * n_chans);
+}
+
+void BM_Adpcm_Encode(benchmark::State& state) {
+    const size_t n_chans = (size_t)state.range(0);
+    AdpcmEncoder encoder(make_spec(SampleFormat_Adpcm, n_chans), arena);
+
+    bench_encoder(state, encoder, n_chans);
+}
+
+BENCHMARK(BM_Adpcm_Encode)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
+void BM_Adpcm_Decode(benchmark::State& state) {
+    const size_t n_chans = (size_t)state.range(0);
+    AdpcmEncoder encoder(make_spec(SampleFormat_Adpcm, n_chans), arena);
+    AdpcmDecoder decoder(make_spec(SampleFormat_Adpcm, n_chans), arena);
+
+    bench_decoder(state, encoder, decoder, n_chans);
+}
+
+BENCHMARK(BM_Adpcm_Decode)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
+// PCM for comparison.
+void BM_Pcm16_Encode(benchmark::State& state) {
+    const size_t n_chans = (size_t)state.range(0);
+    PcmEncoder encoder(make_spec(SampleFormat_Pcm, n_chans));
+
+    bench_encoder(state, encoder, n_chans);
+}
+
+BENCHMARK(BM_Pcm16_Encode)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
+void BM_Pcm16_Decode(benchmark::State& state) {
+    const size_t n_chans = (size_t)state.range(0);
+    PcmEncoder encoder(make_spec(SampleFormat_Pcm, n_chans));
+    PcmDecoder decoder(make_spec(SampleFormat_Pcm, n_chans));
+
+    bench_decoder(state, encoder, decoder, n_chans);
+}
+
+BENCHMARK(BM_Pcm16_Decode)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
+} // namespace
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/builtin_resampler.h"
+#include "roc_audio/frame_factory.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_arena.h"
+
+namespace roc {
+namespace audio {
+namespace {
+
+enum {
+    SampleRate = 48000,
+    FrameSize = 480,
+    MaxChans = 32,
+    BufferSize = FrameSize * MaxChans * sizeof(sample_t) * 2
+};
+
+core::HeapArena arena;
+FrameFactory frame_factory(arena, BufferSize);
+SincTableMap sinc_table_map(arena);
+
+void generate_noise(sample_t* samples, size_t n_samples) {
+    for (size_t i = 0; i < n_samples; i++) {
+        samples[i] = sample_t(core::fast_random_range(0, 2000)) / 1000 - 1;
+    }
+}
+
+ChannelSet make_multitrack(size_t n_chans) {
+    ChannelSet chans;
+    chans.set_layout(ChanLayout_Multitrack);
+    chans.set_order(ChanOrder_None);
+    chans.set_range(0, n_chans - 1);
+    return chans;
+}
+
+void BM_BuiltinResampler_Channels(benchmark::State& state) {
+    const size_t n_chans = (size_t)state.range(0);
+
+    const SampleSpec spec(SampleRate, Sample_RawFormat, make_multitrack(n_chans));
+
+    BuiltinResampler resampler(arena, frame_factory, sinc_table_map,
+                               ResamplerProfile_Medium, spec, spec);
+    if (!resampler.is_valid()) {
+        state.SkipWithError("can't create resampler");
+        return;
+    }
+
+    resampler.set_scaling(SampleRate, SampleRate, 1.001f);
+
+    static sample_t out_samples[FrameSize * MaxChans];
+
+    size_t n_processed = 0;
+
+    while (state.KeepRunning()) {
+        const core::Slice<sample_t>& in = resampler.begin_push_input();
+        generate_noise(in.data(), in.size());
+        resampler.end_push_input();
+
+        n_processed += resampler.pop_output(out_samples, FrameSize * n_chans) / n_chans;
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed((int64_t)n_processed);
+}
+
+BENCHMARK(BM_BuiltinResampler_Channels)->Arg(2)->Arg(8)->Arg(16)->Arg(32);
+
+void BM_BuiltinResampler_Channels_Planar(benchmark::State& state) {
+    const size_t n_chans = (size_t)state.range(0);
+
+    SampleSpec spec(SampleRate, Sample_RawFormat, make_multitrack(n_chans));
+    spec.set_sample_layout(SampleLayout_Planar);
+
+    BuiltinResampler resampler(arena, frame_factory, sinc_table_map,
+                               ResamplerProfile_Medium, spec, spec);
+    if (!resampler.is_valid()) {
+        state.SkipWithError("can't create resampler");
+        return;
+    }
+
+    resampler.set_scaling(SampleRate, SampleRate, 1.001f);
+
+    // One plane of FrameSize samples per channel.
+    static sample_t out_planes[FrameSize * MaxChans];
+
+    size_t n_processed = 0;
+
+    while (state.KeepRunning()) {
+        const core::Slice<sample_t>& in = resampler.begin_push_input();
+        generate_noise(in.data(), in.size());
+        resampler.end_push_input();
+
+        n_processed += resampler.pop_planar_output(out_planes, FrameSize, FrameSize);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed((int64_t)n_processed);
+}
+
+BENCHMARK(BM_BuiltinResampler_Channels_Planar)->Arg(2)->Arg(8)->Arg(16)->Arg(32);
+
+} // namespace
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/builtin_resampler.h"
+#include "roc_audio/mixer.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/thread.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace audio {
+namespace {
+
+enum {
+    SampleRate = 48000,
+    NumChans = 2,
+    FrameSize = 480,
+    NumSessions = 32,
+    BufferSize = FrameSize * NumChans * sizeof(sample_t) * 2
+};
+
+core::HeapArena arena;
+FrameFactory frame_factory(arena, BufferSize);
+SincTableMap sinc_table_map(arena);
+
+const SampleSpec sample_spec(SampleRate,
+                             Sample_RawFormat,
+                             ChanLayout_Surround,
+                             ChanOrder_Smpte,
+                             ChanMask_Surround_Stereo);
+
+// Reader emulating receiver session: resamples pre-generated noise with
+// slightly off scaling, like a session adjusting its clock. Noise is
+// generated in advance, because shared random generator would serialize
+// readers.
+class SessionReader : public IFrameReader {
+public:
+    SessionReader()
+        : resampler_(arena,
+                     frame_factory,
+                     sinc_table_map,
+                     ResamplerProfile_High,
+                     sample_spec,
+                     sample_spec) {
+        for (size_t i = 0; i < FrameSize * NumChans; i++) {
+            noise_[i] = sample_t(core::fast_random_range(0, 2000)) / 1000 - 1;
+        }
+        resampler_.set_scaling(SampleRate, SampleRate, 1.001f);
+    }
+
+    bool is_valid() const {
+        return resampler_.is_valid();
+    }
+
+    virtual bool read(Frame& frame) {
+        sample_t* samples = frame.raw_samples();
+        const size_t n_samples = frame.num_raw_samples();
+
+        size_t pos = 0;
+
+        while (pos < n_samples) {
+            const size_t n_popped =
+                resampler_.pop_output(samples + pos, n_samples - pos);
+
+            if (pos + n_popped < n_samples) {
+                const core::Slice<sample_t>& in = resampler_.begin_push_input();
+                for (size_t i = 0; i < in.size(); i++) {
+                    in.data()[i] = noise_[i % (FrameSize * NumChans)] * 0.01f;
+                }
+                resampler_.end_push_input();
+            }
+
+            pos += n_popped;
+        }
+
+        return true;
+    }
+
+private:
+    BuiltinResampler resampler_;
+    sample_t noise_[FrameSize * NumChans];
+};
+
+// Wall-clock time of one iteration with a single thread, measured by the
+// first run and used to report speedup of other runs.
+double single_thread_time = 0;
+
+void BM_Mixer_ParallelSessions(benchmark::State& state) {
+    const size_t n_threads = (size_t)state.range(0);
+
+    SessionReader readers[NumSessions];
+    for (size_t n = 0; n < NumSessions; n++) {
+        if (!readers[n].is_valid()) {
+            state.SkipWithError("can't create resampler");
+            return;
+        }
+    }
+
+    Mixer mixer(frame_factory, arena, sample_spec, false, n_threads);
+    if (!mixer.is_valid()) {
+        state.SkipWithError("can't create mixer");
+        return;
+    }
+
+    for (size_t n = 0; n < NumSessions; n++) {
+        mixer.add_input(readers[n]);
+    }
+
+    static sample_t samples[FrameSize * NumChans];
+
+    const core::nanoseconds_t start_time = core::timestamp(core::ClockMonotonic);
+
+    while (state.KeepRunning()) {
+        Frame frame(samples, FrameSize * NumChans);
+        mixer.read(frame);
+        benchmark::ClobberMemory();
+    }
+
+    const double iter_time =
+        double(core::timestamp(core::ClockMonotonic) - start_time)
+        / (double)state.iterations();
+
+    if (n_threads == 1) {
+        single_thread_time = iter_time;
+    }
+
+    state.SetItemsProcessed(state.iterations() * FrameSize * NumSessions);
+
+    state.counters["cpus"] = (double)core::Thread::get_cpu_count();
+    if (single_thread_time > 0) {
+        state.counters["speedup"] = single_thread_time / iter_time;
+    }
+
+    // How many times faster than real time all sessions are processed.
+    state.counters["realtime_factor"] =
+        double(core::Second) * FrameSize / SampleRate / iter_time;
+}
+
+// 1, 2, 4, ... threads, up to number of CPUs.
+void thread_args(benchmark::internal::Benchmark* b) {
+    const size_t n_cpus = core::Thread::get_cpu_count();
+
+    size_t n_threads = 1;
+    for (; n_threads < n_cpus && n_threads < NumSessions; n_threads *= 2) {
+        b->Arg((int64_t)n_threads);
+    }
+    b->Arg((int64_t)std::min(n_cpus, (size_t)NumSessions));
+}
+
+BENCHMARK(BM_Mixer_ParallelSessions)
+    ->Apply(thread_args)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace audio
+} // namespace roc
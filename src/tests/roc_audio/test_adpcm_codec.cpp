@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/adpcm_decoder.h"
+#include "roc_audio/adpcm_encoder.h"
+#include "roc_core/heap_arena.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { SampleRate = 44100, SamplesPerFrame = 441, MaxChans = 8, MaxFrameSize = 10000 };
+
+const double Pi = 3.14159265358979323846;
+
+core::HeapArena arena;
+
+SampleSpec make_spec(size_t n_chans) {
+    SampleSpec sample_spec;
+    sample_spec.set_sample_rate(SampleRate);
+    sample_spec.set_sample_format(SampleFormat_Adpcm);
+    sample_spec.channel_set().set_layout(ChanLayout_Multitrack);
+    sample_spec.channel_set().set_order(ChanOrder_None);
+    sample_spec.channel_set().set_range(0, n_chans - 1);
+    return sample_spec;
+}
+
+// Different tone on every channel.
+void generate_tones(sample_t* samples, size_t offset, size_t n_samples, size_t n_chans) {
+    for (size_t i = 0; i < n_samples; i++) {
+        const double t = double(offset + i) / SampleRate;
+        for (size_t c = 0; c < n_chans; c++) {
+            samples[i * n_chans + c] =
+                sample_t(0.5 * sin(2 * Pi * double(300 + c * 200) * t));
+        }
+    }
+}
+
+size_t encode(AdpcmEncoder& encoder,
+              uint8_t* frame,
+              const sample_t* samples,
+              size_t n_samples) {
+    const size_t frame_size = encoder.encoded_byte_count(n_samples);
+    CHECK(frame_size <= MaxFrameSize);
+
+    encoder.begin(frame, frame_size);
+    UNSIGNED_LONGS_EQUAL(n_samples, encoder.write(samples, n_samples));
+    UNSIGNED_LONGS_EQUAL(frame_size, encoder.end());
+
+    return frame_size;
+}
+
+size_t decode(AdpcmDecoder& decoder,
+              const uint8_t* frame,
+              size_t frame_size,
+              sample_t* samples) {
+    const size_t n_samples = decoder.decoded_sample_count(frame, frame_size);
+
+    decoder.begin(0, frame, frame_size);
+    UNSIGNED_LONGS_EQUAL(n_samples, decoder.available());
+    UNSIGNED_LONGS_EQUAL(n_samples, decoder.read(samples, n_samples));
+    decoder.end();
+
+    return n_samples;
+}
+
+// Signal to noise ratio, in decibels.
+double compute_snr(const sample_t* expected, const sample_t* actual, size_t n) {
+    double signal = 0, noise = 0;
+    for (size_t i = 0; i < n; i++) {
+        signal += double(expected[i]) * expected[i];
+        noise += double(expected[i] - actual[i]) * (expected[i] - actual[i]);
+    }
+    return 10 * log10(signal / noise);
+}
+
+} // namespace
+
+TEST_GROUP(adpcm_codec) {};
+
+TEST(adpcm_codec, frame_size) {
+    for (size_t n_chans = 1; n_chans <= MaxChans; n_chans++) {
+        AdpcmEncoder encoder(make_spec(n_chans), arena);
+
+        // Header: 2 bytes, plus 4 bytes per channel.
+        // Payload: 4 bits per sample.
+        UNSIGNED_LONGS_EQUAL(2 + n_chans * 4, encoder.encoded_byte_count(0));
+        UNSIGNED_LONGS_EQUAL(2 + n_chans * 4 + (SamplesPerFrame * n_chans + 1) / 2,
+                             encoder.encoded_byte_count(SamplesPerFrame));
+    }
+}
+
+TEST(adpcm_codec, tones) {
+    for (size_t n_chans = 1; n_chans <= MaxChans; n_chans++) {
+        AdpcmEncoder encoder(make_spec(n_chans), arena);
+        AdpcmDecoder decoder(make_spec(n_chans), arena);
+
+        for (size_t n = 0; n < 10; n++) {
+            sample_t input[SamplesPerFrame * MaxChans];
+            sample_t output[SamplesPerFrame * MaxChans];
+            uint8_t frame[MaxFrameSize];
+
+            generate_tones(input, n * SamplesPerFrame, SamplesPerFrame, n_chans);
+
+            const size_t frame_size = encode(encoder, frame, input, SamplesPerFrame);
+            UNSIGNED_LONGS_EQUAL(SamplesPerFrame,
+                                 decode(decoder, frame, frame_size, output));
+
+            // First frame starts with minimum step and needs time to adapt.
+            if (n > 0) {
+                CHECK(compute_snr(input, output, SamplesPerFrame * n_chans) > 25);
+            }
+        }
+    }
+}
+
+TEST(adpcm_codec, independent_frames) {
+    enum { NumFrames = 5 };
+
+    for (size_t n_chans = 1; n_chans <= MaxChans; n_chans++) {
+        AdpcmEncoder encoder(make_spec(n_chans), arena);
+
+        sample_t input[SamplesPerFrame * MaxChans];
+        uint8_t frames[NumFrames][MaxFrameSize];
+        size_t frame_sizes[NumFrames];
+
+        sample_t expected[NumFrames][SamplesPerFrame * MaxChans];
+
+        {
+            AdpcmDecoder decoder(make_spec(n_chans), arena);
+
+            for (size_t n = 0; n < NumFrames; n++) {
+                generate_tones(input, n * SamplesPerFrame, SamplesPerFrame, n_chans);
+                frame_sizes[n] = encode(encoder, frames[n], input, SamplesPerFrame);
+                decode(decoder, frames[n], frame_sizes[n], expected[n]);
+            }
+        }
+
+        // Decode frames in reverse order, every frame by new decoder and
+        // by the same decoder; results should be bit-exact.
+        AdpcmDecoder shared_decoder(make_spec(n_chans), arena);
+
+        for (size_t n = NumFrames; n > 0; n--) {
+            sample_t actual[SamplesPerFrame * MaxChans];
+
+            AdpcmDecoder decoder(make_spec(n_chans), arena);
+            decode(decoder, frames[n - 1], frame_sizes[n - 1], actual);
+            MEMCMP_EQUAL(expected[n - 1], actual,
+                         SamplesPerFrame * n_chans * sizeof(sample_t));
+
+            decode(shared_decoder, frames[n - 1], frame_sizes[n - 1], actual);
+            MEMCMP_EQUAL(expected[n - 1], actual,
+                         SamplesPerFrame * n_chans * sizeof(sample_t));
+        }
+    }
+}
+
+TEST(adpcm_codec, incremental) {
+    enum { Step = 17 };
+
+    for (size_t n_chans = 1; n_chans <= MaxChans; n_chans++) {
+        sample_t input[SamplesPerFrame * MaxChans];
+        generate_tones(input, 0, SamplesPerFrame, n_chans);
+
+        uint8_t frame1[MaxFrameSize] = {};
+        uint8_t frame2[MaxFrameSize] = {};
+
+        AdpcmEncoder encoder1(make_spec(n_chans), arena);
+        const size_t frame_size = encode(encoder1, frame1, input, SamplesPerFrame);
+
+        // Write by small chunks.
+        AdpcmEncoder encoder2(make_spec(n_chans), arena);
+        encoder2.begin(frame2, frame_size);
+        for (size_t pos = 0; pos < SamplesPerFrame;) {
+            const size_t n = std::min((size_t)Step, SamplesPerFrame - pos);
+            UNSIGNED_LONGS_EQUAL(n, encoder2.write(input + pos * n_chans, n));
+            pos += n;
+        }
+        UNSIGNED_LONGS_EQUAL(frame_size, encoder2.end());
+
+        MEMCMP_EQUAL(frame1, frame2, frame_size);
+
+        sample_t expected[SamplesPerFrame * MaxChans];
+        AdpcmDecoder decoder1(make_spec(n_chans), arena);
+        decode(decoder1, frame1, frame_size, expected);
+
+        // Read and shift by small chunks.
+        AdpcmDecoder decoder2(make_spec(n_chans), arena);
+        decoder2.begin(0, frame2, frame_size);
+        for (size_t pos = 0; pos < SamplesPerFrame;) {
+            const size_t n = std::min((size_t)Step, SamplesPerFrame - pos);
+            if ((pos / Step) % 2 == 0) {
+                sample_t actual[Step * MaxChans];
+                UNSIGNED_LONGS_EQUAL(n, decoder2.read(actual, n));
+                MEMCMP_EQUAL(expected + pos * n_chans, actual,
+                             n * n_chans * sizeof(sample_t));
+            } else {
+                UNSIGNED_LONGS_EQUAL(n, decoder2.shift(n));
+            }
+            pos += n;
+            UNSIGNED_LONGS_EQUAL(pos, decoder2.position());
+            UNSIGNED_LONGS_EQUAL(SamplesPerFrame - pos, decoder2.available());
+        }
+        decoder2.end();
+    }
+}
+
+TEST(adpcm_codec, odd_sample_count) {
+    enum { NumSamples = 11 };
+
+    AdpcmEncoder encoder(make_spec(1), arena);
+    AdpcmDecoder decoder(make_spec(1), arena);
+
+    sample_t input[NumSamples];
+    sample_t output[NumSamples];
+    generate_tones(input, 0, NumSamples, 1);
+
+    uint8_t frame[MaxFrameSize];
+    const size_t frame_size = encode(encoder, frame, input, NumSamples);
+
+    UNSIGNED_LONGS_EQUAL(2 + 4 + 6, frame_size);
+    UNSIGNED_LONGS_EQUAL(0, frame[frame_size - 1] & 0xf0);
+
+    UNSIGNED_LONGS_EQUAL(NumSamples, decode(decoder, frame, frame_size, output));
+}
+
+TEST(adpcm_codec, write_too_much) {
+    enum { NumSamples = 100 };
+
+    AdpcmEncoder encoder(make_spec(2), arena);
+
+    sample_t input[NumSamples * 2];
+    generate_tones(input, 0, NumSamples, 2);
+
+    uint8_t frame[MaxFrameSize];
+    const size_t frame_size = encoder.encoded_byte_count(NumSamples / 2);
+
+    encoder.begin(frame, frame_size);
+    UNSIGNED_LONGS_EQUAL(NumSamples / 2, encoder.write(input, NumSamples));
+    UNSIGNED_LONGS_EQUAL(0, encoder.write(input, NumSamples));
+    UNSIGNED_LONGS_EQUAL(frame_size, encoder.end());
+}
+
+TEST(adpcm_codec, empty_frame) {
+    AdpcmEncoder encoder(make_spec(2), arena);
+    AdpcmDecoder decoder(make_spec(2), arena);
+
+    uint8_t frame[MaxFrameSize];
+
+    encoder.begin(frame, MaxFrameSize);
+    UNSIGNED_LONGS_EQUAL(encoder.encoded_byte_count(0), encoder.end());
+
+    UNSIGNED_LONGS_EQUAL(
+        0, decoder.decoded_sample_count(frame, encoder.encoded_byte_count(0)));
+}
+
+TEST(adpcm_codec, malformed_frames) {
+    AdpcmEncoder encoder(make_spec(2), arena);
+    AdpcmDecoder decoder(make_spec(2), arena);
+
+    sample_t input[SamplesPerFrame * 2];
+    sample_t output[SamplesPerFrame * 2];
+    generate_tones(input, 0, SamplesPerFrame, 2);
+
+    uint8_t frame[MaxFrameSize];
+    const size_t frame_size = encode(encoder, frame, input, SamplesPerFrame);
+
+    { // too short for header
+        UNSIGNED_LONGS_EQUAL(0, decoder.decoded_sample_count(frame, 1));
+
+        decoder.begin(100, frame, 1);
+        UNSIGNED_LONGS_EQUAL(100, decoder.position());
+        UNSIGNED_LONGS_EQUAL(0, decoder.available());
+        decoder.end();
+    }
+    { // truncated
+        UNSIGNED_LONGS_EQUAL(0, decoder.decoded_sample_count(frame, frame_size - 1));
+
+        decoder.begin(100, frame, frame_size - 1);
+        UNSIGNED_LONGS_EQUAL(0, decoder.available());
+        UNSIGNED_LONGS_EQUAL(0, decoder.read(output, SamplesPerFrame));
+        decoder.end();
+    }
+    { // bad step index
+        uint8_t bad_frame[MaxFrameSize];
+        memcpy(bad_frame, frame, frame_size);
+        bad_frame[2 + 4 + 2] = 100;
+
+        decoder.begin(100, bad_frame, frame_size);
+        UNSIGNED_LONGS_EQUAL(0, decoder.available());
+        decoder.end();
+    }
+    { // still can decode valid frame
+        UNSIGNED_LONGS_EQUAL(SamplesPerFrame, decode(decoder, frame, frame_size, output));
+    }
+}
+
+} // namespace audio
+} // namespace roc
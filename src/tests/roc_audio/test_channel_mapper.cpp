@@ -12,6 +12,7 @@
 #include "roc_audio/channel_mapper.h"
 #include "roc_audio/channel_set.h"
 #include "roc_audio/channel_tables.h"
+#include "roc_audio/sample_layout.h"
 #include "roc_core/macro_helpers.h"
 
 namespace roc {
@@ -19,7 +20,7 @@ namespace audio {
 
 namespace {
 
-enum { MaxSamples = 100 };
+enum { MaxSamples = 100, MaxPlanarSamples = 1000 };
 
 const double Epsilon = 0.005;
 
@@ -80,6 +81,32 @@ void check(const sample_t* input,
             FAIL("unexpected samples");
         }
     }
+
+    // Planar mapping should produce exactly the same samples.
+    const size_t stride = plane_stride(n_samples);
+
+    CHECK(in_chans.num_channels() * stride <= MaxPlanarSamples);
+    CHECK(out_chans.num_channels() * stride <= MaxPlanarSamples);
+
+    sample_t planar_input[MaxPlanarSamples] = {};
+    sample_t planar_output[MaxPlanarSamples] = {};
+    memset(planar_output, 0xff, MaxPlanarSamples * sizeof(sample_t));
+
+    deinterleave_samples(input, planar_input, stride, in_chans.num_channels(),
+                         n_samples);
+    mapper.map_planar(planar_input, stride, planar_output, stride, n_samples);
+
+    sample_t actual_planar_output[MaxSamples] = {};
+    interleave_samples(planar_output, stride, actual_planar_output,
+                       out_chans.num_channels(), n_samples);
+
+    for (size_t n = 0; n < n_samples * out_chans.num_channels(); n++) {
+        if (actual_planar_output[n] != actual_output[n]) {
+            dump("interleaved", actual_output, n_samples, out_chans);
+            dump("planar", actual_planar_output, n_samples, out_chans);
+            FAIL("planar samples differ from interleaved");
+        }
+    }
 }
 
 } // namespace
@@ -26,6 +26,7 @@ enum { MaxSz = 500 };
 
 core::HeapArena arena;
 FrameFactory frame_factory(arena, MaxSz * sizeof(sample_t));
+FrameFactory large_frame_factory(arena, MaxSz * 4 * sizeof(sample_t));
 
 void add_mono(test::MockReader& mock_reader,
               size_t size,
@@ -70,6 +71,24 @@ void expect_stereo(const Frame& frame, sample_t left_value, sample_t right_value
     }
 }
 
+void expect_plane(const Frame& frame, size_t channel, sample_t value) {
+    CHECK(frame.is_planar());
+
+    const size_t plane_size = frame.num_raw_samples() / frame.num_planes();
+    CHECK(plane_size > 0);
+
+    for (size_t n = 0; n < plane_size; n++) {
+        DOUBLES_EQUAL((double)value, (double)frame.plane(channel)[n], Epsilon);
+    }
+}
+
+SampleSpec planar_spec(ChannelMask mask) {
+    SampleSpec spec(MaxSz, Sample_RawFormat, ChanLayout_Surround, ChanOrder_Smpte,
+                    mask);
+    spec.set_sample_layout(SampleLayout_Planar);
+    return spec;
+}
+
 } // namespace
 
 TEST_GROUP(channel_mapper_reader) {};
@@ -266,5 +285,79 @@ TEST(channel_mapper_reader, large_frame_nocts) {
     expect_mono(frame, 0.3f);
 }
 
+TEST(channel_mapper_reader, planar_upmix) {
+    enum { PlaneSz = 600, FirstReadSz = 480 };
+
+    const SampleSpec in_spec = planar_spec(ChanMask_Surround_Mono);
+    const SampleSpec out_spec = planar_spec(ChanMask_Surround_Stereo);
+
+    CHECK_EQUAL(FirstReadSz, frame_factory.planar_buffer_size(1));
+
+    const core::nanoseconds_t start_ts = 1000000;
+
+    test::MockReader mock_reader;
+    ChannelMapperReader mapper_reader(mock_reader, frame_factory, in_spec, out_spec);
+    CHECK(mapper_reader.is_valid());
+
+    const unsigned flags1 = Frame::FlagNotComplete;
+    const unsigned flags2 = Frame::FlagPacketDrops;
+
+    mock_reader.enable_timestamps(start_ts, in_spec);
+    add_mono(mock_reader, FirstReadSz, 0.3f, flags1);
+    add_mono(mock_reader, PlaneSz - FirstReadSz, 0.3f, flags2);
+
+    core::Slice<sample_t> buf = large_frame_factory.new_planar_buffer();
+    CHECK(buf);
+    Frame frame(buf.data(), PlaneSz * 2, 2);
+
+    CHECK(mapper_reader.read(frame));
+
+    CHECK_EQUAL(2, mock_reader.total_reads());
+    CHECK_EQUAL(0, mock_reader.num_unread());
+
+    CHECK_EQUAL(flags1 | flags2, frame.flags());
+    CHECK_EQUAL(start_ts, frame.capture_timestamp());
+    CHECK_EQUAL(PlaneSz, frame.duration());
+
+    expect_plane(frame, 0, 0.3f);
+    expect_plane(frame, 1, 0.3f);
+}
+
+TEST(channel_mapper_reader, planar_downmix) {
+    enum { PlaneSz = 480, ReadSz = 240 };
+
+    const SampleSpec in_spec = planar_spec(ChanMask_Surround_Stereo);
+    const SampleSpec out_spec = planar_spec(ChanMask_Surround_Mono);
+
+    CHECK_EQUAL(ReadSz, frame_factory.planar_buffer_size(2));
+
+    const core::nanoseconds_t start_ts = 1000000;
+
+    test::MockReader mock_reader;
+    ChannelMapperReader mapper_reader(mock_reader, frame_factory, in_spec, out_spec);
+    CHECK(mapper_reader.is_valid());
+
+    const unsigned flags1 = Frame::FlagNotComplete;
+    const unsigned flags2 = Frame::FlagPacketDrops;
+
+    mock_reader.enable_timestamps(start_ts, in_spec);
+    add_stereo(mock_reader, ReadSz * 2, 0.2f, 0.4f, flags1);
+    add_stereo(mock_reader, ReadSz * 2, 0.2f, 0.4f, flags2);
+
+    core::Slice<sample_t> buf = large_frame_factory.new_planar_buffer();
+    CHECK(buf);
+    Frame frame(buf.data(), PlaneSz, 1);
+
+    CHECK(mapper_reader.read(frame));
+
+    CHECK_EQUAL(2, mock_reader.total_reads());
+    CHECK_EQUAL(0, mock_reader.num_unread());
+
+    CHECK_EQUAL(flags1 | flags2, frame.flags());
+    CHECK_EQUAL(start_ts, frame.capture_timestamp());
+
+    expect_plane(frame, 0, 0.3f);
+}
+
 } // namespace audio
 } // namespace roc
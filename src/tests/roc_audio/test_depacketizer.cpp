@@ -172,6 +172,39 @@ private:
     status::StatusCode code_;
 };
 
+class TestPlc : public IPlc {
+public:
+    explicit TestPlc(sample_t value)
+        : value_(value)
+        , history_samples_(0)
+        , loss_samples_(0) {
+    }
+
+    virtual void process_history(sample_t*, size_t n_samples) {
+        history_samples_ += n_samples;
+    }
+
+    virtual void process_loss(sample_t* samples, size_t n_samples) {
+        for (size_t n = 0; n < n_samples * NumCh; n++) {
+            samples[n] = value_;
+        }
+        loss_samples_ += n_samples;
+    }
+
+    size_t history_samples() const {
+        return history_samples_;
+    }
+
+    size_t loss_samples() const {
+        return loss_samples_;
+    }
+
+private:
+    const sample_t value_;
+    size_t history_samples_;
+    size_t loss_samples_;
+};
+
 } // namespace
 
 TEST_GROUP(depacketizer) {};
@@ -181,7 +214,7 @@ TEST(depacketizer, one_packet_one_read) {
     PcmDecoder decoder(packet_spec);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, frame_spec, false);
+    Depacketizer dp(queue, decoder, frame_spec, NULL);
     CHECK(dp.is_valid());
 
     LONGS_EQUAL(status::StatusOK, queue.write(new_packet(encoder, 0, 0.11f, Now)));
@@ -194,7 +227,7 @@ TEST(depacketizer, one_packet_multiple_reads) {
     PcmDecoder decoder(packet_spec);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, frame_spec, false);
+    Depacketizer dp(queue, decoder, frame_spec, NULL);
     CHECK(dp.is_valid());
 
     LONGS_EQUAL(status::StatusOK, queue.write(new_packet(encoder, 0, 0.11f, Now)));
@@ -213,7 +246,7 @@ TEST(depacketizer, multiple_packets_one_read) {
     PcmDecoder decoder(packet_spec);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, frame_spec, false);
+    Depacketizer dp(queue, decoder, frame_spec, NULL);
     CHECK(dp.is_valid());
 
     core::nanoseconds_t ts = Now;
@@ -235,7 +268,7 @@ TEST(depacketizer, multiple_packets_multiple_reads) {
     PcmDecoder decoder(packet_spec);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, frame_spec, false);
+    Depacketizer dp(queue, decoder, frame_spec, NULL);
     CHECK(dp.is_valid());
 
     // Start with a packet with zero capture timestamp.
@@ -277,7 +310,7 @@ TEST(depacketizer, timestamp_overflow) {
     PcmDecoder decoder(packet_spec);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, frame_spec, false);
+    Depacketizer dp(queue, decoder, frame_spec, NULL);
     CHECK(dp.is_valid());
 
     const packet::stream_timestamp_t ts2 = 0;
@@ -304,7 +337,7 @@ TEST(depacketizer, drop_late_packets) {
     PcmDecoder decoder(packet_spec);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, frame_spec, false);
+    Depacketizer dp(queue, decoder, frame_spec, NULL);
     CHECK(dp.is_valid());
 
     const packet::stream_timestamp_t ts1 = SamplesPerPacket * 2;
@@ -320,6 +353,9 @@ TEST(depacketizer, drop_late_packets) {
 
     expect_output(dp, SamplesPerPacket, 0.11f, capt_ts1);
     expect_output(dp, SamplesPerPacket, 0.33f, capt_ts3);
+
+    CHECK_EQUAL(1, dp.metrics().late_packets);
+    CHECK_EQUAL(0, dp.metrics().missing_samples);
 }
 
 TEST(depacketizer, drop_late_packets_timestamp_overflow) {
@@ -327,7 +363,7 @@ TEST(depacketizer, drop_late_packets_timestamp_overflow) {
     PcmDecoder decoder(packet_spec);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, frame_spec, false);
+    Depacketizer dp(queue, decoder, frame_spec, NULL);
     CHECK(dp.is_valid());
 
     const packet::stream_timestamp_t ts1 = 0;
@@ -350,7 +386,7 @@ TEST(depacketizer, zeros_no_packets) {
     PcmDecoder decoder(packet_spec);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, frame_spec, false);
+    Depacketizer dp(queue, decoder, frame_spec, NULL);
     CHECK(dp.is_valid());
 
     expect_output(dp, SamplesPerPacket, 0.00f, 0);
@@ -361,7 +397,7 @@ TEST(depacketizer, zeros_no_next_packet) {
     PcmDecoder decoder(packet_spec);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, frame_spec, false);
+    Depacketizer dp(queue, decoder, frame_spec, NULL);
     CHECK(dp.is_valid());
 
     LONGS_EQUAL(status::StatusOK, queue.write(new_packet(encoder, 0, 0.11f, 0)));
@@ -375,7 +411,7 @@ TEST(depacketizer, zeros_between_packets) {
     PcmDecoder decoder(packet_spec);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, frame_spec, false);
+    Depacketizer dp(queue, decoder, frame_spec, NULL);
     CHECK(dp.is_valid());
 
     const core::nanoseconds_t capt_ts1 = Now;
@@ -389,6 +425,9 @@ TEST(depacketizer, zeros_between_packets) {
     expect_output(dp, SamplesPerPacket, 0.11f, Now);
     expect_output(dp, SamplesPerPacket, 0.00f, Now + NsPerPacket);
     expect_output(dp, SamplesPerPacket, 0.33f, Now + 2 * NsPerPacket);
+
+    CHECK_EQUAL(0, dp.metrics().late_packets);
+    CHECK_EQUAL(SamplesPerPacket, dp.metrics().missing_samples);
 }
 
 TEST(depacketizer, zeros_between_packets_timestamp_overflow) {
@@ -396,7 +435,7 @@ TEST(depacketizer, zeros_between_packets_timestamp_overflow) {
     PcmDecoder decoder(packet_spec);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, frame_spec, false);
+    Depacketizer dp(queue, decoder, frame_spec, NULL);
     CHECK(dp.is_valid());
 
     const packet::stream_timestamp_t ts2 = 0;
@@ -421,7 +460,7 @@ TEST(depacketizer, zeros_after_packet) {
     CHECK(SamplesPerPacket % 2 == 0);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, frame_spec, false);
+    Depacketizer dp(queue, decoder, frame_spec, NULL);
     CHECK(dp.is_valid());
 
     LONGS_EQUAL(status::StatusOK, queue.write(new_packet(encoder, 0, 0.11f, Now)));
@@ -448,7 +487,7 @@ TEST(depacketizer, packet_after_zeros) {
     PcmDecoder decoder(packet_spec);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, frame_spec, false);
+    Depacketizer dp(queue, decoder, frame_spec, NULL);
     CHECK(dp.is_valid());
 
     expect_output(dp, SamplesPerPacket, 0.00f, 0);
@@ -465,7 +504,7 @@ TEST(depacketizer, overlapping_packets) {
     PcmDecoder decoder(packet_spec);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, frame_spec, false);
+    Depacketizer dp(queue, decoder, frame_spec, NULL);
     CHECK(dp.is_valid());
 
     const packet::stream_timestamp_t ts1 = 0;
@@ -554,7 +593,7 @@ TEST(depacketizer, frame_flags_incompltete_blank) {
 
     for (size_t n = 0; n < ROC_ARRAY_SIZE(packets); n++) {
         PcmDecoder decoder(packet_spec);
-        Depacketizer dp(queue, decoder, frame_spec, false);
+        Depacketizer dp(queue, decoder, frame_spec, NULL);
         CHECK(dp.is_valid());
 
         for (size_t p = 0; p < PacketsPerFrame; p++) {
@@ -572,7 +611,7 @@ TEST(depacketizer, frame_flags_drops) {
     PcmDecoder decoder(packet_spec);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, frame_spec, false);
+    Depacketizer dp(queue, decoder, frame_spec, NULL);
     CHECK(dp.is_valid());
 
     packet::PacketPtr packets[] = {
@@ -616,7 +655,7 @@ TEST(depacketizer, timestamp) {
     PcmDecoder decoder(packet_spec);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, frame_spec, false);
+    Depacketizer dp(queue, decoder, frame_spec, NULL);
     CHECK(dp.is_valid());
 
     core::nanoseconds_t capt_ts = 0;
@@ -672,7 +711,7 @@ TEST(depacketizer, timestamp_fract_frame_per_packet) {
     PcmDecoder decoder(packet_spec);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, frame_spec, false);
+    Depacketizer dp(queue, decoder, frame_spec, NULL);
     CHECK(dp.is_valid());
 
     core::nanoseconds_t capt_ts = Now + frame_spec.samples_overall_2_ns(SamplesPerPacket);
@@ -696,7 +735,7 @@ TEST(depacketizer, timestamp_small_non_zero_cts) {
     PcmDecoder decoder(packet_spec);
 
     packet::Queue queue;
-    Depacketizer dp(queue, decoder, frame_spec, false);
+    Depacketizer dp(queue, decoder, frame_spec, NULL);
     CHECK(dp.is_valid());
 
     // 1st packet in frame has 0 capture ts
@@ -747,7 +786,7 @@ TEST(depacketizer, read_after_error) {
 
         packet::Queue queue;
         TestReader reader(queue);
-        Depacketizer dp(reader, decoder, frame_spec, false);
+        Depacketizer dp(reader, decoder, frame_spec, NULL);
         CHECK(dp.is_valid());
 
         LONGS_EQUAL(status::StatusOK, queue.write(new_packet(encoder, 0, 0.11f, Now)));
@@ -766,5 +805,72 @@ TEST(depacketizer, read_after_error) {
     }
 }
 
+// Samples are decoded directly into integer format, without conversion
+// to raw samples; missing packets are filled with integer zeros.
+TEST(depacketizer, integer_format) {
+    const SampleSpec integer_spec(SampleRate, PcmFormat_SInt16, ChanLayout_Surround,
+                                  ChanOrder_Smpte, ChMask);
+
+    PcmEncoder encoder(packet_spec);
+    PcmDecoder decoder(packet_spec);
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, integer_spec, NULL);
+    CHECK(dp.is_valid());
+
+    LONGS_EQUAL(status::StatusOK,
+                queue.write(new_packet(encoder, 0, 0.25f, Now)));
+    LONGS_EQUAL(status::StatusOK,
+                queue.write(new_packet(encoder, 2 * SamplesPerPacket, -0.5f,
+                                       Now + NsPerPacket * 2)));
+
+    const int16_t expected[] = { 8192, 0, -16384 };
+
+    core::Slice<uint8_t> buf = frame_factory.new_byte_buffer();
+    CHECK(buf);
+
+    for (size_t np = 0; np < ROC_ARRAY_SIZE(expected); np++) {
+        Frame frame(buf.data(), SamplesSize * sizeof(int16_t));
+        CHECK(dp.read(frame));
+
+        CHECK(frame.flags() & Frame::FlagNotRaw);
+        UNSIGNED_LONGS_EQUAL(SamplesPerPacket, frame.duration());
+
+        const int16_t* samples = (const int16_t*)frame.bytes();
+        for (size_t n = 0; n < SamplesSize; n++) {
+            LONGS_EQUAL(expected[np], samples[n]);
+        }
+    }
+}
+
+TEST(depacketizer, plc_between_packets) {
+    PcmEncoder encoder(packet_spec);
+    PcmDecoder decoder(packet_spec);
+
+    TestPlc plc(0.77f);
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, frame_spec, &plc);
+    CHECK(dp.is_valid());
+
+    LONGS_EQUAL(status::StatusOK,
+                queue.write(new_packet(encoder, 1 * SamplesPerPacket, 0.11f, Now)));
+    LONGS_EQUAL(status::StatusOK,
+                queue.write(new_packet(encoder, 3 * SamplesPerPacket, 0.33f,
+                                       Now + NsPerPacket * 2)));
+
+    expect_output(dp, SamplesPerPacket, 0.11f, Now);
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket, plc.history_samples());
+    UNSIGNED_LONGS_EQUAL(0, plc.loss_samples());
+
+    expect_output(dp, SamplesPerPacket, 0.77f, Now + NsPerPacket);
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket, plc.history_samples());
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket, plc.loss_samples());
+
+    expect_output(dp, SamplesPerPacket, 0.33f, Now + 2 * NsPerPacket);
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket * 2, plc.history_samples());
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket, plc.loss_samples());
+}
+
 } // namespace audio
 } // namespace roc
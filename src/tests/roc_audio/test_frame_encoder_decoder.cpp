@@ -9,6 +9,8 @@
 #include <CppUTest/TestHarness.h>
 
 #include "roc_audio/frame_factory.h"
+#include "roc_audio/lossless_decoder.h"
+#include "roc_audio/lossless_encoder.h"
 #include "roc_audio/pcm_decoder.h"
 #include "roc_audio/pcm_encoder.h"
 #include "roc_audio/pcm_format.h"
@@ -25,6 +27,8 @@ enum {
     Codec_PCM_SInt16_2ch,
     Codec_PCM_SInt24_1ch,
     Codec_PCM_SInt24_2ch,
+    Codec_Lossless_1ch,
+    Codec_Lossless_2ch,
 
     NumCodecs
 };
@@ -34,6 +38,8 @@ const ChannelMask Codec_channels[NumCodecs] = {
     ChanMask_Surround_Stereo,
     ChanMask_Surround_Mono,
     ChanMask_Surround_Stereo,
+    ChanMask_Surround_Mono,
+    ChanMask_Surround_Stereo,
 };
 
 enum { SampleRate = 44100, MaxChans = 8, MaxBufSize = 2000 };
@@ -43,6 +49,16 @@ const double Epsilon = 0.00001;
 core::HeapArena arena;
 FrameFactory frame_factory(arena, MaxBufSize);
 
+SampleSpec lossless_spec(ChannelMask ch_mask) {
+    SampleSpec sample_spec;
+    sample_spec.set_sample_rate(SampleRate);
+    sample_spec.set_sample_format(SampleFormat_Lossless);
+    sample_spec.channel_set().set_layout(ChanLayout_Surround);
+    sample_spec.channel_set().set_order(ChanOrder_Smpte);
+    sample_spec.channel_set().set_mask(ch_mask);
+    return sample_spec;
+}
+
 sample_t nth_sample(uint8_t n) {
     return sample_t(n) / sample_t(1 << 8);
 }
@@ -69,6 +85,14 @@ IFrameEncoder* new_encoder(size_t id) {
             PcmEncoder(SampleSpec(SampleRate, PcmFormat_SInt24_Be, ChanLayout_Surround,
                                   ChanOrder_Smpte, ChanMask_Surround_Stereo));
 
+    case Codec_Lossless_1ch:
+        return new (arena)
+            LosslessEncoder(lossless_spec(ChanMask_Surround_Mono), arena);
+
+    case Codec_Lossless_2ch:
+        return new (arena)
+            LosslessEncoder(lossless_spec(ChanMask_Surround_Stereo), arena);
+
     default:
         FAIL("bad codec id");
     }
@@ -98,6 +122,14 @@ IFrameDecoder* new_decoder(size_t id) {
             PcmDecoder(SampleSpec(SampleRate, PcmFormat_SInt24_Be, ChanLayout_Surround,
                                   ChanOrder_Smpte, ChanMask_Surround_Stereo));
 
+    case Codec_Lossless_1ch:
+        return new (arena)
+            LosslessDecoder(lossless_spec(ChanMask_Surround_Mono), arena);
+
+    case Codec_Lossless_2ch:
+        return new (arena)
+            LosslessDecoder(lossless_spec(ChanMask_Surround_Stereo), arena);
+
     default:
         FAIL("bad codec id");
     }
@@ -69,5 +69,17 @@ TEST(freq_estimator, small_queue_size) {
     }
 }
 
+TEST(freq_estimator, update_target_latency) {
+    for (size_t p = 0; p < ROC_ARRAY_SIZE(Profiles); p++) {
+        FreqEstimator fe(Profiles[p], Target);
+
+        fe.update_target_latency(Target / 2);
+
+        do {
+            fe.update(Target);
+        } while (fe.freq_coeff() < 1.01f);
+    }
+}
+
 } // namespace audio
 } // namespace roc
@@ -37,8 +37,15 @@ public:
             return false;
         }
 
-        memcpy(frame.raw_samples(), samples_ + pos_,
-               frame.num_raw_samples() * sizeof(sample_t));
+        if (frame.is_planar()) {
+            // Samples are stored interleaved.
+            deinterleave_samples(samples_ + pos_, frame.plane(0), frame.plane_stride(),
+                                 frame.num_planes(),
+                                 frame.num_raw_samples() / frame.num_planes());
+        } else {
+            memcpy(frame.raw_samples(), samples_ + pos_,
+                   frame.num_raw_samples() * sizeof(sample_t));
+        }
 
         unsigned flags = 0;
         for (size_t n = pos_; n < pos_ + frame.num_raw_samples(); n++) {
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/integer_ops.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// Not a multiple of vector width, to cover both vector loop and scalar tail.
+enum { NumSamples = 37 };
+
+} // namespace
+
+TEST_GROUP(integer_ops) {};
+
+TEST(integer_ops, formats) {
+    CHECK(is_integer_format(PcmFormat_SInt16));
+    CHECK(is_integer_format(PcmFormat_SInt32));
+
+    CHECK(!is_integer_format(PcmFormat_SInt16_Be));
+    CHECK(!is_integer_format(PcmFormat_SInt24));
+    CHECK(!is_integer_format(PcmFormat_Float32));
+
+    UNSIGNED_LONGS_EQUAL(2, integer_sample_size(PcmFormat_SInt16));
+    UNSIGNED_LONGS_EQUAL(4, integer_sample_size(PcmFormat_SInt32));
+}
+
+TEST(integer_ops, mix_s16) {
+    int16_t out[NumSamples];
+    int16_t in[NumSamples];
+
+    for (size_t n = 0; n < NumSamples; n++) {
+        out[n] = (int16_t)(n * 500);
+        in[n] = (int16_t)(n % 2 == 0 ? 20000 : -20000);
+    }
+
+    mix_s16(out, in, NumSamples);
+
+    for (size_t n = 0; n < NumSamples; n++) {
+        const int32_t expected = std::max(
+            std::min((int32_t)(n * 500) + (n % 2 == 0 ? 20000 : -20000), 32767),
+            -32768);
+        LONGS_EQUAL(expected, out[n]);
+    }
+}
+
+TEST(integer_ops, mix_s32) {
+    int32_t out[NumSamples];
+    int32_t in[NumSamples];
+
+    for (size_t n = 0; n < NumSamples; n++) {
+        out[n] = (int32_t)(n % 2 == 0 ? INT32_MAX - 10 : INT32_MIN + 10);
+        in[n] = (int32_t)(n % 2 == 0 ? (int32_t)n : -(int32_t)n);
+    }
+
+    mix_s32(out, in, NumSamples);
+
+    for (size_t n = 0; n < NumSamples; n++) {
+        int64_t expected = n % 2 == 0 ? (int64_t)INT32_MAX - 10 + (int64_t)n
+                                      : (int64_t)INT32_MIN + 10 - (int64_t)n;
+        expected = std::min(expected, (int64_t)INT32_MAX);
+        expected = std::max(expected, (int64_t)INT32_MIN);
+
+        CHECK(expected == out[n]);
+    }
+}
+
+TEST(integer_ops, dot_s16) {
+    int16_t samples[NumSamples];
+    int16_t weights[NumSamples];
+
+    int64_t expected = 0;
+
+    for (size_t n = 0; n < NumSamples; n++) {
+        samples[n] = (int16_t)(n % 3 == 0 ? INT16_MIN : INT16_MAX - (int16_t)n);
+        weights[n] = (int16_t)(n % 2 == 0 ? INT16_MIN : INT16_MAX);
+
+        expected += (int64_t)samples[n] * (int64_t)weights[n];
+    }
+
+    CHECK(expected == dot_s16(samples, weights, NumSamples));
+    CHECK(0 == dot_s16(samples, weights, 0));
+}
+
+TEST(integer_ops, dot_s32) {
+    int32_t samples[NumSamples];
+    int32_t weights[NumSamples];
+
+    int64_t expected = 0;
+
+    for (size_t n = 0; n < NumSamples; n++) {
+        samples[n] = (int32_t)(n % 2 == 0 ? INT32_MAX - (int32_t)n : INT32_MIN);
+        weights[n] = (int32_t)(n % 3 == 0 ? -(1 << 20) : (1 << 20) - (int32_t)n);
+
+        expected += (int64_t)samples[n] * (int64_t)weights[n];
+    }
+
+    CHECK(expected == dot_s32(samples, weights, NumSamples));
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/latency_tuner.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { SampleRate = 48000, FrameSize = 480 };
+
+const core::nanoseconds_t FrameDuration = FrameSize * core::Second / SampleRate;
+
+const core::nanoseconds_t Target = 100 * core::Millisecond;
+const core::nanoseconds_t MinTarget = 20 * core::Millisecond;
+const core::nanoseconds_t MaxTarget = 200 * core::Millisecond;
+
+const SampleSpec sample_spec(SampleRate,
+                             Sample_RawFormat,
+                             ChanLayout_Surround,
+                             ChanOrder_Smpte,
+                             ChanMask_Surround_Stereo);
+
+LatencyConfig make_config(LatencyTunerProfile profile) {
+    LatencyConfig config;
+    config.tuner_backend = LatencyTunerBackend_Niq;
+    config.tuner_profile = profile;
+    config.target_latency = Target;
+    if (profile == LatencyTunerProfile_Adaptive) {
+        config.min_target_latency = MinTarget;
+        config.max_target_latency = MaxTarget;
+    }
+    config.deduce_defaults(200 * core::Millisecond, true);
+    return config;
+}
+
+// Feed tuner with given latency for given duration, return last scaling.
+float run_tuner_latency(LatencyTuner& tuner,
+                        core::nanoseconds_t duration,
+                        core::nanoseconds_t latency) {
+    LatencyMetrics latency_metrics;
+    latency_metrics.niq_latency = latency;
+
+    packet::LinkMetrics link_metrics;
+
+    float scaling = 0;
+
+    for (core::nanoseconds_t pos = 0; pos < duration; pos += FrameDuration) {
+        tuner.write_metrics(latency_metrics, link_metrics);
+        if (!tuner.update_stream()) {
+            return -1;
+        }
+        tuner.advance_stream(FrameSize);
+
+        const float new_scaling = tuner.fetch_scaling();
+        if (new_scaling > 0) {
+            scaling = new_scaling;
+        }
+    }
+
+    return scaling;
+}
+
+// Feed tuner with given jitter and losses for given duration.
+void run_tuner(LatencyTuner& tuner,
+               core::nanoseconds_t duration,
+               core::nanoseconds_t jitter,
+               int64_t lost_packets) {
+    LatencyMetrics latency_metrics;
+    latency_metrics.niq_latency = Target;
+
+    packet::LinkMetrics link_metrics;
+    link_metrics.jitter = jitter;
+    link_metrics.lost_packets = lost_packets;
+
+    for (core::nanoseconds_t pos = 0; pos < duration; pos += FrameDuration) {
+        tuner.write_metrics(latency_metrics, link_metrics);
+        CHECK(tuner.update_stream());
+        tuner.advance_stream(FrameSize);
+    }
+}
+
+} // namespace
+
+TEST_GROUP(latency_tuner) {};
+
+TEST(latency_tuner, deduce_adaptive_bounds) {
+    LatencyConfig config;
+    config.tuner_backend = LatencyTunerBackend_Niq;
+    config.tuner_profile = LatencyTunerProfile_Adaptive;
+    config.deduce_defaults(200 * core::Millisecond, true);
+
+    LONGS_EQUAL(200 * core::Millisecond, config.target_latency);
+    LONGS_EQUAL(20 * core::Millisecond, config.min_target_latency);
+    LONGS_EQUAL(400 * core::Millisecond, config.max_target_latency);
+}
+
+TEST(latency_tuner, invalid_adaptive_bounds) {
+    { // min above target
+        LatencyConfig config = make_config(LatencyTunerProfile_Adaptive);
+        config.min_target_latency = Target * 2;
+
+        LatencyTuner tuner(config, sample_spec);
+        CHECK(!tuner.is_valid());
+    }
+    { // max below target
+        LatencyConfig config = make_config(LatencyTunerProfile_Adaptive);
+        config.max_target_latency = Target / 2;
+
+        LatencyTuner tuner(config, sample_spec);
+        CHECK(!tuner.is_valid());
+    }
+}
+
+TEST(latency_tuner, fast_start) {
+    LatencyConfig config = make_config(LatencyTunerProfile_Responsive);
+    config.start_latency = MinTarget;
+    config.deduce_defaults(200 * core::Millisecond, true);
+
+    DOUBLES_EQUAL(0.01, (double)config.start_scaling, 0.0001);
+
+    LatencyTuner tuner(config, sample_spec);
+    CHECK(tuner.is_valid());
+
+    // latency is below target, playback is slowed down
+    DOUBLES_EQUAL(0.99, (double)run_tuner_latency(tuner, core::Second, MinTarget),
+                  0.0001);
+    DOUBLES_EQUAL(0.99,
+                  (double)run_tuner_latency(tuner, core::Second, Target - MinTarget),
+                  0.0001);
+
+    // latency reached target, fast start finished
+    DOUBLES_EQUAL(1.0, (double)run_tuner_latency(tuner, core::Second, Target), 0.0001);
+
+    // latency decreased, normal tuning continues
+    const float scaling = run_tuner_latency(tuner, core::Second, Target - MinTarget);
+    CHECK(scaling < 1.0f);
+    CHECK(scaling >= 0.995f);
+}
+
+TEST(latency_tuner, fast_start_below_min_latency) {
+    LatencyConfig config = make_config(LatencyTunerProfile_Responsive);
+    config.target_latency = 2 * core::Second;
+    config.latency_tolerance = core::Second;
+    config.start_latency = MinTarget;
+    config.deduce_defaults(200 * core::Millisecond, true);
+
+    LatencyTuner tuner(config, sample_spec);
+    CHECK(tuner.is_valid());
+
+    // latency is below min latency, but it's ok during fast start
+    CHECK(run_tuner_latency(tuner, core::Second, MinTarget) > 0);
+
+    // fast start finished
+    CHECK(run_tuner_latency(tuner, FrameDuration, 2 * core::Second) > 0);
+
+    // now latency is out of bounds
+    CHECK(run_tuner_latency(tuner, FrameDuration, MinTarget) < 0);
+}
+
+TEST(latency_tuner, invalid_fast_start) {
+    { // start above target
+        LatencyConfig config = make_config(LatencyTunerProfile_Responsive);
+        config.start_latency = Target * 2;
+        config.deduce_defaults(200 * core::Millisecond, true);
+
+        LatencyTuner tuner(config, sample_spec);
+        CHECK(!tuner.is_valid());
+    }
+    { // tuning disabled
+        LatencyConfig config = make_config(LatencyTunerProfile_Intact);
+        config.start_latency = MinTarget;
+        config.deduce_defaults(200 * core::Millisecond, true);
+
+        LatencyTuner tuner(config, sample_spec);
+        CHECK(!tuner.is_valid());
+    }
+}
+
+TEST(latency_tuner, constant_target) {
+    const LatencyTunerProfile profiles[] = { LatencyTunerProfile_Responsive,
+                                             LatencyTunerProfile_Gradual };
+
+    for (size_t p = 0; p < sizeof(profiles) / sizeof(profiles[0]); p++) {
+        LatencyTuner tuner(make_config(profiles[p]), sample_spec);
+        CHECK(tuner.is_valid());
+
+        run_tuner(tuner, core::Second, 50 * core::Millisecond, 100);
+        LONGS_EQUAL(Target, tuner.target_latency());
+
+        run_tuner(tuner, 30 * core::Second, core::Millisecond, 100);
+        LONGS_EQUAL(Target, tuner.target_latency());
+    }
+}
+
+TEST(latency_tuner, adaptive_grow_on_jitter) {
+    LatencyTuner tuner(make_config(LatencyTunerProfile_Adaptive), sample_spec);
+    CHECK(tuner.is_valid());
+
+    LONGS_EQUAL(Target, tuner.target_latency());
+
+    // jitter * 4 is above target, target jumps immediately
+    run_tuner(tuner, FrameDuration, 35 * core::Millisecond, 0);
+    LONGS_EQUAL(140 * core::Millisecond, tuner.target_latency());
+
+    // jitter * 4 is above max target, target is clamped
+    run_tuner(tuner, FrameDuration * 100, 80 * core::Millisecond, 0);
+    LONGS_EQUAL(MaxTarget, tuner.target_latency());
+}
+
+TEST(latency_tuner, adaptive_grow_on_loss_burst) {
+    LatencyTuner tuner(make_config(LatencyTunerProfile_Adaptive), sample_spec);
+    CHECK(tuner.is_valid());
+
+    // single loss is ignored
+    run_tuner(tuner, core::Second, core::Millisecond, 1);
+    LONGS_EQUAL(Target, tuner.target_latency());
+
+    // burst of losses increases target
+    run_tuner(tuner, FrameDuration * 100, core::Millisecond, 5);
+    LONGS_EQUAL(Target * 3 / 2, tuner.target_latency());
+
+    // another burst, target is clamped
+    run_tuner(tuner, FrameDuration * 100, core::Millisecond, 10);
+    LONGS_EQUAL(MaxTarget, tuner.target_latency());
+}
+
+TEST(latency_tuner, adaptive_shrink_slowly) {
+    LatencyTuner tuner(make_config(LatencyTunerProfile_Adaptive), sample_spec);
+    CHECK(tuner.is_valid());
+
+    run_tuner(tuner, FrameDuration, 45 * core::Millisecond, 0);
+    LONGS_EQUAL(180 * core::Millisecond, tuner.target_latency());
+
+    // jitter decreased, but target is held for a while
+    run_tuner(tuner, 5 * core::Second, core::Millisecond, 0);
+    LONGS_EQUAL(180 * core::Millisecond, tuner.target_latency());
+
+    // then target starts decreasing slowly
+    run_tuner(tuner, 10 * core::Second, core::Millisecond, 0);
+    CHECK(tuner.target_latency() < 180 * core::Millisecond);
+    CHECK(tuner.target_latency() > 100 * core::Millisecond);
+
+    // and finally reaches lower bound
+    run_tuner(tuner, 60 * core::Second, core::Millisecond, 0);
+    LONGS_EQUAL(MinTarget, tuner.target_latency());
+
+    // congestion again, target grows immediately
+    run_tuner(tuner, FrameDuration * 20, 10 * core::Millisecond, 0);
+    LONGS_EQUAL(40 * core::Millisecond, tuner.target_latency());
+}
+
+} // namespace audio
+} // namespace roc
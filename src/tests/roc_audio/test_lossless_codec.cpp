@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/lossless_decoder.h"
+#include "roc_audio/lossless_encoder.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/noncopyable.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { SampleRate = 48000, NumCh = 2, SamplesPerFrame = 480, MaxFrameSize = 10000 };
+
+const double Pi = 3.14159265358979323846;
+
+core::HeapArena arena;
+
+// Arena that fails allocations after given number of successful ones.
+class FailingArena : public core::IArena, public core::NonCopyable<> {
+public:
+    FailingArena()
+        : n_allowed_((size_t)-1) {
+    }
+
+    virtual void* allocate(size_t size) {
+        if (n_allowed_ == 0) {
+            return NULL;
+        }
+        n_allowed_--;
+        return arena_.allocate(size);
+    }
+
+    virtual void deallocate(void* ptr) {
+        arena_.deallocate(ptr);
+    }
+
+    virtual size_t compute_allocated_size(size_t size) const {
+        return arena_.compute_allocated_size(size);
+    }
+
+    virtual size_t allocated_size(void* ptr) const {
+        return arena_.allocated_size(ptr);
+    }
+
+    void set_allowed(size_t n_allowed) {
+        n_allowed_ = n_allowed;
+    }
+
+private:
+    core::HeapArena arena_;
+    size_t n_allowed_;
+};
+
+SampleSpec make_spec() {
+    SampleSpec sample_spec;
+    sample_spec.set_sample_rate(SampleRate);
+    sample_spec.set_sample_format(SampleFormat_Lossless);
+    sample_spec.channel_set().set_layout(ChanLayout_Surround);
+    sample_spec.channel_set().set_order(ChanOrder_Smpte);
+    sample_spec.channel_set().set_mask(ChanMask_Surround_Stereo);
+    return sample_spec;
+}
+
+// Round sample to given bit depth.
+sample_t quantize(double s, unsigned bits) {
+    const double scale = double(1 << (bits - 1));
+    double q = (double)(long)(s * scale + (s >= 0 ? 0.5 : -0.5));
+    if (q > scale - 1) {
+        q = scale - 1;
+    }
+    if (q < -scale) {
+        q = -scale;
+    }
+    return sample_t(q / scale);
+}
+
+// Two tones with different amplitude on two channels.
+void generate_tones(sample_t* samples, size_t offset, size_t n_samples, unsigned bits) {
+    for (size_t i = 0; i < n_samples; i++) {
+        const double t = double(offset + i) / SampleRate;
+        samples[i * NumCh] = quantize(0.5 * sin(2 * Pi * 440 * t)
+                                          + 0.2 * sin(2 * Pi * 1250 * t),
+                                      bits);
+        samples[i * NumCh + 1] = quantize(0.3 * sin(2 * Pi * 660 * t), bits);
+    }
+}
+
+void generate_noise(sample_t* samples, size_t n_samples, unsigned bits) {
+    for (size_t i = 0; i < n_samples * NumCh; i++) {
+        const int32_t max = (1 << (bits - 1)) - 1;
+        samples[i] =
+            sample_t(int32_t(core::fast_random_range(0, (uint32_t)max * 2)) - max)
+            / sample_t(1 << (bits - 1));
+    }
+}
+
+size_t encode(LosslessEncoder& encoder, uint8_t* frame, const sample_t* samples) {
+    const size_t frame_size = encoder.encoded_byte_count(SamplesPerFrame);
+    CHECK(frame_size <= MaxFrameSize);
+
+    encoder.begin(frame, frame_size);
+    UNSIGNED_LONGS_EQUAL(SamplesPerFrame, encoder.write(samples, SamplesPerFrame));
+
+    const size_t written = encoder.end();
+    CHECK(written > 0);
+    CHECK(written <= frame_size);
+
+    return written;
+}
+
+void decode_and_check(LosslessDecoder& decoder,
+                      const uint8_t* frame,
+                      size_t frame_size,
+                      const sample_t* expected) {
+    UNSIGNED_LONGS_EQUAL(SamplesPerFrame,
+                         decoder.decoded_sample_count(frame, frame_size));
+
+    decoder.begin(0, frame, frame_size);
+    UNSIGNED_LONGS_EQUAL(SamplesPerFrame, decoder.available());
+
+    sample_t actual[SamplesPerFrame * NumCh] = {};
+    UNSIGNED_LONGS_EQUAL(SamplesPerFrame, decoder.read(actual, SamplesPerFrame));
+
+    decoder.end();
+
+    for (size_t i = 0; i < SamplesPerFrame * NumCh; i++) {
+        // Bit-exact.
+        CHECK_EQUAL(expected[i], actual[i]);
+    }
+}
+
+} // namespace
+
+TEST_GROUP(lossless_codec) {};
+
+TEST(lossless_codec, tones_24bit) {
+    LosslessEncoder encoder(make_spec(), arena);
+    LosslessDecoder decoder(make_spec(), arena);
+
+    sample_t samples[SamplesPerFrame * NumCh];
+    uint8_t frame[MaxFrameSize];
+
+    for (size_t n = 0; n < 10; n++) {
+        generate_tones(samples, n * SamplesPerFrame, SamplesPerFrame, 24);
+
+        const size_t size = encode(encoder, frame, samples);
+        decode_and_check(decoder, frame, size, samples);
+
+        // Should be considerably smaller than 24-bit PCM.
+        CHECK(size < SamplesPerFrame * NumCh * 3 / 2);
+    }
+}
+
+TEST(lossless_codec, tones_16bit) {
+    LosslessEncoder encoder(make_spec(), arena);
+    LosslessDecoder decoder(make_spec(), arena);
+
+    sample_t samples[SamplesPerFrame * NumCh];
+    uint8_t frame[MaxFrameSize];
+
+    for (size_t n = 0; n < 10; n++) {
+        generate_tones(samples, n * SamplesPerFrame, SamplesPerFrame, 16);
+
+        const size_t size = encode(encoder, frame, samples);
+        decode_and_check(decoder, frame, size, samples);
+
+        // Unused low bits are not coded, so should be considerably
+        // smaller than 16-bit PCM as well.
+        CHECK(size < SamplesPerFrame * NumCh * 2 / 2);
+    }
+}
+
+TEST(lossless_codec, noise) {
+    LosslessEncoder encoder(make_spec(), arena);
+    LosslessDecoder decoder(make_spec(), arena);
+
+    sample_t samples[SamplesPerFrame * NumCh];
+    uint8_t frame[MaxFrameSize];
+
+    for (size_t n = 0; n < 10; n++) {
+        generate_noise(samples, SamplesPerFrame, 24);
+
+        // Noise can't be compressed, but size should not exceed maximum.
+        const size_t size = encode(encoder, frame, samples);
+        decode_and_check(decoder, frame, size, samples);
+
+        CHECK(size <= encoder.encoded_byte_count(SamplesPerFrame));
+    }
+}
+
+TEST(lossless_codec, silence) {
+    LosslessEncoder encoder(make_spec(), arena);
+    LosslessDecoder decoder(make_spec(), arena);
+
+    sample_t samples[SamplesPerFrame * NumCh] = {};
+    uint8_t frame[MaxFrameSize];
+
+    const size_t size = encode(encoder, frame, samples);
+    decode_and_check(decoder, frame, size, samples);
+
+    // Header + 4 bytes per channel.
+    UNSIGNED_LONGS_EQUAL(4 + NumCh * 4, size);
+}
+
+TEST(lossless_codec, clipping) {
+    LosslessEncoder encoder(make_spec(), arena);
+    LosslessDecoder decoder(make_spec(), arena);
+
+    sample_t samples[SamplesPerFrame * NumCh];
+    sample_t expected[SamplesPerFrame * NumCh];
+    uint8_t frame[MaxFrameSize];
+
+    for (size_t i = 0; i < SamplesPerFrame * NumCh; i++) {
+        samples[i] = (i % 2) ? sample_t(1.5) : sample_t(-1.5);
+        expected[i] = (i % 2) ? sample_t((1 << 23) - 1) / sample_t(1 << 23) : -1;
+    }
+
+    const size_t size = encode(encoder, frame, samples);
+    decode_and_check(decoder, frame, size, expected);
+}
+
+TEST(lossless_codec, independent_frames) {
+    LosslessEncoder encoder(make_spec(), arena);
+
+    sample_t samples1[SamplesPerFrame * NumCh];
+    sample_t samples2[SamplesPerFrame * NumCh];
+
+    uint8_t frame1[MaxFrameSize];
+    uint8_t frame2[MaxFrameSize];
+
+    generate_tones(samples1, 0, SamplesPerFrame, 24);
+    generate_tones(samples2, SamplesPerFrame, SamplesPerFrame, 24);
+
+    const size_t size1 = encode(encoder, frame1, samples1);
+    const size_t size2 = encode(encoder, frame2, samples2);
+
+    {
+        // Second frame decoded without first one.
+        LosslessDecoder decoder(make_spec(), arena);
+        decode_and_check(decoder, frame2, size2, samples2);
+    }
+    {
+        // Frames decoded in reverse order.
+        LosslessDecoder decoder(make_spec(), arena);
+        decode_and_check(decoder, frame2, size2, samples2);
+        decode_and_check(decoder, frame1, size1, samples1);
+    }
+}
+
+// If allocation fails in begin(), frame is empty, and next begin() retries
+// allocation of all buffers.
+TEST(lossless_codec, allocation_failure) {
+    FailingArena failing_arena;
+    LosslessEncoder encoder(make_spec(), failing_arena);
+    LosslessDecoder decoder(make_spec(), arena);
+
+    sample_t samples[SamplesPerFrame * NumCh];
+    uint8_t frame[MaxFrameSize];
+
+    generate_tones(samples, 0, SamplesPerFrame, 24);
+
+    const size_t frame_size = encoder.encoded_byte_count(SamplesPerFrame);
+
+    { // first buffer allocated, second one failed
+        failing_arena.set_allowed(1);
+
+        encoder.begin(frame, frame_size);
+        UNSIGNED_LONGS_EQUAL(0, encoder.write(samples, SamplesPerFrame));
+        encoder.end();
+    }
+    { // allocation succeeded
+        failing_arena.set_allowed((size_t)-1);
+
+        const size_t size = encode(encoder, frame, samples);
+        decode_and_check(decoder, frame, size, samples);
+    }
+}
+
+TEST(lossless_codec, malformed_frames) {
+    LosslessEncoder encoder(make_spec(), arena);
+    LosslessDecoder decoder(make_spec(), arena);
+
+    sample_t samples[SamplesPerFrame * NumCh];
+    uint8_t frame[MaxFrameSize];
+
+    generate_tones(samples, 0, SamplesPerFrame, 24);
+
+    const size_t size = encode(encoder, frame, samples);
+
+    { // too short for header
+        UNSIGNED_LONGS_EQUAL(0, decoder.decoded_sample_count(frame, 3));
+
+        decoder.begin(100, frame, 3);
+        UNSIGNED_LONGS_EQUAL(100, decoder.position());
+        UNSIGNED_LONGS_EQUAL(0, decoder.available());
+        decoder.end();
+    }
+    { // truncated
+        UNSIGNED_LONGS_EQUAL(SamplesPerFrame,
+                             decoder.decoded_sample_count(frame, size / 2));
+
+        decoder.begin(100, frame, size / 2);
+        UNSIGNED_LONGS_EQUAL(0, decoder.available());
+
+        sample_t actual[SamplesPerFrame * NumCh];
+        UNSIGNED_LONGS_EQUAL(0, decoder.read(actual, SamplesPerFrame));
+        decoder.end();
+    }
+    { // declared number of samples doesn't fit into frame
+        uint8_t bad_frame[MaxFrameSize];
+        memcpy(bad_frame, frame, size);
+        bad_frame[0] = 0xff;
+        bad_frame[1] = 0xff;
+
+        UNSIGNED_LONGS_EQUAL(0, decoder.decoded_sample_count(bad_frame, size));
+        UNSIGNED_LONGS_EQUAL(0, decoder.decoded_sample_count(bad_frame, 5));
+
+        decoder.begin(100, bad_frame, size);
+        UNSIGNED_LONGS_EQUAL(0, decoder.available());
+        decoder.end();
+    }
+    { // wrong number of channels
+        uint8_t bad_frame[MaxFrameSize];
+        memcpy(bad_frame, frame, size);
+        bad_frame[3] = 1;
+
+        UNSIGNED_LONGS_EQUAL(0, decoder.decoded_sample_count(bad_frame, size));
+
+        decoder.begin(100, bad_frame, size);
+        UNSIGNED_LONGS_EQUAL(0, decoder.available());
+        decoder.end();
+    }
+    { // garbage
+        uint8_t bad_frame[MaxFrameSize];
+        memcpy(bad_frame, frame, size);
+        for (size_t i = 4; i < size; i++) {
+            bad_frame[i] = (uint8_t)core::fast_random_range(0, 255);
+        }
+
+        decoder.begin(100, bad_frame, size);
+        CHECK(decoder.available() == 0 || decoder.available() == SamplesPerFrame);
+
+        sample_t actual[SamplesPerFrame * NumCh];
+        decoder.read(actual, SamplesPerFrame);
+        decoder.end();
+    }
+    { // still can decode valid frame
+        decode_and_check(decoder, frame, size, samples);
+    }
+}
+
+} // namespace audio
+} // namespace roc
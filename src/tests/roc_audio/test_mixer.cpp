@@ -11,7 +11,10 @@
 #include "test_helpers/mock_reader.h"
 
 #include "roc_audio/mixer.h"
+#include "roc_audio/pcm_mapper_reader.h"
 #include "roc_core/heap_arena.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/optional.h"
 #include "roc_core/stddefs.h"
 
 namespace roc {
@@ -58,12 +61,73 @@ void expect_output(Mixer& mixer,
     }
 }
 
+SampleSpec planar_stereo_spec() {
+    SampleSpec spec(SampleRate, Sample_RawFormat, ChanLayout_Surround, ChanOrder_Smpte,
+                    ChanMask_Surround_Stereo);
+    spec.set_sample_layout(SampleLayout_Planar);
+    return spec;
+}
+
+void add_stereo(test::MockReader& reader,
+                size_t plane_sz,
+                sample_t left_value,
+                sample_t right_value,
+                unsigned flags = 0) {
+    for (size_t n = 0; n < plane_sz; n++) {
+        reader.add_samples(1, left_value, flags);
+        reader.add_samples(1, right_value, flags);
+    }
+}
+
+void expect_planar_output(Mixer& mixer,
+                          size_t plane_sz,
+                          sample_t left_value,
+                          sample_t right_value,
+                          unsigned flags = 0) {
+    core::Slice<sample_t> buf = large_frame_factory.new_planar_buffer();
+    CHECK(buf);
+
+    Frame frame(buf.data(), plane_sz * 2, 2);
+    CHECK(mixer.read(frame));
+
+    for (size_t n = 0; n < plane_sz; n++) {
+        DOUBLES_EQUAL((double)left_value, (double)frame.plane(0)[n], 0.0001);
+        DOUBLES_EQUAL((double)right_value, (double)frame.plane(1)[n], 0.0001);
+    }
+
+    UNSIGNED_LONGS_EQUAL(flags, frame.flags());
+    UNSIGNED_LONGS_EQUAL(plane_sz, frame.duration());
+}
+
+SampleSpec integer_spec(PcmFormat format) {
+    return SampleSpec(SampleRate, format, ChanLayout_Surround, ChanOrder_Smpte,
+                      ChannelMask);
+}
+
+template <class T>
+void expect_integer_output(Mixer& mixer, size_t sz, T value, T delta, unsigned flags) {
+    core::Slice<uint8_t> buf = large_frame_factory.new_byte_buffer();
+    CHECK(buf);
+
+    Frame frame(buf.data(), sz * sizeof(T));
+    CHECK(mixer.read(frame));
+
+    const T* samples = (const T*)frame.bytes();
+
+    for (size_t n = 0; n < sz; n++) {
+        DOUBLES_EQUAL((double)value, (double)samples[n], (double)delta);
+    }
+
+    UNSIGNED_LONGS_EQUAL(flags | Frame::FlagNotRaw, frame.flags());
+    UNSIGNED_LONGS_EQUAL(sz, frame.duration());
+}
+
 } // namespace
 
 TEST_GROUP(mixer) {};
 
 TEST(mixer, no_readers) {
-    Mixer mixer(frame_factory, sample_spec, true);
+    Mixer mixer(frame_factory, arena, sample_spec, true, 1);
     CHECK(mixer.is_valid());
 
     expect_output(mixer, BufSz, 0);
@@ -72,7 +136,7 @@ TEST(mixer, no_readers) {
 TEST(mixer, one_reader) {
     test::MockReader reader;
 
-    Mixer mixer(frame_factory, sample_spec, true);
+    Mixer mixer(frame_factory, arena, sample_spec, true, 1);
     CHECK(mixer.is_valid());
 
     mixer.add_input(reader);
@@ -86,7 +150,7 @@ TEST(mixer, one_reader) {
 TEST(mixer, one_reader_large) {
     test::MockReader reader;
 
-    Mixer mixer(frame_factory, sample_spec, true);
+    Mixer mixer(frame_factory, arena, sample_spec, true, 1);
     CHECK(mixer.is_valid());
 
     mixer.add_input(reader);
@@ -97,11 +161,40 @@ TEST(mixer, one_reader_large) {
     CHECK(reader.num_unread() == 0);
 }
 
+TEST(mixer, one_reader_failed) {
+    test::MockReader reader(false);
+
+    Mixer mixer(frame_factory, arena, sample_spec, true, 1);
+    CHECK(mixer.is_valid());
+
+    mixer.add_input(reader);
+
+    core::Slice<sample_t> buf = new_buffer(BufSz);
+    for (size_t n = 0; n < BufSz; n++) {
+        buf.data()[n] = 0.99f;
+    }
+
+    Frame frame(buf.data(), buf.size());
+    frame.set_flags(Frame::FlagNotBlank);
+    frame.set_capture_timestamp(1000);
+
+    CHECK(mixer.read(frame));
+
+    for (size_t n = 0; n < BufSz; n++) {
+        DOUBLES_EQUAL(0.0, (double)frame.raw_samples()[n], 0.0001);
+    }
+    UNSIGNED_LONGS_EQUAL(0, frame.flags());
+    UNSIGNED_LONGS_EQUAL(BufSz, frame.duration());
+    LONGS_EQUAL(0, frame.capture_timestamp());
+
+    CHECK(reader.total_reads() == 1);
+}
+
 TEST(mixer, two_readers) {
     test::MockReader reader1;
     test::MockReader reader2;
 
-    Mixer mixer(frame_factory, sample_spec, true);
+    Mixer mixer(frame_factory, arena, sample_spec, true, 1);
     CHECK(mixer.is_valid());
 
     mixer.add_input(reader1);
@@ -120,7 +213,7 @@ TEST(mixer, remove_reader) {
     test::MockReader reader1;
     test::MockReader reader2;
 
-    Mixer mixer(frame_factory, sample_spec, true);
+    Mixer mixer(frame_factory, arena, sample_spec, true, 1);
     CHECK(mixer.is_valid());
 
     mixer.add_input(reader1);
@@ -150,7 +243,7 @@ TEST(mixer, clamp) {
     test::MockReader reader1;
     test::MockReader reader2;
 
-    Mixer mixer(frame_factory, sample_spec, true);
+    Mixer mixer(frame_factory, arena, sample_spec, true, 1);
     CHECK(mixer.is_valid());
 
     mixer.add_input(reader1);
@@ -181,7 +274,7 @@ TEST(mixer, flags) {
     test::MockReader reader1;
     test::MockReader reader2;
 
-    Mixer mixer(frame_factory, sample_spec, true);
+    Mixer mixer(frame_factory, arena, sample_spec, true, 1);
     CHECK(mixer.is_valid());
 
     mixer.add_input(reader1);
@@ -212,7 +305,7 @@ TEST(mixer, timestamps_one_reader) {
 
     test::MockReader reader;
 
-    Mixer mixer(frame_factory, sample_spec, true);
+    Mixer mixer(frame_factory, arena, sample_spec, true, 1);
     CHECK(mixer.is_valid());
 
     mixer.add_input(reader);
@@ -241,7 +334,7 @@ TEST(mixer, timestamps_two_readers) {
     test::MockReader reader1;
     test::MockReader reader2;
 
-    Mixer mixer(frame_factory, sample_spec, true);
+    Mixer mixer(frame_factory, arena, sample_spec, true, 1);
     CHECK(mixer.is_valid());
 
     mixer.add_input(reader1);
@@ -279,7 +372,7 @@ TEST(mixer, timestamps_partial) {
     test::MockReader reader2;
     test::MockReader reader3;
 
-    Mixer mixer(frame_factory, sample_spec, true);
+    Mixer mixer(frame_factory, arena, sample_spec, true, 1);
     CHECK(mixer.is_valid());
 
     mixer.add_input(reader1);
@@ -326,7 +419,7 @@ TEST(mixer, timestamps_no_overflow) {
     test::MockReader reader1;
     test::MockReader reader2;
 
-    Mixer mixer(frame_factory, sample_spec, true);
+    Mixer mixer(frame_factory, arena, sample_spec, true, 1);
     CHECK(mixer.is_valid());
 
     mixer.add_input(reader1);
@@ -362,7 +455,7 @@ TEST(mixer, timestamps_disabled) {
     test::MockReader reader1;
     test::MockReader reader2;
 
-    Mixer mixer(frame_factory, sample_spec, false);
+    Mixer mixer(frame_factory, arena, sample_spec, false, 1);
     CHECK(mixer.is_valid());
 
     reader1.enable_timestamps(start_ts, sample_spec);
@@ -383,5 +476,348 @@ TEST(mixer, timestamps_disabled) {
     CHECK(reader2.num_unread() == 0);
 }
 
+TEST(mixer, parallel_many_readers) {
+    enum { NumReaders = 10, NumThreads = 4 };
+
+    test::MockReader readers[NumReaders];
+
+    Mixer mixer(frame_factory, arena, sample_spec, true, NumThreads);
+    CHECK(mixer.is_valid());
+    UNSIGNED_LONGS_EQUAL(NumThreads, mixer.num_workers());
+
+    for (size_t n = 0; n < NumReaders; n++) {
+        mixer.add_input(readers[n]);
+    }
+
+    for (size_t i = 0; i < 3; i++) {
+        for (size_t n = 0; n < NumReaders; n++) {
+            readers[n].add_samples(BufSz, 0.01f * (n + 1));
+        }
+        // 0.01 + 0.02 + ... + 0.10
+        expect_output(mixer, BufSz, 0.55f);
+    }
+
+    // Larger than temporary buffer.
+    for (size_t n = 0; n < NumReaders; n++) {
+        readers[n].add_samples(MaxBufSz * 3, 0.02f);
+    }
+    expect_output(mixer, MaxBufSz * 3, 0.2f);
+
+    for (size_t n = 0; n < NumReaders; n++) {
+        CHECK(readers[n].num_unread() == 0);
+    }
+}
+
+TEST(mixer, parallel_fewer_readers_than_workers) {
+    enum { NumThreads = 8 };
+
+    test::MockReader reader1;
+    test::MockReader reader2;
+    test::MockReader reader3;
+
+    Mixer mixer(frame_factory, arena, sample_spec, true, NumThreads);
+    CHECK(mixer.is_valid());
+
+    mixer.add_input(reader1);
+    mixer.add_input(reader2);
+
+    reader1.add_samples(BufSz, 0.11f);
+    reader2.add_samples(BufSz, 0.22f);
+    expect_output(mixer, BufSz, 0.33f);
+
+    mixer.add_input(reader3);
+
+    reader1.add_samples(BufSz, 0.11f);
+    reader2.add_samples(BufSz, 0.22f);
+    reader3.add_samples(BufSz, 0.33f);
+    expect_output(mixer, BufSz, 0.66f);
+
+    mixer.remove_input(reader1);
+    mixer.remove_input(reader2);
+
+    reader3.add_samples(BufSz, 0.33f);
+    expect_output(mixer, BufSz, 0.33f);
+
+    CHECK(reader1.num_unread() == 0);
+    CHECK(reader2.num_unread() == 0);
+    CHECK(reader3.num_unread() == 0);
+}
+
+TEST(mixer, parallel_flags) {
+    enum { NumThreads = 3 };
+
+    test::MockReader reader1;
+    test::MockReader reader2;
+    test::MockReader reader3;
+
+    Mixer mixer(frame_factory, arena, sample_spec, true, NumThreads);
+    CHECK(mixer.is_valid());
+
+    mixer.add_input(reader1);
+    mixer.add_input(reader2);
+    mixer.add_input(reader3);
+
+    reader1.add_samples(BufSz, 0.1f, 0);
+    reader2.add_samples(BufSz, 0.1f, Frame::FlagNotBlank);
+    reader3.add_samples(BufSz, 0.1f, Frame::FlagPacketDrops);
+
+    expect_output(mixer, BufSz, 0.3f, Frame::FlagNotBlank | Frame::FlagPacketDrops);
+}
+
+TEST(mixer, parallel_timestamps) {
+    enum { NumThreads = 2 };
+
+    // BufSz samples per second
+    const SampleSpec sample_spec(BufSz, Sample_RawFormat, ChanLayout_Surround,
+                                 ChanOrder_Smpte, ChanMask_Surround_Mono);
+    const core::nanoseconds_t start_ts1 = 9000000000000000000ll;
+    const core::nanoseconds_t start_ts2 = 9100000000000000000ll;
+    const core::nanoseconds_t start_ts3 = 9200000000000000000ll;
+
+    test::MockReader reader1;
+    test::MockReader reader2;
+    test::MockReader reader3;
+    test::MockReader reader4;
+
+    Mixer mixer(frame_factory, arena, sample_spec, true, NumThreads);
+    CHECK(mixer.is_valid());
+
+    mixer.add_input(reader1);
+    mixer.add_input(reader2);
+    mixer.add_input(reader3);
+    mixer.add_input(reader4);
+
+    // reader1 and reader3 go to first worker, reader2 and reader4 go to second
+    // worker; reader4 does not have timestamps
+    reader1.enable_timestamps(start_ts1, sample_spec);
+    reader2.enable_timestamps(start_ts2, sample_spec);
+    reader3.enable_timestamps(start_ts3, sample_spec);
+
+    for (size_t i = 0; i < 3; i++) {
+        reader1.add_samples(BufSz, 0.1f);
+        reader2.add_samples(BufSz, 0.1f);
+        reader3.add_samples(BufSz, 0.1f);
+        reader4.add_samples(BufSz, 0.1f);
+
+        const core::nanoseconds_t offset = core::Second * (core::nanoseconds_t)i;
+
+        expect_output(mixer, BufSz, 0.4f, 0,
+                      (start_ts1 + offset) / 4 + (start_ts2 + offset) / 4
+                          + (start_ts3 + offset) / 4);
+    }
+}
+
+// Saturation is applied after adding every input in input order,
+// regardless of how inputs are divided between workers.
+TEST(mixer, parallel_clamp) {
+    enum { NumReaders = 4 };
+
+    const size_t num_threads[] = { 1, 2, 3, 4 };
+
+    for (size_t t = 0; t < ROC_ARRAY_SIZE(num_threads); t++) {
+        test::MockReader readers[NumReaders];
+
+        Mixer mixer(frame_factory, arena, sample_spec, true, num_threads[t]);
+        CHECK(mixer.is_valid());
+
+        for (size_t n = 0; n < NumReaders; n++) {
+            mixer.add_input(readers[n]);
+        }
+
+        // 0.8 + 0.8 is clamped to 1.0, then 1.0 - 0.8 - 0.8 = -0.6
+        readers[0].add_samples(BufSz, 0.8f);
+        readers[1].add_samples(BufSz, 0.8f);
+        readers[2].add_samples(BufSz, -0.8f);
+        readers[3].add_samples(BufSz, -0.8f);
+
+        expect_output(mixer, BufSz, -0.6f);
+
+        // -0.9 - 0.3 is clamped to -1.0, then -1.0 + 0.9 + 0.3 = 0.2
+        readers[0].add_samples(BufSz, -0.9f);
+        readers[1].add_samples(BufSz, -0.3f);
+        readers[2].add_samples(BufSz, 0.9f);
+        readers[3].add_samples(BufSz, 0.3f);
+
+        expect_output(mixer, BufSz, 0.2f);
+
+        for (size_t n = 0; n < NumReaders; n++) {
+            CHECK(readers[n].num_unread() == 0);
+        }
+    }
+}
+
+TEST(mixer, planar_one_reader) {
+    test::MockReader reader(false);
+
+    Mixer mixer(frame_factory, arena, planar_stereo_spec(), true, 1);
+    CHECK(mixer.is_valid());
+
+    mixer.add_input(reader);
+
+    add_stereo(reader, BufSz, 0.11f, 0.22f, Frame::FlagNotComplete);
+    expect_planar_output(mixer, BufSz, 0.11f, 0.22f, Frame::FlagNotComplete);
+
+    // Failed reader produces zeros.
+    expect_planar_output(mixer, BufSz, 0.0f, 0.0f);
+
+    CHECK(reader.num_unread() == 0);
+}
+
+TEST(mixer, planar_two_readers) {
+    test::MockReader reader1;
+    test::MockReader reader2;
+
+    Mixer mixer(frame_factory, arena, planar_stereo_spec(), true, 1);
+    CHECK(mixer.is_valid());
+
+    mixer.add_input(reader1);
+    mixer.add_input(reader2);
+
+    add_stereo(reader1, BufSz, 0.11f, 0.33f, Frame::FlagNotComplete);
+    add_stereo(reader2, BufSz, 0.22f, 0.44f, Frame::FlagPacketDrops);
+
+    expect_planar_output(mixer, BufSz, 0.33f, 0.77f,
+                         Frame::FlagNotComplete | Frame::FlagPacketDrops);
+
+    // Larger than temporary buffer.
+    add_stereo(reader1, MaxBufSz * 2, 0.8f, -0.1f);
+    add_stereo(reader2, MaxBufSz * 2, 0.8f, -0.2f);
+
+    expect_planar_output(mixer, MaxBufSz * 2, 1.0f, -0.3f);
+
+    CHECK(reader1.num_unread() == 0);
+    CHECK(reader2.num_unread() == 0);
+}
+
+TEST(mixer, planar_parallel) {
+    enum { NumReaders = 10, NumThreads = 4 };
+
+    test::MockReader readers[NumReaders];
+
+    Mixer mixer(frame_factory, arena, planar_stereo_spec(), true, NumThreads);
+    CHECK(mixer.is_valid());
+
+    for (size_t n = 0; n < NumReaders; n++) {
+        mixer.add_input(readers[n]);
+    }
+
+    for (size_t n = 0; n < NumReaders; n++) {
+        add_stereo(readers[n], MaxBufSz, 0.01f * (n + 1), -0.01f * (n + 1));
+    }
+
+    // 0.01 + 0.02 + ... + 0.10
+    expect_planar_output(mixer, MaxBufSz, 0.55f, -0.55f);
+
+    for (size_t n = 0; n < NumReaders; n++) {
+        CHECK(readers[n].num_unread() == 0);
+    }
+}
+
+TEST(mixer, integer_s16_two_readers) {
+    test::MockReader reader1;
+    test::MockReader reader2;
+
+    PcmMapperReader mapper1(reader1, frame_factory, sample_spec,
+                            integer_spec(PcmFormat_SInt16));
+    PcmMapperReader mapper2(reader2, frame_factory, sample_spec,
+                            integer_spec(PcmFormat_SInt16));
+    CHECK(mapper1.is_valid());
+    CHECK(mapper2.is_valid());
+
+    Mixer mixer(frame_factory, arena, integer_spec(PcmFormat_SInt16), true, 1);
+    CHECK(mixer.is_valid());
+
+    mixer.add_input(mapper1);
+    mixer.add_input(mapper2);
+
+    reader1.add_samples(BufSz, 0.25f, Frame::FlagNotComplete);
+    reader2.add_samples(BufSz, 0.125f, Frame::FlagPacketDrops);
+
+    expect_integer_output<int16_t>(mixer, BufSz, 12288, 2,
+                                   Frame::FlagNotComplete | Frame::FlagPacketDrops);
+
+    // Saturated, larger than temporary buffer.
+    reader1.add_samples(MaxBufSz * 2, 0.75f);
+    reader2.add_samples(MaxBufSz * 2, 0.75f);
+
+    expect_integer_output<int16_t>(mixer, MaxBufSz * 2, INT16_MAX, 0, 0);
+
+    reader1.add_samples(BufSz, -0.75f);
+    reader2.add_samples(BufSz, -0.75f);
+
+    expect_integer_output<int16_t>(mixer, BufSz, INT16_MIN, 0, 0);
+
+    CHECK(reader1.num_unread() == 0);
+    CHECK(reader2.num_unread() == 0);
+}
+
+TEST(mixer, integer_s32_two_readers) {
+    test::MockReader reader1;
+    test::MockReader reader2;
+
+    PcmMapperReader mapper1(reader1, frame_factory, sample_spec,
+                            integer_spec(PcmFormat_SInt32));
+    PcmMapperReader mapper2(reader2, frame_factory, sample_spec,
+                            integer_spec(PcmFormat_SInt32));
+    CHECK(mapper1.is_valid());
+    CHECK(mapper2.is_valid());
+
+    Mixer mixer(frame_factory, arena, integer_spec(PcmFormat_SInt32), true, 1);
+    CHECK(mixer.is_valid());
+
+    mixer.add_input(mapper1);
+    mixer.add_input(mapper2);
+
+    reader1.add_samples(BufSz, 0.25f);
+    reader2.add_samples(BufSz, -0.125f);
+
+    expect_integer_output<int32_t>(mixer, BufSz, 1 << 28, 1 << 8, 0);
+
+    reader1.add_samples(MaxBufSz * 2, 0.75f);
+    reader2.add_samples(MaxBufSz * 2, 0.75f);
+
+    expect_integer_output<int32_t>(mixer, MaxBufSz * 2, INT32_MAX, 0, 0);
+
+    CHECK(reader1.num_unread() == 0);
+    CHECK(reader2.num_unread() == 0);
+}
+
+// Same as parallel_clamp, but saturation is done by integer kernels.
+TEST(mixer, integer_parallel_clamp) {
+    enum { NumReaders = 4 };
+
+    const size_t num_threads[] = { 1, 2, 3, 4 };
+
+    for (size_t t = 0; t < ROC_ARRAY_SIZE(num_threads); t++) {
+        test::MockReader readers[NumReaders];
+        core::Optional<PcmMapperReader> mappers[NumReaders];
+
+        Mixer mixer(frame_factory, arena, integer_spec(PcmFormat_SInt16), true,
+                    num_threads[t]);
+        CHECK(mixer.is_valid());
+
+        for (size_t n = 0; n < NumReaders; n++) {
+            mappers[n].reset(new (mappers[n]) PcmMapperReader(
+                readers[n], frame_factory, sample_spec,
+                integer_spec(PcmFormat_SInt16)));
+            CHECK(mappers[n]->is_valid());
+
+            mixer.add_input(*mappers[n]);
+        }
+
+        // 0.75 + 0.75 is saturated, then 1.0 - 0.75 - 0.75 = -0.5
+        readers[0].add_samples(BufSz, 0.75f);
+        readers[1].add_samples(BufSz, 0.75f);
+        readers[2].add_samples(BufSz, -0.75f);
+        readers[3].add_samples(BufSz, -0.75f);
+
+        expect_integer_output<int16_t>(mixer, BufSz, -16384, 2, 0);
+
+        for (size_t n = 0; n < NumReaders; n++) {
+            CHECK(readers[n].num_unread() == 0);
+        }
+    }
+}
+
 } // namespace audio
 } // namespace roc
@@ -11,6 +11,8 @@
 #include "roc_audio/frame_factory.h"
 #include "roc_audio/iframe_decoder.h"
 #include "roc_audio/iframe_encoder.h"
+#include "roc_audio/lossless_decoder.h"
+#include "roc_audio/lossless_encoder.h"
 #include "roc_audio/packetizer.h"
 #include "roc_audio/pcm_decoder.h"
 #include "roc_audio/pcm_encoder.h"
@@ -322,6 +324,53 @@ TEST(packetizer, flush) {
     }
 }
 
+TEST(packetizer, variable_payload_size) {
+    enum { NumPackets = 10 };
+
+    SampleSpec lossless_spec = packet_spec;
+    lossless_spec.set_sample_format(SampleFormat_Lossless);
+    lossless_spec.set_pcm_format(PcmFormat_Invalid);
+
+    LosslessEncoder encoder(lossless_spec, arena);
+    LosslessDecoder decoder(lossless_spec, arena);
+
+    packet::Queue packetizer_queue;
+    packet::Queue packet_queue;
+
+    rtp::Identity identity;
+    rtp::Sequencer sequencer(identity, PayloadType);
+    Packetizer packetizer(packetizer_queue, rtp_composer, sequencer, encoder,
+                          packet_factory, PacketDuration, frame_spec);
+
+    FrameMaker frame_maker;
+    PacketChecker packet_checker(decoder);
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        frame_maker.write(packetizer, n == NumPackets - 1 ? SamplesPerPacket / 2
+                                                          : SamplesPerPacket);
+    }
+    packetizer.flush();
+
+    UNSIGNED_LONGS_EQUAL(NumPackets, packetizer_queue.size());
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        packet::PacketPtr pp;
+        LONGS_EQUAL(status::StatusOK, packetizer_queue.read(pp));
+        CHECK(pp);
+
+        // Packet is truncated to actual payload size, without padding.
+        CHECK(pp->rtp()->payload.size() < encoder.encoded_byte_count(SamplesPerPacket));
+        CHECK(!pp->rtp()->padding);
+        UNSIGNED_LONGS_EQUAL(pp->rtp()->header.size() + pp->rtp()->payload.size(),
+                             pp->buffer().size());
+
+        LONGS_EQUAL(status::StatusOK, packet_queue.write(pp));
+
+        packet_checker.read(packet_queue, n == NumPackets - 1 ? SamplesPerPacket / 2
+                                                              : SamplesPerPacket);
+    }
+}
+
 TEST(packetizer, timestamp_zero_cts) {
     enum {
         NumFrames = 10,
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/iresampler.h"
+#include "roc_audio/parallel_resampler_writer.h"
+#include "roc_audio/resampler_map.h"
+#include "roc_audio/resampler_writer.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/shared_ptr.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum {
+    InRate = 44100,
+    OutRate = 48000,
+    NumChans = 6,
+    FrameSize = 1000,
+    NumFrames = 20,
+    MaxBufSize = FrameSize * NumChans * 2,
+    MaxOutSize = FrameSize * NumFrames * NumChans * 2
+};
+
+const core::nanoseconds_t StartCts = 1000000000000;
+
+core::HeapArena arena;
+FrameFactory frame_factory(arena, MaxBufSize * sizeof(sample_t));
+SincTableMap sinc_table_map(arena);
+
+SampleSpec make_spec(size_t rate) {
+    ChannelSet chans;
+    chans.set_layout(ChanLayout_Multitrack);
+    chans.set_order(ChanOrder_None);
+    chans.set_count(NumChans);
+
+    return SampleSpec(rate, Sample_RawFormat, chans);
+}
+
+sample_t nth_sample(size_t frame, size_t pos) {
+    const size_t ch = pos % NumChans;
+    const size_t n = frame * FrameSize + pos / NumChans;
+    // every channel gets its own tone
+    return sample_t(((n * (ch + 1) * 7) % 200)) / 200.0f - 0.5f;
+}
+
+class CollectingWriter : public IFrameWriter, public core::NonCopyable<> {
+public:
+    CollectingWriter()
+        : size_(0)
+        , first_cts_(0) {
+    }
+
+    virtual void write(Frame& frame) {
+        CHECK(size_ + frame.num_raw_samples() <= MaxOutSize);
+        CHECK(frame.num_raw_samples() % NumChans == 0);
+
+        if (size_ == 0) {
+            first_cts_ = frame.capture_timestamp();
+        }
+
+        memcpy(samples_ + size_, frame.raw_samples(),
+               frame.num_raw_samples() * sizeof(sample_t));
+        size_ += frame.num_raw_samples();
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    sample_t sample(size_t n) const {
+        return samples_[n];
+    }
+
+    core::nanoseconds_t first_cts() const {
+        return first_cts_;
+    }
+
+private:
+    sample_t samples_[MaxOutSize];
+    size_t size_;
+    core::nanoseconds_t first_cts_;
+};
+
+void write_frames(IFrameWriter& writer) {
+    sample_t samples[FrameSize * NumChans];
+
+    for (size_t nf = 0; nf < NumFrames; nf++) {
+        for (size_t ns = 0; ns < FrameSize * NumChans; ns++) {
+            samples[ns] = nth_sample(nf, ns);
+        }
+
+        Frame frame(samples, FrameSize * NumChans);
+        frame.set_capture_timestamp(
+            StartCts + make_spec(InRate).samples_per_chan_2_ns(nf * FrameSize));
+
+        writer.write(frame);
+    }
+}
+
+} // namespace
+
+TEST_GROUP(parallel_resampler_writer) {};
+
+TEST(parallel_resampler_writer, num_lanes) {
+    const size_t num_threads[] = { 1, 2, 4, NumChans, NumChans * 2 };
+    const size_t num_lanes[] = { 1, 2, 4, NumChans, NumChans };
+
+    ResamplerConfig config;
+    config.backend = ResamplerBackend_Builtin;
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(num_threads); n++) {
+        CollectingWriter output;
+
+        ParallelResamplerWriter writer(output, arena, frame_factory, sinc_table_map,
+                                       config, make_spec(InRate), make_spec(OutRate),
+                                       num_threads[n]);
+        CHECK(writer.is_valid());
+
+        UNSIGNED_LONGS_EQUAL(num_lanes[n], writer.num_lanes());
+    }
+}
+
+// Parallel resampler should produce exactly same output as a single
+// resampler, since every lane keeps continuous state for its channels.
+TEST(parallel_resampler_writer, same_as_single) {
+    const size_t num_threads[] = { 1, 2, 3, 4, NumChans };
+
+    for (size_t n_backend = 0; n_backend < ResamplerMap::instance().num_backends();
+         n_backend++) {
+        ResamplerConfig config;
+        config.backend = ResamplerMap::instance().nth_backend(n_backend);
+        config.profile = ResamplerProfile_Medium;
+
+        CollectingWriter expected;
+
+        {
+            core::SharedPtr<IResampler> resampler =
+                ResamplerMap::instance().new_resampler(arena, frame_factory,
+                                                       sinc_table_map, config,
+                                                       make_spec(InRate),
+                                                       make_spec(OutRate));
+            CHECK(resampler);
+
+            ResamplerWriter writer(expected, *resampler, frame_factory,
+                                   make_spec(InRate), make_spec(OutRate));
+            CHECK(writer.is_valid());
+
+            write_frames(writer);
+        }
+
+        CHECK(expected.size() > FrameSize * NumChans);
+
+        for (size_t n = 0; n < ROC_ARRAY_SIZE(num_threads); n++) {
+            CollectingWriter actual;
+
+            {
+                ParallelResamplerWriter writer(actual, arena, frame_factory,
+                                               sinc_table_map, config,
+                                               make_spec(InRate), make_spec(OutRate),
+                                               num_threads[n]);
+                CHECK(writer.is_valid());
+
+                write_frames(writer);
+            }
+
+            // lanes may keep a few samples until next write
+            CHECK(actual.size() + NumChans * 4 >= expected.size());
+            CHECK(actual.size() <= expected.size());
+
+            for (size_t ns = 0; ns < actual.size(); ns++) {
+                DOUBLES_EQUAL(expected.sample(ns), actual.sample(ns), 1e-6);
+            }
+
+            CHECK(core::ns_equal_delta(expected.first_cts(), actual.first_cts(),
+                                       core::Millisecond));
+        }
+    }
+}
+
+} // namespace audio
+} // namespace roc
@@ -25,6 +25,7 @@ enum { Rate = 10000, MaxBytes = 400, SmallFrameSz = 20 };
 
 core::HeapArena arena;
 FrameFactory frame_factory(arena, MaxBytes);
+FrameFactory large_frame_factory(arena, MaxBytes * 10);
 
 template <class T> struct CountReader : IFrameReader {
     T value;
@@ -114,6 +115,44 @@ struct MetaReader : IFrameReader {
     }
 };
 
+// Fills planar frames, n-th sample of every channel is n * step,
+// negated for odd channels.
+struct PlanarReader : IFrameReader {
+    sample_t step;
+    size_t pos;
+
+    int n_calls;
+
+    PlanarReader(sample_t step)
+        : step(step)
+        , pos(0)
+        , n_calls(0) {
+    }
+
+    virtual bool read(Frame& frame) {
+        CHECK(frame.is_planar());
+        CHECK_EQUAL(0, (uintptr_t)frame.plane(0) % PlaneAlignment);
+
+        const size_t plane_size = frame.num_raw_samples() / frame.num_planes();
+
+        for (size_t ch = 0; ch < frame.num_planes(); ch++) {
+            for (size_t n = 0; n < plane_size; n++) {
+                frame.plane(ch)[n] = (pos + n) * step * (ch % 2 == 0 ? 1 : -1);
+            }
+        }
+
+        pos += plane_size;
+        n_calls++;
+        return true;
+    }
+};
+
+SampleSpec planar_spec(ChannelMask mask) {
+    SampleSpec spec(Rate, Sample_RawFormat, ChanLayout_Surround, ChanOrder_Smpte, mask);
+    spec.set_sample_layout(SampleLayout_Planar);
+    return spec;
+}
+
 } // namespace
 
 TEST_GROUP(pcm_mapper_reader) {};
@@ -457,5 +496,90 @@ TEST(pcm_mapper_reader, capture_timestamp) {
     }
 }
 
+TEST(pcm_mapper_reader, s16_to_planar) {
+    enum { PlaneSz = 60 };
+
+    const SampleSpec in_spec(Rate, PcmFormat_SInt16, ChanLayout_Surround, ChanOrder_Smpte,
+                             ChanMask_Surround_Stereo);
+    const SampleSpec out_spec = planar_spec(ChanMask_Surround_Stereo);
+
+    CountReader<int16_t> count_reader(100);
+    PcmMapperReader mapper_reader(count_reader, frame_factory, in_spec, out_spec);
+    CHECK(mapper_reader.is_valid());
+
+    core::Slice<sample_t> buf = large_frame_factory.new_planar_buffer();
+    CHECK(buf);
+    Frame frame(buf.data(), PlaneSz * 2, 2);
+
+    CHECK(mapper_reader.read(frame));
+
+    // Temporary buffer holds 50 samples per channel.
+    LONGS_EQUAL(2, count_reader.n_calls);
+    LONGS_EQUAL(PlaneSz * 2, count_reader.n_values);
+
+    UNSIGNED_LONGS_EQUAL(PlaneSz, frame.duration());
+    CHECK(frame.is_raw());
+
+    for (size_t i = 0; i < PlaneSz; i++) {
+        DOUBLES_EQUAL(i * 2 * 100 / 32768., frame.plane(0)[i], Epsilon);
+        DOUBLES_EQUAL((i * 2 + 1) * 100 / 32768., frame.plane(1)[i], Epsilon);
+    }
+}
+
+TEST(pcm_mapper_reader, planar_to_s16) {
+    enum { PlaneSz = 60 };
+
+    const SampleSpec in_spec = planar_spec(ChanMask_Surround_Stereo);
+    const SampleSpec out_spec(Rate, PcmFormat_SInt16, ChanLayout_Surround,
+                              ChanOrder_Smpte, ChanMask_Surround_Stereo);
+
+    PlanarReader planar_reader(0.001f);
+    PcmMapperReader mapper_reader(planar_reader, frame_factory, in_spec, out_spec);
+    CHECK(mapper_reader.is_valid());
+
+    int16_t samples[PlaneSz * 2] = {};
+    Frame frame((uint8_t*)samples, sizeof(samples));
+
+    CHECK(mapper_reader.read(frame));
+
+    // Planar buffer holds 32 samples per channel.
+    LONGS_EQUAL(2, planar_reader.n_calls);
+
+    UNSIGNED_LONGS_EQUAL(PlaneSz, frame.duration());
+    CHECK(!frame.is_raw());
+
+    for (size_t i = 0; i < PlaneSz; i++) {
+        DOUBLES_EQUAL(i * 0.001, samples[i * 2] / 32768., Epsilon);
+        DOUBLES_EQUAL(-(i * 0.001), samples[i * 2 + 1] / 32768., Epsilon);
+    }
+}
+
+TEST(pcm_mapper_reader, planar_to_raw) {
+    enum { PlaneSz = 60 };
+
+    const SampleSpec in_spec = planar_spec(ChanMask_Surround_Stereo);
+    const SampleSpec out_spec(Rate, Sample_RawFormat, ChanLayout_Surround,
+                              ChanOrder_Smpte, ChanMask_Surround_Stereo);
+
+    PlanarReader planar_reader(0.001f);
+    PcmMapperReader mapper_reader(planar_reader, frame_factory, in_spec, out_spec);
+    CHECK(mapper_reader.is_valid());
+
+    sample_t samples[PlaneSz * 2] = {};
+    Frame frame(samples, PlaneSz * 2);
+
+    CHECK(mapper_reader.read(frame));
+
+    LONGS_EQUAL(2, planar_reader.n_calls);
+
+    UNSIGNED_LONGS_EQUAL(PlaneSz, frame.duration());
+    CHECK(frame.is_raw());
+
+    for (size_t i = 0; i < PlaneSz; i++) {
+        DOUBLES_EQUAL(i * 0.001, samples[i * 2], Epsilon);
+        DOUBLES_EQUAL(-(i * 0.001), samples[i * 2 + 1], Epsilon);
+    }
+}
+
 } // namespace audio
 } // namespace roc
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/pitch_plc.h"
+#include "roc_core/heap_arena.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum {
+    SampleRate = 44100,
+    NumCh = 2,
+    ChMask = 0x3,
+    PacketSamples = 441,
+    MaxSamples = 20000
+};
+
+const double Pi = 3.14159265358979323846;
+
+// 200 Hz, period is exactly 220.5 samples.
+const double ToneFreq = 200;
+
+const SampleSpec sample_spec(
+    SampleRate, Sample_RawFormat, ChanLayout_Surround, ChanOrder_Smpte, ChMask);
+
+core::HeapArena arena;
+
+void generate_tone(sample_t* samples, size_t offset, size_t n_samples) {
+    for (size_t i = 0; i < n_samples; i++) {
+        const double t = double(offset + i) / SampleRate;
+        const sample_t s = sample_t(0.5 * sin(2 * Pi * ToneFreq * t));
+        for (size_t c = 0; c < NumCh; c++) {
+            samples[i * NumCh + c] = s;
+        }
+    }
+}
+
+double max_abs_diff(const sample_t* expected, const sample_t* actual, size_t n_samples) {
+    double result = 0;
+    for (size_t i = 0; i < n_samples * NumCh; i++) {
+        result = std::max(result, std::abs(double(expected[i] - actual[i])));
+    }
+    return result;
+}
+
+double max_abs(const sample_t* samples, size_t n_samples) {
+    double result = 0;
+    for (size_t i = 0; i < n_samples * NumCh; i++) {
+        result = std::max(result, std::abs(double(samples[i])));
+    }
+    return result;
+}
+
+// Feed given number of packets of tone to PLC.
+void feed_history(PitchPlc& plc, size_t n_packets) {
+    for (size_t n = 0; n < n_packets; n++) {
+        sample_t samples[PacketSamples * NumCh];
+        generate_tone(samples, n * PacketSamples, PacketSamples);
+        plc.process_history(samples, PacketSamples);
+    }
+}
+
+} // namespace
+
+TEST_GROUP(pitch_plc) {};
+
+TEST(pitch_plc, no_history) {
+    PitchPlc plc(sample_spec, arena);
+    CHECK(plc.is_valid());
+
+    sample_t samples[PacketSamples * NumCh];
+    for (size_t i = 0; i < PacketSamples * NumCh; i++) {
+        samples[i] = 1;
+    }
+
+    plc.process_loss(samples, PacketSamples);
+
+    DOUBLES_EQUAL(0, max_abs(samples, PacketSamples), 0);
+}
+
+TEST(pitch_plc, short_loss) {
+    enum { HistoryPackets = 5, LossSamples = 200 };
+
+    PitchPlc plc(sample_spec, arena);
+    CHECK(plc.is_valid());
+
+    feed_history(plc, HistoryPackets);
+
+    sample_t expected[LossSamples * NumCh];
+    generate_tone(expected, HistoryPackets * PacketSamples, LossSamples);
+
+    sample_t actual[LossSamples * NumCh];
+    plc.process_loss(actual, LossSamples);
+
+    // Loss is shorter than attenuation start, so synthesized signal should
+    // closely follow the original tone.
+    CHECK(max_abs_diff(expected, actual, LossSamples) < 0.05);
+}
+
+TEST(pitch_plc, loss_split_into_chunks) {
+    enum { HistoryPackets = 5, LossSamples = 400, Chunk = 37 };
+
+    PitchPlc plc1(sample_spec, arena);
+    PitchPlc plc2(sample_spec, arena);
+
+    feed_history(plc1, HistoryPackets);
+    feed_history(plc2, HistoryPackets);
+
+    sample_t expected[LossSamples * NumCh];
+    plc1.process_loss(expected, LossSamples);
+
+    sample_t actual[LossSamples * NumCh];
+    for (size_t pos = 0; pos < LossSamples;) {
+        const size_t n = std::min((size_t)Chunk, LossSamples - pos);
+        plc2.process_loss(actual + pos * NumCh, n);
+        pos += n;
+    }
+
+    MEMCMP_EQUAL(expected, actual, LossSamples * NumCh * sizeof(sample_t));
+}
+
+TEST(pitch_plc, long_loss) {
+    enum { HistoryPackets = 5, LossPackets = 10 };
+
+    PitchPlc plc(sample_spec, arena);
+    feed_history(plc, HistoryPackets);
+
+    sample_t samples[PacketSamples * NumCh];
+
+    // First packet is not attenuated yet.
+    plc.process_loss(samples, PacketSamples);
+    CHECK(max_abs(samples, PacketSamples) > 0.4);
+
+    // Signal fades out gradually.
+    double prev_level = max_abs(samples, PacketSamples);
+    for (size_t n = 1; n < LossPackets; n++) {
+        plc.process_loss(samples, PacketSamples);
+        const double level = max_abs(samples, PacketSamples);
+        CHECK(level <= prev_level);
+        prev_level = level;
+    }
+
+    // And eventually turns into silence.
+    DOUBLES_EQUAL(0, prev_level, 0);
+}
+
+TEST(pitch_plc, fade_before_loss) {
+    enum { HistoryPackets = 5, LossSamples = 100 };
+
+    PitchPlc plc(sample_spec, arena);
+    feed_history(plc, HistoryPackets - 1);
+
+    // Last packet has rising offset, so that beginning of the last period
+    // doesn't continue last samples of the packet.
+    sample_t samples[PacketSamples * NumCh];
+    generate_tone(samples, (HistoryPackets - 1) * PacketSamples, PacketSamples);
+    for (size_t i = 0; i < PacketSamples; i++) {
+        for (size_t c = 0; c < NumCh; c++) {
+            samples[i * NumCh + c] += sample_t(0.3 * i / 220);
+        }
+    }
+    plc.process_history(samples, PacketSamples);
+
+    sample_t lost[LossSamples * NumCh];
+    plc.process_loss(lost, LossSamples);
+
+    // Beginning of loss is overlap-added with decoded signal, so there is
+    // no jump between last real sample and first lost one, and no jumps
+    // during transition to synthesized signal. Loss is shorter than minimum
+    // period, so period boundary is not reached.
+    for (size_t c = 0; c < NumCh; c++) {
+        const double jump =
+            std::abs(double(lost[c] - samples[(PacketSamples - 1) * NumCh + c]));
+        CHECK(jump < 0.05);
+
+        for (size_t i = 1; i < LossSamples; i++) {
+            const double step =
+                std::abs(double(lost[i * NumCh + c] - lost[(i - 1) * NumCh + c]));
+            CHECK(step < 0.05);
+        }
+    }
+}
+
+TEST(pitch_plc, fade_after_loss) {
+    enum { HistoryPackets = 5, LossSamples = 300 };
+
+    PitchPlc plc(sample_spec, arena);
+    feed_history(plc, HistoryPackets);
+
+    sample_t lost[LossSamples * NumCh];
+    plc.process_loss(lost, LossSamples);
+
+    // Next packet has opposite phase, to make discontinuity audible.
+    sample_t samples[PacketSamples * NumCh];
+    generate_tone(samples, HistoryPackets * PacketSamples + LossSamples, PacketSamples);
+    for (size_t i = 0; i < PacketSamples * NumCh; i++) {
+        samples[i] = -samples[i];
+    }
+
+    sample_t original[PacketSamples * NumCh];
+    memcpy(original, samples, sizeof(samples));
+
+    plc.process_history(samples, PacketSamples);
+
+    // Beginning of packet is cross-faded with synthesized signal, so there
+    // is no jump between last lost sample and first real one.
+    for (size_t c = 0; c < NumCh; c++) {
+        const double jump = std::abs(
+            double(samples[c] - lost[(LossSamples - 1) * NumCh + c]));
+        const double orig_jump = std::abs(
+            double(original[c] - lost[(LossSamples - 1) * NumCh + c]));
+        CHECK(jump < orig_jump);
+        CHECK(jump < 0.05);
+    }
+
+    // Tail of packet is unchanged.
+    const size_t tail = PacketSamples / 2;
+    MEMCMP_EQUAL(original + tail * NumCh, samples + tail * NumCh,
+                 (PacketSamples - tail) * NumCh * sizeof(sample_t));
+}
+
+TEST(pitch_plc, history_unchanged_without_loss) {
+    enum { NumPackets = 5 };
+
+    PitchPlc plc(sample_spec, arena);
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        sample_t samples[PacketSamples * NumCh];
+        generate_tone(samples, n * PacketSamples, PacketSamples);
+
+        sample_t original[PacketSamples * NumCh];
+        memcpy(original, samples, sizeof(samples));
+
+        plc.process_history(samples, PacketSamples);
+
+        MEMCMP_EQUAL(original, samples, sizeof(samples));
+    }
+}
+
+} // namespace audio
+} // namespace roc
@@ -11,10 +11,13 @@
 #include "test_helpers/mock_reader.h"
 #include "test_helpers/mock_writer.h"
 
+#include "roc_audio/integer_ops.h"
 #include "roc_audio/iresampler.h"
+#include "roc_audio/pcm_mapper_reader.h"
 #include "roc_audio/resampler_map.h"
 #include "roc_audio/resampler_reader.h"
 #include "roc_audio/resampler_writer.h"
+#include "roc_audio/slip_resampler.h"
 #include "roc_core/heap_arena.h"
 #include "roc_core/log.h"
 #include "roc_core/scoped_ptr.h"
@@ -46,6 +49,7 @@ const float supported_scalings[] = { 0.99f, 0.999f, 1.000f, 1.001f, 1.01f };
 
 core::HeapArena arena;
 FrameFactory frame_factory(arena, MaxFrameSize * sizeof(sample_t));
+SincTableMap sinc_table_map(arena);
 
 void expect_capture_timestamp(core::nanoseconds_t expected,
                               core::nanoseconds_t actual,
@@ -220,6 +224,8 @@ double timestamp_allowance(ResamplerBackend backend) {
         return 5;
     case ResamplerBackend_SpeexDec:
         return 2;
+    case ResamplerBackend_Slip:
+        return 2;
     default:
         break;
     }
@@ -297,7 +303,8 @@ void resample(ResamplerBackend backend,
               const SampleSpec& sample_spec,
               float scaling) {
     core::SharedPtr<IResampler> resampler = ResamplerMap::instance().new_resampler(
-        arena, frame_factory, make_config(backend, profile), sample_spec, sample_spec);
+        arena, frame_factory, sinc_table_map, make_config(backend, profile), sample_spec,
+        sample_spec);
     CHECK(resampler);
     CHECK(resampler->is_valid());
 
@@ -337,7 +344,7 @@ TEST(resampler, supported_scalings) {
 
                         core::SharedPtr<IResampler> resampler =
                             ResamplerMap::instance().new_resampler(
-                                arena, frame_factory,
+                                arena, frame_factory, sinc_table_map,
                                 make_config(backend, supported_profiles[n_prof]), in_spec,
                                 out_spec);
                         CHECK(resampler);
@@ -396,7 +403,7 @@ TEST(resampler, invalid_scalings) {
 
                     core::SharedPtr<IResampler> resampler =
                         ResamplerMap::instance().new_resampler(
-                            arena, frame_factory,
+                            arena, frame_factory, sinc_table_map,
                             make_config(backend, supported_profiles[n_prof]), in_spec,
                             out_spec);
                     CHECK(resampler);
@@ -425,6 +432,37 @@ TEST(resampler, invalid_scalings) {
     }
 }
 
+// Slip backend should accept multipliers clamped exactly to its bound,
+// as done by latency tuner, and reject multipliers beyond it.
+TEST(resampler, slip_scaling_bounds) {
+    enum { ChMask = 0x1 };
+
+    const float max_dev = SlipResampler::max_scaling_deviation();
+
+    for (size_t n_rate = 0; n_rate < ROC_ARRAY_SIZE(supported_rates); n_rate++) {
+        const SampleSpec sample_spec =
+            SampleSpec(supported_rates[n_rate], Sample_RawFormat, ChanLayout_Surround,
+                       ChanOrder_Smpte, ChMask);
+
+        core::SharedPtr<IResampler> resampler = ResamplerMap::instance().new_resampler(
+            arena, frame_factory, sinc_table_map,
+            make_config(ResamplerBackend_Slip, ResamplerProfile_Low), sample_spec,
+            sample_spec);
+        CHECK(resampler);
+        CHECK(resampler->is_valid());
+
+        const size_t rate = sample_spec.sample_rate();
+
+        // at the bound
+        CHECK(resampler->set_scaling(rate, rate, 1.0f + max_dev));
+        CHECK(resampler->set_scaling(rate, rate, 1.0f - max_dev));
+
+        // beyond the bound
+        CHECK(!resampler->set_scaling(rate, rate, 1.0f + max_dev * 2));
+        CHECK(!resampler->set_scaling(rate, rate, 1.0f - max_dev * 2));
+    }
+}
+
 // Set scaling, continously resample, and check that actual
 // scaling eventually becomes close to configured scaling.
 TEST(resampler, scaling_trend) {
@@ -450,7 +488,7 @@ TEST(resampler, scaling_trend) {
 
                     core::SharedPtr<IResampler> resampler =
                         ResamplerMap::instance().new_resampler(
-                            arena, frame_factory,
+                            arena, frame_factory, sinc_table_map,
                             make_config(backend, ResamplerProfile_Low), in_spec,
                             out_spec);
                     CHECK(resampler);
@@ -675,7 +713,7 @@ TEST(resampler, reader_timestamp_passthrough) {
 
                     core::SharedPtr<IResampler> resampler =
                         ResamplerMap::instance().new_resampler(
-                            arena, frame_factory,
+                            arena, frame_factory, sinc_table_map,
                             make_config(backend, supported_profiles[n_prof]), in_spec,
                             out_spec);
 
@@ -797,7 +835,7 @@ TEST(resampler, writer_timestamp_passthrough) {
 
                     core::SharedPtr<IResampler> resampler =
                         ResamplerMap::instance().new_resampler(
-                            arena, frame_factory,
+                            arena, frame_factory, sinc_table_map,
                             make_config(backend, supported_profiles[n_prof]), in_spec,
                             out_spec);
 
@@ -918,7 +956,7 @@ TEST(resampler, reader_timestamp_zero_or_small) {
 
                     core::SharedPtr<IResampler> resampler =
                         ResamplerMap::instance().new_resampler(
-                            arena, frame_factory,
+                            arena, frame_factory, sinc_table_map,
                             make_config(backend, supported_profiles[n_prof]), in_spec,
                             out_spec);
 
@@ -1002,7 +1040,7 @@ TEST(resampler, writer_timestamp_zero_or_small) {
 
                     core::SharedPtr<IResampler> resampler =
                         ResamplerMap::instance().new_resampler(
-                            arena, frame_factory,
+                            arena, frame_factory, sinc_table_map,
                             make_config(backend, supported_profiles[n_prof]), in_spec,
                             out_spec);
 
@@ -1053,5 +1091,266 @@ TEST(resampler, writer_timestamp_zero_or_small) {
     }
 }
 
+// Check that slip backend inserts and drops samples smoothly, i.e. difference
+// between adjacent output samples never noticeably exceeds the one of input
+// samples (abrupt drop would double it).
+TEST(resampler, slip_smoothness) {
+    enum {
+        SampleRate = 44100,
+        ChMask = 0x1,
+        NumPad = 2 * OutFrameSize,
+        NumSamples = 50 * OutFrameSize,
+        NumChecked = NumSamples / 2
+    };
+
+    const float scalings[] = { 0.95f, 0.99f, 1.01f, 1.05f };
+
+    const SampleSpec sample_spec(SampleRate, Sample_RawFormat, ChanLayout_Surround,
+                                 ChanOrder_Smpte, ChMask);
+
+    sample_t input[NumSamples];
+    generate_sine(input, NumSamples, NumPad);
+
+    sample_t max_input_diff = 0;
+    for (size_t n = 1; n < NumSamples; n++) {
+        max_input_diff = std::max(max_input_diff, std::abs(input[n] - input[n - 1]));
+    }
+
+    for (size_t n_scale = 0; n_scale < ROC_ARRAY_SIZE(scalings); n_scale++) {
+        for (size_t n_dir = 0; n_dir < ROC_ARRAY_SIZE(supported_dirs); n_dir++) {
+            const Direction dir = supported_dirs[n_dir];
+
+            sample_t output[NumSamples] = {};
+            resample(ResamplerBackend_Slip, ResamplerProfile_Low, dir, input, output,
+                     NumSamples, sample_spec, scalings[n_scale]);
+
+            for (size_t n = 1; n < NumChecked; n++) {
+                const sample_t output_diff = std::abs(output[n] - output[n - 1]);
+
+                if (output_diff > max_input_diff * 1.1f) {
+                    fail("unexpected jump in output:"
+                         " scaling=%f dir=%s pos=%d diff=%f max_diff=%f",
+                         (double)scalings[n_scale], dir_to_str(dir), (int)n,
+                         (double)output_diff, (double)max_input_diff);
+                }
+            }
+        }
+    }
+}
+
+// Builtin resampler should produce same output in planar and interleaved layouts.
+// In planar layout, input frame size is rounded up to keep planes aligned, and
+// output is shifted by frame size, so we check only profiles and rates for which
+// frame size is already aligned.
+TEST(resampler, builtin_planar) {
+    enum {
+        ChMask = 0xF,
+        NumChans = 4,
+        NumFrames = 5,
+        FrameSize = OutFrameSize * NumChans
+    };
+
+    const ResamplerProfile profiles[] = { ResamplerProfile_Medium,
+                                          ResamplerProfile_High };
+
+    for (size_t n_prof = 0; n_prof < ROC_ARRAY_SIZE(profiles); n_prof++) {
+        for (size_t n_rate = 0; n_rate < ROC_ARRAY_SIZE(supported_rates); n_rate++) {
+            for (size_t n_scale = 0; n_scale < ROC_ARRAY_SIZE(supported_scalings);
+                 n_scale++) {
+                const ResamplerConfig config =
+                    make_config(ResamplerBackend_Builtin, profiles[n_prof]);
+
+                const SampleSpec sample_spec(supported_rates[n_rate], Sample_RawFormat,
+                                             ChanLayout_Multitrack, ChanOrder_None,
+                                             ChMask);
+
+                SampleSpec planar_spec = sample_spec;
+                planar_spec.set_sample_layout(SampleLayout_Planar);
+
+                core::SharedPtr<IResampler> resampler =
+                    ResamplerMap::instance().new_resampler(
+                        arena, frame_factory, sinc_table_map, config, sample_spec,
+                        sample_spec);
+                CHECK(resampler);
+
+                core::SharedPtr<IResampler> planar_resampler =
+                    ResamplerMap::instance().new_resampler(
+                        arena, frame_factory, sinc_table_map, config, planar_spec,
+                        planar_spec);
+                CHECK(planar_resampler);
+
+                test::MockReader input_reader;
+                test::MockReader planar_input_reader;
+
+                for (size_t n = 0; n < MaxFrameSize * NumFrames; n++) {
+                    const sample_t s = (sample_t)std::sin(n * 0.1) * 0.5f;
+                    input_reader.add_samples(1, s);
+                    planar_input_reader.add_samples(1, s);
+                }
+
+                ResamplerReader rr(input_reader, *resampler, sample_spec, sample_spec);
+                CHECK(rr.is_valid());
+                CHECK(rr.set_scaling(supported_scalings[n_scale]));
+
+                ResamplerReader planar_rr(planar_input_reader, *planar_resampler,
+                                          planar_spec, planar_spec);
+                CHECK(planar_rr.is_valid());
+                CHECK(planar_rr.set_scaling(supported_scalings[n_scale]));
+
+                core::Slice<sample_t> planar_buf = frame_factory.new_planar_buffer();
+                CHECK(planar_buf);
+
+                for (size_t n_frame = 0; n_frame < NumFrames; n_frame++) {
+                    sample_t samples[FrameSize];
+                    Frame frame(samples, FrameSize);
+                    CHECK(rr.read(frame));
+
+                    Frame planar_frame(planar_buf.data(), FrameSize, NumChans);
+                    CHECK(planar_rr.read(planar_frame));
+
+                    UNSIGNED_LONGS_EQUAL(frame.duration(), planar_frame.duration());
+
+                    for (size_t ch = 0; ch < NumChans; ch++) {
+                        for (size_t n = 0; n < OutFrameSize; n++) {
+                            CHECK_EQUAL(samples[n * NumChans + ch],
+                                        planar_frame.plane(ch)[n]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Only backends supporting planar layout should accept planar sample specs.
+TEST(resampler, planar_support) {
+    SampleSpec sample_spec(48000, Sample_RawFormat, ChanLayout_Surround,
+                           ChanOrder_Smpte, ChanMask_Surround_Stereo);
+    sample_spec.set_sample_layout(SampleLayout_Planar);
+
+    CHECK(ResamplerMap::instance().supports_planar(ResamplerBackend_Builtin));
+
+    for (size_t n_back = 0; n_back < ResamplerMap::instance().num_backends(); n_back++) {
+        const ResamplerBackend backend = ResamplerMap::instance().nth_backend(n_back);
+
+        core::SharedPtr<IResampler> resampler = ResamplerMap::instance().new_resampler(
+            arena, frame_factory, sinc_table_map,
+            make_config(backend, ResamplerProfile_Medium), sample_spec, sample_spec);
+
+        CHECK_EQUAL(ResamplerMap::instance().supports_planar(backend), (bool)resampler);
+    }
+}
+
+// Builtin resampler in integer format should produce the same signal as in
+// raw format, within precision of integer samples and quantized weights.
+TEST(resampler, builtin_integer) {
+    enum {
+        ChMask = 0x3,
+        NumChans = 2,
+        NumFrames = 5,
+        FrameSize = OutFrameSize * NumChans
+    };
+
+    const PcmFormat formats[] = { PcmFormat_SInt16, PcmFormat_SInt32 };
+    const double max_errors[] = { 1e-3, 1e-5 };
+
+    for (size_t n_fmt = 0; n_fmt < ROC_ARRAY_SIZE(formats); n_fmt++) {
+        for (size_t n_rate = 0; n_rate < ROC_ARRAY_SIZE(supported_rates); n_rate++) {
+            for (size_t n_scale = 0; n_scale < ROC_ARRAY_SIZE(supported_scalings);
+                 n_scale++) {
+                const ResamplerConfig config =
+                    make_config(ResamplerBackend_Builtin, ResamplerProfile_Medium);
+
+                const SampleSpec sample_spec(supported_rates[n_rate], Sample_RawFormat,
+                                             ChanLayout_Surround, ChanOrder_Smpte,
+                                             ChMask);
+
+                const SampleSpec integer_spec(supported_rates[n_rate], formats[n_fmt],
+                                              ChanLayout_Surround, ChanOrder_Smpte,
+                                              ChMask);
+
+                core::SharedPtr<IResampler> resampler =
+                    ResamplerMap::instance().new_resampler(
+                        arena, frame_factory, sinc_table_map, config, sample_spec,
+                        sample_spec);
+                CHECK(resampler);
+
+                core::SharedPtr<IResampler> integer_resampler =
+                    ResamplerMap::instance().new_resampler(
+                        arena, frame_factory, sinc_table_map, config, integer_spec,
+                        integer_spec);
+                CHECK(integer_resampler);
+
+                test::MockReader input_reader;
+                test::MockReader integer_input_reader;
+
+                for (size_t n = 0; n < MaxFrameSize * NumFrames; n++) {
+                    const sample_t s = (sample_t)std::sin(n * 0.1) * 0.5f;
+                    input_reader.add_samples(1, s);
+                    integer_input_reader.add_samples(1, s);
+                }
+
+                PcmMapperReader integer_mapper(integer_input_reader, frame_factory,
+                                               sample_spec, integer_spec);
+                CHECK(integer_mapper.is_valid());
+
+                ResamplerReader rr(input_reader, *resampler, sample_spec, sample_spec);
+                CHECK(rr.is_valid());
+                CHECK(rr.set_scaling(supported_scalings[n_scale]));
+
+                ResamplerReader integer_rr(integer_mapper, *integer_resampler,
+                                           integer_spec, integer_spec);
+                CHECK(integer_rr.is_valid());
+                CHECK(integer_rr.set_scaling(supported_scalings[n_scale]));
+
+                const double integer_scale = formats[n_fmt] == PcmFormat_SInt16
+                    ? 32768.0
+                    : 2147483648.0;
+
+                for (size_t n_frame = 0; n_frame < NumFrames; n_frame++) {
+                    sample_t samples[FrameSize];
+                    Frame frame(samples, FrameSize);
+                    CHECK(rr.read(frame));
+
+                    int32_t integer_samples[FrameSize];
+                    Frame integer_frame((uint8_t*)integer_samples,
+                                        FrameSize * integer_sample_size(formats[n_fmt]));
+                    CHECK(integer_rr.read(integer_frame));
+
+                    CHECK(integer_frame.flags() & Frame::FlagNotRaw);
+                    UNSIGNED_LONGS_EQUAL(frame.duration(), integer_frame.duration());
+
+                    for (size_t n = 0; n < FrameSize; n++) {
+                        const double integer_sample = formats[n_fmt] == PcmFormat_SInt16
+                            ? (double)((int16_t*)integer_samples)[n]
+                            : (double)integer_samples[n];
+
+                        DOUBLES_EQUAL((double)samples[n], integer_sample / integer_scale,
+                                      max_errors[n_fmt]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Only backends supporting integer formats should accept integer sample specs.
+TEST(resampler, integer_support) {
+    const SampleSpec sample_spec(48000, PcmFormat_SInt16, ChanLayout_Surround,
+                                 ChanOrder_Smpte, ChanMask_Surround_Stereo);
+
+    CHECK(ResamplerMap::instance().supports_integer(ResamplerBackend_Builtin));
+
+    for (size_t n_back = 0; n_back < ResamplerMap::instance().num_backends(); n_back++) {
+        const ResamplerBackend backend = ResamplerMap::instance().nth_backend(n_back);
+
+        core::SharedPtr<IResampler> resampler = ResamplerMap::instance().new_resampler(
+            arena, frame_factory, sinc_table_map,
+            make_config(backend, ResamplerProfile_Medium), sample_spec, sample_spec);
+
+        CHECK_EQUAL(ResamplerMap::instance().supports_integer(backend), (bool)resampler);
+    }
+}
+
 } // namespace audio
 } // namespace roc
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/frame.h"
+#include "roc_audio/frame_factory.h"
+#include "roc_audio/sample_layout.h"
+#include "roc_core/heap_arena.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { NumChans = 3, NumSamples = 20, Stride = 32 };
+
+core::HeapArena arena;
+
+} // namespace
+
+TEST_GROUP(sample_layout) {};
+
+TEST(sample_layout, plane_stride) {
+    CHECK_EQUAL(0, plane_stride(0));
+    CHECK_EQUAL(16, plane_stride(1));
+    CHECK_EQUAL(16, plane_stride(16));
+    CHECK_EQUAL(32, plane_stride(17));
+    CHECK_EQUAL(480, plane_stride(480));
+}
+
+TEST(sample_layout, planar_buffer_samples) {
+    CHECK_EQUAL(0, planar_buffer_samples(30, 2));
+    CHECK_EQUAL(16, planar_buffer_samples(32, 2));
+    CHECK_EQUAL(16, planar_buffer_samples(63, 2));
+    CHECK_EQUAL(32, planar_buffer_samples(100, 3));
+    CHECK_EQUAL(1024, planar_buffer_samples(1024, 1));
+}
+
+TEST(sample_layout, interleave_roundtrip) {
+    sample_t interleaved[NumSamples * NumChans];
+    for (size_t n = 0; n < NumSamples * NumChans; n++) {
+        interleaved[n] = sample_t(n) / 100;
+    }
+
+    sample_t planar[Stride * NumChans] = {};
+    deinterleave_samples(interleaved, planar, Stride, NumChans, NumSamples);
+
+    for (size_t ch = 0; ch < NumChans; ch++) {
+        for (size_t ns = 0; ns < NumSamples; ns++) {
+            CHECK_EQUAL(interleaved[ns * NumChans + ch], planar[ch * Stride + ns]);
+        }
+        for (size_t ns = NumSamples; ns < Stride; ns++) {
+            CHECK_EQUAL(0, planar[ch * Stride + ns]);
+        }
+    }
+
+    sample_t output[NumSamples * NumChans] = {};
+    interleave_samples(planar, Stride, output, NumChans, NumSamples);
+
+    for (size_t n = 0; n < NumSamples * NumChans; n++) {
+        CHECK_EQUAL(interleaved[n], output[n]);
+    }
+}
+
+TEST(sample_layout, planar_frame) {
+    FrameFactory frame_factory(arena, 1000 * sizeof(sample_t));
+
+    core::Slice<sample_t> buf = frame_factory.new_planar_buffer();
+    CHECK(buf);
+    CHECK_EQUAL(0, (uintptr_t)buf.data() % PlaneAlignment);
+
+    Frame frame(buf.data(), NumSamples * NumChans, NumChans);
+
+    CHECK(frame.is_planar());
+    CHECK_EQUAL(NumChans, frame.num_planes());
+    CHECK_EQUAL(Stride, frame.plane_stride());
+    CHECK_EQUAL(NumSamples * NumChans, frame.num_raw_samples());
+    CHECK_EQUAL(Stride * NumChans * sizeof(sample_t), frame.num_bytes());
+
+    for (size_t ch = 0; ch < NumChans; ch++) {
+        POINTERS_EQUAL(buf.data() + ch * Stride, frame.plane(ch));
+        CHECK_EQUAL(0, (uintptr_t)frame.plane(ch) % PlaneAlignment);
+    }
+}
+
+TEST(sample_layout, planar_buffer_size) {
+    FrameFactory frame_factory(arena, 1000 * sizeof(sample_t));
+
+    for (size_t n_chans = 1; n_chans <= 32; n_chans++) {
+        const size_t max_size = frame_factory.planar_buffer_size(n_chans);
+
+        CHECK(max_size > 0);
+        CHECK_EQUAL(0, max_size % (PlaneAlignment / sizeof(sample_t)));
+
+        core::Slice<sample_t> buf = frame_factory.new_planar_buffer();
+        CHECK(buf);
+        CHECK(buf.capacity() >= max_size * n_chans);
+    }
+
+    FrameFactory small_frame_factory(arena, 16 * sizeof(sample_t));
+
+    CHECK_EQUAL(0, small_frame_factory.planar_buffer_size(1));
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/sinc_table_map.h"
+#include "roc_core/heap_arena.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+core::HeapArena arena;
+
+} // namespace
+
+TEST_GROUP(sinc_table_map) {};
+
+TEST(sinc_table_map, same_params) {
+    SincTableMap table_map(arena);
+
+    core::SharedPtr<SincTable> table1 = table_map.get_table(16, 64);
+    CHECK(table1);
+
+    const size_t n_tables = table_map.num_tables();
+    UNSIGNED_LONGS_EQUAL(1, n_tables);
+
+    core::SharedPtr<SincTable> table2 = table_map.get_table(16, 64);
+    CHECK(table2);
+
+    POINTERS_EQUAL(table1.get(), table2.get());
+    UNSIGNED_LONGS_EQUAL(n_tables, table_map.num_tables());
+}
+
+TEST(sinc_table_map, different_params) {
+    SincTableMap table_map(arena);
+
+    core::SharedPtr<SincTable> table1 = table_map.get_table(8, 32);
+    CHECK(table1);
+
+    core::SharedPtr<SincTable> table2 = table_map.get_table(8, 16);
+    CHECK(table2);
+
+    core::SharedPtr<SincTable> table3 = table_map.get_table(4, 32);
+    CHECK(table3);
+
+    CHECK(table1.get() != table2.get());
+    CHECK(table1.get() != table3.get());
+    CHECK(table2.get() != table3.get());
+
+    UNSIGNED_LONGS_EQUAL(8, table1->window_size());
+    UNSIGNED_LONGS_EQUAL(32, table1->window_interp());
+    UNSIGNED_LONGS_EQUAL(8 * 32 + 2, table1->size());
+
+    UNSIGNED_LONGS_EQUAL(8 * 16 + 2, table2->size());
+    UNSIGNED_LONGS_EQUAL(4 * 32 + 2, table3->size());
+
+    UNSIGNED_LONGS_EQUAL(3, table_map.num_tables());
+}
+
+// Every map has its own tables, allocated from map's arena.
+TEST(sinc_table_map, separate_maps) {
+    core::HeapArena arena1;
+    core::HeapArena arena2;
+
+    core::SharedPtr<SincTable> table1;
+    core::SharedPtr<SincTable> table2;
+
+    {
+        SincTableMap table_map1(arena1);
+        SincTableMap table_map2(arena2);
+
+        table1 = table_map1.get_table(16, 64);
+        CHECK(table1);
+
+        CHECK(arena1.num_allocations() > 0);
+        UNSIGNED_LONGS_EQUAL(0, arena2.num_allocations());
+
+        table2 = table_map2.get_table(16, 64);
+        CHECK(table2);
+
+        CHECK(arena2.num_allocations() > 0);
+        CHECK(table1.get() != table2.get());
+    }
+
+    // Tables in use outlive their maps.
+    UNSIGNED_LONGS_EQUAL(16 * 64 + 2, table1->size());
+    UNSIGNED_LONGS_EQUAL(16 * 64 + 2, table2->size());
+
+    table1 = NULL;
+    table2 = NULL;
+
+    UNSIGNED_LONGS_EQUAL(0, arena1.num_allocations());
+    UNSIGNED_LONGS_EQUAL(0, arena2.num_allocations());
+}
+
+TEST(sinc_table_map, table_values) {
+    enum { WindowSize = 8, WindowInterp = 32 };
+
+    SincTableMap table_map(arena);
+
+    core::SharedPtr<SincTable> table = table_map.get_table(WindowSize, WindowInterp);
+    CHECK(table);
+
+    const sample_t* data = table->data();
+
+    // peak at zero
+    DOUBLES_EQUAL(1.0, data[0], 1e-6);
+
+    // zero crossings at integer points
+    for (size_t n = 1; n < WindowSize; n++) {
+        DOUBLES_EQUAL(0.0, data[n * WindowInterp], 1e-6);
+    }
+
+    // trailing zeros for interpolation
+    DOUBLES_EQUAL(0.0, data[table->size() - 2], 0);
+    DOUBLES_EQUAL(0.0, data[table->size() - 1], 0);
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/fast_random.h"
+#include "roc_core/flat_hashmap.h"
+#include "roc_core/hashmap.h"
+#include "roc_core/hashsum.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace core {
+namespace {
+
+// Number of lookups per iteration.
+enum { NumLookups = 1024 };
+
+HeapArena arena;
+
+// Key is similar to SSRC used by session router and RTCP reporter.
+struct Object : HashmapNode<> {
+    uint32_t id;
+
+    Object()
+        : id(0) {
+    }
+
+    uint32_t key() const {
+        return id;
+    }
+
+    static hashsum_t key_hash(uint32_t id) {
+        return hashsum_int(id);
+    }
+
+    static bool key_equal(uint32_t id1, uint32_t id2) {
+        return id1 == id2;
+    }
+};
+
+template <class Map> class LookupBench {
+public:
+    explicit LookupBench(size_t n_elems)
+        : objects_(new Object[n_elems])
+        , keys_(new uint32_t[NumLookups])
+        , map_(arena) {
+        for (size_t n = 0; n < n_elems; n++) {
+            objects_[n].id = fast_random_range(0, (uint32_t)-1);
+            while (map_.find(objects_[n].id)) {
+                objects_[n].id = fast_random_range(0, (uint32_t)-1);
+            }
+            roc_panic_if(!map_.insert(objects_[n]));
+        }
+        for (size_t n = 0; n < NumLookups; n++) {
+            keys_[n] = objects_[fast_random_range(0, n_elems - 1)].id;
+        }
+    }
+
+    ~LookupBench() {
+        while (Object* obj = map_.front()) {
+            map_.remove(*obj);
+        }
+        delete[] keys_;
+        delete[] objects_;
+    }
+
+    void run(benchmark::State& state) {
+        while (state.KeepRunning()) {
+            for (size_t n = 0; n < NumLookups; n++) {
+                benchmark::DoNotOptimize(map_.find(keys_[n]));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * NumLookups);
+    }
+
+private:
+    Object* objects_;
+    uint32_t* keys_;
+    Map map_;
+};
+
+void BM_Hashmap_Lookup(benchmark::State& state) {
+    LookupBench<Hashmap<Object, 0, NoOwnership> > bench((size_t)state.range(0));
+    bench.run(state);
+}
+
+BENCHMARK(BM_Hashmap_Lookup)->Arg(10)->Arg(100)->Arg(10000);
+
+void BM_FlatHashmap_Lookup(benchmark::State& state) {
+    LookupBench<FlatHashmap<Object, 0, NoOwnership> > bench((size_t)state.range(0));
+    bench.run(state);
+}
+
+BENCHMARK(BM_FlatHashmap_Lookup)->Arg(10)->Arg(100)->Arg(10000);
+
+} // namespace
+} // namespace core
+} // namespace roc
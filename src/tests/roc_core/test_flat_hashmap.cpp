@@ -0,0 +1,489 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/flat_hashmap.h"
+#include "roc_core/hashsum.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/noop_arena.h"
+#include "roc_core/ref_counted.h"
+#include "roc_core/shared_ptr.h"
+#include "roc_core/string_builder.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+struct HeapAllocation {
+    template <class T> void destroy(T& object) {
+        delete &object;
+    }
+};
+
+class Object : public RefCounted<Object, HeapAllocation> {
+public:
+    Object(const char* k) {
+        strcpy(key_, k);
+    }
+
+    static hashsum_t key_hash(const char* key) {
+        return hashsum_str(key);
+    }
+
+    static bool key_equal(const char* key1, const char* key2) {
+        return strcmp(key1, key2) == 0;
+    }
+
+    const char* key() const {
+        return key_;
+    }
+
+private:
+    char key_[64];
+};
+
+// All keys have same hash, so every lookup has to probe.
+class CollidingObject : public RefCounted<CollidingObject, HeapAllocation> {
+public:
+    CollidingObject(size_t k)
+        : key_(k) {
+    }
+
+    static hashsum_t key_hash(size_t) {
+        return 12345;
+    }
+
+    static bool key_equal(size_t key1, size_t key2) {
+        return key1 == key2;
+    }
+
+    size_t key() const {
+        return key_;
+    }
+
+private:
+    size_t key_;
+};
+
+void format_key(char* key, size_t keysz, size_t n) {
+    StringBuilder b(key, keysz);
+    CHECK(b.append_str("key"));
+    CHECK(b.append_uint((uint64_t)n, 10));
+    CHECK(b.is_ok());
+}
+
+HeapArena arena;
+
+} // namespace
+
+TEST_GROUP(flat_hashmap) {};
+
+TEST(flat_hashmap, empty) {
+    FlatHashmap<Object> hashmap(arena);
+
+    UNSIGNED_LONGS_EQUAL(0, hashmap.size());
+    UNSIGNED_LONGS_EQUAL(0, hashmap.capacity());
+
+    CHECK(!hashmap.find("foo"));
+    CHECK(!hashmap.front());
+    CHECK(!hashmap.back());
+
+    UNSIGNED_LONGS_EQUAL(0, arena.num_allocations());
+}
+
+TEST(flat_hashmap, insert) {
+    SharedPtr<Object> obj = new Object("foo");
+
+    FlatHashmap<Object> hashmap(arena);
+    UNSIGNED_LONGS_EQUAL(0, hashmap.size());
+
+    CHECK(!hashmap.find("foo"));
+    CHECK(!hashmap.contains(*obj));
+
+    CHECK(hashmap.insert(*obj));
+    UNSIGNED_LONGS_EQUAL(1, hashmap.size());
+
+    CHECK(hashmap.find("foo") == obj);
+    CHECK(!hashmap.find("bar"));
+    CHECK(hashmap.contains(*obj));
+}
+
+TEST(flat_hashmap, remove) {
+    SharedPtr<Object> obj = new Object("foo");
+
+    FlatHashmap<Object> hashmap(arena);
+
+    CHECK(hashmap.insert(*obj));
+    UNSIGNED_LONGS_EQUAL(1, hashmap.size());
+
+    CHECK(hashmap.find("foo"));
+
+    hashmap.remove(*obj);
+    UNSIGNED_LONGS_EQUAL(0, hashmap.size());
+
+    CHECK(!hashmap.find("foo"));
+    CHECK(!hashmap.contains(*obj));
+}
+
+TEST(flat_hashmap, contains_same_key) {
+    SharedPtr<Object> obj1 = new Object("foo");
+    SharedPtr<Object> obj2 = new Object("foo");
+
+    FlatHashmap<Object> hashmap(arena);
+
+    CHECK(hashmap.insert(*obj1));
+
+    // contains() checks identity, not key
+    CHECK(hashmap.contains(*obj1));
+    CHECK(!hashmap.contains(*obj2));
+}
+
+TEST(flat_hashmap, insert_remove_many) {
+    enum { NumIterations = 10, NumElements = 200 };
+
+    FlatHashmap<Object> hashmap(arena);
+
+    for (size_t i = 0; i < NumIterations; i++) {
+        UNSIGNED_LONGS_EQUAL(0, hashmap.size());
+
+        for (size_t n = 0; n < NumElements; n++) {
+            char key[64];
+            format_key(key, sizeof(key), n);
+
+            SharedPtr<Object> obj = new Object(key);
+            CHECK(hashmap.insert(*obj));
+        }
+
+        UNSIGNED_LONGS_EQUAL(NumElements, hashmap.size());
+
+        for (size_t n = 0; n < NumElements; n++) {
+            char key[64];
+            format_key(key, sizeof(key), n);
+
+            SharedPtr<Object> obj = hashmap.find(key);
+
+            CHECK(obj);
+            STRCMP_EQUAL(obj->key(), key);
+
+            hashmap.remove(*obj);
+        }
+    }
+}
+
+TEST(flat_hashmap, collisions) {
+    enum { NumElements = 100 };
+
+    FlatHashmap<CollidingObject> hashmap(arena);
+
+    for (size_t n = 0; n < NumElements; n++) {
+        SharedPtr<CollidingObject> obj = new CollidingObject(n);
+        CHECK(hashmap.insert(*obj));
+    }
+
+    for (size_t n = 0; n < NumElements; n++) {
+        SharedPtr<CollidingObject> obj = hashmap.find(n);
+        CHECK(obj);
+        UNSIGNED_LONGS_EQUAL(n, obj->key());
+    }
+
+    CHECK(!hashmap.find((size_t)NumElements));
+
+    for (size_t n = 0; n < NumElements; n += 2) {
+        SharedPtr<CollidingObject> obj = hashmap.find(n);
+        CHECK(obj);
+        hashmap.remove(*obj);
+    }
+
+    for (size_t n = 0; n < NumElements; n++) {
+        CHECK((hashmap.find(n) != NULL) == (n % 2 != 0));
+    }
+}
+
+TEST(flat_hashmap, grow_rapidly) {
+    enum { NumIterations = 5 };
+
+    FlatHashmap<Object> hashmap(arena);
+
+    UNSIGNED_LONGS_EQUAL(0, hashmap.capacity());
+    UNSIGNED_LONGS_EQUAL(0, arena.num_allocations());
+
+    size_t n_elems = 0;
+
+    for (size_t i = 0; i < NumIterations; i++) {
+        UNSIGNED_LONGS_EQUAL(n_elems, hashmap.size());
+
+        const size_t old_cap = hashmap.capacity();
+
+        CHECK(hashmap.grow());
+
+        const size_t new_cap = hashmap.capacity();
+
+        CHECK(old_cap < new_cap);
+        CHECK(n_elems < new_cap);
+
+        // old table is freed after rebuild
+        UNSIGNED_LONGS_EQUAL(1, arena.num_allocations());
+
+        for (size_t n = old_cap; n < new_cap; n++) {
+            char key[64];
+            format_key(key, sizeof(key), n_elems++);
+
+            SharedPtr<Object> obj = new Object(key);
+            CHECK(hashmap.insert(*obj));
+
+            UNSIGNED_LONGS_EQUAL(n_elems, hashmap.size());
+            UNSIGNED_LONGS_EQUAL(new_cap, hashmap.capacity());
+        }
+    }
+}
+
+TEST(flat_hashmap, grow_slowly) {
+    enum {
+        NumElements = 5000,
+        StartSize = 77,
+        GrowthRatio = 5 // keep every 5th element
+    };
+
+    FlatHashmap<Object> hashmap(arena);
+
+    for (size_t n = 0; n < NumElements; n++) {
+        {
+            char key[64];
+            format_key(key, sizeof(key), n);
+
+            SharedPtr<Object> obj = new Object(key);
+            CHECK(hashmap.insert(*obj));
+        }
+
+        if (n > StartSize && n % GrowthRatio != 0) {
+            char key[64];
+            format_key(key, sizeof(key), n - 10);
+
+            SharedPtr<Object> obj = hashmap.find(key);
+
+            CHECK(obj);
+            STRCMP_EQUAL(obj->key(), key);
+
+            hashmap.remove(*obj);
+        }
+    }
+
+    for (size_t n = 0; n < NumElements; n++) {
+        char key[64];
+        format_key(key, sizeof(key), n);
+
+        const bool removed =
+            n > StartSize - 10 && n < NumElements - 10 && (n + 10) % GrowthRatio != 0;
+
+        CHECK((hashmap.find(key) != NULL) == !removed);
+    }
+}
+
+TEST(flat_hashmap, compaction) {
+    enum { NumIterations = 1000 };
+
+    FlatHashmap<Object> hashmap(arena);
+
+    SharedPtr<Object> obj = new Object("foo");
+
+    CHECK(hashmap.insert(*obj));
+
+    const size_t cap = hashmap.capacity();
+
+    // holes left by removed elements are reused instead of growing table
+    for (size_t n = 0; n < NumIterations; n++) {
+        char key[64];
+        format_key(key, sizeof(key), n);
+
+        SharedPtr<Object> tmp = new Object(key);
+        CHECK(hashmap.insert(*tmp));
+
+        hashmap.remove(*tmp);
+    }
+
+    UNSIGNED_LONGS_EQUAL(1, hashmap.size());
+    UNSIGNED_LONGS_EQUAL(cap, hashmap.capacity());
+
+    CHECK(hashmap.find("foo") == obj);
+    CHECK(hashmap.front() == obj);
+    CHECK(hashmap.back() == obj);
+}
+
+TEST(flat_hashmap, refcounting) {
+    SharedPtr<Object> obj1 = new Object("foo");
+    SharedPtr<Object> obj2 = new Object("bar");
+
+    UNSIGNED_LONGS_EQUAL(1, obj1->getref());
+    UNSIGNED_LONGS_EQUAL(1, obj2->getref());
+
+    {
+        FlatHashmap<Object> hashmap(arena);
+
+        CHECK(hashmap.insert(*obj1));
+        CHECK(hashmap.insert(*obj2));
+
+        UNSIGNED_LONGS_EQUAL(2, obj1->getref());
+        UNSIGNED_LONGS_EQUAL(2, obj2->getref());
+
+        hashmap.remove(*obj1);
+
+        UNSIGNED_LONGS_EQUAL(1, obj1->getref());
+        UNSIGNED_LONGS_EQUAL(2, obj2->getref());
+
+        {
+            SharedPtr<Object> obj3 = hashmap.find("bar");
+
+            UNSIGNED_LONGS_EQUAL(1, obj1->getref());
+            UNSIGNED_LONGS_EQUAL(3, obj2->getref());
+        }
+
+        UNSIGNED_LONGS_EQUAL(1, obj1->getref());
+        UNSIGNED_LONGS_EQUAL(2, obj2->getref());
+    }
+
+    UNSIGNED_LONGS_EQUAL(1, obj1->getref());
+    UNSIGNED_LONGS_EQUAL(1, obj2->getref());
+}
+
+TEST(flat_hashmap, iterate_forward) {
+    enum { NumElements = 200 };
+
+    FlatHashmap<Object> hashmap(arena);
+
+    SharedPtr<Object> objects[NumElements];
+
+    for (size_t n = 0; n < NumElements; n++) {
+        char key[64];
+        format_key(key, sizeof(key), n);
+
+        SharedPtr<Object> obj = new Object(key);
+        CHECK(hashmap.insert(*obj));
+
+        objects[n] = obj;
+
+        CHECK(hashmap.front() == objects[0]);
+        CHECK(hashmap.back() == objects[n]);
+    }
+
+    size_t pos = 0;
+
+    for (SharedPtr<Object> obj = hashmap.front(); obj; obj = hashmap.nextof(*obj)) {
+        CHECK(obj == objects[pos]);
+        pos++;
+    }
+
+    UNSIGNED_LONGS_EQUAL(NumElements, pos);
+}
+
+TEST(flat_hashmap, iterate_backward) {
+    enum { NumElements = 200 };
+
+    FlatHashmap<Object> hashmap(arena);
+
+    SharedPtr<Object> objects[NumElements];
+
+    for (size_t n = 0; n < NumElements; n++) {
+        char key[64];
+        format_key(key, sizeof(key), n);
+
+        SharedPtr<Object> obj = new Object(key);
+        CHECK(hashmap.insert(*obj));
+
+        objects[n] = obj;
+    }
+
+    size_t pos = NumElements;
+
+    for (SharedPtr<Object> obj = hashmap.back(); obj; obj = hashmap.prevof(*obj)) {
+        pos--;
+        CHECK(obj == objects[pos]);
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, pos);
+}
+
+TEST(flat_hashmap, iterate_modify) {
+    enum { NumElements = 200 };
+
+    FlatHashmap<Object> hashmap(arena);
+
+    SharedPtr<Object> objects[NumElements];
+
+    for (size_t n = 0; n < NumElements - 1; n++) {
+        char key[64];
+        format_key(key, sizeof(key), n);
+
+        SharedPtr<Object> obj = new Object(key);
+        CHECK(hashmap.insert(*obj));
+
+        objects[n] = obj;
+    }
+
+    size_t pos = 0;
+
+    for (SharedPtr<Object> obj = hashmap.front(); obj; obj = hashmap.nextof(*obj)) {
+        if (pos == 2) {
+            // remove already visited element during iteration
+            hashmap.remove(*objects[1]);
+        }
+
+        if (pos == 3) {
+            // insert new element during iteration
+            char key[64];
+            format_key(key, sizeof(key), NumElements - 1);
+
+            SharedPtr<Object> new_obj = new Object(key);
+            CHECK(hashmap.insert(*new_obj));
+
+            objects[NumElements - 1] = new_obj;
+        }
+
+        CHECK(obj == objects[pos]);
+        pos++;
+    }
+
+    UNSIGNED_LONGS_EQUAL(NumElements, pos);
+}
+
+template <size_t Capacity> void test_embedded_capacity() {
+    FlatHashmap<Object, Capacity> hashmap(core::NoopArena);
+
+    CHECK(hashmap.capacity() >= Capacity);
+
+    size_t n = 0;
+
+    for (;;) {
+        char key[64];
+        format_key(key, sizeof(key), n);
+
+        SharedPtr<Object> obj = new Object(key);
+        if (!hashmap.insert(*obj)) {
+            break;
+        }
+        n++;
+    }
+
+    CHECK(n >= Capacity);
+    UNSIGNED_LONGS_EQUAL(n, hashmap.capacity());
+}
+
+TEST(flat_hashmap, embedded_capacity) {
+    test_embedded_capacity<0>();
+    test_embedded_capacity<5>();
+    test_embedded_capacity<10>();
+    test_embedded_capacity<15>();
+    test_embedded_capacity<20>();
+    test_embedded_capacity<25>();
+    test_embedded_capacity<50>();
+    test_embedded_capacity<100>();
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/log.h"
+#include "roc_core/thread.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+enum { MaxMessages = 2000, NumThreads = 4 };
+
+struct Message {
+    LogLevel level;
+    uint64_t tid;
+    uint64_t handler_tid;
+    char text[64];
+};
+
+Message messages[MaxMessages];
+size_t n_messages;
+size_t n_dropped_reports;
+
+void test_handler(const LogMessage& msg, void** args) {
+    CHECK(args);
+    CHECK(args[0] == &n_messages);
+
+    if (strncmp(msg.text, "logger: dropped", 15) == 0) {
+        n_dropped_reports++;
+        return;
+    }
+
+    CHECK(n_messages < MaxMessages);
+
+    messages[n_messages].level = msg.level;
+    messages[n_messages].tid = msg.tid;
+    messages[n_messages].handler_tid = Thread::get_tid();
+    snprintf(messages[n_messages].text, sizeof(messages[n_messages].text), "%s",
+             msg.text);
+
+    n_messages++;
+}
+
+class LoggingThread : public Thread {
+public:
+    LoggingThread(size_t index, size_t n_messages)
+        : index_(index)
+        , n_messages_(n_messages) {
+    }
+
+    virtual ~LoggingThread() {
+    }
+
+private:
+    virtual void run() {
+        for (size_t n = 0; n < n_messages_; n++) {
+            roc_log(LogInfo, "thread %d message %d", (int)index_, (int)n);
+        }
+    }
+
+    const size_t index_;
+    const size_t n_messages_;
+};
+
+} // namespace
+
+TEST_GROUP(log) {
+    LogLevel saved_level;
+
+    void setup() {
+        memset(messages, 0, sizeof(messages));
+        n_messages = 0;
+        n_dropped_reports = 0;
+
+        saved_level = Logger::instance().get_level();
+        Logger::instance().set_level(LogInfo);
+
+        void* args[1] = { &n_messages };
+        Logger::instance().set_handler(&test_handler, args, 1);
+    }
+
+    void teardown() {
+        Logger::instance().set_async(false);
+        Logger::instance().set_handler(NULL, NULL, 0);
+        Logger::instance().set_level(saved_level);
+    }
+};
+
+TEST(log, sync) {
+    roc_log(LogInfo, "message %d", 1);
+    roc_log(LogDebug, "message %d", 2);
+    roc_log(LogError, "message %d", 3);
+
+    LONGS_EQUAL(2, n_messages);
+
+    LONGS_EQUAL(LogInfo, messages[0].level);
+    STRCMP_EQUAL("message 1", messages[0].text);
+
+    LONGS_EQUAL(LogError, messages[1].level);
+    STRCMP_EQUAL("message 3", messages[1].text);
+}
+
+TEST(log, async) {
+    Logger::instance().set_async(true);
+
+    const size_t dropped_before = Logger::instance().num_dropped();
+
+    roc_log(LogInfo, "message %d", 1);
+    roc_log(LogDebug, "message %d", 2);
+    roc_log(LogError, "message %d", 3);
+
+    // Disabling async mode flushes pending messages.
+    Logger::instance().set_async(false);
+
+    LONGS_EQUAL(dropped_before, Logger::instance().num_dropped());
+    LONGS_EQUAL(2, n_messages);
+
+    LONGS_EQUAL(LogInfo, messages[0].level);
+    STRCMP_EQUAL("message 1", messages[0].text);
+    LONGS_EQUAL(Thread::get_tid(), messages[0].tid);
+
+    LONGS_EQUAL(LogError, messages[1].level);
+    STRCMP_EQUAL("message 3", messages[1].text);
+    LONGS_EQUAL(Thread::get_tid(), messages[1].tid);
+}
+
+TEST(log, async_restart) {
+    for (int i = 0; i < 3; i++) {
+        Logger::instance().set_async(true);
+        roc_log(LogInfo, "message %d", i);
+        Logger::instance().set_async(false);
+    }
+
+    LONGS_EQUAL(3, n_messages);
+
+    STRCMP_EQUAL("message 0", messages[0].text);
+    STRCMP_EQUAL("message 1", messages[1].text);
+    STRCMP_EQUAL("message 2", messages[2].text);
+}
+
+TEST(log, async_overflow) {
+    enum { NumMessages = LogRing::Capacity * 20 };
+
+    Logger::instance().set_async(true);
+
+    const size_t dropped_before = Logger::instance().num_dropped();
+
+    for (size_t n = 0; n < NumMessages; n++) {
+        roc_log(LogInfo, "message %d", (int)n);
+    }
+
+    Logger::instance().set_async(false);
+
+    const size_t n_dropped = Logger::instance().num_dropped() - dropped_before;
+
+    // Every message is either delivered or counted as dropped.
+    LONGS_EQUAL(NumMessages, n_messages + n_dropped);
+
+    if (n_dropped != 0) {
+        CHECK(n_dropped_reports > 0);
+    }
+
+    // Delivered messages preserve order.
+    int prev = -1;
+    for (size_t n = 0; n < n_messages; n++) {
+        int curr = -1;
+        CHECK(sscanf(messages[n].text, "message %d", &curr) == 1);
+        CHECK(curr > prev);
+        prev = curr;
+    }
+}
+
+TEST(log, async_threads) {
+    enum { NumMessages = LogRing::Capacity / 2 };
+
+    Logger::instance().set_async(true);
+
+    const size_t dropped_before = Logger::instance().num_dropped();
+
+    LoggingThread* threads[NumThreads];
+
+    for (size_t n = 0; n < NumThreads; n++) {
+        threads[n] = new LoggingThread(n, NumMessages);
+        CHECK(threads[n]->start());
+    }
+
+    for (size_t n = 0; n < NumThreads; n++) {
+        threads[n]->join();
+        delete threads[n];
+    }
+
+    Logger::instance().set_async(false);
+
+    LONGS_EQUAL(dropped_before, Logger::instance().num_dropped());
+    LONGS_EQUAL(NumThreads * NumMessages, n_messages);
+
+    // Messages from every thread preserve order.
+    for (size_t nt = 0; nt < NumThreads; nt++) {
+        int prev = -1;
+        for (size_t n = 0; n < n_messages; n++) {
+            int thr = -1, curr = -1;
+            CHECK(sscanf(messages[n].text, "thread %d message %d", &thr, &curr) == 2);
+            if (thr == (int)nt) {
+                CHECK(curr > prev);
+                prev = curr;
+            }
+        }
+        LONGS_EQUAL(NumMessages - 1, prev);
+    }
+}
+
+// Rings are released when threads exit, so many short-lived threads
+// can log asynchronously one after another.
+TEST(log, async_thread_exit) {
+    enum { NumSeqThreads = 64, NumMessages = 4 };
+
+    Logger::instance().set_async(true);
+
+    for (size_t n = 0; n < NumSeqThreads; n++) {
+        LoggingThread thread(n, NumMessages);
+        CHECK(thread.start());
+        thread.join();
+    }
+
+    Logger::instance().set_async(false);
+
+    LONGS_EQUAL(NumSeqThreads * NumMessages, n_messages);
+
+    // No thread fell back to synchronous mode, i.e. every message
+    // was passed to handler from drainer thread.
+    for (size_t n = 0; n < n_messages; n++) {
+        CHECK(messages[n].handler_tid != messages[n].tid);
+    }
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/pinned_arena.h"
+#include "roc_core/slab_pool.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+enum { RegionSize = 64 * 1024 };
+
+struct TestObject {
+    char data[100];
+};
+
+} // namespace
+
+TEST_GROUP(pinned_arena) {};
+
+TEST(pinned_arena, init) {
+    PinnedArena arena(RegionSize);
+    CHECK(arena.is_valid());
+
+    CHECK(arena.size() >= RegionSize);
+    UNSIGNED_LONGS_EQUAL(0, arena.num_allocations());
+    UNSIGNED_LONGS_EQUAL(arena.size(), arena.num_free_bytes());
+}
+
+TEST(pinned_arena, allocate_deallocate) {
+    PinnedArena arena(RegionSize);
+    CHECK(arena.is_valid());
+
+    void* p1 = arena.allocate(100);
+    void* p2 = arena.allocate(200);
+    void* p3 = arena.allocate(300);
+
+    CHECK(p1);
+    CHECK(p2);
+    CHECK(p3);
+
+    UNSIGNED_LONGS_EQUAL(3, arena.num_allocations());
+
+    UNSIGNED_LONGS_EQUAL(arena.compute_allocated_size(100), arena.allocated_size(p1));
+    UNSIGNED_LONGS_EQUAL(arena.compute_allocated_size(200), arena.allocated_size(p2));
+    UNSIGNED_LONGS_EQUAL(arena.compute_allocated_size(300), arena.allocated_size(p3));
+
+    UNSIGNED_LONGS_EQUAL(arena.size() - arena.compute_allocated_size(100)
+                             - arena.compute_allocated_size(200)
+                             - arena.compute_allocated_size(300),
+                         arena.num_free_bytes());
+
+    // memory is writable and chunks don't overlap
+    memset(p1, 1, 100);
+    memset(p2, 2, 200);
+    memset(p3, 3, 300);
+
+    CHECK(((char*)p1)[99] == 1);
+    CHECK(((char*)p2)[0] == 2);
+    CHECK(((char*)p2)[199] == 2);
+    CHECK(((char*)p3)[0] == 3);
+
+    arena.deallocate(p2);
+    arena.deallocate(p1);
+    arena.deallocate(p3);
+
+    UNSIGNED_LONGS_EQUAL(0, arena.num_allocations());
+    UNSIGNED_LONGS_EQUAL(arena.size(), arena.num_free_bytes());
+}
+
+TEST(pinned_arena, exhaust) {
+    PinnedArena arena(RegionSize);
+    CHECK(arena.is_valid());
+
+    // region can't be exceeded
+    CHECK(!arena.allocate(arena.size()));
+
+    void* p1 = arena.allocate(arena.size() / 2);
+    CHECK(p1);
+
+    CHECK(!arena.allocate(arena.size() / 2));
+
+    arena.deallocate(p1);
+
+    // freed chunks are merged back
+    void* p2 = arena.allocate(arena.size() - arena.compute_allocated_size(0));
+    CHECK(p2);
+    UNSIGNED_LONGS_EQUAL(0, arena.num_free_bytes());
+
+    arena.deallocate(p2);
+
+    UNSIGNED_LONGS_EQUAL(arena.size(), arena.num_free_bytes());
+}
+
+TEST(pinned_arena, reuse) {
+    enum { NumChunks = 20, NumIterations = 100 };
+
+    PinnedArena arena(RegionSize);
+    CHECK(arena.is_valid());
+
+    void* chunks[NumChunks] = {};
+
+    for (size_t i = 0; i < NumIterations; i++) {
+        for (size_t n = 0; n < NumChunks; n++) {
+            if ((n + i) % 3 == 0 && chunks[n]) {
+                arena.deallocate(chunks[n]);
+                chunks[n] = NULL;
+            } else if (!chunks[n]) {
+                chunks[n] = arena.allocate((n + 1) * 50 + i);
+                CHECK(chunks[n]);
+            }
+        }
+    }
+
+    for (size_t n = 0; n < NumChunks; n++) {
+        if (chunks[n]) {
+            arena.deallocate(chunks[n]);
+        }
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, arena.num_allocations());
+    UNSIGNED_LONGS_EQUAL(arena.size(), arena.num_free_bytes());
+}
+
+TEST(pinned_arena, slab_pool) {
+    PinnedArena arena(RegionSize);
+    CHECK(arena.is_valid());
+
+    {
+        SlabPool<TestObject> pool("test", arena);
+
+        void* objects[100];
+
+        for (size_t n = 0; n < 100; n++) {
+            objects[n] = pool.allocate();
+            CHECK(objects[n]);
+        }
+
+        CHECK(arena.num_allocations() > 0);
+
+        for (size_t n = 0; n < 100; n++) {
+            pool.deallocate(objects[n]);
+        }
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, arena.num_allocations());
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,353 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "roc_address/socket_addr.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/limited_pool.h"
+#include "roc_core/memory_limiter.h"
+#include "roc_core/slab_pool.h"
+#include "roc_core/time.h"
+#include "roc_netio/iuring_udp_handler.h"
+#include "roc_netio/uring_udp_io.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace netio {
+
+namespace {
+
+enum { NumPackets = 100, BufferSize = 125, MaxHeld = NumPackets };
+
+const core::nanoseconds_t Timeout = 10 * core::Second;
+
+core::HeapArena arena;
+
+core::SlabPool<packet::Packet> packet_pool("packet_pool", arena);
+// Received datagrams fill buffers completely, after recvmsg header.
+core::SlabPool<core::Buffer>
+    buffer_pool("buffer_pool",
+                arena,
+                sizeof(core::Buffer) + UringUdpIo::recv_header_size() + BufferSize);
+
+packet::PacketFactory packet_factory(packet_pool, buffer_pool);
+
+class TestHandler : public IUringUdpHandler {
+public:
+    TestHandler()
+        : n_received(0)
+        , n_sent(0)
+        , n_send_errors(0)
+        , n_recv_failed(0)
+        , closed(false)
+        , hold(false) {
+    }
+
+    virtual void handle_uring_received(const core::Slice<uint8_t>& data,
+                                       const address::SocketAddr& src_addr) {
+        CHECK(data);
+        CHECK(n_received < NumPackets);
+
+        LONGS_EQUAL(BufferSize, data.size());
+        for (size_t n = 0; n < BufferSize; n++) {
+            LONGS_EQUAL(uint8_t((n_received + n) & 0xff), data.data()[n]);
+        }
+
+        CHECK(src_addr == expected_src);
+
+        if (hold) {
+            held[n_received] = data;
+        }
+
+        n_received++;
+    }
+
+    virtual void handle_uring_recv_failed() {
+        n_recv_failed++;
+    }
+
+    virtual void handle_uring_sent(const packet::PacketPtr& packet, int err) {
+        CHECK(packet);
+        if (err < 0) {
+            n_send_errors++;
+        }
+        n_sent++;
+    }
+
+    virtual void handle_uring_closed() {
+        closed = true;
+    }
+
+    void release_held() {
+        for (size_t n = 0; n < MaxHeld; n++) {
+            held[n] = core::Slice<uint8_t>();
+        }
+    }
+
+    address::SocketAddr expected_src;
+
+    size_t n_received;
+    size_t n_sent;
+    size_t n_send_errors;
+    size_t n_recv_failed;
+    bool closed;
+
+    bool hold;
+    core::Slice<uint8_t> held[MaxHeld];
+};
+
+int open_socket(address::SocketAddr& addr) {
+    const int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    CHECK(fd >= 0);
+
+    CHECK(addr.set_host_port(address::Family_IPv4, "127.0.0.1", 0));
+    CHECK(bind(fd, addr.saddr(), addr.slen()) == 0);
+
+    socklen_t len = addr.max_slen();
+    CHECK(getsockname(fd, addr.saddr(), &len) == 0);
+
+    // Don't block forever if a datagram is lost.
+    timeval tv;
+    tv.tv_sec = 5;
+    tv.tv_usec = 0;
+    CHECK(setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) == 0);
+
+    return fd;
+}
+
+void fill_datagram(uint8_t* data, int value) {
+    for (int n = 0; n < BufferSize; n++) {
+        data[n] = uint8_t((value + n) & 0xff);
+    }
+}
+
+void send_datagrams(int fd, const address::SocketAddr& dst_addr, int first, int count) {
+    for (int value = first; value < first + count; value++) {
+        uint8_t data[BufferSize];
+        fill_datagram(data, value);
+        CHECK(sendto(fd, data, BufferSize, 0, dst_addr.saddr(), dst_addr.slen())
+              == BufferSize);
+    }
+}
+
+packet::PacketPtr new_packet(const address::SocketAddr& dst_addr, int value) {
+    packet::PacketPtr pp = packet_factory.new_packet();
+    CHECK(pp);
+
+    pp->add_flags(packet::Packet::FlagUDP);
+    pp->udp()->dst_addr = dst_addr;
+
+    core::Slice<uint8_t> buf = packet_factory.new_packet_buffer();
+    CHECK(buf);
+    buf.reslice(0, BufferSize);
+    fill_datagram(buf.data(), value);
+
+    pp->set_buffer(buf);
+
+    return pp;
+}
+
+// Run one non-blocking iteration of event loop.
+// Fails test if deadline is expired.
+void run_loop(uv_loop_t& loop, core::nanoseconds_t deadline) {
+    uv_run(&loop, UV_RUN_NOWAIT);
+    core::sleep_for(core::ClockMonotonic, core::Microsecond * 100);
+
+    if (core::timestamp(core::ClockMonotonic) > deadline) {
+        FAIL("timeout");
+    }
+}
+
+void close_io(uv_loop_t& loop, UringUdpIo& io, TestHandler& handler) {
+    const core::nanoseconds_t deadline = core::timestamp(core::ClockMonotonic) + Timeout;
+
+    io.async_close();
+
+    while (!handler.closed) {
+        run_loop(loop, deadline);
+    }
+
+    CHECK(!io.is_open());
+}
+
+} // namespace
+
+TEST_GROUP(uring_udp_io) {
+    uv_loop_t loop;
+
+    void setup() {
+        LONGS_EQUAL(0, uv_loop_init(&loop));
+    }
+
+    void teardown() {
+        LONGS_EQUAL(0, uv_loop_close(&loop));
+    }
+};
+
+TEST(uring_udp_io, open_close) {
+    address::SocketAddr addr;
+    const int fd = open_socket(addr);
+
+    {
+        TestHandler handler;
+        UringUdpIo io(handler, loop, packet_factory);
+
+        if (io.open(fd, addr)) {
+            CHECK(io.is_open());
+            CHECK(io.start_recv());
+
+            close_io(loop, io, handler);
+        } else {
+            // Not supported by running kernel, caller falls back to libuv.
+            CHECK(!io.is_open());
+        }
+    }
+
+    CHECK(close(fd) == 0);
+}
+
+TEST(uring_udp_io, send) {
+    address::SocketAddr tx_addr, rx_addr;
+    const int tx_fd = open_socket(tx_addr);
+    const int rx_fd = open_socket(rx_addr);
+
+    {
+        TestHandler handler;
+        UringUdpIo io(handler, loop, packet_factory);
+
+        if (io.open(tx_fd, tx_addr)) {
+            const core::nanoseconds_t deadline =
+                core::timestamp(core::ClockMonotonic) + Timeout;
+
+            for (int n = 0; n < NumPackets; n++) {
+                CHECK(io.enqueue_send(new_packet(rx_addr, n)));
+            }
+            io.flush();
+
+            while (handler.n_sent < NumPackets) {
+                run_loop(loop, deadline);
+            }
+
+            LONGS_EQUAL(0, handler.n_send_errors);
+
+            for (int n = 0; n < NumPackets; n++) {
+                uint8_t expected[BufferSize];
+                fill_datagram(expected, n);
+
+                uint8_t actual[BufferSize + 1];
+                LONGS_EQUAL(BufferSize, recv(rx_fd, actual, sizeof(actual), 0));
+                CHECK(memcmp(expected, actual, BufferSize) == 0);
+            }
+
+            close_io(loop, io, handler);
+        }
+    }
+
+    CHECK(close(tx_fd) == 0);
+    CHECK(close(rx_fd) == 0);
+}
+
+TEST(uring_udp_io, recv) {
+    address::SocketAddr tx_addr, rx_addr;
+    const int tx_fd = open_socket(tx_addr);
+    const int rx_fd = open_socket(rx_addr);
+
+    {
+        TestHandler handler;
+        handler.expected_src = tx_addr;
+
+        UringUdpIo io(handler, loop, packet_factory);
+
+        if (io.open(rx_fd, rx_addr)) {
+            const core::nanoseconds_t deadline =
+                core::timestamp(core::ClockMonotonic) + Timeout;
+
+            CHECK(io.start_recv());
+
+            send_datagrams(tx_fd, rx_addr, 0, NumPackets);
+
+            while (handler.n_received < NumPackets) {
+                run_loop(loop, deadline);
+            }
+
+            LONGS_EQUAL(0, handler.n_recv_failed);
+
+            close_io(loop, io, handler);
+        }
+    }
+
+    CHECK(close(tx_fd) == 0);
+    CHECK(close(rx_fd) == 0);
+}
+
+// Receiver runs out of pool buffers, kernel terminates multishot request
+// with ENOBUFS, and there are no more completions to wake up receiver.
+// When buffers are returned to pool, receiving should resume by itself.
+TEST(uring_udp_io, recv_pool_exhausted) {
+    enum { MaxBuffers = NumPackets * 3 / 4 };
+
+    core::MemoryLimiter limiter("limiter", MaxBuffers * buffer_pool.allocation_size());
+    core::LimitedPool limited_buffer_pool(buffer_pool, limiter);
+    packet::PacketFactory limited_packet_factory(packet_pool, limited_buffer_pool);
+
+    address::SocketAddr tx_addr, rx_addr;
+    const int tx_fd = open_socket(tx_addr);
+    const int rx_fd = open_socket(rx_addr);
+
+    {
+        TestHandler handler;
+        handler.expected_src = tx_addr;
+        handler.hold = true;
+
+        UringUdpIo io(handler, loop, limited_packet_factory);
+
+        if (io.open(rx_fd, rx_addr)) {
+            const core::nanoseconds_t deadline =
+                core::timestamp(core::ClockMonotonic) + Timeout;
+
+            CHECK(io.start_recv());
+
+            send_datagrams(tx_fd, rx_addr, 0, NumPackets);
+
+            // All pool buffers are held by handler.
+            while (handler.n_received < MaxBuffers) {
+                run_loop(loop, deadline);
+            }
+
+            for (int n = 0; n < 100; n++) {
+                run_loop(loop, deadline);
+            }
+
+            LONGS_EQUAL(MaxBuffers, handler.n_received);
+
+            // Return buffers to pool, remaining datagrams are still
+            // queued in socket.
+            handler.hold = false;
+            handler.release_held();
+
+            while (handler.n_received < NumPackets) {
+                run_loop(loop, deadline);
+            }
+
+            LONGS_EQUAL(0, handler.n_recv_failed);
+
+            close_io(loop, io, handler);
+        }
+    }
+
+    CHECK(close(tx_fd) == 0);
+    CHECK(close(rx_fd) == 0);
+}
+
+} // namespace netio
+} // namespace roc
@@ -50,5 +50,66 @@ TEST(context, reference_counting) {
     CHECK(context.getref() == 0);
 }
 
+TEST(context, pinned_memory) {
+    ContextConfig context_config;
+    context_config.pinned_memory_size = 1024 * 1024;
+
+    Context context(context_config, arena);
+    CHECK(context.is_valid());
+
+    const size_t num_allocs = arena.num_allocations();
+
+    void* packet = context.packet_pool().allocate();
+    void* buffer = context.packet_buffer_pool().allocate();
+    CHECK(packet);
+    CHECK(buffer);
+
+    // pools don't use context arena
+    UNSIGNED_LONGS_EQUAL(num_allocs, arena.num_allocations());
+
+    context.packet_pool().deallocate(packet);
+    context.packet_buffer_pool().deallocate(buffer);
+}
+
+TEST(context, memory_limits) {
+    ContextConfig context_config;
+    context_config.max_packet_memory = 1;
+
+    Context context(context_config, arena);
+    CHECK(context.is_valid());
+
+    // packet memory limit is exceeded
+    CHECK(!context.packet_pool().allocate());
+    CHECK(!context.packet_buffer_pool().allocate());
+
+    // frame and arena memory are not limited
+    void* buffer = context.frame_buffer_pool().allocate();
+    CHECK(buffer);
+
+    void* chunk = context.arena().allocate(100);
+    CHECK(chunk);
+
+    MetricsCollector collector(arena);
+    CHECK(context.collect_metrics(collector));
+
+    UNSIGNED_LONGS_EQUAL(3, collector.num_memory());
+
+    STRCMP_EQUAL("arena", collector.memory(0).name);
+    CHECK(collector.memory(0).acquired_bytes >= 100);
+    UNSIGNED_LONGS_EQUAL(0, collector.memory(0).limit_bytes);
+
+    STRCMP_EQUAL("packet", collector.memory(1).name);
+    UNSIGNED_LONGS_EQUAL(0, collector.memory(1).acquired_bytes);
+    UNSIGNED_LONGS_EQUAL(1, collector.memory(1).limit_bytes);
+
+    STRCMP_EQUAL("frame", collector.memory(2).name);
+    UNSIGNED_LONGS_EQUAL(context.frame_buffer_pool().allocation_size(),
+                         collector.memory(2).acquired_bytes);
+    UNSIGNED_LONGS_EQUAL(0, collector.memory(2).limit_bytes);
+
+    context.frame_buffer_pool().deallocate(buffer);
+    context.arena().deallocate(chunk);
+}
+
 } // namespace node
 } // namespace roc
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_arena.h"
+#include "roc_core/string_buffer.h"
+#include "roc_core/temp_file.h"
+#include "roc_core/time.h"
+#include "roc_node/context.h"
+#include "roc_node/receiver_decoder.h"
+#include "roc_node/sender_encoder.h"
+
+namespace roc {
+namespace node {
+
+namespace {
+
+core::HeapArena arena;
+
+size_t count_lines(const char* text, const char* prefix) {
+    size_t count = 0;
+    const size_t prefix_len = strlen(prefix);
+
+    for (const char* line = text; line && *line;) {
+        if (strncmp(line, prefix, prefix_len) == 0) {
+            count++;
+        }
+        line = strchr(line, '\n');
+        if (line) {
+            line++;
+        }
+    }
+
+    return count;
+}
+
+bool ends_with(const char* text, const char* suffix) {
+    const size_t text_len = strlen(text);
+    const size_t suffix_len = strlen(suffix);
+
+    return text_len >= suffix_len
+        && strcmp(text + text_len - suffix_len, suffix) == 0;
+}
+
+bool read_file(const char* path, char* buf, size_t bufsz) {
+    FILE* fp = fopen(path, "r");
+    if (!fp) {
+        return false;
+    }
+    const size_t n = fread(buf, 1, bufsz - 1, fp);
+    buf[n] = '\0';
+    fclose(fp);
+    return true;
+}
+
+} // namespace
+
+TEST_GROUP(metrics_exporter) {
+    ContextConfig context_config;
+    pipeline::SenderSinkConfig sender_config;
+    pipeline::ReceiverSourceConfig receiver_config;
+};
+
+TEST(metrics_exporter, no_nodes) {
+    Context context(context_config, arena);
+    CHECK(context.is_valid());
+
+    core::StringBuffer buf(arena);
+    CHECK(context.metrics_exporter().render(buf));
+
+    // pools are always present
+    LONGS_EQUAL(1, count_lines(buf.c_str(), "# TYPE roc_pool_used_objects gauge\n"));
+    LONGS_EQUAL(3, count_lines(buf.c_str(), "roc_pool_used_objects{"));
+    LONGS_EQUAL(1,
+                count_lines(buf.c_str(), "roc_pool_used_objects{pool=\"packet_pool\"}"));
+
+    // memory limiters are always present
+    LONGS_EQUAL(1, count_lines(buf.c_str(), "# TYPE roc_memory_acquired_bytes gauge\n"));
+    LONGS_EQUAL(3, count_lines(buf.c_str(), "roc_memory_acquired_bytes{"));
+    LONGS_EQUAL(1,
+                count_lines(buf.c_str(), "roc_memory_limit_bytes{memory=\"packet\"} 0"));
+
+    // families are present, but without samples
+    LONGS_EQUAL(1, count_lines(buf.c_str(), "# TYPE roc_pipeline_tasks counter\n"));
+    LONGS_EQUAL(0, count_lines(buf.c_str(), "roc_pipeline_tasks_total{"));
+    LONGS_EQUAL(0, count_lines(buf.c_str(), "roc_slot_connections{"));
+
+    CHECK(ends_with(buf.c_str(), "\n# EOF\n"));
+}
+
+TEST(metrics_exporter, nodes) {
+    Context context(context_config, arena);
+    CHECK(context.is_valid());
+
+    core::StringBuffer buf(arena);
+
+    {
+        SenderEncoder sender(context, sender_config);
+        CHECK(sender.is_valid());
+
+        ReceiverDecoder receiver(context, receiver_config);
+        CHECK(receiver.is_valid());
+
+        CHECK(sender.id() != receiver.id());
+
+        CHECK(context.metrics_exporter().render(buf));
+
+        LONGS_EQUAL(2, count_lines(buf.c_str(), "roc_pipeline_tasks_total{"));
+        LONGS_EQUAL(2, count_lines(buf.c_str(), "roc_slot_connections{"));
+        LONGS_EQUAL(2, count_lines(buf.c_str(), "roc_slot_frame_processing_seconds{"));
+
+        // sender-only families
+        LONGS_EQUAL(1, count_lines(buf.c_str(),
+                                   "roc_slot_pacing_queue_depth{node=\"sender_encoder\""));
+        LONGS_EQUAL(0, count_lines(buf.c_str(),
+                                   "roc_slot_pacing_queue_depth{node=\"receiver_decoder\""));
+
+        // receiver-only families
+        LONGS_EQUAL(1, count_lines(buf.c_str(), "roc_slot_admitted_sessions_total{"
+                                                "node=\"receiver_decoder\""));
+        LONGS_EQUAL(0, count_lines(buf.c_str(), "roc_slot_admitted_sessions_total{"
+                                                "node=\"sender_encoder\""));
+        LONGS_EQUAL(1, count_lines(buf.c_str(), "roc_slot_rejected_sessions_total{"));
+        LONGS_EQUAL(1, count_lines(buf.c_str(), "roc_slot_shed_sessions_total{"));
+
+        // labels identify node and slot
+        char prefix[128];
+        snprintf(prefix, sizeof(prefix),
+                 "roc_slot_connections{node=\"receiver_decoder\",node_id=\"%llu\","
+                 "slot=\"0\"}",
+                 (unsigned long long)receiver.id());
+        LONGS_EQUAL(1, count_lines(buf.c_str(), prefix));
+
+        // metadata precedes samples of each family
+        const char* type = strstr(buf.c_str(), "# TYPE roc_slot_connections gauge\n");
+        const char* sample = strstr(buf.c_str(), "roc_slot_connections{");
+        CHECK(type);
+        CHECK(sample);
+        CHECK(type < sample);
+
+        CHECK(ends_with(buf.c_str(), "\n# EOF\n"));
+    }
+
+    // destroyed nodes are unregistered
+    CHECK(context.metrics_exporter().render(buf));
+
+    LONGS_EQUAL(0, count_lines(buf.c_str(), "roc_pipeline_tasks_total{"));
+    LONGS_EQUAL(0, count_lines(buf.c_str(), "roc_slot_connections{"));
+}
+
+TEST(metrics_exporter, write_file) {
+    core::TempFile file("metrics.txt");
+
+    context_config.metrics_exporter.file_path = file.path();
+    context_config.metrics_exporter.interval = core::Millisecond;
+
+    Context context(context_config, arena);
+    CHECK(context.is_valid());
+
+    ReceiverDecoder receiver(context, receiver_config);
+    CHECK(receiver.is_valid());
+
+    char buf[16384];
+
+    // wait until file is written after receiver was registered
+    for (;;) {
+        if (read_file(file.path(), buf, sizeof(buf))
+            && count_lines(buf, "roc_slot_connections{") == 1) {
+            break;
+        }
+        core::sleep_for(core::ClockMonotonic, core::Millisecond);
+    }
+
+    // file is always replaced atomically
+    CHECK(ends_with(buf, "\n# EOF\n"));
+}
+
+} // namespace node
+} // namespace roc
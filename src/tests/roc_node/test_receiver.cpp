@@ -784,5 +784,176 @@ TEST(receiver, metrics) {
     LONGS_EQUAL(0, party_count);
 }
 
+TEST(receiver, shared_multicast) {
+    netio::UdpConfig iface_config;
+    strcpy(iface_config.multicast_interface, "0.0.0.0");
+
+    { // sharing disabled
+        Context context(context_config, arena);
+        CHECK(context.is_valid());
+
+        Receiver receiver1(context, receiver_config);
+        CHECK(receiver1.is_valid());
+        Receiver receiver2(context, receiver_config);
+        CHECK(receiver2.is_valid());
+
+        address::EndpointUri source_endp1(arena);
+        parse_uri(source_endp1, "rtp://224.0.0.1:0");
+
+        CHECK(receiver1.configure(DefaultSlot, address::Iface_AudioSource, iface_config));
+        CHECK(receiver1.bind(DefaultSlot, address::Iface_AudioSource, source_endp1));
+
+        address::EndpointUri source_endp2(arena);
+        parse_uri(source_endp2, "rtp://224.0.0.1:0");
+
+        CHECK(receiver2.configure(DefaultSlot, address::Iface_AudioSource, iface_config));
+        CHECK(receiver2.bind(DefaultSlot, address::Iface_AudioSource, source_endp2));
+
+        LONGS_EQUAL(0, context.num_shared_receivers());
+        LONGS_EQUAL(2, context.network_loop().num_ports());
+    }
+    { // same endpoint
+        context_config.enable_shared_multicast = true;
+
+        Context context(context_config, arena);
+        CHECK(context.is_valid());
+
+        Receiver receiver1(context, receiver_config);
+        CHECK(receiver1.is_valid());
+        Receiver receiver2(context, receiver_config);
+        CHECK(receiver2.is_valid());
+
+        address::EndpointUri source_endp1(arena);
+        parse_uri(source_endp1, "rtp://224.0.0.1:0");
+
+        CHECK(receiver1.configure(DefaultSlot, address::Iface_AudioSource, iface_config));
+        CHECK(receiver1.bind(DefaultSlot, address::Iface_AudioSource, source_endp1));
+        CHECK(source_endp1.port() != 0);
+
+        address::EndpointUri source_endp2(arena);
+        parse_uri(source_endp2, "rtp://224.0.0.1:0");
+
+        CHECK(receiver2.configure(DefaultSlot, address::Iface_AudioSource, iface_config));
+        CHECK(receiver2.bind(DefaultSlot, address::Iface_AudioSource, source_endp2));
+        LONGS_EQUAL(source_endp1.port(), source_endp2.port());
+
+        LONGS_EQUAL(1, context.num_shared_receivers());
+        LONGS_EQUAL(1, context.network_loop().num_ports());
+
+        // both receivers read from shared stream
+        const size_t frame_size = receiver_config.common.output_sample_spec
+                                      .ns_2_samples_overall(core::Millisecond * 10);
+        audio::sample_t samples[4096];
+        CHECK(frame_size <= ROC_ARRAY_SIZE(samples));
+
+        for (size_t n = 0; n < 10; n++) {
+            audio::Frame frame1(samples, frame_size);
+            CHECK(receiver1.source().read(frame1));
+
+            audio::Frame frame2(samples, frame_size);
+            CHECK(receiver2.source().read(frame2));
+        }
+
+        pipeline::ReceiverSlotMetrics slot_metrics;
+        pipeline::ReceiverParticipantMetrics party_metrics[10];
+        size_t party_count = ROC_ARRAY_SIZE(party_metrics);
+        CHECK(receiver2.get_metrics(DefaultSlot, write_slot_metrics, &slot_metrics,
+                                    write_party_metrics, &party_count,
+                                    &party_metrics));
+        LONGS_EQUAL(0, party_count);
+
+        CHECK(receiver1.unlink(DefaultSlot));
+
+        LONGS_EQUAL(1, context.num_shared_receivers());
+        LONGS_EQUAL(1, context.network_loop().num_ports());
+
+        CHECK(receiver2.unlink(DefaultSlot));
+
+        LONGS_EQUAL(0, context.num_shared_receivers());
+        LONGS_EQUAL(0, context.network_loop().num_ports());
+    }
+    { // different endpoints
+        context_config.enable_shared_multicast = true;
+
+        Context context(context_config, arena);
+        CHECK(context.is_valid());
+
+        Receiver receiver1(context, receiver_config);
+        CHECK(receiver1.is_valid());
+        Receiver receiver2(context, receiver_config);
+        CHECK(receiver2.is_valid());
+
+        address::EndpointUri source_endp1(arena);
+        parse_uri(source_endp1, "rtp://224.0.0.1:0");
+
+        CHECK(receiver1.configure(DefaultSlot, address::Iface_AudioSource, iface_config));
+        CHECK(receiver1.bind(DefaultSlot, address::Iface_AudioSource, source_endp1));
+
+        address::EndpointUri source_endp2(arena);
+        parse_uri(source_endp2, "rtp://224.0.0.2:0");
+
+        CHECK(receiver2.configure(DefaultSlot, address::Iface_AudioSource, iface_config));
+        CHECK(receiver2.bind(DefaultSlot, address::Iface_AudioSource, source_endp2));
+
+        LONGS_EQUAL(2, context.num_shared_receivers());
+        LONGS_EQUAL(2, context.network_loop().num_ports());
+    }
+    { // incompatible configs
+        context_config.enable_shared_multicast = true;
+
+        Context context(context_config, arena);
+        CHECK(context.is_valid());
+
+        pipeline::ReceiverSourceConfig receiver_config2 = receiver_config;
+        receiver_config2.session_defaults.latency.target_latency =
+            123 * core::Millisecond;
+
+        Receiver receiver1(context, receiver_config);
+        CHECK(receiver1.is_valid());
+        Receiver receiver2(context, receiver_config2);
+        CHECK(receiver2.is_valid());
+
+        address::EndpointUri source_endp1(arena);
+        parse_uri(source_endp1, "rtp://224.0.0.1:0");
+
+        CHECK(receiver1.configure(DefaultSlot, address::Iface_AudioSource, iface_config));
+        CHECK(receiver1.bind(DefaultSlot, address::Iface_AudioSource, source_endp1));
+
+        address::EndpointUri source_endp2(arena);
+        parse_uri(source_endp2, "rtp://224.0.0.1:0");
+
+        // can't share stream with different latency
+        CHECK(receiver2.configure(DefaultSlot, address::Iface_AudioSource, iface_config));
+        CHECK(!receiver2.bind(DefaultSlot, address::Iface_AudioSource, source_endp2));
+
+        LONGS_EQUAL(1, context.num_shared_receivers());
+        LONGS_EQUAL(1, context.network_loop().num_ports());
+    }
+    { // shared and non-shared endpoints in one receiver
+        context_config.enable_shared_multicast = true;
+
+        Context context(context_config, arena);
+        CHECK(context.is_valid());
+
+        Receiver receiver(context, receiver_config);
+        CHECK(receiver.is_valid());
+
+        address::EndpointUri source_endp1(arena);
+        parse_uri(source_endp1, "rtp://224.0.0.1:0");
+
+        CHECK(receiver.configure(0, address::Iface_AudioSource, iface_config));
+        CHECK(receiver.bind(0, address::Iface_AudioSource, source_endp1));
+
+        address::EndpointUri source_endp2(arena);
+        parse_uri(source_endp2, "rtp://127.0.0.1:0");
+
+        CHECK(!receiver.bind(1, address::Iface_AudioSource, source_endp2));
+        CHECK(receiver.has_broken());
+
+        LONGS_EQUAL(1, context.num_shared_receivers());
+        LONGS_EQUAL(1, context.network_loop().num_ports());
+    }
+}
+
 } // namespace node
 } // namespace roc
@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_arena.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/time.h"
+#include "roc_packet/pacer.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/queue.h"
+
+namespace roc {
+namespace packet {
+
+namespace {
+
+enum { MaxBufSize = 100, PacketSize = 100 };
+
+const core::nanoseconds_t PacketLength = 10 * core::Millisecond;
+
+core::HeapArena arena;
+PacketFactory packet_factory(arena, MaxBufSize);
+
+PacketPtr new_packet(unsigned flags) {
+    PacketPtr packet = packet_factory.new_packet();
+    CHECK(packet);
+
+    packet->add_flags(Packet::FlagUDP | flags);
+
+    core::Slice<uint8_t> buffer = packet_factory.new_packet_buffer();
+    CHECK(buffer);
+    buffer.reslice(0, PacketSize);
+    packet->set_buffer(buffer);
+
+    return packet;
+}
+
+class MockWriter : public IWriter, public core::NonCopyable<> {
+public:
+    explicit MockWriter(status::StatusCode code)
+        : code_(code) {
+    }
+
+    virtual ROC_ATTR_NODISCARD status::StatusCode write(const PacketPtr&) {
+        return code_;
+    }
+
+private:
+    status::StatusCode code_;
+};
+
+} // namespace
+
+TEST_GROUP(pacer) {};
+
+TEST(pacer, invalid_config) {
+    Queue queue;
+    PacerConfig config;
+
+    {
+        Pacer pacer(queue, config, 0, 10, 0);
+        CHECK(!pacer.is_valid());
+    }
+    {
+        Pacer pacer(queue, config, PacketLength, 0, 0);
+        CHECK(!pacer.is_valid());
+    }
+    {
+        Pacer pacer(queue, config, PacketLength, 10, 0);
+        CHECK(pacer.is_valid());
+    }
+}
+
+TEST(pacer, rate_limit) {
+    enum { NumPackets = 5 };
+
+    Queue queue;
+    PacerConfig config;
+    config.rate = 1000; // 100 bytes per 100ms
+    config.burst = 100 * core::Millisecond;
+
+    Pacer pacer(queue, config, PacketLength, 10, 0);
+    CHECK(pacer.is_valid());
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        LONGS_EQUAL(status::StatusOK, pacer.write(new_packet(Packet::FlagAudio)));
+    }
+
+    // nothing is sent until refresh
+    UNSIGNED_LONGS_EQUAL(0, queue.size());
+    UNSIGNED_LONGS_EQUAL(NumPackets, pacer.metrics().queue_depth);
+
+    const core::nanoseconds_t start = core::timestamp(core::ClockUnix);
+
+    // bucket is full initially, one packet fits
+    LONGS_EQUAL(status::StatusOK, pacer.refresh(start));
+    UNSIGNED_LONGS_EQUAL(1, queue.size());
+    UNSIGNED_LONGS_EQUAL(NumPackets - 1, pacer.metrics().queue_depth);
+
+    // bucket is empty, next packet is due in 100ms
+    CHECK(pacer.refresh_deadline() > start + 99 * core::Millisecond);
+    CHECK(pacer.refresh_deadline() <= start + 101 * core::Millisecond);
+
+    LONGS_EQUAL(status::StatusOK, pacer.refresh(start + 50 * core::Millisecond));
+    UNSIGNED_LONGS_EQUAL(1, queue.size());
+
+    for (size_t n = 2; n <= NumPackets; n++) {
+        LONGS_EQUAL(status::StatusOK,
+                    pacer.refresh(start + (core::nanoseconds_t)(n - 1) * 101
+                                      * core::Millisecond));
+        UNSIGNED_LONGS_EQUAL(n, queue.size());
+        UNSIGNED_LONGS_EQUAL(NumPackets - n, pacer.metrics().queue_depth);
+    }
+
+    LONGS_EQUAL(0, pacer.refresh_deadline());
+}
+
+TEST(pacer, derived_rate) {
+    enum { NumPackets = 3 };
+
+    Queue queue;
+    PacerConfig config;
+
+    Pacer pacer(queue, config, PacketLength, 10, 0);
+    CHECK(pacer.is_valid());
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        LONGS_EQUAL(status::StatusOK, pacer.write(new_packet(Packet::FlagAudio)));
+    }
+
+    const core::nanoseconds_t start = core::timestamp(core::ClockUnix);
+
+    // rate is derived from packet length, so that one packet is sent
+    // per packet length, with some headroom
+    LONGS_EQUAL(status::StatusOK, pacer.refresh(start));
+    UNSIGNED_LONGS_EQUAL(1, queue.size());
+
+    LONGS_EQUAL(status::StatusOK, pacer.refresh(start + PacketLength / 4));
+    UNSIGNED_LONGS_EQUAL(1, queue.size());
+
+    LONGS_EQUAL(status::StatusOK, pacer.refresh(start + PacketLength));
+    UNSIGNED_LONGS_EQUAL(2, queue.size());
+
+    LONGS_EQUAL(status::StatusOK, pacer.refresh(start + PacketLength * 2));
+    UNSIGNED_LONGS_EQUAL(3, queue.size());
+}
+
+TEST(pacer, derived_rate_repair) {
+    enum { NumSource = 10, NumRepair = 5 };
+
+    const core::nanoseconds_t RepairInterval = PacketLength * NumSource / NumRepair;
+
+    Queue queue;
+    PacerConfig config;
+
+    Pacer pacer(queue, config, PacketLength, NumSource, NumRepair);
+    CHECK(pacer.is_valid());
+
+    for (size_t n = 0; n < NumRepair; n++) {
+        LONGS_EQUAL(status::StatusOK, pacer.write(new_packet(Packet::FlagRepair)));
+    }
+
+    const core::nanoseconds_t start = core::timestamp(core::ClockUnix);
+
+    // rate is derived from source stream rate and scaled by ratio of repair
+    // and source packets, so it doesn't delay repair packets beyond the
+    // repair interval
+    for (size_t n = 1; n <= NumRepair; n++) {
+        const core::nanoseconds_t send_time =
+            start + RepairInterval * (core::nanoseconds_t)(n - 1);
+
+        if (n > 1) {
+            LONGS_EQUAL(send_time, pacer.refresh_deadline());
+        }
+
+        LONGS_EQUAL(status::StatusOK, pacer.refresh(send_time));
+        UNSIGNED_LONGS_EQUAL(n, queue.size());
+    }
+
+    LONGS_EQUAL(0, pacer.refresh_deadline());
+}
+
+TEST(pacer, spread_repair) {
+    enum { NumSource = 10, NumRepair = 5 };
+
+    // repair interval = block duration / number of repair packets
+    const core::nanoseconds_t RepairInterval = PacketLength * NumSource / NumRepair;
+
+    Queue queue;
+    PacerConfig config;
+    config.rate = 1000000000;
+
+    Pacer pacer(queue, config, PacketLength, NumSource, NumRepair);
+    CHECK(pacer.is_valid());
+
+    for (size_t n = 0; n < NumRepair; n++) {
+        LONGS_EQUAL(status::StatusOK, pacer.write(new_packet(Packet::FlagRepair)));
+    }
+
+    const core::nanoseconds_t start = core::timestamp(core::ClockUnix);
+
+    for (size_t n = 1; n <= NumRepair; n++) {
+        const core::nanoseconds_t send_time =
+            start + RepairInterval * (core::nanoseconds_t)(n - 1);
+
+        if (n > 1) {
+            // not yet
+            LONGS_EQUAL(status::StatusOK,
+                        pacer.refresh(send_time - RepairInterval / 2));
+            UNSIGNED_LONGS_EQUAL(n - 1, queue.size());
+
+            LONGS_EQUAL(send_time, pacer.refresh_deadline());
+        }
+
+        LONGS_EQUAL(status::StatusOK, pacer.refresh(send_time));
+        UNSIGNED_LONGS_EQUAL(n, queue.size());
+        UNSIGNED_LONGS_EQUAL(NumRepair - n, pacer.metrics().queue_depth);
+
+        CHECK(pacer.metrics().pacing_delay >= 0);
+        CHECK(pacer.metrics().pacing_delay <= send_time - start + core::Second);
+    }
+}
+
+TEST(pacer, source_not_spread) {
+    enum { NumSource = 10, NumRepair = 5 };
+
+    Queue queue;
+    PacerConfig config;
+    config.rate = 1000000000;
+
+    Pacer pacer(queue, config, PacketLength, NumSource, NumRepair);
+    CHECK(pacer.is_valid());
+
+    for (size_t n = 0; n < NumSource; n++) {
+        LONGS_EQUAL(status::StatusOK, pacer.write(new_packet(Packet::FlagAudio)));
+    }
+
+    // source packets are limited only by rate
+    LONGS_EQUAL(status::StatusOK, pacer.refresh(core::timestamp(core::ClockUnix)));
+    UNSIGNED_LONGS_EQUAL(NumSource, queue.size());
+    UNSIGNED_LONGS_EQUAL(0, pacer.metrics().queue_depth);
+}
+
+TEST(pacer, flush) {
+    enum { NumSource = 10, NumRepair = 5 };
+
+    Queue queue;
+    PacerConfig config;
+
+    Pacer pacer(queue, config, PacketLength, NumSource, NumRepair);
+    CHECK(pacer.is_valid());
+
+    for (size_t n = 0; n < NumRepair; n++) {
+        LONGS_EQUAL(status::StatusOK, pacer.write(new_packet(Packet::FlagRepair)));
+    }
+
+    const core::nanoseconds_t start = core::timestamp(core::ClockUnix);
+
+    LONGS_EQUAL(status::StatusOK, pacer.refresh(start));
+    UNSIGNED_LONGS_EQUAL(1, queue.size());
+    CHECK(pacer.refresh_deadline() > start);
+
+    // all queued packets are sent regardless of rate and repair interval
+    LONGS_EQUAL(status::StatusOK, pacer.flush(start));
+    UNSIGNED_LONGS_EQUAL(NumRepair, queue.size());
+    UNSIGNED_LONGS_EQUAL(0, pacer.metrics().queue_depth);
+    LONGS_EQUAL(0, pacer.refresh_deadline());
+}
+
+TEST(pacer, forward_error) {
+    const status::StatusCode codes[] = {
+        status::StatusUnknown,
+        status::StatusNoData,
+    };
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(codes); n++) {
+        MockWriter writer(codes[n]);
+        PacerConfig config;
+
+        Pacer pacer(writer, config, PacketLength, 10, 0);
+        CHECK(pacer.is_valid());
+
+        LONGS_EQUAL(status::StatusOK, pacer.write(new_packet(Packet::FlagAudio)));
+        LONGS_EQUAL(codes[n], pacer.refresh(core::timestamp(core::ClockUnix)));
+    }
+}
+
+} // namespace packet
+} // namespace roc
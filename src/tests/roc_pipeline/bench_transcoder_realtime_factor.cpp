@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/null_writer.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/slab_pool.h"
+#include "roc_core/time.h"
+#include "roc_pipeline/transcoder_sink.h"
+
+namespace roc {
+namespace pipeline {
+namespace {
+
+// Measures how much faster than realtime TranscoderSink converts audio,
+// when used like roc-copy in batch mode (large frames, resampling).
+//
+// Arguments:
+//  - number of channels
+//  - number of resampling threads
+//
+// Reported counters:
+//  - rtf - realtime factor, seconds of audio processed per second of wall time
+
+enum { InRate = 44100, OutRate = 48000 };
+
+const core::nanoseconds_t FrameLength = 500 * core::Millisecond;
+
+core::HeapArena arena;
+
+audio::SincTableMap sinc_table_map(arena);
+
+void BM_TranscoderSink_RealtimeFactor(benchmark::State& state) {
+    const size_t num_chans = (size_t)state.range(0);
+    const size_t num_threads = (size_t)state.range(1);
+
+    audio::ChannelSet chans;
+    chans.set_layout(audio::ChanLayout_Multitrack);
+    chans.set_order(audio::ChanOrder_None);
+    chans.set_count(num_chans);
+
+    TranscoderConfig config;
+    config.input_sample_spec = audio::SampleSpec(InRate, audio::Sample_RawFormat, chans);
+    config.output_sample_spec =
+        audio::SampleSpec(OutRate, audio::Sample_RawFormat, chans);
+    config.resampler.backend = audio::ResamplerBackend_Builtin;
+    config.resampler.profile = audio::ResamplerProfile_Medium;
+    config.num_threads = num_threads;
+
+    const size_t frame_size = config.input_sample_spec.ns_2_samples_overall(FrameLength);
+
+    core::SlabPool<core::Buffer> buffer_pool(
+        "buffer_pool", arena,
+        sizeof(core::Buffer) + frame_size * 2 * sizeof(audio::sample_t));
+
+    audio::NullWriter null_writer;
+
+    TranscoderSink transcoder(config, &null_writer, sinc_table_map, buffer_pool, arena);
+    if (!transcoder.is_valid()) {
+        state.SkipWithError("can't create transcoder");
+        return;
+    }
+
+    audio::sample_t* samples =
+        (audio::sample_t*)arena.allocate(frame_size * sizeof(audio::sample_t));
+    for (size_t n = 0; n < frame_size; n++) {
+        samples[n] = audio::sample_t(n % 1000) / 1000.0f - 0.5f;
+    }
+
+    double audio_secs = 0;
+
+    while (state.KeepRunning()) {
+        audio::Frame frame(samples, frame_size);
+        transcoder.write(frame);
+
+        audio_secs += (double)FrameLength / core::Second;
+    }
+
+    state.counters["rtf"] = benchmark::Counter(audio_secs, benchmark::Counter::kIsRate);
+
+    arena.deallocate(samples);
+}
+
+BENCHMARK(BM_TranscoderSink_RealtimeFactor)
+    ->ArgNames({ "chans", "threads" })
+    ->Args({ 2, 1 })
+    ->Args({ 2, 2 })
+    ->Args({ 8, 1 })
+    ->Args({ 8, 2 })
+    ->Args({ 8, 4 })
+    ->Args({ 8, 8 })
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace pipeline
+} // namespace roc
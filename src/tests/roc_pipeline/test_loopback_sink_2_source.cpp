@@ -53,6 +53,9 @@ const audio::ChannelMask Chans_Stereo = audio::ChanMask_Surround_Stereo;
 const rtp::PayloadType PayloadType_Ch1 = rtp::PayloadType_L16_Mono;
 const rtp::PayloadType PayloadType_Ch2 = rtp::PayloadType_L16_Stereo;
 
+const rtp::PayloadType PayloadType_Lossless_Ch1 = (rtp::PayloadType)100;
+const rtp::PayloadType PayloadType_Lossless_Ch2 = (rtp::PayloadType)101;
+
 enum {
     MaxBufSize = 500,
 
@@ -98,7 +101,10 @@ enum {
     FlagRTCP = (1 << 6),
 
     // enable capture timestamps
-    FlagCTS = (1 << 7)
+    FlagCTS = (1 << 7),
+
+    // use lossless encoding instead of PCM
+    FlagLossless = (1 << 8)
 };
 
 core::HeapArena arena;
@@ -115,6 +121,7 @@ packet::PacketFactory packet_factory(packet_pool, packet_buffer_pool);
 audio::FrameFactory frame_factory(frame_buffer_pool);
 
 rtp::EncodingMap encoding_map(arena);
+audio::SincTableMap sinc_table_map(arena);
 
 // Copy sequence of packets to multiple writers.
 // Routes packet by type.
@@ -235,6 +242,26 @@ private:
     size_t counter_;
 };
 
+rtp::PayloadType register_lossless_encoding(audio::ChannelMask channels) {
+    const rtp::PayloadType pt =
+        channels == Chans_Mono ? PayloadType_Lossless_Ch1 : PayloadType_Lossless_Ch2;
+
+    if (!encoding_map.find_by_pt(pt)) {
+        rtp::Encoding enc;
+        enc.payload_type = pt;
+        enc.packet_flags = packet::Packet::FlagAudio;
+        enc.sample_spec.set_sample_rate(SampleRate);
+        enc.sample_spec.set_sample_format(audio::SampleFormat_Lossless);
+        enc.sample_spec.channel_set().set_layout(audio::ChanLayout_Surround);
+        enc.sample_spec.channel_set().set_order(audio::ChanOrder_Smpte);
+        enc.sample_spec.channel_set().set_mask(channels);
+
+        CHECK(encoding_map.add_encoding(enc));
+    }
+
+    return pt;
+}
+
 SenderSinkConfig make_sender_config(int flags,
                                     audio::ChannelMask frame_channels,
                                     audio::ChannelMask packet_channels) {
@@ -258,6 +285,10 @@ SenderSinkConfig make_sender_config(int flags,
         FAIL("unsupported packet_sample_spec");
     }
 
+    if (flags & FlagLossless) {
+        config.payload_type = register_lossless_encoding(packet_channels);
+    }
+
     config.packet_length = SamplesPerPacket * core::Second / SampleRate;
 
     if (flags & FlagReedSolomon) {
@@ -379,10 +410,15 @@ void check_metrics(ReceiverSlot& receiver, SenderSlot& sender, int flags) {
 
     CHECK(send_metrics.source_id > 0);
 
+    // Participants are identified by remote source ID.
+    UNSIGNED_LONGS_EQUAL(send_metrics.source_id, recv_party_metrics.source_id);
+
     if (flags & FlagRTCP) {
         UNSIGNED_LONGS_EQUAL(1, send_metrics.num_participants);
         UNSIGNED_LONGS_EQUAL(1, send_party_count);
 
+        UNSIGNED_LONGS_EQUAL(recv_metrics.source_id, send_party_metrics.source_id);
+
         UNSIGNED_LONGS_EQUAL(recv_party_metrics.link.ext_first_seqnum,
                              send_party_metrics.link.ext_first_seqnum);
         CHECK(packet::seqnum_diff(recv_party_metrics.link.ext_last_seqnum,
@@ -405,6 +441,16 @@ void check_metrics(ReceiverSlot& receiver, SenderSlot& sender, int flags) {
         } else {
             CHECK(send_party_metrics.latency.e2e_latency == 0);
         }
+
+        // Recovery metrics are cumulative, and sender may be one report behind.
+        CHECK(send_party_metrics.link.fec_repaired_packets
+              <= recv_party_metrics.link.fec_repaired_packets);
+        CHECK(send_party_metrics.link.fec_unrepaired_packets
+              <= recv_party_metrics.link.fec_unrepaired_packets);
+        CHECK(send_party_metrics.link.late_packets
+              <= recv_party_metrics.link.late_packets);
+        CHECK(send_party_metrics.link.concealed_duration
+              <= recv_party_metrics.link.concealed_duration);
     } else {
         UNSIGNED_LONGS_EQUAL(0, send_metrics.num_participants);
         UNSIGNED_LONGS_EQUAL(0, send_party_count);
@@ -431,8 +477,8 @@ void send_receive(int flags,
     SenderSinkConfig sender_config =
         make_sender_config(flags, frame_channels, packet_channels);
 
-    SenderSink sender(sender_config, encoding_map, packet_pool, packet_buffer_pool,
-                      frame_buffer_pool, arena);
+    SenderSink sender(sender_config, encoding_map, sinc_table_map, packet_pool,
+                      packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(sender.is_valid());
 
     SenderSlotConfig sender_slot_config;
@@ -468,7 +514,7 @@ void send_receive(int flags,
     ReceiverSourceConfig receiver_config =
         make_receiver_config(frame_channels, packet_channels);
 
-    ReceiverSource receiver(receiver_config, encoding_map, packet_pool,
+    ReceiverSource receiver(receiver_config, encoding_map, sinc_table_map, packet_pool,
                             packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
@@ -572,6 +618,17 @@ void send_receive(int flags,
     } else {
         CHECK(proxy.n_control() == 0);
     }
+
+    if ((flags & FlagRTCP) != 0 && (flags & FlagLosses) != 0 && num_sessions == 1) {
+        // Losses repaired on receiver are reported to sender.
+        SenderSlotMetrics send_metrics;
+        SenderParticipantMetrics send_party_metrics;
+        size_t send_party_count = 1;
+        sender_slot->get_metrics(send_metrics, &send_party_metrics, &send_party_count);
+
+        UNSIGNED_LONGS_EQUAL(1, send_party_count);
+        CHECK(send_party_metrics.link.fec_repaired_packets > 0);
+    }
 }
 
 } // namespace
@@ -622,6 +679,14 @@ TEST(loopback_sink_2_source, fec_loss) {
     }
 }
 
+TEST(loopback_sink_2_source, fec_loss_rtcp) {
+    enum { Chans = Chans_Stereo, NumSess = 1 };
+
+    if (is_fec_supported(FlagReedSolomon)) {
+        send_receive(FlagReedSolomon | FlagLosses | FlagRTCP, NumSess, Chans, Chans);
+    }
+}
+
 TEST(loopback_sink_2_source, fec_drop_source) {
     enum { Chans = Chans_Stereo, NumSess = 0 };
 
@@ -638,6 +703,26 @@ TEST(loopback_sink_2_source, fec_drop_repair) {
     }
 }
 
+TEST(loopback_sink_2_source, lossless) {
+    enum { Chans = Chans_Stereo, NumSess = 1 };
+
+    send_receive(FlagLossless, NumSess, Chans, Chans);
+}
+
+TEST(loopback_sink_2_source, lossless_mono) {
+    enum { Chans = Chans_Mono, NumSess = 1 };
+
+    send_receive(FlagLossless, NumSess, Chans, Chans);
+}
+
+TEST(loopback_sink_2_source, lossless_fec) {
+    enum { Chans = Chans_Stereo, NumSess = 1 };
+
+    if (is_fec_supported(FlagReedSolomon)) {
+        send_receive(FlagLossless | FlagReedSolomon, NumSess, Chans, Chans);
+    }
+}
+
 TEST(loopback_sink_2_source, channel_mapping_stereo_to_mono) {
     enum { FrameChans = Chans_Stereo, PacketChans = Chans_Mono, NumSess = 1 };
 
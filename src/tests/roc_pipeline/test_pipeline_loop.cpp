@@ -64,6 +64,7 @@ public:
         , frame_allow_counter_(999999)
         , task_allow_counter_(999999)
         , time_(StartTime)
+        , frame_proc_duration_(0)
         , tid_(DefaultThread)
         , exp_frame_val_(0)
         , exp_frame_sz_(0)
@@ -73,7 +74,9 @@ public:
         , n_processed_frames_(0)
         , n_processed_tasks_(0)
         , n_sched_calls_(0)
-        , n_sched_cancellations_(0) {
+        , n_sched_cancellations_(0)
+        , frame_refresh_deadline_(0)
+        , n_refreshes_(0) {
     }
 
     void set_time(core::nanoseconds_t t) {
@@ -81,6 +84,11 @@ public:
         time_ = t;
     }
 
+    void set_frame_processing_duration(core::nanoseconds_t d) {
+        core::Mutex::Lock lock(mutex_);
+        frame_proc_duration_ = d;
+    }
+
     void set_tid(uint64_t t) {
         core::Mutex::Lock lock(mutex_);
         tid_ = t;
@@ -192,11 +200,22 @@ public:
         exp_frame_cts_ = cts;
     }
 
+    void set_frame_refresh_deadline(core::nanoseconds_t d) {
+        core::Mutex::Lock lock(mutex_);
+        frame_refresh_deadline_ = d;
+    }
+
+    size_t num_refreshes() const {
+        core::Mutex::Lock lock(mutex_);
+        return n_refreshes_;
+    }
+
     void expect_sched_deadline(core::nanoseconds_t d) {
         core::Mutex::Lock lock(mutex_);
         exp_sched_deadline_ = d;
     }
 
+    using PipelineLoop::frame_processing_time;
     using PipelineLoop::num_pending_frames;
     using PipelineLoop::num_pending_tasks;
     using PipelineLoop::process_subframes_and_tasks;
@@ -231,9 +250,16 @@ private:
         roc_panic_if(frame.flags() != exp_frame_flags_);
         roc_panic_if(frame.capture_timestamp() != exp_frame_cts_);
         n_processed_frames_++;
+        time_ += frame_proc_duration_;
+        request_refresh(frame_refresh_deadline_);
         return true;
     }
 
+    virtual void refresh_imp() {
+        core::Mutex::Lock lock(mutex_);
+        n_refreshes_++;
+    }
+
     virtual bool process_task_imp(PipelineTask&) {
         core::Mutex::Lock lock(mutex_);
         bool first_iter = true;
@@ -284,6 +310,7 @@ private:
     int task_allow_counter_;
 
     core::nanoseconds_t time_;
+    core::nanoseconds_t frame_proc_duration_;
     uint64_t tid_;
 
     audio::sample_t exp_frame_val_;
@@ -298,6 +325,9 @@ private:
 
     size_t n_sched_calls_;
     size_t n_sched_cancellations_;
+
+    core::nanoseconds_t frame_refresh_deadline_;
+    size_t n_refreshes_;
 };
 
 class TestCompleter : public IPipelineTaskCompleter {
@@ -2305,6 +2335,89 @@ TEST(pipeline_loop, schedule_and_wait_until_process_frame_called) {
     UNSIGNED_LONGS_EQUAL(1, pipeline.num_sched_cancellations());
 }
 
+TEST(pipeline_loop, refresh_without_frames) {
+    TestPipeline pipeline(config);
+
+    audio::Frame frame(samples, FrameSize);
+    fill_frame(frame, 0.1f, 0, FrameSize);
+    pipeline.expect_frame(0.1f, FrameSize);
+
+    const core::nanoseconds_t RefreshTime = StartTime + FrameSize * core::Microsecond * 3;
+
+    pipeline.set_time(StartTime);
+    pipeline.set_tid(ProcessingThread);
+
+    // frame requests refresh, and since there are no more frames,
+    // processing is scheduled at refresh deadline
+    pipeline.set_frame_refresh_deadline(RefreshTime);
+    pipeline.expect_sched_deadline(RefreshTime);
+
+    CHECK(pipeline.process_subframes_and_tasks(frame));
+
+    UNSIGNED_LONGS_EQUAL(1, pipeline.num_processed_frames());
+    UNSIGNED_LONGS_EQUAL(0, pipeline.num_refreshes());
+    UNSIGNED_LONGS_EQUAL(1, pipeline.num_sched_calls());
+
+    // next frame re-requests refresh with same deadline,
+    // processing is already scheduled
+    pipeline.set_time(StartTime + FrameSize * core::Microsecond);
+
+    CHECK(pipeline.process_subframes_and_tasks(frame));
+
+    UNSIGNED_LONGS_EQUAL(2, pipeline.num_processed_frames());
+    UNSIGNED_LONGS_EQUAL(0, pipeline.num_refreshes());
+    UNSIGNED_LONGS_EQUAL(1, pipeline.num_sched_calls());
+    UNSIGNED_LONGS_EQUAL(0, pipeline.num_sched_cancellations());
+
+    // frames stopped, scheduler invokes process_tasks() at refresh deadline
+    pipeline.set_tid(BackgroundThread);
+    pipeline.set_time(RefreshTime);
+
+    pipeline.process_tasks();
+
+    UNSIGNED_LONGS_EQUAL(1, pipeline.num_refreshes());
+    UNSIGNED_LONGS_EQUAL(1, pipeline.num_sched_calls());
+
+    UNSIGNED_LONGS_EQUAL(0, pipeline.num_pending_tasks());
+    UNSIGNED_LONGS_EQUAL(0, pipeline.num_processed_tasks());
+}
+
+TEST(pipeline_loop, refresh_deadline_not_expired) {
+    TestPipeline pipeline(config);
+
+    audio::Frame frame(samples, FrameSize);
+    fill_frame(frame, 0.1f, 0, FrameSize);
+    pipeline.expect_frame(0.1f, FrameSize);
+
+    const core::nanoseconds_t RefreshTime = StartTime + FrameSize * core::Microsecond * 3;
+
+    pipeline.set_time(StartTime);
+    pipeline.set_tid(ProcessingThread);
+
+    pipeline.set_frame_refresh_deadline(RefreshTime);
+    pipeline.expect_sched_deadline(RefreshTime);
+
+    CHECK(pipeline.process_subframes_and_tasks(frame));
+
+    UNSIGNED_LONGS_EQUAL(1, pipeline.num_sched_calls());
+
+    // process_tasks() invoked before deadline, refresh is rescheduled
+    pipeline.set_tid(BackgroundThread);
+    pipeline.set_time(RefreshTime - 1);
+
+    pipeline.process_tasks();
+
+    UNSIGNED_LONGS_EQUAL(0, pipeline.num_refreshes());
+    UNSIGNED_LONGS_EQUAL(2, pipeline.num_sched_calls());
+
+    pipeline.set_time(RefreshTime);
+
+    pipeline.process_tasks();
+
+    UNSIGNED_LONGS_EQUAL(1, pipeline.num_refreshes());
+    UNSIGNED_LONGS_EQUAL(2, pipeline.num_sched_calls());
+}
+
 TEST(pipeline_loop, forward_flags_and_cts_small_frame) {
     TestPipeline pipeline(config);
 
@@ -2355,5 +2468,44 @@ TEST(pipeline_loop, forward_flags_and_cts_large_frame) {
     UNSIGNED_LONGS_EQUAL(2, pipeline.num_processed_frames());
 }
 
+TEST(pipeline_loop, frame_processing_time) {
+    config.enable_precise_task_scheduling = false;
+
+    TestPipeline pipeline(config);
+
+    audio::Frame frame(samples, FrameSize);
+    fill_frame(frame, 0.1f, 0, FrameSize);
+
+    pipeline.expect_frame(0.1f, FrameSize);
+
+    LONGLONGS_EQUAL(0, pipeline.frame_processing_time());
+
+    pipeline.set_frame_processing_duration(core::Millisecond);
+
+    for (size_t n = 0; n < 10; n++) {
+        CHECK(pipeline.process_subframes_and_tasks(frame));
+
+        LONGLONGS_EQUAL(core::Millisecond, pipeline.frame_processing_time());
+    }
+
+    pipeline.set_frame_processing_duration(2 * core::Millisecond);
+
+    core::nanoseconds_t prev_time = pipeline.frame_processing_time();
+
+    for (size_t n = 0; n < 100; n++) {
+        CHECK(pipeline.process_subframes_and_tasks(frame));
+
+        CHECK(pipeline.frame_processing_time() >= prev_time);
+        CHECK(pipeline.frame_processing_time() <= 2 * core::Millisecond);
+
+        prev_time = pipeline.frame_processing_time();
+    }
+
+    DOUBLES_EQUAL(2 * core::Millisecond, pipeline.frame_processing_time(),
+                  core::Microsecond);
+
+    UNSIGNED_LONGS_EQUAL(110, pipeline.num_processed_frames());
+}
+
 } // namespace pipeline
 } // namespace roc
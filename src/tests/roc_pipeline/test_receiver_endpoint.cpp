@@ -17,6 +17,7 @@
 #include "roc_pipeline/config.h"
 #include "roc_pipeline/receiver_endpoint.h"
 #include "roc_pipeline/receiver_session_group.h"
+#include "roc_rtp/headers.h"
 
 namespace roc {
 namespace pipeline {
@@ -31,38 +32,64 @@ packet::PacketFactory packet_factory(arena, PacketSz);
 audio::FrameFactory frame_factory(arena, PacketSz * sizeof(audio::sample_t));
 
 rtp::EncodingMap encoding_map(arena);
+audio::SincTableMap sinc_table_map(arena);
+
+packet::PacketPtr new_packet(size_t size, uint8_t payload_type) {
+    core::Slice<uint8_t> buf = packet_factory.new_packet_buffer();
+    CHECK(buf);
+    buf.reslice(0, size);
+    memset(buf.data(), 0, size);
+
+    if (size >= sizeof(rtp::Header)) {
+        rtp::Header& header = *(rtp::Header*)buf.data();
+        header.set_version(rtp::V2);
+        header.set_payload_type(payload_type);
+    }
+
+    packet::PacketPtr pp = packet_factory.new_packet();
+    CHECK(pp);
+    pp->set_buffer(buf);
+
+    return pp;
+}
 
 } // namespace
 
 TEST_GROUP(receiver_endpoint) {};
 
 TEST(receiver_endpoint, valid) {
-    audio::Mixer mixer(frame_factory, DefaultSampleSpec, false);
+    audio::Mixer mixer(frame_factory, arena, DefaultSampleSpec, false, 1);
 
     StateTracker state_tracker;
     ReceiverSourceConfig source_config;
     ReceiverSlotConfig slot_config;
-    ReceiverSessionGroup session_group(source_config, slot_config, state_tracker, mixer,
-                                       encoding_map, packet_factory, frame_factory,
+    AdmissionController admission_controller(source_config.common, state_tracker);
+    ReceiverSessionGroup session_group(source_config, slot_config, state_tracker,
+                                       admission_controller, mixer, encoding_map,
+                                       sinc_table_map, packet_factory, frame_factory,
                                        arena);
 
-    ReceiverEndpoint endpoint(address::Proto_RTP, state_tracker, session_group,
-                              encoding_map, address::SocketAddr(), NULL, arena);
+    ReceiverEndpoint endpoint(address::Proto_RTP, source_config.common, state_tracker,
+                              session_group, encoding_map, address::SocketAddr(), NULL,
+                              arena);
     CHECK(endpoint.is_valid());
 }
 
 TEST(receiver_endpoint, invalid_proto) {
-    audio::Mixer mixer(frame_factory, DefaultSampleSpec, false);
+    audio::Mixer mixer(frame_factory, arena, DefaultSampleSpec, false, 1);
 
     StateTracker state_tracker;
     ReceiverSourceConfig source_config;
     ReceiverSlotConfig slot_config;
-    ReceiverSessionGroup session_group(source_config, slot_config, state_tracker, mixer,
-                                       encoding_map, packet_factory, frame_factory,
+    AdmissionController admission_controller(source_config.common, state_tracker);
+    ReceiverSessionGroup session_group(source_config, slot_config, state_tracker,
+                                       admission_controller, mixer, encoding_map,
+                                       sinc_table_map, packet_factory, frame_factory,
                                        arena);
 
-    ReceiverEndpoint endpoint(address::Proto_None, state_tracker, session_group,
-                              encoding_map, address::SocketAddr(), NULL, arena);
+    ReceiverEndpoint endpoint(address::Proto_None, source_config.common, state_tracker,
+                              session_group, encoding_map, address::SocketAddr(), NULL,
+                              arena);
     CHECK(!endpoint.is_valid());
 }
 
@@ -75,21 +102,76 @@ TEST(receiver_endpoint, no_memory) {
     };
 
     for (size_t n = 0; n < ROC_ARRAY_SIZE(protos); ++n) {
-        audio::Mixer mixer(frame_factory, DefaultSampleSpec, false);
+        audio::Mixer mixer(frame_factory, arena, DefaultSampleSpec, false, 1);
 
         StateTracker state_tracker;
         ReceiverSourceConfig source_config;
         ReceiverSlotConfig slot_config;
+        AdmissionController admission_controller(source_config.common, state_tracker);
         ReceiverSessionGroup session_group(source_config, slot_config, state_tracker,
-                                           mixer, encoding_map, packet_factory,
-                                           frame_factory, core::NoopArena);
+                                           admission_controller, mixer, encoding_map,
+                                           sinc_table_map, packet_factory, frame_factory,
+                                           core::NoopArena);
 
-        ReceiverEndpoint endpoint(protos[n], state_tracker, session_group, encoding_map,
-                                  address::SocketAddr(), NULL, core::NoopArena);
+        ReceiverEndpoint endpoint(protos[n], source_config.common, state_tracker,
+                                  session_group, encoding_map, address::SocketAddr(),
+                                  NULL, core::NoopArena);
 
         CHECK(!endpoint.is_valid());
     }
 }
 
+TEST(receiver_endpoint, inline_parsing) {
+    enum { PayloadSz = 64, BadPayloadType = 100 };
+
+    for (int inline_parsing = 0; inline_parsing <= 1; inline_parsing++) {
+        audio::Mixer mixer(frame_factory, arena, DefaultSampleSpec, false, 1);
+
+        StateTracker state_tracker;
+        ReceiverSourceConfig source_config;
+        source_config.common.enable_inline_parsing = inline_parsing;
+        ReceiverSlotConfig slot_config;
+        AdmissionController admission_controller(source_config.common, state_tracker);
+        ReceiverSessionGroup session_group(source_config, slot_config, state_tracker,
+                                           admission_controller, mixer, encoding_map,
+                                           sinc_table_map, packet_factory, frame_factory,
+                                           arena);
+
+        ReceiverEndpoint endpoint(address::Proto_RTP, source_config.common,
+                                  state_tracker, session_group, encoding_map,
+                                  address::SocketAddr(), NULL, arena);
+        CHECK(endpoint.is_valid());
+
+        // truncated header
+        packet::PacketPtr junk_pp = new_packet(4, 0);
+        // unknown payload type
+        packet::PacketPtr bad_pt_pp =
+            new_packet(sizeof(rtp::Header) + PayloadSz, BadPayloadType);
+        // good packet
+        packet::PacketPtr good_pp =
+            new_packet(sizeof(rtp::Header) + PayloadSz, rtp::PayloadType_L16_Stereo);
+
+        LONGS_EQUAL(status::StatusOK, endpoint.inbound_writer().write(junk_pp));
+        LONGS_EQUAL(status::StatusOK, endpoint.inbound_writer().write(bad_pt_pp));
+        LONGS_EQUAL(status::StatusOK, endpoint.inbound_writer().write(good_pp));
+
+        if (inline_parsing) {
+            // junk is dropped on write, good packet is parsed before pull
+            UNSIGNED_LONGS_EQUAL(1, state_tracker.num_pending_packets());
+            CHECK(good_pp->has_flags(packet::Packet::FlagRTP));
+            CHECK(good_pp->has_flags(packet::Packet::FlagAudio));
+        } else {
+            // everything is enqueued, nothing is parsed before pull
+            UNSIGNED_LONGS_EQUAL(3, state_tracker.num_pending_packets());
+            CHECK(!good_pp->has_flags(packet::Packet::FlagRTP));
+        }
+
+        LONGS_EQUAL(status::StatusOK, endpoint.pull_packets(0));
+
+        UNSIGNED_LONGS_EQUAL(0, state_tracker.num_pending_packets());
+        CHECK(good_pp->has_flags(packet::Packet::FlagRTP));
+    }
+}
+
 } // namespace pipeline
 } // namespace roc
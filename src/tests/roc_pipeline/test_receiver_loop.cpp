@@ -37,6 +37,7 @@ packet::PacketFactory packet_factory(packet_pool, packet_buffer_pool);
 audio::FrameFactory frame_factory(frame_buffer_pool);
 
 rtp::EncodingMap encoding_map(arena);
+audio::SincTableMap sinc_table_map(arena);
 
 class TaskIssuer : public IPipelineTaskCompleter {
 public:
@@ -120,7 +121,7 @@ TEST_GROUP(receiver_loop) {
 };
 
 TEST(receiver_loop, endpoints_sync) {
-    ReceiverLoop receiver(scheduler, config, encoding_map, packet_pool,
+    ReceiverLoop receiver(scheduler, config, encoding_map, sinc_table_map, packet_pool,
                           packet_buffer_pool, frame_buffer_pool, arena);
 
     CHECK(receiver.is_valid());
@@ -154,7 +155,7 @@ TEST(receiver_loop, endpoints_sync) {
 }
 
 TEST(receiver_loop, endpoints_async) {
-    ReceiverLoop receiver(scheduler, config, encoding_map, packet_pool,
+    ReceiverLoop receiver(scheduler, config, encoding_map, sinc_table_map, packet_pool,
                           packet_buffer_pool, frame_buffer_pool, arena);
 
     CHECK(receiver.is_valid());
@@ -167,5 +168,41 @@ TEST(receiver_loop, endpoints_async) {
     scheduler.wait_done();
 }
 
+TEST(receiver_loop, slot_metrics) {
+    ReceiverLoop receiver(scheduler, config, encoding_map, sinc_table_map, packet_pool,
+                          packet_buffer_pool, frame_buffer_pool, arena);
+
+    CHECK(receiver.is_valid());
+
+    ReceiverLoop::SlotHandle slot = NULL;
+
+    {
+        ReceiverSlotConfig config;
+        ReceiverLoop::Tasks::CreateSlot task(config);
+        CHECK(receiver.schedule_and_wait(task));
+        CHECK(task.success());
+
+        slot = task.get_handle();
+    }
+
+    {
+        // Snapshot is published when slot is created, and is read
+        // without waiting for pipeline.
+        ReceiverSlotMetrics slot_metrics;
+        size_t party_count = 0;
+        CHECK(receiver.load_slot_metrics(slot, slot_metrics, NULL, &party_count));
+
+        CHECK(slot_metrics.source_id != 0);
+        UNSIGNED_LONGS_EQUAL(0, slot_metrics.num_participants);
+        UNSIGNED_LONGS_EQUAL(0, party_count);
+    }
+
+    {
+        ReceiverLoop::Tasks::DeleteSlot task(slot);
+        CHECK(receiver.schedule_and_wait(task));
+        CHECK(task.success());
+    }
+}
+
 } // namespace pipeline
 } // namespace roc
@@ -16,6 +16,7 @@
 #include "roc_address/interface.h"
 #include "roc_address/protocol.h"
 #include "roc_core/heap_arena.h"
+#include "roc_core/macro_helpers.h"
 #include "roc_core/slab_pool.h"
 #include "roc_core/time.h"
 #include "roc_pipeline/receiver_source.h"
@@ -88,6 +89,7 @@ packet::PacketFactory packet_factory(packet_pool, packet_buffer_pool);
 audio::FrameFactory frame_factory(frame_buffer_pool);
 
 rtp::EncodingMap encoding_map(arena);
+audio::SincTableMap sinc_table_map(arena);
 
 ReceiverSlot* create_slot(ReceiverSource& source) {
     ReceiverSlotConfig slot_config;
@@ -212,8 +214,8 @@ TEST(receiver_source, no_sessions) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     test::FrameReader frame_reader(receiver, frame_factory);
@@ -231,8 +233,8 @@ TEST(receiver_source, one_session) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -268,8 +270,8 @@ TEST(receiver_source, one_session_long_run) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -309,8 +311,8 @@ TEST(receiver_source, initial_latency) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -349,14 +351,79 @@ TEST(receiver_source, initial_latency) {
     }
 }
 
+// Fast start: playback starts when start latency is accumulated,
+// before target latency is reached.
+TEST(receiver_source, fast_start) {
+    enum {
+        Rate = SampleRate,
+        Chans = Chans_Stereo,
+        StartPackets = 2,
+        StartLatency = SamplesPerPacket * StartPackets
+    };
+
+    init(Rate, Chans, Rate, Chans);
+
+    ReceiverSourceConfig config = make_default_config();
+    config.session_defaults.latency.tuner_profile = audio::LatencyTunerProfile_Responsive;
+    config.session_defaults.latency.start_latency =
+        StartLatency * core::Second / (int)output_sample_spec.sample_rate();
+
+    ReceiverSource receiver(config, encoding_map, sinc_table_map, packet_pool,
+                            packet_buffer_pool, frame_buffer_pool, arena);
+    CHECK(receiver.is_valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint1_writer =
+        create_transport_endpoint(slot, address::Iface_AudioSource, proto1, dst_addr1);
+    CHECK(endpoint1_writer);
+
+    test::FrameReader frame_reader(receiver, frame_factory);
+
+    test::PacketWriter packet_writer(arena, *endpoint1_writer, encoding_map,
+                                     packet_factory, src_id1, src_addr1, dst_addr1,
+                                     PayloadType_Ch2);
+
+    for (size_t np = 0; np < StartPackets - 1; np++) {
+        packet_writer.write_packets(1, SamplesPerPacket, packet_sample_spec);
+
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            receiver.refresh(frame_reader.refresh_ts());
+            frame_reader.read_zero_samples(SamplesPerFrame, output_sample_spec);
+        }
+    }
+
+    // start latency accumulated, playback starts (first frames may be zero
+    // because of resampler delay)
+    packet_writer.write_packets(1, SamplesPerPacket, packet_sample_spec);
+
+    for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+        receiver.refresh(frame_reader.refresh_ts());
+        frame_reader.read_any_samples(SamplesPerFrame, output_sample_spec);
+    }
+
+    // target latency is not reached yet, but playback continues
+    for (size_t np = StartPackets; np < Latency / SamplesPerPacket; np++) {
+        packet_writer.write_packets(1, SamplesPerPacket, packet_sample_spec);
+
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            receiver.refresh(frame_reader.refresh_ts());
+            frame_reader.read_nonzero_samples(SamplesPerFrame, output_sample_spec);
+        }
+
+        UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+    }
+}
+
 // Timeout expires during initial latency accumulation.
 TEST(receiver_source, initial_latency_timeout) {
     enum { Rate = SampleRate, Chans = Chans_Stereo };
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -395,8 +462,8 @@ TEST(receiver_source, timeout) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -443,7 +510,8 @@ TEST(receiver_source, timeout_smaller_than_latency) {
 
     ReceiverSource receiver(
         make_custom_config(LargeLatency, LatencyTolerance, Timeout, LargeWarmup),
-        encoding_map, packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
+        encoding_map, sinc_table_map, packet_pool, packet_buffer_pool, frame_buffer_pool,
+        arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -518,7 +586,7 @@ TEST(receiver_source, min_latency) {
 
     ReceiverSource receiver(
         make_custom_config(Latency, SmallTolerance, LargeTimeout, Warmup), encoding_map,
-        packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
+        sinc_table_map, packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -577,7 +645,7 @@ TEST(receiver_source, max_latency) {
 
     ReceiverSource receiver(
         make_custom_config(Latency, SmallTolerance, LargeTimeout, Warmup), encoding_map,
-        packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
+        sinc_table_map, packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -643,8 +711,8 @@ TEST(receiver_source, initial_trim) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -682,8 +750,8 @@ TEST(receiver_source, two_sessions_synchronous) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -726,8 +794,8 @@ TEST(receiver_source, two_sessions_overlapping) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -783,8 +851,8 @@ TEST(receiver_source, two_sessions_two_endpoints) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot1 = create_slot(receiver);
@@ -834,8 +902,8 @@ TEST(receiver_source, two_sessions_same_address_same_stream) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -883,8 +951,8 @@ TEST(receiver_source, two_sessions_same_address_different_streams) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -929,13 +997,249 @@ TEST(receiver_source, two_sessions_same_address_different_streams) {
     }
 }
 
+// New sessions are rejected when session limit is reached.
+TEST(receiver_source, admission_max_sessions) {
+    enum { Rate = SampleRate, Chans = Chans_Stereo, MaxParties = 10 };
+
+    init(Rate, Chans, Rate, Chans);
+
+    ReceiverSourceConfig config = make_default_config();
+    config.common.max_sessions = 1;
+
+    ReceiverSource receiver(config, encoding_map, sinc_table_map, packet_pool,
+                            packet_buffer_pool, frame_buffer_pool, arena);
+    CHECK(receiver.is_valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint1_writer =
+        create_transport_endpoint(slot, address::Iface_AudioSource, proto1, dst_addr1);
+    CHECK(endpoint1_writer);
+
+    test::FrameReader frame_reader(receiver, frame_factory);
+
+    test::PacketWriter packet_writer1(arena, *endpoint1_writer, encoding_map,
+                                      packet_factory, src_id1, src_addr1, dst_addr1,
+                                      PayloadType_Ch2);
+
+    test::PacketWriter packet_writer2(arena, *endpoint1_writer, encoding_map,
+                                      packet_factory, src_id2, src_addr2, dst_addr1,
+                                      PayloadType_Ch2);
+
+    for (size_t np = 0; np < Latency / SamplesPerPacket; np++) {
+        packet_writer1.write_packets(1, SamplesPerPacket, output_sample_spec);
+        packet_writer2.write_packets(1, SamplesPerPacket, output_sample_spec);
+    }
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            receiver.refresh(frame_reader.refresh_ts());
+            frame_reader.read_samples(SamplesPerFrame, 1, output_sample_spec);
+
+            UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+        }
+
+        packet_writer1.write_packets(1, SamplesPerPacket, output_sample_spec);
+        packet_writer2.write_packets(1, SamplesPerPacket, output_sample_spec);
+    }
+
+    ReceiverSlotMetrics slot_metrics;
+    ReceiverParticipantMetrics party_metrics[MaxParties];
+    size_t party_metrics_size = MaxParties;
+
+    slot->get_metrics(slot_metrics, party_metrics, &party_metrics_size);
+
+    UNSIGNED_LONGS_EQUAL(1, slot_metrics.num_participants);
+    UNSIGNED_LONGS_EQUAL(1, slot_metrics.num_admitted_sessions);
+    CHECK(slot_metrics.num_rejected_sessions > 0);
+    UNSIGNED_LONGS_EQUAL(0, slot_metrics.num_shed_sessions);
+}
+
+// When load limit is exceeded, sessions of slot with lower priority
+// are removed first.
+TEST(receiver_source, admission_shedding_priority) {
+    enum { Rate = SampleRate, Chans = Chans_Stereo, MaxParties = 10 };
+
+    init(Rate, Chans, Rate, Chans);
+
+    ReceiverSourceConfig config = make_default_config();
+    // Any measured load exceeds this limit.
+    config.common.max_session_load = 1e-9f;
+
+    ReceiverSource receiver(config, encoding_map, sinc_table_map, packet_pool,
+                            packet_buffer_pool, frame_buffer_pool, arena);
+    CHECK(receiver.is_valid());
+
+    ReceiverSlotConfig high_slot_config;
+    high_slot_config.session_priority = SessionPriority_High;
+    ReceiverSlot* high_slot = receiver.create_slot(high_slot_config);
+    CHECK(high_slot);
+
+    ReceiverSlotConfig low_slot_config;
+    low_slot_config.session_priority = SessionPriority_Low;
+    ReceiverSlot* low_slot = receiver.create_slot(low_slot_config);
+    CHECK(low_slot);
+
+    packet::IWriter* endpoint1_writer = create_transport_endpoint(
+        high_slot, address::Iface_AudioSource, proto1, dst_addr1);
+    CHECK(endpoint1_writer);
+
+    packet::IWriter* endpoint2_writer = create_transport_endpoint(
+        low_slot, address::Iface_AudioSource, proto2, dst_addr2);
+    CHECK(endpoint2_writer);
+
+    test::FrameReader frame_reader(receiver, frame_factory);
+
+    test::PacketWriter packet_writer1(arena, *endpoint1_writer, encoding_map,
+                                      packet_factory, src_id1, src_addr1, dst_addr1,
+                                      PayloadType_Ch2);
+
+    test::PacketWriter packet_writer2(arena, *endpoint2_writer, encoding_map,
+                                      packet_factory, src_id2, src_addr2, dst_addr2,
+                                      PayloadType_Ch2);
+
+    packet_writer1.write_packets(Latency / SamplesPerPacket, SamplesPerPacket,
+                                 output_sample_spec);
+    packet_writer2.write_packets(Latency / SamplesPerPacket, SamplesPerPacket,
+                                 output_sample_spec);
+
+    // Sessions are created before any load is measured.
+    receiver.refresh(frame_reader.refresh_ts());
+    UNSIGNED_LONGS_EQUAL(1, high_slot->num_sessions());
+    UNSIGNED_LONGS_EQUAL(1, low_slot->num_sessions());
+
+    frame_reader.read_samples(SamplesPerFrame, 2, output_sample_spec);
+
+    // Session with lower priority is removed first.
+    receiver.refresh(frame_reader.refresh_ts());
+    UNSIGNED_LONGS_EQUAL(1, high_slot->num_sessions());
+    UNSIGNED_LONGS_EQUAL(0, low_slot->num_sessions());
+
+    frame_reader.read_samples(SamplesPerFrame, 1, output_sample_spec);
+
+    receiver.refresh(frame_reader.refresh_ts());
+    UNSIGNED_LONGS_EQUAL(0, high_slot->num_sessions());
+    UNSIGNED_LONGS_EQUAL(0, low_slot->num_sessions());
+
+    {
+        ReceiverSlotMetrics slot_metrics;
+        ReceiverParticipantMetrics party_metrics[MaxParties];
+        size_t party_metrics_size = MaxParties;
+
+        low_slot->get_metrics(slot_metrics, party_metrics, &party_metrics_size);
+
+        UNSIGNED_LONGS_EQUAL(1, slot_metrics.num_admitted_sessions);
+        UNSIGNED_LONGS_EQUAL(1, slot_metrics.num_shed_sessions);
+    }
+
+    // Load is still above the limit, new sessions are rejected.
+    packet_writer2.write_packets(1, SamplesPerPacket, output_sample_spec);
+    receiver.refresh(frame_reader.refresh_ts());
+    UNSIGNED_LONGS_EQUAL(0, low_slot->num_sessions());
+
+    {
+        ReceiverSlotMetrics slot_metrics;
+        ReceiverParticipantMetrics party_metrics[MaxParties];
+        size_t party_metrics_size = MaxParties;
+
+        low_slot->get_metrics(slot_metrics, party_metrics, &party_metrics_size);
+
+        CHECK(slot_metrics.num_rejected_sessions > 0);
+    }
+}
+
+// After session is shed, its sender is denied for a while even if load
+// dropped, and is admitted again when deny duration expires.
+TEST(receiver_source, admission_shedding_deny) {
+    enum { Rate = SampleRate, Chans = Chans_Stereo, MaxParties = 10, DenyFrames = 5 };
+
+    init(Rate, Chans, Rate, Chans);
+
+    ReceiverSourceConfig config = make_default_config();
+    // Any measured load exceeds this limit.
+    config.common.max_session_load = 1e-9f;
+    config.common.shed_deny_duration =
+        output_sample_spec.samples_per_chan_2_ns(SamplesPerFrame * DenyFrames);
+
+    ReceiverSource receiver(config, encoding_map, sinc_table_map, packet_pool,
+                            packet_buffer_pool, frame_buffer_pool, arena);
+    CHECK(receiver.is_valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint1_writer =
+        create_transport_endpoint(slot, address::Iface_AudioSource, proto1, dst_addr1);
+    CHECK(endpoint1_writer);
+
+    test::FrameReader frame_reader(receiver, frame_factory);
+
+    test::PacketWriter packet_writer(arena, *endpoint1_writer, encoding_map,
+                                     packet_factory, src_id1, src_addr1, dst_addr1,
+                                     PayloadType_Ch2);
+
+    packet_writer.write_packets(Latency / SamplesPerPacket, SamplesPerPacket,
+                                output_sample_spec);
+
+    receiver.refresh(frame_reader.refresh_ts());
+    UNSIGNED_LONGS_EQUAL(1, slot->num_sessions());
+
+    frame_reader.read_samples(SamplesPerFrame, 1, output_sample_spec);
+
+    // Session is shed.
+    receiver.refresh(frame_reader.refresh_ts());
+    UNSIGNED_LONGS_EQUAL(0, slot->num_sessions());
+
+    frame_reader.read_zero_samples(SamplesPerFrame, output_sample_spec);
+
+    // Load is now zero, but sender is denied.
+    for (size_t nf = 0; nf < DenyFrames - 2; nf++) {
+        packet_writer.write_packets(1, SamplesPerPacket, output_sample_spec);
+        receiver.refresh(frame_reader.refresh_ts());
+        UNSIGNED_LONGS_EQUAL(0, slot->num_sessions());
+
+        frame_reader.read_zero_samples(SamplesPerFrame, output_sample_spec);
+    }
+
+    {
+        ReceiverSlotMetrics slot_metrics;
+        ReceiverParticipantMetrics party_metrics[MaxParties];
+        size_t party_metrics_size = MaxParties;
+
+        slot->get_metrics(slot_metrics, party_metrics, &party_metrics_size);
+
+        UNSIGNED_LONGS_EQUAL(1, slot_metrics.num_admitted_sessions);
+        UNSIGNED_LONGS_EQUAL(1, slot_metrics.num_shed_sessions);
+        CHECK(slot_metrics.num_rejected_sessions > 0);
+    }
+
+    for (size_t nf = 0; nf < DenyFrames; nf++) {
+        frame_reader.read_zero_samples(SamplesPerFrame, output_sample_spec);
+    }
+
+    // Deny duration expired, sender is admitted again.
+    packet_writer.write_packets(1, SamplesPerPacket, output_sample_spec);
+    receiver.refresh(frame_reader.refresh_ts());
+
+    {
+        ReceiverSlotMetrics slot_metrics;
+        ReceiverParticipantMetrics party_metrics[MaxParties];
+        size_t party_metrics_size = MaxParties;
+
+        slot->get_metrics(slot_metrics, party_metrics, &party_metrics_size);
+
+        UNSIGNED_LONGS_EQUAL(2, slot_metrics.num_admitted_sessions);
+    }
+}
+
 TEST(receiver_source, seqnum_overflow) {
     enum { Rate = SampleRate, Chans = Chans_Stereo };
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -969,8 +1273,8 @@ TEST(receiver_source, seqnum_small_jump) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -1014,8 +1318,8 @@ TEST(receiver_source, seqnum_large_jump) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -1067,8 +1371,8 @@ TEST(receiver_source, seqnum_reorder) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -1108,8 +1412,8 @@ TEST(receiver_source, seqnum_late) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -1171,8 +1475,8 @@ TEST(receiver_source, timestamp_overflow) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -1208,8 +1512,8 @@ TEST(receiver_source, timestamp_small_jump) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -1262,8 +1566,8 @@ TEST(receiver_source, timestamp_large_jump) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -1310,8 +1614,8 @@ TEST(receiver_source, timestamp_overlap) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -1347,8 +1651,8 @@ TEST(receiver_source, timestamp_reorder) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -1406,8 +1710,8 @@ TEST(receiver_source, timestamp_late) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -1480,8 +1784,8 @@ TEST(receiver_source, packet_size_small) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -1521,8 +1825,8 @@ TEST(receiver_source, packet_size_large) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -1568,8 +1872,8 @@ TEST(receiver_source, packet_size_variable) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -1606,8 +1910,8 @@ TEST(receiver_source, corrupted_packets_new_session) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -1646,8 +1950,8 @@ TEST(receiver_source, corrupted_packets_existing_session) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -1709,8 +2013,8 @@ TEST(receiver_source, channel_mapping_stereo_to_mono) {
 
     init(Rate, OutputChans, Rate, PacketChans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -1747,8 +2051,8 @@ TEST(receiver_source, channel_mapping_mono_to_stereo) {
 
     init(Rate, OutputChans, Rate, PacketChans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -1785,8 +2089,8 @@ TEST(receiver_source, sample_rate_mapping) {
 
     init(OutputRate, Chans, PacketRate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -1820,22 +2124,297 @@ TEST(receiver_source, sample_rate_mapping) {
     }
 }
 
-// When there are no control packets, receiver always sets CTS of frames to zero.
-TEST(receiver_source, timestamp_mapping_no_control_packets) {
-    enum { Rate = SampleRate, Chans = Chans_Stereo };
+// Planar processing, packets are mono, receiver produces stereo,
+// two sessions are mixed.
+TEST(receiver_source, planar_channel_mapping_two_sessions) {
+    enum { Rate = SampleRate, OutputChans = Chans_Stereo, PacketChans = Chans_Mono };
 
-    init(Rate, Chans, Rate, Chans);
+    init(Rate, OutputChans, Rate, PacketChans);
+
+    ReceiverSourceConfig config = make_default_config();
+    config.common.processing_layout = audio::SampleLayout_Planar;
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
+    ReceiverSource receiver(config, encoding_map, sinc_table_map, packet_pool,
                             packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
     CHECK(slot);
 
-    packet::IWriter* transport_endpoint = create_transport_endpoint(
-        slot, address::Iface_AudioSource, address::Proto_RTP, dst_addr1);
-    CHECK(transport_endpoint);
+    packet::IWriter* endpoint1_writer =
+        create_transport_endpoint(slot, address::Iface_AudioSource, proto1, dst_addr1);
+    CHECK(endpoint1_writer);
+
+    test::FrameReader frame_reader(receiver, frame_factory);
+
+    test::PacketWriter packet_writer1(arena, *endpoint1_writer, encoding_map,
+                                      packet_factory, src_id1, src_addr1, dst_addr1,
+                                      PayloadType_Ch1);
+
+    test::PacketWriter packet_writer2(arena, *endpoint1_writer, encoding_map,
+                                      packet_factory, src_id2, src_addr2, dst_addr1,
+                                      PayloadType_Ch1);
+
+    for (size_t np = 0; np < Latency / SamplesPerPacket; np++) {
+        packet_writer1.write_packets(1, SamplesPerPacket, packet_sample_spec);
+        packet_writer2.write_packets(1, SamplesPerPacket, packet_sample_spec);
+    }
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            receiver.refresh(frame_reader.refresh_ts());
+            frame_reader.read_samples(SamplesPerFrame, 2, output_sample_spec);
+
+            UNSIGNED_LONGS_EQUAL(2, receiver.num_sessions());
+        }
+
+        packet_writer1.write_packets(1, SamplesPerPacket, packet_sample_spec);
+        packet_writer2.write_packets(1, SamplesPerPacket, packet_sample_spec);
+    }
+}
+
+// Planar processing with resampling, both with resampler backend that supports
+// planar layout and with backend that doesn't.
+TEST(receiver_source, planar_sample_rate_mapping) {
+    enum { OutputRate = 48000, PacketRate = 44100, Chans = Chans_Stereo };
+
+    const audio::ResamplerBackend backends[] = { audio::ResamplerBackend_Builtin,
+                                                 audio::ResamplerBackend_Slip };
+
+    for (size_t n_back = 0; n_back < ROC_ARRAY_SIZE(backends); n_back++) {
+        init(OutputRate, Chans, PacketRate, Chans);
+
+        ReceiverSourceConfig config = make_default_config();
+        config.common.processing_layout = audio::SampleLayout_Planar;
+        config.session_defaults.resampler.backend = backends[n_back];
+
+        ReceiverSource receiver(config, encoding_map, sinc_table_map, packet_pool,
+                                packet_buffer_pool, frame_buffer_pool, arena);
+        CHECK(receiver.is_valid());
+
+        ReceiverSlot* slot = create_slot(receiver);
+        CHECK(slot);
+
+        packet::IWriter* endpoint1_writer = create_transport_endpoint(
+            slot, address::Iface_AudioSource, proto1, dst_addr1);
+        CHECK(endpoint1_writer);
+
+        test::FrameReader frame_reader(receiver, frame_factory);
+
+        test::PacketWriter packet_writer(arena, *endpoint1_writer, encoding_map,
+                                         packet_factory, src_id1, src_addr1, dst_addr1,
+                                         PayloadType_Ch2);
+
+        packet_writer.write_packets(Latency / SamplesPerPacket, SamplesPerPacket,
+                                    packet_sample_spec);
+
+        for (size_t np = 0; np < ManyPackets; np++) {
+            for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+                receiver.refresh(frame_reader.refresh_ts());
+                frame_reader.read_nonzero_samples(
+                    SamplesPerFrame * OutputRate / PacketRate
+                        / output_sample_spec.num_channels()
+                        * output_sample_spec.num_channels(),
+                    output_sample_spec);
+
+                UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+            }
+
+            packet_writer.write_packets(1, SamplesPerPacket, packet_sample_spec);
+        }
+    }
+}
+
+// Integer processing, two sessions are mixed. Samples are kept in integer
+// format from depacketizer to mixer and converted to raw output after mixing.
+TEST(receiver_source, integer_two_sessions) {
+    enum { Rate = SampleRate, Chans = Chans_Stereo };
+
+    const audio::PcmFormat formats[] = { audio::PcmFormat_SInt16,
+                                         audio::PcmFormat_SInt32 };
+
+    for (size_t n_fmt = 0; n_fmt < ROC_ARRAY_SIZE(formats); n_fmt++) {
+        init(Rate, Chans, Rate, Chans);
+
+        ReceiverSourceConfig config = make_default_config();
+        config.common.processing_format = formats[n_fmt];
+
+        ReceiverSource receiver(config, encoding_map, sinc_table_map, packet_pool,
+                                packet_buffer_pool, frame_buffer_pool, arena);
+        CHECK(receiver.is_valid());
+
+        ReceiverSlot* slot = create_slot(receiver);
+        CHECK(slot);
+
+        packet::IWriter* endpoint1_writer = create_transport_endpoint(
+            slot, address::Iface_AudioSource, proto1, dst_addr1);
+        CHECK(endpoint1_writer);
+
+        test::FrameReader frame_reader(receiver, frame_factory);
+
+        test::PacketWriter packet_writer1(arena, *endpoint1_writer, encoding_map,
+                                          packet_factory, src_id1, src_addr1, dst_addr1,
+                                          PayloadType_Ch2);
+
+        test::PacketWriter packet_writer2(arena, *endpoint1_writer, encoding_map,
+                                          packet_factory, src_id2, src_addr2, dst_addr1,
+                                          PayloadType_Ch2);
+
+        for (size_t np = 0; np < Latency / SamplesPerPacket; np++) {
+            packet_writer1.write_packets(1, SamplesPerPacket, packet_sample_spec);
+            packet_writer2.write_packets(1, SamplesPerPacket, packet_sample_spec);
+        }
+
+        for (size_t np = 0; np < ManyPackets; np++) {
+            for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+                receiver.refresh(frame_reader.refresh_ts());
+                frame_reader.read_samples(SamplesPerFrame, 2, output_sample_spec);
+
+                UNSIGNED_LONGS_EQUAL(2, receiver.num_sessions());
+            }
+
+            packet_writer1.write_packets(1, SamplesPerPacket, packet_sample_spec);
+            packet_writer2.write_packets(1, SamplesPerPacket, packet_sample_spec);
+        }
+    }
+}
+
+// Integer processing, packets are mono, receiver produces stereo. Channel
+// mapper works with raw samples, so session converts them to integer after it.
+TEST(receiver_source, integer_channel_mapping) {
+    enum { Rate = SampleRate, OutputChans = Chans_Stereo, PacketChans = Chans_Mono };
+
+    init(Rate, OutputChans, Rate, PacketChans);
+
+    ReceiverSourceConfig config = make_default_config();
+    config.common.processing_format = audio::PcmFormat_SInt16;
+
+    ReceiverSource receiver(config, encoding_map, sinc_table_map, packet_pool,
+                            packet_buffer_pool, frame_buffer_pool, arena);
+    CHECK(receiver.is_valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint1_writer =
+        create_transport_endpoint(slot, address::Iface_AudioSource, proto1, dst_addr1);
+    CHECK(endpoint1_writer);
+
+    test::FrameReader frame_reader(receiver, frame_factory);
+
+    test::PacketWriter packet_writer(arena, *endpoint1_writer, encoding_map,
+                                     packet_factory, src_id1, src_addr1, dst_addr1,
+                                     PayloadType_Ch1);
+
+    packet_writer.write_packets(Latency / SamplesPerPacket, SamplesPerPacket,
+                                packet_sample_spec);
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            receiver.refresh(frame_reader.refresh_ts());
+            frame_reader.read_samples(SamplesPerFrame, 1, output_sample_spec);
+
+            UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+        }
+
+        packet_writer.write_packets(1, SamplesPerPacket, packet_sample_spec);
+    }
+}
+
+// Integer processing with resampling, both with resampler backend that supports
+// integer formats and with backend that doesn't.
+TEST(receiver_source, integer_sample_rate_mapping) {
+    enum { OutputRate = 48000, PacketRate = 44100, Chans = Chans_Stereo };
+
+    const audio::ResamplerBackend backends[] = { audio::ResamplerBackend_Builtin,
+                                                 audio::ResamplerBackend_Slip };
+
+    for (size_t n_back = 0; n_back < ROC_ARRAY_SIZE(backends); n_back++) {
+        init(OutputRate, Chans, PacketRate, Chans);
+
+        ReceiverSourceConfig config = make_default_config();
+        config.common.processing_format = audio::PcmFormat_SInt16;
+        config.session_defaults.resampler.backend = backends[n_back];
+
+        ReceiverSource receiver(config, encoding_map, sinc_table_map, packet_pool,
+                                packet_buffer_pool, frame_buffer_pool, arena);
+        CHECK(receiver.is_valid());
+
+        ReceiverSlot* slot = create_slot(receiver);
+        CHECK(slot);
+
+        packet::IWriter* endpoint1_writer = create_transport_endpoint(
+            slot, address::Iface_AudioSource, proto1, dst_addr1);
+        CHECK(endpoint1_writer);
+
+        test::FrameReader frame_reader(receiver, frame_factory);
+
+        test::PacketWriter packet_writer(arena, *endpoint1_writer, encoding_map,
+                                         packet_factory, src_id1, src_addr1, dst_addr1,
+                                         PayloadType_Ch2);
+
+        packet_writer.write_packets(Latency / SamplesPerPacket, SamplesPerPacket,
+                                    packet_sample_spec);
+
+        for (size_t np = 0; np < ManyPackets; np++) {
+            for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+                receiver.refresh(frame_reader.refresh_ts());
+                frame_reader.read_nonzero_samples(
+                    SamplesPerFrame * OutputRate / PacketRate
+                        / output_sample_spec.num_channels()
+                        * output_sample_spec.num_channels(),
+                    output_sample_spec);
+
+                UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+            }
+
+            packet_writer.write_packets(1, SamplesPerPacket, packet_sample_spec);
+        }
+    }
+}
+
+// Integer processing can't be combined with planar layout, and only
+// native-endian integer formats are supported.
+TEST(receiver_source, integer_invalid_config) {
+    enum { Rate = SampleRate, Chans = Chans_Stereo };
+
+    init(Rate, Chans, Rate, Chans);
+
+    {
+        ReceiverSourceConfig config = make_default_config();
+        config.common.processing_format = audio::PcmFormat_SInt16;
+        config.common.processing_layout = audio::SampleLayout_Planar;
+
+        ReceiverSource receiver(config, encoding_map, sinc_table_map, packet_pool,
+                                packet_buffer_pool, frame_buffer_pool, arena);
+        CHECK(!receiver.is_valid());
+    }
+    {
+        ReceiverSourceConfig config = make_default_config();
+        config.common.processing_format = audio::PcmFormat_SInt16_Be;
+
+        ReceiverSource receiver(config, encoding_map, sinc_table_map, packet_pool,
+                                packet_buffer_pool, frame_buffer_pool, arena);
+        CHECK(!receiver.is_valid());
+    }
+}
+
+// When there are no control packets, receiver always sets CTS of frames to zero.
+TEST(receiver_source, timestamp_mapping_no_control_packets) {
+    enum { Rate = SampleRate, Chans = Chans_Stereo };
+
+    init(Rate, Chans, Rate, Chans);
+
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
+    CHECK(receiver.is_valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* transport_endpoint = create_transport_endpoint(
+        slot, address::Iface_AudioSource, address::Proto_RTP, dst_addr1);
+    CHECK(transport_endpoint);
 
     packet::Queue control_outbound_queue;
     packet::IWriter* control_endpoint =
@@ -1878,8 +2457,8 @@ TEST(receiver_source, timestamp_mapping_one_control_packet) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -1947,8 +2526,8 @@ TEST(receiver_source, timestamp_mapping_periodic_control_packets) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -2021,8 +2600,8 @@ TEST(receiver_source, timestamp_mapping_remixing) {
 
     init(OutputRate, OutputChans, PacketRate, PacketChans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -2106,8 +2685,8 @@ TEST(receiver_source, metrics_participants) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -2220,8 +2799,8 @@ TEST(receiver_source, metrics_truncation) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -2313,6 +2892,240 @@ TEST(receiver_source, metrics_truncation) {
     }
 }
 
+// Check that metrics snapshot, which is published by pipeline during
+// refresh and can be read from any thread, matches metrics queried
+// directly from pipeline thread.
+TEST(receiver_source, metrics_snapshot) {
+    enum { Rate = SampleRate, Chans = Chans_Stereo, MaxParties = 10 };
+
+    init(Rate, Chans, Rate, Chans);
+
+    ReceiverSourceConfig config = make_default_config();
+    config.common.metrics_interval = 0;
+
+    ReceiverSource receiver(config, encoding_map, sinc_table_map, packet_pool,
+                            packet_buffer_pool, frame_buffer_pool, arena);
+    CHECK(receiver.is_valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    {
+        // Snapshot is published when slot is created.
+        ReceiverSlotMetrics slot_metrics;
+        ReceiverParticipantMetrics party_metrics[MaxParties];
+        size_t party_metrics_size = MaxParties;
+
+        CHECK(slot->load_metrics(slot_metrics, party_metrics, &party_metrics_size));
+
+        CHECK(slot_metrics.source_id != 0);
+        UNSIGNED_LONGS_EQUAL(0, slot_metrics.num_participants);
+        UNSIGNED_LONGS_EQUAL(0, party_metrics_size);
+    }
+
+    packet::IWriter* endpoint1_writer =
+        create_transport_endpoint(slot, address::Iface_AudioSource, proto1, dst_addr1);
+    CHECK(endpoint1_writer);
+
+    test::FrameReader frame_reader(receiver, frame_factory);
+
+    test::PacketWriter packet_writer1(arena, *endpoint1_writer, encoding_map,
+                                      packet_factory, src_id1, src_addr1, dst_addr1,
+                                      PayloadType_Ch2);
+
+    packet_writer1.write_packets(Latency / SamplesPerPacket, SamplesPerPacket,
+                                 output_sample_spec);
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            // with zero interval, snapshot is republished on every refresh
+            receiver.refresh(frame_reader.refresh_ts());
+
+            ReceiverSlotMetrics expected_slot_metrics;
+            ReceiverParticipantMetrics expected_party_metrics[MaxParties];
+            size_t expected_party_metrics_size = MaxParties;
+
+            slot->get_metrics(expected_slot_metrics, expected_party_metrics,
+                              &expected_party_metrics_size);
+
+            ReceiverSlotMetrics slot_metrics;
+            ReceiverParticipantMetrics party_metrics[MaxParties];
+            size_t party_metrics_size = MaxParties;
+
+            CHECK(slot->load_metrics(slot_metrics, party_metrics, &party_metrics_size));
+
+            UNSIGNED_LONGS_EQUAL(expected_slot_metrics.source_id,
+                                 slot_metrics.source_id);
+            UNSIGNED_LONGS_EQUAL(1, slot_metrics.num_participants);
+            UNSIGNED_LONGS_EQUAL(1, party_metrics_size);
+
+            LONGLONGS_EQUAL(expected_party_metrics[0].latency.niq_latency,
+                            party_metrics[0].latency.niq_latency);
+            LONGLONGS_EQUAL(expected_party_metrics[0].link.total_packets,
+                            party_metrics[0].link.total_packets);
+            DOUBLES_EQUAL(1.0, party_metrics[0].resampler_scaling, 0.01);
+
+            frame_reader.read_nonzero_samples(SamplesPerFrame, output_sample_spec);
+        }
+
+        packet_writer1.write_packets(1, SamplesPerPacket, output_sample_spec);
+    }
+}
+
+// Check that metrics snapshot is republished on refresh when number of
+// participants changes or when it becomes older than configured interval.
+TEST(receiver_source, metrics_snapshot_interval) {
+    enum { Rate = SampleRate, Chans = Chans_Stereo, MaxParties = 10 };
+
+    init(Rate, Chans, Rate, Chans);
+
+    ReceiverSourceConfig config = make_default_config();
+    config.common.metrics_interval = core::Hour;
+
+    ReceiverSource receiver(config, encoding_map, sinc_table_map, packet_pool,
+                            packet_buffer_pool, frame_buffer_pool, arena);
+    CHECK(receiver.is_valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint1_writer =
+        create_transport_endpoint(slot, address::Iface_AudioSource, proto1, dst_addr1);
+    CHECK(endpoint1_writer);
+
+    test::FrameReader frame_reader(receiver, frame_factory);
+
+    test::PacketWriter packet_writer1(arena, *endpoint1_writer, encoding_map,
+                                      packet_factory, src_id1, src_addr1, dst_addr1,
+                                      PayloadType_Ch2);
+
+    packet_writer1.write_packets(Latency / SamplesPerPacket, SamplesPerPacket,
+                                 output_sample_spec);
+
+    // first refresh publishes snapshot because it's older than interval
+    // (or because session was created)
+    receiver.refresh(frame_reader.refresh_ts());
+
+    uint64_t published_total_packets = 0;
+
+    {
+        ReceiverSlotMetrics slot_metrics;
+        ReceiverParticipantMetrics party_metrics[MaxParties];
+        size_t party_metrics_size = MaxParties;
+
+        CHECK(slot->load_metrics(slot_metrics, party_metrics, &party_metrics_size));
+
+        UNSIGNED_LONGS_EQUAL(1, slot_metrics.num_participants);
+        UNSIGNED_LONGS_EQUAL(1, party_metrics_size);
+
+        published_total_packets = party_metrics[0].link.total_packets;
+    }
+
+    frame_reader.read_nonzero_samples(SamplesPerFrame, output_sample_spec);
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        packet_writer1.write_packets(1, SamplesPerPacket, output_sample_spec);
+
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            receiver.refresh(frame_reader.refresh_ts());
+            frame_reader.read_nonzero_samples(SamplesPerFrame, output_sample_spec);
+        }
+    }
+
+    {
+        // Snapshot is younger than interval and number of participants
+        // didn't change, so it's not republished.
+        ReceiverSlotMetrics slot_metrics;
+        ReceiverParticipantMetrics party_metrics[MaxParties];
+        size_t party_metrics_size = MaxParties;
+
+        CHECK(slot->load_metrics(slot_metrics, party_metrics, &party_metrics_size));
+
+        UNSIGNED_LONGS_EQUAL(1, party_metrics_size);
+        LONGLONGS_EQUAL(published_total_packets, party_metrics[0].link.total_packets);
+    }
+
+    receiver.refresh(frame_reader.refresh_ts() + core::Hour);
+
+    {
+        // Snapshot became older than interval and is republished.
+        ReceiverSlotMetrics expected_slot_metrics;
+        ReceiverParticipantMetrics expected_party_metrics[MaxParties];
+        size_t expected_party_metrics_size = MaxParties;
+
+        slot->get_metrics(expected_slot_metrics, expected_party_metrics,
+                          &expected_party_metrics_size);
+
+        ReceiverSlotMetrics slot_metrics;
+        ReceiverParticipantMetrics party_metrics[MaxParties];
+        size_t party_metrics_size = MaxParties;
+
+        CHECK(slot->load_metrics(slot_metrics, party_metrics, &party_metrics_size));
+
+        UNSIGNED_LONGS_EQUAL(1, party_metrics_size);
+        CHECK(party_metrics[0].link.total_packets > published_total_packets);
+        LONGLONGS_EQUAL(expected_party_metrics[0].link.total_packets,
+                        party_metrics[0].link.total_packets);
+    }
+}
+
+// Check that metrics snapshot is not limited in number of participants.
+TEST(receiver_source, metrics_snapshot_many_participants) {
+    enum {
+        Rate = SampleRate,
+        Chans = Chans_Stereo,
+        NumParties = 40,
+        MaxParties = NumParties * 2
+    };
+
+    init(Rate, Chans, Rate, Chans);
+
+    ReceiverSourceConfig config = make_default_config();
+    config.common.metrics_interval = core::Hour;
+
+    ReceiverSource receiver(config, encoding_map, sinc_table_map, packet_pool,
+                            packet_buffer_pool, frame_buffer_pool, arena);
+    CHECK(receiver.is_valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint1_writer =
+        create_transport_endpoint(slot, address::Iface_AudioSource, proto1, dst_addr1);
+    CHECK(endpoint1_writer);
+
+    for (size_t n = 0; n < NumParties; n++) {
+        test::PacketWriter packet_writer(arena, *endpoint1_writer, encoding_map,
+                                         packet_factory, src_id1 + n,
+                                         test::new_address(100 + (int)n), dst_addr1,
+                                         PayloadType_Ch2);
+
+        packet_writer.write_packets(1, SamplesPerPacket, output_sample_spec);
+    }
+
+    test::FrameReader frame_reader(receiver, frame_factory);
+
+    // sessions are created during refresh, which also republishes snapshot
+    // because number of participants changed
+    receiver.refresh(frame_reader.refresh_ts());
+    frame_reader.read_any_samples(SamplesPerFrame, output_sample_spec);
+
+    UNSIGNED_LONGS_EQUAL(NumParties, receiver.num_sessions());
+
+    ReceiverSlotMetrics slot_metrics;
+    ReceiverParticipantMetrics party_metrics[MaxParties];
+    size_t party_metrics_size = MaxParties;
+
+    CHECK(slot->load_metrics(slot_metrics, party_metrics, &party_metrics_size));
+
+    UNSIGNED_LONGS_EQUAL(NumParties, slot_metrics.num_participants);
+    UNSIGNED_LONGS_EQUAL(NumParties, party_metrics_size);
+
+    for (size_t n = 0; n < NumParties; n++) {
+        CHECK(party_metrics[n].source_id != 0);
+    }
+}
+
 // Check how receiver computes packet metrics:
 // total_packets, lost_packets, ext_first_seqnum, ext_last_seqnum
 IGNORE_TEST(receiver_source, metrics_packet_counters) {
@@ -2333,8 +3146,8 @@ TEST(receiver_source, metrics_niq_latency) {
     const core::nanoseconds_t virtual_niq_latency =
         output_sample_spec.samples_per_chan_2_ns(Latency);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -2389,8 +3202,8 @@ TEST(receiver_source, metrics_e2e_latency) {
 
     const core::nanoseconds_t virtual_e2e_latency = core::Millisecond * 555;
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -2478,8 +3291,8 @@ TEST(receiver_source, reports_no_senders) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -2515,8 +3328,8 @@ TEST(receiver_source, reports_one_sender) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -2610,8 +3423,8 @@ TEST(receiver_source, reports_two_senders_unicast) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -2744,8 +3557,8 @@ TEST(receiver_source, reports_two_senders_multicast) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -2856,8 +3669,8 @@ TEST(receiver_source, pipeline_state) {
 
     init(Rate, Chans, Rate, Chans);
 
-    ReceiverSource receiver(make_default_config(), encoding_map, packet_pool,
-                            packet_buffer_pool, frame_buffer_pool, arena);
+    ReceiverSource receiver(make_default_config(), encoding_map, sinc_table_map,
+                            packet_pool, packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(receiver.is_valid());
 
     ReceiverSlot* slot = create_slot(receiver);
@@ -32,6 +32,7 @@ packet::PacketFactory packet_factory(arena, PacketSz);
 audio::FrameFactory frame_factory(arena, PacketSz * sizeof(audio::sample_t));
 
 rtp::EncodingMap encoding_map(arena);
+audio::SincTableMap sinc_table_map(arena);
 
 } // namespace
 
@@ -43,11 +44,11 @@ TEST(sender_endpoint, valid) {
 
     SenderSinkConfig sink_config;
     StateTracker state_tracker;
-    SenderSession session(sink_config, encoding_map, packet_factory, frame_factory,
-                          arena);
+    SenderSession session(sink_config, encoding_map, sinc_table_map, packet_factory,
+                          frame_factory, arena);
 
-    SenderEndpoint endpoint(address::Proto_RTP, state_tracker, session, addr, queue,
-                            arena);
+    SenderEndpoint endpoint(address::Proto_RTP, sink_config, state_tracker, session, addr,
+                            queue, arena);
     CHECK(endpoint.is_valid());
 }
 
@@ -58,11 +59,11 @@ TEST(sender_endpoint, invalid_proto) {
 
     SenderSinkConfig sink_config;
     StateTracker state_tracker;
-    SenderSession session(sink_config, encoding_map, packet_factory, frame_factory,
-                          arena);
+    SenderSession session(sink_config, encoding_map, sinc_table_map, packet_factory,
+                          frame_factory, arena);
 
-    SenderEndpoint endpoint(address::Proto_None, state_tracker, session, addr, queue,
-                            arena);
+    SenderEndpoint endpoint(address::Proto_None, sink_config, state_tracker, session,
+                            addr, queue, arena);
     CHECK(!endpoint.is_valid());
 }
 
@@ -80,14 +81,48 @@ TEST(sender_endpoint, no_memory) {
 
         SenderSinkConfig sink_config;
         StateTracker state_tracker;
-        SenderSession session(sink_config, encoding_map, packet_factory, frame_factory,
-                              arena);
+        SenderSession session(sink_config, encoding_map, sinc_table_map, packet_factory,
+                              frame_factory, arena);
 
-        SenderEndpoint endpoint(protos[n], state_tracker, session, addr, queue,
-                                core::NoopArena);
+        SenderEndpoint endpoint(protos[n], sink_config, state_tracker, session, addr,
+                                queue, core::NoopArena);
         CHECK(!endpoint.is_valid());
     }
 }
 
+TEST(sender_endpoint, pacing) {
+    address::SocketAddr addr;
+    packet::Queue queue;
+
+    SenderSinkConfig sink_config;
+    sink_config.enable_pacing = true;
+    StateTracker state_tracker;
+    SenderSession session(sink_config, encoding_map, sinc_table_map, packet_factory,
+                          frame_factory, arena);
+
+    SenderEndpoint endpoint(address::Proto_RTP, sink_config, state_tracker, session, addr,
+                            queue, arena);
+    CHECK(endpoint.is_valid());
+
+    packet::PacketPtr pp = packet_factory.new_packet();
+    CHECK(pp);
+    pp->add_flags(packet::Packet::FlagAudio | packet::Packet::FlagPrepared
+                  | packet::Packet::FlagComposed);
+    pp->set_buffer(packet_factory.new_packet_buffer());
+
+    LONGS_EQUAL(status::StatusOK, endpoint.outbound_writer().write(pp));
+
+    // packet is delayed by pacer
+    UNSIGNED_LONGS_EQUAL(0, queue.size());
+    UNSIGNED_LONGS_EQUAL(1, endpoint.pacer_metrics().queue_depth);
+
+    LONGS_EQUAL(status::StatusOK, endpoint.push_packets(core::Second));
+
+    // packet is sent
+    UNSIGNED_LONGS_EQUAL(1, queue.size());
+    UNSIGNED_LONGS_EQUAL(0, endpoint.pacer_metrics().queue_depth);
+    LONGS_EQUAL(0, endpoint.push_deadline());
+}
+
 } // namespace pipeline
 } // namespace roc
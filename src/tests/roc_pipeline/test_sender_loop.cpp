@@ -34,6 +34,7 @@ core::SlabPool<core::Buffer>
                       sizeof(core::Buffer) + MaxBufSize * sizeof(audio::sample_t));
 
 rtp::EncodingMap encoding_map(arena);
+audio::SincTableMap sinc_table_map(arena);
 
 class TaskIssuer : public IPipelineTaskCompleter {
 public:
@@ -121,8 +122,8 @@ TEST_GROUP(sender_loop) {
 };
 
 TEST(sender_loop, endpoints_sync) {
-    SenderLoop sender(scheduler, config, encoding_map, packet_pool, packet_buffer_pool,
-                      frame_buffer_pool, arena);
+    SenderLoop sender(scheduler, config, encoding_map, sinc_table_map, packet_pool,
+                      packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(sender.is_valid());
 
     SenderLoop::SlotHandle slot = NULL;
@@ -157,8 +158,8 @@ TEST(sender_loop, endpoints_sync) {
 }
 
 TEST(sender_loop, endpoints_async) {
-    SenderLoop sender(scheduler, config, encoding_map, packet_pool, packet_buffer_pool,
-                      frame_buffer_pool, arena);
+    SenderLoop sender(scheduler, config, encoding_map, sinc_table_map, packet_pool,
+                      packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(sender.is_valid());
 
     TaskIssuer ti(sender);
@@ -169,5 +170,40 @@ TEST(sender_loop, endpoints_async) {
     scheduler.wait_done();
 }
 
+TEST(sender_loop, slot_metrics) {
+    SenderLoop sender(scheduler, config, encoding_map, sinc_table_map, packet_pool,
+                      packet_buffer_pool, frame_buffer_pool, arena);
+    CHECK(sender.is_valid());
+
+    SenderLoop::SlotHandle slot = NULL;
+
+    {
+        SenderSlotConfig config;
+        SenderLoop::Tasks::CreateSlot task(config);
+        CHECK(sender.schedule_and_wait(task));
+        CHECK(task.success());
+
+        slot = task.get_handle();
+    }
+
+    {
+        // Snapshot is published when slot is created, and is read
+        // without waiting for pipeline.
+        SenderSlotMetrics slot_metrics;
+        size_t party_count = 0;
+        CHECK(sender.load_slot_metrics(slot, slot_metrics, NULL, &party_count));
+
+        CHECK(slot_metrics.source_id != 0);
+        UNSIGNED_LONGS_EQUAL(0, slot_metrics.num_participants);
+        UNSIGNED_LONGS_EQUAL(0, party_count);
+    }
+
+    {
+        SenderLoop::Tasks::DeleteSlot task(slot);
+        CHECK(sender.schedule_and_wait(task));
+        CHECK(task.success());
+    }
+}
+
 } // namespace pipeline
 } // namespace roc
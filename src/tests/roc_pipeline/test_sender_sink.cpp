@@ -77,6 +77,7 @@ packet::PacketFactory packet_factory(packet_pool, packet_buffer_pool);
 audio::FrameFactory frame_factory(frame_buffer_pool);
 
 rtp::EncodingMap encoding_map(arena);
+audio::SincTableMap sinc_table_map(arena);
 
 SenderSlot* create_slot(SenderSink& sink) {
     SenderSlotConfig slot_config;
@@ -189,8 +190,8 @@ TEST(sender_sink, basic) {
 
     packet::Queue queue;
 
-    SenderSink sender(make_config(), encoding_map, packet_pool, packet_buffer_pool,
-                      frame_buffer_pool, arena);
+    SenderSink sender(make_config(), encoding_map, sinc_table_map, packet_pool,
+                      packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(sender.is_valid());
 
     SenderSlot* slot = create_slot(sender);
@@ -228,8 +229,8 @@ TEST(sender_sink, frame_size_small) {
 
     packet::Queue queue;
 
-    SenderSink sender(make_config(), encoding_map, packet_pool, packet_buffer_pool,
-                      frame_buffer_pool, arena);
+    SenderSink sender(make_config(), encoding_map, sinc_table_map, packet_pool,
+                      packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(sender.is_valid());
 
     SenderSlot* slot = create_slot(sender);
@@ -267,8 +268,8 @@ TEST(sender_sink, frame_size_large) {
 
     packet::Queue queue;
 
-    SenderSink sender(make_config(), encoding_map, packet_pool, packet_buffer_pool,
-                      frame_buffer_pool, arena);
+    SenderSink sender(make_config(), encoding_map, sinc_table_map, packet_pool,
+                      packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(sender.is_valid());
 
     SenderSlot* slot = create_slot(sender);
@@ -300,8 +301,8 @@ TEST(sender_sink, channel_mapping_stereo_to_mono) {
 
     packet::Queue queue;
 
-    SenderSink sender(make_config(), encoding_map, packet_pool, packet_buffer_pool,
-                      frame_buffer_pool, arena);
+    SenderSink sender(make_config(), encoding_map, sinc_table_map, packet_pool,
+                      packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(sender.is_valid());
 
     SenderSlot* slot = create_slot(sender);
@@ -333,8 +334,8 @@ TEST(sender_sink, channel_mapping_mono_to_stereo) {
 
     packet::Queue queue;
 
-    SenderSink sender(make_config(), encoding_map, packet_pool, packet_buffer_pool,
-                      frame_buffer_pool, arena);
+    SenderSink sender(make_config(), encoding_map, sinc_table_map, packet_pool,
+                      packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(sender.is_valid());
 
     SenderSlot* slot = create_slot(sender);
@@ -366,8 +367,8 @@ TEST(sender_sink, sample_rate_mapping) {
 
     packet::Queue queue;
 
-    SenderSink sender(make_config(), encoding_map, packet_pool, packet_buffer_pool,
-                      frame_buffer_pool, arena);
+    SenderSink sender(make_config(), encoding_map, sinc_table_map, packet_pool,
+                      packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(sender.is_valid());
 
     SenderSlot* slot = create_slot(sender);
@@ -401,8 +402,8 @@ TEST(sender_sink, timestamp_mapping) {
 
     packet::Queue queue;
 
-    SenderSink sender(make_config(), encoding_map, packet_pool, packet_buffer_pool,
-                      frame_buffer_pool, arena);
+    SenderSink sender(make_config(), encoding_map, sinc_table_map, packet_pool,
+                      packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(sender.is_valid());
 
     SenderSlot* slot = create_slot(sender);
@@ -440,8 +441,8 @@ TEST(sender_sink, timestamp_mapping_remixing) {
 
     packet::Queue queue;
 
-    SenderSink sender(make_config(), encoding_map, packet_pool, packet_buffer_pool,
-                      frame_buffer_pool, arena);
+    SenderSink sender(make_config(), encoding_map, sinc_table_map, packet_pool,
+                      packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(sender.is_valid());
 
     SenderSlot* slot = create_slot(sender);
@@ -501,8 +502,8 @@ TEST(sender_sink, metrics_feedback) {
 
     packet::Queue queue;
 
-    SenderSink sender(make_config(), encoding_map, packet_pool, packet_buffer_pool,
-                      frame_buffer_pool, arena);
+    SenderSink sender(make_config(), encoding_map, sinc_table_map, packet_pool,
+                      packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(sender.is_valid());
 
     SenderSlot* slot = create_slot(sender);
@@ -629,8 +630,8 @@ TEST(sender_sink, reports_no_receivers) {
 
     packet::Queue queue;
 
-    SenderSink sender(make_config(), encoding_map, packet_pool, packet_buffer_pool,
-                      frame_buffer_pool, arena);
+    SenderSink sender(make_config(), encoding_map, sinc_table_map, packet_pool,
+                      packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(sender.is_valid());
 
     SenderSlot* slot = create_slot(sender);
@@ -698,8 +699,8 @@ TEST(sender_sink, reports_one_receiver) {
 
     packet::Queue queue;
 
-    SenderSink sender(make_config(), encoding_map, packet_pool, packet_buffer_pool,
-                      frame_buffer_pool, arena);
+    SenderSink sender(make_config(), encoding_map, sinc_table_map, packet_pool,
+                      packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(sender.is_valid());
 
     SenderSlot* slot = create_slot(sender);
@@ -786,8 +787,8 @@ TEST(sender_sink, reports_two_receivers) {
 
     packet::Queue queue;
 
-    SenderSink sender(make_config(), encoding_map, packet_pool, packet_buffer_pool,
-                      frame_buffer_pool, arena);
+    SenderSink sender(make_config(), encoding_map, sinc_table_map, packet_pool,
+                      packet_buffer_pool, frame_buffer_pool, arena);
     CHECK(sender.is_valid());
 
     SenderSlot* slot = create_slot(sender);
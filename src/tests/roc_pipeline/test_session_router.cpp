@@ -28,6 +28,7 @@ packet::PacketFactory packet_factory(arena, MaxBufSize);
 audio::FrameFactory frame_factory(arena, MaxBufSize * sizeof(audio::sample_t));
 
 rtp::EncodingMap encoding_map(arena);
+audio::SincTableMap sinc_table_map(arena);
 
 } // namespace
 
@@ -62,10 +63,12 @@ TEST_GROUP(session_router) {
 
             sess1 =
                 new (arena) ReceiverSession(session_config, common_config, encoding_map,
-                                            packet_factory, frame_factory, arena);
+                                            sinc_table_map, packet_factory,
+                                            frame_factory, arena);
             sess2 =
                 new (arena) ReceiverSession(session_config, common_config, encoding_map,
-                                            packet_factory, frame_factory, arena);
+                                            sinc_table_map, packet_factory,
+                                            frame_factory, arena);
         }
     }
 };
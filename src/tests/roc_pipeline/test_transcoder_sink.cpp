@@ -34,6 +34,8 @@ const audio::ChannelMask Chans_Stereo = audio::ChanMask_Surround_Stereo;
 
 core::HeapArena arena;
 
+audio::SincTableMap sinc_table_map(arena);
+
 core::SlabPool<core::Buffer> buffer_pool("frame_buffer_pool",
                                          arena,
                                          sizeof(core::Buffer)
@@ -80,7 +82,7 @@ TEST(transcoder_sink, null) {
 
     init(Rate, Chans, Rate, Chans);
 
-    TranscoderSink transcoder(make_config(), NULL, buffer_pool, arena);
+    TranscoderSink transcoder(make_config(), NULL, sinc_table_map, buffer_pool, arena);
     CHECK(transcoder.is_valid());
 
     test::FrameWriter frame_writer(transcoder, frame_factory);
@@ -97,7 +99,8 @@ TEST(transcoder_sink, write) {
 
     test::MockSink mock_sink(output_sample_spec);
 
-    TranscoderSink transcoder(make_config(), &mock_sink, buffer_pool, arena);
+    TranscoderSink transcoder(make_config(), &mock_sink, sinc_table_map, buffer_pool,
+                              arena);
     CHECK(transcoder.is_valid());
 
     test::FrameWriter frame_writer(transcoder, frame_factory);
@@ -121,7 +124,8 @@ TEST(transcoder_sink, frame_size_small) {
 
     test::MockSink mock_sink(output_sample_spec);
 
-    TranscoderSink transcoder(make_config(), &mock_sink, buffer_pool, arena);
+    TranscoderSink transcoder(make_config(), &mock_sink, sinc_table_map, buffer_pool,
+                              arena);
     CHECK(transcoder.is_valid());
 
     test::FrameWriter frame_writer(transcoder, frame_factory);
@@ -145,7 +149,8 @@ TEST(transcoder_sink, frame_size_large) {
 
     test::MockSink mock_sink(output_sample_spec);
 
-    TranscoderSink transcoder(make_config(), &mock_sink, buffer_pool, arena);
+    TranscoderSink transcoder(make_config(), &mock_sink, sinc_table_map, buffer_pool,
+                              arena);
     CHECK(transcoder.is_valid());
 
     test::FrameWriter frame_writer(transcoder, frame_factory);
@@ -165,7 +170,8 @@ TEST(transcoder_sink, channel_mapping_stereo_to_mono) {
 
     test::MockSink mock_sink(output_sample_spec);
 
-    TranscoderSink transcoder(make_config(), &mock_sink, buffer_pool, arena);
+    TranscoderSink transcoder(make_config(), &mock_sink, sinc_table_map, buffer_pool,
+                              arena);
     CHECK(transcoder.is_valid());
 
     test::FrameWriter frame_writer(transcoder, frame_factory);
@@ -185,7 +191,8 @@ TEST(transcoder_sink, channel_mapping_mono_to_stereo) {
 
     test::MockSink mock_sink(output_sample_spec);
 
-    TranscoderSink transcoder(make_config(), &mock_sink, buffer_pool, arena);
+    TranscoderSink transcoder(make_config(), &mock_sink, sinc_table_map, buffer_pool,
+                              arena);
     CHECK(transcoder.is_valid());
 
     test::FrameWriter frame_writer(transcoder, frame_factory);
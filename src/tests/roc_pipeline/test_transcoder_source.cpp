@@ -34,6 +34,8 @@ const audio::ChannelMask Chans_Stereo = audio::ChanMask_Surround_Stereo;
 
 core::HeapArena arena;
 
+audio::SincTableMap sinc_table_map(arena);
+
 core::SlabPool<core::Buffer> buffer_pool("frame_buffer_pool",
                                          arena,
                                          sizeof(core::Buffer)
@@ -81,7 +83,8 @@ TEST(transcoder_source, state) {
 
     test::MockSource mock_source;
 
-    TranscoderSource transcoder(make_config(), mock_source, buffer_pool, arena);
+    TranscoderSource transcoder(make_config(), mock_source, sinc_table_map, buffer_pool,
+                                arena);
     CHECK(transcoder.is_valid());
 
     mock_source.set_state(sndio::DeviceState_Active);
@@ -98,7 +101,8 @@ TEST(transcoder_source, pause_resume) {
 
     test::MockSource mock_source;
 
-    TranscoderSource transcoder(make_config(), mock_source, buffer_pool, arena);
+    TranscoderSource transcoder(make_config(), mock_source, sinc_table_map, buffer_pool,
+                                arena);
     CHECK(transcoder.is_valid());
 
     transcoder.pause();
@@ -117,7 +121,8 @@ TEST(transcoder_source, pause_restart) {
 
     test::MockSource mock_source;
 
-    TranscoderSource transcoder(make_config(), mock_source, buffer_pool, arena);
+    TranscoderSource transcoder(make_config(), mock_source, sinc_table_map, buffer_pool,
+                                arena);
     CHECK(transcoder.is_valid());
 
     transcoder.pause();
@@ -137,7 +142,8 @@ TEST(transcoder_source, read) {
     test::MockSource mock_source;
     mock_source.add(ManyFrames * SamplesPerFrame, input_sample_spec);
 
-    TranscoderSource transcoder(make_config(), mock_source, buffer_pool, arena);
+    TranscoderSource transcoder(make_config(), mock_source, sinc_table_map, buffer_pool,
+                                arena);
     CHECK(transcoder.is_valid());
 
     test::FrameReader frame_reader(transcoder, frame_factory);
@@ -156,7 +162,8 @@ TEST(transcoder_source, eof) {
 
     test::MockSource mock_source;
 
-    TranscoderSource transcoder(make_config(), mock_source, buffer_pool, arena);
+    TranscoderSource transcoder(make_config(), mock_source, sinc_table_map, buffer_pool,
+                                arena);
     CHECK(transcoder.is_valid());
 
     core::Slice<audio::sample_t> samples = frame_factory.new_raw_buffer();
@@ -177,7 +184,8 @@ TEST(transcoder_source, frame_size_small) {
     test::MockSource mock_source;
     mock_source.add(ManyFrames * SamplesPerSmallFrame, input_sample_spec);
 
-    TranscoderSource transcoder(make_config(), mock_source, buffer_pool, arena);
+    TranscoderSource transcoder(make_config(), mock_source, sinc_table_map, buffer_pool,
+                                arena);
     CHECK(transcoder.is_valid());
 
     test::FrameReader frame_reader(transcoder, frame_factory);
@@ -197,7 +205,8 @@ TEST(transcoder_source, frame_size_large) {
     test::MockSource mock_source;
     mock_source.add(ManyFrames * SamplesPerLargeFrame, input_sample_spec);
 
-    TranscoderSource transcoder(make_config(), mock_source, buffer_pool, arena);
+    TranscoderSource transcoder(make_config(), mock_source, sinc_table_map, buffer_pool,
+                                arena);
     CHECK(transcoder.is_valid());
 
     test::FrameReader frame_reader(transcoder, frame_factory);
@@ -217,7 +226,8 @@ TEST(transcoder_source, channel_mapping_stereo_to_mono) {
     test::MockSource mock_source;
     mock_source.add(ManyFrames * SamplesPerFrame, input_sample_spec);
 
-    TranscoderSource transcoder(make_config(), mock_source, buffer_pool, arena);
+    TranscoderSource transcoder(make_config(), mock_source, sinc_table_map, buffer_pool,
+                                arena);
     CHECK(transcoder.is_valid());
 
     test::FrameReader frame_reader(transcoder, frame_factory);
@@ -237,7 +247,8 @@ TEST(transcoder_source, channel_mapping_mono_to_stereo) {
     test::MockSource mock_source;
     mock_source.add(ManyFrames * SamplesPerFrame, input_sample_spec);
 
-    TranscoderSource transcoder(make_config(), mock_source, buffer_pool, arena);
+    TranscoderSource transcoder(make_config(), mock_source, sinc_table_map, buffer_pool,
+                                arena);
     CHECK(transcoder.is_valid());
 
     test::FrameReader frame_reader(transcoder, frame_factory);
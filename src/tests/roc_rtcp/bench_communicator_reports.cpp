@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/heap_arena.h"
+#include "roc_core/panic.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/queue.h"
+#include "roc_rtcp/communicator.h"
+#include "roc_rtcp/composer.h"
+#include "roc_rtcp/iparticipant.h"
+
+namespace roc {
+namespace rtcp {
+namespace {
+
+enum { MaxPacketSz = 1500, SampleRate = 48000, RecvSsrc = 1, FirstSendSsrc = 1000 };
+
+// How many senders are reported in one batch in batched mode.
+enum { BatchSize = 100 };
+
+const core::nanoseconds_t StartTime = 1000000000000000000;
+
+core::HeapArena arena;
+packet::PacketFactory packet_factory(arena, MaxPacketSz);
+Composer composer;
+
+// Participant with one sending or many receiving streams.
+class BenchParticipant : public IParticipant {
+public:
+    BenchParticipant(packet::stream_source_t source_id,
+                     ParticipantReportMode report_mode,
+                     size_t n_recv_streams)
+        : source_id_(source_id)
+        , report_mode_(report_mode)
+        , n_recv_streams_(n_recv_streams) {
+        report_addr_.set_host_port(address::Family_IPv4, "127.0.0.1", 1);
+    }
+
+    virtual ParticipantInfo participant_info() {
+        ParticipantInfo info;
+        info.cname = "bench_cname";
+        info.source_id = source_id_;
+        info.report_mode = report_mode_;
+        info.report_address = report_addr_;
+        return info;
+    }
+
+    virtual void change_source_id() {
+    }
+
+    virtual bool has_send_stream() {
+        return n_recv_streams_ == 0;
+    }
+
+    virtual SendReport query_send_stream(core::nanoseconds_t report_time) {
+        SendReport report;
+        report.sender_cname = "bench_cname";
+        report.sender_source_id = source_id_;
+        report.report_timestamp = report_time;
+        report.stream_timestamp = 1000;
+        report.sample_rate = SampleRate;
+        report.packet_count = 2000;
+        report.byte_count = 3000;
+        return report;
+    }
+
+    virtual size_t num_recv_streams() {
+        return n_recv_streams_;
+    }
+
+    virtual void query_recv_streams(RecvReport* reports,
+                                    size_t n_reports,
+                                    core::nanoseconds_t report_time) {
+        for (size_t n = 0; n < n_reports; n++) {
+            reports[n] = RecvReport();
+            reports[n].receiver_cname = "bench_cname";
+            reports[n].receiver_source_id = source_id_;
+            reports[n].sender_source_id = packet::stream_source_t(FirstSendSsrc + n);
+            reports[n].report_timestamp = report_time;
+            reports[n].sample_rate = SampleRate;
+            reports[n].ext_first_seqnum = 100;
+            reports[n].ext_last_seqnum = 200;
+            reports[n].packet_count = 100;
+            reports[n].jitter = core::Millisecond;
+            reports[n].niq_latency = core::Millisecond * 50;
+            reports[n].e2e_latency = core::Millisecond * 100;
+        }
+    }
+
+private:
+    packet::stream_source_t source_id_;
+    ParticipantReportMode report_mode_;
+    address::SocketAddr report_addr_;
+    size_t n_recv_streams_;
+};
+
+// Writer that drops packets and counts them.
+class CountingWriter : public packet::IWriter {
+public:
+    CountingWriter()
+        : count_(0) {
+    }
+
+    virtual ROC_ATTR_NODISCARD status::StatusCode write(const packet::PacketPtr&) {
+        count_++;
+        return status::StatusOK;
+    }
+
+    size_t count() const {
+        return count_;
+    }
+
+private:
+    size_t count_;
+};
+
+// Receiver which discovered many senders, each on its own address,
+// so that every report is sent as separate packet.
+void run_bench(benchmark::State& state, size_t batch_size) {
+    const size_t n_senders = (size_t)state.range(0);
+
+    Config config;
+    config.report_batch_size = batch_size;
+    config.inactivity_timeout = core::Second * 3600;
+
+    BenchParticipant recv_part(RecvSsrc, Report_Back, n_senders);
+    CountingWriter recv_writer;
+    Communicator recv_comm(config, recv_part, recv_writer, composer, packet_factory,
+                           arena);
+    roc_panic_if(!recv_comm.is_valid());
+
+    core::nanoseconds_t time = StartTime;
+
+    // Deliver report from every sender to receiver.
+    for (size_t n = 0; n < n_senders; n++) {
+        BenchParticipant send_part(packet::stream_source_t(FirstSendSsrc + n),
+                                   Report_ToAddress, 0);
+        packet::Queue send_queue;
+        Communicator send_comm(config, send_part, send_queue, composer,
+                               packet_factory, arena);
+        roc_panic_if(!send_comm.is_valid());
+        roc_panic_if(send_comm.generate_reports(time) != status::StatusOK);
+
+        packet::PacketPtr pp;
+        roc_panic_if(send_queue.read(pp) != status::StatusOK);
+        roc_panic_if(!pp->udp()->src_addr.set_host_port(address::Family_IPv4,
+                                                        "127.0.0.1", int(10000 + n)));
+
+        roc_panic_if(recv_comm.process_packet(pp, time) != status::StatusOK);
+        time++;
+    }
+
+    while (state.KeepRunning()) {
+        time = std::max(time + 1, recv_comm.generation_deadline(time));
+        roc_panic_if(recv_comm.generate_reports(time) != status::StatusOK);
+    }
+
+    roc_panic_if(recv_comm.total_destinations() != n_senders);
+
+    state.SetItemsProcessed((int64_t)recv_writer.count());
+}
+
+// Reports to all senders are generated at once, every report interval.
+void BM_Communicator_Reports(benchmark::State& state) {
+    run_bench(state, 0);
+}
+
+BENCHMARK(BM_Communicator_Reports)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMicrosecond);
+
+// Reports are generated in batches, spread across report interval.
+void BM_Communicator_ReportsBatched(benchmark::State& state) {
+    run_bench(state, BatchSize);
+}
+
+BENCHMARK(BM_Communicator_ReportsBatched)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace rtcp
+} // namespace roc
@@ -385,6 +385,13 @@ TEST(builder_traverser, rr_sdes_xr) {
     queue_metrics.set_ssrc(1010);
     queue_metrics.set_niq_latency(0xA100000);
     queue_metrics.set_niq_stalling(0xA200000);
+    header::XrRecoveryMetricsBlock recovery_metrics;
+    recovery_metrics.set_metric_flag(header::MetricFlag_CumulativeDuration);
+    recovery_metrics.set_ssrc(1111);
+    recovery_metrics.set_fec_repaired(0xB1);
+    recovery_metrics.set_fec_unrepaired(0xB2);
+    recovery_metrics.set_late_packets(0xB3);
+    recovery_metrics.set_concealed_duration(0xB400000000000004);
 
     // Synthesize part
 
@@ -415,6 +422,7 @@ TEST(builder_traverser, rr_sdes_xr) {
     builder.add_xr_measurement_info(measure_info);
     builder.add_xr_delay_metrics(delay_metrics);
     builder.add_xr_queue_metrics(queue_metrics);
+    builder.add_xr_recovery_metrics(recovery_metrics);
     builder.end_xr();
 
     CHECK(builder.is_ok());
@@ -476,7 +484,7 @@ TEST(builder_traverser, rr_sdes_xr) {
     CHECK_EQUAL(Traverser::Iterator::XR, it.next());
     XrTraverser xr_tr = it.get_xr();
     CHECK(xr_tr.parse());
-    CHECK_EQUAL(5, xr_tr.blocks_count());
+    CHECK_EQUAL(6, xr_tr.blocks_count());
     CHECK_EQUAL(555, xr_tr.packet().ssrc());
     XrTraverser::Iterator xr_it = xr_tr.iter();
 
@@ -517,6 +525,16 @@ TEST(builder_traverser, rr_sdes_xr) {
     CHECK_EQUAL(0xA100000, xr_it.get_queue_metrics().niq_latency());
     CHECK_EQUAL(0xA200000, xr_it.get_queue_metrics().niq_stalling());
 
+    CHECK_EQUAL(XrTraverser::Iterator::RECOVERY_METRICS_BLOCK, xr_it.next());
+    CHECK_EQUAL(header::MetricFlag_CumulativeDuration,
+                xr_it.get_recovery_metrics().metric_flag());
+    CHECK_EQUAL(1111, xr_it.get_recovery_metrics().ssrc());
+    CHECK_EQUAL(0xB1, xr_it.get_recovery_metrics().fec_repaired());
+    CHECK_EQUAL(0xB2, xr_it.get_recovery_metrics().fec_unrepaired());
+    CHECK_EQUAL(0xB3, xr_it.get_recovery_metrics().late_packets());
+    CHECK(xr_it.get_recovery_metrics().has_concealed_duration());
+    CHECK_EQUAL(0xB400000000000004, xr_it.get_recovery_metrics().concealed_duration());
+
     CHECK_EQUAL(XrTraverser::Iterator::END, xr_it.next());
     CHECK_FALSE(xr_it.error());
 
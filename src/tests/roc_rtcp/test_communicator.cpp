@@ -391,6 +391,10 @@ RecvReport make_recv_report(core::nanoseconds_t time,
     report.niq_latency = seed * 500000;
     report.niq_stalling = seed * 600000;
     report.e2e_latency = seed * 7000;
+    report.fec_repaired_packets = seed * 80;
+    report.fec_unrepaired_packets = seed * 90;
+    report.late_packets = seed * 100;
+    report.concealed_duration = seed * 1100000;
     return report;
 }
 
@@ -428,11 +432,20 @@ void expect_recv_report(const RecvReport& report,
         expect_timestamp("niq_stalling", seed * 600000, report.niq_stalling, RttEpsilon);
         expect_timestamp("e2e_latency", seed * 7000, report.e2e_latency,
                          TimestampEpsilon);
+        CHECK_EQUAL(seed * 80, report.fec_repaired_packets);
+        CHECK_EQUAL(seed * 90, report.fec_unrepaired_packets);
+        CHECK_EQUAL(seed * 100, report.late_packets);
+        expect_timestamp("concealed_duration", seed * 1100000,
+                         report.concealed_duration, TimestampEpsilon);
         CHECK(report.rtt >= 0);
     } else {
         CHECK(report.niq_latency == 0);
         CHECK(report.niq_stalling == 0);
         CHECK(report.e2e_latency == 0);
+        CHECK(report.fec_repaired_packets == 0);
+        CHECK(report.fec_unrepaired_packets == 0);
+        CHECK(report.late_packets == 0);
+        CHECK(report.concealed_duration == 0);
         CHECK(report.rtt == 0);
         CHECK(report.clock_offset == 0);
     }
@@ -2901,7 +2914,7 @@ TEST(communicator, split_receiver_report) {
 
 // Bidirectional peer report is too large and is split into multiple packets
 TEST(communicator, split_bidirectional_report) {
-    enum { LocalSsrc = 100, RemoteSsrc = 200, NumReports = 15, NumPackets = 8 };
+    enum { LocalSsrc = 100, RemoteSsrc = 200, NumReports = 15, NumPackets = 15 };
 
     const char* local_cname = "local_cname";
 
@@ -3610,7 +3623,7 @@ TEST(communicator, report_back_combine_reports) {
 // Same as above, but reports to same address are also split into multiple packets
 // because they're too big
 TEST(communicator, report_back_split_reports) {
-    enum { LocalSsrc = 100, NumGroups = 2, PeersPerGroup = 20, PacketsPerGroup = 5 };
+    enum { LocalSsrc = 100, NumGroups = 2, PeersPerGroup = 20, PacketsPerGroup = 10 };
 
     const char* local_cname = "local_cname";
 
@@ -3715,6 +3728,170 @@ TEST(communicator, report_back_split_reports) {
     CHECK_EQUAL(0, local_queue.size());
 }
 
+// Receiver sends reports to multiple senders, and report generation is split
+// into batches, spread evenly across report interval
+TEST(communicator, batched_reports) {
+    enum { RecvSsrc = 11, NumSenders = 3 };
+
+    const char* RecvCname = "recv_cname";
+    const char* SendCnames[NumSenders] = { "send1_cname", "send2_cname", "send3_cname" };
+    const packet::stream_source_t SendSsrcs[NumSenders] = { 22, 33, 44 };
+
+    address::SocketAddr send_addrs[NumSenders];
+    for (size_t n = 0; n < NumSenders; n++) {
+        send_addrs[n] = make_address(int(n + 1) * 111);
+    }
+
+    Config recv_config;
+    recv_config.report_batch_size = 1;
+
+    Config send_config;
+
+    packet::Queue recv_queue;
+    MockParticipant recv_part(RecvCname, RecvSsrc, Report_Back);
+    Communicator recv_comm(recv_config, recv_part, recv_queue, composer,
+                           packet_factory, arena);
+    CHECK(recv_comm.is_valid());
+
+    core::nanoseconds_t recv_time = 10000000000000000;
+    core::nanoseconds_t send_time = 30000000000000000;
+
+    packet::PacketPtr pp;
+
+    // Generate receiver report
+    for (size_t n = 0; n < NumSenders; n++) {
+        recv_part.set_recv_report(
+            n, make_recv_report(recv_time, RecvCname, RecvSsrc, SendSsrcs[n], Seed));
+    }
+    LONGS_EQUAL(status::StatusOK, recv_comm.generate_reports(recv_time));
+    CHECK_EQUAL(0, recv_queue.size());
+
+    advance_time(recv_time);
+    advance_time(send_time);
+
+    // Deliver report from every sender to receiver
+    for (size_t n = 0; n < NumSenders; n++) {
+        packet::Queue send_queue;
+        MockParticipant send_part(SendCnames[n], SendSsrcs[n], Report_ToAddress);
+        Communicator send_comm(send_config, send_part, send_queue, composer,
+                               packet_factory, arena);
+        CHECK(send_comm.is_valid());
+
+        send_part.set_send_report(
+            make_send_report(send_time, SendCnames[n], SendSsrcs[n], Seed));
+        LONGS_EQUAL(status::StatusOK, send_comm.generate_reports(send_time));
+        CHECK_EQUAL(1, send_queue.size());
+
+        pp = read_packet(send_queue);
+        set_src_address(pp, send_addrs[n]);
+        for (size_t i = 0; i < NumSenders; i++) {
+            recv_part.set_recv_report(i,
+                                      make_recv_report(recv_time, RecvCname, RecvSsrc,
+                                                       SendSsrcs[i], Seed));
+        }
+        LONGS_EQUAL(status::StatusOK, recv_comm.process_packet(pp, recv_time));
+
+        CHECK_EQUAL(1, recv_part.pending_notifications());
+        expect_send_report(recv_part.next_send_notification(), send_time,
+                           SendCnames[n], SendSsrcs[n], Seed);
+    }
+
+    advance_time(recv_time);
+
+    for (size_t n = 0; n < NumSenders; n++) {
+        recv_part.set_recv_report(
+            n, make_recv_report(recv_time, RecvCname, RecvSsrc, SendSsrcs[n], Seed));
+    }
+
+    const core::nanoseconds_t round_start = recv_time;
+    bool reported[NumSenders] = {};
+
+    // Every batch generates report for one sender
+    for (size_t batch = 0; batch < NumSenders; batch++) {
+        if (batch == 0) {
+            CHECK(recv_comm.generation_deadline(recv_time) <= recv_time);
+        } else {
+            CHECK_EQUAL(round_start
+                            + recv_config.report_interval * (int)batch / NumSenders,
+                        recv_comm.generation_deadline(recv_time));
+            recv_time = recv_comm.generation_deadline(recv_time);
+        }
+        LONGS_EQUAL(status::StatusOK, recv_comm.generate_reports(recv_time));
+        CHECK_EQUAL(NumSenders, recv_comm.total_destinations());
+        CHECK_EQUAL(1, recv_queue.size());
+
+        pp = read_packet(recv_queue);
+        expect_has_orig_ssrc(pp, RecvSsrc, true);
+
+        for (size_t n = 0; n < NumSenders; n++) {
+            if (pp->udp()->dst_addr == send_addrs[n]) {
+                CHECK(!reported[n]);
+                reported[n] = true;
+                expect_has_dest_ssrc(pp, SendSsrcs[n], true);
+            } else {
+                expect_has_dest_ssrc(pp, SendSsrcs[n], false);
+            }
+        }
+
+        // Nothing is generated until next batch
+        LONGS_EQUAL(status::StatusOK, recv_comm.generate_reports(recv_time + 1));
+        CHECK_EQUAL(0, recv_queue.size());
+    }
+
+    for (size_t n = 0; n < NumSenders; n++) {
+        CHECK(reported[n]);
+    }
+
+    // Next round starts after report interval
+    CHECK_EQUAL(round_start + recv_config.report_interval,
+                recv_comm.generation_deadline(recv_time));
+}
+
+// Report interval is randomized in range [0.5; 1.5] of configured interval
+TEST(communicator, randomized_interval) {
+    enum { SendSsrc = 11, NumReports = 100 };
+
+    const char* SendCname = "send_cname";
+
+    Config config;
+    config.enable_interval_randomization = true;
+
+    packet::Queue send_queue;
+    MockParticipant send_part(SendCname, SendSsrc, Report_ToAddress);
+    Communicator send_comm(config, send_part, send_queue, composer, packet_factory,
+                           arena);
+    CHECK(send_comm.is_valid());
+
+    core::nanoseconds_t send_time = 10000000000000000;
+
+    core::nanoseconds_t min_interval = 0;
+    core::nanoseconds_t max_interval = 0;
+
+    for (size_t n = 0; n < NumReports; n++) {
+        send_part.set_send_report(make_send_report(send_time, SendCname, SendSsrc, Seed));
+        LONGS_EQUAL(status::StatusOK, send_comm.generate_reports(send_time));
+        CHECK_EQUAL(1, send_queue.size());
+        read_packet(send_queue);
+
+        const core::nanoseconds_t interval =
+            send_comm.generation_deadline(send_time) - send_time;
+
+        CHECK(interval >= config.report_interval / 2);
+        CHECK(interval <= config.report_interval * 3 / 2);
+
+        if (n == 0 || interval < min_interval) {
+            min_interval = interval;
+        }
+        if (n == 0 || interval > max_interval) {
+            max_interval = interval;
+        }
+
+        send_time += interval;
+    }
+
+    CHECK(min_interval < max_interval);
+}
+
 // Check how communicator computes RTT and clock offset
 TEST(communicator, rtt) {
     enum { SendSsrc = 11, RecvSsrc = 22, NumIters = 200 };
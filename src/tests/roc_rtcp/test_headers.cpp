@@ -407,6 +407,40 @@ TEST(headers, metrics) {
         CHECK(!blk.has_niq_stalling());
         CHECK_EQUAL(0x0000FFFFFFFF0000, blk.niq_stalling());
     }
+    { // concealed_duration
+        header::XrRecoveryMetricsBlock blk;
+
+        CHECK(!blk.has_concealed_duration());
+        CHECK_EQUAL(0xFFFFFFFFFFFFFFFF, blk.concealed_duration());
+
+        blk.set_concealed_duration(0xAABBCCDD11223344);
+        CHECK(blk.has_concealed_duration());
+        CHECK_EQUAL(0xAABBCCDD11223344, blk.concealed_duration());
+
+        blk.set_concealed_duration(0xFFFFFFFFFFFFFFFF);
+        CHECK(blk.has_concealed_duration());
+        CHECK_EQUAL(0xFFFFFFFFFFFFFFFE, blk.concealed_duration());
+
+        blk.reset();
+
+        CHECK(!blk.has_concealed_duration());
+        CHECK_EQUAL(0xFFFFFFFFFFFFFFFF, blk.concealed_duration());
+    }
+    { // counters
+        header::XrRecoveryMetricsBlock blk;
+
+        CHECK_EQUAL(0, blk.fec_repaired());
+        CHECK_EQUAL(0, blk.fec_unrepaired());
+        CHECK_EQUAL(0, blk.late_packets());
+
+        blk.set_fec_repaired(0xAABBCCDD);
+        blk.set_fec_unrepaired(0x11223344);
+        blk.set_late_packets(0x55667788);
+
+        CHECK_EQUAL(0xAABBCCDD, blk.fec_repaired());
+        CHECK_EQUAL(0x11223344, blk.fec_unrepaired());
+        CHECK_EQUAL(0x55667788, blk.late_packets());
+    }
 }
 
 } // namespace rtcp
@@ -8,6 +8,10 @@
 
 #include <CppUTest/TestHarness.h>
 
+#include "roc_audio/adpcm_decoder.h"
+#include "roc_audio/adpcm_encoder.h"
+#include "roc_audio/lossless_decoder.h"
+#include "roc_audio/lossless_encoder.h"
 #include "roc_audio/pcm_decoder.h"
 #include "roc_audio/pcm_encoder.h"
 #include "roc_audio/pcm_format.h"
@@ -151,5 +155,85 @@ TEST(encoding_map, add_encoding) {
     }
 }
 
+TEST(encoding_map, add_lossless_encoding) {
+    EncodingMap enc_map(arena);
+
+    audio::SampleSpec sample_spec;
+    sample_spec.set_sample_rate(48000);
+    sample_spec.set_sample_format(audio::SampleFormat_Lossless);
+    sample_spec.channel_set().set_layout(audio::ChanLayout_Surround);
+    sample_spec.channel_set().set_order(audio::ChanOrder_Smpte);
+    sample_spec.channel_set().set_mask(audio::ChanMask_Surround_Stereo);
+
+    CHECK(sample_spec.is_valid());
+
+    {
+        Encoding enc;
+        enc.payload_type = (PayloadType)101;
+        enc.packet_flags = packet::Packet::FlagAudio;
+        enc.sample_spec = sample_spec;
+
+        CHECK(enc_map.add_encoding(enc));
+    }
+
+    {
+        const Encoding* enc = enc_map.find_by_pt(101);
+        CHECK(enc);
+
+        LONGS_EQUAL(101, enc->payload_type);
+        CHECK(enc->sample_spec == sample_spec);
+
+        CHECK(enc->new_encoder == &audio::LosslessEncoder::construct);
+        CHECK(enc->new_decoder == &audio::LosslessDecoder::construct);
+    }
+
+    {
+        const Encoding* enc = enc_map.find_by_spec(sample_spec);
+        CHECK(enc);
+
+        LONGS_EQUAL(101, enc->payload_type);
+    }
+}
+
+TEST(encoding_map, add_adpcm_encoding) {
+    EncodingMap enc_map(arena);
+
+    audio::SampleSpec sample_spec;
+    sample_spec.set_sample_rate(48000);
+    sample_spec.set_sample_format(audio::SampleFormat_Adpcm);
+    sample_spec.channel_set().set_layout(audio::ChanLayout_Surround);
+    sample_spec.channel_set().set_order(audio::ChanOrder_Smpte);
+    sample_spec.channel_set().set_mask(audio::ChanMask_Surround_Stereo);
+
+    CHECK(sample_spec.is_valid());
+
+    {
+        Encoding enc;
+        enc.payload_type = (PayloadType)102;
+        enc.packet_flags = packet::Packet::FlagAudio;
+        enc.sample_spec = sample_spec;
+
+        CHECK(enc_map.add_encoding(enc));
+    }
+
+    {
+        const Encoding* enc = enc_map.find_by_pt(102);
+        CHECK(enc);
+
+        LONGS_EQUAL(102, enc->payload_type);
+        CHECK(enc->sample_spec == sample_spec);
+
+        CHECK(enc->new_encoder == &audio::AdpcmEncoder::construct);
+        CHECK(enc->new_decoder == &audio::AdpcmDecoder::construct);
+    }
+
+    {
+        const Encoding* enc = enc_map.find_by_spec(sample_spec);
+        CHECK(enc);
+
+        LONGS_EQUAL(102, enc->payload_type);
+    }
+}
+
 } // namespace rtp
 } // namespace roc
@@ -28,14 +28,18 @@ packet::PacketFactory packet_factory(arena, PacketSz);
 
 EncodingMap encoding_map(arena);
 
-packet::PacketPtr new_packet(packet::seqnum_t sn) {
+packet::PacketPtr new_packet(packet::seqnum_t sn,
+                             packet::stream_timestamp_t sts = 0,
+                             core::nanoseconds_t rts = 0) {
     packet::PacketPtr packet = packet_factory.new_packet();
     CHECK(packet);
 
     packet->add_flags(packet::Packet::FlagRTP | packet::Packet::FlagUDP);
     packet->rtp()->payload_type = PayloadType_L16_Stereo;
     packet->rtp()->seqnum = sn;
+    packet->rtp()->stream_timestamp = sts;
     packet->udp()->queue_timestamp = 666;
+    packet->udp()->receive_timestamp = rts;
 
     return packet;
 }
@@ -113,19 +117,109 @@ TEST(link_meter, last_seqnum_wrap) {
 
     // overflow
     LONGS_EQUAL(status::StatusOK, meter.write(new_packet(2)));
-    UNSIGNED_LONGS_EQUAL(65537, meter.metrics().ext_last_seqnum);
+    UNSIGNED_LONGS_EQUAL(65538, meter.metrics().ext_last_seqnum);
 
     // late packet, ignored
     LONGS_EQUAL(status::StatusOK, meter.write(new_packet(65534)));
-    UNSIGNED_LONGS_EQUAL(65537, meter.metrics().ext_last_seqnum);
+    UNSIGNED_LONGS_EQUAL(65538, meter.metrics().ext_last_seqnum);
 
     // new packet
     LONGS_EQUAL(status::StatusOK, meter.write(new_packet(5)));
-    UNSIGNED_LONGS_EQUAL(65540, meter.metrics().ext_last_seqnum);
+    UNSIGNED_LONGS_EQUAL(65541, meter.metrics().ext_last_seqnum);
 
     UNSIGNED_LONGS_EQUAL(5, queue.size());
 }
 
+TEST(link_meter, lost_packets) {
+    packet::Queue queue;
+    LinkMeter meter(encoding_map);
+    meter.set_writer(queue);
+
+    LONGS_EQUAL(status::StatusOK, meter.write(new_packet(100)));
+    UNSIGNED_LONGS_EQUAL(1, meter.metrics().total_packets);
+    LONGS_EQUAL(0, meter.metrics().lost_packets);
+
+    LONGS_EQUAL(status::StatusOK, meter.write(new_packet(101)));
+    UNSIGNED_LONGS_EQUAL(2, meter.metrics().total_packets);
+    LONGS_EQUAL(0, meter.metrics().lost_packets);
+
+    // 102 and 103 lost
+    LONGS_EQUAL(status::StatusOK, meter.write(new_packet(104)));
+    UNSIGNED_LONGS_EQUAL(5, meter.metrics().total_packets);
+    LONGS_EQUAL(2, meter.metrics().lost_packets);
+
+    // 103 arrived late, not lost anymore
+    LONGS_EQUAL(status::StatusOK, meter.write(new_packet(103)));
+    UNSIGNED_LONGS_EQUAL(5, meter.metrics().total_packets);
+    LONGS_EQUAL(1, meter.metrics().lost_packets);
+
+    // duplicate
+    LONGS_EQUAL(status::StatusOK, meter.write(new_packet(103)));
+    UNSIGNED_LONGS_EQUAL(5, meter.metrics().total_packets);
+    LONGS_EQUAL(0, meter.metrics().lost_packets);
+}
+
+TEST(link_meter, lost_packets_wrap) {
+    packet::Queue queue;
+    LinkMeter meter(encoding_map);
+    meter.set_writer(queue);
+
+    LONGS_EQUAL(status::StatusOK, meter.write(new_packet(65534)));
+    LONGS_EQUAL(status::StatusOK, meter.write(new_packet(65535)));
+    UNSIGNED_LONGS_EQUAL(2, meter.metrics().total_packets);
+    LONGS_EQUAL(0, meter.metrics().lost_packets);
+
+    // overflow, no losses
+    LONGS_EQUAL(status::StatusOK, meter.write(new_packet(0)));
+    UNSIGNED_LONGS_EQUAL(65536, meter.metrics().ext_last_seqnum);
+    UNSIGNED_LONGS_EQUAL(3, meter.metrics().total_packets);
+    LONGS_EQUAL(0, meter.metrics().lost_packets);
+
+    // 1 lost
+    LONGS_EQUAL(status::StatusOK, meter.write(new_packet(2)));
+    UNSIGNED_LONGS_EQUAL(65538, meter.metrics().ext_last_seqnum);
+    UNSIGNED_LONGS_EQUAL(5, meter.metrics().total_packets);
+    LONGS_EQUAL(1, meter.metrics().lost_packets);
+}
+
+TEST(link_meter, jitter) {
+    enum { PacketSamples = 441 };
+
+    const core::nanoseconds_t PacketDur = 10 * core::Millisecond;
+
+    packet::Queue queue;
+    LinkMeter meter(encoding_map);
+    meter.set_writer(queue);
+
+    core::nanoseconds_t rts = 1000000 * core::Second;
+
+    // packets arrive evenly, no jitter
+    for (packet::seqnum_t sn = 0; sn < 100; sn++) {
+        LONGS_EQUAL(status::StatusOK,
+                    meter.write(new_packet(sn, sn * PacketSamples, rts)));
+        rts += PacketDur;
+    }
+    LONGS_EQUAL(0, meter.metrics().jitter);
+
+    // packets arrive with alternating 2ms delay
+    for (packet::seqnum_t sn = 100; sn < 1000; sn++) {
+        LONGS_EQUAL(status::StatusOK,
+                    meter.write(new_packet(sn, sn * PacketSamples,
+                                           rts + (sn % 2) * 2 * core::Millisecond)));
+        rts += PacketDur;
+    }
+    DOUBLES_EQUAL(2 * core::Millisecond, (double)meter.metrics().jitter,
+                  0.01 * core::Millisecond);
+
+    // packets arrive evenly again, jitter decays
+    for (packet::seqnum_t sn = 1000; sn < 1200; sn++) {
+        LONGS_EQUAL(status::StatusOK,
+                    meter.write(new_packet(sn, sn * PacketSamples, rts)));
+        rts += PacketDur;
+    }
+    CHECK(meter.metrics().jitter < 0.01 * core::Millisecond);
+}
+
 TEST(link_meter, forward_error) {
     StatusWriter writer(status::StatusNoMem);
     LinkMeter meter(encoding_map);
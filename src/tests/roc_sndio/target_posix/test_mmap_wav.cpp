@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <stdio.h>
+
+#include "roc_core/heap_arena.h"
+#include "roc_core/temp_file.h"
+#include "roc_sndio/mmap_wav_sink.h"
+#include "roc_sndio/mmap_wav_source.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+enum { SampleRate = 44100, NumChans = 2, FrameSize = 100, NumFrames = 7 };
+
+const double Epsilon = 0.0001;
+
+core::HeapArena arena;
+
+void write_le16(FILE* fp, unsigned v) {
+    fputc(int(v & 0xff), fp);
+    fputc(int((v >> 8) & 0xff), fp);
+}
+
+void write_le32(FILE* fp, unsigned v) {
+    write_le16(fp, v & 0xffff);
+    write_le16(fp, (v >> 16) & 0xffff);
+}
+
+// Write 16-bit PCM WAV file with an extra chunk before data chunk.
+void write_s16_file(const char* path, const int16_t* samples, size_t n_samples) {
+    FILE* fp = fopen(path, "wb");
+    CHECK(fp);
+
+    const unsigned data_size = unsigned(n_samples * 2);
+
+    fwrite("RIFF", 1, 4, fp);
+    write_le32(fp, 4 + (8 + 16) + (8 + 4) + (8 + data_size));
+    fwrite("WAVE", 1, 4, fp);
+
+    fwrite("fmt ", 1, 4, fp);
+    write_le32(fp, 16);
+    write_le16(fp, 1);
+    write_le16(fp, NumChans);
+    write_le32(fp, SampleRate);
+    write_le32(fp, SampleRate * NumChans * 2);
+    write_le16(fp, NumChans * 2);
+    write_le16(fp, 16);
+
+    fwrite("LIST", 1, 4, fp);
+    write_le32(fp, 4);
+    fwrite("INFO", 1, 4, fp);
+
+    fwrite("data", 1, 4, fp);
+    write_le32(fp, data_size);
+    for (size_t n = 0; n < n_samples; n++) {
+        write_le16(fp, (uint16_t)samples[n]);
+    }
+
+    CHECK(fclose(fp) == 0);
+}
+
+Config make_sink_config() {
+    Config config;
+    config.sample_spec =
+        audio::SampleSpec(SampleRate, audio::Sample_RawFormat, audio::ChanLayout_Surround,
+                          audio::ChanOrder_Smpte, audio::ChanMask_Surround_Stereo);
+    return config;
+}
+
+float nth_sample(size_t n) {
+    return float(n % 1000) / 1000.0f - 0.5f;
+}
+
+} // namespace
+
+TEST_GROUP(mmap_wav) {};
+
+TEST(mmap_wav, write_read) {
+    core::TempFile file("test.wav");
+
+    {
+        MmapWavSink sink(arena, make_sink_config());
+        CHECK(sink.is_valid());
+        CHECK(sink.open(file.path()));
+
+        audio::sample_t samples[FrameSize * NumChans];
+
+        for (size_t nf = 0; nf < NumFrames; nf++) {
+            for (size_t ns = 0; ns < FrameSize * NumChans; ns++) {
+                samples[ns] = nth_sample(nf * FrameSize * NumChans + ns);
+            }
+            audio::Frame frame(samples, FrameSize * NumChans);
+            sink.write(frame);
+        }
+    }
+
+    MmapWavSource source(arena, Config());
+    CHECK(source.is_valid());
+    CHECK(source.open(file.path()));
+
+    LONGS_EQUAL(SampleRate, source.sample_spec().sample_rate());
+    LONGS_EQUAL(NumChans, source.sample_spec().num_channels());
+
+    audio::sample_t samples[FrameSize * NumChans];
+
+    for (size_t nf = 0; nf < NumFrames; nf++) {
+        audio::Frame frame(samples, FrameSize * NumChans);
+        CHECK(source.read(frame));
+
+        for (size_t ns = 0; ns < FrameSize * NumChans; ns++) {
+            DOUBLES_EQUAL(nth_sample(nf * FrameSize * NumChans + ns), samples[ns],
+                          Epsilon);
+        }
+    }
+
+    audio::Frame frame(samples, FrameSize * NumChans);
+    CHECK(!source.read(frame));
+}
+
+TEST(mmap_wav, read_s16) {
+    enum { NumSamples = FrameSize * NumChans * 3 / 2 };
+
+    core::TempFile file("test.wav");
+
+    int16_t in_samples[NumSamples];
+    for (size_t n = 0; n < NumSamples; n++) {
+        in_samples[n] = int16_t(int(n * 37 % 65536) - 32768);
+    }
+    write_s16_file(file.path(), in_samples, NumSamples);
+
+    MmapWavSource source(arena, Config());
+    CHECK(source.is_valid());
+    CHECK(source.open(file.path()));
+
+    LONGS_EQUAL(SampleRate, source.sample_spec().sample_rate());
+    LONGS_EQUAL(NumChans, source.sample_spec().num_channels());
+
+    audio::sample_t samples[FrameSize * NumChans];
+
+    {
+        audio::Frame frame(samples, FrameSize * NumChans);
+        CHECK(source.read(frame));
+
+        for (size_t ns = 0; ns < FrameSize * NumChans; ns++) {
+            DOUBLES_EQUAL(in_samples[ns] / 32768.0, samples[ns], Epsilon);
+        }
+    }
+
+    {
+        // last frame is partial and padded with zeros
+        audio::Frame frame(samples, FrameSize * NumChans);
+        CHECK(source.read(frame));
+
+        for (size_t ns = 0; ns < FrameSize * NumChans; ns++) {
+            if (ns < NumSamples - FrameSize * NumChans) {
+                DOUBLES_EQUAL(in_samples[FrameSize * NumChans + ns] / 32768.0,
+                              samples[ns], Epsilon);
+            } else {
+                DOUBLES_EQUAL(0.0, samples[ns], Epsilon);
+            }
+        }
+    }
+
+    audio::Frame frame(samples, FrameSize * NumChans);
+    CHECK(!source.read(frame));
+}
+
+TEST(mmap_wav, restart) {
+    core::TempFile file("test.wav");
+
+    {
+        MmapWavSink sink(arena, make_sink_config());
+        CHECK(sink.open(file.path()));
+
+        audio::sample_t samples[FrameSize * NumChans];
+        for (size_t ns = 0; ns < FrameSize * NumChans; ns++) {
+            samples[ns] = nth_sample(ns);
+        }
+        audio::Frame frame(samples, FrameSize * NumChans);
+        sink.write(frame);
+    }
+
+    MmapWavSource source(arena, Config());
+    CHECK(source.open(file.path()));
+
+    audio::sample_t samples[FrameSize * NumChans];
+
+    for (size_t n = 0; n < 3; n++) {
+        audio::Frame frame(samples, FrameSize * NumChans);
+
+        CHECK(source.read(frame));
+        DOUBLES_EQUAL(nth_sample(0), samples[0], Epsilon);
+        DOUBLES_EQUAL(nth_sample(FrameSize * NumChans - 1),
+                      samples[FrameSize * NumChans - 1], Epsilon);
+
+        CHECK(!source.read(frame));
+        CHECK(!source.read(frame));
+
+        CHECK(source.restart());
+    }
+}
+
+TEST(mmap_wav, open_bad_file) {
+    core::TempFile file("test.wav");
+
+    FILE* fp = fopen(file.path(), "wb");
+    CHECK(fp);
+    fputs("not a wav file at all", fp);
+    CHECK(fclose(fp) == 0);
+
+    {
+        MmapWavSource source(arena, Config());
+        CHECK(source.is_valid());
+        CHECK(!source.open(file.path()));
+    }
+    {
+        MmapWavSource source(arena, Config());
+        CHECK(source.is_valid());
+        CHECK(!source.open("/bad/file"));
+    }
+    {
+        MmapWavSink sink(arena, make_sink_config());
+        CHECK(sink.is_valid());
+        CHECK(!sink.open("/bad/file"));
+    }
+}
+
+} // namespace sndio
+} // namespace roc
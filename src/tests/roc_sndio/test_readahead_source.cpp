@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_arena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_sndio/readahead_source.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+enum { NumSamples = 10000, FrameSize = 300, QueueSize = 3 };
+
+core::HeapArena arena;
+
+audio::sample_t nth_sample(size_t n) {
+    return audio::sample_t(n % 1000) / 1000.0f;
+}
+
+// Source returning fixed number of samples and then EOF.
+class FiniteSource : public ISource, public core::NonCopyable<> {
+public:
+    explicit FiniteSource(bool has_clock = false)
+        : pos_(0)
+        , n_restarts_(0)
+        , has_clock_(has_clock) {
+    }
+
+    virtual ISink* to_sink() {
+        return NULL;
+    }
+
+    virtual ISource* to_source() {
+        return this;
+    }
+
+    virtual DeviceType type() const {
+        return DeviceType_Source;
+    }
+
+    virtual DeviceState state() const {
+        return DeviceState_Active;
+    }
+
+    virtual void pause() {
+    }
+
+    virtual bool resume() {
+        return true;
+    }
+
+    virtual bool restart() {
+        pos_ = 0;
+        n_restarts_++;
+        return true;
+    }
+
+    virtual audio::SampleSpec sample_spec() const {
+        return audio::SampleSpec();
+    }
+
+    virtual core::nanoseconds_t latency() const {
+        return 0;
+    }
+
+    virtual bool has_latency() const {
+        return false;
+    }
+
+    virtual bool has_clock() const {
+        return has_clock_;
+    }
+
+    virtual void reclock(core::nanoseconds_t) {
+    }
+
+    virtual bool read(audio::Frame& frame) {
+        if (pos_ == NumSamples) {
+            return false;
+        }
+
+        size_t ns = 0;
+        for (; ns < frame.num_raw_samples() && pos_ < NumSamples; ns++) {
+            frame.raw_samples()[ns] = nth_sample(pos_++);
+        }
+        for (; ns < frame.num_raw_samples(); ns++) {
+            frame.raw_samples()[ns] = 0;
+        }
+
+        return true;
+    }
+
+    size_t num_restarts() const {
+        return n_restarts_;
+    }
+
+private:
+    size_t pos_;
+    size_t n_restarts_;
+    bool has_clock_;
+};
+
+// Read everything from source using frames of given size and check samples.
+void read_all(ISource& source, size_t frame_size) {
+    audio::sample_t samples[FrameSize * 4];
+    CHECK(frame_size <= FrameSize * 4);
+
+    size_t pos = 0;
+
+    for (;;) {
+        audio::Frame frame(samples, frame_size);
+        if (!source.read(frame)) {
+            break;
+        }
+
+        for (size_t n = 0; n < frame_size; n++, pos++) {
+            if (pos < NumSamples) {
+                DOUBLES_EQUAL(nth_sample(pos), samples[n], 0.0001);
+            } else {
+                DOUBLES_EQUAL(0.0, samples[n], 0.0001);
+            }
+        }
+    }
+
+    // source pads last frame with zeros up to its own frame size
+    CHECK(pos >= NumSamples);
+    CHECK(pos < NumSamples + FrameSize + frame_size);
+
+    audio::Frame frame(samples, frame_size);
+    CHECK(!source.read(frame));
+}
+
+} // namespace
+
+TEST_GROUP(readahead_source) {};
+
+TEST(readahead_source, invalid) {
+    {
+        FiniteSource source;
+        ReadaheadSource readahead(source, arena, 0, QueueSize);
+        CHECK(!readahead.is_valid());
+    }
+    {
+        FiniteSource source;
+        ReadaheadSource readahead(source, arena, FrameSize, 0);
+        CHECK(!readahead.is_valid());
+    }
+    {
+        FiniteSource source(true);
+        ReadaheadSource readahead(source, arena, FrameSize, QueueSize);
+        CHECK(!readahead.is_valid());
+    }
+}
+
+TEST(readahead_source, same_frame_size) {
+    FiniteSource source;
+    ReadaheadSource readahead(source, arena, FrameSize, QueueSize);
+    CHECK(readahead.is_valid());
+
+    read_all(readahead, FrameSize);
+}
+
+TEST(readahead_source, smaller_frames) {
+    FiniteSource source;
+    ReadaheadSource readahead(source, arena, FrameSize, QueueSize);
+    CHECK(readahead.is_valid());
+
+    read_all(readahead, FrameSize / 3 + 1);
+}
+
+TEST(readahead_source, larger_frames) {
+    FiniteSource source;
+    ReadaheadSource readahead(source, arena, FrameSize, QueueSize);
+    CHECK(readahead.is_valid());
+
+    read_all(readahead, FrameSize * 3 + 1);
+}
+
+TEST(readahead_source, restart) {
+    FiniteSource source;
+    ReadaheadSource readahead(source, arena, FrameSize, QueueSize);
+    CHECK(readahead.is_valid());
+
+    // restart in the middle
+    {
+        audio::sample_t samples[FrameSize];
+        audio::Frame frame(samples, FrameSize);
+        CHECK(readahead.read(frame));
+    }
+
+    CHECK(readahead.restart());
+    UNSIGNED_LONGS_EQUAL(1, source.num_restarts());
+
+    read_all(readahead, FrameSize);
+
+    // restart after eof
+    CHECK(readahead.restart());
+    UNSIGNED_LONGS_EQUAL(2, source.num_restarts());
+
+    read_all(readahead, FrameSize);
+}
+
+TEST(readahead_source, destroy_without_reading) {
+    FiniteSource source;
+    ReadaheadSource readahead(source, arena, FrameSize, QueueSize);
+    CHECK(readahead.is_valid());
+}
+
+} // namespace sndio
+} // namespace roc
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "test_helpers/mock_sink.h"
+
+#include "roc_core/heap_arena.h"
+#include "roc_sndio/writebehind_sink.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+enum { FrameSize = 300, QueueSize = 3, NumFrames = 50 };
+
+core::HeapArena arena;
+
+audio::sample_t nth_sample(size_t n) {
+    return audio::sample_t(uint8_t(n)) / audio::sample_t(1 << 8);
+}
+
+void write_frames(ISink& sink, size_t frame_size, size_t num_frames) {
+    audio::sample_t samples[FrameSize * 4];
+    CHECK(frame_size <= FrameSize * 4);
+
+    size_t pos = 0;
+
+    for (size_t nf = 0; nf < num_frames; nf++) {
+        for (size_t ns = 0; ns < frame_size; ns++) {
+            samples[ns] = nth_sample(pos++);
+        }
+
+        audio::Frame frame(samples, frame_size);
+        sink.write(frame);
+    }
+}
+
+} // namespace
+
+TEST_GROUP(writebehind_sink) {};
+
+TEST(writebehind_sink, invalid) {
+    {
+        test::MockSink sink;
+        WritebehindSink writebehind(sink, arena, 0, QueueSize);
+        CHECK(!writebehind.is_valid());
+    }
+    {
+        test::MockSink sink;
+        WritebehindSink writebehind(sink, arena, FrameSize, 0);
+        CHECK(!writebehind.is_valid());
+    }
+}
+
+TEST(writebehind_sink, same_frame_size) {
+    test::MockSink sink;
+
+    {
+        WritebehindSink writebehind(sink, arena, FrameSize, QueueSize);
+        CHECK(writebehind.is_valid());
+
+        write_frames(writebehind, FrameSize, NumFrames);
+    }
+
+    sink.check(0, FrameSize * NumFrames);
+}
+
+TEST(writebehind_sink, smaller_frames) {
+    test::MockSink sink;
+
+    {
+        WritebehindSink writebehind(sink, arena, FrameSize, QueueSize);
+        CHECK(writebehind.is_valid());
+
+        write_frames(writebehind, FrameSize / 3 + 1, NumFrames);
+    }
+
+    sink.check(0, (FrameSize / 3 + 1) * NumFrames);
+}
+
+TEST(writebehind_sink, larger_frames) {
+    test::MockSink sink;
+
+    {
+        WritebehindSink writebehind(sink, arena, FrameSize, QueueSize);
+        CHECK(writebehind.is_valid());
+
+        write_frames(writebehind, FrameSize * 3 + 1, NumFrames);
+    }
+
+    sink.check(0, (FrameSize * 3 + 1) * NumFrames);
+}
+
+TEST(writebehind_sink, destroy_without_writing) {
+    test::MockSink sink;
+
+    {
+        WritebehindSink writebehind(sink, arena, FrameSize, QueueSize);
+        CHECK(writebehind.is_valid());
+    }
+
+    sink.check(0, 0);
+}
+
+} // namespace sndio
+} // namespace roc
@@ -7,22 +7,37 @@
  */
 
 #include "roc_address/io_uri.h"
+#include "roc_audio/sinc_table_map.h"
 #include "roc_core/crash_handler.h"
 #include "roc_core/heap_arena.h"
 #include "roc_core/log.h"
 #include "roc_core/parse_units.h"
+#include "roc_core/optional.h"
 #include "roc_core/scoped_ptr.h"
+#include "roc_core/thread.h"
 #include "roc_pipeline/transcoder_sink.h"
 #include "roc_sndio/backend_dispatcher.h"
 #include "roc_sndio/backend_map.h"
 #include "roc_sndio/config.h"
 #include "roc_sndio/print_supported.h"
 #include "roc_sndio/pump.h"
+#include "roc_sndio/readahead_source.h"
+#include "roc_sndio/writebehind_sink.h"
 
 #include "roc_copy/cmdline.h"
 
 using namespace roc;
 
+namespace {
+
+// Default frame length in batch mode.
+const core::nanoseconds_t BatchFrameLength = 500 * core::Millisecond;
+
+// Number of frames buffered by background I/O threads in batch mode.
+const size_t BatchQueueSize = 4;
+
+} // namespace
+
 int main(int argc, char** argv) {
     core::HeapArena::set_guards(core::HeapArena_DefaultGuards
                                 | core::HeapArena_LeakGuard);
@@ -72,6 +87,10 @@ int main(int argc, char** argv) {
         transcoder_config.input_sample_spec.channel_set());
     source_config.sample_spec.set_sample_rate(0);
 
+    if (args.batch_flag) {
+        source_config.frame_length = BatchFrameLength;
+    }
+
     if (args.frame_len_given) {
         if (!core::parse_duration(args.frame_len_arg, source_config.frame_length)) {
             roc_log(LogError, "invalid --frame-len: bad format");
@@ -144,6 +163,9 @@ int main(int argc, char** argv) {
     case resampler_backend_arg_speexdec:
         transcoder_config.resampler.backend = audio::ResamplerBackend_SpeexDec;
         break;
+    case resampler_backend_arg_slip:
+        transcoder_config.resampler.backend = audio::ResamplerBackend_Slip;
+        break;
     default:
         break;
     }
@@ -162,8 +184,39 @@ int main(int argc, char** argv) {
         break;
     }
 
+    if (args.threads_given) {
+        if (!args.batch_flag) {
+            roc_log(LogError, "--threads can be used only with --batch");
+            return 1;
+        }
+        if (args.threads_arg <= 0) {
+            roc_log(LogError, "invalid --threads: should be > 0");
+            return 1;
+        }
+        transcoder_config.num_threads = (size_t)args.threads_arg;
+    } else if (args.batch_flag) {
+        transcoder_config.num_threads = core::Thread::get_cpu_count();
+    }
+
     transcoder_config.enable_profiling = args.profiling_flag;
 
+    const size_t batch_frame_size =
+        transcoder_config.input_sample_spec.ns_2_samples_overall(
+            source_config.frame_length);
+
+    core::Optional<sndio::ReadaheadSource> readahead_source;
+    sndio::ISource* pump_source = input_source.get();
+
+    if (args.batch_flag) {
+        readahead_source.reset(new (readahead_source) sndio::ReadaheadSource(
+            *input_source, arena, batch_frame_size, BatchQueueSize));
+        if (!readahead_source->is_valid()) {
+            roc_log(LogError, "can't create readahead source");
+            return 1;
+        }
+        pump_source = readahead_source.get();
+    }
+
     audio::IFrameWriter* output_writer = NULL;
 
     sndio::Config sink_config;
@@ -204,14 +257,28 @@ int main(int argc, char** argv) {
         output_writer = output_sink.get();
     }
 
-    pipeline::TranscoderSink transcoder(transcoder_config, output_writer,
+    core::Optional<sndio::WritebehindSink> writebehind_sink;
+
+    if (args.batch_flag && output_sink) {
+        writebehind_sink.reset(new (writebehind_sink) sndio::WritebehindSink(
+            *output_sink, arena, batch_frame_size, BatchQueueSize));
+        if (!writebehind_sink->is_valid()) {
+            roc_log(LogError, "can't create writebehind sink");
+            return 1;
+        }
+        output_writer = writebehind_sink.get();
+    }
+
+    audio::SincTableMap sinc_table_map(arena);
+
+    pipeline::TranscoderSink transcoder(transcoder_config, output_writer, sinc_table_map,
                                         frame_buffer_pool, arena);
     if (!transcoder.is_valid()) {
         roc_log(LogError, "can't create transcoder pipeline");
         return 1;
     }
 
-    sndio::Pump pump(frame_buffer_pool, *input_source, NULL, transcoder,
+    sndio::Pump pump(frame_buffer_pool, *pump_source, NULL, transcoder,
                      source_config.frame_length, transcoder_config.input_sample_spec,
                      sndio::Pump::ModePermanent);
     if (!pump.is_valid()) {
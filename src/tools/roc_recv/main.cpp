@@ -64,6 +64,10 @@ int main(int argc, char** argv) {
         break;
     }
 
+    if (args.log_async_flag) {
+        core::Logger::instance().set_async(true);
+    }
+
     pipeline::ReceiverSourceConfig receiver_config;
 
     sndio::Config io_config;
@@ -116,6 +120,45 @@ int main(int argc, char** argv) {
         }
     }
 
+    if (args.start_latency_given) {
+        if (!core::parse_duration(
+                args.start_latency_arg,
+                receiver_config.session_defaults.latency.start_latency)) {
+            roc_log(LogError, "invalid --start-latency: bad format");
+            return 1;
+        }
+        if (receiver_config.session_defaults.latency.start_latency <= 0) {
+            roc_log(LogError, "invalid --start-latency: should be > 0");
+            return 1;
+        }
+    }
+
+    if (args.min_target_latency_given) {
+        if (!core::parse_duration(
+                args.min_target_latency_arg,
+                receiver_config.session_defaults.latency.min_target_latency)) {
+            roc_log(LogError, "invalid --min-target-latency: bad format");
+            return 1;
+        }
+        if (receiver_config.session_defaults.latency.min_target_latency <= 0) {
+            roc_log(LogError, "invalid --min-target-latency: should be > 0");
+            return 1;
+        }
+    }
+
+    if (args.max_target_latency_given) {
+        if (!core::parse_duration(
+                args.max_target_latency_arg,
+                receiver_config.session_defaults.latency.max_target_latency)) {
+            roc_log(LogError, "invalid --max-target-latency: bad format");
+            return 1;
+        }
+        if (receiver_config.session_defaults.latency.max_target_latency <= 0) {
+            roc_log(LogError, "invalid --max-target-latency: should be > 0");
+            return 1;
+        }
+    }
+
     if (args.latency_tolerance_given) {
         if (!core::parse_duration(
                 args.latency_tolerance_arg,
@@ -177,6 +220,10 @@ int main(int argc, char** argv) {
         receiver_config.session_defaults.latency.tuner_profile =
             audio::LatencyTunerProfile_Gradual;
         break;
+    case latency_profile_arg_adaptive:
+        receiver_config.session_defaults.latency.tuner_profile =
+            audio::LatencyTunerProfile_Adaptive;
+        break;
     case latency_profile_arg_intact:
         receiver_config.session_defaults.latency.tuner_profile =
             audio::LatencyTunerProfile_Intact;
@@ -202,6 +249,9 @@ int main(int argc, char** argv) {
         receiver_config.session_defaults.resampler.backend =
             audio::ResamplerBackend_SpeexDec;
         break;
+    case resampler_backend_arg_slip:
+        receiver_config.session_defaults.resampler.backend = audio::ResamplerBackend_Slip;
+        break;
     default:
         break;
     }
@@ -222,8 +272,87 @@ int main(int argc, char** argv) {
         break;
     }
 
+    switch (args.plc_arg) {
+    case plc_arg_none:
+        receiver_config.session_defaults.plc.backend = audio::PlcBackend_None;
+        break;
+    case plc_arg_pitch:
+        receiver_config.session_defaults.plc.backend = audio::PlcBackend_Pitch;
+        break;
+    default:
+        break;
+    }
+
     receiver_config.session_defaults.enable_beeping = args.beep_flag;
     receiver_config.common.enable_profiling = args.profiling_flag;
+    receiver_config.common.enable_inline_parsing = args.inline_parsing_flag;
+
+    if (args.planar_flag) {
+        receiver_config.common.processing_layout = audio::SampleLayout_Planar;
+    }
+
+    switch (args.processing_format_arg) {
+    case processing_format_arg_s16:
+        receiver_config.common.processing_format = audio::PcmFormat_SInt16;
+        break;
+    case processing_format_arg_s32:
+        receiver_config.common.processing_format = audio::PcmFormat_SInt32;
+        break;
+    default:
+        break;
+    }
+
+    if (args.planar_flag
+        && receiver_config.common.processing_format != audio::Sample_RawFormat) {
+        roc_log(LogError, "--planar can't be combined with integer --processing-format");
+        return 1;
+    }
+
+    if (args.session_threads_given) {
+        if (args.session_threads_arg <= 0) {
+            roc_log(LogError, "invalid --session-threads: should be > 0");
+            return 1;
+        }
+        receiver_config.num_session_threads = (size_t)args.session_threads_arg;
+    }
+
+    if (args.max_sessions_given) {
+        if (args.max_sessions_arg <= 0) {
+            roc_log(LogError, "invalid --max-sessions: should be > 0");
+            return 1;
+        }
+        receiver_config.common.max_sessions = (size_t)args.max_sessions_arg;
+    }
+
+    if (args.max_session_load_given) {
+        if (args.max_session_load_arg <= 0) {
+            roc_log(LogError, "invalid --max-session-load: should be > 0");
+            return 1;
+        }
+        receiver_config.common.max_session_load = (float)args.max_session_load_arg;
+    }
+
+    if (args.shed_deny_duration_given) {
+        if (!core::parse_duration(args.shed_deny_duration_arg,
+                                  receiver_config.common.shed_deny_duration)) {
+            roc_log(LogError, "invalid --shed-deny-duration: bad format");
+            return 1;
+        }
+        if (receiver_config.common.shed_deny_duration < 0) {
+            roc_log(LogError, "invalid --shed-deny-duration: should be >= 0");
+            return 1;
+        }
+    }
+
+    receiver_config.common.rtcp.enable_interval_randomization = args.rtcp_randomize_flag;
+
+    if (args.rtcp_batch_size_given) {
+        if (args.rtcp_batch_size_arg < 0) {
+            roc_log(LogError, "invalid --rtcp-batch-size: should be >= 0");
+            return 1;
+        }
+        receiver_config.common.rtcp.report_batch_size = (size_t)args.rtcp_batch_size_arg;
+    }
 
     node::ContextConfig context_config;
 
@@ -63,6 +63,10 @@ int main(int argc, char** argv) {
         break;
     }
 
+    if (args.log_async_flag) {
+        core::Logger::instance().set_async(true);
+    }
+
     pipeline::SenderSinkConfig sender_config;
 
     sndio::Config io_config;
@@ -211,6 +215,9 @@ int main(int argc, char** argv) {
     case resampler_backend_arg_speexdec:
         sender_config.resampler.backend = audio::ResamplerBackend_SpeexDec;
         break;
+    case resampler_backend_arg_slip:
+        sender_config.resampler.backend = audio::ResamplerBackend_Slip;
+        break;
     default:
         break;
     }
@@ -230,6 +237,20 @@ int main(int argc, char** argv) {
     }
 
     sender_config.enable_interleaving = args.interleaving_flag;
+    sender_config.enable_pacing = args.pacing_flag;
+
+    if (args.pacing_rate_given) {
+        if (!core::parse_size(args.pacing_rate_arg, sender_config.pacer.rate)) {
+            roc_log(LogError, "invalid --pacing-rate: bad format");
+            return 1;
+        }
+        if (sender_config.pacer.rate == 0) {
+            roc_log(LogError, "invalid --pacing-rate: should be > 0");
+            return 1;
+        }
+    }
+
+    sender_config.rtcp.enable_interval_randomization = args.rtcp_randomize_flag;
     sender_config.enable_profiling = args.profiling_flag;
 
     node::ContextConfig context_config;